@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.lang.ref.WeakReference;
+
+public class GcChurnBenchmark {
+    static class Node {
+        Node next;
+        long payload;
+    }
+
+    // Long-lived objects that survive into the old generation.
+    static final int OLD_SIZE = 64 * 1024;
+    static final Node[] oldNodes = new Node[OLD_SIZE];
+
+    static {
+        for (int i = 0; i < OLD_SIZE; ++i) {
+            oldNodes[i] = new Node();
+        }
+    }
+
+    static final int CACHE_SIZE = 4096;
+    static final WeakReference<?>[] cache = new WeakReference<?>[CACHE_SIZE];
+
+    static final int LARGE_ARRAY_SIZE = 64 * 1024;
+
+    // Stores a fresh object into an old object on every iteration, creating
+    // old-to-young references that the young collection has to trace.
+    public long timeOldToYoungChurn(int count) {
+        long sum = 0;
+        for (int i = 0; i < count; ++i) {
+            Node young = new Node();
+            young.payload = i;
+            Node old = oldNodes[i & (OLD_SIZE - 1)];
+            old.next = young;
+            sum += old.next.payload;
+        }
+        return sum;
+    }
+
+    // A cache of weakly held values, as used for caching decoded resources.
+    public int timeWeakReferenceCache(int count) {
+        int hits = 0;
+        for (int i = 0; i < count; ++i) {
+            int slot = (i * 31) & (CACHE_SIZE - 1);
+            WeakReference<?> ref = cache[slot];
+            if (ref != null && ref.get() != null) {
+                ++hits;
+            } else {
+                cache[slot] = new WeakReference<>(new byte[128]);
+            }
+        }
+        return hits;
+    }
+
+    // Allocates and drops large arrays, which go to the large object space.
+    public int timeLargeArrayChurn(int count) {
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            byte[] buffer = new byte[LARGE_ARRAY_SIZE];
+            buffer[i & (LARGE_ARRAY_SIZE - 1)] = (byte) i;
+            sum += buffer[i & (LARGE_ARRAY_SIZE - 1)];
+        }
+        return sum;
+    }
+
+    // Mixed object sizes with a short lifetime.
+    public int timeMixedSizes(int count) {
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            Object o;
+            switch (i & 3) {
+                case 0: o = new Node(); break;
+                case 1: o = new int[(i & 31) + 1]; break;
+                case 2: o = new Object[(i & 15) + 1]; break;
+                default: o = new long[(i & 255) + 1]; break;
+            }
+            sum += o.hashCode() & 1;
+        }
+        return sum;
+    }
+}
@@ -0,0 +1,412 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class InterpreterCacheBenchmark {
+    // The loop of this method has 16 field loads, which fit in the cache.
+    public void timeSmallLoop(int count) {
+        Fields a = fieldsA;
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            sum += a.f0;
+            sum += a.f1;
+            sum += a.f2;
+            sum += a.f3;
+            sum += a.f4;
+            sum += a.f5;
+            sum += a.f6;
+            sum += a.f7;
+            sum += a.f8;
+            sum += a.f9;
+            sum += a.f10;
+            sum += a.f11;
+            sum += a.f12;
+            sum += a.f13;
+            sum += a.f14;
+            sum += a.f15;
+        }
+        result = sum;
+    }
+
+    // The loop of this method has 320 field loads and almost 2KiB of bytecode, so each
+    // set of the interpreter cache is used by one or two loads.
+    public void timeLargeLoop(int count) {
+        Fields a = fieldsA;
+        Fields b = fieldsB;
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            sum += a.f0;
+            sum += a.f1;
+            sum += a.f2;
+            sum += a.f3;
+            sum += a.f4;
+            sum += a.f5;
+            sum += a.f6;
+            sum += a.f7;
+            sum += a.f8;
+            sum += a.f9;
+            sum += a.f10;
+            sum += a.f11;
+            sum += a.f12;
+            sum += a.f13;
+            sum += a.f14;
+            sum += a.f15;
+            sum += a.f16;
+            sum += a.f17;
+            sum += a.f18;
+            sum += a.f19;
+            sum += a.f20;
+            sum += a.f21;
+            sum += a.f22;
+            sum += a.f23;
+            sum += a.f24;
+            sum += a.f25;
+            sum += a.f26;
+            sum += a.f27;
+            sum += a.f28;
+            sum += a.f29;
+            sum += a.f30;
+            sum += a.f31;
+            sum += b.f0;
+            sum += b.f1;
+            sum += b.f2;
+            sum += b.f3;
+            sum += b.f4;
+            sum += b.f5;
+            sum += b.f6;
+            sum += b.f7;
+            sum += b.f8;
+            sum += b.f9;
+            sum += b.f10;
+            sum += b.f11;
+            sum += b.f12;
+            sum += b.f13;
+            sum += b.f14;
+            sum += b.f15;
+            sum += b.f16;
+            sum += b.f17;
+            sum += b.f18;
+            sum += b.f19;
+            sum += b.f20;
+            sum += b.f21;
+            sum += b.f22;
+            sum += b.f23;
+            sum += b.f24;
+            sum += b.f25;
+            sum += b.f26;
+            sum += b.f27;
+            sum += b.f28;
+            sum += b.f29;
+            sum += b.f30;
+            sum += b.f31;
+            sum += a.f0;
+            sum += a.f1;
+            sum += a.f2;
+            sum += a.f3;
+            sum += a.f4;
+            sum += a.f5;
+            sum += a.f6;
+            sum += a.f7;
+            sum += a.f8;
+            sum += a.f9;
+            sum += a.f10;
+            sum += a.f11;
+            sum += a.f12;
+            sum += a.f13;
+            sum += a.f14;
+            sum += a.f15;
+            sum += a.f16;
+            sum += a.f17;
+            sum += a.f18;
+            sum += a.f19;
+            sum += a.f20;
+            sum += a.f21;
+            sum += a.f22;
+            sum += a.f23;
+            sum += a.f24;
+            sum += a.f25;
+            sum += a.f26;
+            sum += a.f27;
+            sum += a.f28;
+            sum += a.f29;
+            sum += a.f30;
+            sum += a.f31;
+            sum += b.f0;
+            sum += b.f1;
+            sum += b.f2;
+            sum += b.f3;
+            sum += b.f4;
+            sum += b.f5;
+            sum += b.f6;
+            sum += b.f7;
+            sum += b.f8;
+            sum += b.f9;
+            sum += b.f10;
+            sum += b.f11;
+            sum += b.f12;
+            sum += b.f13;
+            sum += b.f14;
+            sum += b.f15;
+            sum += b.f16;
+            sum += b.f17;
+            sum += b.f18;
+            sum += b.f19;
+            sum += b.f20;
+            sum += b.f21;
+            sum += b.f22;
+            sum += b.f23;
+            sum += b.f24;
+            sum += b.f25;
+            sum += b.f26;
+            sum += b.f27;
+            sum += b.f28;
+            sum += b.f29;
+            sum += b.f30;
+            sum += b.f31;
+            sum += a.f0;
+            sum += a.f1;
+            sum += a.f2;
+            sum += a.f3;
+            sum += a.f4;
+            sum += a.f5;
+            sum += a.f6;
+            sum += a.f7;
+            sum += a.f8;
+            sum += a.f9;
+            sum += a.f10;
+            sum += a.f11;
+            sum += a.f12;
+            sum += a.f13;
+            sum += a.f14;
+            sum += a.f15;
+            sum += a.f16;
+            sum += a.f17;
+            sum += a.f18;
+            sum += a.f19;
+            sum += a.f20;
+            sum += a.f21;
+            sum += a.f22;
+            sum += a.f23;
+            sum += a.f24;
+            sum += a.f25;
+            sum += a.f26;
+            sum += a.f27;
+            sum += a.f28;
+            sum += a.f29;
+            sum += a.f30;
+            sum += a.f31;
+            sum += b.f0;
+            sum += b.f1;
+            sum += b.f2;
+            sum += b.f3;
+            sum += b.f4;
+            sum += b.f5;
+            sum += b.f6;
+            sum += b.f7;
+            sum += b.f8;
+            sum += b.f9;
+            sum += b.f10;
+            sum += b.f11;
+            sum += b.f12;
+            sum += b.f13;
+            sum += b.f14;
+            sum += b.f15;
+            sum += b.f16;
+            sum += b.f17;
+            sum += b.f18;
+            sum += b.f19;
+            sum += b.f20;
+            sum += b.f21;
+            sum += b.f22;
+            sum += b.f23;
+            sum += b.f24;
+            sum += b.f25;
+            sum += b.f26;
+            sum += b.f27;
+            sum += b.f28;
+            sum += b.f29;
+            sum += b.f30;
+            sum += b.f31;
+            sum += a.f0;
+            sum += a.f1;
+            sum += a.f2;
+            sum += a.f3;
+            sum += a.f4;
+            sum += a.f5;
+            sum += a.f6;
+            sum += a.f7;
+            sum += a.f8;
+            sum += a.f9;
+            sum += a.f10;
+            sum += a.f11;
+            sum += a.f12;
+            sum += a.f13;
+            sum += a.f14;
+            sum += a.f15;
+            sum += a.f16;
+            sum += a.f17;
+            sum += a.f18;
+            sum += a.f19;
+            sum += a.f20;
+            sum += a.f21;
+            sum += a.f22;
+            sum += a.f23;
+            sum += a.f24;
+            sum += a.f25;
+            sum += a.f26;
+            sum += a.f27;
+            sum += a.f28;
+            sum += a.f29;
+            sum += a.f30;
+            sum += a.f31;
+            sum += b.f0;
+            sum += b.f1;
+            sum += b.f2;
+            sum += b.f3;
+            sum += b.f4;
+            sum += b.f5;
+            sum += b.f6;
+            sum += b.f7;
+            sum += b.f8;
+            sum += b.f9;
+            sum += b.f10;
+            sum += b.f11;
+            sum += b.f12;
+            sum += b.f13;
+            sum += b.f14;
+            sum += b.f15;
+            sum += b.f16;
+            sum += b.f17;
+            sum += b.f18;
+            sum += b.f19;
+            sum += b.f20;
+            sum += b.f21;
+            sum += b.f22;
+            sum += b.f23;
+            sum += b.f24;
+            sum += b.f25;
+            sum += b.f26;
+            sum += b.f27;
+            sum += b.f28;
+            sum += b.f29;
+            sum += b.f30;
+            sum += b.f31;
+            sum += a.f0;
+            sum += a.f1;
+            sum += a.f2;
+            sum += a.f3;
+            sum += a.f4;
+            sum += a.f5;
+            sum += a.f6;
+            sum += a.f7;
+            sum += a.f8;
+            sum += a.f9;
+            sum += a.f10;
+            sum += a.f11;
+            sum += a.f12;
+            sum += a.f13;
+            sum += a.f14;
+            sum += a.f15;
+            sum += a.f16;
+            sum += a.f17;
+            sum += a.f18;
+            sum += a.f19;
+            sum += a.f20;
+            sum += a.f21;
+            sum += a.f22;
+            sum += a.f23;
+            sum += a.f24;
+            sum += a.f25;
+            sum += a.f26;
+            sum += a.f27;
+            sum += a.f28;
+            sum += a.f29;
+            sum += a.f30;
+            sum += a.f31;
+            sum += b.f0;
+            sum += b.f1;
+            sum += b.f2;
+            sum += b.f3;
+            sum += b.f4;
+            sum += b.f5;
+            sum += b.f6;
+            sum += b.f7;
+            sum += b.f8;
+            sum += b.f9;
+            sum += b.f10;
+            sum += b.f11;
+            sum += b.f12;
+            sum += b.f13;
+            sum += b.f14;
+            sum += b.f15;
+            sum += b.f16;
+            sum += b.f17;
+            sum += b.f18;
+            sum += b.f19;
+            sum += b.f20;
+            sum += b.f21;
+            sum += b.f22;
+            sum += b.f23;
+            sum += b.f24;
+            sum += b.f25;
+            sum += b.f26;
+            sum += b.f27;
+            sum += b.f28;
+            sum += b.f29;
+            sum += b.f30;
+            sum += b.f31;
+        }
+        result = sum;
+    }
+
+    Fields fieldsA = new Fields();
+    Fields fieldsB = new Fields();
+    int result;
+}
+
+class Fields {
+    int f0 = 0;
+    int f1 = 1;
+    int f2 = 2;
+    int f3 = 3;
+    int f4 = 4;
+    int f5 = 5;
+    int f6 = 6;
+    int f7 = 7;
+    int f8 = 8;
+    int f9 = 9;
+    int f10 = 10;
+    int f11 = 11;
+    int f12 = 12;
+    int f13 = 13;
+    int f14 = 14;
+    int f15 = 15;
+    int f16 = 16;
+    int f17 = 17;
+    int f18 = 18;
+    int f19 = 19;
+    int f20 = 20;
+    int f21 = 21;
+    int f22 = 22;
+    int f23 = 23;
+    int f24 = 24;
+    int f25 = 25;
+    int f26 = 26;
+    int f27 = 27;
+    int f28 = 28;
+    int f29 = 29;
+    int f30 = 30;
+    int f31 = 31;
+}
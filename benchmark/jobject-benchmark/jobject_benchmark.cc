@@ -34,6 +34,23 @@ extern "C" JNIEXPORT void JNICALL Java_JObjectBenchmark_timeAddRemoveLocal(
   }
 }
 
+extern "C" JNIEXPORT void JNICALL Java_JObjectBenchmark_timeAddManyLocalsInFrame(
+    JNIEnv* env, jobject jobj, jint reps) {
+  // Models native code creating many locals in a loop, which makes the local reference table
+  // grow past its initial small table, followed by releasing them all with a frame pop.
+  static constexpr jint kNumLocals = 1024;
+  ScopedObjectAccess soa(env);
+  ObjPtr<mirror::Object> obj = soa.Decode<mirror::Object>(jobj);
+  CHECK(obj != nullptr);
+  for (jint i = 0; i < reps; ++i) {
+    soa.Env()->PushFrame(kNumLocals);
+    for (jint j = 0; j < kNumLocals; ++j) {
+      soa.Env()->AddLocalReference<jobject>(obj);
+    }
+    soa.Env()->PopFrame();
+  }
+}
+
 extern "C" JNIEXPORT void JNICALL Java_JObjectBenchmark_timeDecodeLocal(
     JNIEnv* env, jobject jobj, jint reps) {
   ScopedObjectAccess soa(env);
@@ -15,10 +15,13 @@
  */
 
 public class JObjectBenchmark {
+  private static final int NUM_THREADS = 4;
+
   public JObjectBenchmark() {
     // Make sure to link methods before benchmark starts.
     System.loadLibrary("artbenchmark");
     timeAddRemoveLocal(1);
+    timeAddManyLocalsInFrame(1);
     timeDecodeLocal(1);
     timeAddRemoveGlobal(1);
     timeDecodeGlobal(1);
@@ -27,7 +30,20 @@ public class JObjectBenchmark {
     timeDecodeHandleScopeRef(1);
   }
 
+  public void timeAddRemoveGlobalMultiThreaded(int reps) throws InterruptedException {
+    // Several threads churning global references contend on the globals lock.
+    Thread[] threads = new Thread[NUM_THREADS];
+    for (int i = 0; i < NUM_THREADS; ++i) {
+      threads[i] = new Thread(() -> timeAddRemoveGlobal(reps));
+      threads[i].start();
+    }
+    for (Thread thread : threads) {
+      thread.join();
+    }
+  }
+
   public native void timeAddRemoveLocal(int reps);
+  public native void timeAddManyLocalsInFrame(int reps);
   public native void timeDecodeLocal(int reps);
   public native void timeAddRemoveGlobal(int reps);
   public native void timeDecodeGlobal(int reps);
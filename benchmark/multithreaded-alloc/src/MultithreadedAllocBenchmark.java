@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.util.concurrent.CountDownLatch;
+
+public class MultithreadedAllocBenchmark {
+    static class Small {
+        int value;
+    }
+
+    static class Medium {
+        long a, b, c, d, e, f, g, h;
+    }
+
+    // Keep a few objects alive so that runs do not become entirely free and get released.
+    static final int RETAINED = 256;
+
+    interface Allocator {
+        // Allocates `count` objects and returns a value depending on all of them.
+        int allocate(int count, Object[] retained);
+    }
+
+    static final Allocator SMALL = (count, retained) -> {
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            Small s = new Small();
+            s.value = i;
+            retained[i & (RETAINED - 1)] = s;
+            sum += s.value;
+        }
+        return sum;
+    };
+
+    static final Allocator MEDIUM = (count, retained) -> {
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            Medium m = new Medium();
+            m.a = i;
+            retained[i & (RETAINED - 1)] = m;
+            sum += (int) m.a;
+        }
+        return sum;
+    };
+
+    static final Allocator ARRAYS = (count, retained) -> {
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            byte[] b = new byte[(i & 63) + 1];
+            retained[i & (RETAINED - 1)] = b;
+            sum += b.length;
+        }
+        return sum;
+    };
+
+    private static void run(int numThreads, int count, Allocator allocator) {
+        final CountDownLatch start = new CountDownLatch(1);
+        final int[] results = new int[numThreads];
+        Thread[] threads = new Thread[numThreads];
+        for (int t = 0; t < numThreads; ++t) {
+            final int index = t;
+            threads[t] = new Thread(() -> {
+                Object[] retained = new Object[RETAINED];
+                try {
+                    start.await();
+                } catch (InterruptedException e) {
+                    throw new AssertionError(e);
+                }
+                results[index] = allocator.allocate(count, retained);
+            });
+            threads[t].start();
+        }
+        start.countDown();
+        for (Thread thread : threads) {
+            try {
+                thread.join();
+            } catch (InterruptedException e) {
+                throw new AssertionError(e);
+            }
+        }
+        for (int result : results) {
+            if (result != results[0]) {
+                throw new AssertionError();
+            }
+        }
+    }
+
+    public void timeSmallObjects1Thread(int count) {
+        run(1, count, SMALL);
+    }
+
+    public void timeSmallObjects4Threads(int count) {
+        run(4, count, SMALL);
+    }
+
+    public void timeSmallObjects16Threads(int count) {
+        run(16, count, SMALL);
+    }
+
+    public void timeMediumObjects4Threads(int count) {
+        run(4, count, MEDIUM);
+    }
+
+    public void timeMediumObjects16Threads(int count) {
+        run(16, count, MEDIUM);
+    }
+
+    public void timeMixedArrays4Threads(int count) {
+        run(4, count, ARRAYS);
+    }
+
+    public void timeMixedArrays16Threads(int count) {
+        run(16, count, ARRAYS);
+    }
+}
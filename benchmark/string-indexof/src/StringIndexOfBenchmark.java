@@ -113,6 +113,78 @@ public class StringIndexOfBenchmark {
         }
     }
 
+    // Long strings, searched for the last char. The compressed string holds only Latin-1
+    // chars, the uncompressed one has a char outside that range at the start.
+    public static final String compressed1024 = "a".repeat(1023) + "z";  // length = 1024
+    public static final String uncompressed1024 =
+        "\u0100" + "a".repeat(1022) + "z";  // length = 1024
+
+    public void timeIndexOfLongCompressed(int count) {
+        final char c = 'z';
+        String s = compressed1024;
+        for (int i = 0; i < count; ++i) {
+            $noinline$indexOf(s, c);
+        }
+    }
+
+    public void timeIndexOfLongUncompressed(int count) {
+        final char c = 'z';
+        String s = uncompressed1024;
+        for (int i = 0; i < count; ++i) {
+            $noinline$indexOf(s, c);
+        }
+    }
+
+    public void timeIndexOfLongNotFound(int count) {
+        final char c = '_';
+        String s = compressed1024;
+        for (int i = 0; i < count; ++i) {
+            $noinline$indexOf(s, c);
+        }
+    }
+
+    public void timeEqualsLongCompressed(int count) {
+        String s1 = compressed1024;
+        String s2 = new String(compressed1024);
+        for (int i = 0; i < count; ++i) {
+            $noinline$equals(s1, s2);
+        }
+    }
+
+    public void timeEqualsLongUncompressed(int count) {
+        String s1 = uncompressed1024;
+        String s2 = new String(uncompressed1024);
+        for (int i = 0; i < count; ++i) {
+            $noinline$equals(s1, s2);
+        }
+    }
+
+    public void timeCompareToLongCompressed(int count) {
+        String s1 = compressed1024;
+        String s2 = "a".repeat(1024);
+        for (int i = 0; i < count; ++i) {
+            $noinline$compareTo(s1, s2);
+        }
+    }
+
+    public void timeCompareToLongUncompressed(int count) {
+        String s1 = uncompressed1024;
+        String s2 = "\u0100" + "a".repeat(1023);
+        for (int i = 0; i < count; ++i) {
+            $noinline$compareTo(s1, s2);
+        }
+    }
+
+    static boolean $noinline$equals(String s1, String s2) {
+        if (doThrow) { throw new Error(); }
+        return s1.equals(s2);
+    }
+
+    static int $noinline$compareTo(String s1, String s2) {
+        if (doThrow) { throw new Error(); }
+        return s1.compareTo(s2);
+    }
+
     static int $noinline$indexOf(String s, char c) {
         if (doThrow) { throw new Error(); }
         return s.indexOf(c);
@@ -105,7 +105,61 @@ public class TypeCheckBenchmark {
         result = sum;
     }
 
-    public static Object[] createArray(int level) {
+    public void timeCheckCastLevel9ToLevel3(int count) {
+        Object[] arr = arr9;
+        for (int i = 0; i < count; ++i) {
+            Level3 l3 = (Level3) arr[i & 1023];
+        }
+    }
+
+    public void timeCheckCastLevel9ToLevel8(int count) {
+        Object[] arr = arr9;
+        for (int i = 0; i < count; ++i) {
+            Level8 l8 = (Level8) arr[i & 1023];
+        }
+    }
+
+    public void timeCheckCastMixedToLevel1(int count) {
+        Object[] arr = arrMixed;
+        for (int i = 0; i < count; ++i) {
+            Level1 l1 = (Level1) arr[i & 1023];
+        }
+    }
+
+    public void timeInstanceOfLevel9ToLevel3(int count) {
+        int sum = 0;
+        Object[] arr = arr9;
+        for (int i = 0; i < count; ++i) {
+            if (arr[i & 1023] instanceof Level3) {
+              ++sum;
+            }
+        }
+        result = sum;
+    }
+
+    public void timeInstanceOfLevel9ToLevel8(int count) {
+        int sum = 0;
+        Object[] arr = arr9;
+        for (int i = 0; i < count; ++i) {
+            if (arr[i & 1023] instanceof Level8) {
+              ++sum;
+            }
+        }
+        result = sum;
+    }
+
+    public void timeInstanceOfMixedToLevel5(int count) {
+        int sum = 0;
+        Object[] arr = arrMixed;
+        for (int i = 0; i < count; ++i) {
+            if (arr[i & 1023] instanceof Level5) {
+              ++sum;
+            }
+        }
+        result = sum;
+    }
+
+    public static Object createObject(int level) {
         try {
             Class<?>[] ls = {
                     null,
@@ -119,20 +173,34 @@ public class TypeCheckBenchmark {
                     Level8.class,
                     Level9.class,
             };
-            Class<?> l = ls[level];
-            Object[] array = new Object[1024];
-            for (int i = 0; i < array.length; ++i) {
-                array[i] = l.newInstance();
-            }
-            return array;
+            return ls[level].newInstance();
         } catch (Exception unexpected) {
             throw new Error("Initialization failure!");
         }
     }
+
+    public static Object[] createArray(int level) {
+        Object[] array = new Object[1024];
+        for (int i = 0; i < array.length; ++i) {
+            array[i] = createObject(level);
+        }
+        return array;
+    }
+
+    // Objects of all levels, so that the type checks see many different classes.
+    public static Object[] createMixedArray() {
+        Object[] array = new Object[1024];
+        for (int i = 0; i < array.length; ++i) {
+            array[i] = createObject(1 + i % 9);
+        }
+        return array;
+    }
+
     Object[] arr1 = createArray(1);
     Object[] arr2 = createArray(2);
     Object[] arr3 = createArray(3);
     Object[] arr9 = createArray(9);
+    Object[] arrMixed = createMixedArray();
     int result;
 }
 
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class VectorReductionBenchmark {
+    private static final int LENGTH = 1024;
+
+    private final int[] ints = new int[LENGTH];
+    private final long[] longs = new long[LENGTH];
+    private final byte[] bytes1 = new byte[LENGTH];
+    private final byte[] bytes2 = new byte[LENGTH];
+
+    public VectorReductionBenchmark() {
+        for (int i = 0, k = -LENGTH / 3; i < LENGTH; i++, k += 7) {
+            ints[i] = k * 31;
+            longs[i] = k * 31L;
+            bytes1[i] = (byte) k;
+            bytes2[i] = (byte) (k * 3);
+        }
+    }
+
+    public void timeSumInt(int count) {
+        for (int i = 0; i < count; ++i) {
+            $noinline$sumInt(ints);
+        }
+    }
+
+    public void timeMinInt(int count) {
+        for (int i = 0; i < count; ++i) {
+            $noinline$minInt(ints);
+        }
+    }
+
+    public void timeMaxInt(int count) {
+        for (int i = 0; i < count; ++i) {
+            $noinline$maxInt(ints);
+        }
+    }
+
+    public void timeMinLong(int count) {
+        for (int i = 0; i < count; ++i) {
+            $noinline$minLong(longs);
+        }
+    }
+
+    public void timeDotProdByte(int count) {
+        for (int i = 0; i < count; ++i) {
+            $noinline$dotProdByte(bytes1, bytes2);
+        }
+    }
+
+    private static int $noinline$sumInt(int[] x) {
+        int sum = 0;
+        for (int i = 0; i < x.length; i++) {
+            sum += x[i];
+        }
+        return sum;
+    }
+
+    private static int $noinline$minInt(int[] x) {
+        int min = Integer.MAX_VALUE;
+        for (int i = 0; i < x.length; i++) {
+            min = Math.min(min, x[i]);
+        }
+        return min;
+    }
+
+    private static int $noinline$maxInt(int[] x) {
+        int max = Integer.MIN_VALUE;
+        for (int i = 0; i < x.length; i++) {
+            max = Math.max(max, x[i]);
+        }
+        return max;
+    }
+
+    private static long $noinline$minLong(long[] x) {
+        long min = Long.MAX_VALUE;
+        for (int i = 0; i < x.length; i++) {
+            min = Math.min(min, x[i]);
+        }
+        return min;
+    }
+
+    private static int $noinline$dotProdByte(byte[] a, byte[] b) {
+        int sum = 0;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    }
+}
@@ -40,7 +40,8 @@ namespace art {
            lhs.min_methods_to_save_ == rhs.min_methods_to_save_ &&
            lhs.min_classes_to_save_ == rhs.min_classes_to_save_ &&
            lhs.min_notification_before_wake_ == rhs.min_notification_before_wake_ &&
-           lhs.max_notification_before_wake_ == rhs.max_notification_before_wake_;
+           lhs.max_notification_before_wake_ == rhs.max_notification_before_wake_ &&
+           lhs.sampling_interval_ms_ == rhs.sampling_interval_ms_;
   }
 
   bool UsuallyEquals(double expected, double actual) {
@@ -488,7 +489,10 @@ TEST_F(CmdlineParserTest, TestJitOptions) {
 * -Xps-*
 */
 TEST_F(CmdlineParserTest, ProfileSaverOptions) {
-  ProfileSaverOptions opt = ProfileSaverOptions(true, 1, 2, 3, 4, 5, 6, 7, "abc", true);
+  ProfileSaverOptions opt = ProfileSaverOptions(true, 1, 2, 3, 4, 5, 6, 7, "abc", true,
+                                                /*profile_aot_code=*/ false,
+                                                /*wait_for_jit_notifications_to_save=*/ true,
+                                                /*sampling_interval_ms=*/ 8);
 
   EXPECT_SINGLE_PARSE_VALUE(opt,
                             "-Xjitsaveprofilinginfo "
@@ -499,6 +503,7 @@ TEST_F(CmdlineParserTest, ProfileSaverOptions) {
                             "-Xps-min-notification-before-wake:5 "
                             "-Xps-max-notification-before-wake:6 "
                             "-Xps-inline-cache-threshold:7 "
+                            "-Xps-sampling-interval-ms:8 "
                             "-Xps-profile-path:abc "
                             "-Xps-profile-boot-class-path",
                             M::ProfileSaverOpts);
@@ -862,6 +862,12 @@ struct CmdlineType<ProfileSaverOptions> : CmdlineTypeParser<ProfileSaverOptions>
       return ParseInto(
           existing, &ProfileSaverOptions::inline_cache_threshold_, type_parser.Parse(suffix));
     }
+    if (option.starts_with("sampling-interval-ms:")) {
+      CmdlineType<unsigned int> type_parser;
+      return ParseInto(existing,
+             &ProfileSaverOptions::sampling_interval_ms_,
+             type_parser.Parse(suffix));
+    }
     if (option.starts_with("profile-path:")) {
       existing.profile_path_ = suffix;
       return Result::SuccessNoValue();
@@ -310,6 +310,10 @@ class CompilerOptions final {
     return dump_cfg_append_;
   }
 
+  const std::string& GetDumpCompileProfileFileName() const {
+    return dump_compile_profile_file_name_;
+  }
+
   bool IsForceDeterminism() const {
     return force_determinism_;
   }
@@ -350,6 +354,10 @@ class CompilerOptions final {
     return resolve_startup_const_strings_;
   }
 
+  bool UseGraphColoringRegisterAllocator() const {
+    return use_graph_coloring_register_allocator_;
+  }
+
   ProfileMethodsCheck CheckProfiledMethodsCompiled() const {
     return check_profiled_methods_;
   }
@@ -439,6 +447,7 @@ class CompilerOptions final {
 
   std::string dump_cfg_file_name_;
   bool dump_cfg_append_;
+  std::string dump_compile_profile_file_name_;
 
   // Whether the compiler should trade performance for determinism to guarantee exactly reproducible
   // outcomes.
@@ -462,6 +471,10 @@ class CompilerOptions final {
   // profile.
   bool resolve_startup_const_strings_;
 
+  // Whether AOT compilation for speed uses the graph coloring register allocator for hot
+  // methods and, without a profile, for methods with loops.
+  bool use_graph_coloring_register_allocator_;
+
   // Whether we attempt to run class initializers for app image classes.
   bool initialize_app_image_classes_;
 
@@ -81,12 +81,15 @@ inline bool ReadCompilerOptions(Base& map, CompilerOptions* options, std::string
   if (map.Exists(Base::DumpCFGAppend)) {
     options->dump_cfg_append_ = true;
   }
+  map.AssignIfExists(Base::DumpCompileProfile, &options->dump_compile_profile_file_name_);
   map.AssignIfExists(Base::VerboseMethods, &options->verbose_methods_);
   options->deduplicate_code_ = map.GetOrDefault(Base::DeduplicateCode);
   if (map.Exists(Base::CountHotnessInCompiledCode)) {
     options->count_hotness_in_compiled_code_ = true;
   }
   map.AssignIfExists(Base::ResolveStartupConstStrings, &options->resolve_startup_const_strings_);
+  map.AssignIfExists(Base::GraphColoringRegisterAllocation,
+                     &options->use_graph_coloring_register_allocator_);
   map.AssignIfExists(Base::InitializeAppImageClasses, &options->initialize_app_image_classes_);
   if (map.Exists(Base::CheckProfiledMethods)) {
     options->check_profiled_methods_ = *map.Get(Base::CheckProfiledMethods);
@@ -215,6 +218,12 @@ NO_INLINE void AddCompilerOptionsArgumentParserOptions(Builder& b) {
                     "(instead of overwriting existing data with new data, which is the default\n"
                     "behavior). This option is only meaningful when used with --dump-cfg.")
           .IntoKey(Map::DumpCFGAppend)
+      .Define("--dump-compile-profile=_")
+          .template WithType<std::string>()
+          .WithHelp("Append the time, arena memory and graph size of each compiler pass and the\n"
+                    "inlining decisions of each compiled method to the specified file, one line\n"
+                    "of JSON per method.")
+          .IntoKey(Map::DumpCompileProfile)
 
       .Define("--resolve-startup-const-strings=_")
           .template WithType<bool>()
@@ -223,6 +232,13 @@ NO_INLINE void AddCompilerOptionsArgumentParserOptions(Builder& b) {
                     "of startup methods.")
           .IntoKey(Map::ResolveStartupConstStrings)
 
+      .Define("--graph-coloring-register-allocation=_")
+          .template WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .WithHelp("If true, use the graph coloring register allocator for hot methods when\n"
+                    "compiling for speed. Defaults to false.")
+          .IntoKey(Map::GraphColoringRegisterAllocation)
+
       .Define("--initialize-app-image-classes=_")
           .template WithType<bool>()
           .WithValueMap({{"false", false}, {"true", true}})
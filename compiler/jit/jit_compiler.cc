@@ -211,10 +211,11 @@ bool JitCompiler::CompileMethod(
   }
 
   // If we don't have a new task following this compile,
-  // trim maps to reduce memory usage.
+  // trim maps to reduce memory usage. The memory recent compilations needed
+  // stays populated for the next ones.
   if (jit->GetThreadPool() == nullptr || jit->GetThreadPool()->GetTaskCount(self) == 0) {
     TimingLogger::ScopedTiming t2("TrimMaps", &logger);
-    runtime->GetJitArenaPool()->TrimMaps();
+    jit->TrimArenaPool(self);
   }
 
   jit->AddTimingLogger(logger);
@@ -22,6 +22,7 @@
 #include "base/macros.h"
 #include "base/mutex.h"
 #include "base/os.h"
+#include "thread-current-inl.h"
 
 namespace art HIDDEN {
 
@@ -88,7 +89,7 @@ namespace jit {
 //
 class JitLogger {
  public:
-    JitLogger() : code_index_(0), marker_address_(nullptr) {}
+    JitLogger() : lock_("JIT logger lock"), code_index_(0), marker_address_(nullptr) {}
 
     void OpenLog() {
       OpenPerfMapLog();
@@ -96,7 +97,9 @@ class JitLogger {
     }
 
     void WriteLog(const void* ptr, size_t code_size, ArtMethod* method)
-        REQUIRES_SHARED(Locks::mutator_lock_) {
+        REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!lock_) {
+      // Several JIT workers may log at the same time.
+      MutexLock mu(Thread::Current(), lock_);
       WritePerfMapLog(ptr, code_size, method);
       WriteJitDumpLog(ptr, code_size, method);
     }
@@ -124,6 +127,7 @@ class JitLogger {
     void WriteJitDumpHeader();
     void WriteJitDumpDebugInfo();
 
+    Mutex lock_;
     std::unique_ptr<File> perf_file_;
     std::unique_ptr<File> jit_dump_file_;
     uint64_t code_index_;
@@ -16,13 +16,16 @@
 
 #include "bounds_check_elimination.h"
 
+#include <algorithm>
 #include <limits>
 
+#include "base/array_ref.h"
 #include "base/scoped_arena_allocator.h"
 #include "base/scoped_arena_containers.h"
 #include "induction_var_range.h"
 #include "nodes.h"
 #include "side_effects_analysis.h"
+#include "superblock_cloner.h"
 
 namespace art HIDDEN {
 
@@ -502,6 +505,10 @@ class BCEVisitor final : public HGraphVisitor {
   static constexpr uint32_t kMaxLengthForAddingDeoptimize =
       std::numeric_limits<int32_t>::max() - 1024 * 1024;
 
+  // Limits on loop versioning, which duplicates the loop body.
+  static constexpr size_t kMaxNumberOfVersionedLoops = 4;
+  static constexpr size_t kMaxInstructionsInVersionedLoop = 64;
+
   // Added blocks for loop body entry test.
   bool IsAddedBlock(HBasicBlock* block) const {
     return block->GetBlockId() >= initial_block_size_;
@@ -524,6 +531,7 @@ class BCEVisitor final : public HGraphVisitor {
         taken_test_loop_(std::less<uint32_t>(),
                          allocator_.Adapter(kArenaAllocBoundsCheckElimination)),
         finite_loop_(allocator_.Adapter(kArenaAllocBoundsCheckElimination)),
+        versioning_candidates_(allocator_.Adapter(kArenaAllocBoundsCheckElimination)),
         has_dom_based_dynamic_bce_(false),
         initial_block_size_(graph->GetBlocks().size()),
         side_effects_(side_effects),
@@ -550,7 +558,8 @@ class BCEVisitor final : public HGraphVisitor {
     }
     // We should never deoptimize from an osr method, otherwise we might wrongly optimize
     // code dominated by the deoptimization.
-    if (!GetGraph()->IsCompilingOsr()) {
+    if (!GetGraph()->IsCompilingOsr() &&
+        GetGraph()->ShouldSpeculate(DeoptimizationKind::kBlockBCE)) {
       AddComparesWithDeoptimization(block);
     }
   }
@@ -560,6 +569,10 @@ class BCEVisitor final : public HGraphVisitor {
     // new taken-test structures (see TransformLoopForDeoptimizationIfNeeded()).
     InsertPhiNodes();
 
+    // Version the loops with bounds checks that the deoptimization techniques could not
+    // eliminate. This is done last since it changes the loop structure of the graph.
+    TransformLoopsForVersioning();
+
     // Clear the loop data structures.
     early_exit_loop_.clear();
     taken_test_loop_.clear();
@@ -932,6 +945,11 @@ class BCEVisitor final : public HGraphVisitor {
         TransformLoopForDynamicBCE(loop, bounds_check);
         return;
       }
+      // Remember bounds checks in loops for loop versioning, in case the dominator-based
+      // dynamic elimination does not remove them either.
+      if (loop != nullptr) {
+        versioning_candidates_.push_back(bounds_check);
+      }
       // Otherwise, prepare dominator-based dynamic elimination.
       if (first_index_bounds_check_map_.find(array_length->GetId()) ==
           first_index_bounds_check_map_.end()) {
@@ -1685,6 +1703,11 @@ class BCEVisitor final : public HGraphVisitor {
       if (GetGraph()->IsCompilingOsr()) {
         return false;
       }
+      // Do not keep deoptimizing a method whose loop deoptimizations kept failing.
+      if (!GetGraph()->ShouldSpeculate(DeoptimizationKind::kLoopBoundsBCE) ||
+          !GetGraph()->ShouldSpeculate(DeoptimizationKind::kLoopNullBCE)) {
+        return false;
+      }
       // A try boundary preheader is hard to handle.
       // TODO: remove this restriction.
       if (loop->GetPreHeader()->GetLastInstruction()->IsTryBoundary()) {
@@ -1931,6 +1954,167 @@ class BCEVisitor final : public HGraphVisitor {
     taken_test_loop_.Put(loop_id, true_block);
   }
 
+  /**
+   * Returns true if `loop` is an innermost loop small enough to be versioned.
+   */
+  bool CanVersionLoop(HLoopInformation* loop) {
+    if (loop->IsIrreducible() || !loop->GetPreHeader()->GetLastInstruction()->IsGoto()) {
+      return false;
+    }
+    size_t number_of_instructions = 0;
+    for (HBlocksInLoopIterator it_loop(*loop); !it_loop.Done(); it_loop.Advance()) {
+      HBasicBlock* block = it_loop.Current();
+      if (block->GetLoopInformation() != loop) {
+        return false;  // Not an innermost loop.
+      }
+      for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+        ++number_of_instructions;
+      }
+      if (number_of_instructions > kMaxInstructionsInVersionedLoop) {
+        return false;
+      }
+    }
+    return LoopClonerHelper::IsLoopClonable(loop);
+  }
+
+  /**
+   * Generates in the preheader of `loop` a test that is true when the index of one of
+   * `bounds_checks` may be out of bounds in some iteration of the loop, and returns it.
+   * All bounds checks must have a loop invariant length and an index for which range
+   * analysis can generate code.
+   *
+   * In code, using unsigned comparisons:
+   *   (lower_1 > upper_1) || (upper_1 >= length_1) || ... || (upper_n >= length_n)
+   * where the lower test is omitted for loop invariant indices.
+   */
+  HInstruction* GenerateVersioningTest(HLoopInformation* loop,
+                                       ArrayRef<HBoundsCheck* const> bounds_checks) {
+    HBasicBlock* block = loop->GetPreHeader();
+    HInstruction* test = nullptr;
+    auto add_test = [&](HInstruction* condition) {
+      block->InsertInstructionBefore(condition, block->GetLastInstruction());
+      if (test == nullptr) {
+        test = condition;
+      } else {
+        test = new (GetGraph()->GetAllocator()) HOr(DataType::Type::kInt32, test, condition);
+        block->InsertInstructionBefore(test, block->GetLastInstruction());
+      }
+    };
+    for (HBoundsCheck* bounds_check : bounds_checks) {
+      HInstruction* lower = nullptr;
+      HInstruction* upper = nullptr;
+      induction_range_.GenerateRange(
+          bounds_check->GetBlock(), bounds_check->InputAt(0), GetGraph(), block, &lower, &upper);
+      if (lower != nullptr) {
+        add_test(new (GetGraph()->GetAllocator()) HAbove(lower, upper));
+      }
+      add_test(new (GetGraph()->GetAllocator()) HAboveOrEqual(upper, bounds_check->InputAt(1)));
+    }
+    DCHECK(test != nullptr);
+    return test;
+  }
+
+  /**
+   * Performs loop versioning for the bounds checks that neither static nor dynamic
+   * elimination could remove, typically in loops with early exits or with bounds checks
+   * that are not executed on every iteration, or in methods where deoptimization failed
+   * before. Such a loop is duplicated, and a single test in the preheader selects the copy
+   * without bounds checks when no index can be out of bounds. Otherwise, the original
+   * loop runs with its bounds checks and throws where it should. Unlike deoptimization,
+   * taking the slow version has no lasting cost, so it is fine, for example, if an early
+   * exit means that the loop never reaches the indices found out of bounds.
+   *
+   *           preheader: if (test)
+   *             /               \
+   *      header <--\         header' <--\    <- the original loop and its copy
+   *        |       |           |         |
+   *      body -----/         body' ------/    <- the copy has no bounds checks
+   */
+  void TransformLoopsForVersioning() {
+    if (versioning_candidates_.empty() ||
+        GetGraph()->IsCompilingOsr() ||
+        GetGraph()->HasIrreducibleLoops()) {
+      return;
+    }
+    // Group the remaining candidates by loop.
+    ScopedArenaVector<HBoundsCheck*> candidates(
+        allocator_.Adapter(kArenaAllocBoundsCheckElimination));
+    for (HBoundsCheck* bounds_check : versioning_candidates_) {
+      if (bounds_check->IsInBlock()) {
+        candidates.push_back(bounds_check);
+      }
+    }
+    std::stable_sort(candidates.begin(),
+                     candidates.end(),
+                     [](HBoundsCheck* lhs, HBoundsCheck* rhs) {
+                       return lhs->GetBlock()->GetLoopInformation()->GetHeader()->GetBlockId() <
+                              rhs->GetBlock()->GetLoopInformation()->GetHeader()->GetBlockId();
+                     });
+
+    // Generate all the tests before cloning any loop, since range analysis is not
+    // updated for the changes of the loop structure.
+    struct VersionedLoop {
+      HLoopInformation* loop;
+      HInstruction* test;
+      size_t begin;  // Range of `bounds_checks` eliminated in the fast version.
+      size_t end;
+    };
+    ScopedArenaVector<VersionedLoop> versioned_loops(
+        allocator_.Adapter(kArenaAllocBoundsCheckElimination));
+    ScopedArenaVector<HBoundsCheck*> bounds_checks(
+        allocator_.Adapter(kArenaAllocBoundsCheckElimination));
+    for (auto it = candidates.begin();
+         it != candidates.end() && versioned_loops.size() < kMaxNumberOfVersionedLoops;) {
+      HLoopInformation* loop = (*it)->GetBlock()->GetLoopInformation();
+      auto loop_end = std::find_if(it, candidates.end(), [loop](HBoundsCheck* bounds_check) {
+        return bounds_check->GetBlock()->GetLoopInformation() != loop;
+      });
+      if (CanVersionLoop(loop)) {
+        size_t begin = bounds_checks.size();
+        for (; it != loop_end; ++it) {
+          HBoundsCheck* bounds_check = *it;
+          bool needs_finite_test = false;
+          bool needs_taken_test = false;  // A loop that is not taken runs either version.
+          if (loop->IsDefinedOutOfTheLoop(bounds_check->InputAt(1)) &&
+              induction_range_.CanGenerateRange(bounds_check->GetBlock(),
+                                                bounds_check->InputAt(0),
+                                                &needs_finite_test,
+                                                &needs_taken_test) &&
+              !needs_finite_test) {
+            bounds_checks.push_back(bounds_check);
+          }
+        }
+        if (begin != bounds_checks.size()) {
+          ArrayRef<HBoundsCheck* const> loop_bounds_checks(
+              bounds_checks.data() + begin, bounds_checks.size() - begin);
+          HInstruction* test = GenerateVersioningTest(loop, loop_bounds_checks);
+          versioned_loops.push_back({loop, test, begin, bounds_checks.size()});
+        }
+      }
+      it = loop_end;
+    }
+
+    for (const VersionedLoop& versioned_loop : versioned_loops) {
+      HLoopInformation* loop = versioned_loop.loop;
+      HBasicBlock* preheader = loop->GetPreHeader();
+      LoopClonerSimpleHelper helper(loop, &induction_range_);
+      helper.DoVersioning();
+      // The copy of the loop is the second successor of the preheader. It is the fast
+      // version, taken when the test finds no index out of bounds.
+      DCHECK_EQ(preheader->GetSuccessors().size(), 2u);
+      DCHECK(preheader->GetSuccessors()[0]->Dominates(loop->GetHeader()));
+      DCHECK(preheader->GetLastInstruction()->IsGoto());
+      preheader->ReplaceAndRemoveInstructionWith(
+          preheader->GetLastInstruction(),
+          new (GetGraph()->GetAllocator()) HIf(versioned_loop.test));
+      for (size_t i = versioned_loop.begin; i != versioned_loop.end; ++i) {
+        HInstruction* copy = helper.GetInstructionMap()->Get(bounds_checks[i]);
+        DCHECK(copy->IsBoundsCheck());
+        ReplaceInstruction(copy, copy->InputAt(0));
+      }
+    }
+  }
+
   /**
    * Inserts phi nodes that preserve SSA structure in generated top test structures.
    * All uses of instructions in the deoptimization block that reach the loop need
@@ -2046,6 +2230,9 @@ class BCEVisitor final : public HGraphVisitor {
   // Finite loop bookkeeping.
   ScopedArenaSet<uint32_t> finite_loop_;
 
+  // Bounds checks in loops that may be eliminated by loop versioning.
+  ScopedArenaVector<HBoundsCheck*> versioning_candidates_;
+
   // Flag that denotes whether dominator-based dynamic elimination has occurred.
   bool has_dom_based_dynamic_bce_;
 
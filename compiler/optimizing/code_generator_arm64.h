@@ -158,7 +158,6 @@ Location ARM64ReturnLocation(DataType::Type return_type);
   V(SystemArrayCopyInt)                       \
   V(UnsafeArrayBaseOffset)                    \
   /* 1.8 */                                   \
-  V(MethodHandleInvokeExact)                  \
   V(MethodHandleInvoke)                       \
   /* OpenJDK 11 */                            \
   V(JdkUnsafeArrayBaseOffset)
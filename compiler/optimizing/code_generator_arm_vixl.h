@@ -134,6 +134,9 @@ using VIXLUInt32Literal = vixl::aarch32::Literal<uint32_t>;
   V(CRC32Update)                                                           \
   V(CRC32UpdateBytes)                                                      \
   V(CRC32UpdateByteBuffer)                                                 \
+  V(CRC32CUpdateBytes)                                                     \
+  V(CRC32CUpdateDirectByteBuffer)                                          \
+  V(ArraysEqualsByte)                                                      \
   V(FP16ToFloat)                                                           \
   V(FP16ToHalf)                                                            \
   V(FP16Floor)                                                             \
@@ -147,6 +150,19 @@ using VIXLUInt32Literal = vixl::aarch32::Literal<uint32_t>;
   V(FP16Min)                                                               \
   V(FP16Max)                                                               \
   V(MathMultiplyHigh)                                                      \
+  V(LongValueOf)                                                           \
+  V(UnsafeGetByteAbsolute)                                                 \
+  V(UnsafeGetAbsolute)                                                     \
+  V(UnsafeGetLongAbsolute)                                                 \
+  V(UnsafePutByteAbsolute)                                                 \
+  V(UnsafePutAbsolute)                                                     \
+  V(UnsafePutLongAbsolute)                                                 \
+  V(JdkUnsafeGetByteAbsolute)                                              \
+  V(JdkUnsafeGetAbsolute)                                                  \
+  V(JdkUnsafeGetLongAbsolute)                                              \
+  V(JdkUnsafePutByteAbsolute)                                              \
+  V(JdkUnsafePutAbsolute)                                                  \
+  V(JdkUnsafePutLongAbsolute)                                              \
   V(StringStringIndexOf)                                                   \
   V(StringStringIndexOfAfter)                                              \
   V(StringBufferAppend)                                                    \
@@ -88,10 +88,25 @@ static constexpr int32_t kFClassNaNMinValue = 0x100;
   V(CRC32Update)                                \
   V(CRC32UpdateBytes)                           \
   V(CRC32UpdateByteBuffer)                      \
+  V(CRC32CUpdateBytes)                          \
+  V(CRC32CUpdateDirectByteBuffer)               \
   V(MethodHandleInvokeExact)                    \
   V(MethodHandleInvoke)                         \
   V(UnsafeArrayBaseOffset)                      \
   V(JdkUnsafeArrayBaseOffset)                   \
+  V(LongValueOf)                                \
+  V(UnsafeGetByteAbsolute)                      \
+  V(UnsafeGetAbsolute)                          \
+  V(UnsafeGetLongAbsolute)                      \
+  V(UnsafePutByteAbsolute)                      \
+  V(UnsafePutAbsolute)                          \
+  V(UnsafePutLongAbsolute)                      \
+  V(JdkUnsafeGetByteAbsolute)                   \
+  V(JdkUnsafeGetAbsolute)                       \
+  V(JdkUnsafeGetLongAbsolute)                   \
+  V(JdkUnsafePutByteAbsolute)                   \
+  V(JdkUnsafePutAbsolute)                       \
+  V(JdkUnsafePutLongAbsolute)                   \
 
 // Method register on invoke.
 static const XRegister kArtMethodRegister = A0;
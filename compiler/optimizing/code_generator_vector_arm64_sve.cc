@@ -253,9 +253,12 @@ void InstructionCodeGeneratorARM64Sve::VisitVecReduce(HVecReduce* instruction) {
         case HVecReduce::kSum:
           __ Saddv(dst.S(), p_reg, src.VnS());
           break;
-        default:
-          LOG(FATAL) << "Unsupported SIMD instruction";
-          UNREACHABLE();
+        case HVecReduce::kMin:
+          __ Sminv(dst.S(), p_reg, src.VnS());
+          break;
+        case HVecReduce::kMax:
+          __ Smaxv(dst.S(), p_reg, src.VnS());
+          break;
       }
       break;
     case DataType::Type::kInt64:
@@ -263,9 +266,12 @@ void InstructionCodeGeneratorARM64Sve::VisitVecReduce(HVecReduce* instruction) {
         case HVecReduce::kSum:
           __ Uaddv(dst.D(), p_reg, src.VnD());
           break;
-        default:
-          LOG(FATAL) << "Unsupported SIMD instruction";
-          UNREACHABLE();
+        case HVecReduce::kMin:
+          __ Sminv(dst.D(), p_reg, src.VnD());
+          break;
+        case HVecReduce::kMax:
+          __ Smaxv(dst.D(), p_reg, src.VnD());
+          break;
       }
       break;
     default:
@@ -602,23 +608,95 @@ void InstructionCodeGeneratorARM64Sve::VisitVecDiv(HVecDiv* instruction) {
 }
 
 void LocationsBuilderARM64Sve::VisitVecMin(HVecMin* instruction) {
-  LOG(FATAL) << "Unsupported SIMD instruction " << instruction->GetId();
-  UNREACHABLE();
+  CreateVecBinOpLocations(GetGraph()->GetAllocator(), instruction);
 }
 
 void InstructionCodeGeneratorARM64Sve::VisitVecMin(HVecMin* instruction) {
-  LOG(FATAL) << "Unsupported SIMD instruction " << instruction->GetId();
-  UNREACHABLE();
+  DCHECK(instruction->IsPredicated());
+  LocationSummary* locations = instruction->GetLocations();
+  const ZRegister lhs = ZRegisterFrom(locations->InAt(0));
+  const ZRegister rhs = ZRegisterFrom(locations->InAt(1));
+  const ZRegister dst = ZRegisterFrom(locations->Out());
+  const PRegisterM p_reg = GetVecGoverningPReg(instruction).Merging();
+  ValidateVectorLength(instruction);
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kUint8:
+      __ Umin(dst.VnB(), p_reg, lhs.VnB(), rhs.VnB());
+      break;
+    case DataType::Type::kInt8:
+      __ Smin(dst.VnB(), p_reg, lhs.VnB(), rhs.VnB());
+      break;
+    case DataType::Type::kUint16:
+      __ Umin(dst.VnH(), p_reg, lhs.VnH(), rhs.VnH());
+      break;
+    case DataType::Type::kInt16:
+      __ Smin(dst.VnH(), p_reg, lhs.VnH(), rhs.VnH());
+      break;
+    case DataType::Type::kUint32:
+      __ Umin(dst.VnS(), p_reg, lhs.VnS(), rhs.VnS());
+      break;
+    case DataType::Type::kInt32:
+      __ Smin(dst.VnS(), p_reg, lhs.VnS(), rhs.VnS());
+      break;
+    case DataType::Type::kInt64:
+      __ Smin(dst.VnD(), p_reg, lhs.VnD(), rhs.VnD());
+      break;
+    case DataType::Type::kFloat32:
+      __ Fmin(dst.VnS(), p_reg, lhs.VnS(), rhs.VnS(), StrictNaNPropagation);
+      break;
+    case DataType::Type::kFloat64:
+      __ Fmin(dst.VnD(), p_reg, lhs.VnD(), rhs.VnD(), StrictNaNPropagation);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
 }
 
 void LocationsBuilderARM64Sve::VisitVecMax(HVecMax* instruction) {
-  LOG(FATAL) << "Unsupported SIMD instruction " << instruction->GetId();
-  UNREACHABLE();
+  CreateVecBinOpLocations(GetGraph()->GetAllocator(), instruction);
 }
 
 void InstructionCodeGeneratorARM64Sve::VisitVecMax(HVecMax* instruction) {
-  LOG(FATAL) << "Unsupported SIMD instruction " << instruction->GetId();
-  UNREACHABLE();
+  DCHECK(instruction->IsPredicated());
+  LocationSummary* locations = instruction->GetLocations();
+  const ZRegister lhs = ZRegisterFrom(locations->InAt(0));
+  const ZRegister rhs = ZRegisterFrom(locations->InAt(1));
+  const ZRegister dst = ZRegisterFrom(locations->Out());
+  const PRegisterM p_reg = GetVecGoverningPReg(instruction).Merging();
+  ValidateVectorLength(instruction);
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kUint8:
+      __ Umax(dst.VnB(), p_reg, lhs.VnB(), rhs.VnB());
+      break;
+    case DataType::Type::kInt8:
+      __ Smax(dst.VnB(), p_reg, lhs.VnB(), rhs.VnB());
+      break;
+    case DataType::Type::kUint16:
+      __ Umax(dst.VnH(), p_reg, lhs.VnH(), rhs.VnH());
+      break;
+    case DataType::Type::kInt16:
+      __ Smax(dst.VnH(), p_reg, lhs.VnH(), rhs.VnH());
+      break;
+    case DataType::Type::kUint32:
+      __ Umax(dst.VnS(), p_reg, lhs.VnS(), rhs.VnS());
+      break;
+    case DataType::Type::kInt32:
+      __ Smax(dst.VnS(), p_reg, lhs.VnS(), rhs.VnS());
+      break;
+    case DataType::Type::kInt64:
+      __ Smax(dst.VnD(), p_reg, lhs.VnD(), rhs.VnD());
+      break;
+    case DataType::Type::kFloat32:
+      __ Fmax(dst.VnS(), p_reg, lhs.VnS(), rhs.VnS(), StrictNaNPropagation);
+      break;
+    case DataType::Type::kFloat64:
+      __ Fmax(dst.VnD(), p_reg, lhs.VnD(), rhs.VnD(), StrictNaNPropagation);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
 }
 
 void LocationsBuilderARM64Sve::VisitVecAnd(HVecAnd* instruction) {
@@ -64,6 +64,9 @@ static constexpr size_t kRuntimeParameterFpuRegistersLength =
   V(CRC32Update)                            \
   V(CRC32UpdateBytes)                       \
   V(CRC32UpdateByteBuffer)                  \
+  V(CRC32CUpdateBytes)                      \
+  V(CRC32CUpdateDirectByteBuffer)           \
+  V(ArraysEqualsByte)                       \
   V(FP16ToFloat)                            \
   V(FP16ToHalf)                             \
   V(FP16Floor)                              \
@@ -77,6 +80,19 @@ static constexpr size_t kRuntimeParameterFpuRegistersLength =
   V(FP16Min)                                \
   V(FP16Max)                                \
   V(MathMultiplyHigh)                       \
+  V(LongValueOf)                            \
+  V(UnsafeGetByteAbsolute)                  \
+  V(UnsafeGetAbsolute)                      \
+  V(UnsafeGetLongAbsolute)                  \
+  V(UnsafePutByteAbsolute)                  \
+  V(UnsafePutAbsolute)                      \
+  V(UnsafePutLongAbsolute)                  \
+  V(JdkUnsafeGetByteAbsolute)               \
+  V(JdkUnsafeGetAbsolute)                   \
+  V(JdkUnsafeGetLongAbsolute)               \
+  V(JdkUnsafePutByteAbsolute)               \
+  V(JdkUnsafePutAbsolute)                   \
+  V(JdkUnsafePutLongAbsolute)               \
   V(StringStringIndexOf)                    \
   V(StringStringIndexOfAfter)               \
   V(StringBufferAppend)                     \
@@ -63,6 +63,8 @@ static constexpr FloatRegister non_volatile_xmm_regs[] = { XMM12, XMM13, XMM14,
   V(CRC32Update)                               \
   V(CRC32UpdateBytes)                          \
   V(CRC32UpdateByteBuffer)                     \
+  V(CRC32CUpdateBytes)                         \
+  V(CRC32CUpdateDirectByteBuffer)              \
   V(FP16ToFloat)                               \
   V(FP16ToHalf)                                \
   V(FP16Floor)                                 \
@@ -16,6 +16,7 @@
 
 #include "code_sinking.h"
 
+#include <limits>
 #include <sstream>
 
 #include "android-base/logging.h"
@@ -45,8 +46,7 @@ bool CodeSinking::Run() {
 void CodeSinking::UncommonBranchSinking() {
   HBasicBlock* exit = graph_->GetExitBlock();
   DCHECK(exit != nullptr);
-  // TODO(ngeoffray): we do not profile branches yet, so use throw instructions
-  // as an indicator of an uncommon branch.
+  // Use throw instructions as an indicator of an uncommon branch.
   for (HBasicBlock* exit_predecessor : exit->GetPredecessors()) {
     HInstruction* last = exit_predecessor->GetLastInstruction();
 
@@ -71,6 +71,39 @@ void CodeSinking::UncommonBranchSinking() {
       SinkCodeToUncommonBranch(exit_predecessor);
     }
   }
+
+  // Branches that the profile shows to be rarely taken are uncommon too. This moves
+  // allocations that only escape there, for example to a logging call, out of the
+  // common path. Load store elimination has already replaced their loads on that path.
+  for (HBasicBlock* block : graph_->GetReversePostOrder()) {
+    if (block->EndsWithIf()) {
+      HBasicBlock* uncommon_successor =
+          GetProfiledUncommonSuccessor(block->GetLastInstruction()->AsIf());
+      if (uncommon_successor != nullptr) {
+        SinkCodeToUncommonBranch(uncommon_successor, /* is_profiled_branch= */ true);
+      }
+    }
+  }
+}
+
+HBasicBlock* CodeSinking::GetProfiledUncommonSuccessor(HIf* if_instruction) {
+  uint32_t true_count = if_instruction->GetTrueCount();
+  uint32_t false_count = if_instruction->GetFalseCount();
+  if (true_count == std::numeric_limits<uint16_t>::max() &&
+      false_count == std::numeric_limits<uint16_t>::max()) {
+    // No profiling data.
+    return nullptr;
+  }
+  uint32_t total_count = true_count + false_count;
+  if (total_count < kMinimumProfiledBranchCount) {
+    return nullptr;
+  }
+  if (true_count * kUncommonBranchRatio <= total_count) {
+    return if_instruction->IfTrueSuccessor();
+  } else if (false_count * kUncommonBranchRatio <= total_count) {
+    return if_instruction->IfFalseSuccessor();
+  }
+  return nullptr;
 }
 
 static bool IsInterestingInstruction(HInstruction* instruction) {
@@ -327,7 +360,7 @@ static HInstruction* FindIdealPosition(HInstruction* instruction,
 }
 
 
-void CodeSinking::SinkCodeToUncommonBranch(HBasicBlock* end_block) {
+void CodeSinking::SinkCodeToUncommonBranch(HBasicBlock* end_block, bool is_profiled_branch) {
   // Local allocator to discard data structures created below at the end of this optimization.
   ScopedArenaAllocator allocator(graph_->GetArenaStack());
 
@@ -338,13 +371,17 @@ void CodeSinking::SinkCodeToUncommonBranch(HBasicBlock* end_block) {
   ArenaBitVector post_dominated(&allocator, graph_->GetBlocks().size(), /* expandable= */ false);
 
   // Step (1): Visit post order to get a subset of blocks post dominated by `end_block`.
+  // For a profiled branch, `end_block` starts the uncommon branch and we take the
+  // blocks it dominates instead.
   // TODO(ngeoffray): Getting the full set of post-dominated should be done by
-  // computing the post dominator tree, but that could be too time consuming. Also,
-  // we should start the analysis from blocks dominated by an uncommon branch, but we
-  // don't profile branches yet.
+  // computing the post dominator tree, but that could be too time consuming.
   bool found_block = false;
   for (HBasicBlock* block : graph_->GetPostOrder()) {
-    if (block == end_block) {
+    if (is_profiled_branch) {
+      if (end_block->Dominates(block)) {
+        post_dominated.SetBit(block->GetBlockId());
+      }
+    } else if (block == end_block) {
       found_block = true;
       post_dominated.SetBit(block->GetBlockId());
     } else if (found_block) {
@@ -572,6 +609,13 @@ void CodeSinking::SinkCodeToUncommonBranch(HBasicBlock* end_block) {
     if (!post_dominated.IsBitSet(position->GetBlock()->GetBlockId())) {
       continue;
     }
+    // A profiled branch does not leave the method, so it may be executed several times
+    // for each execution of `instruction` if it is in another loop.
+    if (is_profiled_branch &&
+        position->GetBlock()->GetLoopInformation() !=
+            instruction->GetBlock()->GetLoopInformation()) {
+      continue;
+    }
     MaybeRecordStat(stats_, MethodCompilationStat::kInstructionSunk);
     instruction->MoveBefore(position, /* do_checks= */ false);
   }
@@ -38,12 +38,23 @@ class CodeSinking : public HOptimization {
 
   static constexpr const char* kCodeSinkingPassName = "code_sinking";
 
+  // Returns the successor of `if_instruction` that the profile shows to be rarely taken,
+  // or null if there is none or not enough profiling data.
+  static HBasicBlock* GetProfiledUncommonSuccessor(HIf* if_instruction);
+
  private:
   // Tries to sink code to uncommon branches.
   void UncommonBranchSinking();
   // Tries to move code only used by `end_block` and all its post-dominated / dominated
-  // blocks, to these blocks.
-  void SinkCodeToUncommonBranch(HBasicBlock* end_block);
+  // blocks, to these blocks. If `is_profiled_branch`, `end_block` is the first block of
+  // a branch that the profile shows to be rarely taken, and we only consider the blocks
+  // it dominates.
+  void SinkCodeToUncommonBranch(HBasicBlock* end_block, bool is_profiled_branch = false);
+
+  // A profiled branch is uncommon if it is taken at most once every `kUncommonBranchRatio`
+  // times, out of at least `kMinimumProfiledBranchCount` executions.
+  static constexpr uint32_t kUncommonBranchRatio = 100;
+  static constexpr uint32_t kMinimumProfiledBranchCount = 1000;
 
   // Coalesces the Return/ReturnVoid instructions into one, if we have two or more. We do this to
   // avoid generating the exit frame code several times.
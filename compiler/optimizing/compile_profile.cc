@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "compile_profile.h"
+
+#include <sstream>
+
+#include "base/arena_allocator.h"
+#include "base/scoped_arena_allocator.h"
+#include "base/time_utils.h"
+#include "nodes.h"
+#include "thread-current-inl.h"
+
+namespace art HIDDEN {
+
+// Write `str` as a JSON string. Method names do not contain control characters.
+static void DumpJsonString(std::ostream& os, std::string_view str) {
+  os << '"';
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      os << '\\';
+    }
+    os << c;
+  }
+  os << '"';
+}
+
+MethodCompileProfile::MethodCompileProfile(HGraph* graph)
+    : graph_(graph),
+      start_ns_(NanoTime()),
+      passes_(),
+      inlining_decisions_(),
+      pass_start_ns_(0u),
+      pass_start_arena_bytes_(0u) {}
+
+MethodCompileProfile::GraphSize MethodCompileProfile::ComputeGraphSize() const {
+  GraphSize size = {0u, 0u};
+  for (HBasicBlock* block : graph_->GetBlocks()) {
+    if (block == nullptr) {
+      continue;
+    }
+    ++size.blocks;
+    for (HInstructionIterator it(block->GetPhis()); !it.Done(); it.Advance()) {
+      ++size.instructions;
+    }
+    for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+      ++size.instructions;
+    }
+  }
+  return size;
+}
+
+void MethodCompileProfile::StartPass(const char* pass_name) {
+  passes_.push_back({pass_name, 0u, 0u, ComputeGraphSize(), {0u, 0u}});
+  pass_start_arena_bytes_ = graph_->GetAllocator()->BytesUsed();
+  pass_start_ns_ = NanoTime();
+}
+
+void MethodCompileProfile::EndPass() {
+  uint64_t end_ns = NanoTime();
+  DCHECK(!passes_.empty());
+  PassRecord& pass = passes_.back();
+  pass.time_ns = end_ns - pass_start_ns_;
+  pass.arena_bytes = graph_->GetAllocator()->BytesUsed() - pass_start_arena_bytes_;
+  pass.size_after = ComputeGraphSize();
+}
+
+void MethodCompileProfile::AddInliningDecision(MethodReference callee,
+                                               uint32_t dex_pc,
+                                               size_t depth,
+                                               bool inlined,
+                                               std::optional<MethodCompilationStat> failure) {
+  inlining_decisions_.push_back({callee, dex_pc, depth, inlined, failure});
+}
+
+void MethodCompileProfile::Dump(std::ostream& os, const std::string& method_name) const {
+  os << "{\"method\":";
+  DumpJsonString(os, method_name);
+  os << ",\"kind\":\"" << graph_->GetCompilationKind() << '"'
+     << ",\"total_ns\":" << (NanoTime() - start_ns_)
+     << ",\"arena_bytes\":" << graph_->GetAllocator()->BytesUsed()
+     << ",\"arena_stack_peak_bytes\":" << graph_->GetArenaStack()->ApproximatePeakBytes()
+     << ",\"passes\":[";
+  const char* separator = "";
+  for (const PassRecord& pass : passes_) {
+    os << separator << "{\"name\":";
+    DumpJsonString(os, pass.name);
+    os << ",\"ns\":" << pass.time_ns
+       << ",\"arena_bytes\":" << pass.arena_bytes
+       << ",\"blocks_before\":" << pass.size_before.blocks
+       << ",\"instructions_before\":" << pass.size_before.instructions
+       << ",\"blocks_after\":" << pass.size_after.blocks
+       << ",\"instructions_after\":" << pass.size_after.instructions << '}';
+    separator = ",";
+  }
+  os << "],\"inlining\":[";
+  separator = "";
+  for (const InliningDecision& decision : inlining_decisions_) {
+    os << separator << "{\"callee\":";
+    DumpJsonString(os, decision.callee.PrettyMethod());
+    os << ",\"dex_pc\":" << decision.dex_pc
+       << ",\"depth\":" << decision.depth
+       << ",\"inlined\":" << (decision.inlined ? "true" : "false");
+    if (decision.failure.has_value()) {
+      os << ",\"reason\":\"" << decision.failure.value() << '"';
+    }
+    os << '}';
+    separator = ",";
+  }
+  os << "]}\n";
+}
+
+CompileProfileWriter::CompileProfileWriter(const std::string& file_name)
+    : lock_("compile profile writer lock"),
+      output_(file_name, std::ofstream::app) {}
+
+void CompileProfileWriter::Write(const MethodCompileProfile& profile,
+                                 const std::string& method_name) {
+  // Format outside of the lock, the profiles of large methods are long.
+  std::ostringstream oss;
+  profile.Dump(oss, method_name);
+  MutexLock mu(Thread::Current(), lock_);
+  output_ << oss.str();
+  output_.flush();
+}
+
+}  // namespace art
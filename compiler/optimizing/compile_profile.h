@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_COMPILE_PROFILE_H_
+#define ART_COMPILER_OPTIMIZING_COMPILE_PROFILE_H_
+
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/mutex.h"
+#include "dex/method_reference.h"
+#include "optimizing_compiler_stats.h"
+
+namespace art HIDDEN {
+
+class HGraph;
+
+// Profile of the compilation of one method, written with --dump-compile-profile.
+// It records the time, the arena memory and the graph size of each pass, and the
+// decisions of the inliner, so that the methods which dominate the compile time of
+// dex2oat or the latency of the JIT can be found in release builds.
+class MethodCompileProfile {
+ public:
+  explicit MethodCompileProfile(HGraph* graph);
+
+  void StartPass(const char* pass_name);
+  void EndPass();
+
+  // Record whether the inliner inlined the call to `callee` at `dex_pc` and, if not,
+  // the last reason it gave for failing.
+  void AddInliningDecision(MethodReference callee,
+                           uint32_t dex_pc,
+                           size_t depth,
+                           bool inlined,
+                           std::optional<MethodCompilationStat> failure);
+
+  // Write the profile as a single line of JSON.
+  void Dump(std::ostream& os, const std::string& method_name) const;
+
+ private:
+  struct GraphSize {
+    size_t blocks;
+    size_t instructions;
+  };
+
+  struct PassRecord {
+    const char* name;
+    uint64_t time_ns;
+    size_t arena_bytes;
+    GraphSize size_before;
+    GraphSize size_after;
+  };
+
+  struct InliningDecision {
+    MethodReference callee;
+    uint32_t dex_pc;
+    size_t depth;
+    bool inlined;
+    std::optional<MethodCompilationStat> failure;
+  };
+
+  GraphSize ComputeGraphSize() const;
+
+  HGraph* const graph_;
+  const uint64_t start_ns_;
+  std::vector<PassRecord> passes_;
+  std::vector<InliningDecision> inlining_decisions_;
+
+  // The start time and arena usage of the current pass.
+  uint64_t pass_start_ns_;
+  size_t pass_start_arena_bytes_;
+
+  DISALLOW_COPY_AND_ASSIGN(MethodCompileProfile);
+};
+
+// Appends the profiles of all compiled methods to a file. Methods are compiled
+// by several threads, so each profile is written as one line under a lock.
+class CompileProfileWriter {
+ public:
+  explicit CompileProfileWriter(const std::string& file_name);
+
+  void Write(const MethodCompileProfile& profile, const std::string& method_name)
+      REQUIRES(!lock_);
+
+ private:
+  Mutex lock_;
+  std::ofstream output_ GUARDED_BY(lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(CompileProfileWriter);
+};
+
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_COMPILE_PROFILE_H_
@@ -25,6 +25,20 @@
 
 namespace art HIDDEN {
 
+// Returns whether `instruction` may read the field `field`. Field loads only read
+// their own field, and fields at different offsets never alias.
+static bool MayReadField(HInstruction* instruction, const FieldInfo& field) {
+  const FieldInfo* read_field = nullptr;
+  if (instruction->IsInstanceFieldGet()) {
+    read_field = &instruction->AsInstanceFieldGet()->GetFieldInfo();
+  } else if (instruction->IsStaticFieldGet()) {
+    read_field = &instruction->AsStaticFieldGet()->GetFieldInfo();
+  } else {
+    return true;
+  }
+  return read_field->GetFieldOffset() == field.GetFieldOffset();
+}
+
 /**
  * A ValueSet holds instructions that can replace other instructions. It is updated
  * through the `Add` method, and the `Kill` method. The `Kill` method removes
@@ -130,6 +144,28 @@ class ValueSet : public ArenaObject<kArenaAllocGvn> {
     });
   }
 
+  // Removes all instructions in the set affected by a non-volatile store to `field`.
+  // Unlike `Kill()`, this keeps the loads of other fields of the same type.
+  void KillFieldWrite(const FieldInfo& field) {
+    DCHECK(!field.IsVolatile());
+    SideEffects side_effects =
+        SideEffects::FieldWriteOfType(field.GetFieldType(), /* is_volatile= */ false);
+    DeleteAllImpureWhich([side_effects, &field](Node* node) {
+      return node->GetSideEffects().MayDependOn(side_effects) &&
+             MayReadField(node->GetInstruction(), field);
+    });
+  }
+
+  // Removes all instructions in the set affected by `instruction`.
+  void KillEffectsOf(HInstruction* instruction) {
+    const FieldInfo* field = GetNonVolatileFieldWrite(instruction);
+    if (field != nullptr) {
+      KillFieldWrite(*field);
+    } else {
+      Kill(instruction->GetSideEffects());
+    }
+  }
+
   void Clear() {
     num_entries_ = 0;
     for (size_t i = 0; i < num_buckets_; ++i) {
@@ -467,7 +503,10 @@ void GlobalValueNumberer::VisitBasicBlock(HBasicBlock* block) {
         } else {
           DCHECK(!block->GetLoopInformation()->IsIrreducible());
           DCHECK_EQ(block->GetDominator(), block->GetLoopInformation()->GetPreHeader());
-          set->Kill(side_effects_.GetLoopEffects(block));
+          set->Kill(side_effects_.GetLoopEffectsExceptFieldWrites(block));
+          for (const FieldInfo* field : side_effects_.GetLoopFieldWrites(block)) {
+            set->KillFieldWrite(*field);
+          }
         }
       } else if (predecessors.size() > 1) {
         for (HBasicBlock* predecessor : predecessors) {
@@ -509,11 +548,11 @@ void GlobalValueNumberer::VisitBasicBlock(HBasicBlock* block) {
         current->ReplaceWith(existing);
         current->GetBlock()->RemoveInstruction(current);
       } else {
-        set->Kill(current->GetSideEffects());
+        set->KillEffectsOf(current);
         set->Add(current);
       }
     } else {
-      set->Kill(current->GetSideEffects());
+      set->KillEffectsOf(current);
     }
     current = next;
   }
@@ -200,6 +200,64 @@ TEST_F(GVNTest, LoopSideEffects) {
     ASSERT_FALSE(side_effects.GetBlockEffects(outer_loop_body).DoesAnyWrite());
     ASSERT_TRUE(side_effects.GetLoopEffects(outer_loop_header).DoesAnyWrite());
     ASSERT_TRUE(side_effects.GetLoopEffects(inner_loop_header).DoesAnyWrite());
+    ASSERT_EQ(side_effects.GetLoopFieldWrites(outer_loop_header).size(), 1u);
+    ASSERT_EQ(side_effects.GetLoopFieldWrites(inner_loop_header).size(), 1u);
+    ASSERT_FALSE(side_effects.GetLoopEffectsExceptFieldWrites(outer_loop_header).DoesAnyWrite());
+    ASSERT_FALSE(side_effects.GetLoopEffectsExceptFieldWrites(inner_loop_header).DoesAnyWrite());
   }
 }
+
+// Test that a field store only kills the loads of fields at the same offset.
+TEST_F(GVNTest, LocalFieldSensitiveElimination) {
+  HBasicBlock* block = InitEntryMainExitGraphWithReturnVoid();
+
+  HInstruction* parameter = MakeParam(DataType::Type::kReference);
+  HInstruction* value = MakeParam(DataType::Type::kInt32);
+
+  MakeIFieldGet(block, parameter, DataType::Type::kInt32, MemberOffset(40));
+  MakeIFieldGet(block, parameter, DataType::Type::kInt32, MemberOffset(44));
+  MakeIFieldSet(block, parameter, value, DataType::Type::kInt32, MemberOffset(40));
+  HInstruction* same_field =
+      MakeIFieldGet(block, parameter, DataType::Type::kInt32, MemberOffset(40));
+  HInstruction* other_field =
+      MakeIFieldGet(block, parameter, DataType::Type::kInt32, MemberOffset(44));
+
+  graph_->BuildDominatorTree();
+  SideEffectsAnalysis side_effects(graph_);
+  side_effects.Run();
+  GVNOptimization(graph_, side_effects).Run();
+
+  ASSERT_EQ(same_field->GetBlock(), block);
+  ASSERT_TRUE(other_field->GetBlock() == nullptr);
+}
+
+// Test that a field store in a loop does not kill the loads of other fields of the same type.
+TEST_F(GVNTest, LoopFieldSensitiveElimination) {
+  HBasicBlock* return_block = InitEntryMainExitGraphWithReturnVoid();
+  auto [pre_header, loop_header, loop_body] = CreateWhileLoop(return_block);
+  loop_header->SwapSuccessors();  // Move the loop exit to the "else" successor.
+
+  HInstruction* parameter = MakeParam(DataType::Type::kReference);
+  HInstruction* value = MakeParam(DataType::Type::kInt32);
+
+  MakeIFieldGet(pre_header, parameter, DataType::Type::kInt32, MemberOffset(40));
+  MakeIFieldGet(pre_header, parameter, DataType::Type::kInt32, MemberOffset(44));
+
+  HInstruction* condition = MakeParam(DataType::Type::kBool);
+  MakeIf(loop_header, condition);
+
+  HInstruction* written_field =
+      MakeIFieldGet(loop_body, parameter, DataType::Type::kInt32, MemberOffset(40));
+  HInstruction* other_field =
+      MakeIFieldGet(loop_body, parameter, DataType::Type::kInt32, MemberOffset(44));
+  MakeIFieldSet(loop_body, parameter, value, DataType::Type::kInt32, MemberOffset(40));
+
+  graph_->BuildDominatorTree();
+  SideEffectsAnalysis side_effects(graph_);
+  side_effects.Run();
+  GVNOptimization(graph_, side_effects).Run();
+
+  ASSERT_EQ(written_field->GetBlock(), loop_body);
+  ASSERT_TRUE(other_field->GetBlock() == nullptr);
+}
 }  // namespace art
@@ -16,12 +16,17 @@
 
 #include "inliner.h"
 
+#include <algorithm>
+
 #include "art_method-inl.h"
 #include "base/logging.h"
 #include "base/pointer_size.h"
+#include "base/scoped_arena_allocator.h"
+#include "base/scoped_arena_containers.h"
 #include "builder.h"
 #include "class_linker.h"
 #include "class_root-inl.h"
+#include "compile_profile.h"
 #include "constant_folding.h"
 #include "data_type-inl.h"
 #include "dead_code_elimination.h"
@@ -70,6 +75,16 @@ static constexpr size_t kMaximumNumberOfRecursiveCalls = 4;
 // recursive calls at all.
 static constexpr size_t kMaximumNumberOfPolymorphicRecursiveCalls = 0;
 
+// Minimum number of types of a megamorphic inline cache that must dispatch to the same method
+// for us to inline it. Once the cache is full, its last entry keeps the most recently seen type,
+// so a frequently seen target tends to show up there in addition to the first types recorded.
+static constexpr size_t kMegamorphicMinDominantTypes = 3;
+
+// When ranking call sites, each loop level around a call site makes it this many
+// times (as a power of two) hotter, up to the given depth.
+static constexpr size_t kLoopDepthHotnessShift = 3;
+static constexpr size_t kMaximumRankedLoopDepth = 4;
+
 // Controls the use of inline caches in AOT mode.
 static constexpr bool kUseAOTInlineCaches = true;
 
@@ -86,7 +101,8 @@ static constexpr bool kInlineTryCatches = true;
 #define LOG_TRY() LOG_INTERNAL("Try inlinining call: ")
 #define LOG_NOTE() LOG_INTERNAL("Note: ")
 #define LOG_SUCCESS() LOG_INTERNAL("Success: ")
-#define LOG_FAIL(stats_ptr, stat) MaybeRecordStat(stats_ptr, stat); LOG_INTERNAL("Fail: ")
+#define LOG_FAIL(stats_ptr, stat) \
+  MaybeRecordStat(stats_ptr, stat); last_failure_ = stat; LOG_INTERNAL("Fail: ")
 #define LOG_FAIL_NO_STAT() LOG_INTERNAL("Fail: ")
 
 std::string HInliner::DepthString(int line) const {
@@ -169,40 +185,97 @@ bool HInliner::Run() {
       Runtime::Current()->IsAotCompiler() &&
       !graph_->IsCompilingBaseline();
 
+  MethodCompileProfile* compile_profile = outermost_graph_->GetCompileProfile();
+  auto try_inline_and_record = [&](HInvoke* call) {
+    if (compile_profile == nullptr) {
+      return TryInline(call);
+    }
+    // Read the call site before inlining, `call` is removed from the graph when inlined.
+    MethodReference callee = call->GetMethodReference();
+    uint32_t dex_pc = call->GetDexPc();
+    last_failure_.reset();
+    bool inlined = TryInline(call);
+    compile_profile->AddInliningDecision(callee, dex_pc, depth_, inlined, last_failure_);
+    return inlined;
+  };
+  auto try_inline = [&](HInvoke* call) {
+    if (honor_noinline_directives) {
+      // Debugging case: directives in method names control or assert on inlining.
+      std::string callee_name =
+          call->GetMethodReference().PrettyMethod(/* with_signature= */ false);
+      // Tests prevent inlining by having $noinline$ in their method names.
+      if (callee_name.find("$noinline$") == std::string::npos) {
+        if (try_inline_and_record(call)) {
+          did_inline = true;
+        } else if (honor_inline_directives) {
+          bool should_have_inlined = (callee_name.find("$inline$") != std::string::npos);
+          CHECK(!should_have_inlined) << "Could not inline " << callee_name;
+        }
+      }
+    } else {
+      DCHECK(!honor_inline_directives);
+      // Normal case: try to inline.
+      if (try_inline_and_record(call)) {
+        did_inline = true;
+      }
+    }
+  };
+
   // Keep a copy of all blocks when starting the visit.
   ArenaVector<HBasicBlock*> blocks = graph_->GetReversePostOrder();
   DCHECK(!blocks.empty());
-  // Because we are changing the graph when inlining,
-  // we just iterate over the blocks of the outer method.
-  // This avoids doing the inlining work again on the inlined blocks.
-  for (HBasicBlock* block : blocks) {
-    for (HInstruction* instruction = block->GetFirstInstruction(); instruction != nullptr;) {
-      HInstruction* next = instruction->GetNext();
-      HInvoke* call = instruction->AsInvokeOrNull();
-      // As long as the call is not intrinsified, it is worth trying to inline.
-      if (call != nullptr && !codegen_->IsImplementedIntrinsic(call)) {
-        if (honor_noinline_directives) {
-          // Debugging case: directives in method names control or assert on inlining.
-          std::string callee_name =
-              call->GetMethodReference().PrettyMethod(/* with_signature= */ false);
-          // Tests prevent inlining by having $noinline$ in their method names.
-          if (callee_name.find("$noinline$") == std::string::npos) {
-            if (TryInline(call)) {
-              did_inline = true;
-            } else if (honor_inline_directives) {
-              bool should_have_inlined = (callee_name.find("$inline$") != std::string::npos);
-              CHECK(!should_have_inlined) << "Could not inline " << callee_name;
-            }
-          }
-        } else {
-          DCHECK(!honor_inline_directives);
-          // Normal case: try to inline.
-          if (TryInline(call)) {
-            did_inline = true;
+  if (ShouldRankCallSites()) {
+    // Spend the instruction budget on the call sites where the profile says it matters
+    // most, instead of on the first call sites in the method. Call sites that were not
+    // executed while profiling only inline small methods.
+    ScopedArenaAllocator allocator(graph_->GetArenaStack());
+    ScopedArenaVector<CallSite> call_sites(allocator.Adapter(kArenaAllocMisc));
+    {
+      ScopedObjectAccess soa(Thread::Current());
+      for (HBasicBlock* block : blocks) {
+        for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+          HInvoke* call = it.Current()->AsInvokeOrNull();
+          if (call != nullptr && !codegen_->IsImplementedIntrinsic(call)) {
+            bool is_cold = false;
+            uint64_t priority = GetCallSitePriority(call, &is_cold);
+            call_sites.push_back({call, priority, is_cold});
           }
         }
       }
-      instruction = next;
+    }
+    std::stable_sort(call_sites.begin(),
+                     call_sites.end(),
+                     [](const CallSite& lhs, const CallSite& rhs) {
+                       return lhs.priority > rhs.priority;
+                     });
+    for (const CallSite& call_site : call_sites) {
+      // A call site can be removed when inlining another one, for example if it was
+      // devirtualized and replaced.
+      if (call_site.invoke->GetBlock() == nullptr) {
+        continue;
+      }
+      MaybeRecordStat(stats_, MethodCompilationStat::kRankedInlineCallSite);
+      if (call_site.is_cold) {
+        MaybeRecordStat(stats_, MethodCompilationStat::kColdInlineCallSite);
+        inlining_budget_ = kMaximumNumberOfInstructionsForSmallMethod;
+      }
+      try_inline(call_site.invoke);
+      UpdateInliningBudget();
+    }
+  } else {
+    // Because we are changing the graph when inlining,
+    // we just iterate over the blocks of the outer method.
+    // This avoids doing the inlining work again on the inlined blocks.
+    for (HBasicBlock* block : blocks) {
+      for (HInstruction* instruction = block->GetFirstInstruction(); instruction != nullptr;) {
+        HInstruction* next = instruction->GetNext();
+        HInvoke* call = instruction->AsInvokeOrNull();
+        // As long as the call is not intrinsified, it is worth trying to inline.
+        if (call != nullptr && !codegen_->IsImplementedIntrinsic(call)) {
+          try_inline(call);
+        }
+        instruction = next;
+      }
     }
   }
 
@@ -228,6 +301,73 @@ bool HInliner::Run() {
   return did_inline || graph_->HasAlwaysThrowingInvokes();
 }
 
+bool HInliner::ShouldRankCallSites() const {
+  if (graph_ != outermost_graph_ ||
+      !Runtime::Current()->IsAotCompiler() ||
+      graph_->IsCompilingBaseline()) {
+    return false;
+  }
+  const ProfileCompilationInfo* pci = codegen_->GetCompilerOptions().GetProfileCompilationInfo();
+  if (pci == nullptr) {
+    return false;
+  }
+  ProfileCompilationInfo::MethodHotness hotness = pci->GetMethodHotness(MethodReference(
+      caller_compilation_unit_.GetDexFile(), caller_compilation_unit_.GetDexMethodIndex()));
+  return hotness.IsHot();
+}
+
+uint64_t HInliner::GetCallSitePriority(HInvoke* invoke, /*out*/ bool* is_cold) const {
+  *is_cold = false;
+  // Call sites in loops are expected to run more often.
+  size_t loop_depth = 0u;
+  for (HLoopInformation* loop_info = invoke->GetBlock()->GetLoopInformation();
+       loop_info != nullptr;
+       loop_info = loop_info->GetPreHeader()->GetLoopInformation()) {
+    ++loop_depth;
+  }
+  uint64_t hotness = uint64_t{1}
+      << (kLoopDepthHotnessShift * std::min(loop_depth, kMaximumRankedLoopDepth));
+
+  if (invoke->IsInvokeVirtual() || invoke->IsInvokeInterface()) {
+    // The profile has an inline cache for each virtual or interface call executed while
+    // profiling.
+    const ProfileCompilationInfo* pci = codegen_->GetCompilerOptions().GetProfileCompilationInfo();
+    ProfileCompilationInfo::MethodHotness method_hotness = pci->GetMethodHotness(MethodReference(
+        caller_compilation_unit_.GetDexFile(), caller_compilation_unit_.GetDexMethodIndex()));
+    const ProfileCompilationInfo::InlineCacheMap* inline_caches =
+        method_hotness.GetInlineCacheMap();
+    DCHECK(inline_caches != nullptr);
+    const auto it = inline_caches->find(invoke->GetDexPc());
+    if (it == inline_caches->end()) {
+      // A missing inline cache only means the call was not executed if one would have
+      // been recorded for it. Otherwise we know nothing beyond the loop depth.
+      if (ProfilingInfoBuilder::CanHaveInlineCache(invoke, codegen_)) {
+        *is_cold = true;
+        return 0u;
+      }
+    } else {
+      const ProfileCompilationInfo::DexPcData& dex_pc_data = it->second;
+      if (!dex_pc_data.is_megamorphic &&
+          !dex_pc_data.is_missing_types &&
+          dex_pc_data.classes.size() == 1u) {
+        // Inlining a monomorphic call also saves the virtual dispatch.
+        hotness *= 2u;
+      }
+    }
+  }
+
+  // The smaller the callee, the more of the call overhead we save per inlined instruction.
+  size_t code_units = kMaximumNumberOfTotalInstructions;
+  ArtMethod* method = invoke->GetResolvedMethod();
+  if (method != nullptr) {
+    CodeItemDataAccessor accessor(method->DexInstructionData());
+    if (accessor.HasCodeItem()) {
+      code_units = accessor.InsnsSizeInCodeUnits();
+    }
+  }
+  return hotness * kMaximumNumberOfTotalInstructions / (code_units + 1u);
+}
+
 static bool IsMethodOrDeclaringClassFinal(ArtMethod* method)
     REQUIRES_SHARED(Locks::mutator_lock_) {
   return method->IsFinal() || method->GetDeclaringClass()->IsFinal();
@@ -375,6 +515,10 @@ ArtMethod* HInliner::FindMethodFromCHA(ArtMethod* resolved_method) {
     // We do not support HDeoptimize in OSR methods.
     return nullptr;
   }
+  if (!outermost_graph_->ShouldSpeculate(DeoptimizationKind::kCHA)) {
+    // The CHA guards of the method kept failing.
+    return nullptr;
+  }
   PointerSize pointer_size = caller_compilation_unit_.GetClassLinker()->GetImagePointerSize();
   ArtMethod* single_impl = resolved_method->GetSingleImplementation(pointer_size);
   if (single_impl == nullptr) {
@@ -621,7 +765,12 @@ bool HInliner::UseOnlyPolymorphicInliningWithNoDeopt() {
   //
   // For OSR:
   //     We may come from the interpreter and it may have seen different receiver types.
-  return Runtime::Current()->IsAotCompiler() || outermost_graph_->IsCompilingOsr();
+  //
+  // For methods whose inline cache checks kept deoptimizing:
+  //     The deopts updated the inline caches, but the receiver types keep changing.
+  return Runtime::Current()->IsAotCompiler() ||
+         outermost_graph_->IsCompilingOsr() ||
+         !outermost_graph_->ShouldSpeculate(DeoptimizationKind::kJitInlineCache);
 }
 bool HInliner::TryInlineFromInlineCache(HInvoke* invoke_instruction)
     REQUIRES_SHARED(Locks::mutator_lock_) {
@@ -668,6 +817,10 @@ bool HInliner::TryInlineFromInlineCache(HInvoke* invoke_instruction)
     }
 
     case kInlineCacheMegamorphic: {
+      if (TryInlinePolymorphicCallToSameTarget(
+              invoke_instruction, classes, /* is_megamorphic= */ true)) {
+        return true;
+      }
       LOG_FAIL_NO_STAT()
           << "Interface or virtual call to "
           << invoke_instruction->GetMethodReference().PrettyMethod()
@@ -1202,7 +1355,8 @@ void HInliner::CreateDiamondPatternForPolymorphicInline(HInstruction* compare,
 
 bool HInliner::TryInlinePolymorphicCallToSameTarget(
     HInvoke* invoke_instruction,
-    const StackHandleScope<InlineCache::kIndividualCacheSize>& classes) {
+    const StackHandleScope<InlineCache::kIndividualCacheSize>& classes,
+    bool is_megamorphic) {
   // This optimization only works under JIT for now.
   if (!codegen_->GetCompilerOptions().IsJitCompiler()) {
     return false;
@@ -1217,9 +1371,13 @@ bool HInliner::TryInlinePolymorphicCallToSameTarget(
       : invoke_instruction->AsInvokeInterface()->GetImtIndex();
 
   // Check whether we are actually calling the same method among
-  // the different types seen.
+  // the different types seen. For a megamorphic cache, we only need most of the
+  // types seen to agree: other receivers go through the original call.
   DCHECK_EQ(classes.Capacity(), InlineCache::kIndividualCacheSize);
   uint8_t number_of_types = classes.Size();
+  ArtMethod* targets[InlineCache::kIndividualCacheSize];
+  size_t target_counts[InlineCache::kIndividualCacheSize];
+  size_t number_of_targets = 0;
   for (size_t i = 0; i != number_of_types; ++i) {
     DCHECK(classes.GetReference(i) != nullptr);
     ArtMethod* new_method = nullptr;
@@ -1237,13 +1395,25 @@ bool HInliner::TryInlinePolymorphicCallToSameTarget(
           classes.GetReference(i)->AsClass()->GetEmbeddedVTableEntry(method_index, pointer_size);
     }
     DCHECK(new_method != nullptr);
-    if (actual_method == nullptr) {
-      actual_method = new_method;
-    } else if (actual_method != new_method) {
-      // Different methods, bailout.
-      return false;
+    size_t target_index = std::find(targets, targets + number_of_targets, new_method) - targets;
+    if (target_index == number_of_targets) {
+      if (number_of_targets != 0u && !is_megamorphic) {
+        // Different methods, bailout.
+        return false;
+      }
+      targets[number_of_targets] = new_method;
+      target_counts[number_of_targets] = 0u;
+      ++number_of_targets;
     }
+    ++target_counts[target_index];
+  }
+
+  size_t dominant_index =
+      std::max_element(target_counts, target_counts + number_of_targets) - target_counts;
+  if (is_megamorphic && target_counts[dominant_index] < kMegamorphicMinDominantTypes) {
+    return false;
   }
+  actual_method = targets[dominant_index];
 
   HInstruction* receiver = invoke_instruction->InputAt(0);
   HInstruction* cursor = invoke_instruction->GetPrevious();
@@ -1293,7 +1463,11 @@ bool HInliner::TryInlinePolymorphicCallToSameTarget(
   bb_cursor->InsertInstructionAfter(class_table_get, receiver_class);
   bb_cursor->InsertInstructionAfter(compare, class_table_get);
 
-  if (outermost_graph_->IsCompilingOsr()) {
+  // Receivers of a megamorphic call are known to reach other targets, so keep the
+  // original call for them rather than deoptimizing.
+  if (is_megamorphic ||
+      outermost_graph_->IsCompilingOsr() ||
+      !outermost_graph_->ShouldSpeculate(DeoptimizationKind::kJitSameTarget)) {
     CreateDiamondPatternForPolymorphicInline(compare, return_replacement, invoke_instruction);
   } else {
     HDeoptimize* deoptimize = new (graph_->GetAllocator()) HDeoptimize(
@@ -1311,6 +1485,11 @@ bool HInliner::TryInlinePolymorphicCallToSameTarget(
 
   // Lazily run type propagation to get the guard typed.
   run_extra_type_propagation_ = true;
+  if (is_megamorphic) {
+    MaybeRecordStat(stats_, MethodCompilationStat::kInlinedMegamorphicCall);
+    LOG_SUCCESS() << "Inlined dominant megamorphic target " << actual_method->PrettyMethod();
+    return true;
+  }
   MaybeRecordStat(stats_, MethodCompilationStat::kInlinedPolymorphicCall);
 
   LOG_SUCCESS() << "Inlined same polymorphic target " << actual_method->PrettyMethod();
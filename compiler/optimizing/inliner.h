@@ -17,6 +17,8 @@
 #ifndef ART_COMPILER_OPTIMIZING_INLINER_H_
 #define ART_COMPILER_OPTIMIZING_INLINER_H_
 
+#include <optional>
+
 #include "base/macros.h"
 #include "dex/dex_file_types.h"
 #include "dex/invoke_type.h"
@@ -60,7 +62,8 @@ class HInliner : public HOptimization {
         inlining_budget_(0),
         try_catch_inlining_allowed_(try_catch_inlining_allowed),
         run_extra_type_propagation_(false),
-        inline_stats_(nullptr) {}
+        inline_stats_(nullptr),
+        last_failure_() {}
 
   bool Run() override;
 
@@ -82,6 +85,24 @@ class HInliner : public HOptimization {
     kInlineCacheMissingTypes = 5
   };
 
+  // A call site to try to inline, with its priority when ranked.
+  struct CallSite {
+    HInvoke* invoke;
+    uint64_t priority;
+    bool is_cold;
+  };
+
+  // Returns whether to try call sites in the order of `GetCallSitePriority()` rather than
+  // in the order they appear in the graph. We do so for AOT compilation of methods that the
+  // profile marks as hot.
+  bool ShouldRankCallSites() const;
+
+  // Returns the priority of inlining `invoke`: how hot the call site is expected to be, from
+  // its loop depth and the profile, times the benefit of inlining, which decreases with the
+  // size of the callee. Sets `is_cold` if the profile shows the call site was not executed.
+  uint64_t GetCallSitePriority(HInvoke* invoke, /*out*/ bool* is_cold) const
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   bool TryInline(HInvoke* invoke_instruction);
 
   // Try to inline `resolved_method` in place of `invoke_instruction`. `do_rtp` is whether
@@ -225,9 +246,13 @@ class HInliner : public HOptimization {
                                 const StackHandleScope<InlineCache::kIndividualCacheSize>& classes)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Try to inline the single target of a polymorphic call. For a megamorphic call, inline the
+  // target that most of the recorded types dispatch to, keeping the original call for
+  // the other receivers.
   bool TryInlinePolymorphicCallToSameTarget(
       HInvoke* invoke_instruction,
-      const StackHandleScope<InlineCache::kIndividualCacheSize>& classes)
+      const StackHandleScope<InlineCache::kIndividualCacheSize>& classes,
+      bool is_megamorphic = false)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
   // Returns whether or not we should use only polymorphic inlining with no deoptimizations.
@@ -350,6 +375,9 @@ class HInliner : public HOptimization {
   // If the inlining is successful, these stats are merged to the caller graph's stats.
   OptimizingCompilerStats* inline_stats_;
 
+  // The last reason for not inlining the current call site, reported in the compile profile.
+  mutable std::optional<MethodCompilationStat> last_failure_;
+
   DISALLOW_COPY_AND_ASSIGN(HInliner);
 };
 
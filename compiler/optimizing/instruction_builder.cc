@@ -1574,100 +1574,6 @@ static bool IsSubClass(ObjPtr<mirror::Class> to_test, ObjPtr<mirror::Class> supe
   return to_test != nullptr && !to_test->IsInterface() && to_test->IsSubClass(super_class);
 }
 
-static bool HasTrivialClinit(ObjPtr<mirror::Class> klass, PointerSize pointer_size)
-    REQUIRES_SHARED(Locks::mutator_lock_) {
-  // Check if the class has encoded fields that trigger bytecode execution.
-  // (Encoded fields are just a different representation of <clinit>.)
-  if (klass->NumStaticFields() != 0u) {
-    DCHECK(klass->GetClassDef() != nullptr);
-    EncodedStaticFieldValueIterator it(klass->GetDexFile(), *klass->GetClassDef());
-    for (; it.HasNext(); it.Next()) {
-      switch (it.GetValueType()) {
-        case EncodedArrayValueIterator::ValueType::kBoolean:
-        case EncodedArrayValueIterator::ValueType::kByte:
-        case EncodedArrayValueIterator::ValueType::kShort:
-        case EncodedArrayValueIterator::ValueType::kChar:
-        case EncodedArrayValueIterator::ValueType::kInt:
-        case EncodedArrayValueIterator::ValueType::kLong:
-        case EncodedArrayValueIterator::ValueType::kFloat:
-        case EncodedArrayValueIterator::ValueType::kDouble:
-        case EncodedArrayValueIterator::ValueType::kNull:
-        case EncodedArrayValueIterator::ValueType::kString:
-          // Primitive, null or j.l.String initialization is permitted.
-          break;
-        case EncodedArrayValueIterator::ValueType::kType:
-          // Type initialization can load classes and execute bytecode through a class loader
-          // which can execute arbitrary bytecode. We do not optimize for known class loaders;
-          // kType is rarely used (if ever).
-          return false;
-        default:
-          // Other types in the encoded static field list are rejected by the DexFileVerifier.
-          LOG(FATAL) << "Unexpected type " << it.GetValueType();
-          UNREACHABLE();
-      }
-    }
-  }
-  // Check if the class has <clinit> that executes arbitrary code.
-  // Initialization of static fields of the class itself with constants is allowed.
-  ArtMethod* clinit = klass->FindClassInitializer(pointer_size);
-  if (clinit != nullptr) {
-    const DexFile& dex_file = *clinit->GetDexFile();
-    CodeItemInstructionAccessor accessor(dex_file, clinit->GetCodeItem());
-    for (DexInstructionPcPair it : accessor) {
-      switch (it->Opcode()) {
-        case Instruction::CONST_4:
-        case Instruction::CONST_16:
-        case Instruction::CONST:
-        case Instruction::CONST_HIGH16:
-        case Instruction::CONST_WIDE_16:
-        case Instruction::CONST_WIDE_32:
-        case Instruction::CONST_WIDE:
-        case Instruction::CONST_WIDE_HIGH16:
-        case Instruction::CONST_STRING:
-        case Instruction::CONST_STRING_JUMBO:
-          // Primitive, null or j.l.String initialization is permitted.
-          break;
-        case Instruction::RETURN_VOID:
-          break;
-        case Instruction::SPUT:
-        case Instruction::SPUT_WIDE:
-        case Instruction::SPUT_OBJECT:
-        case Instruction::SPUT_BOOLEAN:
-        case Instruction::SPUT_BYTE:
-        case Instruction::SPUT_CHAR:
-        case Instruction::SPUT_SHORT:
-          // Only initialization of a static field of the same class is permitted.
-          if (dex_file.GetFieldId(it->VRegB_21c()).class_idx_ != klass->GetDexTypeIndex()) {
-            return false;
-          }
-          break;
-        case Instruction::NEW_ARRAY:
-          // Only primitive arrays are permitted.
-          if (Primitive::GetType(dex_file.GetTypeDescriptor(dex_file.GetTypeId(
-                  dex::TypeIndex(it->VRegC_22c())))[1]) == Primitive::kPrimNot) {
-            return false;
-          }
-          break;
-        case Instruction::APUT:
-        case Instruction::APUT_WIDE:
-        case Instruction::APUT_BOOLEAN:
-        case Instruction::APUT_BYTE:
-        case Instruction::APUT_CHAR:
-        case Instruction::APUT_SHORT:
-        case Instruction::FILL_ARRAY_DATA:
-        case Instruction::NOP:
-          // Allow initialization of primitive arrays (only constants can be stored).
-          // Note: We expect NOPs used for fill-array-data-payload but accept all NOPs
-          // (even unreferenced switch payloads if they make it through the verifier).
-          break;
-        default:
-          return false;
-      }
-    }
-  }
-  return true;
-}
-
 static bool HasTrivialInitialization(ObjPtr<mirror::Class> cls,
                                      const CompilerOptions& compiler_options)
     REQUIRES_SHARED(Locks::mutator_lock_) {
@@ -1679,7 +1585,7 @@ static bool HasTrivialInitialization(ObjPtr<mirror::Class> cls,
     if (klass->IsInitialized() && IsInImage(klass, compiler_options)) {
       break;  // `klass` and its superclasses are already initialized in the boot or app image.
     }
-    if (!HasTrivialClinit(klass, pointer_size)) {
+    if (!klass->HasTrivialClassInitializer(pointer_size)) {
       return false;
     }
   }
@@ -1695,7 +1601,7 @@ static bool HasTrivialInitialization(ObjPtr<mirror::Class> cls,
     if (iface->IsInitialized() && IsInImage(iface, compiler_options)) {
       continue;  // This interface is already initialized in the boot or app image.
     }
-    if (!HasTrivialClinit(iface, pointer_size)) {
+    if (!iface->HasTrivialClassInitializer(pointer_size)) {
       return false;
     }
   }
@@ -1209,6 +1209,9 @@ void InstructionSimplifierVisitor::VisitIf(HIf* instruction) {
     // Swap successors if input is negated.
     instruction->ReplaceInput(condition->InputAt(0), 0);
     instruction->GetBlock()->SwapSuccessors();
+    uint16_t true_count = instruction->GetTrueCount();
+    instruction->SetTrueCount(instruction->GetFalseCount());
+    instruction->SetFalseCount(true_count);
     RecordSimplification();
   }
 }
@@ -2682,7 +2685,8 @@ void InstructionSimplifierVisitor::SimplifyBoxUnbox(
   DCHECK(instruction->GetIntrinsic() == Intrinsics::kByteValueOf ||
          instruction->GetIntrinsic() == Intrinsics::kShortValueOf ||
          instruction->GetIntrinsic() == Intrinsics::kCharacterValueOf ||
-         instruction->GetIntrinsic() == Intrinsics::kIntegerValueOf);
+         instruction->GetIntrinsic() == Intrinsics::kIntegerValueOf ||
+         instruction->GetIntrinsic() == Intrinsics::kLongValueOf);
   const HUseList<HInstruction*>& uses = instruction->GetUses();
   for (auto it = uses.begin(), end = uses.end(); it != end;) {
     HInstruction* user = it->GetUser();
@@ -3032,11 +3036,16 @@ static bool TryReplaceStringBuilderAppend(HInvoke* invoke) {
   uint32_t format = 0u;
   uint32_t num_args = 0u;
   bool has_fp_args = false;
+  // Whether there is a write between an append and the StringBuilder.toString().
+  bool seen_write_after_append = false;
   HInstruction* args[StringBuilderAppend::kMaxArgs];  // Added in reverse order.
   for (HBackwardInstructionIterator iter(block->GetInstructions()); !iter.Done(); iter.Advance()) {
     HInstruction* user = iter.Current();
     // Instructions of interest apply to `sb`, skip those that do not involve `sb`.
     if (user->InputCount() == 0u || user->InputAt(0u) != sb) {
+      if (seen_to_string && user->GetSideEffects().DoesAnyWrite()) {
+        seen_write_after_append = true;
+      }
       continue;
     }
     // We visit the uses in reverse order, so the StringBuilder.toString() must come first.
@@ -3062,9 +3071,15 @@ static bool TryReplaceStringBuilderAppend(HInvoke* invoke) {
           arg = StringBuilderAppend::Argument::kString;
           break;
         case Intrinsics::kStringBuilderAppendCharArray:
-          // TODO: Unimplemented, StringBuilder.append(char[]) can throw NPE and we would
-          // not have the correct stack trace for it.
-          return false;
+          // StringBuilder.append(char[]) can throw NPE and we would not have the correct
+          // stack trace for it, so we only handle arguments known to be non-null.
+          // The array is mutable, so we also need to make sure the contents cannot
+          // change before the fused append reads them at the StringBuilder.toString().
+          if (as_invoke_virtual->InputAt(1)->CanBeNull() || seen_write_after_append) {
+            return false;
+          }
+          arg = StringBuilderAppend::Argument::kCharArray;
+          break;
         case Intrinsics::kStringBuilderAppendBoolean:
           arg = StringBuilderAppend::Argument::kBoolean;
           break;
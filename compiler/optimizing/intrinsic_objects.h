@@ -35,18 +35,25 @@ class Object;
 template <class T> class ObjectArray;
 }  // namespace mirror
 
-#define BOXED_TYPES(V) \
+// Boxed types whose value fits in 32 bits.
+#define BOXED_TYPES_32(V) \
   V(Byte, -128, 127, DataType::Type::kInt8, 0) \
   V(Short, -128, 127, DataType::Type::kInt16, kByteCacheLastIndex) \
   V(Character, 0, 127, DataType::Type::kUint16, kShortCacheLastIndex) \
   V(Integer, -128, 127, DataType::Type::kInt32, kCharacterCacheLastIndex)
 
+// All boxed types with a cache in the boot image. Backends without 64-bit support in
+// their `valueOf` intrinsics implement only `BOXED_TYPES_32`.
+#define BOXED_TYPES(V) \
+  BOXED_TYPES_32(V) \
+  V(Long, -128, 127, DataType::Type::kInt64, kIntegerCacheLastIndex)
+
 #define DEFINE_BOXED_CONSTANTS(name, low, high, unused, start_index) \
   static constexpr size_t k ##name ##CacheLastIndex = start_index + (high - low + 1); \
   static constexpr size_t k ##name ##CacheFirstIndex = start_index;
   BOXED_TYPES(DEFINE_BOXED_CONSTANTS)
 
-  static constexpr size_t kNumberOfBoxedCaches = kIntegerCacheLastIndex;
+  static constexpr size_t kNumberOfBoxedCaches = kLongCacheLastIndex;
 #undef DEFINE_BOXED_CONSTANTS
 
 class IntrinsicObjects {
@@ -93,9 +93,9 @@ void IntrinsicVisitor::ComputeValueOfLocations(HInvoke* invoke,
     return;
   }
   HInstruction* const input = invoke->InputAt(0);
-  if (input->IsIntConstant()) {
-    int32_t value = input->AsIntConstant()->GetValue();
-    if (static_cast<uint32_t>(value) - static_cast<uint32_t>(low) < static_cast<uint32_t>(length)) {
+  if (input->IsConstant()) {
+    int64_t value = Int64FromConstant(input->AsConstant());
+    if (static_cast<uint64_t>(value) - static_cast<uint64_t>(low) < static_cast<uint64_t>(length)) {
       // No call, we shall use direct pointer to the boxed object.
       call_kind = LocationSummary::kNoCall;
     }
@@ -131,12 +131,12 @@ IntrinsicVisitor::ValueOfInfo IntrinsicVisitor::ComputeValueOfInfo(
   info.length = length;
   info.value_offset = value_field->GetOffset().Uint32Value();
   if (compiler_options.IsBootImage()) {
-    if (invoke->InputAt(0)->IsIntConstant()) {
-      int32_t input_value = invoke->InputAt(0)->AsIntConstant()->GetValue();
-      uint32_t index = static_cast<uint32_t>(input_value) - static_cast<uint32_t>(info.low);
-      if (index < static_cast<uint32_t>(info.length)) {
+    if (invoke->InputAt(0)->IsConstant()) {
+      int64_t input_value = Int64FromConstant(invoke->InputAt(0)->AsConstant());
+      uint64_t index = static_cast<uint64_t>(input_value) - static_cast<uint64_t>(info.low);
+      if (index < static_cast<uint64_t>(info.length)) {
         info.value_boot_image_reference = IntrinsicObjects::EncodePatch(
-            IntrinsicObjects::PatchType::kValueOfObject, index + base);
+            IntrinsicObjects::PatchType::kValueOfObject, static_cast<uint32_t>(index) + base);
       } else {
         // Not in the cache.
         info.value_boot_image_reference = ValueOfInfo::kInvalidReference;
@@ -149,12 +149,12 @@ IntrinsicVisitor::ValueOfInfo IntrinsicVisitor::ComputeValueOfInfo(
     ScopedObjectAccess soa(Thread::Current());
     ObjPtr<mirror::ObjectArray<mirror::Object>> boot_image_live_objects = GetBootImageLiveObjects();
 
-    if (invoke->InputAt(0)->IsIntConstant()) {
-      int32_t input_value = invoke->InputAt(0)->AsIntConstant()->GetValue();
-      uint32_t index = static_cast<uint32_t>(input_value) - static_cast<uint32_t>(info.low);
-      if (index < static_cast<uint32_t>(info.length)) {
-        ObjPtr<mirror::Object> object =
-            IntrinsicObjects::GetValueOfObject(boot_image_live_objects, base, index);
+    if (invoke->InputAt(0)->IsConstant()) {
+      int64_t input_value = Int64FromConstant(invoke->InputAt(0)->AsConstant());
+      uint64_t index = static_cast<uint64_t>(input_value) - static_cast<uint64_t>(info.low);
+      if (index < static_cast<uint64_t>(info.length)) {
+        ObjPtr<mirror::Object> object = IntrinsicObjects::GetValueOfObject(
+            boot_image_live_objects, base, static_cast<uint32_t>(index));
         info.value_boot_image_reference = CodeGenerator::GetBootImageOffset(object);
       } else {
         // Not in the cache.
@@ -23,6 +23,7 @@
 #include "code_generator_arm64.h"
 #include "common_arm64.h"
 #include "data_type-inl.h"
+#include "dex/modifiers.h"
 #include "entrypoints/quick/quick_entrypoints.h"
 #include "heap_poisoning.h"
 #include "intrinsic_objects.h"
@@ -30,6 +31,7 @@
 #include "intrinsics_utils.h"
 #include "lock_word.h"
 #include "mirror/array-inl.h"
+#include "mirror/method_handle_impl.h"
 #include "mirror/object_array-inl.h"
 #include "mirror/reference.h"
 #include "mirror/string-inl.h"
@@ -160,6 +162,35 @@ class ReadBarrierSystemArrayCopySlowPathARM64 : public SlowPathCodeARM64 {
 
   DISALLOW_COPY_AND_ASSIGN(ReadBarrierSystemArrayCopySlowPathARM64);
 };
+
+class InvokePolymorphicSlowPathARM64 : public SlowPathCodeARM64 {
+ public:
+  InvokePolymorphicSlowPathARM64(HInstruction* instruction, Register method_handle)
+      : SlowPathCodeARM64(instruction), method_handle_(method_handle) {
+    DCHECK(instruction->IsInvokePolymorphic());
+  }
+
+  void EmitNativeCode(CodeGenerator* codegen_in) override {
+    CodeGeneratorARM64* codegen = down_cast<CodeGeneratorARM64*>(codegen_in);
+    __ Bind(GetEntryLabel());
+    SaveLiveRegisters(codegen, instruction_->GetLocations());
+
+    // Passing `MethodHandle` object as hidden argument.
+    __ Mov(kArtMethodRegister.W(), method_handle_.W());
+    codegen->InvokeRuntime(QuickEntrypointEnum::kQuickInvokePolymorphicWithHiddenReceiver,
+                           instruction_,
+                           instruction_->GetDexPc());
+
+    RestoreLiveRegisters(codegen, instruction_->GetLocations());
+    __ B(GetExitLabel());
+  }
+
+  const char* GetDescription() const override { return "InvokePolymorphicSlowPathARM64"; }
+
+ private:
+  const Register method_handle_;
+  DISALLOW_COPY_AND_ASSIGN(InvokePolymorphicSlowPathARM64);
+};
 #undef __
 
 bool IntrinsicLocationsBuilderARM64::TryDispatch(HInvoke* invoke) {
@@ -689,6 +720,118 @@ void IntrinsicCodeGeneratorARM64::VisitMemoryPokeShortNative(HInvoke* invoke) {
           AbsoluteHeapOperandFrom(invoke->GetLocations()->InAt(0), 0));
 }
 
+// Unsafe.get*(long) and Unsafe.put*(long, ...) are the Memory.peek*() and Memory.poke*()
+// operations with an unused receiver as input 0.
+static void CreateUnsafeGetAbsoluteLocations(ArenaAllocator* allocator, HInvoke* invoke) {
+  LocationSummary* locations =
+      new (allocator) LocationSummary(invoke, LocationSummary::kNoCall, kIntrinsified);
+  locations->SetInAt(0, Location::NoLocation());        // Unused receiver.
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+}
+
+static void CreateUnsafePutAbsoluteLocations(ArenaAllocator* allocator, HInvoke* invoke) {
+  LocationSummary* locations =
+      new (allocator) LocationSummary(invoke, LocationSummary::kNoCall, kIntrinsified);
+  locations->SetInAt(0, Location::NoLocation());        // Unused receiver.
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->SetInAt(2, Location::RequiresRegister());
+}
+
+static void GenUnsafeGetAbsolute(HInvoke* invoke,
+                                 DataType::Type type,
+                                 CodeGeneratorARM64* codegen) {
+  LocationSummary* locations = invoke->GetLocations();
+  codegen->Load(type,
+                RegisterFrom(locations->Out(), type),
+                AbsoluteHeapOperandFrom(locations->InAt(1)));
+}
+
+static void GenUnsafePutAbsolute(HInvoke* invoke,
+                                 DataType::Type type,
+                                 CodeGeneratorARM64* codegen) {
+  LocationSummary* locations = invoke->GetLocations();
+  codegen->Store(type,
+                 RegisterFrom(locations->InAt(2), type),
+                 AbsoluteHeapOperandFrom(locations->InAt(1)));
+}
+
+void IntrinsicLocationsBuilderARM64::VisitUnsafeGetByteAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafeGetByteAbsolute(invoke);
+}
+void IntrinsicLocationsBuilderARM64::VisitUnsafeGetAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafeGetAbsolute(invoke);
+}
+void IntrinsicLocationsBuilderARM64::VisitUnsafeGetLongAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafeGetLongAbsolute(invoke);
+}
+void IntrinsicLocationsBuilderARM64::VisitUnsafePutByteAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafePutByteAbsolute(invoke);
+}
+void IntrinsicLocationsBuilderARM64::VisitUnsafePutAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafePutAbsolute(invoke);
+}
+void IntrinsicLocationsBuilderARM64::VisitUnsafePutLongAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafePutLongAbsolute(invoke);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitJdkUnsafeGetByteAbsolute(HInvoke* invoke) {
+  CreateUnsafeGetAbsoluteLocations(allocator_, invoke);
+}
+void IntrinsicLocationsBuilderARM64::VisitJdkUnsafeGetAbsolute(HInvoke* invoke) {
+  CreateUnsafeGetAbsoluteLocations(allocator_, invoke);
+}
+void IntrinsicLocationsBuilderARM64::VisitJdkUnsafeGetLongAbsolute(HInvoke* invoke) {
+  CreateUnsafeGetAbsoluteLocations(allocator_, invoke);
+}
+void IntrinsicLocationsBuilderARM64::VisitJdkUnsafePutByteAbsolute(HInvoke* invoke) {
+  CreateUnsafePutAbsoluteLocations(allocator_, invoke);
+}
+void IntrinsicLocationsBuilderARM64::VisitJdkUnsafePutAbsolute(HInvoke* invoke) {
+  CreateUnsafePutAbsoluteLocations(allocator_, invoke);
+}
+void IntrinsicLocationsBuilderARM64::VisitJdkUnsafePutLongAbsolute(HInvoke* invoke) {
+  CreateUnsafePutAbsoluteLocations(allocator_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitUnsafeGetByteAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafeGetByteAbsolute(invoke);
+}
+void IntrinsicCodeGeneratorARM64::VisitUnsafeGetAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafeGetAbsolute(invoke);
+}
+void IntrinsicCodeGeneratorARM64::VisitUnsafeGetLongAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafeGetLongAbsolute(invoke);
+}
+void IntrinsicCodeGeneratorARM64::VisitUnsafePutByteAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafePutByteAbsolute(invoke);
+}
+void IntrinsicCodeGeneratorARM64::VisitUnsafePutAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafePutAbsolute(invoke);
+}
+void IntrinsicCodeGeneratorARM64::VisitUnsafePutLongAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafePutLongAbsolute(invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitJdkUnsafeGetByteAbsolute(HInvoke* invoke) {
+  GenUnsafeGetAbsolute(invoke, DataType::Type::kInt8, codegen_);
+}
+void IntrinsicCodeGeneratorARM64::VisitJdkUnsafeGetAbsolute(HInvoke* invoke) {
+  GenUnsafeGetAbsolute(invoke, DataType::Type::kInt32, codegen_);
+}
+void IntrinsicCodeGeneratorARM64::VisitJdkUnsafeGetLongAbsolute(HInvoke* invoke) {
+  GenUnsafeGetAbsolute(invoke, DataType::Type::kInt64, codegen_);
+}
+void IntrinsicCodeGeneratorARM64::VisitJdkUnsafePutByteAbsolute(HInvoke* invoke) {
+  GenUnsafePutAbsolute(invoke, DataType::Type::kInt8, codegen_);
+}
+void IntrinsicCodeGeneratorARM64::VisitJdkUnsafePutAbsolute(HInvoke* invoke) {
+  GenUnsafePutAbsolute(invoke, DataType::Type::kInt32, codegen_);
+}
+void IntrinsicCodeGeneratorARM64::VisitJdkUnsafePutLongAbsolute(HInvoke* invoke) {
+  GenUnsafePutAbsolute(invoke, DataType::Type::kInt64, codegen_);
+}
+
 void IntrinsicLocationsBuilderARM64::VisitThreadCurrentThread(HInvoke* invoke) {
   LocationSummary* locations =
       new (allocator_) LocationSummary(invoke, LocationSummary::kNoCall, kIntrinsified);
@@ -2294,6 +2437,99 @@ void IntrinsicCodeGeneratorARM64::VisitStringEquals(HInvoke* invoke) {
   __ Bind(&end);
 }
 
+void IntrinsicLocationsBuilderARM64::VisitArraysEqualsByte(HInvoke* invoke) {
+  LocationSummary* locations =
+      new (allocator_) LocationSummary(invoke, LocationSummary::kNoCall, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->AddRegisterTemps(2);
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitArraysEqualsByte(HInvoke* invoke) {
+  MacroAssembler* masm = GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  Register array1 = XRegisterFrom(locations->InAt(0));
+  Register array2 = XRegisterFrom(locations->InAt(1));
+  Register last = XRegisterFrom(locations->GetTemp(0));
+  Register offset = XRegisterFrom(locations->GetTemp(1));
+  Register out = XRegisterFrom(locations->Out());
+
+  UseScratchRegisterScope scratch_scope(masm);
+  Register temp = scratch_scope.AcquireX();
+  Register temp1 = scratch_scope.AcquireX();
+
+  vixl::aarch64::Label loop;
+  vixl::aarch64::Label short_array;
+  vixl::aarch64::Label short_loop;
+  vixl::aarch64::Label end;
+  vixl::aarch64::Label return_true;
+  vixl::aarch64::Label return_false;
+
+  const int32_t length_offset = mirror::Array::LengthOffset().Int32Value();
+  const int32_t data_offset = mirror::Array::DataOffset(sizeof(uint8_t)).Int32Value();
+
+  // Reference equality check, return true if same reference or both null.
+  __ Cmp(array1, array2);
+  __ B(&return_true, eq);
+
+  // Otherwise return false if either array is null.
+  if (invoke->InputAt(0)->CanBeNull()) {
+    __ Cbz(array1, &return_false);
+  }
+  if (invoke->InputAt(1)->CanBeNull()) {
+    __ Cbz(array2, &return_false);
+  }
+
+  // Check if lengths are equal, return false if they're not.
+  __ Ldr(last.W(), HeapOperand(array1.W(), length_offset));
+  __ Ldr(temp.W(), HeapOperand(array2.W(), length_offset));
+  __ Cmp(last.W(), temp.W());
+  __ B(&return_false, ne);
+
+  __ Mov(offset, data_offset);
+  __ Cmp(last.W(), 8);
+  __ B(&short_array, lt);
+
+  // Compare 8 bytes at a time. The last 8 bytes are compared separately and may overlap
+  // bytes already compared, so that nothing beyond the array data is read.
+  __ Add(last, last, data_offset - 8);
+  __ Bind(&loop);
+  __ Ldr(temp, MemOperand(array1, offset));
+  __ Ldr(temp1, MemOperand(array2, offset));
+  __ Add(offset, offset, 8);
+  __ Cmp(temp, temp1);
+  __ B(&return_false, ne);
+  __ Cmp(offset, last);
+  __ B(&loop, lo);
+  __ Ldr(temp, MemOperand(array1, last));
+  __ Ldr(temp1, MemOperand(array2, last));
+  __ Cmp(temp, temp1);
+  __ B(&return_false, ne);
+  __ B(&return_true);
+
+  // Compare arrays shorter than 8 bytes one byte at a time.
+  __ Bind(&short_array);
+  __ Cbz(last, &return_true);
+  __ Bind(&short_loop);
+  __ Ldrb(temp.W(), MemOperand(array1, offset));
+  __ Ldrb(temp1.W(), MemOperand(array2, offset));
+  __ Add(offset, offset, 1);
+  __ Cmp(temp.W(), temp1.W());
+  __ B(&return_false, ne);
+  __ Subs(last, last, 1);
+  __ B(&short_loop, ne);
+
+  __ Bind(&return_true);
+  __ Mov(out, 1);
+  __ B(&end);
+
+  __ Bind(&return_false);
+  __ Mov(out, 0);
+  __ Bind(&end);
+}
+
 static void GenerateVisitStringIndexOf(HInvoke* invoke,
                                        MacroAssembler* masm,
                                        CodeGeneratorARM64* codegen,
@@ -3527,9 +3763,9 @@ void IntrinsicCodeGeneratorARM64::HandleValueOf(HInvoke* invoke,
     codegen_->InvokeRuntime(kQuickAllocObjectInitialized, invoke, invoke->GetDexPc());
     CheckEntrypointTypes<kQuickAllocObjectWithChecks, void*, mirror::Class*>();
   };
-  if (invoke->InputAt(0)->IsIntConstant()) {
-    int32_t value = invoke->InputAt(0)->AsIntConstant()->GetValue();
-    if (static_cast<uint32_t>(value - info.low) < info.length) {
+  if (invoke->InputAt(0)->IsConstant()) {
+    int64_t value = Int64FromConstant(invoke->InputAt(0)->AsConstant());
+    if (static_cast<uint64_t>(value - info.low) < info.length) {
       // Just embed the object in the code.
       DCHECK_NE(info.value_boot_image_reference, ValueOfInfo::kInvalidReference);
       codegen_->LoadBootImageAddress(out, info.value_boot_image_reference);
@@ -3539,17 +3775,19 @@ void IntrinsicCodeGeneratorARM64::HandleValueOf(HInvoke* invoke,
       // TODO: If we JIT, we could allocate the object now, and store it in the
       // JIT object table.
       allocate_instance();
-      __ Mov(temp.W(), value);
-      codegen_->Store(type, temp.W(), HeapOperand(out.W(), info.value_offset));
+      Register value_reg = DataType::Is64BitType(type) ? temp.X() : temp.W();
+      __ Mov(value_reg, value);
+      codegen_->Store(type, value_reg, HeapOperand(out.W(), info.value_offset));
       // Class pointer and `value` final field stores require a barrier before publication.
       codegen_->GenerateMemoryBarrier(MemBarrierKind::kStoreStore);
     }
   } else {
     DCHECK(locations->CanCall());
-    Register in = RegisterFrom(locations->InAt(0), DataType::Type::kInt32);
+    Register in = RegisterFrom(locations->InAt(0), DataType::Kind(type));
     // Check bounds of our cache.
-    __ Add(out.W(), in.W(), -info.low);
-    __ Cmp(out.W(), info.length);
+    Register index = DataType::Is64BitType(type) ? out.X() : out.W();
+    __ Add(index, in, -info.low);
+    __ Cmp(index, info.length);
     vixl::aarch64::Label allocate, done;
     __ B(&allocate, hs);
     // If the value is within the bounds, load the object directly from the array.
@@ -3562,7 +3800,7 @@ void IntrinsicCodeGeneratorARM64::HandleValueOf(HInvoke* invoke,
     __ Bind(&allocate);
     // Otherwise allocate and initialize a new object.
     allocate_instance();
-    codegen_->Store(type, in.W(), HeapOperand(out.W(), info.value_offset));
+    codegen_->Store(type, in, HeapOperand(out.W(), info.value_offset));
     // Class pointer and `value` final field stores require a barrier before publication.
     codegen_->GenerateMemoryBarrier(MemBarrierKind::kStoreStore);
     __ Bind(&done);
@@ -3754,22 +3992,58 @@ void IntrinsicCodeGeneratorARM64::VisitCRC32Update(HInvoke* invoke) {
   __ Mvn(out, tmp);
 }
 
+// The CRC32 polynomial of java.util.zip.CRC32 or the CRC32C (Castagnoli) polynomial
+// of java.util.zip.CRC32C.
+enum class CRC32Polynomial {
+  kCRC32,
+  kCRC32C,
+};
+
+// Generate a CRC32 or CRC32C instruction updating `out` with `size` bytes of `data`.
+static void GenerateCRC32Update(MacroAssembler* masm,
+                                CRC32Polynomial polynomial,
+                                size_t size,
+                                const Register& out,
+                                const Register& data) {
+  DCHECK(size == 1u || size == 2u || size == 4u || size == 8u) << size;
+  if (polynomial == CRC32Polynomial::kCRC32C) {
+    switch (size) {
+      case 1u: __ Crc32cb(out, out, data); break;
+      case 2u: __ Crc32ch(out, out, data); break;
+      case 4u: __ Crc32cw(out, out, data); break;
+      default: __ Crc32cx(out, out, data); break;
+    }
+  } else {
+    switch (size) {
+      case 1u: __ Crc32b(out, out, data); break;
+      case 2u: __ Crc32h(out, out, data); break;
+      case 4u: __ Crc32w(out, out, data); break;
+      default: __ Crc32x(out, out, data); break;
+    }
+  }
+}
+
 // Generate code using CRC32 instructions which calculates
 // a CRC32 value of a byte.
 //
+// The CRC value is negated before and after the calculation only for CRC32.
+// CRC32C keeps its state negated, so CRC32C.updateBytes does not negate it.
+//
 // Parameters:
-//   masm   - VIXL macro assembler
-//   crc    - a register holding an initial CRC value
-//   ptr    - a register holding a memory address of bytes
-//   length - a register holding a number of bytes to process
-//   out    - a register to put a result of calculation
+//   masm       - VIXL macro assembler
+//   polynomial - the CRC32 or CRC32C polynomial
+//   crc        - a register holding an initial CRC value
+//   ptr        - a register holding a memory address of bytes
+//   length     - a register holding a number of bytes to process
+//   out        - a register to put a result of calculation
 static void GenerateCodeForCalculationCRC32ValueOfBytes(MacroAssembler* masm,
+                                                        CRC32Polynomial polynomial,
                                                         const Register& crc,
                                                         const Register& ptr,
                                                         const Register& length,
                                                         const Register& out) {
   // The algorithm of CRC32 of bytes is:
-  //   crc = ~crc
+  //   crc = ~crc (CRC32 only)
   //   process a few first bytes to make the array 8-byte aligned
   //   while array has 8 bytes do:
   //     crc = crc32_of_8bytes(crc, 8_bytes(array))
@@ -3779,7 +4053,7 @@ static void GenerateCodeForCalculationCRC32ValueOfBytes(MacroAssembler* masm,
   //     crc = crc32_of_2bytes(crc, 2_bytes(array))
   //   if array has a byte:
   //     crc = crc32_of_byte(crc, 1_byte(array))
-  //   crc = ~crc
+  //   crc = ~crc (CRC32 only)
 
   vixl::aarch64::Label loop, done;
   vixl::aarch64::Label process_4bytes, process_2bytes, process_1byte;
@@ -3791,28 +4065,32 @@ static void GenerateCodeForCalculationCRC32ValueOfBytes(MacroAssembler* masm,
   Register len = temps.AcquireW();
   Register array_elem = temps.AcquireW();
 
-  __ Mvn(out, crc);
+  if (polynomial == CRC32Polynomial::kCRC32) {
+    __ Mvn(out, crc);
+  } else {
+    __ Mov(out, crc);
+  }
   __ Mov(len, length);
 
   __ Tbz(ptr, 0, &aligned2);
   __ Subs(len, len, 1);
   __ B(&done, lo);
   __ Ldrb(array_elem, MemOperand(ptr, 1, PostIndex));
-  __ Crc32b(out, out, array_elem);
+  GenerateCRC32Update(masm, polynomial, 1u, out, array_elem);
 
   __ Bind(&aligned2);
   __ Tbz(ptr, 1, &aligned4);
   __ Subs(len, len, 2);
   __ B(&process_1byte, lo);
   __ Ldrh(array_elem, MemOperand(ptr, 2, PostIndex));
-  __ Crc32h(out, out, array_elem);
+  GenerateCRC32Update(masm, polynomial, 2u, out, array_elem);
 
   __ Bind(&aligned4);
   __ Tbz(ptr, 2, &aligned8);
   __ Subs(len, len, 4);
   __ B(&process_2bytes, lo);
   __ Ldr(array_elem, MemOperand(ptr, 4, PostIndex));
-  __ Crc32w(out, out, array_elem);
+  GenerateCRC32Update(masm, polynomial, 4u, out, array_elem);
 
   __ Bind(&aligned8);
   __ Subs(len, len, 8);
@@ -3823,7 +4101,7 @@ static void GenerateCodeForCalculationCRC32ValueOfBytes(MacroAssembler* masm,
   __ Bind(&loop);
   __ Ldr(array_elem.X(), MemOperand(ptr, 8, PostIndex));
   __ Subs(len, len, 8);
-  __ Crc32x(out, out, array_elem.X());
+  GenerateCRC32Update(masm, polynomial, 8u, out, array_elem.X());
   // if len >= 8, process the next 8 bytes.
   __ B(&loop, hs);
 
@@ -3840,22 +4118,24 @@ static void GenerateCodeForCalculationCRC32ValueOfBytes(MacroAssembler* masm,
   // Goto process_2bytes if less than four bytes available
   __ Tbz(len, 2, &process_2bytes);
   __ Ldr(array_elem, MemOperand(ptr, 4, PostIndex));
-  __ Crc32w(out, out, array_elem);
+  GenerateCRC32Update(masm, polynomial, 4u, out, array_elem);
 
   __ Bind(&process_2bytes);
   // Goto process_1bytes if less than two bytes available
   __ Tbz(len, 1, &process_1byte);
   __ Ldrh(array_elem, MemOperand(ptr, 2, PostIndex));
-  __ Crc32h(out, out, array_elem);
+  GenerateCRC32Update(masm, polynomial, 2u, out, array_elem);
 
   __ Bind(&process_1byte);
   // Goto done if no bytes available
   __ Tbz(len, 0, &done);
   __ Ldrb(array_elem, MemOperand(ptr));
-  __ Crc32b(out, out, array_elem);
+  GenerateCRC32Update(masm, polynomial, 1u, out, array_elem);
 
   __ Bind(&done);
-  __ Mvn(out, out);
+  if (polynomial == CRC32Polynomial::kCRC32) {
+    __ Mvn(out, out);
+  }
 }
 
 // The threshold for sizes of arrays to use the library provided implementation
@@ -3913,7 +4193,8 @@ void IntrinsicCodeGeneratorARM64::VisitCRC32UpdateBytes(HInvoke* invoke) {
   Register crc = WRegisterFrom(locations->InAt(0));
   Register out = WRegisterFrom(locations->Out());
 
-  GenerateCodeForCalculationCRC32ValueOfBytes(masm, crc, ptr, length, out);
+  GenerateCodeForCalculationCRC32ValueOfBytes(
+      masm, CRC32Polynomial::kCRC32, crc, ptr, length, out);
 
   __ Bind(slow_path->GetExitLabel());
 }
@@ -3958,7 +4239,109 @@ void IntrinsicCodeGeneratorARM64::VisitCRC32UpdateByteBuffer(HInvoke* invoke) {
   Register crc = WRegisterFrom(locations->InAt(0));
   Register length = WRegisterFrom(locations->InAt(3));
   Register out = WRegisterFrom(locations->Out());
-  GenerateCodeForCalculationCRC32ValueOfBytes(masm, crc, ptr, length, out);
+  GenerateCodeForCalculationCRC32ValueOfBytes(
+      masm, CRC32Polynomial::kCRC32, crc, ptr, length, out);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitCRC32CUpdateBytes(HInvoke* invoke) {
+  if (!codegen_->GetInstructionSetFeatures().HasCRC()) {
+    return;
+  }
+
+  LocationSummary* locations =
+      new (allocator_) LocationSummary(invoke,
+                                       LocationSummary::kCallOnSlowPath,
+                                       kIntrinsified);
+
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->SetInAt(2, Location::RegisterOrConstant(invoke->InputAt(2)));
+  locations->SetInAt(3, Location::RequiresRegister());
+  locations->AddRegisterTemps(2);
+  locations->SetOut(Location::RequiresRegister());
+}
+
+// Lower the invoke of CRC32C.updateBytes(int crc, byte[] b, int off, int end)
+//
+// Note: The intrinsic is not used if the number of bytes exceeds a threshold.
+void IntrinsicCodeGeneratorARM64::VisitCRC32CUpdateBytes(HInvoke* invoke) {
+  DCHECK(codegen_->GetInstructionSetFeatures().HasCRC());
+
+  MacroAssembler* masm = GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  SlowPathCodeARM64* slow_path =
+      new (codegen_->GetScopedAllocator()) IntrinsicSlowPathARM64(invoke);
+  codegen_->AddSlowPath(slow_path);
+
+  const uint32_t array_data_offset =
+      mirror::Array::DataOffset(Primitive::kPrimByte).Uint32Value();
+  Register ptr = XRegisterFrom(locations->GetTemp(0));
+  Register length = WRegisterFrom(locations->GetTemp(1));
+  Register array = XRegisterFrom(locations->InAt(1));
+  Register end = WRegisterFrom(locations->InAt(3));
+  Location offset = locations->InAt(2);
+  if (offset.IsConstant()) {
+    int32_t offset_value = offset.GetConstant()->AsIntConstant()->GetValue();
+    __ Sub(length, end, offset_value);
+    __ Add(ptr, array, array_data_offset + offset_value);
+  } else {
+    __ Sub(length, end, WRegisterFrom(offset));
+    __ Add(ptr, array, array_data_offset);
+    __ Add(ptr, ptr, Operand(WRegisterFrom(offset), SXTW));
+  }
+  // Also takes the slow path for a negative length.
+  __ Cmp(length, kCRC32UpdateBytesThreshold);
+  __ B(slow_path->GetEntryLabel(), hi);
+
+  Register crc = WRegisterFrom(locations->InAt(0));
+  Register out = WRegisterFrom(locations->Out());
+
+  GenerateCodeForCalculationCRC32ValueOfBytes(
+      masm, CRC32Polynomial::kCRC32C, crc, ptr, length, out);
+
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void IntrinsicLocationsBuilderARM64::VisitCRC32CUpdateDirectByteBuffer(HInvoke* invoke) {
+  if (!codegen_->GetInstructionSetFeatures().HasCRC()) {
+    return;
+  }
+
+  LocationSummary* locations =
+      new (allocator_) LocationSummary(invoke,
+                                       LocationSummary::kNoCall,
+                                       kIntrinsified);
+
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->SetInAt(2, Location::RequiresRegister());
+  locations->SetInAt(3, Location::RequiresRegister());
+  locations->AddRegisterTemps(2);
+  locations->SetOut(Location::RequiresRegister());
+}
+
+// Lower the invoke of CRC32C.updateDirectByteBuffer(int crc, long addr, int off, int end)
+//
+// As for CRC32.updateByteBuffer, the method is private and only called with the
+// address of a DirectBuffer, so there is no need to check the address.
+void IntrinsicCodeGeneratorARM64::VisitCRC32CUpdateDirectByteBuffer(HInvoke* invoke) {
+  DCHECK(codegen_->GetInstructionSetFeatures().HasCRC());
+
+  MacroAssembler* masm = GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  Register addr = XRegisterFrom(locations->InAt(1));
+  Register offset = WRegisterFrom(locations->InAt(2));
+  Register ptr = XRegisterFrom(locations->GetTemp(0));
+  Register length = WRegisterFrom(locations->GetTemp(1));
+  __ Add(ptr, addr, Operand(offset, SXTW));
+  __ Sub(length, WRegisterFrom(locations->InAt(3)), offset);
+
+  Register crc = WRegisterFrom(locations->InAt(0));
+  Register out = WRegisterFrom(locations->Out());
+  GenerateCodeForCalculationCRC32ValueOfBytes(
+      masm, CRC32Polynomial::kCRC32C, crc, ptr, length, out);
 }
 
 void IntrinsicLocationsBuilderARM64::VisitFP16ToFloat(HInvoke* invoke) {
@@ -4920,6 +5303,112 @@ static void GenerateVarHandleGet(HInvoke* invoke,
   }
 }
 
+void IntrinsicLocationsBuilderARM64::VisitMethodHandleInvokeExact(HInvoke* invoke) {
+  // Don't emit intrinsic code for MethodHandle.invokeExact when it certainly does not target
+  // invoke-virtual: if invokeExact is called w/o arguments or if the first argument in that
+  // call is not a reference.
+  if (!invoke->AsInvokePolymorphic()->CanHaveFastPath()) {
+    return;
+  }
+  ArenaAllocator* allocator = invoke->GetBlock()->GetGraph()->GetAllocator();
+  LocationSummary* locations = new (allocator)
+      LocationSummary(invoke, LocationSummary::kCallOnMainAndSlowPath, kIntrinsified);
+
+  InvokeDexCallingConventionVisitorARM64 calling_convention;
+  locations->SetOut(calling_convention.GetReturnLocation(invoke->GetType()));
+
+  locations->SetInAt(0, Location::RequiresRegister());
+
+  // Accomodating LocationSummary for underlying invoke-* call.
+  uint32_t number_of_args = invoke->GetNumberOfArguments();
+  for (uint32_t i = 1; i < number_of_args; ++i) {
+    locations->SetInAt(i, calling_convention.GetNextLocation(invoke->InputAt(i)->GetType()));
+  }
+
+  // The last input is MethodType object corresponding to the call-site.
+  locations->SetInAt(number_of_args, Location::RequiresRegister());
+
+  // The target method is loaded into x0 while the MethodHandle is still needed by the slow path,
+  // so keep the inputs out of it.
+  locations->AddTemp(calling_convention.GetMethodLocation());
+  locations->AddTemp(Location::RequiresRegister());
+}
+
+void IntrinsicCodeGeneratorARM64::VisitMethodHandleInvokeExact(HInvoke* invoke) {
+  DCHECK(invoke->AsInvokePolymorphic()->CanHaveFastPath());
+  LocationSummary* locations = invoke->GetLocations();
+  MacroAssembler* masm = codegen_->GetVIXLAssembler();
+
+  Register method_handle = InputRegisterAt(invoke, 0);
+
+  SlowPathCodeARM64* slow_path =
+      new (codegen_->GetScopedAllocator()) InvokePolymorphicSlowPathARM64(invoke, method_handle);
+  codegen_->AddSlowPath(slow_path);
+
+  // Using the temp for the MethodHandle fields and later for the declaring class and the vtable
+  // index. It is not needed across the call.
+  Register temp = WRegisterFrom(locations->GetTemp(1));
+
+  // If it is not InvokeVirtual then go to slow path. See the x86-64 implementation for why
+  // other kinds of underlying methods are caught by the subtype check below.
+  __ Ldr(temp, HeapOperand(method_handle, mirror::MethodHandle::HandleKindOffset()));
+  __ Cmp(temp, static_cast<int32_t>(mirror::MethodHandle::Kind::kInvokeVirtual));
+  __ B(ne, slow_path->GetEntryLabel());
+
+  // Call site should match with MethodHandle's type. We deliberately avoid the read barrier,
+  // letting the slow path handle the false negatives.
+  Register call_site_type = InputRegisterAt(invoke, invoke->GetNumberOfArguments());
+  __ Ldr(temp, HeapOperand(method_handle, mirror::MethodHandle::MethodTypeOffset()));
+  codegen_->GetAssembler()->MaybeUnpoisonHeapReference(temp);
+  __ Cmp(call_site_type, temp);
+  __ B(ne, slow_path->GetEntryLabel());
+
+  // Get method to call.
+  Register method = XRegisterFrom(locations->GetTemp(0));
+  DCHECK(method.Is(kArtMethodRegister));
+  __ Ldr(method, MemOperand(method_handle.X(),
+                            mirror::MethodHandle::ArtFieldOrMethodOffset().Int32Value()));
+
+  Register receiver = InputRegisterAt(invoke, 1);
+  __ Cbz(receiver, slow_path->GetEntryLabel());
+
+  // If `method` is an interface method this check will fail.
+  __ Ldr(temp, MemOperand(method, ArtMethod::DeclaringClassOffset().Int32Value()));
+  GenerateSubTypeObjectCheckNoReadBarrier(
+      codegen_, slow_path, receiver, temp, /*object_can_be_null=*/ false);
+
+  vixl::aarch64::Label execute_target_method;
+  {
+    UseScratchRegisterScope temps(masm);
+    Register access_flags = temps.AcquireW();
+    // Skip virtual dispatch if `method` is private.
+    __ Ldr(access_flags, MemOperand(method, ArtMethod::AccessFlagsOffset().Int32Value()));
+    __ Tbnz(access_flags, WhichPowerOf2(kAccPrivate), &execute_target_method);
+  }
+
+  // MethodIndex is uint16_t.
+  __ Ldrh(temp, MemOperand(method, ArtMethod::MethodIndexOffset().Int32Value()));
+
+  // Re-using method register for receiver class.
+  __ Ldr(method.W(), HeapOperand(receiver, mirror::Object::ClassOffset()));
+  codegen_->GetAssembler()->MaybeUnpoisonHeapReference(method.W());
+
+  __ Add(method, method, mirror::Class::EmbeddedVTableOffset(kArm64PointerSize).Int32Value());
+  static_assert(static_cast<size_t>(kArm64PointerSize) == 8u);
+  __ Ldr(method, MemOperand(method, temp.X(), LSL, 3));
+
+  __ Bind(&execute_target_method);
+  __ Ldr(lr, MemOperand(
+      method, ArtMethod::EntryPointFromQuickCompiledCodeOffset(kArm64PointerSize).Int32Value()));
+  {
+    // Use a scope to help guarantee that `RecordPcInfo()` records the correct pc.
+    ExactAssemblyScope eas(masm, kInstructionSize, CodeBufferCheckScope::kExactSize);
+    __ blr(lr);
+    codegen_->RecordPcInfo(invoke, invoke->GetDexPc(), slow_path);
+  }
+  __ Bind(slow_path->GetExitLabel());
+}
+
 void IntrinsicLocationsBuilderARM64::VisitVarHandleGet(HInvoke* invoke) {
   CreateVarHandleGetLocations(invoke, codegen_);
 }
@@ -2321,7 +2321,7 @@ void IntrinsicCodeGeneratorARMVIXL::VisitMathFloor(HInvoke* invoke) {
                                              start_index);                                        \
     HandleValueOf(invoke, info, type);                                                            \
   }
-  BOXED_TYPES(VISIT_INTRINSIC)
+  BOXED_TYPES_32(VISIT_INTRINSIC)
 #undef VISIT_INTRINSIC
 
 
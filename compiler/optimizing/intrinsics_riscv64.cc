@@ -681,7 +681,7 @@ void IntrinsicCodeGeneratorRISCV64::VisitLongRemainderUnsigned(HInvoke* invoke)
                                              start_index);                               \
     HandleValueOf(invoke, info, type);                                                   \
   }
-  BOXED_TYPES(VISIT_INTRINSIC)
+  BOXED_TYPES_32(VISIT_INTRINSIC)
 #undef VISIT_INTRINSIC
 
 void IntrinsicCodeGeneratorRISCV64::HandleValueOf(HInvoke* invoke,
@@ -872,36 +872,203 @@ void IntrinsicCodeGeneratorRISCV64::VisitReferenceRefersTo(HInvoke* invoke) {
   __ Seqz(out, out);
 }
 
-static void GenerateVisitStringIndexOf(HInvoke* invoke,
-                                       Riscv64Assembler* assembler,
-                                       CodeGeneratorRISCV64* codegen,
-                                       bool start_at_zero) {
-  LocationSummary* locations = invoke->GetLocations();
+// Returns whether the String intrinsics can use the "V" extension.
+static bool UseVectorStringIntrinsics(CodeGeneratorRISCV64* codegen) {
+  return codegen->GetInstructionSetFeatures().HasVector();
+}
 
-  // Note that the null check must have been done earlier.
-  DCHECK(!invoke->CanDoImplicitNullCheckOn(invoke->InputAt(0)));
+static uint32_t VectorStringVType(Riscv64Assembler::SelectedElementWidth sew) {
+  // Use the largest register group. The data is only read, so the tail and inactive elements
+  // do not matter.
+  return Riscv64Assembler::VTypeiValue(Riscv64Assembler::VectorMaskAgnostic::kAgnostic,
+                                       Riscv64Assembler::VectorTailAgnostic::kAgnostic,
+                                       sew,
+                                       Riscv64Assembler::LengthMultiplier::kM8);
+}
 
-  // Check for code points > 0xFFFF. Either a slow-path check when we don't know statically,
-  // or directly dispatch for a large constant, or omit slow-path for a small constant or a char.
-  SlowPathCodeRISCV64* slow_path = nullptr;
+// Compare `count` bytes at `ptr1` and `ptr2` with vector instructions. If the data differ,
+// branch to `diff` with `index` holding the offset of the first differing byte from the
+// current `ptr1` and `ptr2`. Otherwise fall through with `count` equal to zero.
+// Clobbers `ptr1`, `ptr2`, `count`, `vl`, `index`, V0 and V8-V23.
+static void GenerateVectorMismatchLoop(Riscv64Assembler* assembler,
+                                       XRegister ptr1,
+                                       XRegister ptr2,
+                                       XRegister count,
+                                       XRegister vl,
+                                       XRegister index,
+                                       Riscv64Label* diff) {
+  Riscv64Label loop;
+  __ Bind(&loop);
+  __ VSetvli(vl, count, VectorStringVType(Riscv64Assembler::SelectedElementWidth::kE8));
+  __ VLe8(V8, ptr1);
+  __ VLe8(V16, ptr2);
+  __ VMsne_vv(V0, V8, V16);
+  __ VFirst_m(index, V0);
+  __ Bgez(index, diff);
+  __ Add(ptr1, ptr1, vl);
+  __ Add(ptr2, ptr2, vl);
+  __ Sub(count, count, vl);
+  __ Bnez(count, &loop);
+}
+
+// Check for code points > 0xFFFF. Either a slow-path check when we don't know statically,
+// or directly dispatch for a large constant, or omit slow-path for a small constant or a char.
+// Returns false if the code point is a large constant and the slow path was already emitted.
+static bool GenerateStringIndexOfCodePointCheck(HInvoke* invoke,
+                                                Riscv64Assembler* assembler,
+                                                CodeGeneratorRISCV64* codegen,
+                                                /*out*/ SlowPathCodeRISCV64** slow_path) {
+  LocationSummary* locations = invoke->GetLocations();
   HInstruction* code_point = invoke->InputAt(1);
   if (code_point->IsIntConstant()) {
     if (static_cast<uint32_t>(code_point->AsIntConstant()->GetValue()) > 0xFFFFU) {
       // Always needs the slow-path. We could directly dispatch to it, but this case should be
       // rare, so for simplicity just put the full slow-path down and branch unconditionally.
-      slow_path = new (codegen->GetScopedAllocator()) IntrinsicSlowPathRISCV64(invoke);
-      codegen->AddSlowPath(slow_path);
-      __ J(slow_path->GetEntryLabel());
-      __ Bind(slow_path->GetExitLabel());
-      return;
+      *slow_path = new (codegen->GetScopedAllocator()) IntrinsicSlowPathRISCV64(invoke);
+      codegen->AddSlowPath(*slow_path);
+      __ J((*slow_path)->GetEntryLabel());
+      __ Bind((*slow_path)->GetExitLabel());
+      return false;
     }
   } else if (code_point->GetType() != DataType::Type::kUint16) {
-    slow_path = new (codegen->GetScopedAllocator()) IntrinsicSlowPathRISCV64(invoke);
-    codegen->AddSlowPath(slow_path);
+    *slow_path = new (codegen->GetScopedAllocator()) IntrinsicSlowPathRISCV64(invoke);
+    codegen->AddSlowPath(*slow_path);
     ScratchRegisterScope srs(assembler);
     XRegister tmp = srs.AllocateXRegister();
     __ Srliw(tmp, locations->InAt(1).AsRegister<XRegister>(), 16);
-    __ Bnez(tmp, slow_path->GetEntryLabel());
+    __ Bnez(tmp, (*slow_path)->GetEntryLabel());
+  }
+  return true;
+}
+
+// Search the string for a char with vector instructions, separately for compressed and
+// uncompressed data. Supplementary code points are left to the slow path.
+static void GenerateVectorStringIndexOf(HInvoke* invoke,
+                                        Riscv64Assembler* assembler,
+                                        CodeGeneratorRISCV64* codegen,
+                                        bool start_at_zero) {
+  LocationSummary* locations = invoke->GetLocations();
+  XRegister str = locations->InAt(0).AsRegister<XRegister>();
+  XRegister ch = locations->InAt(1).AsRegister<XRegister>();
+  XRegister out = locations->Out().AsRegister<XRegister>();
+  XRegister ptr = locations->GetTemp(0).AsRegister<XRegister>();
+  XRegister remaining = locations->GetTemp(1).AsRegister<XRegister>();
+
+  // Note that the null check must have been done earlier.
+  DCHECK(!invoke->CanDoImplicitNullCheckOn(invoke->InputAt(0)));
+
+  SlowPathCodeRISCV64* slow_path = nullptr;
+  if (!GenerateStringIndexOfCodePointCheck(invoke, assembler, codegen, &slow_path)) {
+    return;
+  }
+
+  const int32_t count_offset = mirror::String::CountOffset().Int32Value();
+  const int32_t value_offset = mirror::String::ValueOffset().Int32Value();
+
+  ScratchRegisterScope srs(assembler);
+  XRegister vl = srs.AllocateXRegister();
+  XRegister index = srs.AllocateXRegister();
+
+  Riscv64Label not_found;
+  Riscv64Label found;
+  Riscv64Label done;
+
+  // Load the length and, with string compression, keep the compression flag in `vl`.
+  if (mirror::kUseStringCompression) {
+    __ Loadwu(vl, str, count_offset);
+    __ Srliw(remaining, vl, 1u);
+    __ Andi(vl, vl, 1);
+  } else {
+    __ Loadwu(remaining, str, count_offset);
+  }
+
+  // The start index is clamped to zero from below. A start index at or beyond the end
+  // yields -1 through the check of the remaining length below.
+  if (start_at_zero) {
+    __ Li(out, 0);
+  } else {
+    Riscv64Label start_ok;
+    __ Mv(out, locations->InAt(2).AsRegister<XRegister>());
+    __ Bgez(out, &start_ok);
+    __ Li(out, 0);
+    __ Bind(&start_ok);
+  }
+  __ Sub(remaining, remaining, out);
+  __ Blez(remaining, &not_found);
+  __ Addi(ptr, str, value_offset);
+
+  if (mirror::kUseStringCompression) {
+    Riscv64Label uncompressed;
+    static_assert(static_cast<uint32_t>(mirror::StringCompressionFlag::kCompressed) == 0u,
+                  "Expecting 0=compressed, 1=uncompressed");
+    __ Bnez(vl, &uncompressed);
+    // Compressed strings contain only chars up to 0xFF.
+    __ Srliw(index, ch, 8);
+    __ Bnez(index, &not_found);
+    __ Add(ptr, ptr, out);
+
+    Riscv64Label compressed_loop;
+    __ Bind(&compressed_loop);
+    __ VSetvli(vl, remaining, VectorStringVType(Riscv64Assembler::SelectedElementWidth::kE8));
+    __ VLe8(V8, ptr);
+    __ VMseq_vx(V0, V8, ch);
+    __ VFirst_m(index, V0);
+    __ Bgez(index, &found);
+    __ Add(ptr, ptr, vl);
+    __ Add(out, out, vl);
+    __ Sub(remaining, remaining, vl);
+    __ Bnez(remaining, &compressed_loop);
+    __ J(&not_found);
+
+    __ Bind(&uncompressed);
+  }
+
+  __ Slli(index, out, 1);
+  __ Add(ptr, ptr, index);
+
+  Riscv64Label uncompressed_loop;
+  __ Bind(&uncompressed_loop);
+  __ VSetvli(vl, remaining, VectorStringVType(Riscv64Assembler::SelectedElementWidth::kE16));
+  __ VLe16(V8, ptr);
+  __ VMseq_vx(V0, V8, ch);
+  __ VFirst_m(index, V0);
+  __ Bgez(index, &found);
+  __ Slli(index, vl, 1);
+  __ Add(ptr, ptr, index);
+  __ Add(out, out, vl);
+  __ Sub(remaining, remaining, vl);
+  __ Bnez(remaining, &uncompressed_loop);
+
+  __ Bind(&not_found);
+  __ Li(out, -1);
+  __ J(&done);
+
+  __ Bind(&found);
+  __ Add(out, out, index);
+  __ Bind(&done);
+
+  if (slow_path != nullptr) {
+    __ Bind(slow_path->GetExitLabel());
+  }
+}
+
+static void GenerateVisitStringIndexOf(HInvoke* invoke,
+                                       Riscv64Assembler* assembler,
+                                       CodeGeneratorRISCV64* codegen,
+                                       bool start_at_zero) {
+  if (UseVectorStringIntrinsics(codegen)) {
+    GenerateVectorStringIndexOf(invoke, assembler, codegen, start_at_zero);
+    return;
+  }
+
+  LocationSummary* locations = invoke->GetLocations();
+
+  // Note that the null check must have been done earlier.
+  DCHECK(!invoke->CanDoImplicitNullCheckOn(invoke->InputAt(0)));
+
+  SlowPathCodeRISCV64* slow_path = nullptr;
+  if (!GenerateStringIndexOfCodePointCheck(invoke, assembler, codegen, &slow_path)) {
+    return;
   }
 
   if (start_at_zero) {
@@ -918,7 +1085,25 @@ static void GenerateVisitStringIndexOf(HInvoke* invoke,
   }
 }
 
+static void CreateVectorStringIndexOfLocations(HInvoke* invoke,
+                                               ArenaAllocator* allocator,
+                                               bool start_at_zero) {
+  LocationSummary* locations =
+      new (allocator) LocationSummary(invoke, LocationSummary::kCallOnSlowPath, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  if (!start_at_zero) {
+    locations->SetInAt(2, Location::RequiresRegister());
+  }
+  locations->AddRegisterTemps(2);
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
 void IntrinsicLocationsBuilderRISCV64::VisitStringIndexOf(HInvoke* invoke) {
+  if (UseVectorStringIntrinsics(codegen_)) {
+    CreateVectorStringIndexOfLocations(invoke, allocator_, /* start_at_zero= */ true);
+    return;
+  }
   LocationSummary* locations = new (allocator_) LocationSummary(
       invoke, LocationSummary::kCallOnMainAndSlowPath, kIntrinsified);
   // We have a hand-crafted assembly stub that follows the runtime calling convention. So it's
@@ -937,6 +1122,10 @@ void IntrinsicCodeGeneratorRISCV64::VisitStringIndexOf(HInvoke* invoke) {
 }
 
 void IntrinsicLocationsBuilderRISCV64::VisitStringIndexOfAfter(HInvoke* invoke) {
+  if (UseVectorStringIntrinsics(codegen_)) {
+    CreateVectorStringIndexOfLocations(invoke, allocator_, /* start_at_zero= */ false);
+    return;
+  }
   LocationSummary* locations = new (allocator_) LocationSummary(
       invoke, LocationSummary::kCallOnMainAndSlowPath, kIntrinsified);
   // We have a hand-crafted assembly stub that follows the runtime calling convention. So it's
@@ -1069,6 +1258,71 @@ AqRl GetAmoAqRl(std::memory_order order) {
   return amo_aqrl;
 }
 
+void IntrinsicLocationsBuilderRISCV64::VisitArraysEqualsByte(HInvoke* invoke) {
+  // Without the "V" extension, compiled code of the Java implementation is good enough.
+  if (!codegen_->GetInstructionSetFeatures().HasVector()) {
+    return;
+  }
+
+  LocationSummary* locations =
+      new (allocator_) LocationSummary(invoke, LocationSummary::kNoCall, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->AddRegisterTemps(3);
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+void IntrinsicCodeGeneratorRISCV64::VisitArraysEqualsByte(HInvoke* invoke) {
+  DCHECK(codegen_->GetInstructionSetFeatures().HasVector());
+  Riscv64Assembler* assembler = GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  XRegister array1 = locations->InAt(0).AsRegister<XRegister>();
+  XRegister array2 = locations->InAt(1).AsRegister<XRegister>();
+  XRegister length = locations->GetTemp(0).AsRegister<XRegister>();
+  XRegister ptr1 = locations->GetTemp(1).AsRegister<XRegister>();
+  XRegister ptr2 = locations->GetTemp(2).AsRegister<XRegister>();
+  XRegister out = locations->Out().AsRegister<XRegister>();
+
+  ScratchRegisterScope srs(assembler);
+  XRegister vl = srs.AllocateXRegister();
+
+  Riscv64Label end;
+  Riscv64Label return_true;
+  Riscv64Label return_false;
+
+  const int32_t length_offset = mirror::Array::LengthOffset().Int32Value();
+  const int32_t data_offset = mirror::Array::DataOffset(sizeof(uint8_t)).Int32Value();
+
+  // Reference equality check, return true if same reference or both null.
+  __ Beq(array1, array2, &return_true);
+
+  // Otherwise return false if either array is null.
+  if (invoke->InputAt(0)->CanBeNull()) {
+    __ Beqz(array1, &return_false);
+  }
+  if (invoke->InputAt(1)->CanBeNull()) {
+    __ Beqz(array2, &return_false);
+  }
+
+  // Check if lengths are equal, return false if they're not.
+  __ Loadwu(length, array1, length_offset);
+  __ Loadwu(vl, array2, length_offset);
+  __ Bne(length, vl, &return_false);
+
+  __ Addi(ptr1, array1, data_offset);
+  __ Addi(ptr2, array2, data_offset);
+  GenerateVectorMismatchLoop(assembler, ptr1, ptr2, length, vl, out, &return_false);
+
+  __ Bind(&return_true);
+  __ Li(out, 1);
+  __ J(&end);
+
+  __ Bind(&return_false);
+  __ Li(out, 0);
+  __ Bind(&end);
+}
+
 static void EmitLoadReserved(Riscv64Assembler* assembler,
                              DataType::Type type,
                              XRegister ptr,
@@ -1102,6 +1356,10 @@ void IntrinsicLocationsBuilderRISCV64::VisitStringEquals(HInvoke* invoke) {
   locations->SetInAt(0, Location::RequiresRegister());
   locations->SetInAt(1, Location::RequiresRegister());
   locations->AddTemp(Location::RequiresRegister());
+  if (UseVectorStringIntrinsics(codegen_)) {
+    // The vector loop needs a register for the index of the first difference.
+    locations->AddTemp(Location::RequiresRegister());
+  }
   // TODO: If the String.equals() is used only for an immediately following HIf, we can
   // mark it as emitted-at-use-site and emit branches directly to the appropriate blocks.
   // Then we shall need an extra temporary register instead of the output register.
@@ -1184,21 +1442,31 @@ void IntrinsicCodeGeneratorRISCV64::VisitStringEquals(HInvoke* invoke) {
     __ Sllw(temp, temp, temp1);  // Calculate number of bytes to compare.
   }
 
-  // Store offset of string value in preparation for comparison loop
-  __ Li(temp1, value_offset);
-
   XRegister temp2 = srs.AllocateXRegister();
-  // Loop to compare strings 8 bytes at a time starting at the front of the string.
-  __ Bind(&loop);
-  __ Add(out, str, temp1);
-  __ Ld(out, out, 0);
-  __ Add(temp2, arg, temp1);
-  __ Ld(temp2, temp2, 0);
-  __ Addi(temp1, temp1, sizeof(uint64_t));
-  __ Bne(out, temp2, &return_false);
-  // With string compression, we have compared 8 bytes, otherwise 4 chars.
-  __ Addi(temp, temp, mirror::kUseStringCompression ? -8 : -4);
-  __ Bgt(temp, Zero, &loop);
+  if (UseVectorStringIntrinsics(codegen_)) {
+    if (!mirror::kUseStringCompression) {
+      __ Slli(temp, temp, 1u);  // Calculate number of bytes to compare.
+    }
+    XRegister temp3 = locations->GetTemp(1).AsRegister<XRegister>();
+    __ Addi(temp1, str, value_offset);
+    __ Addi(out, arg, value_offset);
+    GenerateVectorMismatchLoop(assembler, temp1, out, temp, temp2, temp3, &return_false);
+  } else {
+    // Store offset of string value in preparation for comparison loop
+    __ Li(temp1, value_offset);
+
+    // Loop to compare strings 8 bytes at a time starting at the front of the string.
+    __ Bind(&loop);
+    __ Add(out, str, temp1);
+    __ Ld(out, out, 0);
+    __ Add(temp2, arg, temp1);
+    __ Ld(temp2, temp2, 0);
+    __ Addi(temp1, temp1, sizeof(uint64_t));
+    __ Bne(out, temp2, &return_false);
+    // With string compression, we have compared 8 bytes, otherwise 4 chars.
+    __ Addi(temp, temp, mirror::kUseStringCompression ? -8 : -4);
+    __ Bgt(temp, Zero, &loop);
+  }
 
   // Return true and exit the function.
   // If loop does not result in returning false, we return true.
@@ -3184,8 +3452,6 @@ void IntrinsicCodeGeneratorRISCV64::VisitStringCompareTo(HInvoke* invoke) {
     __ Andi(temp2, temp2, 1);
     __ Bne(temp2, temp3, &different_compression);
   }
-  // Store offset of string value in preparation for comparison loop.
-  __ Li(temp1, value_offset);
   if (mirror::kUseStringCompression) {
     // For string compression, calculate the number of bytes to compare (not chars).
     __ Sll(temp0, temp0, temp3);
@@ -3201,49 +3467,83 @@ void IntrinsicCodeGeneratorRISCV64::VisitStringCompareTo(HInvoke* invoke) {
   ScratchRegisterScope scratch_scope(assembler);
   XRegister temp4 = scratch_scope.AllocateXRegister();
 
-  // Loop to compare 4x16-bit characters at a time (ok because of string data alignment).
-  __ Bind(&loop);
-  __ Add(temp4, str, temp1);
-  __ Ld(temp4, temp4, 0);
-  __ Add(temp2, arg, temp1);
-  __ Ld(temp2, temp2, 0);
-  __ Bne(temp4, temp2, &find_char_diff);
-  __ Addi(temp1, temp1, char_size * 4);
-  // With string compression, we have compared 8 bytes, otherwise 4 chars.
-  __ Addi(temp0, temp0, (mirror::kUseStringCompression) ? -8 : -4);
-  __ Bgtz(temp0, &loop);
-  __ J(&end);
+  if (UseVectorStringIntrinsics(codegen_)) {
+    if (!mirror::kUseStringCompression) {
+      __ Slli(temp0, temp0, 1u);  // Calculate number of bytes to compare.
+    }
+    XRegister temp5 = scratch_scope.AllocateXRegister();
+    __ Addi(temp1, str, value_offset);
+    __ Addi(temp2, arg, value_offset);
+    GenerateVectorMismatchLoop(assembler, temp1, temp2, temp0, temp4, temp5, &find_char_diff);
+    __ J(&end);
 
-  // Find the single character difference.
-  __ Bind(&find_char_diff);
-  // Get the bit position of the first character that differs.
-  __ Xor(temp1, temp2, temp4);
-  __ Ctz(temp1, temp1);
-
-  // If the number of chars remaining <= the index where the difference occurs (0-3), then
-  // the difference occurs outside the remaining string data, so just return length diff (out).
-  __ Srliw(temp1, temp1, (mirror::kUseStringCompression) ? 3 : 4);
-  __ Ble(temp0, temp1, &end);
-
-  // Extract the characters and calculate the difference.
-  __ Slliw(temp1, temp1, (mirror::kUseStringCompression) ? 3 : 4);
-  if (mirror:: kUseStringCompression) {
-    __ Slliw(temp3, temp3, 3u);
-    __ Andn(temp1, temp1, temp3);
-  }
-  __ Srl(temp2, temp2, temp1);
-  __ Srl(temp4, temp4, temp1);
-  if (mirror::kUseStringCompression) {
-    __ Li(temp0, -256);           // ~0xff
-    __ Sllw(temp0, temp0, temp3);  // temp3 = 0 or 8, temp0 := ~0xff or ~0xffff
-    __ Andn(temp4, temp4, temp0);  // Extract 8 or 16 bits.
-    __ Andn(temp2, temp2, temp0);  // Extract 8 or 16 bits.
+    // Load the first characters that differ and calculate the difference.
+    __ Bind(&find_char_diff);
+    __ Add(temp1, temp1, temp5);
+    __ Add(temp2, temp2, temp5);
+    if (mirror::kUseStringCompression) {
+      Riscv64Label uncompressed_char_diff;
+      __ Bnez(temp3, &uncompressed_char_diff);
+      __ Lbu(temp4, temp1, 0);
+      __ Lbu(temp5, temp2, 0);
+      __ Subw(out, temp4, temp5);
+      __ J(&end);
+      __ Bind(&uncompressed_char_diff);
+    }
+    // The differing byte can be the high byte of a char, so align down to the char.
+    __ Andi(temp1, temp1, -static_cast<int32_t>(char_size));
+    __ Andi(temp2, temp2, -static_cast<int32_t>(char_size));
+    __ Lhu(temp4, temp1, 0);
+    __ Lhu(temp5, temp2, 0);
+    __ Subw(out, temp4, temp5);
   } else {
-    __ ZextH(temp4, temp4);
-    __ ZextH(temp2, temp2);
-  }
+    // Store offset of string value in preparation for comparison loop.
+    __ Li(temp1, value_offset);
 
-  __ Subw(out, temp4, temp2);
+    // Loop to compare 4x16-bit characters at a time (ok because of string data alignment).
+    __ Bind(&loop);
+    __ Add(temp4, str, temp1);
+    __ Ld(temp4, temp4, 0);
+    __ Add(temp2, arg, temp1);
+    __ Ld(temp2, temp2, 0);
+    __ Bne(temp4, temp2, &find_char_diff);
+    __ Addi(temp1, temp1, char_size * 4);
+    // With string compression, we have compared 8 bytes, otherwise 4 chars.
+    __ Addi(temp0, temp0, (mirror::kUseStringCompression) ? -8 : -4);
+    __ Bgtz(temp0, &loop);
+    __ J(&end);
+
+    // Find the single character difference.
+    __ Bind(&find_char_diff);
+    // Get the bit position of the first character that differs.
+    __ Xor(temp1, temp2, temp4);
+    __ Ctz(temp1, temp1);
+
+    // If the number of chars remaining <= the index where the difference occurs (0-3), then
+    // the difference occurs outside the remaining string data, so just return length diff (out).
+    __ Srliw(temp1, temp1, (mirror::kUseStringCompression) ? 3 : 4);
+    __ Ble(temp0, temp1, &end);
+
+    // Extract the characters and calculate the difference.
+    __ Slliw(temp1, temp1, (mirror::kUseStringCompression) ? 3 : 4);
+    if (mirror:: kUseStringCompression) {
+      __ Slliw(temp3, temp3, 3u);
+      __ Andn(temp1, temp1, temp3);
+    }
+    __ Srl(temp2, temp2, temp1);
+    __ Srl(temp4, temp4, temp1);
+    if (mirror::kUseStringCompression) {
+      __ Li(temp0, -256);           // ~0xff
+      __ Sllw(temp0, temp0, temp3);  // temp3 = 0 or 8, temp0 := ~0xff or ~0xffff
+      __ Andn(temp4, temp4, temp0);  // Extract 8 or 16 bits.
+      __ Andn(temp2, temp2, temp0);  // Extract 8 or 16 bits.
+    } else {
+      __ ZextH(temp4, temp4);
+      __ ZextH(temp2, temp2);
+    }
+
+    __ Subw(out, temp4, temp2);
+  }
 
   if (mirror::kUseStringCompression) {
     __ J(&end);
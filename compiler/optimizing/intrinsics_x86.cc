@@ -3415,7 +3415,7 @@ static void RequestBaseMethodAddressInRegister(HInvoke* invoke) {
                                              start_index);                               \
     HandleValueOf(invoke, info, type);                                                   \
   }
-  BOXED_TYPES(VISIT_INTRINSIC)
+  BOXED_TYPES_32(VISIT_INTRINSIC)
 #undef VISIT_INTRINSIC
 
 void IntrinsicCodeGeneratorX86::HandleValueOf(HInvoke* invoke,
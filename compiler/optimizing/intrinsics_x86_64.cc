@@ -1341,6 +1341,92 @@ void IntrinsicCodeGeneratorX86_64::VisitStringEquals(HInvoke* invoke) {
   __ Bind(&end);
 }
 
+void IntrinsicLocationsBuilderX86_64::VisitArraysEqualsByte(HInvoke* invoke) {
+  LocationSummary* locations =
+      new (allocator_) LocationSummary(invoke, LocationSummary::kNoCall, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->AddRegisterTemps(3);
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitArraysEqualsByte(HInvoke* invoke) {
+  X86_64Assembler* assembler = GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  CpuRegister array1 = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister array2 = locations->InAt(1).AsRegister<CpuRegister>();
+  CpuRegister last = locations->GetTemp(0).AsRegister<CpuRegister>();
+  CpuRegister offset = locations->GetTemp(1).AsRegister<CpuRegister>();
+  CpuRegister temp = locations->GetTemp(2).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+
+  NearLabel end, return_true, return_false, loop, short_array, short_loop;
+
+  const uint32_t length_offset = mirror::Array::LengthOffset().Uint32Value();
+  const uint32_t data_offset = mirror::Array::DataOffset(sizeof(uint8_t)).Uint32Value();
+
+  // Reference equality check, return true if same reference or both null.
+  __ cmpl(array1, array2);
+  __ j(kEqual, &return_true);
+
+  // Otherwise return false if either array is null.
+  if (invoke->InputAt(0)->CanBeNull()) {
+    __ testl(array1, array1);
+    __ j(kEqual, &return_false);
+  }
+  if (invoke->InputAt(1)->CanBeNull()) {
+    __ testl(array2, array2);
+    __ j(kEqual, &return_false);
+  }
+
+  // Check if lengths are equal, return false if they're not.
+  __ movl(last, Address(array1, length_offset));
+  __ cmpl(last, Address(array2, length_offset));
+  __ j(kNotEqual, &return_false);
+
+  __ movl(offset, Immediate(data_offset));
+  __ cmpl(last, Immediate(8));
+  __ j(kLess, &short_array);
+
+  // Compare 8 bytes at a time. The last 8 bytes are compared separately and may overlap
+  // bytes already compared, so that nothing beyond the array data is read.
+  __ addl(last, Immediate(data_offset - 8));
+  __ Bind(&loop);
+  __ movq(out, Address(array1, offset, TIMES_1, 0));
+  __ cmpq(out, Address(array2, offset, TIMES_1, 0));
+  __ j(kNotEqual, &return_false);
+  __ addl(offset, Immediate(8));
+  __ cmpl(offset, last);
+  __ j(kBelow, &loop);
+  __ movq(out, Address(array1, last, TIMES_1, 0));
+  __ cmpq(out, Address(array2, last, TIMES_1, 0));
+  __ j(kNotEqual, &return_false);
+  __ jmp(&return_true);
+
+  // Compare arrays shorter than 8 bytes one byte at a time.
+  __ Bind(&short_array);
+  __ testl(last, last);
+  __ j(kEqual, &return_true);
+  __ addl(last, Immediate(data_offset));
+  __ Bind(&short_loop);
+  __ movzxb(out, Address(array1, offset, TIMES_1, 0));
+  __ movzxb(temp, Address(array2, offset, TIMES_1, 0));
+  __ cmpl(out, temp);
+  __ j(kNotEqual, &return_false);
+  __ addl(offset, Immediate(1));
+  __ cmpl(offset, last);
+  __ j(kBelow, &short_loop);
+
+  __ Bind(&return_true);
+  __ movl(out, Immediate(1));
+  __ jmp(&end);
+
+  __ Bind(&return_false);
+  __ xorl(out, out);
+  __ Bind(&end);
+}
+
 static void CreateStringIndexOfLocations(HInvoke* invoke,
                                          ArenaAllocator* allocator,
                                          bool start_at_zero) {
@@ -1685,9 +1771,14 @@ void IntrinsicCodeGeneratorX86_64::VisitStringGetCharsNoCheck(HInvoke* invoke) {
   __ Bind(&done);
 }
 
-static void GenPeek(LocationSummary* locations, DataType::Type size, X86_64Assembler* assembler) {
-  CpuRegister address = locations->InAt(0).AsRegister<CpuRegister>();
-  CpuRegister out = locations->Out().AsRegister<CpuRegister>();  // == address, here for clarity.
+// The `address` is input 0 for the Memory.peek*() intrinsics and input 1 for the
+// Unsafe.get*(long) intrinsics where input 0 is the unused receiver.
+static void GenPeek(LocationSummary* locations,
+                    DataType::Type size,
+                    X86_64Assembler* assembler,
+                    size_t address_index = 0u) {
+  CpuRegister address = locations->InAt(address_index).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
   // x86 allows unaligned access. We do not have to check the input or use specific instructions
   // to avoid a SIGBUS.
   switch (size) {
@@ -1748,9 +1839,12 @@ static void CreateIntIntToVoidLocations(ArenaAllocator* allocator, HInvoke* invo
   locations->SetInAt(1, Location::RegisterOrInt32Constant(invoke->InputAt(1)));
 }
 
-static void GenPoke(LocationSummary* locations, DataType::Type size, X86_64Assembler* assembler) {
-  CpuRegister address = locations->InAt(0).AsRegister<CpuRegister>();
-  Location value = locations->InAt(1);
+static void GenPoke(LocationSummary* locations,
+                    DataType::Type size,
+                    X86_64Assembler* assembler,
+                    size_t address_index = 0u) {
+  CpuRegister address = locations->InAt(address_index).AsRegister<CpuRegister>();
+  Location value = locations->InAt(address_index + 1u);
   // x86 allows unaligned access. We do not have to check the input or use specific instructions
   // to avoid a SIGBUS.
   switch (size) {
@@ -1826,6 +1920,98 @@ void IntrinsicCodeGeneratorX86_64::VisitMemoryPokeShortNative(HInvoke* invoke) {
   GenPoke(invoke->GetLocations(), DataType::Type::kInt16, GetAssembler());
 }
 
+static void CreateUnsafeGetAbsoluteLocations(ArenaAllocator* allocator, HInvoke* invoke) {
+  LocationSummary* locations =
+      new (allocator) LocationSummary(invoke, LocationSummary::kNoCall, kIntrinsified);
+  locations->SetInAt(0, Location::NoLocation());        // Unused receiver.
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+}
+
+static void CreateUnsafePutAbsoluteLocations(ArenaAllocator* allocator, HInvoke* invoke) {
+  LocationSummary* locations =
+      new (allocator) LocationSummary(invoke, LocationSummary::kNoCall, kIntrinsified);
+  locations->SetInAt(0, Location::NoLocation());        // Unused receiver.
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->SetInAt(2, Location::RegisterOrInt32Constant(invoke->InputAt(2)));
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitUnsafeGetByteAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafeGetByteAbsolute(invoke);
+}
+void IntrinsicLocationsBuilderX86_64::VisitUnsafeGetAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafeGetAbsolute(invoke);
+}
+void IntrinsicLocationsBuilderX86_64::VisitUnsafeGetLongAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafeGetLongAbsolute(invoke);
+}
+void IntrinsicLocationsBuilderX86_64::VisitUnsafePutByteAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafePutByteAbsolute(invoke);
+}
+void IntrinsicLocationsBuilderX86_64::VisitUnsafePutAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafePutAbsolute(invoke);
+}
+void IntrinsicLocationsBuilderX86_64::VisitUnsafePutLongAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafePutLongAbsolute(invoke);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitJdkUnsafeGetByteAbsolute(HInvoke* invoke) {
+  CreateUnsafeGetAbsoluteLocations(allocator_, invoke);
+}
+void IntrinsicLocationsBuilderX86_64::VisitJdkUnsafeGetAbsolute(HInvoke* invoke) {
+  CreateUnsafeGetAbsoluteLocations(allocator_, invoke);
+}
+void IntrinsicLocationsBuilderX86_64::VisitJdkUnsafeGetLongAbsolute(HInvoke* invoke) {
+  CreateUnsafeGetAbsoluteLocations(allocator_, invoke);
+}
+void IntrinsicLocationsBuilderX86_64::VisitJdkUnsafePutByteAbsolute(HInvoke* invoke) {
+  CreateUnsafePutAbsoluteLocations(allocator_, invoke);
+}
+void IntrinsicLocationsBuilderX86_64::VisitJdkUnsafePutAbsolute(HInvoke* invoke) {
+  CreateUnsafePutAbsoluteLocations(allocator_, invoke);
+}
+void IntrinsicLocationsBuilderX86_64::VisitJdkUnsafePutLongAbsolute(HInvoke* invoke) {
+  CreateUnsafePutAbsoluteLocations(allocator_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitUnsafeGetByteAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafeGetByteAbsolute(invoke);
+}
+void IntrinsicCodeGeneratorX86_64::VisitUnsafeGetAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafeGetAbsolute(invoke);
+}
+void IntrinsicCodeGeneratorX86_64::VisitUnsafeGetLongAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafeGetLongAbsolute(invoke);
+}
+void IntrinsicCodeGeneratorX86_64::VisitUnsafePutByteAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafePutByteAbsolute(invoke);
+}
+void IntrinsicCodeGeneratorX86_64::VisitUnsafePutAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafePutAbsolute(invoke);
+}
+void IntrinsicCodeGeneratorX86_64::VisitUnsafePutLongAbsolute(HInvoke* invoke) {
+  VisitJdkUnsafePutLongAbsolute(invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitJdkUnsafeGetByteAbsolute(HInvoke* invoke) {
+  GenPeek(invoke->GetLocations(), DataType::Type::kInt8, GetAssembler(), /*address_index=*/ 1u);
+}
+void IntrinsicCodeGeneratorX86_64::VisitJdkUnsafeGetAbsolute(HInvoke* invoke) {
+  GenPeek(invoke->GetLocations(), DataType::Type::kInt32, GetAssembler(), /*address_index=*/ 1u);
+}
+void IntrinsicCodeGeneratorX86_64::VisitJdkUnsafeGetLongAbsolute(HInvoke* invoke) {
+  GenPeek(invoke->GetLocations(), DataType::Type::kInt64, GetAssembler(), /*address_index=*/ 1u);
+}
+void IntrinsicCodeGeneratorX86_64::VisitJdkUnsafePutByteAbsolute(HInvoke* invoke) {
+  GenPoke(invoke->GetLocations(), DataType::Type::kInt8, GetAssembler(), /*address_index=*/ 1u);
+}
+void IntrinsicCodeGeneratorX86_64::VisitJdkUnsafePutAbsolute(HInvoke* invoke) {
+  GenPoke(invoke->GetLocations(), DataType::Type::kInt32, GetAssembler(), /*address_index=*/ 1u);
+}
+void IntrinsicCodeGeneratorX86_64::VisitJdkUnsafePutLongAbsolute(HInvoke* invoke) {
+  GenPoke(invoke->GetLocations(), DataType::Type::kInt64, GetAssembler(), /*address_index=*/ 1u);
+}
+
 void IntrinsicLocationsBuilderX86_64::VisitThreadCurrentThread(HInvoke* invoke) {
   LocationSummary* locations =
       new (allocator_) LocationSummary(invoke, LocationSummary::kNoCall, kIntrinsified);
@@ -3263,6 +3449,10 @@ static void Store(X86_64Assembler* assembler,
       __ movl(address, operand);
       break;
     }
+    case DataType::Type::kInt64: {
+      __ movq(address, operand);
+      break;
+    }
     default: {
       LOG(FATAL) << "Unrecognized ValueOf type " << primitive_type;
     }
@@ -3283,9 +3473,9 @@ void IntrinsicCodeGeneratorX86_64::HandleValueOf(HInvoke* invoke,
     codegen_->InvokeRuntime(kQuickAllocObjectInitialized, invoke, invoke->GetDexPc());
     CheckEntrypointTypes<kQuickAllocObjectWithChecks, void*, mirror::Class*>();
   };
-  if (invoke->InputAt(0)->IsIntConstant()) {
-    int32_t value = invoke->InputAt(0)->AsIntConstant()->GetValue();
-    if (static_cast<uint32_t>(value - info.low) < info.length) {
+  if (invoke->InputAt(0)->IsConstant()) {
+    int64_t value = Int64FromConstant(invoke->InputAt(0)->AsConstant());
+    if (static_cast<uint64_t>(value - info.low) < info.length) {
       // Just embed the object in the code.
       DCHECK_NE(info.value_boot_image_reference, ValueOfInfo::kInvalidReference);
       codegen_->LoadBootImageAddress(out, info.value_boot_image_reference);
@@ -3295,14 +3485,27 @@ void IntrinsicCodeGeneratorX86_64::HandleValueOf(HInvoke* invoke,
       // TODO: If we JIT, we could allocate the boxed value now, and store it in the
       // JIT object table.
       allocate_instance();
-      Store(assembler, type, Address(out, info.value_offset), Immediate(value));
+      if (IsInt<32>(value)) {
+        Store(assembler, type, Address(out, info.value_offset), Immediate(value));
+      } else {
+        // Only a long value can be out of the 32-bit immediate range. The class
+        // argument register is free after the allocation.
+        DCHECK_EQ(type, DataType::Type::kInt64);
+        codegen_->Load64BitValue(argument, value);
+        Store(assembler, type, Address(out, info.value_offset), argument);
+      }
     }
   } else {
     DCHECK(locations->CanCall());
     CpuRegister in = locations->InAt(0).AsRegister<CpuRegister>();
     // Check bounds of our cache.
-    __ leal(out, Address(in, -info.low));
-    __ cmpl(out, Immediate(info.length));
+    if (type == DataType::Type::kInt64) {
+      __ leaq(out, Address(in, -info.low));
+      __ cmpq(out, Immediate(info.length));
+    } else {
+      __ leal(out, Address(in, -info.low));
+      __ cmpl(out, Immediate(info.length));
+    }
     NearLabel allocate, done;
     __ j(kAboveEqual, &allocate);
     // If the value is within the bounds, load the boxed value directly from the array.
@@ -16,6 +16,10 @@
 
 #include "licm.h"
 
+#include "base/array_ref.h"
+#include "base/scoped_arena_allocator.h"
+#include "base/scoped_arena_containers.h"
+#include "load_store_analysis.h"
 #include "side_effects_analysis.h"
 
 namespace art HIDDEN {
@@ -78,10 +82,79 @@ static void UpdateLoopPhisIn(HEnvironment* environment, HLoopInformation* info)
   }
 }
 
+/**
+ * Returns whether the field load `load` may read a value written by one of `loop_writes`,
+ * using the aliasing information of `heap_location_collector` for field stores.
+ */
+static bool MayLoadValueWrittenInLoop(HInstruction* load,
+                                      ArrayRef<HInstruction* const> loop_writes,
+                                      const HeapLocationCollector& heap_location_collector) {
+  DCHECK(load->IsInstanceFieldGet() || load->IsStaticFieldGet());
+  size_t load_location = heap_location_collector.GetFieldHeapLocation(
+      load->InputAt(0), &load->GetFieldInfo());
+  if (load_location == HeapLocationCollector::kHeapLocationNotFound) {
+    return true;
+  }
+  for (HInstruction* write : loop_writes) {
+    if (!load->GetSideEffects().MayDependOn(write->GetSideEffects())) {
+      continue;
+    }
+    if (!write->IsInstanceFieldSet() && !write->IsStaticFieldSet()) {
+      // Invokes, volatile stores, monitor operations, ...
+      return true;
+    }
+    size_t write_location = heap_location_collector.GetFieldHeapLocation(
+        write->InputAt(0), &write->GetFieldInfo());
+    if (write_location == HeapLocationCollector::kHeapLocationNotFound ||
+        heap_location_collector.MayAlias(load_location, write_location)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool LICM::Run() {
   bool didLICM = false;
   DCHECK(side_effects_.HasRun());
 
+  // The side effects of a loop only tell which types of fields it writes. For field loads
+  // that depend on them, we ask the load store analysis whether the stores of the loop may
+  // actually alias the load. The analysis is only run when we find such a load.
+  ScopedArenaAllocator allocator(graph_->GetArenaStack());
+  LoadStoreAnalysis lsa(graph_, /*stats=*/ nullptr, &allocator);
+  bool lsa_has_run = false;
+  bool has_aliasing_info = false;
+  ScopedArenaVector<HInstruction*> loop_writes(allocator.Adapter(kArenaAllocLICM));
+  HBasicBlock* loop_writes_header = nullptr;
+  auto is_load_invariant_in_loop = [&](HInstruction* load, HLoopInformation* loop_info) {
+    if ((!load->IsInstanceFieldGet() && !load->IsStaticFieldGet()) ||
+        load->GetFieldInfo().IsVolatile()) {
+      return false;
+    }
+    if (!lsa_has_run) {
+      lsa_has_run = true;
+      has_aliasing_info = lsa.Run();
+    }
+    if (!has_aliasing_info) {
+      return false;
+    }
+    if (loop_writes_header != loop_info->GetHeader()) {
+      loop_writes_header = loop_info->GetHeader();
+      loop_writes.clear();
+      for (HBlocksInLoopIterator it_loop(*loop_info); !it_loop.Done(); it_loop.Advance()) {
+        for (HInstructionIterator inst_it(it_loop.Current()->GetInstructions());
+             !inst_it.Done();
+             inst_it.Advance()) {
+          if (inst_it.Current()->DoesAnyWrite()) {
+            loop_writes.push_back(inst_it.Current());
+          }
+        }
+      }
+    }
+    return !MayLoadValueWrittenInLoop(
+        load, ArrayRef<HInstruction* const>(loop_writes), lsa.GetHeapLocationCollector());
+  };
+
   // Only used during debug.
   ArenaBitVector* visited = nullptr;
   if (kIsDebugBuild) {
@@ -146,6 +219,9 @@ bool LICM::Run() {
             }
           } else if (!instruction->GetSideEffects().MayDependOn(loop_effects)) {
             can_move = true;
+          } else if (is_load_invariant_in_loop(instruction, loop_info)) {
+            MaybeRecordStat(stats_, MethodCompilationStat::kLoopInvariantLoadMoved);
+            can_move = true;
           }
         }
         if (can_move) {
@@ -110,6 +110,37 @@ TEST_F(LICMTest, NoFieldHoisting) {
   EXPECT_EQ(set_field->GetBlock(), loop_body_);
 }
 
+TEST_F(LICMTest, FieldHoistingWithNonAliasingStore) {
+  BuildLoop();
+
+  // Populate the loop with instructions: set/get different fields with the same type.
+  HInstruction* get_field =
+      MakeIFieldGet(loop_body_, parameter_, DataType::Type::kInt32, MemberOffset(10));
+  HInstruction* set_field = MakeIFieldSet(loop_body_, parameter_, get_field, MemberOffset(20));
+
+  EXPECT_EQ(get_field->GetBlock(), loop_body_);
+  EXPECT_EQ(set_field->GetBlock(), loop_body_);
+  PerformLICM();
+  EXPECT_EQ(get_field->GetBlock(), loop_preheader_);
+  EXPECT_EQ(set_field->GetBlock(), loop_body_);
+}
+
+TEST_F(LICMTest, NoFieldHoistingWithInvoke) {
+  BuildLoop();
+
+  // Populate the loop with instructions: get a field and call a method that may write it.
+  HInstruction* get_field =
+      MakeIFieldGet(loop_body_, parameter_, DataType::Type::kInt32, MemberOffset(10));
+  HInstruction* set_field = MakeIFieldSet(loop_body_, parameter_, get_field, MemberOffset(20));
+  HInstruction* invoke = MakeInvokeStatic(loop_body_, DataType::Type::kVoid, {}, {});
+
+  EXPECT_EQ(get_field->GetBlock(), loop_body_);
+  PerformLICM();
+  EXPECT_EQ(get_field->GetBlock(), loop_body_);
+  EXPECT_EQ(set_field->GetBlock(), loop_body_);
+  EXPECT_EQ(invoke->GetBlock(), loop_body_);
+}
+
 TEST_F(LICMTest, ArrayHoisting) {
   BuildLoop();
 
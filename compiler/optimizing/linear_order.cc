@@ -16,8 +16,11 @@
 
 #include "linear_order.h"
 
+#include <algorithm>
+
 #include "base/scoped_arena_allocator.h"
 #include "base/scoped_arena_containers.h"
+#include "code_sinking.h"
 
 namespace art HIDDEN {
 
@@ -87,7 +90,10 @@ void LinearizeGraphInternal(const HGraph* graph, ArrayRef<HBasicBlock*> linear_o
   DCHECK_EQ(linear_order.size(), graph->GetReversePostOrder().size());
   // Create a reverse post ordering with the following properties:
   // - Blocks in a loop are consecutive,
-  // - Back-edge is the last block before loop exits.
+  // - Back-edge is the last block before loop exits,
+  // - The successor of a profiled branch that is commonly taken comes right after the branch,
+  // - Blocks outside loops that are only reached through rarely taken profiled branches
+  //   come as late as possible.
   //
   // (1): Record the number of forward predecessors for each block. This is to
   //      ensure the resulting order is reverse post order. We could use the
@@ -108,23 +114,63 @@ void LinearizeGraphInternal(const HGraph* graph, ArrayRef<HBasicBlock*> linear_o
   //      iterate over the successors. When all non-back edge predecessors of a
   //      successor block are visited, the successor block is added in the worklist
   //      following an order that satisfies the requirements to build our linear graph.
+  //      Cold blocks, which are outside loops and only reached through rarely taken
+  //      branches, go to a separate worklist that is only used once the other one is
+  //      empty. This keeps them out of the hot code without breaking (1) or loops.
   ScopedArenaVector<HBasicBlock*> worklist(allocator.Adapter(kArenaAllocLinearOrder));
+  ScopedArenaVector<HBasicBlock*> cold_worklist(allocator.Adapter(kArenaAllocLinearOrder));
+  ArenaBitVector is_cold(
+      &allocator, graph->GetBlocks().size(), /* expandable= */ false, kArenaAllocLinearOrder);
   worklist.push_back(graph->GetEntryBlock());
   size_t num_added = 0u;
   do {
-    HBasicBlock* current = worklist.back();
-    worklist.pop_back();
+    ScopedArenaVector<HBasicBlock*>* current_worklist =
+        worklist.empty() ? &cold_worklist : &worklist;
+    HBasicBlock* current = current_worklist->back();
+    current_worklist->pop_back();
     linear_order[num_added] = current;
     ++num_added;
-    for (HBasicBlock* successor : current->GetSuccessors()) {
+    HBasicBlock* uncommon_successor = current->EndsWithIf()
+        ? CodeSinking::GetProfiledUncommonSuccessor(current->GetLastInstruction()->AsIf())
+        : nullptr;
+    auto visit_successor = [&](HBasicBlock* successor) {
       int block_id = successor->GetBlockId();
       size_t number_of_remaining_predecessors = forward_predecessors[block_id];
-      if (number_of_remaining_predecessors == 1) {
+      forward_predecessors[block_id] = number_of_remaining_predecessors - 1;
+      if (number_of_remaining_predecessors != 1) {
+        return;
+      }
+      bool cold = false;
+      if (!IsLoop(successor->GetLoopInformation())) {
+        const ArenaVector<HBasicBlock*>& predecessors = successor->GetPredecessors();
+        cold = (successor == uncommon_successor && predecessors.size() == 1u) ||
+               std::all_of(predecessors.begin(),
+                           predecessors.end(),
+                           [&](HBasicBlock* predecessor) {
+                             return is_cold.IsBitSet(predecessor->GetBlockId());
+                           });
+      }
+      if (cold) {
+        is_cold.SetBit(block_id);
+        cold_worklist.push_back(successor);
+      } else {
         AddToListForLinearization(&worklist, successor);
       }
-      forward_predecessors[block_id] = number_of_remaining_predecessors - 1;
+    };
+    if (uncommon_successor != nullptr) {
+      // The last block added to the worklist is the next one to be processed, so visit
+      // the commonly taken successor last to let the branch fall through to it.
+      HIf* if_instruction = current->GetLastInstruction()->AsIf();
+      visit_successor(uncommon_successor);
+      visit_successor(uncommon_successor == if_instruction->IfTrueSuccessor()
+                          ? if_instruction->IfFalseSuccessor()
+                          : if_instruction->IfTrueSuccessor());
+    } else {
+      for (HBasicBlock* successor : current->GetSuccessors()) {
+        visit_successor(successor);
+      }
     }
-  } while (!worklist.empty());
+  } while (!worklist.empty() || !cold_worklist.empty());
   DCHECK_EQ(num_added, linear_order.size());
 
   DCHECK(graph->HasIrreducibleLoops() || IsLinearOrderWellFormed(graph, linear_order));
@@ -28,7 +28,9 @@ void LinearizeGraphInternal(const HGraph* graph, ArrayRef<HBasicBlock*> linear_o
 
 // Linearizes the 'graph' such that:
 // (1): a block is always after its dominator,
-// (2): blocks of loops are contiguous.
+// (2): blocks of loops are contiguous,
+// (3): profiled branches fall through to their commonly taken successor, and blocks
+//      outside loops only reached through rarely taken branches are placed last.
 //
 // Storage is obtained through 'allocator' and the linear order it computed
 // into 'linear_order'. Once computed, iteration can be expressed as:
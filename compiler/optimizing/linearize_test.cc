@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <fstream>
 
 #include "base/arena_allocator.h"
@@ -245,4 +246,51 @@ TEST_F(LinearizeTest, CFG7) {
   TestCode(data, blocks);
 }
 
+TEST_F(LinearizeTest, ProfiledUncommonBranch) {
+  // Structure of this graph
+  //            Block0
+  //              |
+  //            Block1
+  //            /   \
+  //     (hot) /     \ (rarely taken)
+  //      Block2     Block3
+  //            \   /
+  //            Block4
+  const std::vector<uint16_t> data = ONE_REGISTER_CODE_ITEM(
+    Instruction::CONST_4 | 0 | 0,
+    Instruction::IF_EQ, 3,
+    Instruction::RETURN_VOID,
+    Instruction::RETURN_VOID);
+
+  HGraph* graph = CreateCFG(data);
+  HIf* if_instruction = nullptr;
+  for (HBasicBlock* block : graph->GetReversePostOrder()) {
+    if (block->EndsWithIf()) {
+      if_instruction = block->GetLastInstruction()->AsIf();
+    }
+  }
+  ASSERT_TRUE(if_instruction != nullptr);
+  HBasicBlock* hot_successor = if_instruction->IfTrueSuccessor();
+  HBasicBlock* cold_successor = if_instruction->IfFalseSuccessor();
+  if_instruction->SetTrueCount(5000u);
+  if_instruction->SetFalseCount(1u);
+
+  std::unique_ptr<CompilerOptions> compiler_options =
+      CommonCompilerTest::CreateCompilerOptions(kRuntimeISA, "default");
+  std::unique_ptr<CodeGenerator> codegen = CodeGenerator::Create(graph, *compiler_options);
+  SsaLivenessAnalysis liveness(graph, codegen.get(), GetScopedAllocator());
+  liveness.Analyze();
+
+  // Without profiling data the false successor comes first. Here the branch falls
+  // through to the hot successor, and the rarely taken one comes after it.
+  ArrayRef<HBasicBlock* const> linear_order(graph->GetLinearOrder());
+  auto if_position =
+      std::find(linear_order.begin(), linear_order.end(), if_instruction->GetBlock());
+  ASSERT_TRUE(if_position != linear_order.end());
+  ASSERT_TRUE(if_position + 1 != linear_order.end());
+  EXPECT_EQ(*(if_position + 1), hot_successor);
+  EXPECT_LT(std::find(linear_order.begin(), linear_order.end(), hot_successor),
+            std::find(linear_order.begin(), linear_order.end(), cold_successor));
+}
+
 }  // namespace art
@@ -205,6 +205,10 @@ class HeapLocationCollector : public HGraphVisitor {
     return heap_locations_.size();
   }
 
+  size_t GetNumberOfReferenceInfos() const {
+    return ref_info_array_.size();
+  }
+
   HeapLocation* GetHeapLocation(size_t index) const {
     return heap_locations_[index];
   }
@@ -62,9 +62,6 @@
  *  - In phase 4, we commit the changes, replacing loads marked for elimination
  *    in previous processing and removing stores not marked for keeping. We also
  *    remove allocations that are no longer needed.
- *  - In phase 5, we move allocations which only escape along some executions
- *    closer to their escape points and fixup non-escaping paths with their actual
- *    values, creating PHIs when needed.
  *
  * 1. Walk over blocks and their instructions.
  *
@@ -108,6 +105,9 @@
  *    return/deoptimization.
  *  - Some instructions such as invokes are treated as loading and invalidating
  *    all the heap values, depending on the instruction's side effects.
+ *    Allocations that escape only along some executions keep their heap values
+ *    across such instructions until they reach the first escape, which lets
+ *    code sinking move the allocation to the escaping paths afterwards.
  *  - SIMD graphs (with VecLoad and VecStore instructions) are also handled. Any
  *    partial overlap access among ArrayGet/ArraySet/VecLoad/Store is seen as
  *    alias and no load/store is eliminated in such case.
@@ -687,6 +687,10 @@ class LSEVisitor final : private HGraphDelegateVisitor {
   Value MergePredecessorValues(HBasicBlock* block, size_t idx);
   void MergePredecessorRecords(HBasicBlock* block);
 
+  // Returns whether the reference of `ref_info` may have escaped when `instruction`
+  // executes, i.e. whether `instruction` is an escape or can be reached from one.
+  bool MayHaveEscapedAt(ReferenceInfo* ref_info, HInstruction* instruction);
+
   void MaterializeNonLoopPhis(PhiPlaceholder phi_placeholder, DataType::Type type);
 
   void VisitGetLocation(HInstruction* instruction, size_t idx);
@@ -1011,8 +1015,11 @@ class LSEVisitor final : private HGraphDelegateVisitor {
           KeepStores(heap_values[i].stored_by);
           heap_values[i].stored_by = Value::Unknown();
         }
-        if (side_effects.DoesAnyWrite()) {
-          // The value may be clobbered.
+        if (side_effects.DoesAnyWrite() &&
+            (can_throw_inside_a_try || MayHaveEscapedAt(ref_info, instruction))) {
+          // The value may be clobbered. An allocation that escapes only on some paths,
+          // for example to a logging call on a rare path, cannot be seen by the callee
+          // before it escapes, so we keep its value until then.
           heap_values[i].value = Value::Unknown();
         }
       }
@@ -1180,6 +1187,11 @@ class LSEVisitor final : private HGraphDelegateVisitor {
 
   ScopedArenaVector<HInstruction*> singleton_new_instances_;
 
+  // For each reference, the blocks that can be reached from an escape of the reference
+  // and the blocks with an escape. Computed on demand by `MayHaveEscapedAt()`.
+  ScopedArenaVector<ArenaBitVector*> escaped_blocks_;
+  ScopedArenaVector<ArenaBitVector*> blocks_with_escapes_;
+
   // The field infos for each heap location (if relevant).
   ScopedArenaVector<const FieldInfo*> field_infos_;
 
@@ -1293,6 +1305,12 @@ LSEVisitor::LSEVisitor(HGraph* graph,
       phi_placeholder_replacements_(
           num_phi_placeholders_, Value::Invalid(), allocator_.Adapter(kArenaAllocLSE)),
       singleton_new_instances_(allocator_.Adapter(kArenaAllocLSE)),
+      escaped_blocks_(heap_location_collector_.GetNumberOfReferenceInfos(),
+                      nullptr,
+                      allocator_.Adapter(kArenaAllocLSE)),
+      blocks_with_escapes_(heap_location_collector_.GetNumberOfReferenceInfos(),
+                           nullptr,
+                           allocator_.Adapter(kArenaAllocLSE)),
       field_infos_(heap_location_collector_.GetNumberOfHeapLocations(),
                    allocator_.Adapter(kArenaAllocLSE)),
       current_phase_(Phase::kLoadElimination) {}
@@ -1402,6 +1420,73 @@ LSEVisitor::Value LSEVisitor::MergePredecessorValues(HBasicBlock* block, size_t
   return merged_value;
 }
 
+bool LSEVisitor::MayHaveEscapedAt(ReferenceInfo* ref_info, HInstruction* instruction) {
+  HInstruction* reference = ref_info->GetReference();
+  // References not allocated in the method, and finalizable ones, escape from the start.
+  if ((!reference->IsNewInstance() && !reference->IsNewArray()) ||
+      (reference->IsNewInstance() && reference->AsNewInstance()->IsFinalizable())) {
+    return true;
+  }
+  size_t pos = ref_info->GetPosition();
+  if (escaped_blocks_[pos] == nullptr) {
+    size_t num_blocks = GetGraph()->GetBlocks().size();
+    ArenaBitVector* escaped_blocks =
+        ArenaBitVector::Create(&allocator_, num_blocks, /*expandable=*/ false, kArenaAllocLSE);
+    ArenaBitVector* blocks_with_escapes =
+        ArenaBitVector::Create(&allocator_, num_blocks, /*expandable=*/ false, kArenaAllocLSE);
+    ScopedArenaVector<HBasicBlock*> worklist(allocator_.Adapter(kArenaAllocLSE));
+    auto add_escaped_block = [&](HBasicBlock* block) {
+      if (!escaped_blocks->IsBitSet(block->GetBlockId())) {
+        escaped_blocks->SetBit(block->GetBlockId());
+        worklist.push_back(block);
+      }
+    };
+    LambdaEscapeVisitor visitor([&](HInstruction* escape) {
+      HBasicBlock* block = escape->GetBlock();
+      blocks_with_escapes->SetBit(block->GetBlockId());
+      if (escape->IsPhi()) {
+        // The merged reference is an alias from the start of the block.
+        add_escaped_block(block);
+      } else {
+        for (HBasicBlock* successor : block->GetSuccessors()) {
+          add_escaped_block(successor);
+        }
+      }
+      return true;
+    });
+    VisitEscapes(reference, visitor);
+    while (!worklist.empty()) {
+      HBasicBlock* block = worklist.back();
+      worklist.pop_back();
+      for (HBasicBlock* successor : block->GetSuccessors()) {
+        add_escaped_block(successor);
+      }
+    }
+    escaped_blocks_[pos] = escaped_blocks;
+    blocks_with_escapes_[pos] = blocks_with_escapes;
+  }
+
+  HBasicBlock* block = instruction->GetBlock();
+  if (escaped_blocks_[pos]->IsBitSet(block->GetBlockId())) {
+    return true;
+  }
+  if (!blocks_with_escapes_[pos]->IsBitSet(block->GetBlockId())) {
+    return false;
+  }
+  // Look for an escape before `instruction` in its block.
+  bool escaped = false;
+  LambdaEscapeVisitor visitor([&](HInstruction* escape) {
+    if (escape == instruction ||
+        (escape->GetBlock() == block && escape->StrictlyDominates(instruction))) {
+      escaped = true;
+      return false;
+    }
+    return true;
+  });
+  VisitEscapes(reference, visitor);
+  return escaped;
+}
+
 void LSEVisitor::MergePredecessorRecords(HBasicBlock* block) {
   if (block->IsExitBlock()) {
     // Exit block doesn't really merge values since the control flow ends in
@@ -2212,4 +2212,63 @@ TEST_F(LoadStoreEliminationTest, DISABLED_PartialLoadPreserved6) {
   EXPECT_INS_RETAINED(call_left);
   EXPECT_INS_RETAINED(call_entry);
 }
+
+// // ENTRY
+// obj = new Obj();
+// // DO NOT ELIMINATE. Kept by escape.
+// obj.field = 1;
+// noescape();
+// // ELIMINATE. obj has not escaped yet.
+// int value = obj.field;
+// if (parameter_value) {
+//   // LEFT
+//   escape(obj);
+//   noescape();
+//   // DO NOT ELIMINATE. obj has escaped.
+//   value += obj.field;
+// } else {
+//   // RIGHT
+// }
+// EXIT
+// return value;
+TEST_F(LoadStoreEliminationTest, PartialEscapeLoadBeforeEscape) {
+  ScopedObjectAccess soa(Thread::Current());
+  VariableSizedHandleScope vshs(soa.Self());
+  HBasicBlock* breturn = InitEntryMainExitGraph(&vshs);
+
+  HInstruction* bool_value = MakeParam(DataType::Type::kBool);
+  HInstruction* c1 = graph_->GetIntConstant(1);
+
+  auto [start, left, right] = CreateDiamondPattern(breturn, bool_value);
+
+  // start
+  HInstruction* cls = MakeLoadClass(start);
+  HInstruction* new_inst = MakeNewInstance(start, cls);
+  HInstruction* write_start = MakeIFieldSet(start, new_inst, c1, MemberOffset(32));
+  HInstruction* call_start = MakeInvokeStatic(start, DataType::Type::kVoid, {});
+  HInstruction* read_start =
+      MakeIFieldGet(start, new_inst, DataType::Type::kInt32, MemberOffset(32));
+
+  HInstruction* call_left = MakeInvokeStatic(left, DataType::Type::kVoid, { new_inst });
+  HInstruction* call2_left = MakeInvokeStatic(left, DataType::Type::kVoid, {});
+  HInstruction* read_left =
+      MakeIFieldGet(left, new_inst, DataType::Type::kInt32, MemberOffset(32));
+  HInstruction* add_left = MakeBinOp<HAdd>(left, DataType::Type::kInt32, read_start, read_left);
+
+  HPhi* phi = MakePhi(breturn, {add_left, read_start});
+  MakeReturn(breturn, phi);
+
+  PerformLSE();
+
+  EXPECT_INS_REMOVED(read_start);
+  EXPECT_INS_EQ(add_left->InputAt(0), c1);
+  EXPECT_INS_EQ(phi->InputAt(1), c1);
+  EXPECT_INS_RETAINED(read_left);
+  EXPECT_INS_RETAINED(write_start);
+  EXPECT_INS_RETAINED(call_start);
+  EXPECT_INS_RETAINED(call_left);
+  EXPECT_INS_RETAINED(call2_left);
+  EXPECT_INS_RETAINED(new_inst);
+}
+
 }  // namespace art
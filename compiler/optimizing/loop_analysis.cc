@@ -16,6 +16,8 @@
 
 #include "loop_analysis.h"
 
+#include <limits>
+
 #include "base/bit_vector-inl.h"
 #include "code_generator.h"
 #include "induction_var_range.h"
@@ -26,6 +28,7 @@ void LoopAnalysis::CalculateLoopBasicProperties(HLoopInformation* loop_info,
                                                 LoopAnalysisInfo* analysis_results,
                                                 int64_t trip_count) {
   analysis_results->trip_count_ = trip_count;
+  analysis_results->profiled_trip_count_ = GetLoopProfiledTripCount(loop_info);
 
   for (HBlocksInLoopIterator block_it(*loop_info);
        !block_it.Done();
@@ -73,6 +76,48 @@ int64_t LoopAnalysis::GetLoopTripCount(HLoopInformation* loop_info,
   return trip_count;
 }
 
+HIf* LoopAnalysis::GetSingleExitIf(HLoopInformation* loop_info) {
+  HIf* exit_if = nullptr;
+  for (HBlocksInLoopIterator block_it(*loop_info); !block_it.Done(); block_it.Advance()) {
+    HBasicBlock* block = block_it.Current();
+    for (HBasicBlock* successor : block->GetSuccessors()) {
+      if (!loop_info->Contains(*successor)) {
+        HIf* hif = block->GetLastInstruction()->AsIfOrNull();
+        if (hif == nullptr || exit_if != nullptr) {
+          return nullptr;
+        }
+        exit_if = hif;
+      }
+    }
+  }
+  return exit_if;
+}
+
+int64_t LoopAnalysis::GetLoopProfiledTripCount(HLoopInformation* loop_info) {
+  HIf* exit_if = GetSingleExitIf(loop_info);
+  if (exit_if == nullptr) {
+    return LoopAnalysisInfo::kUnknownTripCount;
+  }
+  bool exits_if_true = !loop_info->Contains(*exit_if->IfTrueSuccessor());
+  uint16_t exit_count = exits_if_true ? exit_if->GetTrueCount() : exit_if->GetFalseCount();
+  uint16_t stay_count = exits_if_true ? exit_if->GetFalseCount() : exit_if->GetTrueCount();
+  // The counters saturate, and are at their maximum when there is no profiling data. Once the
+  // stay count saturates, the average is a lower bound, which is good enough for heuristics.
+  if (exit_count < kMinimumProfiledLoopExits ||
+      exit_count == std::numeric_limits<uint16_t>::max()) {
+    return LoopAnalysisInfo::kUnknownTripCount;
+  }
+  return stay_count / exit_count;
+}
+
+void LoopAnalysis::ClearLoopProfiledTripCount(HLoopInformation* loop_info) {
+  HIf* exit_if = GetSingleExitIf(loop_info);
+  if (exit_if != nullptr) {
+    exit_if->SetTrueCount(std::numeric_limits<uint16_t>::max());
+    exit_if->SetFalseCount(std::numeric_limits<uint16_t>::max());
+  }
+}
+
 // Default implementation of loop helper; used for all targets unless a custom implementation
 // is provided. Enables scalar loop peeling and unrolling with the most conservative heuristics.
 class ArchDefaultLoopHelper : public ArchNoOptsLoopHelper {
@@ -88,6 +133,10 @@ class ArchDefaultLoopHelper : public ArchNoOptsLoopHelper {
   static constexpr uint32_t kScalarHeuristicMaxBodySizeBlocks = 6;
   // Maximum number of instructions to be created as a result of full unrolling.
   static constexpr uint32_t kScalarHeuristicFullyUnrolledMaxInstrThreshold = 35;
+  // Minimum profiled trip count for unrolling loops without a known trip count.
+  static constexpr int64_t kScalarHeuristicMinProfiledTripCountForUnrolling = 16;
+  // Maximum profiled trip count for peeling loops without a known trip count.
+  static constexpr int64_t kScalarHeuristicMaxProfiledTripCountForPeeling = 1;
 
   bool IsLoopNonBeneficialForScalarOpts(LoopAnalysisInfo* analysis_info) const override {
     return analysis_info->HasLongTypeInstructions() ||
@@ -98,9 +147,13 @@ class ArchDefaultLoopHelper : public ArchNoOptsLoopHelper {
 
   uint32_t GetScalarUnrollingFactor(const LoopAnalysisInfo* analysis_info) const override {
     int64_t trip_count = analysis_info->GetTripCount();
-    // Unroll only loops with known trip count.
     if (trip_count == LoopAnalysisInfo::kUnknownTripCount) {
-      return LoopAnalysisInfo::kNoUnrollingFactor;
+      // Without a known trip count, the copy of the loop body keeps its exit check, so only
+      // unroll the loops that the profile shows to run for long.
+      return (analysis_info->GetProfiledTripCount() >=
+                  kScalarHeuristicMinProfiledTripCountForUnrolling)
+          ? kScalarMaxUnrollFactor
+          : LoopAnalysisInfo::kNoUnrollingFactor;
     }
     uint32_t desired_unrolling_factor = kScalarMaxUnrollFactor;
     if (trip_count < desired_unrolling_factor || trip_count % desired_unrolling_factor != 0) {
@@ -112,6 +165,13 @@ class ArchDefaultLoopHelper : public ArchNoOptsLoopHelper {
 
   bool IsLoopPeelingEnabled() const override { return true; }
 
+  bool IsProfiledPeelingBeneficial(const LoopAnalysisInfo* analysis_info) const override {
+    int64_t profiled_trip_count = analysis_info->GetProfiledTripCount();
+    return analysis_info->GetTripCount() == LoopAnalysisInfo::kUnknownTripCount &&
+           profiled_trip_count != LoopAnalysisInfo::kUnknownTripCount &&
+           profiled_trip_count <= kScalarHeuristicMaxProfiledTripCountForPeeling;
+  }
+
   bool IsFullUnrollingBeneficial(LoopAnalysisInfo* analysis_info) const override {
     int64_t trip_count = analysis_info->GetTripCount();
     // We assume that trip count is known.
@@ -36,6 +36,7 @@ class LoopAnalysisInfo : public ValueObject {
 
   explicit LoopAnalysisInfo(HLoopInformation* loop_info)
       : trip_count_(kUnknownTripCount),
+        profiled_trip_count_(kUnknownTripCount),
         bb_num_(0),
         instr_num_(0),
         exits_num_(0),
@@ -46,6 +47,7 @@ class LoopAnalysisInfo : public ValueObject {
         loop_info_(loop_info) {}
 
   int64_t GetTripCount() const { return trip_count_; }
+  int64_t GetProfiledTripCount() const { return profiled_trip_count_; }
   size_t GetNumberOfBasicBlocks() const { return bb_num_; }
   size_t GetNumberOfInstructions() const { return instr_num_; }
   size_t GetNumberOfExits() const { return exits_num_; }
@@ -72,6 +74,9 @@ class LoopAnalysisInfo : public ValueObject {
  private:
   // Trip count of the loop if known, kUnknownTripCount otherwise.
   int64_t trip_count_;
+  // Average trip count observed by the JIT's branch profiling if available, kUnknownTripCount
+  // otherwise. Only a hint: the compiled code must stay correct for any trip count.
+  int64_t profiled_trip_count_;
   // Number of basic blocks in the loop body.
   size_t bb_num_;
   // Number of instructions in the loop body.
@@ -108,7 +113,23 @@ class LoopAnalysis : public ValueObject {
   static int64_t GetLoopTripCount(HLoopInformation* loop_info,
                                   const InductionVarRange* induction_range);
 
+  // Returns the average trip count of the loop taken from the profiled counts of its exit
+  // branch, that is the number of times the branch stayed in the loop per time it exited.
+  // Returns kUnknownTripCount if the loop does not have a single exit through an HIf or if
+  // there is not enough profiling data.
+  static int64_t GetLoopProfiledTripCount(HLoopInformation* loop_info);
+
+  // Drops the profiled counts of the exit branch of the loop, for transformations after which
+  // they no longer describe the loop.
+  static void ClearLoopProfiledTripCount(HLoopInformation* loop_info);
+
  private:
+  // Minimum number of loop exits seen by the branch profiling for its counts to be used.
+  static constexpr uint16_t kMinimumProfiledLoopExits = 8;
+
+  // Returns the HIf through which the loop exits if it is the only exit, nullptr otherwise.
+  static HIf* GetSingleExitIf(HLoopInformation* loop_info);
+
   // Returns whether an instruction makes scalar loop peeling/unrolling non-beneficial.
   //
   // If in the loop body we have a dex/runtime call then its contribution to the whole
@@ -165,6 +186,15 @@ class ArchNoOptsLoopHelper : public ArenaObject<kArenaAllocOptimization> {
   // Returns 'false' by default, should be overridden by particular target loop helper.
   virtual bool IsLoopPeelingEnabled() const { return false; }
 
+  // Returns whether peeling the first iteration of a loop is beneficial given its profiled
+  // trip count, that is when most executions of the loop exit without taking the back edge.
+  //
+  // Returns 'false' by default, should be overridden by particular target loop helper.
+  virtual bool IsProfiledPeelingBeneficial(
+      [[maybe_unused]] const LoopAnalysisInfo* analysis_info) const {
+    return false;
+  }
+
   // Returns whether it is beneficial to fully unroll the loop.
   //
   // Returns 'false' by default, should be overridden by particular target loop helper.
@@ -339,8 +339,10 @@ static bool IsSubConst2(HGraph* graph,
 // Detect reductions of the following forms,
 //   x = x_phi + ..
 //   x = x_phi - ..
+//   x = min(x_phi, ..)
+//   x = max(x_phi, ..)
 static bool HasReductionFormat(HInstruction* reduction, HInstruction* phi) {
-  if (reduction->IsAdd()) {
+  if (reduction->IsAdd() || reduction->IsMin() || reduction->IsMax()) {
     return (reduction->InputAt(0) == phi && reduction->InputAt(1) != phi) ||
            (reduction->InputAt(0) != phi && reduction->InputAt(1) == phi);
   } else if (reduction->IsSub()) {
@@ -356,6 +358,10 @@ static HVecReduce::ReductionKind GetReductionKind(HVecOperation* reduction) {
       reduction->IsVecSADAccumulate() ||
       reduction->IsVecDotProd()) {
     return HVecReduce::kSum;
+  } else if (reduction->IsVecMin()) {
+    return HVecReduce::kMin;
+  } else if (reduction->IsVecMax()) {
+    return HVecReduce::kMax;
   }
   LOG(FATAL) << "Unsupported SIMD reduction " << reduction->GetId();
   UNREACHABLE();
@@ -1014,11 +1020,15 @@ bool HLoopOptimization::TryUnrollingForBranchPenaltyReduction(LoopAnalysisInfo*
     LoopClonerSimpleHelper helper(loop_info, &induction_range_);
     helper.DoUnrolling();
 
-    // Remove the redundant loop check after unrolling.
-    HIf* copy_hif =
-        helper.GetBasicBlockMap()->Get(loop_info->GetHeader())->GetLastInstruction()->AsIf();
-    int32_t constant = loop_info->Contains(*copy_hif->IfTrueSuccessor()) ? 1 : 0;
-    copy_hif->ReplaceInput(graph_->GetIntConstant(constant), 0u);
+    if (analysis_info->GetTripCount() != LoopAnalysisInfo::kUnknownTripCount) {
+      // Remove the redundant loop check after unrolling.
+      HIf* copy_hif =
+          helper.GetBasicBlockMap()->Get(loop_info->GetHeader())->GetLastInstruction()->AsIf();
+      int32_t constant = loop_info->Contains(*copy_hif->IfTrueSuccessor()) ? 1 : 0;
+      copy_hif->ReplaceInput(graph_->GetIntConstant(constant), 0u);
+    }
+    // Otherwise we unrolled because of the profiled trip count, and the copy keeps its exit
+    // check: the loop is correct for any trip count.
   }
   return true;
 }
@@ -1052,6 +1062,24 @@ bool HLoopOptimization::TryPeelingForLoopInvariantExitsElimination(LoopAnalysisI
   return true;
 }
 
+bool HLoopOptimization::TryPeelingForProfiledTripCount(LoopAnalysisInfo* analysis_info,
+                                                       bool generate_code) {
+  HLoopInformation* loop_info = analysis_info->GetLoopInfo();
+  if (!arch_loop_helper_->IsLoopPeelingEnabled() ||
+      !arch_loop_helper_->IsProfiledPeelingBeneficial(analysis_info)) {
+    return false;
+  }
+
+  if (generate_code) {
+    LoopClonerSimpleHelper helper(loop_info, &induction_range_);
+    helper.DoPeeling();
+    // The remaining loop only runs in the uncommon case, don't peel it again.
+    LoopAnalysis::ClearLoopProfiledTripCount(loop_info);
+  }
+
+  return true;
+}
+
 bool HLoopOptimization::TryFullUnrolling(LoopAnalysisInfo* analysis_info, bool generate_code) {
   // Fully unroll loops with a known and small trip count.
   int64_t trip_count = analysis_info->GetTripCount();
@@ -1104,30 +1132,35 @@ bool HLoopOptimization::TryLoopScalarOpts(LoopNode* node) {
 
   LoopAnalysisInfo analysis_info(loop_info);
   LoopAnalysis::CalculateLoopBasicProperties(loop_info, &analysis_info, trip_count);
-  if (analysis_info.HasInstructionsPreventingScalarOpts() ||
-      arch_loop_helper_->IsLoopNonBeneficialForScalarOpts(&analysis_info)) {
-    return false;
-  }
-
-  if (!TryFullUnrolling(&analysis_info, /*generate_code*/ false) &&
-      !TryPeelingForLoopInvariantExitsElimination(&analysis_info, /*generate_code*/ false) &&
-      !TryUnrollingForBranchPenaltyReduction(&analysis_info, /*generate_code*/ false) &&
-      !TryToRemoveSuspendCheckFromLoopHeader(&analysis_info, /*generate_code*/ false)) {
+  if (analysis_info.HasInstructionsPreventingScalarOpts()) {
     return false;
   }
 
   // Try the suspend check removal even for non-clonable loops. Also this
   // optimization doesn't interfere with other scalar loop optimizations so it can
-  // be done prior to them.
+  // be done prior to them. It is bounded by the total number of executed instructions
+  // alone, so it doesn't depend on the target's scalar optimization heuristics either.
   bool removed_suspend_check = TryToRemoveSuspendCheckFromLoopHeader(&analysis_info);
 
+  if (arch_loop_helper_->IsLoopNonBeneficialForScalarOpts(&analysis_info)) {
+    return removed_suspend_check;
+  }
+
+  if (!TryFullUnrolling(&analysis_info, /*generate_code*/ false) &&
+      !TryPeelingForLoopInvariantExitsElimination(&analysis_info, /*generate_code*/ false) &&
+      !TryPeelingForProfiledTripCount(&analysis_info, /*generate_code*/ false) &&
+      !TryUnrollingForBranchPenaltyReduction(&analysis_info, /*generate_code*/ false)) {
+    return removed_suspend_check;
+  }
+
   // Run 'IsLoopClonable' the last as it might be time-consuming.
   if (!LoopClonerHelper::IsLoopClonable(loop_info)) {
-    return false;
+    return removed_suspend_check;
   }
 
   return TryFullUnrolling(&analysis_info) ||
          TryPeelingForLoopInvariantExitsElimination(&analysis_info) ||
+         TryPeelingForProfiledTripCount(&analysis_info) ||
          TryUnrollingForBranchPenaltyReduction(&analysis_info) || removed_suspend_check;
 }
 
@@ -2013,6 +2046,43 @@ bool HLoopOptimization::VectorizeUse(LoopNode* node,
       }
       return true;
     }
+  } else if (instruction->IsMin() || instruction->IsMax()) {
+    // Deal with vector restrictions.
+    HInstruction* opa = instruction->InputAt(0);
+    HInstruction* opb = instruction->InputAt(1);
+    HInstruction* r = opa;
+    HInstruction* s = opb;
+    bool is_unsigned = false;
+    bool is_reduction = reductions_->find(opa) != reductions_->end() ||
+                        reductions_->find(opb) != reductions_->end();
+    if (HasVectorRestrictions(restrictions, kNoMinMax) ||
+        (is_reduction && HasVectorRestrictions(restrictions, kNoMinMaxReduction))) {
+      return false;
+    } else if (HasVectorRestrictions(restrictions, kNoHiBits) &&
+               !IsNarrowerOperands(opa, opb, type, &r, &s, &is_unsigned)) {
+      return false;  // reject, unless all operands are same-extension narrower
+    }
+    // Accept MIN/MAX(x, y) for vectorizable operands.
+    DCHECK(r != nullptr && s != nullptr);
+    if (generate_code && synthesis_mode_ != LoopSynthesisMode::kVector) {  // de-idiom
+      r = opa;
+      s = opb;
+    }
+    if (VectorizeUse(node, r, generate_code, type, restrictions) &&
+        VectorizeUse(node, s, generate_code, type, restrictions)) {
+      if (generate_code) {
+        // Keep the reduction phi as the first operand: in predicated mode, the inactive
+        // lanes of the result are taken from the first operand.
+        if (reductions_->find(s) != reductions_->end()) {
+          std::swap(r, s);
+        }
+        GenerateVecOp(instruction,
+                      vector_map_->Get(r),
+                      vector_map_->Get(s),
+                      HVecOperation::ToProperType(type, is_unsigned));
+      }
+      return true;
+    }
   }
   return false;
 }
@@ -2113,7 +2183,7 @@ bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrict
             *restrictions |= kNoDiv;
             return TrySetVectorLength(type, 4);
           case DataType::Type::kInt64:
-            *restrictions |= kNoDiv | kNoMul;
+            *restrictions |= kNoDiv | kNoMul | kNoMinMax;
             return TrySetVectorLength(type, 2);
           case DataType::Type::kFloat32:
             *restrictions |= kNoReduction;
@@ -2160,16 +2230,16 @@ bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrict
                              kNoSAD;
             return TrySetVectorLength(type, 8);
           case DataType::Type::kInt32:
-            *restrictions |= kNoDiv | kNoSAD;
+            *restrictions |= kNoDiv | kNoSAD | kNoMinMaxReduction;
             return TrySetVectorLength(type, 4);
           case DataType::Type::kInt64:
-            *restrictions |= kNoMul | kNoDiv | kNoShr | kNoAbs | kNoSAD;
+            *restrictions |= kNoMul | kNoDiv | kNoShr | kNoAbs | kNoSAD | kNoMinMax;
             return TrySetVectorLength(type, 2);
           case DataType::Type::kFloat32:
-            *restrictions |= kNoReduction;
+            *restrictions |= kNoReduction | kNoMinMax;  // min/max(x, NaN)
             return TrySetVectorLength(type, 4);
           case DataType::Type::kFloat64:
-            *restrictions |= kNoReduction;
+            *restrictions |= kNoReduction | kNoMinMax;  // min/max(x, NaN)
             return TrySetVectorLength(type, 2);
           default:
             break;
@@ -2469,6 +2539,14 @@ HInstruction* HLoopOptimization::GenerateVecOp(HInstruction* org,
       GENERATE_VEC(
         new (global_allocator_) HVecAbs(global_allocator_, opa, type, vector_length_, dex_pc),
         new (global_allocator_) HAbs(org_type, opa, dex_pc));
+    case HInstruction::kMin:
+      GENERATE_VEC(
+        new (global_allocator_) HVecMin(global_allocator_, opa, opb, type, vector_length_, dex_pc),
+        new (global_allocator_) HMin(org_type, opa, opb, dex_pc));
+    case HInstruction::kMax:
+      GENERATE_VEC(
+        new (global_allocator_) HVecMax(global_allocator_, opa, opb, type, vector_length_, dex_pc),
+        new (global_allocator_) HMax(org_type, opa, opb, dex_pc));
     case HInstruction::kEqual: {
         // Special case.
         DCHECK_EQ(synthesis_mode_, LoopSynthesisMode::kVector);
@@ -102,6 +102,8 @@ class HLoopOptimization : public HOptimization {
     kNoWideSAD       = 1 << 12,  // no sum of absolute differences (SAD) with operand widening
     kNoDotProd       = 1 << 13,  // no dot product
     kNoIfCond        = 1 << 14,  // no if condition conversion
+    kNoMinMax        = 1 << 15,  // no min/max
+    kNoMinMaxReduction = 1 << 16,  // no min/max reduction
   };
 
   /*
@@ -270,6 +272,11 @@ class HLoopOptimization : public HOptimization {
   bool TryPeelingForLoopInvariantExitsElimination(LoopAnalysisInfo* analysis_info,
                                                   bool generate_code = true);
 
+  // Tries to peel the first iteration of a loop which the profile shows to rarely take its back
+  // edge, so that the common case runs straight-line code. Returns whether transformation
+  // happened. 'generate_code' determines whether the optimization should be actually applied.
+  bool TryPeelingForProfiledTripCount(LoopAnalysisInfo* analysis_info, bool generate_code = true);
+
   // Tries to perform whole loop unrolling for a small loop with a small trip count to eliminate
   // the loop check overhead and to have more opportunities for inter-iteration optimizations.
   // Returns whether transformation happened. 'generate_code' determines whether the optimization
@@ -17,6 +17,7 @@
 #include "base/macros.h"
 #include "code_generator.h"
 #include "driver/compiler_options.h"
+#include "loop_analysis.h"
 #include "loop_optimization.h"
 #include "optimizing_unit_test.h"
 
@@ -326,4 +327,31 @@ TEST_F(LoopOptimizationTest, SimplifyLoopSinglePreheader) {
   EXPECT_EQ(header_phi->InputAt(1), body_add);
 }
 
+// Checks that the trip count of a loop is derived from the profiled counts of its exit branch.
+TEST_F(LoopOptimizationTest, ProfiledTripCount) {
+  HBasicBlock* header = AddLoop(entry_block_, return_block_);
+  graph_->BuildDominatorTree();
+  HLoopInformation* loop_info = header->GetLoopInformation();
+  HIf* hif = header->GetLastInstruction()->AsIf();
+  ASSERT_TRUE(loop_info->Contains(*hif->IfTrueSuccessor()));
+
+  // No profiling data.
+  EXPECT_EQ(LoopAnalysis::GetLoopProfiledTripCount(loop_info),
+            LoopAnalysisInfo::kUnknownTripCount);
+
+  hif->SetTrueCount(1000);
+  hif->SetFalseCount(10);
+  EXPECT_EQ(LoopAnalysis::GetLoopProfiledTripCount(loop_info), 100);
+
+  // Too few exits to trust the counts.
+  hif->SetFalseCount(2);
+  EXPECT_EQ(LoopAnalysis::GetLoopProfiledTripCount(loop_info),
+            LoopAnalysisInfo::kUnknownTripCount);
+
+  hif->SetFalseCount(10);
+  LoopAnalysis::ClearLoopProfiledTripCount(loop_info);
+  EXPECT_EQ(LoopAnalysis::GetLoopProfiledTripCount(loop_info),
+            LoopAnalysisInfo::kUnknownTripCount);
+}
+
 }  // namespace art
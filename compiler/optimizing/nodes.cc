@@ -39,6 +39,7 @@
 #include "intrinsic_objects.h"
 #include "intrinsics.h"
 #include "intrinsics_list.h"
+#include "jit/profiling_info.h"
 #include "mirror/class-inl.h"
 #include "scoped_thread_state_change-inl.h"
 #include "ssa_builder.h"
@@ -63,6 +64,10 @@ void HGraph::AddBlock(HBasicBlock* block) {
   blocks_.push_back(block);
 }
 
+bool HGraph::ShouldSpeculate(DeoptimizationKind kind) const {
+  return profiling_info_ == nullptr || profiling_info_->ShouldSpeculate(kind);
+}
+
 void HGraph::FindBackEdges(ArenaBitVector* visited) {
   // "visited" must be empty on entry, it's an output argument for all visited (i.e. live) blocks.
   DCHECK_EQ(visited->GetHighestBitSet(), -1);
@@ -78,6 +78,7 @@ class HTryBoundary;
 class FieldInfo;
 class LiveInterval;
 class LocationSummary;
+class MethodCompileProfile;
 class ProfilingInfo;
 class SlowPathCode;
 class SsaBuilder;
@@ -427,6 +428,7 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
         cached_double_constants_(std::less<int64_t>(), allocator->Adapter(kArenaAllocConstantsMap)),
         cached_current_method_(nullptr),
         art_method_(nullptr),
+        compile_profile_(nullptr),
         compilation_kind_(compilation_kind),
         useful_optimizing_(false),
         cha_single_implementation_list_(allocator->Adapter(kArenaAllocCHA)) {
@@ -733,6 +735,13 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
   void SetProfilingInfo(ProfilingInfo* info) { profiling_info_ = info; }
   ProfilingInfo* GetProfilingInfo() const { return profiling_info_; }
 
+  void SetCompileProfile(MethodCompileProfile* profile) { compile_profile_ = profile; }
+  MethodCompileProfile* GetCompileProfile() const { return compile_profile_; }
+
+  // Whether the code we generate may deoptimize for `kind`. Returns false once the JIT saw the
+  // compiled code of this method deoptimize too often for `kind`.
+  bool ShouldSpeculate(DeoptimizationKind kind) const;
+
   HCondition* CreateCondition(IfCondition cond,
                               HInstruction* lhs,
                               HInstruction* rhs,
@@ -898,6 +907,9 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
   // The `ProfilingInfo` associated with the method being compiled.
   ProfilingInfo* profiling_info_;
 
+  // The profile of this compilation written with --dump-compile-profile, or null.
+  MethodCompileProfile* compile_profile_;
+
   // How we are compiling the graph: either optimized, osr, or baseline.
   // For osr, we will make all loops seen as irreducible and emit special
   // stack maps to mark compiled code entries which the interpreter can
@@ -2101,6 +2113,11 @@ class HEnvironment : public ArenaObject<kArenaAllocEnvironment> {
     locations_.resize(vregs_.size());
   }
 
+  // Drop the locations so that the liveness analysis can run again.
+  void ClearLocations() {
+    locations_.clear();
+  }
+
   void SetAndCopyParentChain(ArenaAllocator* allocator, HEnvironment* parent) {
     if (parent_ != nullptr) {
       parent_->SetAndCopyParentChain(allocator, parent);
@@ -18,6 +18,7 @@
 
 #include <fstream>
 #include <memory>
+#include <optional>
 #include <sstream>
 
 #include <stdint.h>
@@ -34,6 +35,7 @@
 #include "base/timing_logger.h"
 #include "builder.h"
 #include "code_generator.h"
+#include "compile_profile.h"
 #include "compiler.h"
 #include "debug/elf_debug_writer.h"
 #include "debug/method_debug_info.h"
@@ -56,6 +58,7 @@
 #include "prepare_for_register_allocation.h"
 #include "profiling_info_builder.h"
 #include "reference_type_propagation.h"
+#include "register_allocator_graph_color.h"
 #include "register_allocator_linear_scan.h"
 #include "select_generator.h"
 #include "ssa_builder.h"
@@ -83,6 +86,7 @@ class PassObserver : public ValueObject {
   PassObserver(HGraph* graph,
                CodeGenerator* codegen,
                std::ostream* visualizer_output,
+               CompileProfileWriter* compile_profile_writer,
                const CompilerOptions& compiler_options)
       : graph_(graph),
         last_seen_graph_size_(0),
@@ -95,7 +99,13 @@ class PassObserver : public ValueObject {
         visualizer_enabled_(!compiler_options.GetDumpCfgFileName().empty()),
         visualizer_(&visualizer_oss_, graph, codegen),
         codegen_(codegen),
+        compile_profile_writer_(compile_profile_writer),
+        compile_profile_(),
         graph_in_bad_state_(false) {
+    if (compile_profile_writer_ != nullptr) {
+      compile_profile_.emplace(graph);
+      graph->SetCompileProfile(&compile_profile_.value());
+    }
     if (timing_logger_enabled_ || visualizer_enabled_) {
       if (!IsVerboseMethod(compiler_options, GetMethodName())) {
         timing_logger_enabled_ = visualizer_enabled_ = false;
@@ -116,6 +126,10 @@ class PassObserver : public ValueObject {
       FlushVisualizer();
     }
     DCHECK(visualizer_oss_.str().empty());
+    if (compile_profile_.has_value()) {
+      compile_profile_writer_->Write(compile_profile_.value(), GetMethodName());
+      graph_->SetCompileProfile(nullptr);
+    }
   }
 
   void DumpDisassembly() {
@@ -146,6 +160,9 @@ class PassObserver : public ValueObject {
     if (timing_logger_enabled_) {
       timing_logger_.StartTiming(pass_name);
     }
+    if (compile_profile_.has_value()) {
+      compile_profile_->StartPass(pass_name);
+    }
   }
 
   void FlushVisualizer() {
@@ -160,6 +177,9 @@ class PassObserver : public ValueObject {
     if (timing_logger_enabled_) {
       timing_logger_.EndTiming();
     }
+    if (compile_profile_.has_value()) {
+      compile_profile_->EndPass();
+    }
     if (visualizer_enabled_) {
       visualizer_.DumpGraph(pass_name, /* is_after_pass= */ true, graph_in_bad_state_);
       FlushVisualizer();
@@ -214,6 +234,10 @@ class PassObserver : public ValueObject {
   HGraphVisualizer visualizer_;
   CodeGenerator* codegen_;
 
+  // Profile of the passes and inlining decisions, set when --dump-compile-profile is used.
+  CompileProfileWriter* const compile_profile_writer_;
+  std::optional<MethodCompileProfile> compile_profile_;
+
   // Flag to be set by the compiler if the pass failed and the graph is not
   // expected to validate.
   bool graph_in_bad_state_;
@@ -383,6 +407,8 @@ class OptimizingCompiler final : public Compiler {
 
   std::unique_ptr<std::ostream> visualizer_output_;
 
+  std::unique_ptr<CompileProfileWriter> compile_profile_writer_;
+
   DISALLOW_COPY_AND_ASSIGN(OptimizingCompiler);
 };
 
@@ -399,6 +425,10 @@ OptimizingCompiler::OptimizingCompiler(const CompilerOptions& compiler_options,
     visualizer_output_.reset(new std::ofstream(cfg_file_name, cfg_file_mode));
     DumpInstructionSetFeaturesToCfg();
   }
+  const std::string& compile_profile_file_name = compiler_options.GetDumpCompileProfileFileName();
+  if (!compile_profile_file_name.empty()) {
+    compile_profile_writer_.reset(new CompileProfileWriter(compile_profile_file_name));
+  }
   if (compiler_options.GetDumpStats()) {
     compilation_stats_.reset(new OptimizingCompilerStats());
   }
@@ -539,7 +569,8 @@ bool OptimizingCompiler::RunArchOptimizations(HGraph* graph,
           OptDef(OptimizationPass::kInstructionSimplifierRiscv64),
           OptDef(OptimizationPass::kSideEffectsAnalysis),
           OptDef(OptimizationPass::kGlobalValueNumbering, "GVN$after_arch"),
-          OptDef(OptimizationPass::kCriticalNativeAbiFixupRiscv64)
+          OptDef(OptimizationPass::kCriticalNativeAbiFixupRiscv64),
+          OptDef(OptimizationPass::kScheduling)
       };
       return RunOptimizations(graph,
                               codegen,
@@ -587,6 +618,35 @@ bool OptimizingCompiler::RunArchOptimizations(HGraph* graph,
   }
 }
 
+// Above this number of SSA values, the interference graph gets too expensive to build and
+// color, and we fall back to linear scan.
+static constexpr size_t kMaximumNumberOfSsaValuesForGraphColoring = 2000;
+
+// Graph coloring takes more compile time than linear scan, so only use it when compiling AOT
+// for speed, for the methods which are hot according to the profile or which have loops.
+static RegisterAllocator::Strategy GetRegisterAllocationStrategy(
+    HGraph* graph, const CompilerOptions& compiler_options, const SsaLivenessAnalysis& liveness) {
+  if (!compiler_options.UseGraphColoringRegisterAllocator() ||
+      !compiler_options.IsAotCompiler() ||
+      compiler_options.IsBaseline() ||
+      liveness.GetNumberOfSsaValues() > kMaximumNumberOfSsaValuesForGraphColoring) {
+    return RegisterAllocator::Strategy::kLinearScan;
+  }
+  CompilerFilter::Filter filter = compiler_options.GetCompilerFilter();
+  if (filter != CompilerFilter::kSpeedProfile && filter != CompilerFilter::kSpeed) {
+    return RegisterAllocator::Strategy::kLinearScan;
+  }
+  const ProfileCompilationInfo* pci = compiler_options.GetProfileCompilationInfo();
+  if (pci != nullptr &&
+      pci->GetMethodHotness(MethodReference(&graph->GetDexFile(), graph->GetMethodIdx())).IsHot()) {
+    return RegisterAllocator::Strategy::kGraphColor;
+  }
+  // Without a profile, only spend the extra time on loops.
+  return (filter == CompilerFilter::kSpeed && graph->HasLoops())
+      ? RegisterAllocator::Strategy::kGraphColor
+      : RegisterAllocator::Strategy::kLinearScan;
+}
+
 NO_INLINE  // Avoid increasing caller's frame size by large stack-allocated objects.
 static void AllocateRegisters(HGraph* graph,
                               CodeGenerator* codegen,
@@ -607,8 +667,34 @@ static void AllocateRegisters(HGraph* graph,
   }
   {
     PassScope scope(RegisterAllocator::kRegisterAllocatorPassName, pass_observer);
+    RegisterAllocator::Strategy strategy =
+        GetRegisterAllocationStrategy(graph, codegen->GetCompilerOptions(), liveness);
+    if (strategy == RegisterAllocator::Strategy::kGraphColor) {
+      RegisterAllocatorGraphColor graph_color(&local_allocator, codegen, liveness);
+      if (graph_color.TryAllocateRegisters()) {
+        return;
+      }
+      // Coloring did not converge. Nothing was resolved yet, so analyze liveness again
+      // from scratch and use linear scan.
+      VLOG(compiler) << "Graph coloring did not converge for "
+                     << graph->PrettyMethod() << ", using linear scan";
+      for (HBasicBlock* block : graph->GetReversePostOrder()) {
+        for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+          for (HEnvironment* env = it.Current()->GetEnvironment();
+               env != nullptr;
+               env = env->GetParent()) {
+            env->ClearLocations();
+          }
+        }
+      }
+      SsaLivenessAnalysis fallback_liveness(graph, codegen, &local_allocator);
+      fallback_liveness.Analyze();
+      RegisterAllocatorLinearScan(&local_allocator, codegen, fallback_liveness)
+          .AllocateRegisters();
+      return;
+    }
     std::unique_ptr<RegisterAllocator> register_allocator =
-        RegisterAllocator::Create(&local_allocator, codegen, liveness);
+        RegisterAllocator::Create(&local_allocator, codegen, liveness, strategy);
     register_allocator->AllocateRegisters();
   }
 }
@@ -855,6 +941,7 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* allocator,
   PassObserver pass_observer(graph,
                              codegen.get(),
                              visualizer_output_.get(),
+                             compile_profile_writer_.get(),
                              compiler_options);
 
   {
@@ -1012,6 +1099,7 @@ CodeGenerator* OptimizingCompiler::TryCompileIntrinsic(
   PassObserver pass_observer(graph,
                              codegen.get(),
                              visualizer_output_.get(),
+                             compile_profile_writer_.get(),
                              compiler_options);
 
   {
@@ -1320,6 +1408,7 @@ bool OptimizingCompiler::JitCompile(Thread* self,
                              stack_map.size(),
                              /* number_of_roots= */ 0,
                              method,
+                             compilation_kind,
                              /*out*/ &reserved_code,
                              /*out*/ &reserved_data)) {
       MaybeRecordStat(compilation_stats_.get(), MethodCompilationStat::kJitOutOfMemoryForCommit);
@@ -1367,7 +1456,8 @@ bool OptimizingCompiler::JitCompile(Thread* self,
       return false;
     }
 
-    Runtime::Current()->GetJit()->AddMemoryUsage(method, allocator.BytesUsed());
+    Runtime::Current()->GetJit()->AddMemoryUsage(
+        method, allocator.BytesUsed() + arena_stack.ApproximatePeakBytes());
     if (jit_logger != nullptr) {
       jit_logger->WriteLog(code, jni_compiled_method.GetCode().size(), method);
     }
@@ -1416,6 +1506,7 @@ bool OptimizingCompiler::JitCompile(Thread* self,
                            stack_map.size(),
                            /*number_of_roots=*/codegen->GetNumberOfJitRoots(),
                            method,
+                           compilation_kind,
                            /*out*/ &reserved_code,
                            /*out*/ &reserved_data)) {
     MaybeRecordStat(compilation_stats_.get(), MethodCompilationStat::kJitOutOfMemoryForCommit);
@@ -1481,7 +1572,8 @@ bool OptimizingCompiler::JitCompile(Thread* self,
     return false;
   }
 
-  Runtime::Current()->GetJit()->AddMemoryUsage(method, allocator.BytesUsed());
+  Runtime::Current()->GetJit()->AddMemoryUsage(
+      method, allocator.BytesUsed() + arena_stack.ApproximatePeakBytes());
   if (jit_logger != nullptr) {
     jit_logger->WriteLog(code, codegen->GetAssembler()->CodeSize(), method);
   }
@@ -1489,14 +1581,17 @@ bool OptimizingCompiler::JitCompile(Thread* self,
   if (kArenaAllocatorCountAllocations) {
     codegen.reset();  // Release codegen's ScopedArenaAllocator for memory accounting.
     size_t total_allocated = allocator.BytesAllocated() + arena_stack.PeakBytesAllocated();
+    MemStats mem_stats(allocator.GetMemStats());
+    MemStats peak_stats(arena_stack.GetPeakStats());
+    std::ostringstream arena_stats;
+    arena_stats << Dumpable<MemStats>(mem_stats) << "\n" << Dumpable<MemStats>(peak_stats);
     if (total_allocated > kArenaAllocatorMemoryReportThreshold) {
-      MemStats mem_stats(allocator.GetMemStats());
-      MemStats peak_stats(arena_stack.GetPeakStats());
       LOG(INFO) << "Used " << total_allocated << " bytes of arena memory for compiling "
                 << dex_file->PrettyMethod(method_idx)
-                << "\n" << Dumpable<MemStats>(mem_stats)
-                << "\n" << Dumpable<MemStats>(peak_stats);
+                << "\n" << arena_stats.str();
     }
+    Runtime::Current()->GetJit()->AddArenaAllocationStats(
+        method, total_allocated, arena_stats.str());
   }
 
   return true;
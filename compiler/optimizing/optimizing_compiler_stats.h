@@ -71,12 +71,14 @@ enum class MethodCompilationStat {
   kNotCompiledFrameTooBig,
   kInlinedMonomorphicCall,
   kInlinedPolymorphicCall,
+  kInlinedMegamorphicCall,
   kMonomorphicCall,
   kPolymorphicCall,
   kMegamorphicCall,
   kBooleanSimplified,
   kIntrinsicRecognized,
   kLoopInvariantMoved,
+  kLoopInvariantLoadMoved,
   kLoopVectorized,
   kLoopVectorizedIdiom,
   kSelectGenerated,
@@ -120,6 +122,8 @@ enum class MethodCompilationStat {
   kNotInlinedCustom,
   kNotVarAnalyzedPathological,
   kTryInline,
+  kRankedInlineCallSite,
+  kColdInlineCallSite,
   kConstructorFenceGeneratedNew,
   kConstructorFenceGeneratedFinal,
   kConstructorFenceRemovedLSE,
@@ -101,31 +101,34 @@ void ProfilingInfoBuilder::VisitInvokeVirtual(HInvokeVirtual* invoke) {
 
 bool ProfilingInfoBuilder::IsInlineCacheUseful(HInvoke* invoke, CodeGenerator* codegen) {
   DCHECK(invoke->IsInvokeVirtual() || invoke->IsInvokeInterface());
-  if (codegen->IsImplementedIntrinsic(invoke)) {
-    return false;
-  }
   if (!invoke->GetBlock()->GetGraph()->IsCompilingBaseline()) {
     return false;
   }
   if (Runtime::Current()->IsAotCompiler()) {
     return false;
   }
-  if (invoke->InputAt(0)->GetReferenceTypeInfo().IsExact()) {
-    return false;
-  }
-  if (invoke->GetResolvedMethod() != nullptr) {
-    ScopedObjectAccess soa(Thread::Current());
-    if (invoke->GetResolvedMethod()->IsFinal() ||
-        invoke->GetResolvedMethod()->GetDeclaringClass()->IsFinal()) {
-      return false;
-    }
-  }
-
   if (!codegen->GetGraph()->IsUsefulOptimizing()) {
     // Earlier pass knew what the calling target was. No need for an inline
     // cache.
     return false;
   }
+  ScopedObjectAccess soa(Thread::Current());
+  return CanHaveInlineCache(invoke, codegen);
+}
+
+bool ProfilingInfoBuilder::CanHaveInlineCache(HInvoke* invoke, CodeGenerator* codegen) {
+  DCHECK(invoke->IsInvokeVirtual() || invoke->IsInvokeInterface());
+  if (codegen->IsImplementedIntrinsic(invoke)) {
+    return false;
+  }
+  if (invoke->InputAt(0)->GetReferenceTypeInfo().IsExact()) {
+    return false;
+  }
+  if (invoke->GetResolvedMethod() != nullptr &&
+      (invoke->GetResolvedMethod()->IsFinal() ||
+       invoke->GetResolvedMethod()->GetDeclaringClass()->IsFinal())) {
+    return false;
+  }
   return true;
 }
 
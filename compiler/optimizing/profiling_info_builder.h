@@ -47,6 +47,10 @@ class ProfilingInfoBuilder final : public HGraphDelegateVisitor {
                                      const CompilerOptions& compiler_options,
                                      HInvoke* invoke);
   static bool IsInlineCacheUseful(HInvoke* invoke, CodeGenerator* codegen);
+  // Returns whether the baseline compiler would give `invoke` an inline cache, regardless
+  // of the kind of compilation: intrinsics, exact receivers and final targets get none.
+  static bool CanHaveInlineCache(HInvoke* invoke, CodeGenerator* codegen)
+      REQUIRES_SHARED(Locks::mutator_lock_);
   static uint32_t EncodeInlinedDexPc(
       const HInliner* inliner, const CompilerOptions& compiler_options, HInvoke* invoke)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -24,6 +24,7 @@
 #include "base/bit_utils_iterator.h"
 #include "base/bit_vector-inl.h"
 #include "code_generator.h"
+#include "register_allocator_graph_color.h"
 #include "register_allocator_linear_scan.h"
 #include "ssa_liveness_analysis.h"
 
@@ -65,9 +66,18 @@ RegisterAllocator::RegisterAllocator(ScopedArenaAllocator* allocator,
 
 std::unique_ptr<RegisterAllocator> RegisterAllocator::Create(ScopedArenaAllocator* allocator,
                                                              CodeGenerator* codegen,
-                                                             const SsaLivenessAnalysis& analysis) {
-  return std::unique_ptr<RegisterAllocator>(
-      new (allocator) RegisterAllocatorLinearScan(allocator, codegen, analysis));
+                                                             const SsaLivenessAnalysis& analysis,
+                                                             Strategy strategy) {
+  switch (strategy) {
+    case Strategy::kLinearScan:
+      return std::unique_ptr<RegisterAllocator>(
+          new (allocator) RegisterAllocatorLinearScan(allocator, codegen, analysis));
+    case Strategy::kGraphColor:
+      return std::unique_ptr<RegisterAllocator>(
+          new (allocator) RegisterAllocatorGraphColor(allocator, codegen, analysis));
+  }
+  LOG(FATAL) << "Unexpected register allocation strategy " << static_cast<int>(strategy);
+  UNREACHABLE();
 }
 
 RegisterAllocator::~RegisterAllocator() {
@@ -43,9 +43,15 @@ class RegisterAllocator : public DeletableArenaObject<kArenaAllocRegisterAllocat
     kFpRegister
   };
 
+  enum class Strategy {
+    kLinearScan,  // Fast, used by default.
+    kGraphColor,  // Fewer spills and moves for more compile time.
+  };
+
   static std::unique_ptr<RegisterAllocator> Create(ScopedArenaAllocator* allocator,
                                                    CodeGenerator* codegen,
-                                                   const SsaLivenessAnalysis& analysis);
+                                                   const SsaLivenessAnalysis& analysis,
+                                                   Strategy strategy = Strategy::kLinearScan);
 
   virtual ~RegisterAllocator();
 
@@ -0,0 +1,1131 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "register_allocator_graph_color.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "base/arena_bit_vector.h"
+#include "base/bit_utils.h"
+#include "base/bit_utils_iterator.h"
+#include "base/pointer_size.h"
+#include "base/scoped_arena_allocator.h"
+#include "code_generator.h"
+#include "register_allocation_resolver.h"
+#include "ssa_liveness_analysis.h"
+
+namespace art HIDDEN {
+
+static constexpr size_t kDefaultNumberOfSpillSlots = 4;
+static constexpr size_t kNoNode = std::numeric_limits<size_t>::max();
+
+// Uses in loops weigh `1 << (kLoopDepthWeightShift * depth)` when choosing what to spill.
+static constexpr size_t kLoopDepthWeightShift = 3u;
+static constexpr size_t kMaxWeightedLoopDepth = 8u;
+
+// For simplicity, we implement register pairs as (reg, reg + 1), as the linear scan does.
+static int GetHighForLowRegister(int reg) { return reg + 1; }
+
+// Bits of the even registers.
+static constexpr uint32_t kLowRegistersMask = 0x55555555u;
+
+// Returns the low registers of the pairs with both registers in `mask`.
+static uint32_t GetLowRegistersOfPairs(uint32_t mask) {
+  return mask & (mask >> 1) & kLowRegistersMask;
+}
+
+static uint32_t GetRegistersOf(LiveInterval* interval) {
+  DCHECK(interval->HasRegister());
+  uint32_t mask = 1u << interval->GetRegister();
+  if (interval->HasHighInterval()) {
+    LiveInterval* high = interval->GetHighInterval();
+    mask |= 1u << (high->HasRegister() ? high->GetRegister()
+                                       : GetHighForLowRegister(interval->GetRegister()));
+  }
+  return mask;
+}
+
+// An interval this short cannot be split into anything that would free its register
+// for its register use, so it must get a register.
+static bool IsUnspillable(LiveInterval* interval) {
+  return interval->IsTemp() ||
+         (interval->GetLength() <= 2u && interval->FirstRegisterUse() != kNoLifetime);
+}
+
+static float GetUseWeight(HBasicBlock* block) {
+  size_t depth = 0u;
+  for (HLoopInformationOutwardIterator it(*block); !it.Done(); it.Advance()) {
+    ++depth;
+  }
+  return static_cast<float>(1u << (std::min(depth, kMaxWeightedLoopDepth) * kLoopDepthWeightShift));
+}
+
+// The cost of keeping `interval` in its spill slot, relative to the number
+// of positions it would otherwise keep a register busy.
+static float ComputeSpillWeight(LiveInterval* interval) {
+  if (IsUnspillable(interval)) {
+    return std::numeric_limits<float>::max();
+  }
+  float use_weight = 0.0f;
+  HInstruction* defined_by = interval->GetDefinedBy();
+  if (interval->IsParent() && defined_by != nullptr) {
+    use_weight += GetUseWeight(defined_by->GetBlock());
+  }
+  size_t start = interval->GetStart();
+  size_t end = interval->GetEnd();
+  for (const UsePosition& use : interval->GetUses()) {
+    size_t position = use.GetPosition();
+    if (position > end) {
+      break;
+    }
+    if (position > start && !use.IsSynthesized()) {
+      use_weight += GetUseWeight(use.GetUser()->GetBlock());
+    }
+  }
+  return use_weight / interval->GetLength();
+}
+
+// Returns whether `first` and `second` are both live at a position at or after `position`.
+static bool IntersectsAtOrAfter(LiveInterval* first, LiveInterval* second, size_t position) {
+  LiveRange* first_range = first->GetFirstRange();
+  LiveRange* second_range = second->GetFirstRange();
+  while (first_range != nullptr && second_range != nullptr) {
+    if (first_range->GetEnd() <= position) {
+      first_range = first_range->GetNext();
+    } else if (second_range->GetEnd() <= position) {
+      second_range = second_range->GetNext();
+    } else if (first_range->IntersectsWith(*second_range)) {
+      return true;
+    } else if (first_range->IsBefore(*second_range)) {
+      first_range = first_range->GetNext();
+    } else {
+      second_range = second_range->GetNext();
+    }
+  }
+  return false;
+}
+
+// Returns whether `output` can use the register of `input`, which dies at the instruction
+// defining `output`. The linear scan does the same in `TryAllocateFreeReg`, and this is
+// what `LiveInterval::CanUseInputRegister` validates.
+static bool CanShareRegisterWithInput(LiveInterval* output, LiveInterval* input) {
+  if (!output->IsParent() ||
+      output->IsTemp() ||
+      input->IsTemp() ||
+      output->HasHighInterval() ||
+      input->HasHighInterval()) {
+    return false;
+  }
+  HInstruction* defined_by = output->GetDefinedBy();
+  if (defined_by == nullptr ||
+      defined_by->IsPhi() ||
+      output->GetStart() != defined_by->GetLifetimePosition()) {
+    return false;
+  }
+  LocationSummary* locations = defined_by->GetLocations();
+  if (locations->OutputCanOverlapWithInputs() || !locations->Out().IsUnallocated()) {
+    return false;
+  }
+  size_t position = output->GetStart();
+  if (!input->CoversSlow(position) || input->CoversSlow(position + 1u)) {
+    return false;
+  }
+  HInstruction* value = input->GetParent()->GetDefinedBy();
+  HInputsRef inputs = defined_by->GetInputs();
+  for (size_t i = 0; i != inputs.size(); ++i) {
+    if (inputs[i] == value && locations->InAt(i).IsValid()) {
+      return !IntersectsAtOrAfter(output, input, position + 1u);
+    }
+  }
+  return false;
+}
+
+RegisterAllocatorGraphColor::RegisterAllocatorGraphColor(ScopedArenaAllocator* allocator,
+                                                         CodeGenerator* codegen,
+                                                         const SsaLivenessAnalysis& liveness)
+    : RegisterAllocator(allocator, codegen, liveness),
+      core_intervals_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+      fp_intervals_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+      precolored_core_intervals_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+      precolored_fp_intervals_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+      physical_core_register_intervals_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+      physical_fp_register_intervals_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+      block_registers_for_call_interval_(
+          LiveInterval::MakeFixedInterval(allocator, kNoRegister, DataType::Type::kVoid)),
+      block_registers_special_interval_(
+          LiveInterval::MakeFixedInterval(allocator, kNoRegister, DataType::Type::kVoid)),
+      temp_intervals_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+      int_spill_slots_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+      long_spill_slots_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+      float_spill_slots_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+      double_spill_slots_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+      catch_phi_spill_slots_(0),
+      safepoints_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+      current_register_type_(RegisterType::kCoreRegister),
+      blocked_core_registers_(codegen->GetBlockedCoreRegisters()),
+      blocked_fp_registers_(codegen->GetBlockedFloatingPointRegisters()),
+      reserved_out_slots_(0) {
+  temp_intervals_.reserve(4);
+  int_spill_slots_.reserve(kDefaultNumberOfSpillSlots);
+  long_spill_slots_.reserve(kDefaultNumberOfSpillSlots);
+  float_spill_slots_.reserve(kDefaultNumberOfSpillSlots);
+  double_spill_slots_.reserve(kDefaultNumberOfSpillSlots);
+
+  codegen->SetupBlockedRegisters();
+  physical_core_register_intervals_.resize(num_core_registers_, nullptr);
+  physical_fp_register_intervals_.resize(num_fp_registers_, nullptr);
+  // Always reserve for the current method and the graph's max out registers.
+  // ArtMethod* takes 2 vregs for 64 bits.
+  size_t ptr_size = static_cast<size_t>(InstructionSetPointerSize(codegen->GetInstructionSet()));
+  reserved_out_slots_ = ptr_size / kVRegSize + codegen->GetGraph()->GetMaximumNumberOfOutVRegs();
+}
+
+RegisterAllocatorGraphColor::~RegisterAllocatorGraphColor() {}
+
+void RegisterAllocatorGraphColor::AllocateRegisters() {
+  bool success = TryAllocateRegisters();
+  CHECK(success) << "Graph coloring did not converge in " << kMaxColoringRounds << " rounds";
+}
+
+bool RegisterAllocatorGraphColor::TryAllocateRegisters() {
+  ProcessInstructions();
+
+  ScopedArenaVector<LiveInterval*> fixed_intervals(
+      allocator_->Adapter(kArenaAllocRegisterAllocator));
+  for (LiveInterval* block_registers_interval : { block_registers_for_call_interval_,
+                                                  block_registers_special_interval_ }) {
+    if (block_registers_interval->GetFirstRange() != nullptr) {
+      fixed_intervals.push_back(block_registers_interval);
+    }
+  }
+  size_t number_of_block_intervals = fixed_intervals.size();
+
+  current_register_type_ = RegisterType::kCoreRegister;
+  for (LiveInterval* fixed : physical_core_register_intervals_) {
+    if (fixed != nullptr) {
+      fixed_intervals.push_back(fixed);
+    }
+  }
+  fixed_intervals.insert(fixed_intervals.end(),
+                         precolored_core_intervals_.begin(),
+                         precolored_core_intervals_.end());
+  if (!ColorIntervals(&core_intervals_, ArrayRef<LiveInterval* const>(fixed_intervals))) {
+    return false;
+  }
+
+  current_register_type_ = RegisterType::kFpRegister;
+  fixed_intervals.resize(number_of_block_intervals);
+  for (LiveInterval* fixed : physical_fp_register_intervals_) {
+    if (fixed != nullptr) {
+      fixed_intervals.push_back(fixed);
+    }
+  }
+  fixed_intervals.insert(fixed_intervals.end(),
+                         precolored_fp_intervals_.begin(),
+                         precolored_fp_intervals_.end());
+  if (!ColorIntervals(&fp_intervals_, ArrayRef<LiveInterval* const>(fixed_intervals))) {
+    return false;
+  }
+
+  AllocateSpillSlots();
+  RegisterAllocationResolver(codegen_, liveness_)
+      .Resolve(ArrayRef<HInstruction* const>(safepoints_),
+               reserved_out_slots_,
+               int_spill_slots_.size(),
+               long_spill_slots_.size(),
+               float_spill_slots_.size(),
+               double_spill_slots_.size(),
+               catch_phi_spill_slots_,
+               ArrayRef<LiveInterval* const>(temp_intervals_));
+
+  if (kIsDebugBuild) {
+    current_register_type_ = RegisterType::kCoreRegister;
+    ValidateInternal(true);
+    current_register_type_ = RegisterType::kFpRegister;
+    ValidateInternal(true);
+  }
+  return true;
+}
+
+void RegisterAllocatorGraphColor::ProcessInstructions() {
+  // Iterate post-order, so that safepoints are recorded in the order `AddSafepointsFor` expects.
+  for (HBasicBlock* block : codegen_->GetGraph()->GetLinearPostOrder()) {
+    for (HBackwardInstructionIterator back_it(block->GetInstructions()); !back_it.Done();
+         back_it.Advance()) {
+      ProcessInstruction(back_it.Current());
+    }
+    for (HInstructionIterator inst_it(block->GetPhis()); !inst_it.Done(); inst_it.Advance()) {
+      ProcessInstruction(inst_it.Current());
+    }
+
+    if (block->IsCatchBlock() ||
+        (block->IsLoopHeader() && block->GetLoopInformation()->IsIrreducible())) {
+      // By blocking all registers at the top of each catch block or irreducible loop, we force
+      // intervals belonging to the live-in set of the catch/header block to be spilled.
+      size_t position = block->GetLifetimeStart();
+      DCHECK_EQ(liveness_.GetInstructionFromPosition(position / 2u), nullptr);
+      block_registers_special_interval_->AddRange(position, position + 1u);
+    }
+  }
+}
+
+void RegisterAllocatorGraphColor::ProcessInstruction(HInstruction* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+
+  // Check for early returns.
+  if (locations == nullptr) {
+    return;
+  }
+  if (TryRemoveSuspendCheckEntry(instruction)) {
+    return;
+  }
+
+  bool will_call = locations->WillCall();
+  if (will_call) {
+    // If a call will happen, add the range to a fixed interval that represents all the
+    // caller-save registers blocked at call sites.
+    const size_t position = instruction->GetLifetimePosition();
+    DCHECK_NE(liveness_.GetInstructionFromPosition(position / 2u), nullptr);
+    block_registers_for_call_interval_->AddRange(position, position + 1u);
+  }
+  CheckForTempLiveIntervals(instruction, will_call);
+  CheckForSafepoint(instruction);
+  CheckForFixedInputs(instruction, will_call);
+
+  LiveInterval* current = instruction->GetLiveInterval();
+  if (current == nullptr) {
+    return;
+  }
+
+  const bool core_register = !DataType::IsFloatingPointType(instruction->GetType());
+  ScopedArenaVector<LiveInterval*>& intervals = core_register ? core_intervals_ : fp_intervals_;
+
+  if (codegen_->NeedsTwoRegisters(current->GetType())) {
+    current->AddHighInterval();
+  }
+
+  AddSafepointsFor(instruction);
+  CheckForFixedOutput(instruction, will_call);
+
+  if (instruction->IsPhi() && instruction->AsPhi()->IsCatchPhi()) {
+    AllocateSpillSlotForCatchPhi(instruction->AsPhi());
+  }
+
+  if (current->HasSpillSlot() || instruction->IsConstant()) {
+    // Only color the value from just before its first register use.
+    size_t first_register_use = current->FirstRegisterUse();
+    if (first_register_use != kNoLifetime) {
+      intervals.push_back(SplitBetween(current, current->GetStart(), first_register_use - 1));
+    }
+  } else if (current->HasRegister()) {
+    // The output is in a fixed register. Keep it there for the definition only,
+    // the rest of the value is colored with a preference for that register.
+    (core_register ? precolored_core_intervals_ : precolored_fp_intervals_).push_back(current);
+    if (current->GetStart() + 1u < current->GetEnd()) {
+      intervals.push_back(Split(current, current->GetStart() + 1u));
+    }
+  } else {
+    intervals.push_back(current);
+  }
+}
+
+bool RegisterAllocatorGraphColor::TryRemoveSuspendCheckEntry(HInstruction* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  if (instruction->IsSuspendCheckEntry() && !codegen_->NeedsSuspendCheckEntry()) {
+    // TODO: We do this here because we do not want the suspend check to artificially
+    // create live registers. We should find another place, but this is currently the
+    // simplest.
+    DCHECK_EQ(locations->GetTempCount(), 0u);
+    instruction->GetBlock()->RemoveInstruction(instruction);
+    return true;
+  }
+  return false;
+}
+
+void RegisterAllocatorGraphColor::BlockRegister(Location location,
+                                                size_t position,
+                                                bool will_call) {
+  DCHECK(location.IsRegister() || location.IsFpuRegister());
+  int reg = location.reg();
+  if (will_call) {
+    uint32_t registers_blocked_for_call =
+        location.IsRegister() ? core_registers_blocked_for_call_ : fp_registers_blocked_for_call_;
+    if ((registers_blocked_for_call & (1u << reg)) != 0u) {
+      // Register is already marked as blocked by the `block_registers_for_call_interval_`.
+      return;
+    }
+  }
+  LiveInterval* interval = location.IsRegister()
+      ? physical_core_register_intervals_[reg]
+      : physical_fp_register_intervals_[reg];
+  DataType::Type type = location.IsRegister()
+      ? DataType::Type::kInt32
+      : DataType::Type::kFloat32;
+  if (interval == nullptr) {
+    interval = LiveInterval::MakeFixedInterval(allocator_, reg, type);
+    if (location.IsRegister()) {
+      physical_core_register_intervals_[reg] = interval;
+    } else {
+      physical_fp_register_intervals_[reg] = interval;
+    }
+  }
+  DCHECK(interval->GetRegister() == reg);
+  interval->AddRange(position, position + 1u);
+}
+
+void RegisterAllocatorGraphColor::CheckForTempLiveIntervals(HInstruction* instruction,
+                                                            bool will_call) {
+  LocationSummary* locations = instruction->GetLocations();
+  size_t position = instruction->GetLifetimePosition();
+
+  for (size_t i = 0; i < locations->GetTempCount(); ++i) {
+    Location temp = locations->GetTemp(i);
+    if (temp.IsRegister() || temp.IsFpuRegister()) {
+      BlockRegister(temp, position, will_call);
+      // Ensure that an explicit temporary register is marked as being allocated.
+      codegen_->AddAllocatedRegister(temp);
+    } else {
+      DCHECK(temp.IsUnallocated());
+      switch (temp.GetPolicy()) {
+        case Location::kRequiresRegister: {
+          LiveInterval* interval =
+              LiveInterval::MakeTempInterval(allocator_, DataType::Type::kInt32);
+          temp_intervals_.push_back(interval);
+          interval->AddTempUse(instruction, i);
+          core_intervals_.push_back(interval);
+          break;
+        }
+
+        case Location::kRequiresFpuRegister: {
+          LiveInterval* interval =
+              LiveInterval::MakeTempInterval(allocator_, DataType::Type::kFloat64);
+          temp_intervals_.push_back(interval);
+          interval->AddTempUse(instruction, i);
+          if (codegen_->NeedsTwoRegisters(DataType::Type::kFloat64)) {
+            // The high interval gets its register with the low one.
+            interval->AddHighInterval(/* is_temp= */ true);
+            temp_intervals_.push_back(interval->GetHighInterval());
+          }
+          fp_intervals_.push_back(interval);
+          break;
+        }
+
+        default:
+          LOG(FATAL) << "Unexpected policy for temporary location " << temp.GetPolicy();
+      }
+    }
+  }
+}
+
+void RegisterAllocatorGraphColor::CheckForSafepoint(HInstruction* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  if (locations->NeedsSafepoint()) {
+    safepoints_.push_back(instruction);
+  }
+}
+
+void RegisterAllocatorGraphColor::CheckForFixedInputs(HInstruction* instruction, bool will_call) {
+  LocationSummary* locations = instruction->GetLocations();
+  size_t position = instruction->GetLifetimePosition();
+  for (size_t i = 0; i < locations->GetInputCount(); ++i) {
+    Location input = locations->InAt(i);
+    if (input.IsRegister() || input.IsFpuRegister()) {
+      BlockRegister(input, position, will_call);
+      // Ensure that an explicit input register is marked as being allocated.
+      codegen_->AddAllocatedRegister(input);
+    } else if (input.IsPair()) {
+      BlockRegister(input.ToLow(), position, will_call);
+      BlockRegister(input.ToHigh(), position, will_call);
+      // Ensure that an explicit input register pair is marked as being allocated.
+      codegen_->AddAllocatedRegister(input.ToLow());
+      codegen_->AddAllocatedRegister(input.ToHigh());
+    }
+  }
+}
+
+void RegisterAllocatorGraphColor::AddSafepointsFor(HInstruction* instruction) {
+  LiveInterval* current = instruction->GetLiveInterval();
+  for (size_t safepoint_index = safepoints_.size(); safepoint_index > 0; --safepoint_index) {
+    HInstruction* safepoint = safepoints_[safepoint_index - 1u];
+    size_t safepoint_position = SafepointPosition::ComputePosition(safepoint);
+
+    // Test that safepoints are ordered in the optimal way.
+    DCHECK(safepoint_index == safepoints_.size() ||
+           safepoints_[safepoint_index]->GetLifetimePosition() < safepoint_position);
+
+    if (safepoint_position == current->GetStart()) {
+      // The safepoint is for this instruction, so the location of the instruction
+      // does not need to be saved.
+      DCHECK_EQ(safepoint_index, safepoints_.size());
+      DCHECK_EQ(safepoint, instruction);
+      continue;
+    } else if (current->IsDeadAt(safepoint_position)) {
+      break;
+    } else if (!current->CoversSlow(safepoint_position)) {
+      // Hole in the interval.
+      continue;
+    }
+    current->AddSafepoint(safepoint);
+  }
+}
+
+void RegisterAllocatorGraphColor::CheckForFixedOutput(HInstruction* instruction, bool will_call) {
+  LocationSummary* locations = instruction->GetLocations();
+  size_t position = instruction->GetLifetimePosition();
+  LiveInterval* current = instruction->GetLiveInterval();
+  // Some instructions define their output in fixed register/stack slot, see
+  // `RegisterAllocatorLinearScan::CheckForFixedOutput`.
+  Location output = locations->Out();
+  if (output.IsUnallocated() && output.GetPolicy() == Location::kSameAsFirstInput) {
+    Location first = locations->InAt(0);
+    if (first.IsRegister() || first.IsFpuRegister()) {
+      current->SetFrom(position + 1u);
+      current->SetRegister(first.reg());
+    } else if (first.IsPair()) {
+      current->SetFrom(position + 1u);
+      current->SetRegister(first.low());
+      LiveInterval* high = current->GetHighInterval();
+      high->SetRegister(first.high());
+      high->SetFrom(position + 1u);
+    }
+  } else if (output.IsRegister() || output.IsFpuRegister()) {
+    // Shift the interval's start by one to account for the blocked register.
+    current->SetFrom(position + 1u);
+    current->SetRegister(output.reg());
+    BlockRegister(output, position, will_call);
+    // Ensure that an explicit output register is marked as being allocated.
+    codegen_->AddAllocatedRegister(output);
+  } else if (output.IsPair()) {
+    current->SetFrom(position + 1u);
+    current->SetRegister(output.low());
+    LiveInterval* high = current->GetHighInterval();
+    high->SetRegister(output.high());
+    high->SetFrom(position + 1u);
+    BlockRegister(output.ToLow(), position, will_call);
+    BlockRegister(output.ToHigh(), position, will_call);
+    // Ensure that an explicit output register pair is marked as being allocated.
+    codegen_->AddAllocatedRegister(output.ToLow());
+    codegen_->AddAllocatedRegister(output.ToHigh());
+  } else if (output.IsStackSlot() || output.IsDoubleStackSlot()) {
+    current->SetSpillSlot(output.GetStackIndex());
+  } else {
+    DCHECK(output.IsUnallocated() || output.IsConstant());
+  }
+}
+
+bool RegisterAllocatorGraphColor::ColorIntervals(ScopedArenaVector<LiveInterval*>* intervals,
+                                                 ArrayRef<LiveInterval* const> fixed_intervals) {
+  bool has_split = true;
+  for (size_t round = 0u; has_split; ++round) {
+    if (round == kMaxColoringRounds) {
+      return false;
+    }
+    ColorOnce(ArrayRef<LiveInterval* const>(*intervals), fixed_intervals);
+
+    // Intervals without register uses can stay in their spill slot, and removing them
+    // from the graph does not invalidate the colors of the others. Intervals with register
+    // uses are split, and their siblings around register uses get colored in another round.
+    ScopedArenaVector<LiveInterval*> next_intervals(
+        allocator_->Adapter(kArenaAllocRegisterAllocator));
+    next_intervals.reserve(intervals->size());
+    has_split = false;
+    for (LiveInterval* interval : *intervals) {
+      if (interval->HasRegister()) {
+        next_intervals.push_back(interval);
+      } else if (interval->FirstRegisterUse() != kNoLifetime) {
+        if (IsUnspillable(interval)) {
+          // Splitting would not make progress.
+          return false;
+        }
+        SplitAroundRegisterUses(interval, &next_intervals);
+        has_split = true;
+      }
+    }
+    intervals->swap(next_intervals);
+  }
+
+  for (LiveInterval* interval : *intervals) {
+    DCHECK(interval->HasRegister());
+    int reg = interval->GetRegister();
+    bool is_core = (current_register_type_ == RegisterType::kCoreRegister);
+    codegen_->AddAllocatedRegister(
+        is_core ? Location::RegisterLocation(reg) : Location::FpuRegisterLocation(reg));
+    if (interval->HasHighInterval()) {
+      int high_reg = GetHighForLowRegister(reg);
+      interval->GetHighInterval()->SetRegister(high_reg);
+      codegen_->AddAllocatedRegister(
+          is_core ? Location::RegisterLocation(high_reg) : Location::FpuRegisterLocation(high_reg));
+    }
+  }
+  return true;
+}
+
+void RegisterAllocatorGraphColor::ColorOnce(ArrayRef<LiveInterval* const> intervals,
+                                            ArrayRef<LiveInterval* const> fixed_intervals) {
+  ScopedArenaAllocator allocator(allocator_->GetArenaStack());
+  const size_t number_of_nodes = intervals.size();
+  const size_t number_of_registers = (current_register_type_ == RegisterType::kCoreRegister)
+      ? num_core_registers_
+      : num_fp_registers_;
+  uint32_t available_registers = 0u;
+  for (size_t reg = 0; reg != number_of_registers; ++reg) {
+    if (!IsBlocked(reg)) {
+      available_registers |= 1u << reg;
+    }
+  }
+
+  bool has_pairs = false;
+  for (LiveInterval* interval : intervals) {
+    DCHECK(!interval->IsHighInterval());
+    interval->ClearRegister();
+    has_pairs = has_pairs || interval->HasHighInterval();
+  }
+
+  // (1) Find interferences with a sweep over all live ranges sorted by start position.
+  //     Ranges of fixed intervals only add to the registers a node cannot use.
+  struct RangeEntry {
+    size_t start;
+    size_t end;
+    size_t node;
+    uint32_t fixed_registers;
+  };
+  ScopedArenaVector<RangeEntry> ranges(allocator.Adapter(kArenaAllocRegisterAllocator));
+  for (size_t node = 0; node != number_of_nodes; ++node) {
+    for (LiveRange* range = intervals[node]->GetFirstRange();
+         range != nullptr;
+         range = range->GetNext()) {
+      ranges.push_back({range->GetStart(), range->GetEnd(), node, 0u});
+    }
+  }
+  for (LiveInterval* fixed : fixed_intervals) {
+    uint32_t fixed_registers = fixed->HasRegister()
+        ? GetRegistersOf(fixed)
+        : GetRegisterMask(fixed, current_register_type_);
+    for (LiveRange* range = fixed->GetFirstRange(); range != nullptr; range = range->GetNext()) {
+      ranges.push_back({range->GetStart(), range->GetEnd(), kNoNode, fixed_registers});
+    }
+  }
+  std::sort(ranges.begin(), ranges.end(), [](const RangeEntry& lhs, const RangeEntry& rhs) {
+    return lhs.start < rhs.start;
+  });
+
+  ScopedArenaVector<uint32_t> fixed_registers(
+      number_of_nodes, 0u, allocator.Adapter(kArenaAllocRegisterAllocator));
+  ScopedArenaVector<std::pair<size_t, size_t>> edges(
+      allocator.Adapter(kArenaAllocRegisterAllocator));
+  ScopedArenaVector<RangeEntry> active(allocator.Adapter(kArenaAllocRegisterAllocator));
+  for (const RangeEntry& current : ranges) {
+    auto is_dead = [&](const RangeEntry& entry) { return entry.end <= current.start; };
+    active.erase(std::remove_if(active.begin(), active.end(), is_dead), active.end());
+    for (const RangeEntry& entry : active) {
+      if (current.node != kNoNode && entry.node != kNoNode) {
+        if (current.node != entry.node) {
+          edges.emplace_back(std::min(current.node, entry.node),
+                             std::max(current.node, entry.node));
+        }
+      } else if (current.node != kNoNode) {
+        fixed_registers[current.node] |= entry.fixed_registers;
+      } else if (entry.node != kNoNode) {
+        fixed_registers[entry.node] |= current.fixed_registers;
+      }
+    }
+    active.push_back(current);
+  }
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+  edges.erase(std::remove_if(edges.begin(),
+                             edges.end(),
+                             [&](const std::pair<size_t, size_t>& edge) {
+                               LiveInterval* first = intervals[edge.first];
+                               LiveInterval* second = intervals[edge.second];
+                               return CanShareRegisterWithInput(first, second) ||
+                                      CanShareRegisterWithInput(second, first);
+                             }),
+              edges.end());
+
+  // Adjacency lists, stored contiguously.
+  ScopedArenaVector<size_t> adjacency_start(
+      number_of_nodes + 1u, 0u, allocator.Adapter(kArenaAllocRegisterAllocator));
+  for (const std::pair<size_t, size_t>& edge : edges) {
+    ++adjacency_start[edge.first + 1u];
+    ++adjacency_start[edge.second + 1u];
+  }
+  for (size_t node = 0; node != number_of_nodes; ++node) {
+    adjacency_start[node + 1u] += adjacency_start[node];
+  }
+  ScopedArenaVector<size_t> adjacency(
+      2u * edges.size(), kNoNode, allocator.Adapter(kArenaAllocRegisterAllocator));
+  {
+    ScopedArenaVector<size_t> fill(adjacency_start.begin(),
+                                   adjacency_start.end() - 1u,
+                                   allocator.Adapter(kArenaAllocRegisterAllocator));
+    for (const std::pair<size_t, size_t>& edge : edges) {
+      adjacency[fill[edge.first]++] = edge.second;
+      adjacency[fill[edge.second]++] = edge.first;
+    }
+  }
+  auto neighbors = [&](size_t node) {
+    return ArrayRef<const size_t>(adjacency).SubArray(
+        adjacency_start[node], adjacency_start[node + 1u] - adjacency_start[node]);
+  };
+  auto is_pair = [&](size_t node) { return intervals[node]->HasHighInterval(); };
+  // How many colors a neighbor can take away from `node`.
+  auto edge_weight = [&](size_t node, size_t neighbor) -> size_t {
+    return (!is_pair(node) && is_pair(neighbor)) ? 2u : 1u;
+  };
+
+  // (2) Simplify: remove nodes with fewer neighbors than available colors first. When
+  //     none is left, optimistically remove the cheapest node to spill, it may still
+  //     get a color when selecting.
+  ScopedArenaVector<size_t> colors(
+      number_of_nodes, 0u, allocator.Adapter(kArenaAllocRegisterAllocator));
+  ScopedArenaVector<size_t> degrees(
+      number_of_nodes, 0u, allocator.Adapter(kArenaAllocRegisterAllocator));
+  ScopedArenaVector<float> spill_weights(allocator.Adapter(kArenaAllocRegisterAllocator));
+  ArenaBitVector* removed = ArenaBitVector::Create(
+      &allocator, number_of_nodes, /* expandable= */ false, kArenaAllocRegisterAllocator);
+  ScopedArenaVector<size_t> low_degree_nodes(allocator.Adapter(kArenaAllocRegisterAllocator));
+  ScopedArenaVector<size_t> select_stack(allocator.Adapter(kArenaAllocRegisterAllocator));
+  spill_weights.reserve(number_of_nodes);
+  select_stack.reserve(number_of_nodes);
+  for (size_t node = 0; node != number_of_nodes; ++node) {
+    uint32_t allowed = available_registers & ~fixed_registers[node];
+    colors[node] = is_pair(node) ? POPCOUNT(GetLowRegistersOfPairs(allowed)) : POPCOUNT(allowed);
+    for (size_t neighbor : neighbors(node)) {
+      degrees[node] += edge_weight(node, neighbor);
+    }
+    spill_weights.push_back(ComputeSpillWeight(intervals[node]));
+    if (degrees[node] < colors[node]) {
+      low_degree_nodes.push_back(node);
+    }
+  }
+  for (size_t remaining = number_of_nodes; remaining != 0u; --remaining) {
+    size_t node = kNoNode;
+    while (!low_degree_nodes.empty() && node == kNoNode) {
+      node = low_degree_nodes.back();
+      low_degree_nodes.pop_back();
+      if (removed->IsBitSet(node)) {
+        node = kNoNode;
+      }
+    }
+    if (node == kNoNode) {
+      float best_cost = std::numeric_limits<float>::infinity();
+      for (size_t candidate = 0; candidate != number_of_nodes; ++candidate) {
+        if (removed->IsBitSet(candidate)) {
+          continue;
+        }
+        float cost = spill_weights[candidate] / static_cast<float>(degrees[candidate] + 1u);
+        if (node == kNoNode || cost < best_cost) {
+          node = candidate;
+          best_cost = cost;
+        }
+      }
+    }
+    DCHECK_NE(node, kNoNode);
+    removed->SetBit(node);
+    select_stack.push_back(node);
+    for (size_t neighbor : neighbors(node)) {
+      if (!removed->IsBitSet(neighbor)) {
+        size_t old_degree = degrees[neighbor];
+        degrees[neighbor] -= edge_weight(neighbor, node);
+        if (old_degree >= colors[neighbor] && degrees[neighbor] < colors[neighbor]) {
+          low_degree_nodes.push_back(neighbor);
+        }
+      }
+    }
+  }
+
+  // (3) Select: give each node, in reverse order of removal, a register that none
+  //     of its colored neighbors uses.
+  while (!select_stack.empty()) {
+    size_t node = select_stack.back();
+    select_stack.pop_back();
+    LiveInterval* interval = intervals[node];
+    uint32_t used = 0u;
+    for (size_t neighbor : neighbors(node)) {
+      if (intervals[neighbor]->HasRegister()) {
+        used |= GetRegistersOf(intervals[neighbor]);
+      }
+    }
+    uint32_t allowed = available_registers & ~fixed_registers[node];
+    uint32_t free = allowed & ~used;
+    if (is_pair(node)) {
+      allowed = GetLowRegistersOfPairs(allowed);
+      free = GetLowRegistersOfPairs(free);
+    }
+    if (free != 0u) {
+      interval->SetRegister(ChooseRegister(interval, free, has_pairs));
+    } else if (IsUnspillable(interval)) {
+      // This interval cannot be split any further. Take the register of the
+      // cheapest spillable neighbors, they are split in the next round.
+      int best_reg = kNoRegister;
+      float best_cost = std::numeric_limits<float>::infinity();
+      for (uint32_t reg : LowToHighBits(allowed)) {
+        uint32_t needed = (is_pair(node) ? 3u : 1u) << reg;
+        float cost = 0.0f;
+        for (size_t neighbor : neighbors(node)) {
+          LiveInterval* other = intervals[neighbor];
+          if (other->HasRegister() && (GetRegistersOf(other) & needed) != 0u) {
+            cost = IsUnspillable(other) ? std::numeric_limits<float>::infinity()
+                                        : cost + spill_weights[neighbor];
+          }
+        }
+        if (cost < best_cost) {
+          best_reg = reg;
+          best_cost = cost;
+        }
+      }
+      CHECK_NE(best_reg, kNoRegister) << "No register for an unspillable interval";
+      uint32_t needed = (is_pair(node) ? 3u : 1u) << best_reg;
+      for (size_t neighbor : neighbors(node)) {
+        LiveInterval* other = intervals[neighbor];
+        if (other->HasRegister() && (GetRegistersOf(other) & needed) != 0u) {
+          other->ClearRegister();
+        }
+      }
+      interval->SetRegister(best_reg);
+    }
+  }
+}
+
+int RegisterAllocatorGraphColor::ChooseRegister(LiveInterval* interval,
+                                                uint32_t free,
+                                                bool prefer_intact_pairs) const {
+  DCHECK_NE(free, 0u);
+  // Prefer the register of an interval we would otherwise need a move to or from.
+  auto is_hint = [&](LiveInterval* other) {
+    return other != nullptr &&
+           other->HasRegister() &&
+           !other->IsHighInterval() &&
+           other->SameRegisterKind(*interval) &&
+           other->HasHighInterval() == interval->HasHighInterval() &&
+           (free & (1u << other->GetRegister())) != 0u;
+  };
+  auto location_is_hint = [&](Location location) {
+    return location.IsRegisterKind() &&
+           interval->SameRegisterKind(location) &&
+           (free & (1u << (location.IsPair() ? location.low() : location.reg()))) != 0u;
+  };
+
+  // Split siblings, connected with a move.
+  LiveInterval* previous_sibling = nullptr;
+  for (LiveInterval* sibling = interval->GetParent();
+       sibling != interval;
+       sibling = sibling->GetNextSibling()) {
+    previous_sibling = sibling;
+  }
+  if (is_hint(previous_sibling)) {
+    return previous_sibling->GetRegister();
+  }
+  if (is_hint(interval->GetNextSibling())) {
+    return interval->GetNextSibling()->GetRegister();
+  }
+
+  // The definition.
+  HInstruction* defined_by = interval->GetDefinedBy();
+  if (interval->IsParent() && defined_by != nullptr) {
+    if (defined_by->IsPhi()) {
+      const ArenaVector<HBasicBlock*>& predecessors = defined_by->GetBlock()->GetPredecessors();
+      HInputsRef inputs = defined_by->GetInputs();
+      for (size_t i = 0; i < inputs.size(); ++i) {
+        LiveInterval* input_interval =
+            inputs[i]->GetLiveInterval()->GetSiblingAt(predecessors[i]->GetLifetimeEnd() - 1u);
+        if (is_hint(input_interval)) {
+          return input_interval->GetRegister();
+        }
+      }
+    } else {
+      Location out = defined_by->GetLocations()->Out();
+      if (out.IsUnallocated() && out.GetPolicy() == Location::kSameAsFirstInput) {
+        LiveInterval* input_interval =
+            defined_by->InputAt(0)->GetLiveInterval()->GetSiblingAt(interval->GetStart() - 1u);
+        if (is_hint(input_interval)) {
+          return input_interval->GetRegister();
+        }
+      }
+    }
+  }
+
+  // The uses: fixed inputs, phis and outputs in the same register as their first input.
+  // Temporaries only have their temp use.
+  size_t start = interval->GetStart();
+  size_t end = interval->GetEnd();
+  for (const UsePosition& use : interval->GetUses()) {
+    if (interval->IsTemp()) {
+      break;
+    }
+    size_t position = use.GetPosition();
+    if (position > end) {
+      break;
+    }
+    if (position <= start || use.IsSynthesized()) {
+      continue;
+    }
+    HInstruction* user = use.GetUser();
+    if (user->IsPhi()) {
+      if (is_hint(user->GetLiveInterval())) {
+        return user->GetLiveInterval()->GetRegister();
+      }
+      continue;
+    }
+    LocationSummary* locations = user->GetLocations();
+    Location expected = locations->InAt(use.GetInputIndex());
+    if (location_is_hint(expected)) {
+      return expected.IsPair() ? expected.low() : expected.reg();
+    }
+    Location out = locations->Out();
+    if (use.GetInputIndex() == 0u &&
+        out.IsUnallocated() &&
+        out.GetPolicy() == Location::kSameAsFirstInput &&
+        is_hint(user->GetLiveInterval())) {
+      return user->GetLiveInterval()->GetRegister();
+    }
+  }
+
+  // Intervals live at slow path safepoints prefer callee-save registers, which the slow
+  // paths do not need to save. Others prefer caller-save registers, which do not need
+  // to be saved in the frame.
+  uint32_t caller_save = (current_register_type_ == RegisterType::kCoreRegister)
+      ? core_registers_blocked_for_call_
+      : fp_registers_blocked_for_call_;
+  bool prefer_callee_save = interval->GetFirstSafepoint() != nullptr;
+  uint32_t preferred = free & (prefer_callee_save ? ~caller_save : caller_save);
+  if (preferred == 0u) {
+    preferred = free;
+  }
+  if (prefer_intact_pairs && !interval->HasHighInterval()) {
+    // Do not break a free pair if a single register is free.
+    uint32_t breaks_pair = ((free >> 1) & kLowRegistersMask) | ((free << 1) & ~kLowRegistersMask);
+    if ((preferred & ~breaks_pair) != 0u) {
+      preferred &= ~breaks_pair;
+    }
+  }
+  return CTZ(preferred);
+}
+
+void RegisterAllocatorGraphColor::SplitAroundRegisterUses(
+    LiveInterval* interval, ScopedArenaVector<LiveInterval*>* intervals) {
+  DCHECK(!interval->HasRegister());
+  DCHECK(!interval->IsTemp());
+  LiveInterval* current = interval;
+  size_t use_position = current->FirstRegisterUse();
+  while (use_position != kNoLifetime) {
+    size_t end;
+    if (use_position == current->GetStart()) {
+      // The definition needs a register, the value is spilled right after it.
+      DCHECK(current->IsParent());
+      end = use_position + 1u;
+    } else {
+      // Free the register until just before the use. The value is reloaded from
+      // the spill slot at that position.
+      if (use_position - 1u > current->GetStart()) {
+        current = Split(current, use_position - 1u);
+      }
+      end = use_position;
+      HInstruction* user = liveness_.GetInstructionFromPosition(use_position / 2u);
+      if ((use_position & 1u) != 0u && user != nullptr && user->IsControlFlow()) {
+        // We cannot insert moves after a control flow instruction, keep the register
+        // until the end of the block.
+        end = use_position + 1u;
+      }
+    }
+    intervals->push_back(current);
+    if (end >= current->GetEnd()) {
+      return;
+    }
+    current = Split(current, end);
+    use_position = current->FirstRegisterUse();
+  }
+}
+
+void RegisterAllocatorGraphColor::AllocateSpillSlots() {
+  for (size_t i = 0; i < liveness_.GetNumberOfSsaValues(); ++i) {
+    LiveInterval* parent = liveness_.GetInstructionFromSsaIndex(i)->GetLiveInterval();
+    for (LiveInterval* sibling = parent; sibling != nullptr; sibling = sibling->GetNextSibling()) {
+      if (!sibling->HasRegister()) {
+        AllocateSpillSlotFor(parent);
+        break;
+      }
+    }
+  }
+}
+
+void RegisterAllocatorGraphColor::AllocateSpillSlotFor(LiveInterval* parent) {
+  DCHECK(parent->IsParent());
+  DCHECK(!parent->IsHighInterval());
+
+  // An instruction gets a spill slot for its entire lifetime. If the parent
+  // already has a spill slot, there is nothing to do.
+  if (parent->HasSpillSlot()) {
+    return;
+  }
+
+  HInstruction* defined_by = parent->GetDefinedBy();
+  DCHECK_IMPLIES(defined_by->IsPhi(), !defined_by->AsPhi()->IsCatchPhi());
+
+  if (defined_by->IsParameterValue()) {
+    // Parameters have their own stack slot.
+    parent->SetSpillSlot(codegen_->GetStackSlotOfParameter(defined_by->AsParameterValue()));
+    return;
+  }
+
+  if (defined_by->IsCurrentMethod()) {
+    parent->SetSpillSlot(0);
+    return;
+  }
+
+  if (defined_by->IsConstant()) {
+    // Constants don't need a spill slot.
+    return;
+  }
+
+  ScopedArenaVector<size_t>* spill_slots = nullptr;
+  switch (parent->GetType()) {
+    case DataType::Type::kFloat64:
+      spill_slots = &double_spill_slots_;
+      break;
+    case DataType::Type::kInt64:
+      spill_slots = &long_spill_slots_;
+      break;
+    case DataType::Type::kFloat32:
+      spill_slots = &float_spill_slots_;
+      break;
+    case DataType::Type::kReference:
+    case DataType::Type::kInt32:
+    case DataType::Type::kUint16:
+    case DataType::Type::kUint8:
+    case DataType::Type::kInt8:
+    case DataType::Type::kBool:
+    case DataType::Type::kInt16:
+      spill_slots = &int_spill_slots_;
+      break;
+    case DataType::Type::kUint32:
+    case DataType::Type::kUint64:
+    case DataType::Type::kVoid:
+      LOG(FATAL) << "Unexpected type for interval " << parent->GetType();
+  }
+
+  // Find first available spill slots.
+  size_t number_of_spill_slots_needed = parent->NumberOfSpillSlotsNeeded();
+  size_t slot = 0;
+  for (size_t e = spill_slots->size(); slot < e; ++slot) {
+    bool found = true;
+    for (size_t s = slot, u = std::min(slot + number_of_spill_slots_needed, e); s < u; s++) {
+      if ((*spill_slots)[s] > parent->GetStart()) {
+        found = false;  // failure
+        break;
+      }
+    }
+    if (found) {
+      break;  // success
+    }
+  }
+
+  // Need new spill slots?
+  size_t upper = slot + number_of_spill_slots_needed;
+  if (upper > spill_slots->size()) {
+    spill_slots->resize(upper);
+  }
+  // Set slots to end.
+  size_t end = parent->GetLastSibling()->GetEnd();
+  for (size_t s = slot; s < upper; s++) {
+    (*spill_slots)[s] = end;
+  }
+
+  // Note that the exact spill slot location will be computed when we resolve,
+  // that is when we know the number of spill slots for each type.
+  parent->SetSpillSlot(slot);
+}
+
+void RegisterAllocatorGraphColor::AllocateSpillSlotForCatchPhi(HPhi* phi) {
+  LiveInterval* interval = phi->GetLiveInterval();
+
+  HInstruction* previous_phi = phi->GetPrevious();
+  DCHECK(previous_phi == nullptr || previous_phi->AsPhi()->GetRegNumber() <= phi->GetRegNumber())
+      << "Phis expected to be sorted by vreg number, so that equivalent phis are adjacent.";
+
+  if (phi->IsVRegEquivalentOf(previous_phi)) {
+    // This is an equivalent of the previous phi. We need to assign the same
+    // catch phi slot.
+    DCHECK(previous_phi->GetLiveInterval()->HasSpillSlot());
+    interval->SetSpillSlot(previous_phi->GetLiveInterval()->GetSpillSlot());
+  } else {
+    // Allocate a new spill slot for this catch phi.
+    interval->SetSpillSlot(catch_phi_spill_slots_);
+    catch_phi_spill_slots_ += interval->NumberOfSpillSlotsNeeded();
+  }
+}
+
+bool RegisterAllocatorGraphColor::IsBlocked(int reg) const {
+  return (current_register_type_ == RegisterType::kCoreRegister)
+      ? blocked_core_registers_[reg]
+      : blocked_fp_registers_[reg];
+}
+
+bool RegisterAllocatorGraphColor::ValidateInternal(bool log_fatal_on_failure) const {
+  auto should_process = [](RegisterType current_register_type, LiveInterval* interval) {
+    if (interval == nullptr) {
+      return false;
+    }
+    RegisterType register_type = DataType::IsFloatingPointType(interval->GetType())
+        ? RegisterType::kFpRegister
+        : RegisterType::kCoreRegister;
+    return register_type == current_register_type;
+  };
+
+  ScopedArenaAllocator allocator(allocator_->GetArenaStack());
+  ScopedArenaVector<LiveInterval*> intervals(
+      allocator.Adapter(kArenaAllocRegisterAllocatorValidate));
+  for (size_t i = 0; i < liveness_.GetNumberOfSsaValues(); ++i) {
+    HInstruction* instruction = liveness_.GetInstructionFromSsaIndex(i);
+    if (should_process(current_register_type_, instruction->GetLiveInterval())) {
+      intervals.push_back(instruction->GetLiveInterval());
+    }
+  }
+
+  for (LiveInterval* block_registers_interval : { block_registers_for_call_interval_,
+                                                  block_registers_special_interval_ }) {
+    if (block_registers_interval->GetFirstRange() != nullptr) {
+      intervals.push_back(block_registers_interval);
+    }
+  }
+  const ScopedArenaVector<LiveInterval*>* physical_register_intervals =
+      (current_register_type_ == RegisterType::kCoreRegister)
+          ? &physical_core_register_intervals_
+          : &physical_fp_register_intervals_;
+  for (LiveInterval* fixed : *physical_register_intervals) {
+    if (fixed != nullptr) {
+      intervals.push_back(fixed);
+    }
+  }
+
+  for (LiveInterval* temp : temp_intervals_) {
+    if (should_process(current_register_type_, temp)) {
+      intervals.push_back(temp);
+    }
+  }
+
+  return ValidateIntervals(ArrayRef<LiveInterval* const>(intervals),
+                           GetNumberOfSpillSlots(),
+                           reserved_out_slots_,
+                           *codegen_,
+                           &liveness_,
+                           current_register_type_,
+                           log_fatal_on_failure);
+}
+
+}  // namespace art
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_REGISTER_ALLOCATOR_GRAPH_COLOR_H_
+#define ART_COMPILER_OPTIMIZING_REGISTER_ALLOCATOR_GRAPH_COLOR_H_
+
+#include "base/array_ref.h"
+#include "base/macros.h"
+#include "base/scoped_arena_containers.h"
+#include "register_allocator.h"
+
+namespace art HIDDEN {
+
+class CodeGenerator;
+class HInstruction;
+class HPhi;
+class LiveInterval;
+class Location;
+class SsaLivenessAnalysis;
+
+/**
+ * A graph coloring register allocator on an `HGraph` with SSA form.
+ *
+ * The live intervals computed by the liveness analysis are the nodes of an interference
+ * graph, which we color with Chaitin-Briggs simplification and optimistic selection.
+ * Selection is biased towards the register of related intervals (split siblings, phi inputs,
+ * fixed inputs and outputs) so that most moves become no-ops. Intervals that cannot be colored
+ * are spilled, and split so that each of their register uses gets a short interval of its own;
+ * the graph is then built and colored again until every register use has a register.
+ *
+ * This takes more compile time than linear scan in exchange for fewer spills and moves in
+ * code with high register pressure, and is meant for AOT compilation of hot methods.
+ */
+class RegisterAllocatorGraphColor : public RegisterAllocator {
+ public:
+  RegisterAllocatorGraphColor(ScopedArenaAllocator* allocator,
+                              CodeGenerator* codegen,
+                              const SsaLivenessAnalysis& analysis);
+  ~RegisterAllocatorGraphColor() override;
+
+  void AllocateRegisters() override;
+
+  // Allocate registers, or return false without allocating spill slots or resolving the
+  // locations if the intervals could not be colored within `kMaxColoringRounds` rounds. The
+  // caller must then start over with a new liveness analysis and another allocator.
+  bool TryAllocateRegisters();
+
+  // Splitting intervals around their register uses normally gets every register use colored
+  // in a few rounds. Bound the number of rounds in case it does not.
+  static constexpr size_t kMaxColoringRounds = 32u;
+
+  bool Validate(bool log_fatal_on_failure) override {
+    current_register_type_ = RegisterType::kCoreRegister;
+    if (!ValidateInternal(log_fatal_on_failure)) {
+      return false;
+    }
+    current_register_type_ = RegisterType::kFpRegister;
+    return ValidateInternal(log_fatal_on_failure);
+  }
+
+  size_t GetNumberOfSpillSlots() const {
+    return int_spill_slots_.size()
+        + long_spill_slots_.size()
+        + float_spill_slots_.size()
+        + double_spill_slots_.size()
+        + catch_phi_spill_slots_;
+  }
+
+ private:
+  // Collect the intervals to color and the registers blocked by the code generator
+  // and the location summaries, like the linear scan does.
+  void ProcessInstructions();
+  void ProcessInstruction(HInstruction* instruction);
+
+  // Try to remove the SuspendCheck at function entry. Returns true if it was successful.
+  bool TryRemoveSuspendCheckEntry(HInstruction* instruction);
+
+  // Update the interval for the register in `location` to cover [position, position + 1).
+  void BlockRegister(Location location, size_t position, bool will_call);
+
+  // Create synthesized intervals for the temporary locations needed by an instruction.
+  void CheckForTempLiveIntervals(HInstruction* instruction, bool will_call);
+
+  // If a safe point is needed, record it so that the resolver saves the live registers.
+  void CheckForSafepoint(HInstruction* instruction);
+
+  // If any inputs require specific registers, block those registers
+  // at the position of this instruction.
+  void CheckForFixedInputs(HInstruction* instruction, bool will_call);
+
+  // If the output of an instruction requires a specific register, assign that
+  // register to the interval.
+  void CheckForFixedOutput(HInstruction* instruction, bool will_call);
+
+  // Add all applicable safepoints to a live interval.
+  // Currently depends on instruction processing order.
+  void AddSafepointsFor(HInstruction* instruction);
+
+  // Color `intervals` for the current register type, splitting the intervals that do not
+  // get a register around their register uses until every register use has a register.
+  // `fixed_intervals` are the intervals with a register decided before coloring. Returns false
+  // if some register uses still have no register after `kMaxColoringRounds` rounds.
+  bool ColorIntervals(ScopedArenaVector<LiveInterval*>* intervals,
+                      ArrayRef<LiveInterval* const> fixed_intervals);
+
+  // Build the interference graph of `intervals` and color it. Intervals for
+  // which no register was found are left without a register.
+  void ColorOnce(ArrayRef<LiveInterval* const> intervals,
+                 ArrayRef<LiveInterval* const> fixed_intervals);
+
+  // Pick a register for `interval` among the `free` ones, preferring the register of
+  // related intervals. For register pairs, `free` only has bits set for the low register
+  // of free pairs.
+  int ChooseRegister(LiveInterval* interval, uint32_t free, bool prefer_intact_pairs) const;
+
+  // Split an interval that did not get a register so that each of its register uses
+  // is covered by a short sibling, and add these siblings to `intervals`. The
+  // rest of the interval stays in its spill slot.
+  void SplitAroundRegisterUses(LiveInterval* interval, ScopedArenaVector<LiveInterval*>* intervals);
+
+  // Allocate spill slots for all the intervals with a sibling that did not get a register.
+  void AllocateSpillSlots();
+  void AllocateSpillSlotFor(LiveInterval* parent);
+
+  // Allocate a spill slot for the given catch phi. Will allocate the same slot
+  // for phis which share the same vreg. Must be called in reverse linear order
+  // of lifetime positions and ascending vreg numbers for correctness.
+  void AllocateSpillSlotForCatchPhi(HPhi* phi);
+
+  bool IsBlocked(int reg) const;
+  bool ValidateInternal(bool log_fatal_on_failure) const;
+
+  // Intervals to color, for core and floating-point registers. Split siblings
+  // replace the intervals that could not be colored.
+  ScopedArenaVector<LiveInterval*> core_intervals_;
+  ScopedArenaVector<LiveInterval*> fp_intervals_;
+
+  // Intervals of instructions with their output in a fixed register. They only
+  // cover the definition, the rest of the value is in `core_intervals_` or `fp_intervals_`.
+  ScopedArenaVector<LiveInterval*> precolored_core_intervals_;
+  ScopedArenaVector<LiveInterval*> precolored_fp_intervals_;
+
+  // Fixed intervals for physical registers. Such intervals cover the positions
+  // where an instruction requires a specific register.
+  ScopedArenaVector<LiveInterval*> physical_core_register_intervals_;
+  ScopedArenaVector<LiveInterval*> physical_fp_register_intervals_;
+  LiveInterval* block_registers_for_call_interval_;
+  LiveInterval* block_registers_special_interval_;  // For catch block or irreducible loop header.
+
+  // Intervals for temporaries. Such intervals cover the positions
+  // where an instruction requires a temporary.
+  ScopedArenaVector<LiveInterval*> temp_intervals_;
+
+  // The spill slots allocated for live intervals, typed as in the linear scan.
+  ScopedArenaVector<size_t> int_spill_slots_;
+  ScopedArenaVector<size_t> long_spill_slots_;
+  ScopedArenaVector<size_t> float_spill_slots_;
+  ScopedArenaVector<size_t> double_spill_slots_;
+
+  // Spill slots allocated to catch phis, see `RegisterAllocatorLinearScan`.
+  size_t catch_phi_spill_slots_;
+
+  // Instructions that need a safepoint.
+  ScopedArenaVector<HInstruction*> safepoints_;
+
+  // The register type we're currently processing.
+  RegisterType current_register_type_;
+
+  // Blocked registers, as decided by the code generator.
+  bool* const blocked_core_registers_;
+  bool* const blocked_fp_registers_;
+
+  // Slots reserved for out arguments.
+  size_t reserved_out_slots_;
+
+  DISALLOW_COPY_AND_ASSIGN(RegisterAllocatorGraphColor);
+};
+
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_REGISTER_ALLOCATOR_GRAPH_COLOR_H_
@@ -46,7 +46,11 @@ class RegisterAllocatorTest : public CommonCompilerTest, public OptimizingUnitTe
   }
 
   // Helper functions that make use of the OptimizingUnitTest's members.
-  bool Check(const std::vector<uint16_t>& data);
+  bool Check(const std::vector<uint16_t>& data,
+             RegisterAllocator::Strategy strategy = RegisterAllocator::Strategy::kLinearScan);
+  bool CheckForIsa(const std::vector<uint16_t>& data,
+                   InstructionSet isa,
+                   RegisterAllocator::Strategy strategy);
   HGraph* BuildIfElseWithPhi(HPhi** phi, HInstruction** input1, HInstruction** input2);
   HGraph* BuildFieldReturn(HInstruction** field, HInstruction** ret);
   HGraph* BuildTwoSubs(HInstruction** first_sub, HInstruction** second_sub);
@@ -66,13 +70,29 @@ class RegisterAllocatorTest : public CommonCompilerTest, public OptimizingUnitTe
   std::unique_ptr<CompilerOptions> compiler_options_;
 };
 
-bool RegisterAllocatorTest::Check(const std::vector<uint16_t>& data) {
+bool RegisterAllocatorTest::Check(const std::vector<uint16_t>& data,
+                                  RegisterAllocator::Strategy strategy) {
   HGraph* graph = CreateCFG(data);
   x86::CodeGeneratorX86 codegen(graph, *compiler_options_);
   SsaLivenessAnalysis liveness(graph, &codegen, GetScopedAllocator());
   liveness.Analyze();
   std::unique_ptr<RegisterAllocator> register_allocator =
-      RegisterAllocator::Create(GetScopedAllocator(), &codegen, liveness);
+      RegisterAllocator::Create(GetScopedAllocator(), &codegen, liveness, strategy);
+  register_allocator->AllocateRegisters();
+  return register_allocator->Validate(false);
+}
+
+bool RegisterAllocatorTest::CheckForIsa(const std::vector<uint16_t>& data,
+                                        InstructionSet isa,
+                                        RegisterAllocator::Strategy strategy) {
+  std::unique_ptr<CompilerOptions> compiler_options =
+      CommonCompilerTest::CreateCompilerOptions(isa, "default");
+  HGraph* graph = CreateCFG(data);
+  std::unique_ptr<CodeGenerator> codegen = CodeGenerator::Create(graph, *compiler_options);
+  SsaLivenessAnalysis liveness(graph, codegen.get(), GetScopedAllocator());
+  liveness.Analyze();
+  std::unique_ptr<RegisterAllocator> register_allocator =
+      RegisterAllocator::Create(GetScopedAllocator(), codegen.get(), liveness, strategy);
   register_allocator->AllocateRegisters();
   return register_allocator->Validate(false);
 }
@@ -173,6 +193,7 @@ TEST_F(RegisterAllocatorTest, CFG1) {
     Instruction::RETURN);
 
   ASSERT_TRUE(Check(data));
+  ASSERT_TRUE(Check(data, RegisterAllocator::Strategy::kGraphColor));
 }
 
 TEST_F(RegisterAllocatorTest, Loop1) {
@@ -212,6 +233,7 @@ TEST_F(RegisterAllocatorTest, Loop1) {
     Instruction::RETURN | 1 << 8);
 
   ASSERT_TRUE(Check(data));
+  ASSERT_TRUE(Check(data, RegisterAllocator::Strategy::kGraphColor));
 }
 
 TEST_F(RegisterAllocatorTest, Loop2) {
@@ -261,6 +283,7 @@ TEST_F(RegisterAllocatorTest, Loop2) {
     Instruction::RETURN | 1 << 8);
 
   ASSERT_TRUE(Check(data));
+  ASSERT_TRUE(Check(data, RegisterAllocator::Strategy::kGraphColor));
 }
 
 TEST_F(RegisterAllocatorTest, Loop3) {
@@ -715,18 +738,22 @@ HGraph* RegisterAllocatorTest::BuildDiv(HInstruction** div) {
 }
 
 TEST_F(RegisterAllocatorTest, ExpectedExactInRegisterAndSameOutputHint) {
-  HInstruction *div;
-  HGraph* graph = BuildDiv(&div);
-  x86::CodeGeneratorX86 codegen(graph, *compiler_options_);
-  SsaLivenessAnalysis liveness(graph, &codegen, GetScopedAllocator());
-  liveness.Analyze();
+  for (RegisterAllocator::Strategy strategy : {RegisterAllocator::Strategy::kLinearScan,
+                                               RegisterAllocator::Strategy::kGraphColor}) {
+    HInstruction *div;
+    HGraph* graph = BuildDiv(&div);
+    x86::CodeGeneratorX86 codegen(graph, *compiler_options_);
+    SsaLivenessAnalysis liveness(graph, &codegen, GetScopedAllocator());
+    liveness.Analyze();
 
-  std::unique_ptr<RegisterAllocator> register_allocator =
-      RegisterAllocator::Create(GetScopedAllocator(), &codegen, liveness);
-  register_allocator->AllocateRegisters();
+    std::unique_ptr<RegisterAllocator> register_allocator =
+        RegisterAllocator::Create(GetScopedAllocator(), &codegen, liveness, strategy);
+    register_allocator->AllocateRegisters();
+    ASSERT_TRUE(register_allocator->Validate(false));
 
-  // div on x86 requires its first input in eax and the output be the same as the first input.
-  ASSERT_EQ(div->GetLiveInterval()->GetRegister(), 0);
+    // div on x86 requires its first input in eax and the output be the same as the first input.
+    ASSERT_EQ(div->GetLiveInterval()->GetRegister(), 0);
+  }
 }
 
 // Test a bug in the register allocator, where allocating a blocked
@@ -830,4 +857,54 @@ TEST_F(RegisterAllocatorTest, SpillInactive) {
   ASSERT_TRUE(ValidateIntervals(intervals, codegen));
 }
 
+// The other tests use the x86 code generator. Also allocate with the arm64 and riscv64 ones.
+TEST_F(RegisterAllocatorTest, GraphColorArm64AndRiscv64) {
+  std::vector<InstructionSet> isas;
+#ifdef ART_ENABLE_CODEGEN_arm64
+  isas.push_back(InstructionSet::kArm64);
+#endif
+#ifdef ART_ENABLE_CODEGEN_riscv64
+  isas.push_back(InstructionSet::kRiscv64);
+#endif
+
+  // int a = 0; while (a == 8) { a = 4 + 5; } return 6 + 7;
+  const std::vector<uint16_t> loop = TWO_REGISTERS_CODE_ITEM(
+    Instruction::CONST_4 | 0 | 0,
+    Instruction::CONST_4 | 8 << 12 | 1 << 8,
+    Instruction::IF_EQ | 1 << 8, 7,
+    Instruction::CONST_4 | 4 << 12 | 0 << 8,
+    Instruction::CONST_4 | 5 << 12 | 1 << 8,
+    Instruction::ADD_INT, 1 << 8 | 0,
+    Instruction::GOTO | 0xFA00,
+    Instruction::CONST_4 | 6 << 12 | 1 << 8,
+    Instruction::CONST_4 | 7 << 12 | 1 << 8,
+    Instruction::ADD_INT, 1 << 8 | 0,
+    Instruction::RETURN | 1 << 8);
+
+  // Keep 15 values live at the same time, then add them up.
+  std::vector<uint16_t> pressure_insns;
+  for (uint16_t reg = 0; reg != 15; ++reg) {
+    pressure_insns.push_back(Instruction::CONST_16 | reg << 8);
+    pressure_insns.push_back(reg + 1u);
+  }
+  for (uint16_t reg = 1; reg != 15; ++reg) {
+    pressure_insns.push_back(Instruction::ADD_INT);  // v0 = v0 + v<reg>
+    pressure_insns.push_back(reg << 8 | 0);
+  }
+  pressure_insns.push_back(Instruction::RETURN | 0 << 8);
+  // Code item header, see N_REGISTERS_CODE_ITEM.
+  std::vector<uint16_t> pressure = {
+      15u, 0u, 0u, 0u, 0u, 0u, static_cast<uint16_t>(pressure_insns.size()), 0u};
+  pressure.insert(pressure.end(), pressure_insns.begin(), pressure_insns.end());
+
+  for (InstructionSet isa : isas) {
+    for (const std::vector<uint16_t>* data : {&loop, &pressure}) {
+      ResetPoolAndAllocator();
+      ASSERT_TRUE(CheckForIsa(*data, isa, RegisterAllocator::Strategy::kLinearScan)) << isa;
+      ResetPoolAndAllocator();
+      ASSERT_TRUE(CheckForIsa(*data, isa, RegisterAllocator::Strategy::kGraphColor)) << isa;
+    }
+  }
+}
+
 }  // namespace art
@@ -327,9 +327,11 @@ static inline bool CanUseTypeCheckBitstring(ObjPtr<mirror::Class> klass, CodeGen
     // If the target is a boot image class, try to assign a type check bitstring (fall through).
     // (If --force-determinism, this was already done; repeating is OK and yields the same result.)
   } else {
-    // TODO: Use the bitstring also for AOT app compilation if the target class has a bitstring
-    // already assigned in the boot image.
-    return false;
+    // For AOT app compilation, use the bitstring if the target class has a bitstring assigned
+    // in the boot image file. The oat file is only used with that boot image, so the bitstring
+    // is the same at runtime. The in-memory state is not enough: initializing app classes
+    // assigns bitstrings to their boot image superclasses and the runtime can assign others.
+    return Runtime::Current()->GetClassLinker()->IsTypeCheckBitstringAssignedInBootImage(klass);
   }
 
   // Try to assign a type check bitstring.
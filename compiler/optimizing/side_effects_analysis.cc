@@ -18,11 +18,22 @@
 
 namespace art HIDDEN {
 
+const FieldInfo* GetNonVolatileFieldWrite(HInstruction* instruction) {
+  const FieldInfo* field_info = nullptr;
+  if (instruction->IsInstanceFieldSet()) {
+    field_info = &instruction->AsInstanceFieldSet()->GetFieldInfo();
+  } else if (instruction->IsStaticFieldSet()) {
+    field_info = &instruction->AsStaticFieldSet()->GetFieldInfo();
+  }
+  return (field_info != nullptr && !field_info->IsVolatile()) ? field_info : nullptr;
+}
+
 bool SideEffectsAnalysis::Run() {
   // Inlining might have created more blocks, so we need to increase the size
   // if needed.
   block_effects_.resize(graph_->GetBlocks().size());
   loop_effects_.resize(graph_->GetBlocks().size());
+  loop_field_writes_.resize(graph_->GetBlocks().size());
 
   // In DEBUG mode, ensure side effects are properly initialized to empty.
   if (kIsDebugBuild) {
@@ -39,14 +50,25 @@ bool SideEffectsAnalysis::Run() {
   // Do a post order visit to ensure we visit a loop header after its loop body.
   for (HBasicBlock* block : graph_->GetPostOrder()) {
     SideEffects effects = SideEffects::None();
+    HLoopInformation* loop_info = block->GetLoopInformation();
     // Update `effects` with the side effects of all instructions in this block.
     for (HInstructionIterator inst_it(block->GetInstructions()); !inst_it.Done();
          inst_it.Advance()) {
       HInstruction* instruction = inst_it.Current();
       effects = effects.Union(instruction->GetSideEffects());
-      // If all side effects are represented, scanning further will not add any
-      // more information to side-effects of this block.
-      if (effects.DoesAll()) {
+      if (loop_info != nullptr) {
+        // Record which fields the loop writes, the effects of other instructions
+        // are added to the loop when we are done with the block.
+        const FieldInfo* field_info = GetNonVolatileFieldWrite(instruction);
+        if (field_info != nullptr) {
+          AddLoopFieldWrite(loop_info, field_info);
+        } else {
+          LoopFieldWrites& writes = loop_field_writes_[loop_info->GetHeader()->GetBlockId()];
+          writes.other_effects = writes.other_effects.Union(instruction->GetSideEffects());
+        }
+      } else if (effects.DoesAll()) {
+        // If all side effects are represented, scanning further will not add any
+        // more information to side-effects of this block.
         break;
       }
     }
@@ -62,6 +84,8 @@ bool SideEffectsAnalysis::Run() {
         // Note that this works because we know all the blocks of the inner loop are visited
         // before the loop header of the outer loop.
         UpdateLoopEffects(pre_header->GetLoopInformation(), GetLoopEffects(block));
+        UpdateLoopFieldWrites(pre_header->GetLoopInformation(),
+                              loop_field_writes_[block->GetBlockId()]);
       }
     } else if (block->IsInLoop()) {
       // Update the side effects of the loop with the side effects of this block.
@@ -81,9 +105,49 @@ SideEffects SideEffectsAnalysis::GetBlockEffects(HBasicBlock* block) const {
   return block_effects_[block->GetBlockId()];
 }
 
+SideEffects SideEffectsAnalysis::GetLoopEffectsExceptFieldWrites(HBasicBlock* block) const {
+  DCHECK(block->IsLoopHeader());
+  return loop_field_writes_[block->GetBlockId()].other_effects;
+}
+
+ArrayRef<const FieldInfo* const> SideEffectsAnalysis::GetLoopFieldWrites(
+    HBasicBlock* block) const {
+  DCHECK(block->IsLoopHeader());
+  const LoopFieldWrites& writes = loop_field_writes_[block->GetBlockId()];
+  return ArrayRef<const FieldInfo* const>(writes.fields, writes.num_fields);
+}
+
 void SideEffectsAnalysis::UpdateLoopEffects(HLoopInformation* info, SideEffects effects) {
   uint32_t id = info->GetHeader()->GetBlockId();
   loop_effects_[id] = loop_effects_[id].Union(effects);
 }
 
+void SideEffectsAnalysis::AddLoopFieldWrite(HLoopInformation* info, const FieldInfo* field) {
+  DCHECK(!field->IsVolatile());
+  LoopFieldWrites& writes = loop_field_writes_[info->GetHeader()->GetBlockId()];
+  for (size_t i = 0; i != writes.num_fields; ++i) {
+    if (writes.fields[i]->GetFieldOffset() == field->GetFieldOffset() &&
+        writes.fields[i]->GetFieldType() == field->GetFieldType()) {
+      return;
+    }
+  }
+  if (writes.num_fields == LoopFieldWrites::kMaxFields) {
+    writes.other_effects =
+        writes.other_effects.Union(SideEffects::FieldWriteOfType(field->GetFieldType(),
+                                                                 /* is_volatile= */ false));
+  } else {
+    writes.fields[writes.num_fields] = field;
+    ++writes.num_fields;
+  }
+}
+
+void SideEffectsAnalysis::UpdateLoopFieldWrites(HLoopInformation* info,
+                                                const LoopFieldWrites& inner_loop_writes) {
+  LoopFieldWrites& writes = loop_field_writes_[info->GetHeader()->GetBlockId()];
+  writes.other_effects = writes.other_effects.Union(inner_loop_writes.other_effects);
+  for (size_t i = 0; i != inner_loop_writes.num_fields; ++i) {
+    AddLoopFieldWrite(info, inner_loop_writes.fields[i]);
+  }
+}
+
 }  // namespace art
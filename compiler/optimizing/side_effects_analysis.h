@@ -18,23 +18,35 @@
 #define ART_COMPILER_OPTIMIZING_SIDE_EFFECTS_ANALYSIS_H_
 
 #include "base/arena_containers.h"
+#include "base/array_ref.h"
 #include "base/macros.h"
 #include "nodes.h"
 #include "optimization.h"
 
 namespace art HIDDEN {
 
+// If `instruction` is a non-volatile field store, returns the field it writes.
+// The side effects of such a store are only the field write of the field type.
+const FieldInfo* GetNonVolatileFieldWrite(HInstruction* instruction);
+
 class SideEffectsAnalysis : public HOptimization {
  public:
   explicit SideEffectsAnalysis(HGraph* graph, const char* pass_name = kSideEffectsAnalysisPassName)
       : HOptimization(graph, pass_name),
         graph_(graph),
         block_effects_(graph->GetAllocator()->Adapter(kArenaAllocSideEffectsAnalysis)),
-        loop_effects_(graph->GetAllocator()->Adapter(kArenaAllocSideEffectsAnalysis)) {}
+        loop_effects_(graph->GetAllocator()->Adapter(kArenaAllocSideEffectsAnalysis)),
+        loop_field_writes_(graph->GetAllocator()->Adapter(kArenaAllocSideEffectsAnalysis)) {}
 
   SideEffects GetLoopEffects(HBasicBlock* block) const;
   SideEffects GetBlockEffects(HBasicBlock* block) const;
 
+  // Returns the side effects of the loop, except for the non-volatile field stores
+  // returned by `GetLoopFieldWrites()`. This lets users kill only the loads of the
+  // fields written in the loop, rather than all field loads of the written types.
+  SideEffects GetLoopEffectsExceptFieldWrites(HBasicBlock* block) const;
+  ArrayRef<const FieldInfo* const> GetLoopFieldWrites(HBasicBlock* block) const;
+
   // Compute side effects of individual blocks and loops.
   bool Run();
 
@@ -43,7 +55,19 @@ class SideEffectsAnalysis : public HOptimization {
   static constexpr const char* kSideEffectsAnalysisPassName = "side_effects";
 
  private:
+  // The non-volatile fields written in a loop. We only track a few of them, once there
+  // are more, their writes are added to `other_effects` instead.
+  struct LoopFieldWrites {
+    static constexpr size_t kMaxFields = 8u;
+
+    SideEffects other_effects = SideEffects::None();
+    size_t num_fields = 0u;
+    const FieldInfo* fields[kMaxFields];
+  };
+
   void UpdateLoopEffects(HLoopInformation* info, SideEffects effects);
+  void AddLoopFieldWrite(HLoopInformation* info, const FieldInfo* field);
+  void UpdateLoopFieldWrites(HLoopInformation* info, const LoopFieldWrites& inner_loop_writes);
 
   HGraph* graph_;
 
@@ -59,6 +83,9 @@ class SideEffectsAnalysis : public HOptimization {
   // blocks contained in that loop.
   ArenaVector<SideEffects> loop_effects_;
 
+  // Field writes of loops, indexed like `loop_effects_`.
+  ArenaVector<LoopFieldWrites> loop_field_writes_;
+
   ART_FRIEND_TEST(GVNTest, LoopSideEffects);
   DISALLOW_COPY_AND_ASSIGN(SideEffectsAnalysis);
 };
@@ -895,6 +895,14 @@ class Dex2Oat final {
     }
     compiler_options_->force_determinism_ = force_determinism_;
 
+    // Which methods are compiled before the budget runs out depends on the order in which the
+    // compiler threads finish, so the output would not be reproducible.
+    if (max_compiled_method_memory_mb_ != 0u &&
+        (force_determinism_ || IsBootImage() || IsBootImageExtension())) {
+      Usage("--max-compiled-method-memory cannot be used with --force-determinism or when"
+            " compiling a boot image or boot image extension");
+    }
+
     compiler_options_->check_linkage_conditions_ = check_linkage_conditions_;
     compiler_options_->crash_on_linkage_violation_ = crash_on_linkage_violation_;
 
@@ -1104,6 +1112,7 @@ class Dex2Oat final {
     AssignIfExists(args, M::SwapDexSizeThreshold, &min_dex_file_cumulative_size_for_swap_);
     AssignIfExists(args, M::SwapDexCountThreshold, &min_dex_files_for_swap_);
     AssignIfExists(args, M::VeryLargeAppThreshold, &very_large_threshold_);
+    AssignIfExists(args, M::MaxCompiledMethodMemory, &max_compiled_method_memory_mb_);
     AssignIfExists(args, M::AppImageFile, &app_image_file_name_);
     AssignIfExists(args, M::AppImageFileFd, &app_image_fd_);
     AssignIfExists(args, M::NoInlineFrom, &no_inline_from_string_);
@@ -1907,6 +1916,7 @@ class Dex2Oat final {
                                      verification_results_.get(),
                                      thread_count_,
                                      swap_fd_));
+    driver_->SetCompiledMethodMemoryBudget(max_compiled_method_memory_mb_ * MB);
 
     driver_->PrepareDexFilesForOatFile(timings_);
 
@@ -2777,7 +2787,9 @@ class Dex2Oat final {
     }
     if (!image_writer_->Write(IsAppImage() ? app_image_fd_ : image_fd_,
                               image_filenames_,
-                              IsAppImage() ? 1u : dex_locations_.size())) {
+                              IsAppImage() ? 1u : dex_locations_.size(),
+                              thread_count_,
+                              timings_)) {
       LOG(ERROR) << "Failure during image file creation";
       return false;
     }
@@ -2974,6 +2986,7 @@ class Dex2Oat final {
   size_t min_dex_files_for_swap_ = kDefaultMinDexFilesForSwap;
   size_t min_dex_file_cumulative_size_for_swap_ = kDefaultMinDexFileCumulativeSizeForSwap;
   size_t very_large_threshold_ = std::numeric_limits<size_t>::max();
+  size_t max_compiled_method_memory_mb_ = 0u;
   std::string app_image_file_name_;
   int app_image_fd_;
   std::vector<std::string> profile_files_;
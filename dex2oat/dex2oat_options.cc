@@ -351,6 +351,13 @@ Parser CreateDex2oatArgumentParser() {
           .WithHelp("Specifies the minimum total dex file size in bytes to consider the input\n"
                     "\"very large\" and reduce compilation done.")
           .IntoKey(M::VeryLargeAppThreshold)
+      .Define("--max-compiled-method-memory=_")
+          .WithType<unsigned int>()
+          .WithHelp("Specifies, in MiB, how much memory the code and metadata of compiled methods\n"
+                    "may use. Once it is reached, the remaining methods are not compiled.\n"
+                    "The output then depends on thread timing, so this cannot be used with\n"
+                    "--force-determinism or for boot images.")
+          .IntoKey(M::MaxCompiledMethodMemory)
       .Define("--force-determinism")
           .WithHelp("Force the compiler to emit a deterministic output")
           .IntoKey(M::ForceDeterminism)
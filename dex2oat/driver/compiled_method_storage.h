@@ -17,6 +17,7 @@
 #ifndef ART_DEX2OAT_DRIVER_COMPILED_METHOD_STORAGE_H_
 #define ART_DEX2OAT_DRIVER_COMPILED_METHOD_STORAGE_H_
 
+#include <atomic>
 #include <iosfwd>
 #include <map>
 #include <memory>
@@ -49,6 +50,12 @@ class CompiledMethodStorage final : public CompiledCodeStorage {
     return dedupe_enabled_;
   }
 
+  // Returns the number of bytes currently held for the code, stack maps, CFI and
+  // linker patches of compiled methods, whether in memory or in the swap file.
+  size_t GetAllocatedArrayBytes() const {
+    return allocated_array_bytes_.load(std::memory_order_relaxed);
+  }
+
   SwapAllocator<void> GetSwapSpaceAllocator() {
     return SwapAllocator<void>(swap_space_.get());
   }
@@ -128,6 +135,9 @@ class CompiledMethodStorage final : public CompiledCodeStorage {
 
   bool dedupe_enabled_;
 
+  // Needs to be initialized before the dedupe sets that update it.
+  std::atomic<size_t> allocated_array_bytes_;
+
   ArrayDedupeSet<uint8_t> dedupe_code_;
   ArrayDedupeSet<uint8_t> dedupe_vmap_table_;
   ArrayDedupeSet<uint8_t> dedupe_cfi_info_;
@@ -98,4 +98,40 @@ TEST(CompiledMethodStorage, Deduplicate) {
   }
 }
 
+TEST(CompiledMethodStorage, AllocatedArrayBytes) {
+  const uint8_t raw_code[] = { 1u, 2u, 3u };
+  const uint8_t raw_vmap_table[] = { 2, 4, 6 };
+  ArrayRef<const uint8_t> code(raw_code);
+  ArrayRef<const uint8_t> vmap_table(raw_vmap_table);
+  const size_t expected_size = 2u * LengthPrefixedArray<uint8_t>::ComputeSize(3u);
+
+  {
+    CompiledMethodStorage storage(/* swap_fd= */ -1);
+    ASSERT_EQ(0u, storage.GetAllocatedArrayBytes());
+    CompiledMethod* method1 = CompiledMethod::SwapAllocCompiledMethod(
+        &storage, InstructionSet::kNone, code, vmap_table, {}, {});
+    EXPECT_EQ(expected_size, storage.GetAllocatedArrayBytes());
+    // Deduplicated data is not counted twice.
+    CompiledMethod* method2 = CompiledMethod::SwapAllocCompiledMethod(
+        &storage, InstructionSet::kNone, code, vmap_table, {}, {});
+    EXPECT_EQ(expected_size, storage.GetAllocatedArrayBytes());
+    CompiledMethod::ReleaseSwapAllocatedCompiledMethod(&storage, method1);
+    CompiledMethod::ReleaseSwapAllocatedCompiledMethod(&storage, method2);
+  }
+
+  {
+    CompiledMethodStorage storage(/* swap_fd= */ -1);
+    storage.SetDedupeEnabled(false);
+    CompiledMethod* method1 = CompiledMethod::SwapAllocCompiledMethod(
+        &storage, InstructionSet::kNone, code, vmap_table, {}, {});
+    CompiledMethod* method2 = CompiledMethod::SwapAllocCompiledMethod(
+        &storage, InstructionSet::kNone, code, vmap_table, {}, {});
+    EXPECT_EQ(2u * expected_size, storage.GetAllocatedArrayBytes());
+    CompiledMethod::ReleaseSwapAllocatedCompiledMethod(&storage, method1);
+    EXPECT_EQ(expected_size, storage.GetAllocatedArrayBytes());
+    CompiledMethod::ReleaseSwapAllocatedCompiledMethod(&storage, method2);
+    EXPECT_EQ(0u, storage.GetAllocatedArrayBytes());
+  }
+}
+
 }  // namespace art
@@ -22,6 +22,8 @@
 #include <malloc.h>  // For mallinfo
 #endif
 
+#include <algorithm>
+#include <numeric>
 #include <string_view>
 #include <vector>
 
@@ -265,7 +267,13 @@ CompilerDriver::CompilerDriver(
       parallel_thread_count_(thread_count),
       stats_(new AOTCompilationStats),
       compiled_method_storage_(swap_fd),
-      max_arena_alloc_(0) {
+      compiled_method_memory_budget_(0u),
+      compiled_method_memory_budget_exceeded_(false),
+      max_arena_alloc_(0),
+      compile_time_lock_("compile time lock"),
+      compile_time_us_("Method compile time (us)", /*initial_bucket_width=*/ 50),
+      slowest_method_(nullptr, 0u),
+      slowest_method_ns_(0u) {
   DCHECK(compiler_options_ != nullptr);
 
   compiled_method_storage_.SetDedupeEnabled(compiler_options_->DeduplicateCode());
@@ -399,6 +407,10 @@ static void CompileMethodHarness(
       LOG(WARNING) << "Compilation of " << dex_file.PrettyMethod(method_idx)
                    << " took " << PrettyDuration(duration_ns);
     }
+    // The distribution is only dumped with -verbose:compiler, avoid taking the lock otherwise.
+    if (VLOG_IS_ON(compiler)) {
+      driver->RecordMethodCompileTime(self, method_ref, duration_ns);
+    }
   }
 
   if (compiled_method != nullptr) {
@@ -518,6 +530,8 @@ static void CompileMethodQuick(
          ((access_flags & kAccConstructor) == 0) || ((access_flags & kAccStatic) == 0);
       // Check if we should compile based on the profile.
       compile = compile && ShouldCompileBasedOnProfile(compiler_options, profile_index, method_ref);
+      // Leave the method to the JIT rather than risk being killed for using too much memory.
+      compile = compile && !driver->IsCompiledMethodMemoryBudgetExceeded();
 
       if (compile) {
         // NOTE: if compiler declines to compile this method, it will return null.
@@ -2660,6 +2674,27 @@ void CompilerDriver::InitializeClasses(jobject class_loader,
   }
 }
 
+// Returns the class defs of `dex_file`, ordered by decreasing total size of the code of
+// their methods.
+static std::vector<uint32_t> GetClassDefsByDecreasingCodeSize(const DexFile& dex_file) {
+  std::vector<uint32_t> code_sizes(dex_file.NumClassDefs(), 0u);
+  for (ClassAccessor accessor : dex_file.GetClasses()) {
+    uint32_t code_size = 0u;
+    for (const ClassAccessor::Method& method : accessor.GetMethods()) {
+      code_size += method.GetInstructions().InsnsSizeInCodeUnits();
+    }
+    code_sizes[accessor.GetClassDefIndex()] = code_size;
+  }
+  std::vector<uint32_t> class_def_order(dex_file.NumClassDefs());
+  std::iota(class_def_order.begin(), class_def_order.end(), 0u);
+  std::stable_sort(class_def_order.begin(),
+                   class_def_order.end(),
+                   [&code_sizes](uint32_t lhs, uint32_t rhs) {
+                     return code_sizes[lhs] > code_sizes[rhs];
+                   });
+  return class_def_order;
+}
+
 template <typename CompileFn>
 static void CompileDexFile(CompilerDriver* driver,
                            jobject class_loader,
@@ -2682,7 +2717,16 @@ static void CompileDexFile(CompilerDriver* driver,
       ? compiler_options.GetProfileCompilationInfo()->FindDexFile(dex_file)
       : ProfileCompilationInfo::MaxProfileIndex();
 
-  auto compile = [&context, &compile_fn, profile_index](size_t class_def_index) {
+  // With several threads, compile the classes with the most code first. Otherwise a class
+  // with a huge method (a giant switch, a generated parser) that comes late in the dex file
+  // keeps one thread busy long after the others are done.
+  std::vector<uint32_t> class_def_order;
+  if (thread_count > 1u) {
+    class_def_order = GetClassDefsByDecreasingCodeSize(dex_file);
+  }
+
+  auto compile = [&context, &compile_fn, &class_def_order, profile_index](size_t index) {
+    const size_t class_def_index = class_def_order.empty() ? index : class_def_order[index];
     const DexFile& dex_file = *context.GetDexFile();
     SCOPED_TRACE << "compile " << dex_file.GetLocation() << "@" << class_def_index;
     ClassLinker* class_linker = context.GetClassLinker();
@@ -2778,6 +2822,58 @@ void CompilerDriver::Compile(jobject class_loader,
   }
 
   VLOG(compiler) << "Compile: " << GetMemoryUsageString(false);
+  if (kTimeCompileMethod && VLOG_IS_ON(compiler)) {
+    std::ostringstream oss;
+    DumpCompileTimes(oss);
+    VLOG(compiler) << oss.str();
+  }
+}
+
+void CompilerDriver::RecordMethodCompileTime(Thread* self,
+                                             const MethodReference& method_ref,
+                                             uint64_t duration_ns) {
+  MutexLock mu(self, compile_time_lock_);
+  compile_time_us_.AddValue(NsToUs(duration_ns));
+  if (slowest_method_.dex_file == nullptr || duration_ns > slowest_method_ns_) {
+    slowest_method_ns_ = duration_ns;
+    slowest_method_ = method_ref;
+  }
+}
+
+void CompilerDriver::DumpCompileTimes(std::ostream& os) {
+  MutexLock mu(Thread::Current(), compile_time_lock_);
+  if (compile_time_us_.SampleSize() == 0u) {
+    return;
+  }
+  Histogram<uint64_t>::CumulativeData data;
+  compile_time_us_.CreateHistogram(&data);
+  const uint64_t median_us = static_cast<uint64_t>(compile_time_us_.Percentile(0.5, data));
+  const uint64_t p99_us = static_cast<uint64_t>(compile_time_us_.Percentile(0.99, data));
+  os << "Compiled " << compile_time_us_.SampleSize() << " methods in "
+     << PrettyDuration(UsToNs(compile_time_us_.Sum())) << " of compiler thread time, "
+     << "median " << PrettyDuration(UsToNs(median_us))
+     << ", 99th percentile " << PrettyDuration(UsToNs(p99_us))
+     << ", slowest " << slowest_method_.PrettyMethod()
+     << " took " << PrettyDuration(slowest_method_ns_) << "\n";
+}
+
+bool CompilerDriver::IsCompiledMethodMemoryBudgetExceeded() {
+  if (compiled_method_memory_budget_ == 0u) {
+    return false;
+  }
+  if (compiled_method_memory_budget_exceeded_.load(std::memory_order_relaxed)) {
+    return true;
+  }
+  size_t allocated = compiled_method_storage_.GetAllocatedArrayBytes();
+  if (allocated < compiled_method_memory_budget_) {
+    return false;
+  }
+  if (!compiled_method_memory_budget_exceeded_.exchange(true, std::memory_order_relaxed)) {
+    LOG(WARNING) << "Compiled methods use " << PrettySize(allocated) << ", over the budget of "
+                 << PrettySize(compiled_method_memory_budget_)
+                 << ". Not compiling the remaining methods.";
+  }
+  return true;
 }
 
 void CompilerDriver::AddCompiledMethod(const MethodReference& method_ref,
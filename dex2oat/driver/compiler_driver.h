@@ -26,6 +26,7 @@
 #include "base/array_ref.h"
 #include "base/bit_utils.h"
 #include "base/hash_set.h"
+#include "base/histogram.h"
 #include "base/mutex.h"
 #include "base/os.h"
 #include "base/quasi_atomic.h"
@@ -197,6 +198,14 @@ class CompilerDriver {
     return compiled_method_storage_.DedupeEnabled();
   }
 
+  // Stop compiling methods once the data held for compiled methods reaches `bytes`, leaving
+  // the remaining methods to the interpreter and the JIT. Zero means no limit.
+  void SetCompiledMethodMemoryBudget(size_t bytes) {
+    compiled_method_memory_budget_ = bytes;
+  }
+
+  bool IsCompiledMethodMemoryBudgetExceeded();
+
   // Checks whether profile guided verification is enabled and if the method should be verified
   // according to the profile file.
   bool ShouldVerifyClassBasedOnProfile(const DexFile& dex_file, uint16_t class_idx) const;
@@ -206,6 +215,15 @@ class CompilerDriver {
   // Get memory usage during compilation.
   std::string GetMemoryUsageString(bool extended) const;
 
+  // Record how long the compilation of a method took, for the distribution of compile times.
+  // Only called with -verbose:compiler.
+  void RecordMethodCompileTime(Thread* self,
+                               const MethodReference& method_ref,
+                               uint64_t duration_ns) REQUIRES(!compile_time_lock_);
+
+  // Dump the distribution of method compile times and the slowest method.
+  void DumpCompileTimes(std::ostream& os) REQUIRES(!compile_time_lock_);
+
   void SetHadHardVerifierFailure() {
     had_hard_verifier_failure_ = true;
   }
@@ -324,8 +342,18 @@ class CompilerDriver {
 
   CompiledMethodStorage compiled_method_storage_;
 
+  size_t compiled_method_memory_budget_;
+  std::atomic<bool> compiled_method_memory_budget_exceeded_;
+
   size_t max_arena_alloc_;
 
+  // Distribution of method compile times. The few slowest methods bound the wall clock time
+  // of a parallel compilation.
+  Mutex compile_time_lock_;
+  Histogram<uint64_t> compile_time_us_ GUARDED_BY(compile_time_lock_);
+  MethodReference slowest_method_ GUARDED_BY(compile_time_lock_);
+  uint64_t slowest_method_ns_ GUARDED_BY(compile_time_lock_);
+
   friend class CommonCompilerDriverTest;
   friend class CompileClassVisitor;
   friend class InitializeClassVisitor;
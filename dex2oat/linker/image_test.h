@@ -348,9 +348,12 @@ inline void ImageTest::DoCompile(ImageHeader::StorageMode storage_mode,
       }
     }
 
+    TimingLogger timings("ImageTest::WriteImage", false, false);
     bool success_image = writer->Write(File::kInvalidFd,
                                        image_filenames,
-                                       image_filenames.size());
+                                       image_filenames.size(),
+                                       /*thread_count=*/ 2u,
+                                       &timings);
     ASSERT_TRUE(success_image);
   }
 }
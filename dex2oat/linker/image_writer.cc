@@ -34,6 +34,7 @@
 #include "base/logging.h"  // For VLOG.
 #include "base/pointer_size.h"
 #include "base/stl_util.h"
+#include "base/timing_logger.h"
 #include "base/unix_file/fd_file.h"
 #include "class_linker-inl.h"
 #include "class_root-inl.h"
@@ -88,6 +89,7 @@
 #include "subtype_check.h"
 #include "thread-current-inl.h"  // For AssertOnly1Thread.
 #include "thread_list.h"         // For AssertOnly1Thread.
+#include "thread_pool.h"
 #include "well_known_classes-inl.h"
 
 using ::art::mirror::Class;
@@ -568,6 +570,7 @@ bool ImageWriter::Write(int image_fd,
   Thread* const self = Thread::Current();
   ScopedDebugDisallowReadBarriers sddrb(self);
   {
+    TimingLogger::ScopedTiming t("CopyAndFixupNativeData", timings);
     ScopedObjectAccess soa(self);
     for (size_t i = 0; i < oat_filenames_.size(); ++i) {
       CreateHeader(i, component_count);
@@ -577,16 +580,19 @@ bool ImageWriter::Write(int image_fd,
   }
 
   {
+    TimingLogger::ScopedTiming t("CopyAndFixupObjects", timings);
     // TODO: heap validation can't handle these fix up passes.
-    ScopedObjectAccess soa(self);
     Runtime::Current()->GetHeap()->DisableObjectValidation();
-    CopyAndFixupObjects();
+    CopyAndFixupObjects(thread_count);
   }
 
   if (compiler_options_.IsAppImage()) {
+    TimingLogger::ScopedTiming t("CopyMetadata", timings);
     CopyMetadata();
   }
 
+  TimingLogger::ScopedTiming t("WriteImageFiles", timings);
+
   // Primary image header shall be written last for two reasons. First, this ensures
   // that we shall not end up with a valid primary image and invalid secondary image.
   // Second, its checksum shall include the checksums of the secondary images (XORed).
@@ -3153,7 +3159,8 @@ inline Object* ImageWriter::CopyObject(Object* obj) {
   DCHECK_LT(offset, image_info.image_end_);
   const auto* src = reinterpret_cast<const uint8_t*>(obj);
 
-  bool done = image_info.image_bitmap_.Set(dst);  // Mark the obj as live.
+  // Mark the obj as live. Objects are copied by multiple threads, see `CopyAndFixupObjects()`.
+  bool done = image_info.image_bitmap_.AtomicTestAndSet(dst);
   // Check if the object was already copied, unless the caller indicated that it was not.
   if (kCheckIfDone && done) {
     return nullptr;
@@ -3224,35 +3231,64 @@ class ImageWriter::FixupVisitor {
   mirror::Object* const copy_;
 };
 
-void ImageWriter::CopyAndFixupObjects() {
-  // Copy and fix up pointer arrays first as they require special treatment.
-  auto method_pointer_array_visitor =
-      [&](ObjPtr<mirror::PointerArray> pointer_array) REQUIRES_SHARED(Locks::mutator_lock_) {
-        CopyAndFixupMethodPointerArray(pointer_array.Ptr());
-      };
-  for (ImageInfo& image_info : image_infos_) {
-    if (image_info.class_table_size_ != 0u) {
-      DCHECK(image_info.class_table_.has_value());
-      for (const ClassTable::TableSlot& slot : *image_info.class_table_) {
-        ObjPtr<mirror::Class> klass = slot.Read<kWithoutReadBarrier>();
-        DCHECK(klass != nullptr);
-        // Do not process boot image classes present in app image class table.
-        DCHECK(!IsInBootImage(klass.Ptr()) || compiler_options_.IsAppImage());
-        if (!IsInBootImage(klass.Ptr())) {
-          // Do not fix up method pointer arrays inherited from superclass. If they are part
-          // of the current image, they were or shall be copied when visiting the superclass.
-          VisitNewMethodPointerArrays(klass, method_pointer_array_visitor);
+void ImageWriter::CopyAndFixupObjects(size_t thread_count) {
+  Thread* const self = Thread::Current();
+  std::vector<Object*> objects;
+  {
+    ScopedObjectAccess soa(self);
+    // Copy and fix up pointer arrays first as they require special treatment.
+    auto method_pointer_array_visitor =
+        [&](ObjPtr<mirror::PointerArray> pointer_array) REQUIRES_SHARED(Locks::mutator_lock_) {
+          CopyAndFixupMethodPointerArray(pointer_array.Ptr());
+        };
+    for (ImageInfo& image_info : image_infos_) {
+      if (image_info.class_table_size_ != 0u) {
+        DCHECK(image_info.class_table_.has_value());
+        for (const ClassTable::TableSlot& slot : *image_info.class_table_) {
+          ObjPtr<mirror::Class> klass = slot.Read<kWithoutReadBarrier>();
+          DCHECK(klass != nullptr);
+          // Do not process boot image classes present in app image class table.
+          DCHECK(!IsInBootImage(klass.Ptr()) || compiler_options_.IsAppImage());
+          if (!IsInBootImage(klass.Ptr())) {
+            // Do not fix up method pointer arrays inherited from superclass. If they are part
+            // of the current image, they were or shall be copied when visiting the superclass.
+            VisitNewMethodPointerArrays(klass, method_pointer_array_visitor);
+          }
         }
       }
     }
-  }
 
-  auto visitor = [&](Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
-    DCHECK(obj != nullptr);
-    CopyAndFixupObject(obj);
-  };
-  Runtime::Current()->GetHeap()->VisitObjects(visitor);
+    auto visitor = [&](Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
+      DCHECK(obj != nullptr);
+      if (IsImageBinSlotAssigned(obj)) {
+        objects.push_back(obj);
+      }
+    };
+    Runtime::Current()->GetHeap()->VisitObjects(visitor);
+  }
+
+  // Each object is copied to its own slot in the image and the fixups only read the original
+  // objects and the relocation data computed earlier, so chunks of objects can be processed
+  // in parallel. The image bitmap is shared and uses atomic updates, see `CopyObject()`.
+  static constexpr size_t kObjectsPerTask = 1024u;
+  DCHECK_NE(thread_count, 0u);
+  std::unique_ptr<ThreadPool> thread_pool(
+      ThreadPool::Create("Image writer thread pool", thread_count - 1u));
+  for (size_t begin = 0; begin < objects.size(); begin += kObjectsPerTask) {
+    size_t end = std::min(begin + kObjectsPerTask, objects.size());
+    thread_pool->AddTask(self, new FunctionTask([this, &objects, begin, end](Thread* worker) {
+      ScopedObjectAccess soa(worker);
+      ScopedDebugDisallowReadBarriers sddrb(worker);
+      for (size_t i = begin; i != end; ++i) {
+        CopyAndFixupObject(objects[i]);
+      }
+    }));
+  }
+  thread_pool->StartWorkers(self);
+  thread_pool->Wait(self, /*do_work=*/ true, /*may_hold_locks=*/ false);
+  thread_pool.reset();
 
+  ScopedObjectAccess soa(self);
   // Fill the padding objects since they are required for in order traversal of the image space.
   for (ImageInfo& image_info : image_infos_) {
     for (const size_t start_offset : image_info.padding_offsets_) {
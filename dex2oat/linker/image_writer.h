@@ -153,9 +153,12 @@ class ImageWriter final {
   // the names in image_filenames.
   // If oat_fd is not File::kInvalidFd, then we use that for the oat file. Otherwise we open
   // the names in oat_filenames.
+  // Objects are copied and fixed up using up to `thread_count` threads, including this one.
   bool Write(int image_fd,
              const std::vector<std::string>& image_filenames,
-             size_t component_count)
+             size_t component_count,
+             size_t thread_count,
+             TimingLogger* timings)
       REQUIRES(!Locks::mutator_lock_);
 
   uintptr_t GetOatDataBegin(size_t oat_index) {
@@ -463,7 +466,7 @@ class ImageWriter final {
   // Creates the contiguous image in memory and adjusts pointers.
   void CopyAndFixupNativeData(size_t oat_index) REQUIRES_SHARED(Locks::mutator_lock_);
   void CopyAndFixupJniStubMethods(size_t oat_index) REQUIRES_SHARED(Locks::mutator_lock_);
-  void CopyAndFixupObjects() REQUIRES_SHARED(Locks::mutator_lock_);
+  void CopyAndFixupObjects(size_t thread_count) REQUIRES(!Locks::mutator_lock_);
   void CopyAndFixupObject(mirror::Object* obj) REQUIRES_SHARED(Locks::mutator_lock_);
   template <bool kCheckIfDone>
   mirror::Object* CopyObject(mirror::Object* obj) REQUIRES_SHARED(Locks::mutator_lock_);
@@ -891,6 +891,10 @@ class OatWriter::InitOatClassesMethodVisitor : public DexMethodVisitor {
 //
 // See also OrderedMethodVisitor.
 struct OatWriter::OrderedMethodData {
+  static constexpr uint32_t kHotBit = 1u;
+  static constexpr uint32_t kStartupBit = 2u;
+  static constexpr uint32_t kPostStartupBit = 4u;
+
   uint32_t hotness_bits;
   OatClass* oat_class;
   CompiledMethod* compiled_method;
@@ -910,19 +914,24 @@ struct OatWriter::OrderedMethodData {
     return debug_info_idx != kDebugInfoIdxInvalid;
   }
 
+  bool IsStartup() const {
+    return (hotness_bits & kStartupBit) != 0u;
+  }
+
   // Bin each method according to the profile flags.
   //
-  // Groups by e.g.
+  // Groups by
   //  -- not hot at all
   //  -- hot
-  //  -- hot and startup
+  //  -- post-startup
   //  -- hot and post-startup
-  //  -- hot and startup and poststartup
   //  -- startup
+  //  -- hot and startup
   //  -- startup and post-startup
-  //  -- post-startup
+  //  -- hot and startup and post-startup
   //
-  // (See MethodHotness enum definition for up-to-date binning order.)
+  // All startup methods are kept adjacent so that the runtime can read their
+  // code ahead with a single range, see OatHeader::GetStartupCodeOffset().
   bool operator<(const OrderedMethodData& other) const {
     if (kOatWriterForceOatCodeLayout) {
       // Development flag: Override default behavior by sorting by name.
@@ -933,6 +942,9 @@ struct OatWriter::OrderedMethodData {
     }
 
     // Use the profile's method hotness to determine sort order.
+    if (IsStartup() != other.IsStartup()) {
+      return other.IsStartup();
+    }
     if (hotness_bits < other.hotness_bits) {
       return true;
     }
@@ -1056,12 +1068,13 @@ class OatWriter::LayoutCodeMethodVisitor final : public OatDexMethodVisitor {
       if (profile_index_ != ProfileCompilationInfo::MaxProfileIndex()) {
         ProfileCompilationInfo* pci = writer_->profile_compilation_info_;
         DCHECK(pci != nullptr);
-        // Note: Bin-to-bin order does not matter. If the kernel does or does not read-ahead
-        // any memory, it only goes into the buffer cache and does not grow the PSS until the
-        // first time that memory is referenced in the process.
-        constexpr uint32_t kHotBit = 1u;
-        constexpr uint32_t kStartupBit = 2u;
-        constexpr uint32_t kPostStartupBit = 4u;
+        // Note: Apart from startup methods, which are read ahead on load, bin-to-bin order
+        // does not matter. If the kernel does or does not read-ahead any memory, it only goes
+        // into the buffer cache and does not grow the PSS until the first time that memory
+        // is referenced in the process.
+        constexpr uint32_t kHotBit = OrderedMethodData::kHotBit;
+        constexpr uint32_t kStartupBit = OrderedMethodData::kStartupBit;
+        constexpr uint32_t kPostStartupBit = OrderedMethodData::kPostStartupBit;
         hotness_bits =
             (pci->IsHotMethod(profile_index_, method_index) ? kHotBit : 0u) |
             (pci->IsStartupMethod(profile_index_, method_index) ? kStartupBit : 0u) |
@@ -1218,6 +1231,12 @@ class OatWriter::LayoutReserveOffsetCodeMethodVisitor : public OrderedMethodVisi
       // Update offsets. (Checksum is updated when writing.)
       offset_ += sizeof(*method_header);  // Method header is prepended before code.
       offset_ += code_size;
+      if (method_data.IsStartup()) {
+        if (startup_code_end_ == 0u) {
+          startup_code_begin_ = code_offset - sizeof(*method_header);
+        }
+        startup_code_end_ = offset_;
+      }
     }
 
     // Exclude dex methods without native code.
@@ -1261,6 +1280,15 @@ class OatWriter::LayoutReserveOffsetCodeMethodVisitor : public OrderedMethodVisi
     return offset_;
   }
 
+  // Range of the code of startup methods, see OrderedMethodData.
+  size_t GetStartupCodeBegin() const {
+    return startup_code_begin_;
+  }
+
+  size_t GetStartupCodeEnd() const {
+    return startup_code_end_;
+  }
+
  private:
   LayoutReserveOffsetCodeMethodVisitor(OatWriter* writer,
                                        size_t offset,
@@ -1273,7 +1301,9 @@ class OatWriter::LayoutReserveOffsetCodeMethodVisitor : public OrderedMethodVisi
         executable_offset_(writer->oat_header_->GetExecutableOffset()),
         debuggable_(compiler_options.GetDebuggable()),
         native_debuggable_(compiler_options.GetNativeDebuggable()),
-        generate_debug_info_(compiler_options.GenerateAnyDebugInfo()) {}
+        generate_debug_info_(compiler_options.GenerateAnyDebugInfo()),
+        startup_code_begin_(0u),
+        startup_code_end_(0u) {}
 
   struct CodeOffsetsKeyComparator {
     bool operator()(const CompiledMethod* lhs, const CompiledMethod* rhs) const {
@@ -1320,6 +1350,10 @@ class OatWriter::LayoutReserveOffsetCodeMethodVisitor : public OrderedMethodVisi
   const bool debuggable_;
   const bool native_debuggable_;
   const bool generate_debug_info_;
+
+  // Range of the code of startup methods. Empty if there are none.
+  size_t startup_code_begin_;
+  size_t startup_code_end_;
 };
 
 template <bool kDeduplicate>
@@ -2330,6 +2364,10 @@ size_t OatWriter::InitOatCodeDexFiles(size_t offset) {
     success = layout_reserve_code_visitor.Visit();
     DCHECK(success);
     offset = layout_reserve_code_visitor.GetOffset();
+    oat_header_->SetStartupCodeRange(
+        dchecked_integral_cast<uint32_t>(layout_reserve_code_visitor.GetStartupCodeBegin()),
+        dchecked_integral_cast<uint32_t>(layout_reserve_code_visitor.GetStartupCodeEnd() -
+                                         layout_reserve_code_visitor.GetStartupCodeBegin()));
 
     // Save the method order because the WriteCodeMethodVisitor will need this
     // order again.
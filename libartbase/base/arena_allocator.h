@@ -238,6 +238,9 @@ class ArenaPool {
   virtual void LockReclaimMemory() = 0;
   // Trim the maps in arenas by madvising, used by JIT to reduce memory usage.
   virtual void TrimMaps() = 0;
+  // Like TrimMaps(), but keeps the most recently freed arenas populated for up to
+  // `retained_bytes` of their memory, so that the next allocations do not fault it in again.
+  virtual void TrimMapsAbove(size_t retained_bytes) = 0;
 
  protected:
   ArenaPool() = default;
@@ -24,6 +24,7 @@
 #include <type_traits>
 #include <unordered_map>
 
+#include "base/array_ref.h"
 #include "base/bit_memory_region.h"
 #include "base/casts.h"
 #include "base/iteration_range.h"
@@ -307,8 +308,11 @@ class BitTableBuilderBase {
   // Append given list of values and return the index of the first value.
   // If the exact same set of values was already added, return the old index.
   uint32_t Dedup(Entry* values, size_t count = 1) {
-    FNVHash<MemoryRegion> hasher;
-    uint32_t hash = hasher(MemoryRegion(values, sizeof(Entry) * count));
+    // Hash whole column values rather than individual bytes.
+    static_assert(sizeof(Entry) == sizeof(uint32_t) * kNumColumns);
+    FNVHash<ArrayRef<const uint32_t>> hasher;
+    uint32_t hash = hasher(
+        ArrayRef<const uint32_t>(reinterpret_cast<const uint32_t*>(values), kNumColumns * count));
 
     // Check if we have already added identical set of values.
     auto range = dedup_.equal_range(hash);
@@ -169,19 +169,25 @@ TEST(BitTableTest, TestCollisions) {
   ArenaStack arena_stack(&pool);
   ScopedArenaAllocator allocator(&arena_stack);
   FNVHash<MemoryRegion> hasher;
+  FNVHash<ArrayRef<const uint32_t>> word_hasher;
 
-  BitTableBuilderBase<2>::Entry value0{56948505, 0};
-  BitTableBuilderBase<2>::Entry value1{67108869, 0};
+  // Rows are hashed by column values.
+  BitTableBuilderBase<2>::Entry row0{0, 0};
+  BitTableBuilderBase<2>::Entry row1{1, 16778899};
 
   BitTableBuilderBase<2> builder(&allocator);
-  EXPECT_EQ(hasher(MemoryRegion(&value0, sizeof(value0))),
-            hasher(MemoryRegion(&value1, sizeof(value1))));
-  EXPECT_EQ(0u, builder.Dedup(&value0));
-  EXPECT_EQ(1u, builder.Dedup(&value1));
-  EXPECT_EQ(0u, builder.Dedup(&value0));
-  EXPECT_EQ(1u, builder.Dedup(&value1));
+  EXPECT_EQ(word_hasher(ArrayRef<const uint32_t>(&row0[0], 2u)),
+            word_hasher(ArrayRef<const uint32_t>(&row1[0], 2u)));
+  EXPECT_EQ(0u, builder.Dedup(&row0));
+  EXPECT_EQ(1u, builder.Dedup(&row1));
+  EXPECT_EQ(0u, builder.Dedup(&row0));
+  EXPECT_EQ(1u, builder.Dedup(&row1));
   EXPECT_EQ(2u, builder.size());
 
+  // Bitmaps are hashed by bytes.
+  BitTableBuilderBase<2>::Entry value0{56948505, 0};
+  BitTableBuilderBase<2>::Entry value1{67108869, 0};
+
   BitmapTableBuilder builder2(&allocator);
   EXPECT_EQ(hasher(MemoryRegion(&value0, BitsToBytesRoundUp(MinimumBitsToStore(value0[0])))),
             hasher(MemoryRegion(&value1, BitsToBytesRoundUp(MinimumBitsToStore(value1[0])))));
@@ -67,6 +67,12 @@ static inline bool DecodeLeb128Helper(const uint8_t** data,
 template <typename T = uint32_t>
 static inline T DecodeUnsignedLeb128(const uint8_t** data) {
   static_assert(!std::is_signed_v<T>);
+  // Fast path for values below 128, which make up most of the class data and debug info.
+  const uint8_t first = **data;
+  if (LIKELY(first <= 0x7f)) {
+    ++*data;
+    return first;
+  }
   T value = 0;
   DecodeLeb128Helper(data, std::nullopt, &value);
   return value;
@@ -34,6 +34,7 @@ class MallocArenaPool final : public ArenaPool {
   void LockReclaimMemory() override;
   // Is a nop for malloc pools.
   void TrimMaps() override;
+  void TrimMapsAbove([[maybe_unused]] size_t retained_bytes) override {}
 
  private:
   Arena* free_arenas_;
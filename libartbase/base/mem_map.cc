@@ -871,6 +871,15 @@ int MemMap::MadviseDontFork() {
   return -1;
 }
 
+int MemMap::MadviseHugePages() {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (base_begin_ != nullptr || base_size_ != 0) {
+    return madvise(base_begin_, base_size_, MADV_HUGEPAGE);
+  }
+#endif
+  return -1;
+}
+
 bool MemMap::Sync() {
 #ifdef _WIN32
   // TODO: add FlushViewOfFile support.
@@ -1266,6 +1275,12 @@ void MemMap::TryReadable() {
   }
 }
 
+size_t GetHugePageSize() {
+  // A PMD maps as many pages as a page holds 64-bit page table entries.
+  const size_t page_size = MemMap::GetPageSize();
+  return page_size * (page_size / sizeof(uint64_t));
+}
+
 static void inline RawClearMemory(uint8_t* begin, uint8_t* end) {
   std::fill(begin, end, 0);
 }
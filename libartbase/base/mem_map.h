@@ -257,6 +257,9 @@ class MemMap {
     FillWithZero(/* release_eagerly= */ true);
   }
   int MadviseDontFork();
+  // Ask the kernel to back the map with transparent huge pages. Returns -1 on failure or when
+  // unsupported.
+  int MadviseHugePages();
 
   int GetProtect() const {
     return prot_;
@@ -465,6 +468,9 @@ inline void swap(MemMap& lhs, MemMap& rhs) {
 
 std::ostream& operator<<(std::ostream& os, const MemMap& mem_map);
 
+// Size of a PMD-mapped transparent huge page for the current page size, e.g. 2MB for 4KB pages.
+size_t GetHugePageSize();
+
 // Zero and maybe release memory if possible, no requirements on alignments.
 void ZeroMemory(void* address, size_t length, bool release_eagerly);
 inline void ZeroAndReleaseMemory(void* address, size_t length) {
@@ -890,6 +890,26 @@ TEST_F(MemMapTest, Reservation) {
   ASSERT_FALSE(map2.IsValid());
 }
 
+TEST_F(MemMapTest, HugePages) {
+  CommonInit();
+  const size_t huge_page_size = GetHugePageSize();
+  ASSERT_TRUE(IsAlignedParam(huge_page_size, MemMap::GetPageSize()));
+  ASSERT_GT(huge_page_size, MemMap::GetPageSize());
+  std::string error_msg;
+  MemMap map = MemMap::MapAnonymous("MemMapTest_HugePagesTest_map",
+                                    2 * huge_page_size,
+                                    PROT_READ | PROT_WRITE,
+                                    /*low_4gb=*/ false,
+                                    &error_msg);
+  ASSERT_TRUE(map.IsValid()) << error_msg;
+  map.AlignBy(huge_page_size, /*align_both_ends=*/ false);
+  ASSERT_TRUE(IsAlignedParam(map.Begin(), huge_page_size));
+  // The kernel may not support transparent huge pages; the advice must not affect the contents.
+  map.MadviseHugePages();
+  memset(map.Begin(), 0xAB, map.Size());
+  EXPECT_EQ(map.Begin()[map.Size() - 1], 0xAB);
+}
+
 }  // namespace art
 
 namespace {
@@ -55,6 +55,18 @@
   METRIC(FullGcTracingThroughputAvg, MetricsAverage)                \
   METRIC(JitMethodCompileTotalTime, MetricsCounter)                 \
   METRIC(JitMethodCompileCount, MetricsCounter)                     \
+  METRIC(JitRecompilationCount, MetricsCounter)                     \
+  METRIC(JitThrottledTime, MetricsCounter)                          \
+  METRIC(JitOsrEntryCount, MetricsCounter)                          \
+  METRIC(JitDeoptimizationCount, MetricsCounter)                    \
+  METRIC(DeoptimizationCount, MetricsCounter)                       \
+  METRIC(DeoptimizationTotalTime, MetricsCounter)                   \
+  METRIC(ChaInvalidatedCodeCount, MetricsCounter)                   \
+  METRIC(ChaCheckpointCount, MetricsCounter)                        \
+  METRIC(JitSpeculationDisabledCount, MetricsCounter)               \
+  METRIC(HeapTrimCount, MetricsCounter)                             \
+  METRIC(HeapTrimReclaimedBytes, MetricsCounter)                    \
+  METRIC(HeapTrimTotalTime, MetricsCounter)                         \
   METRIC(YoungGcCollectionTime, MetricsHistogram, 15, 0, 60'000)    \
   METRIC(FullGcCollectionTime, MetricsHistogram, 15, 0, 60'000)     \
   METRIC(YoungGcThroughput, MetricsHistogram, 15, 0, 10'000)        \
@@ -68,7 +80,12 @@
   METRIC(YoungGcDuration, MetricsCounter)                           \
   METRIC(FullGcScannedBytes, MetricsCounter)                        \
   METRIC(FullGcFreedBytes, MetricsCounter)                          \
-  METRIC(FullGcDuration, MetricsCounter)
+  METRIC(FullGcDuration, MetricsCounter)                            \
+  METRIC(YoungObjectSurvivalRate, MetricsHistogram, 20, 0, 100)     \
+  METRIC(ThreadSuspendAllTime, MetricsHistogram, 15, 0, 10'000)     \
+  METRIC(JitOsrQueueTime, MetricsHistogram, 15, 0, 10'000)          \
+  METRIC(JitBaselineQueueTime, MetricsHistogram, 15, 0, 10'000)     \
+  METRIC(JitOptimizedQueueTime, MetricsHistogram, 15, 0, 10'000)
 
 // Increasing counter metrics, reported as Value Metrics in delta increments.
 #define ART_VALUE_METRICS(METRIC)                              \
@@ -654,15 +654,14 @@ bool DexFileVerifier::CheckHeader() {
     return false;
   }
 
-  // Compute and verify the checksum in the header.
-  uint32_t adler_checksum = dex_file_->CalculateChecksum();
-  if (adler_checksum != header_->checksum_) {
-    if (verify_checksum_) {
+  // Compute and verify the checksum in the header. This reads the whole file, so
+  // skip it when the caller does not want it checked; the structural checks below
+  // do not depend on it.
+  if (verify_checksum_) {
+    uint32_t adler_checksum = dex_file_->CalculateChecksum();
+    if (adler_checksum != header_->checksum_) {
       ErrorStringPrintf("Bad checksum (%08x, expected %08x)", adler_checksum, header_->checksum_);
       return false;
-    } else {
-      LOG(WARNING) << StringPrintf(
-          "Ignoring bad checksum (%08x, expected %08x)", adler_checksum, header_->checksum_);
     }
   }
 
@@ -49,9 +49,23 @@ size_t CountModifiedUtf8Chars(const char* utf8) {
  */
 size_t CountModifiedUtf8Chars(const char* utf8, size_t byte_count) {
   DCHECK_LE(byte_count, strlen(utf8));
+  static constexpr uint64_t kHighBits = UINT64_C(0x8080808080808080);
   size_t len = 0;
   const char* end = utf8 + byte_count;
   for (; utf8 < end; ++utf8) {
+    // Skip runs of one-byte encodings a word at a time.
+    while (static_cast<size_t>(end - utf8) >= sizeof(uint64_t)) {
+      uint64_t word;
+      memcpy(&word, utf8, sizeof(uint64_t));
+      if ((word & kHighBits) != 0u) {
+        break;
+      }
+      utf8 += sizeof(uint64_t);
+      len += sizeof(uint64_t);
+    }
+    if (utf8 == end) {
+      break;
+    }
     int ic = *utf8;
     len++;
     if (LIKELY((ic & 0x80) == 0)) {
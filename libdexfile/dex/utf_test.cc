@@ -16,7 +16,9 @@
 
 #include "utf.h"
 
+#include <iterator>
 #include <map>
+#include <string>
 #include <vector>
 
 #include <android-base/stringprintf.h>
@@ -115,6 +117,23 @@ TEST_F(UtfTest, CountModifiedUtf8Chars) {
   EXPECT_EQ(2u, CountModifiedUtf8Chars(reinterpret_cast<const char *>(kSurrogateEncoding)));
 }
 
+TEST_F(UtfTest, CountModifiedUtf8CharsMixedWithAsciiRuns) {
+  // Place a multi-byte sequence at every offset within and around runs of ASCII characters
+  // long enough to be counted a word at a time.
+  const std::string multi_byte_sequences[] = {"\xc2\xa9", "\xe2\x82\xac", "\xf0\x90\x90\x80"};
+  const size_t multi_byte_chars[] = {1u, 1u, 2u};
+  for (size_t i = 0; i != std::size(multi_byte_sequences); ++i) {
+    for (size_t prefix = 0; prefix != 20u; ++prefix) {
+      std::string utf8 = std::string(prefix, 'a') + multi_byte_sequences[i] + std::string(17u, 'b');
+      EXPECT_EQ(prefix + multi_byte_chars[i] + 17u, CountModifiedUtf8Chars(utf8.c_str()))
+          << "prefix=" << prefix << " sequence=" << i;
+      EXPECT_EQ(prefix + multi_byte_chars[i] + 17u,
+                CountModifiedUtf8Chars(utf8.c_str(), utf8.size()))
+          << "prefix=" << prefix << " sequence=" << i;
+    }
+  }
+}
+
 static void AssertConversion(const std::vector<uint16_t>& input,
                              const std::vector<uint8_t>& expected) {
   ASSERT_EQ(expected.size(), CountModifiedUtf8BytesInUtf16(&input[0], input.size()));
@@ -484,8 +484,13 @@ class OatDumper {
                            GetQuickToInterpreterBridgeOffset);
     DUMP_OAT_HEADER_OFFSET("NTERP_TRAMPOLINE",
                            GetNterpTrampolineOffset);
+    DUMP_OAT_HEADER_OFFSET("STARTUP CODE",
+                           GetStartupCodeOffset);
 #undef DUMP_OAT_HEADER_OFFSET
 
+    os << "STARTUP CODE SIZE:\n";
+    os << StringPrintf("0x%08x\n\n", oat_header.GetStartupCodeSize());
+
     // Print the key-value store.
     {
       os << "KEY VALUE STORE:\n";
@@ -710,7 +715,8 @@ class OatDumper {
 
         // inspired by DumpOatMethod
         for (const ClassAccessor::Method& method : accessor.GetMethods()) {
-          uint32_t code_offset = oat_class.GetOatMethod(class_method_index).GetCodeOffset();
+          const OatFile::OatMethod oat_method = oat_class.GetOatMethod(class_method_index);
+          uint32_t code_offset = oat_method.GetCodeOffset();
           class_method_index++;
 
           uint32_t dex_method_idx = method.GetIndex();
@@ -721,9 +727,10 @@ class OatDumper {
 
           std::string pretty_method = dex_file->PrettyMethod(dex_method_idx, true);
 
-          os << StringPrintf("{\"method\":\"%s\",\"offset\":\"0x%08zx\"}\n",
+          os << StringPrintf("{\"method\":\"%s\",\"offset\":\"0x%08zx\",\"code_size\":%u}\n",
                              pretty_method.c_str(),
-                             AdjustOffset(code_offset));
+                             AdjustOffset(code_offset),
+                             oat_method.GetQuickCodeSize());
         }
       }
     }
@@ -3362,7 +3369,8 @@ Options:
         "      Example: --method-filter=foo\n"
         "\n"
         "  --dump-method-and-offset-as-json: dumps fully qualified method names and\n"
-        "                                    signatures ONLY, in a standard json format.\n"
+        "                                    signatures ONLY, in a standard json format,\n"
+        "                                    together with their code offset and size.\n"
         "      Example: --dump-method-and-offset-as-json\n"
         "\n"
         "  --export-dex-to=<directory>: may be used to export oat embedded dex files.\n"
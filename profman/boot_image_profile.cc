@@ -16,8 +16,11 @@
 
 #include "boot_image_profile.h"
 
+#include <algorithm>
 #include <memory>
 #include <set>
+#include <utility>
+#include <vector>
 
 #include "android-base/file.h"
 #include "dex/class_accessor-inl.h"
@@ -258,6 +261,23 @@ bool GenerateBootImageProfile(
     }
   }
 
+  if (options.preloaded_classes_max_count != 0u &&
+      preloaded_classes.size() > options.preloaded_classes_max_count) {
+    // Keep the classes used by the most profiles. Ties are broken by name to keep
+    // the output deterministic.
+    std::vector<std::pair<size_t, std::string>> ranked;
+    ranked.reserve(preloaded_classes.size());
+    for (const auto& it : preloaded_classes) {
+      ranked.emplace_back(it.second.GetAnnotations().size(), it.first);
+    }
+    std::sort(ranked.begin(), ranked.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.first != rhs.first ? lhs.first > rhs.first : lhs.second < rhs.second;
+    });
+    for (size_t i = options.preloaded_classes_max_count; i != ranked.size(); ++i) {
+      preloaded_classes.erase(ranked[i].second);
+    }
+  }
+
   // Create the output content
   std::string profile_content;
   std::string preloaded_content;
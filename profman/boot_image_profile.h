@@ -67,6 +67,11 @@ struct BootImageOptions {
 
   // The set of classes that should not be preloaded in Zygote
   std::set<std::string> preloaded_classes_denylist;
+
+  // The maximum number of preloaded classes, 0 for no limit. When more classes pass the
+  // preloaded threshold, the ones used by the most profiles are kept. This allows trading
+  // Zygote memory against startup time with a fixed budget.
+  uint32_t preloaded_classes_max_count = 0;
 };
 
 // Generate a boot image profile according to the specified options.
@@ -16,7 +16,12 @@
 
 #include "profile_assistant.h"
 
+#include <algorithm>
+#include <memory>
+#include <thread>
+
 #include "base/os.h"
+#include "base/time_utils.h"
 #include "base/unix_file/fd_file.h"
 #include "profman/profman_result.h"
 
@@ -50,28 +55,18 @@ ProfmanResult::ProcessingResult ProfileAssistant::ProcessProfilesInternal(
   uint32_t number_of_classes = info.GetNumberOfResolvedClasses();
 
   // Merge all current profiles.
-  for (size_t i = 0; i < profile_files.size(); i++) {
-    ProfileCompilationInfo cur_info(options.IsBootImageMerge());
-    if (!cur_info.Load(profile_files[i]->Fd(), /*merge_classes=*/ true, filter_fn)) {
-      LOG(WARNING) << "Could not load profile file at index " << i;
-      if (options.IsForceMerge() || options.IsForceMergeAndAnalyze()) {
-        // If we have to merge forcefully, ignore load failures.
-        // This is useful for boot image profiles to ignore stale profiles which are
-        // cleared lazily.
-        continue;
-      }
-      // TODO: Do we really need to use a different error code for version mismatch?
-      ProfileCompilationInfo wrong_info(!options.IsBootImageMerge());
-      if (wrong_info.Load(profile_files[i]->Fd(), /*merge_classes=*/ true, filter_fn)) {
-        return ProfmanResult::kErrorDifferentVersions;
-      }
-      return ProfmanResult::kErrorBadProfiles;
-    }
-
-    if (!info.MergeWith(cur_info)) {
-      LOG(WARNING) << "Could not merge profile file at index " << i;
-      return ProfmanResult::kErrorBadProfiles;
-    }
+  ProfmanResult::ProcessingResult merge_result;
+  if (options.GetMergeThreads() > 1u && profile_files.size() > 1u) {
+    merge_result = MergeProfilesInParallel(profile_files, filter_fn, options, &info);
+  } else {
+    merge_result = MergeProfiles(ArrayRef<const ScopedFlock>(profile_files),
+                                 /*first_index=*/ 0u,
+                                 filter_fn,
+                                 options,
+                                 &info);
+  }
+  if (merge_result != ProfmanResult::kSuccess) {
+    return merge_result;
   }
 
   // If we perform a forced merge do not analyze the difference between profiles.
@@ -119,6 +114,89 @@ ProfmanResult::ProcessingResult ProfileAssistant::ProcessProfilesInternal(
   return options.IsForceMerge() ? ProfmanResult::kSuccess : ProfmanResult::kCompile;
 }
 
+ProfmanResult::ProcessingResult ProfileAssistant::MergeProfiles(
+    ArrayRef<const ScopedFlock> profile_files,
+    size_t first_index,
+    const ProfileCompilationInfo::ProfileLoadFilterFn& filter_fn,
+    const Options& options,
+    /*inout*/ ProfileCompilationInfo* info) {
+  for (size_t i = 0; i < profile_files.size(); i++) {
+    const size_t index = first_index + i;
+    ProfileCompilationInfo cur_info(options.IsBootImageMerge());
+    if (!cur_info.Load(profile_files[i]->Fd(), /*merge_classes=*/ true, filter_fn)) {
+      LOG(WARNING) << "Could not load profile file at index " << index;
+      if (options.IsForceMerge() || options.IsForceMergeAndAnalyze()) {
+        // If we have to merge forcefully, ignore load failures.
+        // This is useful for boot image profiles to ignore stale profiles which are
+        // cleared lazily.
+        continue;
+      }
+      // TODO: Do we really need to use a different error code for version mismatch?
+      ProfileCompilationInfo wrong_info(!options.IsBootImageMerge());
+      if (wrong_info.Load(profile_files[i]->Fd(), /*merge_classes=*/ true, filter_fn)) {
+        return ProfmanResult::kErrorDifferentVersions;
+      }
+      return ProfmanResult::kErrorBadProfiles;
+    }
+
+    if (!info->MergeWith(cur_info)) {
+      LOG(WARNING) << "Could not merge profile file at index " << index;
+      return ProfmanResult::kErrorBadProfiles;
+    }
+  }
+  return ProfmanResult::kSuccess;
+}
+
+ProfmanResult::ProcessingResult ProfileAssistant::MergeProfilesInParallel(
+    const std::vector<ScopedFlock>& profile_files,
+    const ProfileCompilationInfo::ProfileLoadFilterFn& filter_fn,
+    const Options& options,
+    /*inout*/ ProfileCompilationInfo* info) {
+  uint64_t start_ns = NanoTime();
+  const size_t num_threads = std::min<size_t>(options.GetMergeThreads(), profile_files.size());
+  std::vector<std::unique_ptr<ProfileCompilationInfo>> partial_infos(num_threads);
+  std::vector<ProfmanResult::ProcessingResult> results(num_threads, ProfmanResult::kSuccess);
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (size_t t = 0; t != num_threads; ++t) {
+    // Each thread merges a contiguous range of the profiles, so that the error returned for the
+    // first failing thread is the one a sequential merge would return.
+    size_t begin = profile_files.size() * t / num_threads;
+    size_t end = profile_files.size() * (t + 1u) / num_threads;
+    partial_infos[t] = std::make_unique<ProfileCompilationInfo>(options.IsBootImageMerge());
+    threads.emplace_back([&, t, begin, end]() {
+      ArrayRef<const ScopedFlock> files(profile_files);
+      results[t] = MergeProfiles(files.SubArray(begin, end - begin),
+                                 begin,
+                                 filter_fn,
+                                 options,
+                                 partial_infos[t].get());
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t t = 0; t != num_threads; ++t) {
+    if (results[t] != ProfmanResult::kSuccess) {
+      return results[t];
+    }
+    if (!info->MergeWith(*partial_infos[t])) {
+      LOG(WARNING) << "Could not merge profile files starting at index "
+                   << profile_files.size() * t / num_threads;
+      return ProfmanResult::kErrorBadProfiles;
+    }
+    partial_infos[t].reset();
+  }
+
+  uint64_t merge_time_ns = NanoTime() - start_ns;
+  LOG(INFO) << "Merged " << profile_files.size() << " profiles using " << num_threads
+            << " threads in " << PrettyDuration(merge_time_ns) << " ("
+            << profile_files.size() * 1000000000u / std::max<uint64_t>(merge_time_ns, 1u)
+            << " profiles/s)";
+  return ProfmanResult::kSuccess;
+}
+
 class ScopedFlockList {
  public:
   explicit ScopedFlockList(size_t size) : flocks_(size) {}
@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 
+#include "base/array_ref.h"
 #include "base/scoped_flock.h"
 #include "profile/profile_compilation_info.h"
 #include "profman/profman_result.h"
@@ -34,6 +35,7 @@ class ProfileAssistant {
     static constexpr bool kBootImageMergeDefault = false;
     static constexpr uint32_t kMinNewMethodsPercentChangeForCompilation = 2;
     static constexpr uint32_t kMinNewClassesPercentChangeForCompilation = 2;
+    static constexpr uint32_t kMergeThreadsDefault = 1;
 
     Options()
         : force_merge_(kForceMergeDefault),
@@ -42,7 +44,8 @@ class ProfileAssistant {
           min_new_methods_percent_change_for_compilation_(
               kMinNewMethodsPercentChangeForCompilation),
           min_new_classes_percent_change_for_compilation_(
-              kMinNewClassesPercentChangeForCompilation) {
+              kMinNewClassesPercentChangeForCompilation),
+          merge_threads_(kMergeThreadsDefault) {
     }
 
     // Only for S and T uses. U+ should use `IsForceMergeAndAnalyze`.
@@ -55,6 +58,7 @@ class ProfileAssistant {
     uint32_t GetMinNewClassesPercentChangeForCompilation() const {
         return min_new_classes_percent_change_for_compilation_;
     }
+    uint32_t GetMergeThreads() const { return merge_threads_; }
 
     void SetForceMerge(bool value) { force_merge_ = value; }
     void SetForceMergeAndAnalyze(bool value) { force_merge_and_analyze_ = value; }
@@ -65,6 +69,7 @@ class ProfileAssistant {
     void SetMinNewClassesPercentChangeForCompilation(uint32_t value) {
       min_new_classes_percent_change_for_compilation_ = value;
     }
+    void SetMergeThreads(uint32_t value) { merge_threads_ = value; }
 
    private:
     // If true, performs a forced merge, without analyzing if there is a significant difference
@@ -81,6 +86,9 @@ class ProfileAssistant {
     bool boot_image_merge_;
     uint32_t min_new_methods_percent_change_for_compilation_;
     uint32_t min_new_classes_percent_change_for_compilation_;
+    // The number of threads used to load and merge the current profiles. Each thread merges
+    // a contiguous range of the profiles, then the partial results are merged in order.
+    uint32_t merge_threads_;
   };
 
   // Process the profile information present in the given files. Returns one of
@@ -119,6 +127,19 @@ class ProfileAssistant {
       const ProfileCompilationInfo::ProfileLoadFilterFn& filter_fn,
       const Options& options);
 
+  static ProfmanResult::ProcessingResult MergeProfiles(
+      ArrayRef<const ScopedFlock> profile_files,
+      size_t first_index,
+      const ProfileCompilationInfo::ProfileLoadFilterFn& filter_fn,
+      const Options& options,
+      /*inout*/ ProfileCompilationInfo* info);
+
+  static ProfmanResult::ProcessingResult MergeProfilesInParallel(
+      const std::vector<ScopedFlock>& profile_files,
+      const ProfileCompilationInfo::ProfileLoadFilterFn& filter_fn,
+      const Options& options,
+      /*inout*/ ProfileCompilationInfo* info);
+
   DISALLOW_COPY_AND_ASSIGN(ProfileAssistant);
 };
 
@@ -590,6 +590,47 @@ TEST_F(ProfileAssistantTest, AdviseCompilationNonEmptyReferences) {
   CheckProfileInfo(profile2, info2);
 }
 
+TEST_F(ProfileAssistantTest, AdviseCompilationParallelMerge) {
+  ScratchFile profile1;
+  ScratchFile profile2;
+  ScratchFile profile3;
+  ScratchFile reference_profile;
+
+  std::vector<int> profile_fds({
+      GetFd(profile1),
+      GetFd(profile2),
+      GetFd(profile3)});
+  int reference_profile_fd = GetFd(reference_profile);
+
+  const uint16_t kNumberOfMethodsToEnableCompilation = 100;
+  ProfileCompilationInfo info1;
+  SetupProfile(dex1, dex2, kNumberOfMethodsToEnableCompilation, 0, profile1, &info1);
+  ProfileCompilationInfo info2;
+  SetupProfile(dex3, dex4, kNumberOfMethodsToEnableCompilation, 0, profile2, &info2);
+  ProfileCompilationInfo info3;
+  SetupProfile(dex1, dex2, kNumberOfMethodsToEnableCompilation, 0, profile3,
+      &info3, kNumberOfMethodsToEnableCompilation / 2);
+
+  // We should advise compilation.
+  ASSERT_EQ(ProfmanResult::kCompile,
+            ProcessProfiles(profile_fds, reference_profile_fd, {"--merge-parallel=2"}));
+
+  // The resulting compilation info must be equal to the merge of the inputs.
+  ProfileCompilationInfo result;
+  ASSERT_TRUE(result.Load(reference_profile_fd));
+
+  ProfileCompilationInfo expected;
+  ASSERT_TRUE(expected.MergeWith(info1));
+  ASSERT_TRUE(expected.MergeWith(info2));
+  ASSERT_TRUE(expected.MergeWith(info3));
+  ASSERT_TRUE(expected.Equals(result));
+
+  // The information from profiles must remain the same.
+  CheckProfileInfo(profile1, info1);
+  CheckProfileInfo(profile2, info2);
+  CheckProfileInfo(profile3, info3);
+}
+
 TEST_F(ProfileAssistantTest, DoNotAdviseCompilationEmptyProfile) {
   ScratchFile profile1;
   ScratchFile profile2;
@@ -1076,6 +1117,70 @@ TEST_F(ProfileAssistantTest, TestBootImageProfileWith2RawProfiles) {
   ASSERT_EQ(output_profile_contents, expected_profile_content);
 }
 
+TEST_F(ProfileAssistantTest, TestBootImageProfileWithPreloadedClassesMaxCount) {
+  const std::string core_dex = GetLibCoreDexFileNames()[0];
+
+  const std::string kClassUsedBy3 = "Ljava/lang/Object;";
+  const std::string kClassUsedBy2 = "Ljava/lang/CharSequence;";
+  const std::string kOtherClassUsedBy2 = "Ljava/lang/Comparable;";
+  const std::string kClassUsedBy1 = "Ljava/lang/Process;";
+
+  // Every class passes the preloaded threshold.
+  static const size_t kPreloadedThreshold = 10;
+  static const size_t kPreloadedMaxCount = 2;
+
+  std::vector<std::string> input_data = {
+      "{dex1}" + kClassUsedBy3,
+      "{dex1}" + kClassUsedBy2,
+      "{dex1}" + kOtherClassUsedBy2,
+      "{dex1}" + kClassUsedBy1,
+
+      "{dex2}" + kClassUsedBy3,
+      "{dex2}" + kClassUsedBy2,
+      "{dex2}" + kOtherClassUsedBy2,
+
+      "{dex3}" + kClassUsedBy3,
+  };
+  std::string input_file_contents = JoinProfileLines(input_data);
+
+  // The class used by the most packages is kept, and the tie between the two classes used by
+  // two packages is broken by name. The output stays sorted by name.
+  std::vector<std::string> expected_preloaded_data = {
+      DescriptorToDot(kClassUsedBy2.c_str()),
+      DescriptorToDot(kClassUsedBy3.c_str()),
+  };
+  std::string expected_preloaded_content = JoinProfileLines(expected_preloaded_data);
+
+  ScratchFile profile;
+  EXPECT_TRUE(CreateProfile(input_file_contents,
+                            profile.GetFilename(),
+                            core_dex,
+                            /*for_boot_image=*/ true));
+
+  // Generate the boot profile.
+  ScratchFile out_profile;
+  ScratchFile out_preloaded_classes;
+  std::vector<std::string> args;
+  args.push_back(GetProfmanCmd());
+  args.push_back("--generate-boot-image-profile");
+  args.push_back("--preloaded-class-threshold=" + std::to_string(kPreloadedThreshold));
+  args.push_back("--preloaded-classes-max-count=" + std::to_string(kPreloadedMaxCount));
+  args.push_back("--profile-file=" + profile.GetFilename());
+  args.push_back("--out-profile-path=" + out_profile.GetFilename());
+  args.push_back("--out-preloaded-classes-path=" + out_preloaded_classes.GetFilename());
+  args.push_back("--apk=" + core_dex);
+  args.push_back("--dex-location=" + core_dex);
+
+  std::string error;
+  ASSERT_EQ(ExecAndReturnCode(args, &error), 0) << error;
+
+  // Verify the preloaded classes content.
+  std::string output_preloaded_contents;
+  ASSERT_TRUE(android::base::ReadFileToString(
+      out_preloaded_classes.GetFilename(), &output_preloaded_contents));
+  ASSERT_EQ(output_preloaded_contents, expected_preloaded_content);
+}
+
 TEST_F(ProfileAssistantTest, TestProfileCreationOneNotMatched) {
   // Class names put here need to be in sorted order.
   std::vector<std::string> class_names = {
@@ -175,6 +175,9 @@ NO_RETURN static void Usage(const char *fmt, ...) {
   UsageError("      include it in the final preloaded classes.");
   UsageError("  --preloaded-classes-denylist=file");
   UsageError("      a file listing the classes that should not be preloaded in Zygote");
+  UsageError("  --preloaded-classes-max-count=number");
+  UsageError("      the maximum number of preloaded classes; the classes used by the most");
+  UsageError("      profiles are kept. 0 (the default) means no limit.");
   UsageError("  --upgrade-startup-to-hot=true|false:");
   UsageError("      whether or not to upgrade startup methods to hot");
   UsageError("  --special-package=pkg_name:percentage between 0 and 100");
@@ -198,6 +201,8 @@ NO_RETURN static void Usage(const char *fmt, ...) {
   UsageError("      the min percent of new methods to trigger a compilation.");
   UsageError("  --min-new-classes-percent-change=percentage between 0 and 100 (default 2)");
   UsageError("      the min percent of new classes to trigger a compilation.");
+  UsageError("  --merge-parallel=<number>: the number of threads used to load and merge the");
+  UsageError("      profiles passed with --profile-file(-fd) (default 1).");
   UsageError("");
 
   exit(ProfmanResult::kErrorUsage);
@@ -384,6 +389,10 @@ class ProfMan final {
                         &boot_image_options_.preloaded_class_threshold,
                         0u,
                         100u);
+      } else if (option.starts_with("--preloaded-classes-max-count=")) {
+        ParseUintOption(raw_option,
+                        "--preloaded-classes-max-count=",
+                        &boot_image_options_.preloaded_classes_max_count);
       } else if (option.starts_with("--preloaded-classes-denylist=")) {
         std::string preloaded_classes_denylist =
             std::string(option.substr(strlen("--preloaded-classes-denylist=")));
@@ -463,6 +472,10 @@ class ProfMan final {
                         100u);
         profile_assistant_options_.SetMinNewClassesPercentChangeForCompilation(
             min_new_classes_percent_change);
+      } else if (option.starts_with("--merge-parallel=")) {
+        uint32_t merge_threads;
+        ParseUintOption(raw_option, "--merge-parallel=", &merge_threads, 1u);
+        profile_assistant_options_.SetMergeThreads(merge_threads);
       } else if (option == "--copy-and-update-profile-key") {
         copy_and_update_profile_key_ = true;
       } else if (option == "--boot-image-merge") {
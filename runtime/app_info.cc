@@ -155,6 +155,18 @@ std::string AppInfo::GetPrimaryApkReferenceProfile() {
   return "";
 }
 
+std::string AppInfo::GetPrimaryApkCurrentProfile() {
+  MutexLock mu(Thread::Current(), update_mutex_);
+
+  for (const auto& it : registered_code_locations_) {
+    const CodeLocationInfo& cli = it.second;
+    if (cli.code_type == CodeType::kPrimaryApk) {
+      return cli.cur_profile_path.value_or("");
+    }
+  }
+  return "";
+}
+
 std::string AppInfo::GetPrimaryApkPath() {
   MutexLock mu(Thread::Current(), update_mutex_);
 
@@ -85,6 +85,13 @@ class AppInfo {
   // Returns an empty string if there is no primary APK.
   std::string GetPrimaryApkReferenceProfile();
 
+  // Returns the current profile path of the primary APK, which the profile saver
+  // updates with the classes and methods used across app runs.
+  // Same selection rules as GetPrimaryApkReferenceProfile().
+  //
+  // Returns an empty string if there is no primary APK.
+  std::string GetPrimaryApkCurrentProfile();
+
   // Returns the path of the primary APK.
   // If there are multiple primary APKs registed via RegisterAppInfo, the method
   // will return the path of the first APK, sorted by the location name.
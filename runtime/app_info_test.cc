@@ -130,4 +130,25 @@ TEST(AppInfoTest, RegisterAppInfoWithOdexStatusNoPrimary) {
   ASSERT_EQ(reason, "unknown");
 }
 
+TEST(AppInfoTest, RegisterAppInfoWithProfiles) {
+  AppInfo app_info;
+  EXPECT_EQ(app_info.GetPrimaryApkCurrentProfile(), "");
+  EXPECT_EQ(app_info.GetPrimaryApkReferenceProfile(), "");
+  app_info.RegisterAppInfo(
+      "package_name",
+      std::vector<std::string>({"code_location"}),
+      "cur_profile",
+      "ref_profile",
+      AppInfo::CodeType::kPrimaryApk);
+  app_info.RegisterAppInfo(
+      "package_name",
+      std::vector<std::string>({"secondary_code_location"}),
+      "secondary_cur_profile",
+      "secondary_ref_profile",
+      AppInfo::CodeType::kSecondaryDex);
+
+  EXPECT_EQ(app_info.GetPrimaryApkCurrentProfile(), "cur_profile");
+  EXPECT_EQ(app_info.GetPrimaryApkReferenceProfile(), "ref_profile");
+}
+
 }  // namespace art
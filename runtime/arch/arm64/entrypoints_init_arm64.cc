@@ -194,6 +194,10 @@ void InitEntryPoints(JniEntryPoints* jpoints,
   qpoints->SetStringCompareTo(nullptr);
   qpoints->SetMemcpy(memcpy);
 
+  // Invoke.
+  qpoints->SetInvokePolymorphicWithHiddenReceiver(
+      art_quick_invoke_polymorphic_with_hidden_receiver);
+
   // Read barrier.
   qpoints->SetReadBarrierMarkReg16(nullptr);  // IP0 is used as a temp by the asm stub.
   UpdateReadBarrierEntrypoints(qpoints, /*is_active=*/ false);
@@ -154,6 +154,7 @@ class GcVisitedArenaPool final : public ArenaPool {
   void ReclaimMemory() override {}
   void LockReclaimMemory() override {}
   void TrimMaps() override {}
+  void TrimMapsAbove([[maybe_unused]] size_t retained_bytes) override {}
 
   EXPORT uint8_t* AllocSingleObjArena(size_t size) REQUIRES(!lock_);
   EXPORT void FreeSingleObjArena(uint8_t* addr) REQUIRES(!lock_);
@@ -117,9 +117,15 @@ Arena* MemMapArenaPool::AllocArena(size_t size) {
   Arena* ret = nullptr;
   {
     std::lock_guard<std::mutex> lock(lock_);
-    if (free_arenas_ != nullptr && LIKELY(free_arenas_->Size() >= size)) {
-      ret = free_arenas_;
-      free_arenas_ = free_arenas_->next_;
+    // Take the first free arena that is large enough, rather than only looking at the
+    // head of the list, so that the large arenas of big compilations get reused.
+    for (Arena** link = &free_arenas_; *link != nullptr; link = &(*link)->next_) {
+      if (LIKELY((*link)->Size() >= size)) {
+        ret = *link;
+        *link = ret->next_;
+        ret->next_ = nullptr;
+        break;
+      }
     }
   }
   if (ret == nullptr) {
@@ -130,10 +136,20 @@ Arena* MemMapArenaPool::AllocArena(size_t size) {
 }
 
 void MemMapArenaPool::TrimMaps() {
+  TrimMapsAbove(/* retained_bytes= */ 0u);
+}
+
+void MemMapArenaPool::TrimMapsAbove(size_t retained_bytes) {
   ScopedTrace trace(__PRETTY_FUNCTION__);
   std::lock_guard<std::mutex> lock(lock_);
+  // Freed chains are pushed at the front, so the arenas we keep are the most recently used.
+  size_t retained = 0u;
   for (Arena* arena = free_arenas_; arena != nullptr; arena = arena->next_) {
-    arena->Release();
+    if (retained < retained_bytes) {
+      retained += arena->GetBytesAllocated();
+    } else {
+      arena->Release();
+    }
   }
 }
 
@@ -32,6 +32,7 @@ class MemMapArenaPool final : public ArenaPool {
   void LockReclaimMemory() override;
   // Trim the maps in arenas by madvising, used by JIT to reduce memory usage.
   void TrimMaps() override;
+  void TrimMapsAbove(size_t retained_bytes) override;
 
  private:
   const bool low_4gb_;
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mem_map_arena_pool.h"
+
+#include "base/arena_allocator-inl.h"
+#include "gtest/gtest.h"
+
+namespace art HIDDEN {
+
+TEST(MemMapArenaPoolTest, ReuseLargeArena) {
+  if (arena_allocator::kArenaAllocatorPreciseTracking) {
+    GTEST_SKIP() << "Arenas are not reused with precise tracking";
+  }
+  MemMapArenaPool pool;
+  Arena* large_arena = pool.AllocArena(4 * arena_allocator::kArenaDefaultSize);
+  Arena* small_arena = pool.AllocArena(arena_allocator::kArenaDefaultSize);
+  pool.FreeArenaChain(large_arena);
+  pool.FreeArenaChain(small_arena);
+  // The small arena is at the head of the free list, the large one is found behind it.
+  Arena* arena = pool.AllocArena(4 * arena_allocator::kArenaDefaultSize);
+  EXPECT_EQ(arena, large_arena);
+  EXPECT_EQ(arena->Next(), nullptr);
+  pool.FreeArenaChain(arena);
+}
+
+TEST(MemMapArenaPoolTest, TrimMapsAbove) {
+  if (arena_allocator::kArenaAllocatorPreciseTracking) {
+    GTEST_SKIP() << "Arenas are not reused with precise tracking";
+  }
+  MemMapArenaPool pool;
+  {
+    ArenaAllocator first_allocator(&pool);
+    ArenaAllocator second_allocator(&pool);
+    first_allocator.Alloc(KB);
+    second_allocator.Alloc(KB);
+  }
+  size_t bytes_before_trim = pool.GetBytesAllocated();
+  EXPECT_GE(bytes_before_trim, 2 * KB);
+  // Keep the first free arena populated, release the other one.
+  pool.TrimMapsAbove(/* retained_bytes= */ 1u);
+  size_t bytes_after_trim = pool.GetBytesAllocated();
+  EXPECT_LT(bytes_after_trim, bytes_before_trim);
+  EXPECT_GE(bytes_after_trim, KB);
+  // Keeping more than what is populated does not release anything.
+  pool.TrimMapsAbove(bytes_before_trim);
+  EXPECT_EQ(pool.GetBytesAllocated(), bytes_after_trim);
+  pool.TrimMaps();
+  EXPECT_EQ(pool.GetBytesAllocated(), 0u);
+}
+
+}  // namespace art
@@ -18,6 +18,7 @@
 
 #include "art_method-inl.h"
 #include "base/logging.h"  // For VLOG
+#include "base/metrics/metrics.h"
 #include "base/mutex.h"
 #include "jit/jit.h"
 #include "jit/jit_code_cache.h"
@@ -682,6 +683,9 @@ void ClassHierarchyAnalysis::InvalidateSingleImplementationMethods(
     if (dependent_method_headers.empty()) {
       return;
     }
+    metrics::ArtMetrics* metrics = runtime->GetMetrics();
+    metrics->ChaInvalidatedCodeCount()->Add(dependent_method_headers.size());
+    metrics->ChaCheckpointCount()->AddOne();
     // Deoptimze compiled code on stack that should have been invalidated.
     CHACheckpoint checkpoint(dependent_method_headers);
     size_t threads_running_checkpoint = runtime->GetThreadList()->RunCheckpoint(&checkpoint);
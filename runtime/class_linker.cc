@@ -612,15 +612,21 @@ static bool RegisterMemBarrierForClassInitialization() {
   return membarrier_result == 0;
 }
 
-ClassLinker::ClassLinker(InternTable* intern_table, bool fast_class_not_found_exceptions)
+ClassLinker::ClassLinker(InternTable* intern_table,
+                         bool fast_class_not_found_exceptions,
+                         bool use_class_path_index)
     : boot_class_table_(new ClassTable()),
       failed_dex_cache_class_lookups_(0),
+      num_class_insertions_(0u),
+      num_locked_class_insertions_(0u),
+      num_class_definition_races_(0u),
       class_roots_(nullptr),
       find_array_class_cache_next_victim_(0),
       init_done_(false),
       log_new_roots_(false),
       intern_table_(intern_table),
       fast_class_not_found_exceptions_(fast_class_not_found_exceptions),
+      use_class_path_index_(use_class_path_index),
       jni_dlsym_lookup_trampoline_(nullptr),
       jni_dlsym_lookup_critical_trampoline_(nullptr),
       quick_resolution_trampoline_(nullptr),
@@ -2361,6 +2367,18 @@ bool ClassLinker::AddImageSpace(gc::space::ImageSpace* space,
                                     &read_count);
     VLOG(image) << "Adding class table classes took " << PrettyDuration(NanoTime() - start_time2);
   }
+  if (kBitstringSubtypeCheckEnabled && !app_image && runtime->IsAotCompiler()) {
+    // Record the bitstrings assigned in the boot image file before initializing app classes
+    // assigns bitstrings to their boot image superclasses. See CanUseTypeCheckBitstring().
+    ScopedTrace trace("BootImage:RecordAssignedSubtypeCheckBitstrings");
+    MutexLock subtype_check_lock(self, *Locks::subtype_check_lock_);
+    for (const ClassTable::TableSlot& root : temp_set) {
+      ObjPtr<mirror::Class> klass = root.Read();
+      if (SubtypeCheck<ObjPtr<mirror::Class>>::GetState(klass) == SubtypeCheckInfo::kAssigned) {
+        boot_image_assigned_bitstring_classes_.insert(klass.Ptr());
+      }
+    }
+  }
   if (app_image) {
     AppImageLoadingHelper::Update(this, space, class_loader, dex_caches);
 
@@ -3193,17 +3211,20 @@ bool ClassLinker::FindClassInBaseDexClassLoaderClassPath(
 
   const DexFile* dex_file = nullptr;
   const dex::ClassDef* class_def = nullptr;
-  ObjPtr<mirror::Class> ret;
-  auto find_class_def = [&](const DexFile* cp_dex_file) REQUIRES_SHARED(Locks::mutator_lock_) {
-    const dex::ClassDef* cp_class_def = OatDexFile::FindClassDef(*cp_dex_file, descriptor, hash);
-    if (cp_class_def != nullptr) {
-      dex_file = cp_dex_file;
-      class_def = cp_class_def;
-      return false;  // Found a class definition, stop visit.
-    }
-    return true;  // Continue with the next DexFile.
-  };
-  VisitClassLoaderDexFiles(self, class_loader, find_class_def);
+  if (!use_class_path_index_ ||
+      !FindClassDefInClassPathIndex(self, descriptor, hash, class_loader, &dex_file, &class_def)) {
+    auto find_class_def = [&](const DexFile* cp_dex_file) REQUIRES_SHARED(Locks::mutator_lock_) {
+      const dex::ClassDef* cp_class_def =
+          OatDexFile::FindClassDef(*cp_dex_file, descriptor, hash);
+      if (cp_class_def != nullptr) {
+        dex_file = cp_dex_file;
+        class_def = cp_class_def;
+        return false;  // Found a class definition, stop visit.
+      }
+      return true;  // Continue with the next DexFile.
+    };
+    VisitClassLoaderDexFiles(self, class_loader, find_class_def);
+  }
 
   if (class_def != nullptr) {
     *result = DefineClass(self, descriptor, hash, class_loader, *dex_file, *class_def);
@@ -3218,6 +3239,71 @@ bool ClassLinker::FindClassInBaseDexClassLoaderClassPath(
   return true;
 }
 
+bool ClassLinker::FindClassDefInClassPathIndex(Thread* self,
+                                               const char* descriptor,
+                                               size_t hash,
+                                               Handle<mirror::ClassLoader> class_loader,
+                                               /*out*/ const DexFile** dex_file,
+                                               /*out*/ const dex::ClassDef** class_def) {
+  ClassTable* const class_table = class_loader->GetClassTable();
+  if (class_table == nullptr) {
+    return false;
+  }
+  auto get_dex_elements = [&]() REQUIRES_SHARED(Locks::mutator_lock_) -> ObjPtr<mirror::Object> {
+    ObjPtr<mirror::Object> dex_path_list =
+        WellKnownClasses::dalvik_system_BaseDexClassLoader_pathList->GetObject(class_loader.Get());
+    return (dex_path_list != nullptr)
+        ? WellKnownClasses::dalvik_system_DexPathList_dexElements->GetObject(dex_path_list)
+        : nullptr;
+  };
+  StackHandleScope<1> hs(self);
+  Handle<mirror::Object> dex_elements = hs.NewHandle(get_dex_elements());
+  if (dex_elements == nullptr) {
+    return false;
+  }
+
+  ClassPathIndex::Result result = class_table->LookupInClassPathIndex(
+      dex_elements.Get(), descriptor, hash, dex_file, class_def);
+  if (result == ClassPathIndex::Result::kStale) {
+    // First lookup, or dex files were added to the class loader since the index was built.
+    std::vector<const DexFile*> dex_files;
+    auto collect_dex_files = [&](const DexFile* cp_dex_file) {
+      dex_files.push_back(cp_dex_file);
+      return true;  // Continue with the next DexFile.
+    };
+    VisitClassLoaderDexFiles(self, class_loader, collect_dex_files);
+    std::unique_ptr<ClassPathIndex> class_path_index;
+    {
+      // Building the index reads all class definitions, let the GC run meanwhile.
+      ScopedThreadSuspension sts(self, ThreadState::kSuspended);
+      class_path_index = ClassPathIndex::Create(std::move(dex_files));
+    }
+    if (get_dex_elements() != dex_elements.Get()) {
+      // Raced with a change of the class path. The next lookup builds a new index.
+      return false;
+    }
+    class_path_index->SetDexElements(dex_elements.Get());
+    class_table->SetClassPathIndex(std::move(class_path_index));
+    // The class table now holds a strong root to the `dexElements` array.
+    WriteBarrierOnClassLoader(self, class_loader.Get(), dex_elements.Get());
+    result = class_table->LookupInClassPathIndex(
+        dex_elements.Get(), descriptor, hash, dex_file, class_def);
+  }
+
+  switch (result) {
+    case ClassPathIndex::Result::kFound:
+      return true;
+    case ClassPathIndex::Result::kNotFound:
+      *dex_file = nullptr;
+      *class_def = nullptr;
+      return true;
+    case ClassPathIndex::Result::kStale:
+    case ClassPathIndex::Result::kDisabled:
+      return false;
+  }
+  UNREACHABLE();
+}
+
 ObjPtr<mirror::Class> ClassLinker::FindClass(Thread* self,
                                              const char* descriptor,
                                              Handle<mirror::ClassLoader> class_loader) {
@@ -4744,18 +4830,34 @@ ObjPtr<mirror::Class> ClassLinker::InsertClass(const char* descriptor,
     }
     LOG(INFO) << "Loaded class " << descriptor << source;
   }
-  {
-    WriterMutexLock mu(Thread::Current(), *Locks::classlinker_classes_lock_);
-    const ObjPtr<mirror::ClassLoader> class_loader = klass->GetClassLoader();
-    ClassTable* const class_table = InsertClassTableForClassLoader(class_loader);
-    ObjPtr<mirror::Class> existing = class_table->Lookup(descriptor, hash);
+  Thread* const self = Thread::Current();
+  const ObjPtr<mirror::ClassLoader> class_loader = klass->GetClassLoader();
+  ClassTable* const class_table =
+      (class_loader != nullptr) ? class_loader->GetClassTable() : nullptr;
+  VerifyObject(klass);
+  if (class_table != nullptr) {
+    // The class table of a live class loader is never replaced or deleted, and its own lock
+    // makes the insertion atomic. Avoid the global lock so that threads loading classes into
+    // different class loaders, or looking up classes, do not wait for each other.
+    ObjPtr<mirror::Class> existing = class_table->LookupOrInsert(descriptor, klass, hash);
+    if (existing != nullptr) {
+      num_class_definition_races_.fetch_add(1u, std::memory_order_relaxed);
+      return existing;
+    }
+    WriteBarrierOnClassLoader(self, class_loader, klass);
+  } else {
+    // Creating a class table and logging new boot class roots need the global lock.
+    WriterMutexLock mu(self, *Locks::classlinker_classes_lock_);
+    num_locked_class_insertions_.fetch_add(1u, std::memory_order_relaxed);
+    ClassTable* const new_class_table = InsertClassTableForClassLoader(class_loader);
+    ObjPtr<mirror::Class> existing = new_class_table->LookupOrInsert(descriptor, klass, hash);
     if (existing != nullptr) {
+      num_class_definition_races_.fetch_add(1u, std::memory_order_relaxed);
       return existing;
     }
-    VerifyObject(klass);
-    class_table->InsertWithHash(klass, hash);
     WriteBarrierOnClassLoaderLocked(class_loader, klass);
   }
+  num_class_insertions_.fetch_add(1u, std::memory_order_relaxed);
   if (kIsDebugBuild) {
     // Test that copied methods correctly can find their holder.
     for (ArtMethod& method : klass->GetCopiedMethods(image_pointer_size_)) {
@@ -4793,7 +4895,8 @@ ObjPtr<mirror::Class> ClassLinker::LookupClass(Thread* self,
                                                const char* descriptor,
                                                size_t hash,
                                                ObjPtr<mirror::ClassLoader> class_loader) {
-  ReaderMutexLock mu(self, *Locks::classlinker_classes_lock_);
+  // No need for the global lock: the class table of a live class loader stays valid
+  // and the class table lock protects the lookup.
   ClassTable* const class_table = ClassTableForClassLoader(class_loader);
   if (class_table != nullptr) {
     ObjPtr<mirror::Class> result = class_table->Lookup(descriptor, hash);
@@ -6420,13 +6523,21 @@ bool ClassLinker::LinkClass(Thread* self,
     FixupTemporaryDeclaringClass(klass.Get(), h_new_class.Get());
 
     if (LIKELY(descriptor != nullptr)) {
-      WriterMutexLock mu(self, *Locks::classlinker_classes_lock_);
       const ObjPtr<mirror::ClassLoader> class_loader = h_new_class.Get()->GetClassLoader();
-      ClassTable* const table = InsertClassTableForClassLoader(class_loader);
-      const ObjPtr<mirror::Class> existing =
-          table->UpdateClass(h_new_class.Get(), ComputeModifiedUtf8Hash(descriptor));
-      CHECK_EQ(existing, klass.Get());
-      WriteBarrierOnClassLoaderLocked(class_loader, h_new_class.Get());
+      const size_t hash = ComputeModifiedUtf8Hash(descriptor);
+      if (class_loader != nullptr) {
+        // The temporary class was inserted, so the class table exists. See InsertClass().
+        ClassTable* const table = class_loader->GetClassTable();
+        const ObjPtr<mirror::Class> existing = table->UpdateClass(h_new_class.Get(), hash);
+        CHECK_EQ(existing, klass.Get());
+        WriteBarrierOnClassLoader(self, class_loader, h_new_class.Get());
+      } else {
+        WriterMutexLock mu(self, *Locks::classlinker_classes_lock_);
+        const ObjPtr<mirror::Class> existing =
+            boot_class_table_->UpdateClass(h_new_class.Get(), hash);
+        CHECK_EQ(existing, klass.Get());
+        WriteBarrierOnClassLoaderLocked(class_loader, h_new_class.Get());
+      }
     }
 
     // Update CHA info based on whether we override methods.
@@ -10696,6 +10807,11 @@ void ClassLinker::DumpForSigQuit(std::ostream& os) {
     }
   }
   os << "Done dumping class loaders\n";
+  os << "Classes defined: " << num_class_insertions_.load(std::memory_order_relaxed)
+     << ", with the class linker lock: "
+     << num_locked_class_insertions_.load(std::memory_order_relaxed)
+     << ", lost to a concurrent definition: "
+     << num_class_definition_races_.load(std::memory_order_relaxed) << "\n";
   Runtime* runtime = Runtime::Current();
   os << "Classes initialized: " << runtime->GetStat(KIND_GLOBAL_CLASS_INIT_COUNT) << " in "
      << PrettyDuration(runtime->GetStat(KIND_GLOBAL_CLASS_INIT_TIME)) << "\n";
@@ -11009,11 +11125,13 @@ void ClassLinker::CleanupClassLoaders() {
       PrepareToDeleteClassLoader(self, data, /*cleanup_cha=*/true);
     }
   }
+  Runtime* runtime = Runtime::Current();
+  // Sampled allocation sites are keyed by ArtMethod pointers that are about to be freed.
+  runtime->GetHeap()->GetHeapSampler().OnClassLoadersUnloaded();
   for (const ClassLoaderData& data : to_delete) {
     delete data.allocator;
     delete data.class_table;
   }
-  Runtime* runtime = Runtime::Current();
   if (!unregistered_oat_files.empty()) {
     for (const OatFile* oat_file : unregistered_oat_files) {
       // Notify the fault handler about removal of the executable code range if needed.
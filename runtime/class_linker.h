@@ -28,6 +28,7 @@
 
 #include "base/array_ref.h"
 #include "base/hash_map.h"
+#include "base/hash_set.h"
 #include "base/intrusive_forward_list.h"
 #include "base/locks.h"
 #include "base/macros.h"
@@ -164,7 +165,8 @@ class ClassLinker {
   static constexpr bool kAppImageMayContainStrings = true;
 
   EXPORT explicit ClassLinker(InternTable* intern_table,
-                              bool fast_class_not_found_exceptions = true);
+                              bool fast_class_not_found_exceptions = true,
+                              bool use_class_path_index = false);
   EXPORT virtual ~ClassLinker();
 
   // Initialize class linker by bootstraping from dex files.
@@ -255,6 +257,16 @@ class ClassLinker {
   ObjPtr<mirror::Class> LookupPrimitiveClass(char type) REQUIRES_SHARED(Locks::mutator_lock_);
   ObjPtr<mirror::Class> FindPrimitiveClass(char type) REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Returns whether the type check bitstring of `klass` is assigned in the boot image file.
+  // Only recorded for the AOT compiler. Initializing app classes can assign bitstrings to boot
+  // image classes in memory but these are not the bitstrings seen by the runtime using the oat
+  // file.
+  bool IsTypeCheckBitstringAssignedInBootImage(ObjPtr<mirror::Class> klass) const
+      REQUIRES_SHARED(Locks::mutator_lock_) {
+    return boot_image_assigned_bitstring_classes_.find(klass.Ptr()) !=
+           boot_image_assigned_bitstring_classes_.end();
+  }
+
   void DumpForSigQuit(std::ostream& os) REQUIRES(!Locks::classlinker_classes_lock_);
 
   size_t NumLoadedClasses()
@@ -1187,6 +1199,19 @@ class ClassLinker {
       REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(!Locks::dex_lock_);
 
+  // Finds the class definition in the class path of the given class loader with
+  // its ClassPathIndex, building the index if needed. Returns false if the class
+  // loader cannot use an index, in which case the caller looks up the class path
+  // dex files in turn.
+  bool FindClassDefInClassPathIndex(Thread* self,
+                                    const char* descriptor,
+                                    size_t hash,
+                                    Handle<mirror::ClassLoader> class_loader,
+                                    /*out*/ const DexFile** dex_file,
+                                    /*out*/ const dex::ClassDef** class_def)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!Locks::classlinker_classes_lock_);
+
   // Finds the class in the boot class loader.
   // If the class is found the method updates `result`.
   // The method always returns true, to notify to the caller the
@@ -1454,6 +1479,17 @@ class ClassLinker {
   // the classes into the class_table_ to avoid dex cache based searches.
   Atomic<uint32_t> failed_dex_cache_class_lookups_;
 
+  // Boot image classes with a type check bitstring assigned in the image file, recorded by the
+  // AOT compiler when adding the boot image spaces. Not modified after that.
+  HashSet<mirror::Class*> boot_image_assigned_bitstring_classes_;
+
+  // Contention statistics for InsertClass(), reported by DumpForSigQuit(): classes inserted,
+  // insertions that needed the classlinker_classes_lock_ (boot classes and the first class of a
+  // class loader), and definitions lost to another thread defining the same class first.
+  Atomic<uint64_t> num_class_insertions_;
+  Atomic<uint64_t> num_locked_class_insertions_;
+  Atomic<uint64_t> num_class_definition_races_;
+
   // Well known mirror::Class roots.
   GcRoot<mirror::ObjectArray<mirror::Class>> class_roots_;
 
@@ -1474,6 +1510,10 @@ class ClassLinker {
 
   const bool fast_class_not_found_exceptions_;
 
+  // Whether to look up classes in the class path of BaseDexClassLoaders with many
+  // dex files through a merged index. See ClassPathIndex.
+  const bool use_class_path_index_;
+
   // Trampolines within the image the bounce to runtime entrypoints. Done so that there is a single
   // patch point within the image. TODO: make these proper relocations.
   const void* jni_dlsym_lookup_trampoline_;
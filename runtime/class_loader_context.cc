@@ -1347,6 +1347,11 @@ static bool AreDexNameMatching(const std::string& actual_dex_name,
   // We shouldn't do a naive comparison `actual_dex_name == expected_dex_name`
   // because even if they refer to the same file, one could be encoded as a relative location
   // and the other as an absolute one.
+  if (actual_dex_name == expected_dex_name) {
+    // Identical names always resolve to the same file. This is the common case for
+    // shared libraries, so avoid the `realpath()` calls below.
+    return true;
+  }
   bool is_dex_name_absolute = IsAbsoluteLocation(actual_dex_name);
   bool is_expected_dex_name_absolute = IsAbsoluteLocation(expected_dex_name);
   bool dex_names_match = false;
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "class_path_index.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "base/bit_utils.h"
+#include "base/casts.h"
+#include "dex/dex_file-inl.h"
+#include "dex/utf.h"
+#include "gc_root-inl.h"
+#include "oat/oat_file.h"
+
+namespace art HIDDEN {
+
+std::unique_ptr<ClassPathIndex> ClassPathIndex::Create(std::vector<const DexFile*>&& dex_files) {
+  return std::unique_ptr<ClassPathIndex>(new ClassPathIndex(std::move(dex_files)));
+}
+
+ClassPathIndex::ClassPathIndex(std::vector<const DexFile*>&& dex_files)
+    : dex_files_(std::move(dex_files)),
+      mask_(0u) {
+  bool has_dex_file_without_lookup_table = std::any_of(
+      dex_files_.begin(),
+      dex_files_.end(),
+      [](const DexFile* dex_file) {
+        const OatDexFile* oat_dex_file = dex_file->GetOatDexFile();
+        return oat_dex_file == nullptr || !oat_dex_file->GetTypeLookupTable().Valid();
+      });
+  if ((dex_files_.size() < kMinDexFiles && !has_dex_file_without_lookup_table) ||
+      dex_files_.size() >= kEmptyEntry) {
+    return;
+  }
+  size_t num_class_defs = 0u;
+  for (const DexFile* dex_file : dex_files_) {
+    num_class_defs += dex_file->NumClassDefs();
+  }
+  // Keep the load factor at or below 1/2 so that misses find an empty slot quickly.
+  size_t capacity = RoundUpToPowerOfTwo(std::max<size_t>(2u * num_class_defs, 16u));
+  entries_.resize(capacity, Entry{0u, kEmptyEntry, 0u});
+  mask_ = capacity - 1u;
+
+  for (size_t i = 0; i != dex_files_.size(); ++i) {
+    const DexFile* dex_file = dex_files_[i];
+    for (uint32_t class_def_index = 0; class_def_index != dex_file->NumClassDefs();
+         ++class_def_index) {
+      const char* descriptor = dex_file->GetClassDescriptor(dex_file->GetClassDef(class_def_index));
+      uint32_t hash = ComputeModifiedUtf8Hash(descriptor);
+      Entry* slot = const_cast<Entry*>(FindSlot(descriptor, hash));
+      if (slot->dex_file_index != kEmptyEntry) {
+        // An earlier dex file defines the same class and shadows this definition.
+        continue;
+      }
+      *slot = Entry{hash, dchecked_integral_cast<uint16_t>(i),
+                    dchecked_integral_cast<uint16_t>(class_def_index)};
+    }
+  }
+}
+
+void ClassPathIndex::SetDexElements(ObjPtr<mirror::Object> dex_elements) {
+  dex_elements_ = GcRoot<mirror::Object>(dex_elements);
+}
+
+const ClassPathIndex::Entry* ClassPathIndex::FindSlot(const char* descriptor,
+                                                      uint32_t hash) const {
+  DCHECK(IsEnabled());
+  for (size_t index = hash & mask_; ; index = (index + 1u) & mask_) {
+    const Entry& entry = entries_[index];
+    if (entry.dex_file_index == kEmptyEntry) {
+      return &entry;
+    }
+    if (entry.hash == hash) {
+      const DexFile* dex_file = dex_files_[entry.dex_file_index];
+      const dex::ClassDef& class_def = dex_file->GetClassDef(entry.class_def_index);
+      if (strcmp(descriptor, dex_file->GetClassDescriptor(class_def)) == 0) {
+        return &entry;
+      }
+    }
+  }
+}
+
+ClassPathIndex::Result ClassPathIndex::Lookup(ObjPtr<mirror::Object> dex_elements,
+                                              const char* descriptor,
+                                              size_t hash,
+                                              /*out*/ const DexFile** dex_file,
+                                              /*out*/ const dex::ClassDef** class_def) const {
+  if (dex_elements_.Read() != dex_elements.Ptr()) {
+    return Result::kStale;
+  }
+  if (!IsEnabled()) {
+    return Result::kDisabled;
+  }
+  DCHECK_EQ(hash, ComputeModifiedUtf8Hash(descriptor));
+  const Entry* slot = FindSlot(descriptor, dchecked_integral_cast<uint32_t>(hash));
+  if (slot->dex_file_index == kEmptyEntry) {
+    return Result::kNotFound;
+  }
+  *dex_file = dex_files_[slot->dex_file_index];
+  *class_def = &(*dex_file)->GetClassDef(slot->class_def_index);
+  return Result::kFound;
+}
+
+}  // namespace art
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_CLASS_PATH_INDEX_H_
+#define ART_RUNTIME_CLASS_PATH_INDEX_H_
+
+#include <memory>
+#include <vector>
+
+#include "base/locks.h"
+#include "base/macros.h"
+#include "gc_root.h"
+#include "obj_ptr.h"
+
+namespace art HIDDEN {
+
+class DexFile;
+
+namespace dex {
+struct ClassDef;
+}  // namespace dex
+
+namespace mirror {
+class Object;
+}  // namespace mirror
+
+// Descriptor index merged over all the dex files in the class path of a
+// BaseDexClassLoader. Looking up a class in the class path otherwise probes
+// the type lookup table of each dex file in turn, which is slow for class
+// loaders with many dex files, in particular for classes which are not there.
+// With the index, a single probe sequence in one open addressing table finds
+// the first dex file defining the class, and a miss usually ends at the first
+// empty slot without comparing any descriptor.
+//
+// Dex files loaded at runtime without an oat or vdex file have no type lookup
+// table at all, and finding a class in them scans their class definitions.
+// Class paths with such dex files are indexed regardless of their size. Once
+// background verification has written a vdex, later loads get the type lookup
+// tables from that file, mapped and shared between processes.
+//
+// The index is tied to the `DexPathList.dexElements` array it was built from.
+// That array is replaced whenever dex files are added to the class loader,
+// which makes the index stale.
+class ClassPathIndex {
+ public:
+  enum class Result {
+    kStale,     // The index was built for different dex elements.
+    kDisabled,  // The class path is not worth indexing.
+    kFound,
+    kNotFound,
+  };
+
+  // Class loaders with fewer dex files, all with type lookup tables, keep
+  // looking up each dex file in turn.
+  static constexpr size_t kMinDexFiles = 8u;
+
+  // Build the index for `dex_files`, in class path order. This walks all class
+  // definitions and does not need the mutator lock.
+  static std::unique_ptr<ClassPathIndex> Create(std::vector<const DexFile*>&& dex_files);
+
+  void SetDexElements(ObjPtr<mirror::Object> dex_elements) REQUIRES_SHARED(Locks::mutator_lock_);
+
+  Result Lookup(ObjPtr<mirror::Object> dex_elements,
+                const char* descriptor,
+                size_t hash,
+                /*out*/ const DexFile** dex_file,
+                /*out*/ const dex::ClassDef** class_def) const
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  GcRoot<mirror::Object>& GetDexElementsRoot() {
+    return dex_elements_;
+  }
+
+ private:
+  struct Entry {
+    uint32_t hash;
+    uint16_t dex_file_index;
+    uint16_t class_def_index;
+  };
+  static constexpr uint16_t kEmptyEntry = 0xffffu;
+
+  explicit ClassPathIndex(std::vector<const DexFile*>&& dex_files);
+
+  bool IsEnabled() const {
+    return !entries_.empty();
+  }
+
+  // Return the slot holding `descriptor`, or the empty slot ending its probe sequence.
+  const Entry* FindSlot(const char* descriptor, uint32_t hash) const;
+
+  GcRoot<mirror::Object> dex_elements_;
+  const std::vector<const DexFile*> dex_files_;
+  std::vector<Entry> entries_;
+  size_t mask_;
+
+  DISALLOW_COPY_AND_ASSIGN(ClassPathIndex);
+};
+
+}  // namespace art
+
+#endif  // ART_RUNTIME_CLASS_PATH_INDEX_H_
@@ -84,6 +84,9 @@ void ClassTable::VisitRoots(Visitor& visitor, bool skip_classes) {
       visitor.VisitRootIfNonNull(root.AddressWithoutBarrier());
     }
   }
+  if (class_path_index_ != nullptr) {
+    visitor.VisitRoot(class_path_index_->GetDexElementsRoot().AddressWithoutBarrier());
+  }
 }
 
 template <class Visitor>
@@ -104,6 +107,9 @@ void ClassTable::VisitRoots(const Visitor& visitor, bool skip_classes) {
       visitor.VisitRootIfNonNull(root.AddressWithoutBarrier());
     }
   }
+  if (class_path_index_ != nullptr) {
+    visitor.VisitRoot(class_path_index_->GetDexElementsRoot().AddressWithoutBarrier());
+  }
 }
 
 template <class Condition, class Visitor>
@@ -153,6 +159,9 @@ void ClassTable::VisitClassesAndRoots(Visitor& visitor) {
       visitor.VisitRootIfNonNull(root.AddressWithoutBarrier());
     }
   }
+  if (class_path_index_ != nullptr) {
+    visitor.VisitRoot(class_path_index_->GetDexElementsRoot().AddressWithoutBarrier());
+  }
 }
 
 template <ReadBarrierOption kReadBarrierOption, typename Visitor>
@@ -130,6 +130,21 @@ void ClassTable::InsertWithHash(ObjPtr<mirror::Class> klass, size_t hash) {
   classes_.back().InsertWithHash(TableSlot(klass, hash), hash);
 }
 
+ObjPtr<mirror::Class> ClassTable::LookupOrInsert(const char* descriptor,
+                                                 ObjPtr<mirror::Class> klass,
+                                                 size_t hash) {
+  DescriptorHashPair pair(descriptor, hash);
+  WriterMutexLock mu(Thread::Current(), lock_);
+  for (ClassSet& class_set : ReverseRange(classes_)) {
+    auto it = class_set.FindWithHash(pair, hash);
+    if (it != class_set.end()) {
+      return it->Read();
+    }
+  }
+  classes_.back().InsertWithHash(TableSlot(klass, hash), hash);
+  return nullptr;
+}
+
 bool ClassTable::InsertStrongRoot(ObjPtr<mirror::Object> obj) {
   WriterMutexLock mu(Thread::Current(), lock_);
   DCHECK(obj != nullptr);
@@ -181,10 +196,28 @@ void ClassTable::AddClassSet(ClassSet&& set) {
   classes_.insert(classes_.end() - 1, std::move(set));
 }
 
+ClassPathIndex::Result ClassTable::LookupInClassPathIndex(ObjPtr<mirror::Object> dex_elements,
+                                                         const char* descriptor,
+                                                         size_t hash,
+                                                         /*out*/ const DexFile** dex_file,
+                                                         /*out*/ const dex::ClassDef** class_def) {
+  ReaderMutexLock mu(Thread::Current(), lock_);
+  if (class_path_index_ == nullptr) {
+    return ClassPathIndex::Result::kStale;
+  }
+  return class_path_index_->Lookup(dex_elements, descriptor, hash, dex_file, class_def);
+}
+
+void ClassTable::SetClassPathIndex(std::unique_ptr<ClassPathIndex> class_path_index) {
+  WriterMutexLock mu(Thread::Current(), lock_);
+  class_path_index_ = std::move(class_path_index);
+}
+
 void ClassTable::ClearStrongRoots() {
   WriterMutexLock mu(Thread::Current(), lock_);
   oat_files_.clear();
   strong_roots_.clear();
+  class_path_index_.reset();
 }
 
 }  // namespace art
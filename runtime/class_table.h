@@ -17,6 +17,7 @@
 #ifndef ART_RUNTIME_CLASS_TABLE_H_
 #define ART_RUNTIME_CLASS_TABLE_H_
 
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -25,6 +26,7 @@
 #include "base/hash_set.h"
 #include "base/macros.h"
 #include "base/mutex.h"
+#include "class_path_index.h"
 #include "gc_root.h"
 #include "obj_ptr.h"
 
@@ -239,6 +241,14 @@ class ClassTable {
       REQUIRES(!lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Insert `klass` unless there is already a class with the same descriptor, with a single
+  // acquisition of the lock. Returns the existing class, or null if `klass` was inserted.
+  ObjPtr<mirror::Class> LookupOrInsert(const char* descriptor,
+                                       ObjPtr<mirror::Class> klass,
+                                       size_t hash)
+      REQUIRES(!lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   // Return true if we inserted the strong root, false if it already exists.
   bool InsertStrongRoot(ObjPtr<mirror::Object> obj)
       REQUIRES(!lock_)
@@ -270,6 +280,20 @@ class ClassTable {
       REQUIRES(!lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Look up `descriptor` in the class path index built for `dex_elements`.
+  ClassPathIndex::Result LookupInClassPathIndex(ObjPtr<mirror::Object> dex_elements,
+                                                const char* descriptor,
+                                                size_t hash,
+                                                /*out*/ const DexFile** dex_file,
+                                                /*out*/ const dex::ClassDef** class_def)
+      REQUIRES(!lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Replace the class path index, which holds its dex elements as a strong root.
+  void SetClassPathIndex(std::unique_ptr<ClassPathIndex> class_path_index)
+      REQUIRES(!lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   ReaderWriterMutex& GetLock() {
     return lock_;
   }
@@ -295,6 +319,8 @@ class ClassTable {
   std::vector<GcRoot<mirror::Object>> strong_roots_ GUARDED_BY(lock_);
   // Keep track of oat files with GC roots associated with dex caches in `strong_roots_`.
   std::vector<const OatFile*> oat_files_ GUARDED_BY(lock_);
+  // Merged class descriptor index for the class path of a BaseDexClassLoader, see ClassLinker.
+  std::unique_ptr<ClassPathIndex> class_path_index_ GUARDED_BY(lock_);
 
   friend class linker::ImageWriter;  // for InsertWithoutLocks.
 };
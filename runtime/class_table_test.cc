@@ -19,6 +19,7 @@
 #include "art_field-inl.h"
 #include "art_method-inl.h"
 #include "class_linker-inl.h"
+#include "class_root-inl.h"
 #include "common_runtime_test.h"
 #include "dex/dex_file.h"
 #include "gc/accounting/card_table-inl.h"
@@ -112,6 +113,15 @@ TEST_F(ClassTableTest, ClassTable) {
   EXPECT_EQ(table.NumZygoteClasses(class_loader.Get()), 1u);
   EXPECT_EQ(table.NumNonZygoteClasses(class_loader.Get()), 1u);
 
+  // LookupOrInsert() returns the existing class, including from the zygote snapshot.
+  EXPECT_OBJ_PTR_EQ(
+      table.LookupOrInsert(descriptor_x, h_Y.Get(), ComputeModifiedUtf8Hash(descriptor_x)),
+      h_X.Get());
+  EXPECT_OBJ_PTR_EQ(
+      table.LookupOrInsert(descriptor_y, h_X.Get(), ComputeModifiedUtf8Hash(descriptor_y)),
+      h_Y.Get());
+  EXPECT_EQ(table.NumNonZygoteClasses(class_loader.Get()), 1u);
+
   // Test adding / clearing strong roots.
   EXPECT_TRUE(table.InsertStrongRoot(obj_X.Get()));
   EXPECT_FALSE(table.InsertStrongRoot(obj_X.Get()));
@@ -161,5 +171,75 @@ TEST_F(ClassTableTest, ClassTable) {
   // TODO: Add tests for UpdateClass, InsertOatFile.
 }
 
+TEST_F(ClassTableTest, ClassPathIndex) {
+  ScopedObjectAccess soa(Thread::Current());
+  std::vector<std::unique_ptr<const DexFile>> opened_dex_files;
+  std::vector<const DexFile*> dex_files;
+  auto open_dex_file = [&](const char* name) {
+    opened_dex_files.push_back(OpenTestDexFile(name));
+    dex_files.push_back(opened_dex_files.back().get());
+  };
+  // Classes from the second "XandY" dex file are shadowed by the first one.
+  open_dex_file("Nested");
+  open_dex_file("XandY");
+  while (dex_files.size() < ClassPathIndex::kMinDexFiles) {
+    open_dex_file("XandY");
+  }
+  const DexFile* nested_dex_file = dex_files[0];
+  const DexFile* x_and_y_dex_file = dex_files[1];
+
+  // Any object stands for the dex elements array.
+  StackHandleScope<2> hs(soa.Self());
+  Handle<mirror::Object> dex_elements =
+      hs.NewHandle<mirror::Object>(GetClassRoot<mirror::Object>());
+  Handle<mirror::Object> other_dex_elements =
+      hs.NewHandle<mirror::Object>(GetClassRoot<mirror::String>());
+  std::unique_ptr<ClassPathIndex> index = ClassPathIndex::Create(std::move(dex_files));
+  index->SetDexElements(dex_elements.Get());
+
+  auto lookup = [&](const char* descriptor,
+                    ObjPtr<mirror::Object> elements,
+                    const DexFile** dex_file) REQUIRES_SHARED(Locks::mutator_lock_) {
+    const dex::ClassDef* class_def = nullptr;
+    *dex_file = nullptr;
+    ClassPathIndex::Result result = index->Lookup(
+        elements, descriptor, ComputeModifiedUtf8Hash(descriptor), dex_file, &class_def);
+    if (result == ClassPathIndex::Result::kFound) {
+      EXPECT_STREQ((*dex_file)->GetClassDescriptor(*class_def), descriptor);
+    }
+    return result;
+  };
+  const DexFile* dex_file;
+  EXPECT_EQ(lookup("LNested;", dex_elements.Get(), &dex_file), ClassPathIndex::Result::kFound);
+  EXPECT_EQ(dex_file, nested_dex_file);
+  EXPECT_EQ(lookup("LY$Z;", dex_elements.Get(), &dex_file), ClassPathIndex::Result::kFound);
+  EXPECT_EQ(dex_file, x_and_y_dex_file);
+  EXPECT_EQ(lookup("LNOT_THERE;", dex_elements.Get(), &dex_file),
+            ClassPathIndex::Result::kNotFound);
+  EXPECT_EQ(lookup("LX;", other_dex_elements.Get(), &dex_file), ClassPathIndex::Result::kStale);
+
+  // The index holds its dex elements as a root of the class table.
+  ClassTable table;
+  table.SetClassPathIndex(std::move(index));
+  CollectRootVisitor roots;
+  table.VisitRoots(roots);
+  EXPECT_TRUE(roots.roots_.find(dex_elements.Get()) != roots.roots_.end());
+
+  // Class paths with few dex files are still indexed if a dex file has no type
+  // lookup table, as is the case for dex files opened without an oat file.
+  ASSERT_TRUE(nested_dex_file->GetOatDexFile() == nullptr);
+  std::unique_ptr<ClassPathIndex> small_index =
+      ClassPathIndex::Create(std::vector<const DexFile*>{nested_dex_file});
+  small_index->SetDexElements(dex_elements.Get());
+  const dex::ClassDef* class_def;
+  EXPECT_EQ(small_index->Lookup(dex_elements.Get(),
+                                "LNested;",
+                                ComputeModifiedUtf8Hash("LNested;"),
+                                &dex_file,
+                                &class_def),
+            ClassPathIndex::Result::kFound);
+  EXPECT_EQ(dex_file, nested_dex_file);
+}
+
 }  // namespace mirror
 }  // namespace art
@@ -583,9 +583,10 @@ bool NullPointerHandler::IsValidReturnPc(ArtMethod** sp, uintptr_t return_pc) {
   // Check if we can associate a dex PC with the return PC, whether from Nterp,
   // or with an existing stack map entry for a compiled method.
   // Note: Allowing nested faults if `IsValidMethod()` returned a false positive.
-  // Note: The `ArtMethod::GetOatQuickMethodHeader()` can acquire locks (at least
-  // `Locks::jit_lock_`) and if the thread already held such a lock, the signal
-  // handler would deadlock. However, if a thread is holding one of the locks
+  // Note: The `ArtMethod::GetOatQuickMethodHeader()` looks up JIT code for non-native
+  // methods in the lock-free `CodeLookupTable`, but it can still acquire locks (at least
+  // `Locks::jit_mutator_lock_` for JNI stubs) and if the thread already held such a lock,
+  // the signal handler would deadlock. However, if a thread is holding one of the locks
   // below the mutator lock, the PC should be somewhere in ART code and should
   // not match any registered generated code range, so such as a deadlock is
   // unlikely. If it happens anyway, the worst case is that an internal ART crash
@@ -51,6 +51,29 @@ static inline bool byte_cas(uint8_t old_value, uint8_t new_value, uint8_t* addre
 #endif
 }
 
+// Return the first word in [word_cur, word_end) that holds a card that is not clean, or word_end.
+// Clean runs are skipped kCardScanWordsPerStep words (32 bytes on 64-bit targets) at a time; the
+// OR reduction below is branch-free and compiles to vector loads and ORs.
+static constexpr size_t kCardScanWordsPerStep = 4;
+
+static inline uintptr_t* FindNonCleanCardWord(uintptr_t* word_cur, uintptr_t* word_end) {
+  static_assert(CardTable::kCardClean == 0);
+  while (static_cast<size_t>(word_end - word_cur) >= kCardScanWordsPerStep) {
+    uintptr_t any_dirty = 0;
+    for (size_t i = 0; i < kCardScanWordsPerStep; ++i) {
+      any_dirty |= word_cur[i];
+    }
+    if (any_dirty != 0) {
+      break;
+    }
+    word_cur += kCardScanWordsPerStep;
+  }
+  while (word_cur < word_end && LIKELY(*word_cur == 0)) {
+    ++word_cur;
+  }
+  return word_cur;
+}
+
 template <bool kClearCard, typename Visitor>
 inline size_t CardTable::Scan(ContinuousSpaceBitmap* bitmap,
                               uint8_t* const scan_begin,
@@ -84,13 +107,10 @@ inline size_t CardTable::Scan(ContinuousSpaceBitmap* bitmap,
     DCHECK_LE(card_cur, aligned_end);
 
     uintptr_t* word_end = reinterpret_cast<uintptr_t*>(aligned_end);
-    for (uintptr_t* word_cur = reinterpret_cast<uintptr_t*>(card_cur); word_cur < word_end;
-        ++word_cur) {
-      while (LIKELY(*word_cur == 0)) {
-        ++word_cur;
-        if (UNLIKELY(word_cur >= word_end)) {
-          goto exit_for;
-        }
+    for (uintptr_t* word_cur = reinterpret_cast<uintptr_t*>(card_cur); ; ++word_cur) {
+      word_cur = FindNonCleanCardWord(word_cur, word_end);
+      if (UNLIKELY(word_cur >= word_end)) {
+        break;
       }
 
       // Find the first dirty card.
@@ -111,7 +131,6 @@ inline size_t CardTable::Scan(ContinuousSpaceBitmap* bitmap,
         start += kCardSize;
       }
     }
-    exit_for:
 
     // Handle any unaligned cards at the end.
     card_cur = reinterpret_cast<uint8_t*>(word_end);
@@ -183,7 +202,11 @@ inline void CardTable::ModifyCardsAtomic(uint8_t* scan_begin,
   };
 
   // TODO: Parallelize.
-  while (word_cur < word_end) {
+  while (true) {
+    word_cur = FindNonCleanCardWord(word_cur, word_end);
+    if (word_cur >= word_end) {
+      break;
+    }
     while (true) {
       expected_word = *word_cur;
       static_assert(kCardClean == 0);
@@ -25,6 +25,7 @@
 #include "mirror/class-inl.h"
 #include "mirror/string-inl.h"  // Strings are easiest to allocate
 #include "scoped_thread_state_change-inl.h"
+#include "space_bitmap-inl.h"
 #include "thread_pool.h"
 
 namespace art HIDDEN {
@@ -65,6 +66,15 @@ class CardTableTest : public CommonArtTest {
     size_t offset = RoundDown(addr - heap_begin_, CardTable::kCardSize);
     return 1 + offset % 254;
   }
+  // The card table is not shared with a runtime here, so the locks required by Scan are moot.
+  template <bool kClearCard, typename Visitor>
+  size_t ScanCards(ContinuousSpaceBitmap* bitmap,
+                   uint8_t* scan_begin,
+                   uint8_t* scan_end,
+                   const Visitor& visitor,
+                   uint8_t minimum_age) NO_THREAD_SAFETY_ANALYSIS {
+    return card_table_->Scan<kClearCard>(bitmap, scan_begin, scan_end, visitor, minimum_age);
+  }
   void FillRandom() {
     for (const uint8_t* addr = HeapBegin(); addr != HeapLimit(); addr += CardTable::kCardSize) {
       EXPECT_TRUE(card_table_->AddrIsInCardTable(addr));
@@ -145,7 +155,87 @@ TEST_F(CardTableTest, TestModifyCardsAtomic) {
   }
 }
 
-// TODO: Add test for CardTable::Scan.
+class CountingVisitor {
+ public:
+  void operator()(mirror::Object* /*obj*/) const {
+    ++count_;
+  }
+  mutable size_t count_ = 0;
+};
+
+TEST_F(CardTableTest, TestScan) {
+  CommonSetup();
+  ContinuousSpaceBitmap bitmap(ContinuousSpaceBitmap::Create(
+      "card table test bitmap", HeapBegin(), HeapLimit() - HeapBegin()));
+  ASSERT_TRUE(bitmap.IsValid());
+  // One object at the start of each card.
+  for (uint8_t* addr = HeapBegin(); addr < HeapLimit(); addr += CardTable::kCardSize) {
+    bitmap.Set(reinterpret_cast<const mirror::Object*>(addr));
+  }
+  // Sparse dirty and aged cards, including runs that straddle the scan step.
+  size_t expected_dirty = 0;
+  size_t expected_aged = 0;
+  size_t index = 0;
+  for (uint8_t* addr = HeapBegin(); addr < HeapLimit(); addr += CardTable::kCardSize, ++index) {
+    if (index % 37 == 0 || (index >= 100 && index < 140)) {
+      *card_table_->CardFromAddr(addr) = CardTable::kCardDirty;
+      ++expected_dirty;
+    } else if (index % 53 == 0) {
+      *card_table_->CardFromAddr(addr) = CardTable::kCardAged;
+      ++expected_aged;
+    }
+  }
+  CountingVisitor visitor;
+  size_t scanned = ScanCards</*kClearCard=*/ false>(
+      &bitmap, HeapBegin(), HeapLimit(), visitor, CardTable::kCardDirty);
+  EXPECT_EQ(scanned, expected_dirty);
+  EXPECT_EQ(visitor.count_, expected_dirty);
+
+  CountingVisitor aged_visitor;
+  scanned = ScanCards</*kClearCard=*/ true>(
+      &bitmap, HeapBegin() + 3 * CardTable::kCardSize, HeapLimit(), aged_visitor,
+      CardTable::kCardAged);
+  // Card 0 (dirty) is outside of the range and none of the cards below 3 are aged.
+  EXPECT_EQ(scanned, expected_dirty + expected_aged - 1);
+  EXPECT_EQ(aged_visitor.count_, scanned);
+  EXPECT_EQ(ScanCards</*kClearCard=*/ false>(
+                &bitmap, HeapBegin() + 3 * CardTable::kCardSize, HeapLimit(), aged_visitor,
+                CardTable::kCardAged),
+            0u);
+}
+
+// Scans skip clean cards several words at a time; check that a lone dirty card is found at
+// every position around such a step, from aligned and unaligned scan starts.
+TEST_F(CardTableTest, ScanSingleDirtyCard) {
+  CommonSetup();
+  ContinuousSpaceBitmap bitmap(ContinuousSpaceBitmap::Create(
+      "card table test bitmap", HeapBegin(), HeapLimit() - HeapBegin()));
+  ASSERT_TRUE(bitmap.IsValid());
+  for (uint8_t* addr = HeapBegin(); addr < HeapLimit(); addr += CardTable::kCardSize) {
+    bitmap.Set(reinterpret_cast<const mirror::Object*>(addr));
+  }
+  const size_t num_cards = (HeapLimit() - HeapBegin()) / CardTable::kCardSize;
+  const size_t kStartCards[] = {0u, 1u, 7u, 8u, 31u, 32u, 33u};
+  for (size_t dirty_card = 0; dirty_card < num_cards; ++dirty_card) {
+    // Cover the first few steps and the tail of the table.
+    if (dirty_card == 160u) {
+      dirty_card = num_cards - 160u;
+    }
+    uint8_t* dirty_addr = HeapBegin() + dirty_card * CardTable::kCardSize;
+    *card_table_->CardFromAddr(dirty_addr) = CardTable::kCardDirty;
+    for (size_t start_card : kStartCards) {
+      CountingVisitor visitor;
+      size_t scanned = ScanCards</*kClearCard=*/ false>(
+          &bitmap, HeapBegin() + start_card * CardTable::kCardSize, HeapLimit(), visitor,
+          CardTable::kCardDirty);
+      size_t expected = (dirty_card >= start_card) ? 1u : 0u;
+      EXPECT_EQ(scanned, expected) << dirty_card << " " << start_card;
+      EXPECT_EQ(visitor.count_, expected) << dirty_card << " " << start_card;
+    }
+    *card_table_->CardFromAddr(dirty_addr) = CardTable::kCardClean;
+  }
+}
+
 }  // namespace accounting
 }  // namespace gc
 }  // namespace art
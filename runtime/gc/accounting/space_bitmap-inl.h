@@ -100,6 +100,27 @@ inline mirror::Object* SpaceBitmap<kAlignment>::FindPrecedingObject(uintptr_t vi
   }
 }
 
+template<size_t kAlignment>
+template<size_t kBatchSize, typename Visitor>
+inline void SpaceBitmap<kAlignment>::VisitMarkedRangeBatched(uintptr_t visit_begin,
+                                                             uintptr_t visit_end,
+                                                             Visitor&& visitor) const {
+  static_assert(kBatchSize > 0);
+  mirror::Object* batch[kBatchSize];
+  size_t count = 0;
+  VisitMarkedRange(visit_begin, visit_end, [&](mirror::Object* obj) {
+    __builtin_prefetch(obj);
+    batch[count++] = obj;
+    if (count == kBatchSize) {
+      visitor(batch, count);
+      count = 0;
+    }
+  });
+  if (count != 0) {
+    visitor(batch, count);
+  }
+}
+
 template<size_t kAlignment>
 template<bool kVisitOnce, typename Visitor>
 inline void SpaceBitmap<kAlignment>::VisitMarkedRange(uintptr_t visit_begin,
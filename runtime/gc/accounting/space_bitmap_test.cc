@@ -18,6 +18,7 @@
 
 #include <stdint.h>
 #include <memory>
+#include <vector>
 
 #include "base/mutex.h"
 #include "common_runtime_test.h"
@@ -245,6 +246,29 @@ TYPED_TEST(SpaceBitmapTest, VisitorAlignment) {
   RunTest<SpaceBitmap>(TypeParam::GetObjectAlignment(), count_test_fn);
 }
 
+TYPED_TEST(SpaceBitmapTest, BatchedVisitor) {
+  using SpaceBitmap = typename TypeParam::SpaceBitmap;
+  auto batched_test_fn = [](SpaceBitmap* space_bitmap,
+                            uintptr_t range_begin,
+                            uintptr_t range_end,
+                            size_t manual_count) {
+    std::vector<mirror::Object*> expected;
+    space_bitmap->VisitMarkedRange(range_begin, range_end, [&expected](mirror::Object* obj) {
+      expected.push_back(obj);
+    });
+    EXPECT_EQ(expected.size(), manual_count);
+    std::vector<mirror::Object*> batched;
+    space_bitmap->template VisitMarkedRangeBatched</*kBatchSize=*/ 7>(
+        range_begin, range_end, [&batched](mirror::Object* const* objects, size_t count) {
+          EXPECT_GT(count, 0u);
+          EXPECT_LE(count, 7u);
+          batched.insert(batched.end(), objects, objects + count);
+        });
+    EXPECT_EQ(batched, expected);
+  };
+  RunTest<SpaceBitmap>(TypeParam::GetObjectAlignment(), batched_test_fn);
+}
+
 TYPED_TEST(SpaceBitmapTest, OrderAlignment) {
   using SpaceBitmap = typename TypeParam::SpaceBitmap;
   auto order_test_fn = [](SpaceBitmap* space_bitmap,
@@ -576,16 +576,24 @@ RosAlloc::Run* RosAlloc::AllocRun(Thread* self, size_t idx) {
   return new_run;
 }
 
-RosAlloc::Run* RosAlloc::RefillRun(Thread* self, size_t idx) {
+RosAlloc::Run* RosAlloc::TakeNonFullRun(size_t idx) {
   // Get the lowest address non-full run from the binary tree.
   auto* const bt = &non_full_runs_[idx];
-  if (!bt->empty()) {
-    // If there's one, use it as the current run.
-    auto it = bt->begin();
-    Run* non_full_run = *it;
-    DCHECK(non_full_run != nullptr);
-    DCHECK(!non_full_run->IsThreadLocal());
-    bt->erase(it);
+  if (bt->empty()) {
+    return nullptr;
+  }
+  auto it = bt->begin();
+  Run* non_full_run = *it;
+  DCHECK(non_full_run != nullptr);
+  DCHECK(!non_full_run->IsThreadLocal());
+  bt->erase(it);
+  return non_full_run;
+}
+
+RosAlloc::Run* RosAlloc::RefillRun(Thread* self, size_t idx) {
+  // If there's a non-full run, use it as the current run.
+  Run* non_full_run = TakeNonFullRun(idx);
+  if (non_full_run != nullptr) {
     return non_full_run;
   }
   // If there's none, allocate a new run and use it as the current run.
@@ -676,41 +684,60 @@ void* RosAlloc::AllocFromRun(Thread* self, size_t size, size_t* bytes_allocated,
     if (UNLIKELY(slot_addr == nullptr)) {
       // The run got full. Try to free slots.
       DCHECK(thread_local_run->IsFull());
-      MutexLock mu(self, *size_bracket_locks_[idx]);
-      bool is_all_free_after_merge;
-      // This is safe to do for the dedicated_full_run_ since the bitmaps are empty.
-      if (thread_local_run->MergeThreadLocalFreeListToFreeList(&is_all_free_after_merge)) {
-        DCHECK_NE(thread_local_run, dedicated_full_run_);
-        // Some slot got freed. Keep it.
-        DCHECK(!thread_local_run->IsFull());
-        DCHECK_EQ(is_all_free_after_merge, thread_local_run->IsAllFree());
-      } else {
-        // No slots got freed. Try to refill the thread-local run.
-        DCHECK(thread_local_run->IsFull());
-        if (thread_local_run != dedicated_full_run_) {
-          thread_local_run->SetIsThreadLocal(false);
-          if (kIsDebugBuild) {
-            full_runs_[idx].insert(thread_local_run);
-            if (kTraceRosAlloc) {
-              LOG(INFO) << "RosAlloc::AllocFromRun() : Inserted run 0x" << std::hex
-                        << reinterpret_cast<intptr_t>(thread_local_run)
-                        << " into full_runs_[" << std::dec << idx << "]";
+      bool needs_new_run = false;
+      {
+        MutexLock mu(self, *size_bracket_locks_[idx]);
+        bool is_all_free_after_merge;
+        // This is safe to do for the dedicated_full_run_ since the bitmaps are empty.
+        if (thread_local_run->MergeThreadLocalFreeListToFreeList(&is_all_free_after_merge)) {
+          DCHECK_NE(thread_local_run, dedicated_full_run_);
+          // Some slot got freed. Keep it.
+          DCHECK(!thread_local_run->IsFull());
+          DCHECK_EQ(is_all_free_after_merge, thread_local_run->IsAllFree());
+        } else {
+          // No slots got freed. Try to refill the thread-local run.
+          DCHECK(thread_local_run->IsFull());
+          if (thread_local_run != dedicated_full_run_) {
+            thread_local_run->SetIsThreadLocal(false);
+            if (kIsDebugBuild) {
+              full_runs_[idx].insert(thread_local_run);
+              if (kTraceRosAlloc) {
+                LOG(INFO) << "RosAlloc::AllocFromRun() : Inserted run 0x" << std::hex
+                          << reinterpret_cast<intptr_t>(thread_local_run)
+                          << " into full_runs_[" << std::dec << idx << "]";
+              }
             }
+            DCHECK(non_full_runs_[idx].find(thread_local_run) == non_full_runs_[idx].end());
+            DCHECK(full_runs_[idx].find(thread_local_run) != full_runs_[idx].end());
           }
-          DCHECK(non_full_runs_[idx].find(thread_local_run) == non_full_runs_[idx].end());
-          DCHECK(full_runs_[idx].find(thread_local_run) != full_runs_[idx].end());
-        }
 
-        thread_local_run = RefillRun(self, idx);
+          thread_local_run = TakeNonFullRun(idx);
+          if (thread_local_run != nullptr) {
+            DCHECK(full_runs_[idx].find(thread_local_run) == full_runs_[idx].end());
+            thread_local_run->SetIsThreadLocal(true);
+            self->SetRosAllocRun(idx, thread_local_run);
+            DCHECK(!thread_local_run->IsFull());
+          } else {
+            // The full run is no longer ours, don't leave it installed while we drop the lock.
+            self->SetRosAllocRun(idx, dedicated_full_run_);
+            needs_new_run = true;
+          }
+        }
+      }
+      if (needs_new_run) {
+        // Allocating a new run takes the page lock and initializes the free list of the whole
+        // run. Do it without holding the bracket lock so that other threads of this size bracket,
+        // which only need to reuse or merge runs, are not held up behind us. The new run is not
+        // visible to anyone else until we install it.
+        thread_local_run = AllocRun(self, idx);
         if (UNLIKELY(thread_local_run == nullptr)) {
-          self->SetRosAllocRun(idx, dedicated_full_run_);
           return nullptr;
         }
+        MutexLock mu(self, *size_bracket_locks_[idx]);
         DCHECK(non_full_runs_[idx].find(thread_local_run) == non_full_runs_[idx].end());
         DCHECK(full_runs_[idx].find(thread_local_run) == full_runs_[idx].end());
         thread_local_run->SetIsThreadLocal(true);
         self->SetRosAllocRun(idx, thread_local_run);
-        DCHECK(!thread_local_run->IsFull());
       }
       DCHECK(thread_local_run != nullptr);
       DCHECK(!thread_local_run->IsFull());
@@ -804,6 +804,10 @@ class RosAlloc {
   // thread-local or current run gets full.
   Run* RefillRun(Thread* self, size_t idx) REQUIRES(!lock_);
 
+  // Removes and returns the lowest address run from non_full_runs_[idx], or null if there is
+  // none. The caller must hold size_bracket_locks_[idx].
+  Run* TakeNonFullRun(size_t idx);
+
   // The internal of non-bulk Free().
   size_t FreeInternal(Thread* self, void* ptr) REQUIRES(!lock_);
 
@@ -1481,42 +1481,57 @@ void ConcurrentCopying::CopyingPhase() {
       //   which is an immune space.
       // - In the case where we run without a boot image, these classes are allocated in the
       //   non-moving space (see art::ClassLinker::InitWithoutImage).
-      card_table->Scan<false>(
-          space->GetMarkBitmap(),
-          space->Begin(),
-          space->End(),
-          [this, space](mirror::Object* obj)
-              REQUIRES(Locks::heap_bitmap_lock_)
-              REQUIRES_SHARED(Locks::mutator_lock_) {
-            // TODO: This code may be refactored to avoid scanning object while
-            // done_scanning_ is false by setting rb_state to gray, and pushing the
-            // object on mark stack. However, it will also require clearing the
-            // corresponding mark-bit and, for region space objects,
-            // decrementing the object's size from the corresponding region's
-            // live_bytes.
-            if (young_gen_) {
-              // Don't push or gray unevac refs.
-              if (kIsDebugBuild && space == region_space_) {
-                // We may get unevac large objects.
-                if (!region_space_->IsInUnevacFromSpace(obj)) {
-                  CHECK(region_space_bitmap_->Test(obj));
-                  region_space_->DumpRegionForObject(LOG_STREAM(FATAL_WITHOUT_ABORT), obj);
-                  LOG(FATAL) << "Scanning " << obj << " not in unevac space";
-                }
-              }
-              ScanDirtyObject</*kNoUnEvac*/ true>(obj);
-            } else if (space != region_space_) {
-              DCHECK(space == heap_->non_moving_space_);
-              // We need to process un-evac references as they may be unprocessed,
-              // if they skipped the marking phase due to heap mutation.
-              ScanDirtyObject</*kNoUnEvac*/ false>(obj);
-              non_moving_space_inter_region_bitmap_.Clear(obj);
-            } else if (region_space_->IsInUnevacFromSpace(obj)) {
-              ScanDirtyObject</*kNoUnEvac*/ false>(obj);
-              region_space_inter_region_bitmap_.Clear(obj);
+      auto scan_dirty_object = [this, space](mirror::Object* obj)
+          REQUIRES(Locks::heap_bitmap_lock_)
+          REQUIRES_SHARED(Locks::mutator_lock_) {
+        // TODO: This code may be refactored to avoid scanning object while
+        // done_scanning_ is false by setting rb_state to gray, and pushing the
+        // object on mark stack. However, it will also require clearing the
+        // corresponding mark-bit and, for region space objects,
+        // decrementing the object's size from the corresponding region's
+        // live_bytes.
+        if (young_gen_) {
+          // Don't push or gray unevac refs.
+          if (kIsDebugBuild && space == region_space_) {
+            // We may get unevac large objects.
+            if (!region_space_->IsInUnevacFromSpace(obj)) {
+              CHECK(region_space_bitmap_->Test(obj));
+              region_space_->DumpRegionForObject(LOG_STREAM(FATAL_WITHOUT_ABORT), obj);
+              LOG(FATAL) << "Scanning " << obj << " not in unevac space";
             }
-          },
-          accounting::CardTable::kCardAged);
+          }
+          ScanDirtyObject</*kNoUnEvac*/ true>(obj);
+        } else if (space != region_space_) {
+          DCHECK(space == heap_->non_moving_space_);
+          // We need to process un-evac references as they may be unprocessed,
+          // if they skipped the marking phase due to heap mutation.
+          ScanDirtyObject</*kNoUnEvac*/ false>(obj);
+          non_moving_space_inter_region_bitmap_.Clear(obj);
+        } else if (region_space_->IsInUnevacFromSpace(obj)) {
+          ScanDirtyObject</*kNoUnEvac*/ false>(obj);
+          region_space_inter_region_bitmap_.Clear(obj);
+        }
+      };
+      if (young_gen_ && space == region_space_) {
+        // Only unevac regions have marked objects in a young collection. Skip the cards of all
+        // other regions (newly allocated, evacuated and free), which in a large region space
+        // are most of its cards.
+        region_space_->VisitUnevacFromSpaceBlocks(
+            [&](uint8_t* block_begin, uint8_t* block_end)
+                REQUIRES(Locks::heap_bitmap_lock_) REQUIRES_SHARED(Locks::mutator_lock_) {
+              card_table->Scan<false>(space->GetMarkBitmap(),
+                                      block_begin,
+                                      block_end,
+                                      scan_dirty_object,
+                                      accounting::CardTable::kCardAged);
+            });
+      } else {
+        card_table->Scan<false>(space->GetMarkBitmap(),
+                                space->Begin(),
+                                space->End(),
+                                scan_dirty_object,
+                                accounting::CardTable::kCardAged);
+      }
 
       if (!young_gen_) {
         auto visitor = [this](mirror::Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
@@ -1684,6 +1699,11 @@ void ConcurrentCopying::CopyingPhase() {
     MutexLock mu(self, *Locks::thread_list_lock_);
     CHECK(weak_ref_access_enabled_);
   }
+  TraceGCMetric("scanned_bytes", bytes_scanned_);
+  TraceGCMetric("copied_bytes",
+                bytes_moved_.load(std::memory_order_relaxed) + bytes_moved_gc_thread_);
+  TraceGCMetric("copied_objects",
+                objects_moved_.load(std::memory_order_relaxed) + objects_moved_gc_thread_);
   if (kVerboseMode) {
     LOG(INFO) << "GC end of CopyingPhase";
   }
@@ -2709,12 +2729,19 @@ void ConcurrentCopying::ReclaimPhase() {
       // RegionSpace::ClearFromSpace may clear empty unevac regions.
       CHECK_GE(cleared_bytes, from_bytes);
     }
+    if (region_space_->IsSurvivalTrackingEnabled()) {
+      int32_t young_survival_percent = region_space_->GetLastYoungSurvivalPercent();
+      if (young_survival_percent >= 0) {
+        GetMetrics()->YoungObjectSurvivalRate()->Add(young_survival_percent);
+      }
+    }
 
     // If we need to release available memory to the OS, go over all free
-    // regions which the kernel might still cache.
+    // regions which the kernel might still cache. This is usually left to the
+    // heap task daemon, to keep the madvise calls off the GC thread.
     if (should_eagerly_release_memory) {
       TimingLogger::ScopedTiming split4("Release free regions", GetTimings());
-      region_space_->ReleaseFreeRegions();
+      heap_->RequestReleaseFreeRegions(self, GetCurrentIteration()->GetGcCause());
     }
 
     // freed_bytes could conceivably be negative if we fall back to nonmoving space and have to
@@ -3502,6 +3529,9 @@ mirror::Object* ConcurrentCopying::Copy(Thread* const self,
         objects_moved_.fetch_add(1, std::memory_order_relaxed);
         bytes_moved_.fetch_add(bytes_allocated, std::memory_order_relaxed);
       }
+      if (UNLIKELY(region_space_->IsSurvivalTrackingEnabled())) {
+        region_space_->RecordEvacuatedSurvivor(from_ref, region_space_alloc_size);
+      }
 
       if (LIKELY(!fall_back_to_non_moving)) {
         DCHECK(region_space_->IsInToSpace(to_ref));
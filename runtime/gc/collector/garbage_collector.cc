@@ -42,10 +42,8 @@ namespace art HIDDEN {
 namespace gc {
 namespace collector {
 
-namespace {
-
 // Report a GC metric via the ATrace interface.
-void TraceGCMetric(const char* name, int64_t value) {
+void GarbageCollector::TraceGCMetric(const char* name, int64_t value) {
   // ART's interface with systrace (through libartpalette) only supports
   // reporting 32-bit (signed) integer values at the moment. Upon
   // underflows/overflows, clamp metric values at `int32_t` min/max limits and
@@ -84,8 +82,6 @@ void TraceGCMetric(const char* name, int64_t value) {
   ATraceIntegerValue(name, value);
 }
 
-}  // namespace
-
 Iteration::Iteration()
     : duration_ns_(0), timings_("GC iteration timing logger", true, VLOG_IS_ON(heap)) {
   Reset(kGcCauseBackground, false);  // Reset to some place holder values.
@@ -136,6 +132,7 @@ GarbageCollector::GarbageCollector(Heap* heap, const std::string& name)
 
 void GarbageCollector::RegisterPause(uint64_t nano_length) {
   GetCurrentIteration()->pause_times_.push_back(nano_length);
+  TraceGCMetric("pause_time_us", static_cast<int64_t>(nano_length / 1000));
 }
 
 uint64_t GarbageCollector::ExtractRssFromMincore(
@@ -155,6 +155,10 @@ class GarbageCollector : public RootVisitor, public IsMarkedVisitor, public Mark
   bool ShouldEagerlyReleaseMemoryToOS() const;
 
  protected:
+  // Report a per-phase GC counter (e.g. bytes copied) as a Perfetto track via ATrace, next to the
+  // phase slices emitted by the TimingLogger.
+  static void TraceGCMetric(const char* name, int64_t value);
+
   // Run all of the GC phases.
   virtual void RunPhases() REQUIRES(!Locks::mutator_lock_) = 0;
   // Revoke all the thread-local buffers.
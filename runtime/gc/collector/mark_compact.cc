@@ -39,6 +39,7 @@
 #include "android-base/parseint.h"
 #include "android-base/properties.h"
 #include "android-base/strings.h"
+#include "base/bounded_fifo.h"
 #include "base/file_utils.h"
 #include "base/memfd.h"
 #include "base/quasi_atomic.h"
@@ -447,6 +448,11 @@ MarkCompact::MarkCompact(Heap* heap)
       moving_space_bitmap_(bump_pointer_space_->GetMarkBitmap()),
       moving_space_begin_(bump_pointer_space_->Begin()),
       moving_space_end_(bump_pointer_space_->Limit()),
+      old_gen_end_(moving_space_begin_),
+      young_gen_allocated_bytes_total_(0),
+      young_gen_survived_bytes_total_(0),
+      old_gen_bytes_total_(0),
+      old_gen_live_bytes_total_(0),
       uffd_(kFdUnused),
       sigbus_in_progress_count_{kSigbusCounterCompactionDoneMask, kSigbusCounterCompactionDoneMask},
       compacting_(false),
@@ -951,6 +957,7 @@ void MarkCompact::PrepareForCompaction() {
   }
   InitMovingSpaceFirstObjects(vector_len);
   InitNonMovingSpaceFirstObjects();
+  UpdateGenerationStats(vector_len);
 
   // TODO: We can do a lot of neat tricks with this offset vector to tune the
   // compaction as we wish. Originally, the compaction algorithm slides all
@@ -1013,6 +1020,24 @@ void MarkCompact::PrepareForCompaction() {
   }
 }
 
+void MarkCompact::UpdateGenerationStats(const size_t vec_len) {
+  uint8_t* space_begin = bump_pointer_space_->Begin();
+  // The space may have shrunk since the last GC (zygote compaction or growth
+  // limit clamping). Anything beyond the current marking-pause end is young.
+  uint8_t* old_gen_end = std::min(old_gen_end_, black_allocations_begin_);
+  DCHECK_ALIGNED_PARAM(old_gen_end - space_begin, kOffsetChunkSize);
+  size_t old_gen_chunks = (old_gen_end - space_begin) / kOffsetChunkSize;
+  DCHECK_LE(old_gen_chunks, vec_len);
+  uint64_t old_gen_live_bytes =
+      std::accumulate(chunk_info_vec_, chunk_info_vec_ + old_gen_chunks, static_cast<uint64_t>(0));
+  uint64_t young_gen_live_bytes = std::accumulate(
+      chunk_info_vec_ + old_gen_chunks, chunk_info_vec_ + vec_len, static_cast<uint64_t>(0));
+  old_gen_bytes_total_ += old_gen_end - space_begin;
+  old_gen_live_bytes_total_ += old_gen_live_bytes;
+  young_gen_allocated_bytes_total_ += black_allocations_begin_ - old_gen_end;
+  young_gen_survived_bytes_total_ += young_gen_live_bytes;
+}
+
 class MarkCompact::VerifyRootMarkedVisitor : public SingleRootVisitor {
  public:
   explicit VerifyRootMarkedVisitor(MarkCompact* collector) : collector_(collector) { }
@@ -2171,29 +2196,35 @@ void MarkCompact::UpdateNonMovingPage(mirror::Object* first, uint8_t* page) {
   // TODO: Set kVisitNativeRoots to false once we implement concurrent
   // compaction
   mirror::Object* curr_obj = first;
-  non_moving_space_bitmap_->VisitMarkedRange(
+  auto visit_next = [&](mirror::Object* next_obj) REQUIRES_SHARED(Locks::mutator_lock_) {
+    // TODO: Once non-moving space update becomes concurrent, we'll
+    // require fetching the from-space address of 'curr_obj' and then call
+    // visitor on that.
+    if (reinterpret_cast<uint8_t*>(curr_obj) < page) {
+      RefsUpdateVisitor</*kCheckBegin*/true, /*kCheckEnd*/false>
+              visitor(this, curr_obj, page, page + gPageSize);
+      MemberOffset begin_offset(page - reinterpret_cast<uint8_t*>(curr_obj));
+      // Native roots shouldn't be visited as they are done when this
+      // object's beginning was visited in the preceding page.
+      curr_obj->VisitRefsForCompaction</*kFetchObjSize*/false, /*kVisitNativeRoots*/false>(
+              visitor, begin_offset, MemberOffset(-1));
+    } else {
+      RefsUpdateVisitor</*kCheckBegin*/false, /*kCheckEnd*/false>
+              visitor(this, curr_obj, page, page + gPageSize);
+      curr_obj->VisitRefsForCompaction</*kFetchObjSize*/false>(visitor,
+                                                               MemberOffset(0),
+                                                               MemberOffset(-1));
+    }
+    curr_obj = next_obj;
+  };
+  // The batched visit prefetches the headers of the objects in the page ahead of updating them.
+  non_moving_space_bitmap_->VisitMarkedRangeBatched(
           reinterpret_cast<uintptr_t>(first) + mirror::kObjectHeaderSize,
           reinterpret_cast<uintptr_t>(page + gPageSize),
-          [&](mirror::Object* next_obj) {
-            // TODO: Once non-moving space update becomes concurrent, we'll
-            // require fetching the from-space address of 'curr_obj' and then call
-            // visitor on that.
-            if (reinterpret_cast<uint8_t*>(curr_obj) < page) {
-              RefsUpdateVisitor</*kCheckBegin*/true, /*kCheckEnd*/false>
-                      visitor(this, curr_obj, page, page + gPageSize);
-              MemberOffset begin_offset(page - reinterpret_cast<uint8_t*>(curr_obj));
-              // Native roots shouldn't be visited as they are done when this
-              // object's beginning was visited in the preceding page.
-              curr_obj->VisitRefsForCompaction</*kFetchObjSize*/false, /*kVisitNativeRoots*/false>(
-                      visitor, begin_offset, MemberOffset(-1));
-            } else {
-              RefsUpdateVisitor</*kCheckBegin*/false, /*kCheckEnd*/false>
-                      visitor(this, curr_obj, page, page + gPageSize);
-              curr_obj->VisitRefsForCompaction</*kFetchObjSize*/false>(visitor,
-                                                                       MemberOffset(0),
-                                                                       MemberOffset(-1));
+          [&](mirror::Object* const* objects, size_t count) REQUIRES_SHARED(Locks::mutator_lock_) {
+            for (size_t i = 0; i < count; ++i) {
+              visit_next(objects[i]);
             }
-            curr_obj = next_obj;
           });
 
   MemberOffset end_offset(page + gPageSize - reinterpret_cast<uint8_t*>(curr_obj));
@@ -3488,6 +3519,9 @@ void MarkCompact::CompactionPhase() {
     int32_t freed_bytes = black_objs_slide_diff_;
     bump_pointer_space_->RecordFree(freed_objects_, freed_bytes);
     RecordFree(ObjectBytePair(freed_objects_, freed_bytes));
+    // Marking is complete by now; report it together with what compaction is about to free.
+    TraceGCMetric("scanned_bytes", bytes_scanned_);
+    TraceGCMetric("compaction_freed_bytes", freed_bytes);
   }
 
   CompactMovingSpace<kCopyMode>(compaction_buffers_map_.Begin());
@@ -3907,10 +3941,22 @@ void MarkCompact::ScanObject(mirror::Object* obj) {
 // Scan anything that's on the mark stack.
 void MarkCompact::ProcessMarkStack() {
   TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
-  // TODO: try prefetch like in CMS
-  while (!mark_stack_->IsEmpty()) {
-    mirror::Object* obj = mark_stack_->PopBack();
-    DCHECK(obj != nullptr);
+  // Keep a few objects in flight so that the cache miss on an object's header
+  // (needed for its class and size) overlaps with scanning its predecessors.
+  static constexpr size_t kFifoSize = 4;
+  BoundedFifoPowerOfTwo<mirror::Object*, kFifoSize> prefetch_fifo;
+  while (true) {
+    while (!mark_stack_->IsEmpty() && prefetch_fifo.size() < kFifoSize) {
+      mirror::Object* obj = mark_stack_->PopBack();
+      DCHECK(obj != nullptr);
+      __builtin_prefetch(obj);
+      prefetch_fifo.push_back(obj);
+    }
+    if (prefetch_fifo.empty()) {
+      break;
+    }
+    mirror::Object* obj = prefetch_fifo.front();
+    prefetch_fifo.pop_front();
     ScanObject</*kUpdateLiveWords*/ true>(obj);
   }
 }
@@ -4096,6 +4142,9 @@ void MarkCompact::FinishPhase() {
   GetCurrentIteration()->SetScannedBytes(bytes_scanned_);
   bool is_zygote = Runtime::Current()->IsZygote();
   compacting_ = false;
+  // Everything compacted in this cycle is old for the next one. Black
+  // allocations slid past post_compact_end_ haven't survived a GC yet.
+  old_gen_end_ = post_compact_end_;
   marking_done_ = false;
 
   ZeroAndReleaseMemory(compaction_buffers_map_.Begin(), compaction_buffers_map_.Size());
@@ -4134,6 +4183,22 @@ void MarkCompact::FinishPhase() {
   arena_pool->DeleteUnusedArenas();
 }
 
+void MarkCompact::DumpPerformanceInfo(std::ostream& os) {
+  GarbageCollector::DumpPerformanceInfo(os);
+  if (young_gen_allocated_bytes_total_ > 0) {
+    os << "Young-gen survival rate "
+       << static_cast<double>(young_gen_survived_bytes_total_) / young_gen_allocated_bytes_total_
+       << " (" << PrettySize(young_gen_survived_bytes_total_) << " of "
+       << PrettySize(young_gen_allocated_bytes_total_) << ")\n";
+  }
+  if (old_gen_bytes_total_ > 0) {
+    os << "Old-gen live bytes ratio "
+       << static_cast<double>(old_gen_live_bytes_total_) / old_gen_bytes_total_
+       << " (" << PrettySize(old_gen_live_bytes_total_) << " of "
+       << PrettySize(old_gen_bytes_total_) << ")\n";
+  }
+}
+
 }  // namespace collector
 }  // namespace gc
 }  // namespace art
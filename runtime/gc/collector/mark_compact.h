@@ -122,6 +122,8 @@ class MarkCompact final : public GarbageCollector {
 
   void RevokeAllThreadLocalBuffers() override;
 
+  void DumpPerformanceInfo(std::ostream& os) override REQUIRES(!pause_histogram_lock_);
+
   void DelayReferenceReferent(ObjPtr<mirror::Class> klass,
                               ObjPtr<mirror::Reference> reference) override
       REQUIRES_SHARED(Locks::mutator_lock_, Locks::heap_bitmap_lock_);
@@ -371,6 +373,10 @@ class MarkCompact final : public GarbageCollector {
   // beginning. Store the computed first-object and offset in first_objs_moving_space_
   // and pre_compact_offset_moving_space_ respectively.
   void InitMovingSpaceFirstObjects(const size_t vec_len) REQUIRES_SHARED(Locks::mutator_lock_);
+  // Split the live bytes accumulated in chunk_info_vec_ (which must not have
+  // been prefix-summed yet) into those of the old and the young generation,
+  // and add them to the cumulative generation statistics.
+  void UpdateGenerationStats(const size_t vec_len);
 
   // Gather the info related to black allocations from bump-pointer space to
   // enable concurrent sliding of these pages.
@@ -741,6 +747,18 @@ class MarkCompact final : public GarbageCollector {
   // Cache (black_allocations_begin_ - post_compact_end_) for post-compact
   // address computations.
   ptrdiff_t black_objs_slide_diff_;
+  // End of the compacted part of the moving space as of the end of the
+  // previous GC cycle. Objects below it have survived at least one GC (old
+  // generation), while everything allocated since then lies above it (young
+  // generation). Aligned up to page size.
+  uint8_t* old_gen_end_;
+  // Cumulative bytes allocated in, and bytes surviving from, the young
+  // generation. Their ratio is the young-generation survival rate.
+  uint64_t young_gen_allocated_bytes_total_;
+  uint64_t young_gen_survived_bytes_total_;
+  // Cumulative size of, and live bytes in, the old generation.
+  uint64_t old_gen_bytes_total_;
+  uint64_t old_gen_live_bytes_total_;
   // Cache (from_space_begin_ - bump_pointer_space_->Begin()) so that we can
   // compute from-space address of a given pre-comapct addr efficiently.
   ptrdiff_t from_space_slide_diff_;
@@ -64,6 +64,10 @@ static constexpr bool kParallelRecursiveMark = true;
 // ProcessMarkStack with very small mark stacks.
 static constexpr size_t kMinimumParallelMarkStackSize = 128;
 static constexpr bool kParallelProcessMarkStack = true;
+// Sweep the alloc spaces and the large object space with the GC thread pool. Each task sweeps at
+// least kMinimumParallelSweepChunkSize bytes of one space.
+static constexpr bool kParallelSweep = true;
+static constexpr size_t kMinimumParallelSweepChunkSize = 4 * MB;
 
 // Profiling and information flags.
 static constexpr bool kProfileLargeObjects = false;
@@ -784,6 +788,7 @@ class MarkSweep::MarkStackTask : public Task {
   // Scans all of the objects
   void Run([[maybe_unused]] Thread* self) override REQUIRES(Locks::heap_bitmap_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_) {
+    ScopedTrace trace("MarkStackTask");
     ScanObjectParallelVisitor visitor(this);
     // TODO: Tune this.
     static const size_t kFifoSize = 4;
@@ -844,6 +849,7 @@ class MarkSweep::CardScanTask : public MarkStackTask<false> {
   }
 
   void Run(Thread* self) override NO_THREAD_SAFETY_ANALYSIS {
+    ScopedTrace trace("CardScanTask");
     ScanObjectParallelVisitor visitor(this);
     accounting::CardTable* card_table = mark_sweep_->GetHeap()->GetCardTable();
     size_t cards_scanned = clear_card_
@@ -999,8 +1005,17 @@ class MarkSweep::RecursiveMarkTask : public MarkStackTask<false> {
 
   // Scans all of the objects
   void Run(Thread* self) override NO_THREAD_SAFETY_ANALYSIS {
+    ScopedTrace trace("RecursiveMarkTask");
     ScanObjectParallelVisitor visitor(this);
-    bitmap_->VisitMarkedRange(begin_, end_, visitor);
+    bitmap_->VisitMarkedRangeBatched(
+        begin_,
+        end_,
+        [&visitor](mirror::Object* const* objects, size_t count)
+            REQUIRES(Locks::heap_bitmap_lock_) REQUIRES_SHARED(Locks::mutator_lock_) {
+          for (size_t i = 0; i < count; ++i) {
+            visitor(objects[i]);
+          }
+        });
     // Finish by emptying our local mark stack.
     MarkStackTask::Run(self);
   }
@@ -1058,7 +1073,15 @@ void MarkSweep::RecursiveMark() {
           // This function does not handle heap end increasing, so we must use the space end.
           uintptr_t begin = reinterpret_cast<uintptr_t>(space->Begin());
           uintptr_t end = reinterpret_cast<uintptr_t>(space->End());
-          current_space_bitmap_->VisitMarkedRange(begin, end, scan_visitor);
+          current_space_bitmap_->VisitMarkedRangeBatched(
+              begin,
+              end,
+              [&scan_visitor](mirror::Object* const* objects, size_t count)
+                  REQUIRES(Locks::heap_bitmap_lock_) REQUIRES_SHARED(Locks::mutator_lock_) {
+                for (size_t i = 0; i < count; ++i) {
+                  scan_visitor(objects[i]);
+                }
+              });
         }
       }
     }
@@ -1216,6 +1239,118 @@ void MarkSweep::SweepArray(accounting::ObjectStack* obj_arr, bool swap_bitmaps)
   GarbageCollector::SweepArray(obj_arr, swap_bitmaps, &sweep_spaces);
 }
 
+class MarkSweep::SweepTask : public Task {
+ public:
+  SweepTask(space::ContinuousMemMapAllocSpace* alloc_space,
+            space::LargeObjectSpace* los,
+            uintptr_t begin,
+            uintptr_t end,
+            bool swap_bitmaps,
+            Thread* gc_thread)
+      : alloc_space_(alloc_space),
+        los_(los),
+        begin_(begin),
+        end_(end),
+        swap_bitmaps_(swap_bitmaps),
+        gc_thread_(gc_thread) {
+    DCHECK_NE(alloc_space_ == nullptr, los_ == nullptr);
+  }
+
+  bool IsLargeObjectSweep() const {
+    return los_ != nullptr;
+  }
+
+  const ObjectBytePair& GetFreed() const {
+    return freed_;
+  }
+
+ private:
+  space::ContinuousMemMapAllocSpace* const alloc_space_;
+  space::LargeObjectSpace* const los_;
+  const uintptr_t begin_;
+  const uintptr_t end_;
+  const bool swap_bitmaps_;
+  Thread* const gc_thread_;
+  ObjectBytePair freed_;
+
+  // The tasks are owned by MarkSweep::SweepParallel().
+  void Finalize() override {}
+
+  // The GC thread holds the heap bitmap lock exclusively on our behalf.
+  void Run([[maybe_unused]] Thread* self) override NO_THREAD_SAFETY_ANALYSIS {
+    ScopedTrace trace("SweepTask");
+    freed_ = IsLargeObjectSweep()
+        ? los_->SweepRange(swap_bitmaps_, begin_, end_, gc_thread_)
+        : alloc_space_->SweepRange(swap_bitmaps_, begin_, end_, gc_thread_);
+  }
+};
+
+// Split [begin, end) into at most `max_chunks` chunks of at least kMinimumParallelSweepChunkSize
+// bytes. Chunk bounds fall on `Bitmap` word boundaries so that no two chunks share a bitmap word.
+template <typename Bitmap, typename Visitor>
+static void ForEachSweepChunk(const Bitmap* bitmap,
+                              uintptr_t begin,
+                              uintptr_t end,
+                              size_t max_chunks,
+                              const Visitor& visitor) {
+  const uintptr_t word_span = Bitmap::IndexToOffset(static_cast<uintptr_t>(1));
+  const uintptr_t heap_begin = bitmap->HeapBegin();
+  const uintptr_t chunk_size = std::max<uintptr_t>((end - begin + max_chunks - 1) / max_chunks,
+                                                   kMinimumParallelSweepChunkSize);
+  for (uintptr_t chunk_begin = begin; chunk_begin < end;) {
+    uintptr_t chunk_end = heap_begin + RoundUp(chunk_begin - heap_begin + chunk_size, word_span);
+    chunk_end = std::min(chunk_end, end);
+    visitor(chunk_begin, chunk_end);
+    chunk_begin = chunk_end;
+  }
+}
+
+void MarkSweep::SweepParallel(bool swap_bitmaps, size_t thread_count) {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  Thread* self = Thread::Current();
+  ThreadPool* thread_pool = GetHeap()->GetThreadPool();
+  std::vector<std::unique_ptr<SweepTask>> tasks;
+  for (const auto& space : GetHeap()->GetContinuousSpaces()) {
+    if (space->IsContinuousMemMapAllocSpace()) {
+      space::ContinuousMemMapAllocSpace* alloc_space = space->AsContinuousMemMapAllocSpace();
+      ForEachSweepChunk(alloc_space->GetLiveBitmap(),
+                        reinterpret_cast<uintptr_t>(alloc_space->Begin()),
+                        reinterpret_cast<uintptr_t>(alloc_space->End()),
+                        thread_count,
+                        [&](uintptr_t begin, uintptr_t end) {
+                          tasks.emplace_back(new SweepTask(
+                              alloc_space, nullptr, begin, end, swap_bitmaps, self));
+                        });
+    }
+  }
+  space::LargeObjectSpace* los = GetHeap()->GetLargeObjectsSpace();
+  if (los != nullptr && los->Begin() < los->End()) {
+    std::pair<uint8_t*, uint8_t*> range = los->GetBeginEndAtomic();
+    ForEachSweepChunk(los->GetLiveBitmap(),
+                      reinterpret_cast<uintptr_t>(range.first),
+                      reinterpret_cast<uintptr_t>(range.second),
+                      thread_count,
+                      [&](uintptr_t begin, uintptr_t end) {
+                        tasks.emplace_back(
+                            new SweepTask(nullptr, los, begin, end, swap_bitmaps, self));
+                      });
+  }
+  for (const std::unique_ptr<SweepTask>& task : tasks) {
+    thread_pool->AddTask(self, task.get());
+  }
+  thread_pool->SetMaxActiveWorkers(thread_count - 1);
+  thread_pool->StartWorkers(self);
+  thread_pool->Wait(self, true, true);
+  thread_pool->StopWorkers(self);
+  for (const std::unique_ptr<SweepTask>& task : tasks) {
+    if (task->IsLargeObjectSweep()) {
+      RecordFreeLOS(task->GetFreed());
+    } else {
+      RecordFree(task->GetFreed());
+    }
+  }
+}
+
 void MarkSweep::Sweep(bool swap_bitmaps) {
   TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
   // Ensure that nobody inserted items in the live stack after we swapped the stacks.
@@ -1229,6 +1364,11 @@ void MarkSweep::Sweep(bool swap_bitmaps) {
     live_stack->Reset();
     DCHECK(mark_stack_->IsEmpty());
   }
+  const size_t thread_count = GetThreadCount(false);
+  if (kParallelSweep && thread_count > 1) {
+    SweepParallel(swap_bitmaps, thread_count);
+    return;
+  }
   for (const auto& space : GetHeap()->GetContinuousSpaces()) {
     if (space->IsContinuousMemMapAllocSpace()) {
       space::ContinuousMemMapAllocSpace* alloc_space = space->AsContinuousMemMapAllocSpace();
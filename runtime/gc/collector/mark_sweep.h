@@ -146,6 +146,11 @@ class MarkSweep : public GarbageCollector {
   // Sweeps unmarked objects to complete the garbage collection.
   void SweepLargeObjects(bool swap_bitmaps) REQUIRES(Locks::heap_bitmap_lock_);
 
+  // Sweeps the alloc spaces and the large object space in chunks, using the GC thread pool.
+  void SweepParallel(bool swap_bitmaps, size_t thread_count)
+      REQUIRES(Locks::heap_bitmap_lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   void SweepArray(accounting::ObjectStack* obj_arr, bool swap_bitmaps)
       REQUIRES(Locks::heap_bitmap_lock_) REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -350,6 +355,7 @@ class MarkSweep : public GarbageCollector {
   class RecursiveMarkTask;
   class ScanObjectParallelVisitor;
   class ScanObjectVisitor;
+  class SweepTask;
   class VerifyRootMarkedVisitor;
   class VerifyRootVisitor;
   class VerifySystemWeakVisitor;
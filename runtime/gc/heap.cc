@@ -157,6 +157,10 @@ static double GetStickyGcThroughputAdjustment(bool use_generational_cc) {
 }
 // Whether or not we compact the zygote in PreZygoteFork.
 static constexpr bool kCompactZygote = kMovingCollector;
+// Whether the zygote compaction looks for free bins of the non-moving space in parallel, with a
+// temporary thread pool. Each thread walks at least kMinZygoteBinsChunkSize bytes of the space.
+static constexpr bool kParallelZygoteBins = true;
+static constexpr size_t kMinZygoteBinsChunkSize = 4 * MB;
 // How many reserve entries are at the end of the allocation stack, these are only needed if the
 // allocation stack overflows.
 static constexpr size_t kAllocationStackReserveSize = 1024;
@@ -201,6 +205,15 @@ static constexpr bool kLogAllGCs = false;
 // allocate with relaxed ergonomics for that long.
 static constexpr size_t kPostForkMaxHeapDurationMS = 2000;
 
+// Number of inflated monitors above which Trim() deflates monitors even when we care about pause
+// times. Monitors of objects that were only briefly contended otherwise stay inflated for as long
+// as the process stays in a jank perceptible state.
+static constexpr size_t kForegroundMonitorDeflationThreshold = 4096;
+// Once above the threshold, the number of monitors must also have grown by this much since the
+// last deflation. Monitors still in use stay inflated, so without this an app holding more
+// than the threshold would pay for a pause on every trim without deflating anything.
+static constexpr size_t kForegroundMonitorDeflationGrowth = 1024;
+
 #if defined(__LP64__) || !defined(ADDRESS_SANITIZER)
 // 320 MB (0x14000000) - (default non-moving space capacity).
 // The value is picked to ensure it is aligned to the largest supported PMD
@@ -297,6 +310,7 @@ Heap::Heap(size_t initial_size,
            bool low_memory_mode,
            size_t long_pause_log_threshold,
            size_t long_gc_log_threshold,
+           uint64_t pause_target_ns,
            bool ignore_target_footprint,
            bool always_log_explicit_gcs,
            bool use_tlab,
@@ -312,7 +326,9 @@ Heap::Heap(size_t initial_size,
            bool use_generational_cc,
            uint64_t min_interval_homogeneous_space_compaction_by_oom,
            bool dump_region_info_before_gc,
-           bool dump_region_info_after_gc)
+           bool dump_region_info_after_gc,
+           bool use_transparent_huge_pages,
+           bool use_numa_aware_region_allocation)
     : non_moving_space_(nullptr),
       rosalloc_space_(nullptr),
       dlmalloc_space_(nullptr),
@@ -327,11 +343,13 @@ Heap::Heap(size_t initial_size,
       low_memory_mode_(low_memory_mode),
       long_pause_log_threshold_(long_pause_log_threshold),
       long_gc_log_threshold_(long_gc_log_threshold),
+      pause_target_ns_(pause_target_ns),
       process_cpu_start_time_ns_(ProcessCpuNanoTime()),
       pre_gc_last_process_cpu_time_ns_(process_cpu_start_time_ns_),
       post_gc_last_process_cpu_time_ns_(process_cpu_start_time_ns_),
       pre_gc_weighted_allocated_bytes_(0.0),
       post_gc_weighted_allocated_bytes_(0.0),
+      last_dlmalloc_trim_ns_(NanoTime()),
       ignore_target_footprint_(ignore_target_footprint),
       always_log_explicit_gcs_(always_log_explicit_gcs),
       zygote_creation_lock_("zygote creation lock", kZygoteCreationLock),
@@ -391,6 +409,9 @@ Heap::Heap(size_t initial_size,
       max_free_(max_free),
       target_utilization_(target_utilization),
       foreground_heap_growth_multiplier_(foreground_heap_growth_multiplier),
+      pause_target_scale_(1.0),
+      non_sticky_gc_over_pause_target_(false),
+      pause_target_last_wait_time_(0u),
       stop_for_native_allocs_(stop_for_native_allocs),
       total_wait_time_(0),
       verify_object_mode_(kVerifyObjectModeDisabled),
@@ -409,6 +430,8 @@ Heap::Heap(size_t initial_size,
       max_gc_requested_(0u),
       pending_collector_transition_(nullptr),
       pending_heap_trim_(nullptr),
+      pending_release_free_regions_(nullptr),
+      monitors_after_last_deflation_(0u),
       use_homogeneous_space_compaction_for_oom_(use_homogeneous_space_compaction_for_oom),
       use_generational_cc_(use_generational_cc),
       running_collection_is_blocking_(false),
@@ -432,7 +455,9 @@ Heap::Heap(size_t initial_size,
       boot_image_spaces_(),
       boot_images_start_address_(0u),
       boot_images_size_(0u),
-      pre_oome_gc_count_(0u) {
+      pre_oome_gc_count_(0u),
+      tlab_refill_count_(0u),
+      tlab_waste_bytes_(0u) {
   if (VLOG_IS_ON(heap) || VLOG_IS_ON(startup)) {
     LOG(INFO) << "Heap() entering";
   }
@@ -648,11 +673,14 @@ Heap::Heap(size_t initial_size,
   if (foreground_collector_type_ == kCollectorTypeCC) {
     CHECK(separate_non_moving_space);
     // Reserve twice the capacity, to allow evacuating every region for explicit GCs.
-    MemMap region_space_mem_map =
-        space::RegionSpace::CreateMemMap(kRegionSpaceName, capacity_ * 2, request_begin);
+    MemMap region_space_mem_map = space::RegionSpace::CreateMemMap(
+        kRegionSpaceName, capacity_ * 2, request_begin, use_transparent_huge_pages);
     CHECK(region_space_mem_map.IsValid()) << "No region space mem map";
-    region_space_ = space::RegionSpace::Create(
-        kRegionSpaceName, std::move(region_space_mem_map), use_generational_cc_);
+    region_space_ = space::RegionSpace::Create(kRegionSpaceName,
+                                               std::move(region_space_mem_map),
+                                               use_generational_cc_,
+                                               use_transparent_huge_pages,
+                                               use_numa_aware_region_allocation);
     AddSpace(region_space_);
   } else if (IsMovingGc(foreground_collector_type_)) {
     // Create bump pointer spaces.
@@ -856,6 +884,13 @@ Heap::Heap(size_t initial_size,
     // Disable the Java Heap Profiler.
     GetHeapSampler().DisableHeapSampler();
   }
+  // Built-in allocation site profiler, sharing the sampling machinery of the Java Heap Profiler.
+  if (runtime->GetAllocationSiteSamplingInterval() != 0u) {
+    GetHeapSampler().EnableAllocationSiteProfiling(runtime->GetAllocationSiteSamplingInterval());
+  }
+  if (runtime->IsGcSurvivalTrackingEnabled() && region_space_ != nullptr) {
+    region_space_->EnableSurvivalTracking();
+  }
 
   instrumentation::Instrumentation* const instrumentation = runtime->GetInstrumentation();
   if (gc_stress_mode_) {
@@ -1307,6 +1342,12 @@ void Heap::DumpGcPerformanceInfo(std::ostream& os) {
   os << "Total blocking GC count: " << GetBlockingGcCount() << "\n";
   os << "Total blocking GC time: " << PrettyDuration(GetBlockingGcTime()) << "\n";
   os << "Total pre-OOME GC count: " << GetPreOomeGcCount() << "\n";
+  reference_processor_->DumpStats(os);
+  if (region_space_ != nullptr && region_space_->IsSurvivalTrackingEnabled()) {
+    region_space_->DumpSurvivalHistogram(os);
+  }
+  os << "Total TLAB refills: " << tlab_refill_count_.load(std::memory_order_relaxed)
+     << " wasted: " << PrettySize(tlab_waste_bytes_.load(std::memory_order_relaxed)) << "\n";
   {
     MutexLock mu(Thread::Current(), *gc_complete_lock_);
     if (gc_count_rate_histogram_.SampleSize() > 0U) {
@@ -1354,6 +1395,8 @@ void Heap::ResetGcPerformanceInfo() {
   blocking_gc_count_ = 0;
   blocking_gc_time_ = 0;
   pre_oome_gc_count_.store(0, std::memory_order_relaxed);
+  tlab_refill_count_.store(0, std::memory_order_relaxed);
+  tlab_waste_bytes_.store(0, std::memory_order_relaxed);
   gc_count_last_window_ = 0;
   blocking_gc_count_last_window_ = 0;
   last_update_time_gc_count_rate_histograms_ =  // Round down by the window duration.
@@ -1595,15 +1638,21 @@ void Heap::DoPendingCollectorTransition() {
 
 void Heap::Trim(Thread* self) {
   Runtime* const runtime = Runtime::Current();
-  if (!CareAboutPauseTimes()) {
-    // Deflate the monitors, this can cause a pause but shouldn't matter since we don't care
-    // about pauses.
+  size_t num_monitors = runtime->GetMonitorList()->Size();
+  if (!CareAboutPauseTimes() ||
+      (num_monitors >= kForegroundMonitorDeflationThreshold &&
+       num_monitors >= monitors_after_last_deflation_.load(std::memory_order_relaxed) +
+                           kForegroundMonitorDeflationGrowth)) {
+    // Deflate the monitors, this can cause a pause. That shouldn't matter if we don't care about
+    // pauses, otherwise only pay for it once enough monitors have accumulated.
     ScopedTrace trace("Deflating monitors");
     // Avoid race conditions on the lock word for CC.
     ScopedGCCriticalSection gcs(self, kGcCauseTrim, kCollectorTypeHeapTrim);
     ScopedSuspendAll ssa(__FUNCTION__);
     uint64_t start_time = NanoTime();
     size_t count = runtime->GetMonitorList()->DeflateMonitors();
+    monitors_after_last_deflation_.store(runtime->GetMonitorList()->Size(),
+                                         std::memory_order_relaxed);
     VLOG(heap) << "Deflating " << count << " monitors took "
         << PrettyDuration(NanoTime() - start_time);
   }
@@ -1611,6 +1660,11 @@ void Heap::Trim(Thread* self) {
   TrimSpaces(self);
   // Trim arenas that may have been used by JIT or verifier.
   runtime->GetArenaPool()->TrimMaps();
+  // The JIT keeps some of its arenas populated between compilations, release them
+  // all now that we are idle.
+  if (runtime->GetJitArenaPool() != nullptr) {
+    runtime->GetJitArenaPool()->TrimMaps();
+  }
 }
 
 class TrimIndirectReferenceTableClosure : public Closure {
@@ -1702,14 +1756,20 @@ void Heap::TrimSpaces(Thread* self) {
   uint64_t total_alloc_space_allocated = 0;
   uint64_t total_alloc_space_size = 0;
   uint64_t managed_reclaimed = 0;
+  // Don't trim dlmalloc spaces if we care about pauses since this can hold the space lock for a
+  // long period of time. Still do it once in a while so that processes which stay in the
+  // foreground for days, such as services, give back the holes in the non-moving space.
+  const bool trim_dlmalloc_spaces = !CareAboutPauseTimes() ||
+      start_ns - last_dlmalloc_trim_ns_ >= kForegroundDlMallocTrimInterval;
+  if (trim_dlmalloc_spaces) {
+    last_dlmalloc_trim_ns_ = start_ns;
+  }
   {
     ScopedObjectAccess soa(self);
     for (const auto& space : continuous_spaces_) {
       if (space->IsMallocSpace()) {
         gc::space::MallocSpace* malloc_space = space->AsMallocSpace();
-        if (malloc_space->IsRosAllocSpace() || !CareAboutPauseTimes()) {
-          // Don't trim dlmalloc spaces if we care about pauses since this can hold the space lock
-          // for a long period of time.
+        if (malloc_space->IsRosAllocSpace() || trim_dlmalloc_spaces) {
           managed_reclaimed += malloc_space->Trim();
         }
         total_alloc_space_size += malloc_space->Size();
@@ -1732,6 +1792,11 @@ void Heap::TrimSpaces(Thread* self) {
   // We never move things in the native heap, so we can finish the GC at this point.
   FinishGC(self, collector::kGcTypeNone);
 
+  metrics::ArtMetrics* metrics = GetMetrics();
+  metrics->HeapTrimCount()->AddOne();
+  metrics->HeapTrimReclaimedBytes()->Add(managed_reclaimed);
+  metrics->HeapTrimTotalTime()->Add(NsToUs(gc_heap_end_ns - start_ns));
+
   VLOG(heap) << "Heap trim of managed (duration=" << PrettyDuration(gc_heap_end_ns - start_ns)
       << ", advised=" << PrettySize(managed_reclaimed) << ") heap. Managed heap utilization of "
       << static_cast<int>(100 * managed_utilization) << "%.";
@@ -2374,25 +2439,97 @@ class ZygoteCompactingCollector final : public collector::SemiSpace {
         bin_mark_bitmap_(nullptr),
         is_running_on_memory_tool_(is_running_on_memory_tool) {}
 
-  void BuildBins(space::ContinuousSpace* space) REQUIRES_SHARED(Locks::mutator_lock_) {
+  // Find the free bins of `space`. If `thread_pool` is not null, the space is split into chunks
+  // that are walked in parallel.
+  void BuildBins(space::ContinuousSpace* space, ThreadPool* thread_pool)
+      REQUIRES_SHARED(Locks::mutator_lock_) {
     bin_live_bitmap_ = space->GetLiveBitmap();
     bin_mark_bitmap_ = space->GetMarkBitmap();
-    uintptr_t prev = reinterpret_cast<uintptr_t>(space->Begin());
-    WriterMutexLock mu(Thread::Current(), *Locks::heap_bitmap_lock_);
-    // Note: This requires traversing the space in increasing order of object addresses.
-    auto visitor = [&](mirror::Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
-      uintptr_t object_addr = reinterpret_cast<uintptr_t>(obj);
-      size_t bin_size = object_addr - prev;
-      // Add the bin consisting of the end of the previous object to the start of the current object.
-      AddBin(bin_size, prev);
-      prev = object_addr + RoundUp(obj->SizeOf<kDefaultVerifyFlags>(), kObjectAlignment);
-    };
-    bin_live_bitmap_->Walk(visitor);
+    Thread* self = Thread::Current();
+    WriterMutexLock mu(self, *Locks::heap_bitmap_lock_);
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(space->Begin());
+    const uintptr_t end = reinterpret_cast<uintptr_t>(space->End());
+    // Chunk bounds fall on bitmap word boundaries. Each chunk owns the objects starting in it,
+    // an object crossing the end of a chunk is only visited by that chunk.
+    const uintptr_t word_span =
+        accounting::ContinuousSpaceBitmap::IndexToOffset(static_cast<uintptr_t>(1));
+    const size_t max_chunks = (thread_pool != nullptr) ? thread_pool->GetThreadCount() + 1u : 1u;
+    const uintptr_t chunk_size = RoundUp(
+        std::max<uintptr_t>((end - begin + max_chunks - 1u) / max_chunks,
+                            kMinZygoteBinsChunkSize),
+        word_span);
+    std::vector<BinChunk> chunks;
+    for (uintptr_t chunk_begin = begin; chunk_begin < end; chunk_begin += chunk_size) {
+      chunks.emplace_back(chunk_begin, std::min(chunk_begin + chunk_size, end));
+    }
+    if (thread_pool != nullptr && chunks.size() > 1u) {
+      for (BinChunk& chunk : chunks) {
+        thread_pool->AddTask(self, new FunctionTask([this, &chunk](Thread*) {
+          // We hold the heap bitmap lock on behalf of the workers.
+          ScopedTrace trace("Zygote find bins");
+          FindBins(&chunk);
+        }));
+      }
+      thread_pool->SetMaxActiveWorkers(chunks.size() - 1u);
+      thread_pool->StartWorkers(self);
+      thread_pool->Wait(self, /*do_work=*/ true, /*may_hold_locks=*/ true);
+      thread_pool->StopWorkers(self);
+    } else {
+      for (BinChunk& chunk : chunks) {
+        FindBins(&chunk);
+      }
+    }
+    // Stitch the chunks together in increasing address order, which is the order in which the
+    // bins would be found by a single walk of the space.
+    uintptr_t prev = begin;
+    for (const BinChunk& chunk : chunks) {
+      if (chunk.first_object == 0u) {
+        continue;
+      }
+      // Add the bin consisting of the end of the previous chunk's last object to the start of
+      // this chunk's first object.
+      AddBin(chunk.first_object - prev, prev);
+      for (const std::pair<size_t, uintptr_t>& bin : chunk.bins) {
+        AddBin(bin.first, bin.second);
+      }
+      prev = chunk.objects_end;
+    }
     // Add the last bin which spans after the last object to the end of the space.
-    AddBin(reinterpret_cast<uintptr_t>(space->End()) - prev, prev);
+    AddBin(end - prev, prev);
   }
 
  private:
+  // Bins between the objects starting in [begin, end), found by FindBins().
+  struct BinChunk {
+    BinChunk(uintptr_t b, uintptr_t e) : begin(b), end(e) {}
+
+    const uintptr_t begin;
+    const uintptr_t end;
+    // Start of the first object and end of the last object of the chunk, or 0 if it is empty.
+    uintptr_t first_object = 0u;
+    uintptr_t objects_end = 0u;
+    std::vector<std::pair<size_t, uintptr_t>> bins;
+  };
+
+  void FindBins(BinChunk* chunk) const NO_THREAD_SAFETY_ANALYSIS {
+    uintptr_t prev = 0u;
+    // Note: This requires traversing the chunk in increasing order of object addresses.
+    bin_live_bitmap_->VisitMarkedRange(
+        chunk->begin,
+        chunk->end,
+        [&](mirror::Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
+          uintptr_t object_addr = reinterpret_cast<uintptr_t>(obj);
+          if (chunk->first_object == 0u) {
+            chunk->first_object = object_addr;
+          } else if (object_addr != prev) {
+            // The bin between the end of the previous object and the start of this one.
+            chunk->bins.emplace_back(object_addr - prev, prev);
+          }
+          prev = object_addr + RoundUp(obj->SizeOf<kDefaultVerifyFlags>(), kObjectAlignment);
+        });
+    chunk->objects_end = prev;
+  }
+
   // Maps from bin sizes to locations.
   std::multimap<size_t, uintptr_t> bins_;
   // Live bitmap of the space which contains the bins.
@@ -2524,7 +2661,20 @@ void Heap::PreZygoteFork() {
     // compaction will mess up the rosalloc internal metadata.
     ScopedDisableRosAllocVerification disable_rosalloc_verif(this);
     ZygoteCompactingCollector zygote_collector(this, is_running_on_memory_tool_);
-    zygote_collector.BuildBins(non_moving_space_);
+    {
+      // The zygote does not have GC worker threads before the first fork. Use short-lived ones,
+      // which are joined before we return to the fork.
+      std::unique_ptr<ThreadPool> bins_thread_pool;
+      const size_t num_threads = std::min<size_t>(
+          std::max(parallel_gc_threads_, conc_gc_threads_),
+          non_moving_space_->Size() / kMinZygoteBinsChunkSize);
+      if (kParallelZygoteBins && num_threads > 1u) {
+        ScopedTrace trace("Create zygote compaction thread pool");
+        bins_thread_pool.reset(
+            ThreadPool::Create("Zygote compaction thread pool", num_threads - 1u));
+      }
+      zygote_collector.BuildBins(non_moving_space_, bins_thread_pool.get());
+    }
     // Create a new bump pointer space which we will compact into.
     space::BumpPointerSpace target_space("zygote bump space", non_moving_space_->End(),
                                          non_moving_space_->Limit());
@@ -3720,6 +3870,7 @@ void Heap::DumpForSigQuit(std::ostream& os) {
     }
   }
   DumpGcPerformanceInfo(os);
+  heap_sampler_.DumpAllocationSites(os);
 }
 
 size_t Heap::GetPercentFree() {
@@ -3782,6 +3933,11 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
   MutexLock mu(Thread::Current(), process_state_update_lock_);
   // Use the multiplier to grow more for foreground.
   const double multiplier = HeapGrowthMultiplier();
+  if (pause_target_ns_ != 0) {
+    UpdatePauseTargetScale(gc_type);
+  }
+  // Grow more, and start concurrent GCs earlier, if GCs have been exceeding the pause target.
+  const double pause_scale = pause_target_scale_;
   if (gc_type != collector::kGcTypeSticky) {
     // Grow the heap for non sticky GC.
     uint64_t delta = bytes_allocated * (1.0 / GetTargetHeapUtilization() - 1.0);
@@ -3789,7 +3945,7 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
         << " target_utilization_=" << target_utilization_;
     grow_bytes = std::min(delta, static_cast<uint64_t>(max_free_));
     grow_bytes = std::max(grow_bytes, static_cast<uint64_t>(min_free_));
-    target_size = bytes_allocated + static_cast<uint64_t>(grow_bytes * multiplier);
+    target_size = bytes_allocated + static_cast<uint64_t>(grow_bytes * multiplier * pause_scale);
     next_gc_type_ = collector::kGcTypeSticky;
   } else {
     collector::GcType non_sticky_gc_type = NonStickyGcType();
@@ -3803,15 +3959,18 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
     }
     double sticky_gc_throughput_adjustment = GetStickyGcThroughputAdjustment(use_generational_cc_);
 
-    // If the throughput of the current sticky GC >= throughput of the non sticky collector, then
-    // do another sticky collection next.
+    // If the throughput of the current sticky GC >= throughput of the non sticky collector, or the
+    // last non sticky GC exceeded the pause target, then do another sticky collection next.
     // We also check that the bytes allocated aren't over the target_footprint, or
     // concurrent_start_bytes in case of concurrent GCs, in order to prevent a
     // pathological case where dead objects which aren't reclaimed by sticky could get accumulated
     // if the sticky GC throughput always remained >= the full/partial throughput.
     size_t target_footprint = target_footprint_.load(std::memory_order_relaxed);
-    if (current_gc_iteration_.GetEstimatedThroughput() * sticky_gc_throughput_adjustment >=
-        non_sticky_collector->GetEstimatedMeanThroughput() &&
+    const bool prefer_sticky =
+        current_gc_iteration_.GetEstimatedThroughput() * sticky_gc_throughput_adjustment >=
+            non_sticky_collector->GetEstimatedMeanThroughput() ||
+        non_sticky_gc_over_pause_target_;
+    if (prefer_sticky &&
         non_sticky_collector->NumberOfIterations() > 0 &&
         bytes_allocated <= (IsGcConcurrent() ? concurrent_start_bytes_ : target_footprint)) {
       next_gc_type_ = collector::kGcTypeSticky;
@@ -3819,7 +3978,7 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
       next_gc_type_ = non_sticky_gc_type;
     }
     // If we have freed enough memory, shrink the heap back down.
-    const size_t adjusted_max_free = static_cast<size_t>(max_free_ * multiplier);
+    const size_t adjusted_max_free = static_cast<size_t>(max_free_ * multiplier * pause_scale);
     if (bytes_allocated + adjusted_max_free < target_footprint) {
       target_size = bytes_allocated + adjusted_max_free;
       grow_bytes = max_free_;
@@ -3863,6 +4022,7 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
       size_t remaining_bytes = bytes_allocated_during_gc;
       remaining_bytes = std::min(remaining_bytes, kMaxConcurrentRemainingBytes);
       remaining_bytes = std::max(remaining_bytes, kMinConcurrentRemainingBytes);
+      remaining_bytes = static_cast<size_t>(remaining_bytes * pause_scale);
       size_t target_footprint = target_footprint_.load(std::memory_order_relaxed);
       if (UNLIKELY(remaining_bytes > target_footprint)) {
         // A never going to happen situation that from the estimated allocation rate we will exceed
@@ -3885,6 +4045,34 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
   }
 }
 
+void Heap::UpdatePauseTargetScale(collector::GcType gc_type) {
+  DCHECK_NE(pause_target_ns_, 0u);
+  uint64_t observed_ns = 0;
+  for (uint64_t pause : current_gc_iteration_.GetPauseTimes()) {
+    observed_ns = std::max(observed_ns, pause);
+  }
+  // Add the time mutators spent blocked waiting for GCs since we last looked. total_wait_time_
+  // may have been reset in between.
+  const uint64_t wait_time = total_wait_time_;
+  observed_ns += wait_time >= pause_target_last_wait_time_
+      ? wait_time - pause_target_last_wait_time_
+      : wait_time;
+  pause_target_last_wait_time_ = wait_time;
+  const bool over_target = observed_ns > pause_target_ns_;
+  if (over_target) {
+    pause_target_scale_ = std::min(pause_target_scale_ * kPauseTargetScaleStep,
+                                   kMaxPauseTargetScale);
+  } else if (observed_ns < pause_target_ns_ / 2) {
+    // Comfortably within budget, give the memory back gradually.
+    pause_target_scale_ = std::max(pause_target_scale_ / kPauseTargetScaleStep, 1.0);
+  }
+  if (gc_type != collector::kGcTypeSticky) {
+    non_sticky_gc_over_pause_target_ = over_target;
+  }
+  VLOG(gc) << "Pause target " << PrettyDuration(pause_target_ns_) << " observed "
+           << PrettyDuration(observed_ns) << " scale " << pause_target_scale_;
+}
+
 void Heap::ClampGrowthLimit() {
   // Use heap bitmap lock to guard against races with BindLiveToMarkBitmap.
   ScopedObjectAccess soa(Thread::Current());
@@ -4131,6 +4319,47 @@ void Heap::RequestTrim(Thread* self) {
   task_processor_->AddTask(self, added_task);
 }
 
+class Heap::ReleaseFreeRegionsTask : public HeapTask {
+ public:
+  explicit ReleaseFreeRegionsTask(uint64_t delta_time) : HeapTask(NanoTime() + delta_time) { }
+  void Run(Thread* self) override {
+    gc::Heap* heap = Runtime::Current()->GetHeap();
+    // Clear first, a GC freeing more regions while we release should request another pass.
+    heap->ClearPendingReleaseFreeRegions(self);
+    ScopedTrace trace("ReleaseFreeRegions");
+    heap->region_space_->ReleaseFreeRegions(kReleaseFreeRegionsBatchSize);
+  }
+};
+
+void Heap::ClearPendingReleaseFreeRegions(Thread* self) {
+  MutexLock mu(self, *pending_task_lock_);
+  pending_release_free_regions_ = nullptr;
+}
+
+void Heap::RequestReleaseFreeRegions(Thread* self, GcCause cause) {
+  DCHECK(region_space_ != nullptr);
+  Runtime* runtime = Runtime::Current();
+  // The zygote releases before forking and explicit GCs are expected to have released the memory
+  // when they return.
+  if (runtime->IsZygote() || cause == kGcCauseExplicit || !CanAddHeapTask(self)) {
+    region_space_->ReleaseFreeRegions();
+    return;
+  }
+  ReleaseFreeRegionsTask* added_task = nullptr;
+  {
+    MutexLock mu(self, *pending_task_lock_);
+    if (pending_release_free_regions_ != nullptr) {
+      // The pending task will also release the regions freed by this GC.
+      return;
+    }
+    added_task = new ReleaseFreeRegionsTask(runtime->InJankPerceptibleProcessState()
+                                                ? kReleaseFreeRegionsForegroundWait
+                                                : kReleaseFreeRegionsWait);
+    pending_release_free_regions_ = added_task;
+  }
+  task_processor_->AddTask(self, added_task);
+}
+
 void Heap::IncrementNumberOfBytesFreedRevoke(size_t freed_bytes_revoke) {
   size_t previous_num_bytes_freed_revoke =
       num_bytes_freed_revoke_.fetch_add(freed_bytes_revoke, std::memory_order_relaxed);
@@ -4549,6 +4778,38 @@ void Heap::RemoveGcPauseListener() {
   gc_pause_listener_.store(nullptr, std::memory_order_relaxed);
 }
 
+size_t Heap::AdaptiveTlabSize(Thread* self, size_t default_size) {
+  tlab_refill_count_.fetch_add(1, std::memory_order_relaxed);
+  Thread::AdaptiveTlabState* state = self->GetAdaptiveTlabState();
+  const uint32_t gc_num = GetCurrentGcNum();
+  if (state->gc_num != gc_num) {
+    state->gc_num = gc_num;
+    state->refills = 0;
+  }
+  // A thread refilling often between two GCs allocates fast enough to make use of a larger TLAB,
+  // which amortizes the refill slow-path better. Slow allocators are shrunk back by
+  // RecordTlabWaste() when a GC finds most of their TLAB unused.
+  if (++state->refills >= kTlabRefillsToGrow) {
+    state->refills = 0;
+    state->size_shift = std::min(state->size_shift + 1, kMaxTlabSizeShift);
+  }
+  return state->size_shift >= 0 ? default_size << state->size_shift
+                                : default_size >> -state->size_shift;
+}
+
+void Heap::RecordTlabWaste(Thread* thread, size_t wasted_bytes, bool by_gc) {
+  tlab_waste_bytes_.fetch_add(wasted_bytes, std::memory_order_relaxed);
+  if (by_gc && wasted_bytes > 0) {
+    // The thread didn't manage to fill even half of its TLAB before the GC; give it a smaller one
+    // next time. The caller holds the space lock and the thread is suspended or is the caller.
+    Thread::AdaptiveTlabState* state = thread->GetAdaptiveTlabState();
+    size_t tlab_size = thread->GetThreadLocalBytesAllocated();
+    if (wasted_bytes > tlab_size / 2) {
+      state->size_shift = std::max(state->size_shift - 1, kMinTlabSizeShift);
+    }
+  }
+}
+
 mirror::Object* Heap::AllocWithNewTLAB(Thread* self,
                                        AllocatorType allocator_type,
                                        size_t alloc_size,
@@ -4566,10 +4827,11 @@ mirror::Object* Heap::AllocWithNewTLAB(Thread* self,
     // There is enough space if we grow the TLAB. Lets do that. This increases the
     // TLAB bytes.
     const size_t min_expand_size = alloc_size - self->TlabSize();
+    const size_t partial_tlab_size = AdaptiveTlabSize(self, kPartialTlabSize);
     size_t next_tlab_size =
         jhp_enabled ? JHPCalculateNextTlabSize(
-                          self, kPartialTlabSize, alloc_size, &take_sample, &bytes_until_sample) :
-                      kPartialTlabSize;
+                          self, partial_tlab_size, alloc_size, &take_sample, &bytes_until_sample) :
+                      partial_tlab_size;
     const size_t expand_bytes = std::max(
         min_expand_size,
         std::min(self->TlabRemainingCapacity() - self->TlabSize(), next_tlab_size));
@@ -4585,7 +4847,9 @@ mirror::Object* Heap::AllocWithNewTLAB(Thread* self,
     // TODO: for large allocations, which are rare, maybe we should allocate
     // that object and return. There is no need to revoke the current TLAB,
     // particularly if it's mostly unutilized.
-    size_t next_tlab_size = RoundDown(alloc_size + kDefaultTLABSize, gPageSize) - alloc_size;
+    // The TLAB must be at least a page for the page-aligned size computation below.
+    const size_t tlab_size = std::max(AdaptiveTlabSize(self, kDefaultTLABSize), gPageSize);
+    size_t next_tlab_size = RoundDown(alloc_size + tlab_size, gPageSize) - alloc_size;
     if (jhp_enabled) {
       next_tlab_size = JHPCalculateNextTlabSize(
           self, next_tlab_size, alloc_size, &take_sample, &bytes_until_sample);
@@ -4610,8 +4874,10 @@ mirror::Object* Heap::AllocWithNewTLAB(Thread* self,
       if (LIKELY(!IsOutOfMemoryOnAllocation(allocator_type,
                                             space::RegionSpace::kRegionSize,
                                             grow))) {
-        size_t next_pr_tlab_size =
-            kUsePartialTlabs ? kPartialTlabSize : gc::space::RegionSpace::kRegionSize;
+        size_t next_pr_tlab_size = kUsePartialTlabs
+            ? std::min(AdaptiveTlabSize(self, kPartialTlabSize),
+                       gc::space::RegionSpace::kRegionSize)
+            : gc::space::RegionSpace::kRegionSize;
         if (jhp_enabled) {
           next_pr_tlab_size = JHPCalculateNextTlabSize(
               self, next_pr_tlab_size, alloc_size, &take_sample, &bytes_until_sample);
@@ -146,7 +146,16 @@ class Heap {
   static constexpr size_t kDefaultLongPauseLogThresholdGcStress = MsToNs(50);
   static constexpr size_t kDefaultLongGCLogThreshold = MsToNs(100);
   static constexpr size_t kDefaultLongGCLogThresholdGcStress = MsToNs(1000);
+  // Bounds and step of the extra heap growth applied while GCs exceed the pause target, see
+  // UpdatePauseTargetScale().
+  static constexpr double kMaxPauseTargetScale = 4.0;
+  static constexpr double kPauseTargetScaleStep = 1.25;
   static constexpr size_t kDefaultTLABSize = 32 * KB;
+  // Bounds of the (log2) factor by which a thread's TLAB size is scaled, see AdaptiveTlabSize().
+  static constexpr int32_t kMinTlabSizeShift = -1;
+  static constexpr int32_t kMaxTlabSizeShift = 3;
+  // Number of TLAB refills between two GCs after which a thread's TLAB size is doubled.
+  static constexpr uint32_t kTlabRefillsToGrow = 8;
   static constexpr double kDefaultTargetUtilization = 0.6;
   static constexpr double kDefaultHeapGrowthMultiplier = 2.0;
   // Primitive arrays larger than this size are put in the large object space.
@@ -187,6 +196,18 @@ class Heap {
   // How often we allow heap trimming to happen (nanoseconds).
   static constexpr uint64_t kHeapTrimWait = MsToNs(5000);
 
+  // How long after a GC the pages of the free regions are released (nanoseconds). This also
+  // bounds how often we release them. Jank perceptible processes wait longer, so that releasing
+  // is less likely to compete with UI work.
+  static constexpr uint64_t kReleaseFreeRegionsWait = MsToNs(100);
+  static constexpr uint64_t kReleaseFreeRegionsForegroundWait = MsToNs(1000);
+  // Size of the batches in which the pages of the free regions are released.
+  static constexpr size_t kReleaseFreeRegionsBatchSize = 16 * MB;
+
+  // How often we trim dlmalloc spaces, such as the non-moving space, even though we care about
+  // pause times (nanoseconds). Long running processes may never leave the foreground.
+  static constexpr uint64_t kForegroundDlMallocTrimInterval = MsToNs(10 * 60 * 1000);
+
   // Starting size of DlMalloc/RosAlloc spaces.
   static size_t GetDefaultStartingSize() {
     return gPageSize;
@@ -225,6 +246,7 @@ class Heap {
        bool low_memory_mode,
        size_t long_pause_threshold,
        size_t long_gc_threshold,
+       uint64_t pause_target_ns,
        bool ignore_target_footprint,
        bool always_log_explicit_gcs,
        bool use_tlab,
@@ -240,7 +262,9 @@ class Heap {
        bool use_generational_cc,
        uint64_t min_interval_homogeneous_space_compaction_by_oom,
        bool dump_region_info_before_gc,
-       bool dump_region_info_after_gc);
+       bool dump_region_info_after_gc,
+       bool use_transparent_huge_pages,
+       bool use_numa_aware_region_allocation);
 
   ~Heap();
 
@@ -874,6 +898,11 @@ class Heap {
   // Request an asynchronous trim.
   void RequestTrim(Thread* self) REQUIRES(!*pending_task_lock_);
 
+  // Release the pages of the free regions of the region space to the kernel. Unless `cause`
+  // asks for immediate release, this is done later by the heap task daemon, in batches, and
+  // requests made while one is pending are coalesced.
+  void RequestReleaseFreeRegions(Thread* self, GcCause cause) REQUIRES(!*pending_task_lock_);
+
   // Retrieve the current GC number, i.e. the number n such that we completed n GCs so far.
   // Provides acquire ordering, so that if we read this first, and then check whether a GC is
   // required, we know that the GC number read actually preceded the test.
@@ -930,6 +959,14 @@ class Heap {
   // Reduce the number of bytes to the next sample position by this adjustment.
   void AdjustSampleOffset(size_t adjustment);
 
+  // Returns the size for the next TLAB of `self`, which is `default_size` scaled to the recent
+  // allocation rate of the thread. Called once per TLAB refill or expansion.
+  size_t AdaptiveTlabSize(Thread* self, size_t default_size);
+  // Called when the TLAB of `thread` is revoked with `wasted_bytes` left unused. `by_gc` is true
+  // if the TLAB was revoked for a GC rather than for a refill, including when the thread revokes
+  // it itself in a GC checkpoint.
+  void RecordTlabWaste(Thread* thread, size_t wasted_bytes, bool by_gc);
+
   // Allocation tracking support
   // Callers to this function use double-checked locking to ensure safety on allocation_records_
   bool IsAllocTrackingEnabled() const {
@@ -1031,6 +1068,7 @@ class Heap {
   class ConcurrentGCTask;
   class CollectorTransitionTask;
   class HeapTrimTask;
+  class ReleaseFreeRegionsTask;
   class TriggerPostForkCCGcTask;
   class ReduceTargetFootprintTask;
 
@@ -1237,6 +1275,10 @@ class Heap {
                           size_t bytes_allocated_before_gc = 0)
       REQUIRES(!process_state_update_lock_);
 
+  // Compare the pauses and mutator waits of the GC that just finished against pause_target_ns_
+  // and adjust pause_target_scale_ accordingly. Only called from GrowForUtilization().
+  void UpdatePauseTargetScale(collector::GcType gc_type) REQUIRES(process_state_update_lock_);
+
   size_t GetPercentFree();
 
   // Swap the allocation stack with the live stack.
@@ -1264,6 +1306,7 @@ class Heap {
           REQUIRES(!*gc_complete_lock_, !*pending_task_lock_, !process_state_update_lock_);
 
   void ClearPendingTrim(Thread* self) REQUIRES(!*pending_task_lock_);
+  void ClearPendingReleaseFreeRegions(Thread* self) REQUIRES(!*pending_task_lock_);
   void ClearPendingCollectorTransition(Thread* self) REQUIRES(!*pending_task_lock_);
 
   // What kind of concurrency behavior is the runtime after?
@@ -1402,6 +1445,10 @@ class Heap {
   // If we get a GC longer than long GC log threshold, then we print out the GC after it finishes.
   const size_t long_gc_log_threshold_;
 
+  // Budget for the longest pause plus the time mutators spend waiting for a GC to complete, per
+  // GC cycle. 0 if there is no budget (-XX:GcPauseTargetMs).
+  const uint64_t pause_target_ns_;
+
   // Starting time of the new process; meant to be used for measuring total process CPU time.
   uint64_t process_cpu_start_time_ns_;
 
@@ -1414,6 +1461,10 @@ class Heap {
   double pre_gc_weighted_allocated_bytes_;
   double post_gc_weighted_allocated_bytes_;
 
+  // Last time TrimSpaces() trimmed the dlmalloc spaces. Only accessed by TrimSpaces(), which runs
+  // as a pretend GC.
+  uint64_t last_dlmalloc_trim_ns_;
+
   // If we ignore the target footprint it lets the heap grow until it hits the heap capacity, this
   // is useful for benchmarking since it reduces time spent in GC to a low %.
   const bool ignore_target_footprint_;
@@ -1622,6 +1673,17 @@ class Heap {
   // How much more we grow the heap when we are a foreground app instead of background.
   double foreground_heap_growth_multiplier_;
 
+  // Factor, between 1.0 and kMaxPauseTargetScale, by which we grow the heap more and start
+  // concurrent GCs earlier while recent GCs exceed pause_target_ns_.
+  double pause_target_scale_ GUARDED_BY(process_state_update_lock_);
+
+  // Whether the last non-sticky GC exceeded pause_target_ns_, in which case we keep running sticky
+  // GCs for as long as they keep the heap below the GC trigger.
+  bool non_sticky_gc_over_pause_target_ GUARDED_BY(process_state_update_lock_);
+
+  // Value of total_wait_time_ when UpdatePauseTargetScale() last ran.
+  uint64_t pause_target_last_wait_time_ GUARDED_BY(process_state_update_lock_);
+
   // The amount of native memory allocation since the last GC required to cause us to wait for a
   // collection as a result of native allocation. Very large values can cause the device to run
   // out of memory, due to lack of finalization to reclaim native memory.  Making it too small can
@@ -1684,6 +1746,10 @@ class Heap {
   // Active tasks which we can modify (change target time, desired collector type, etc..).
   CollectorTransitionTask* pending_collector_transition_ GUARDED_BY(pending_task_lock_);
   HeapTrimTask* pending_heap_trim_ GUARDED_BY(pending_task_lock_);
+  ReleaseFreeRegionsTask* pending_release_free_regions_ GUARDED_BY(pending_task_lock_);
+
+  // Number of monitors left inflated by the last deflation in Trim().
+  Atomic<size_t> monitors_after_last_deflation_;
 
   // Whether or not we use homogeneous space compaction to avoid OOM errors.
   bool use_homogeneous_space_compaction_for_oom_;
@@ -1752,6 +1818,10 @@ class Heap {
   // The number of times we initiated a GC of last resort to try to avoid an OOME.
   Atomic<uint64_t> pre_oome_gc_count_;
 
+  // Total number of TLAB refills (including expansions), and bytes left unused in revoked TLABs.
+  Atomic<uint64_t> tlab_refill_count_;
+  Atomic<uint64_t> tlab_waste_bytes_;
+
   // An installed allocation listener.
   Atomic<AllocationListener*> alloc_listener_;
   // An installed GC Pause listener.
@@ -48,7 +48,9 @@ ReferenceProcessor::ReferenceProcessor()
       weak_reference_queue_(Locks::reference_queue_weak_references_lock_),
       finalizer_reference_queue_(Locks::reference_queue_finalizer_references_lock_),
       phantom_reference_queue_(Locks::reference_queue_phantom_references_lock_),
-      cleared_references_(Locks::reference_queue_cleared_references_lock_) {
+      cleared_references_(Locks::reference_queue_cleared_references_lock_),
+      get_referent_blocked_count_(0u),
+      get_referent_blocked_ns_(0u) {
 }
 
 static inline MemberOffset GetSlowPathFlagOffset(ObjPtr<mirror::Class> reference_class)
@@ -104,10 +106,13 @@ ObjPtr<mirror::Object> ReferenceProcessor::GetReferent(Thread* self,
   }
 
   bool started_trace = false;
-  uint64_t start_millis;
-  auto finish_trace = [](uint64_t start_millis) {
+  uint64_t start_ns;
+  auto finish_trace = [this](uint64_t start_ns) {
     ATraceEnd();
-    uint64_t millis = MilliTime() - start_millis;
+    uint64_t blocked_ns = NanoTime() - start_ns;
+    get_referent_blocked_count_.fetch_add(1u, std::memory_order_relaxed);
+    get_referent_blocked_ns_.fetch_add(blocked_ns, std::memory_order_relaxed);
+    uint64_t millis = NsToMs(blocked_ns);
     static constexpr uint64_t kReportMillis = 10;  // Long enough to risk dropped frames.
     if (millis > kReportMillis) {
       LOG(WARNING) << "Weak pointer dereference blocked for " << millis << " milliseconds.";
@@ -130,7 +135,7 @@ ObjPtr<mirror::Object> ReferenceProcessor::GetReferent(Thread* self,
       if (!started_trace) {
         ATraceBegin("GetReferent blocked");
         started_trace = true;
-        start_millis = MilliTime();
+        start_ns = NanoTime();
       }
       condition_.WaitHoldingLocks(self);
       continue;
@@ -153,12 +158,12 @@ ObjPtr<mirror::Object> ReferenceProcessor::GetReferent(Thread* self,
     // Either the referent was marked, and forwarded_ref is the correct return value, or it
     // was not, and forwarded_ref == null, which is again the correct return value.
     if (started_trace) {
-      finish_trace(start_millis);
+      finish_trace(start_ns);
     }
     return forwarded_ref;
   }
   if (started_trace) {
-    finish_trace(start_millis);
+    finish_trace(start_ns);
   }
   return reference->GetReferent();
 }
@@ -171,6 +176,7 @@ uint32_t ReferenceProcessor::ForwardSoftReferences(TimingLogger* timings) {
   // We used to argue that we should be smarter about doing this conditionally, but it's unclear
   // that's actually better than the more predictable strategy of basically only clearing
   // SoftReferences just before we would otherwise run out of memory.
+  uint64_t start_ns = NanoTime();
   uint32_t non_null_refs = soft_reference_queue_.ForwardSoftReferences(collector_);
   if (ATraceEnabled()) {
     static constexpr size_t kBufSize = 80;
@@ -182,9 +188,50 @@ uint32_t ReferenceProcessor::ForwardSoftReferences(TimingLogger* timings) {
   } else {
     collector_->ProcessMarkStack();
   }
+  // Forwarded references are not cleared. Unlike ClearWhiteReferences(), references whose
+  // referent is already null are not counted.
+  AddPendingSoftStats(non_null_refs, /*num_cleared=*/ 0u, start_ns);
   return non_null_refs;
 }
 
+void ReferenceProcessor::RecordStats(ReferenceKind kind,
+                                     uint32_t num_refs,
+                                     uint32_t num_cleared,
+                                     uint64_t time_ns) {
+  ReferenceKindStats& stats = stats_[kind];
+  stats.num_refs.fetch_add(num_refs, std::memory_order_relaxed);
+  stats.num_cleared.fetch_add(num_cleared, std::memory_order_relaxed);
+  stats.time_ns.fetch_add(time_ns, std::memory_order_relaxed);
+}
+
+void ReferenceProcessor::AddPendingSoftStats(uint32_t num_refs,
+                                             uint32_t num_cleared,
+                                             uint64_t start_ns) {
+  pending_soft_stats_.num_refs += num_refs;
+  pending_soft_stats_.num_cleared += num_cleared;
+  pending_soft_stats_.time_ns += NanoTime() - start_ns;
+}
+
+void ReferenceProcessor::DumpStats(std::ostream& os) const {
+  static constexpr const char* kKindNames[kReferenceKindCount] = {
+      "SoftReference", "WeakReference", "FinalizerReference", "PhantomReference"};
+  for (size_t kind = 0; kind < kReferenceKindCount; ++kind) {
+    const ReferenceKindStats& stats = stats_[kind];
+    uint64_t num_refs = stats.num_refs.load(std::memory_order_relaxed);
+    if (num_refs == 0) {
+      continue;
+    }
+    os << kKindNames[kind] << " processed: " << num_refs
+       << " cleared: " << stats.num_cleared.load(std::memory_order_relaxed)
+       << " time: " << PrettyDuration(stats.time_ns.load(std::memory_order_relaxed)) << "\n";
+  }
+  uint64_t blocked_count = get_referent_blocked_count_.load(std::memory_order_relaxed);
+  if (blocked_count > 0) {
+    os << "Reference.get() blocked: " << blocked_count << " times, total "
+       << PrettyDuration(get_referent_blocked_ns_.load(std::memory_order_relaxed)) << "\n";
+  }
+}
+
 void ReferenceProcessor::Setup(Thread* self,
                                collector::GarbageCollector* collector,
                                bool concurrent,
@@ -195,6 +242,7 @@ void ReferenceProcessor::Setup(Thread* self,
   rp_state_ = RpState::kStarting;
   concurrent_ = concurrent;
   clear_soft_references_ = clear_soft_references;
+  pending_soft_stats_ = PendingSoftReferenceStats();
 }
 
 // Process reference class instances and schedule finalizations.
@@ -230,8 +278,17 @@ void ReferenceProcessor::ProcessReferences(Thread* self, TimingLogger* timings)
   }
   // Clear all remaining soft and weak references with white referents.
   // This misses references only reachable through finalizers.
-  soft_reference_queue_.ClearWhiteReferences(&cleared_references_, collector_);
-  weak_reference_queue_.ClearWhiteReferences(&cleared_references_, collector_);
+  {
+    uint64_t start_ns = NanoTime();
+    ClearedReferenceStats soft_stats =
+        soft_reference_queue_.ClearWhiteReferences(&cleared_references_, collector_);
+    AddPendingSoftStats(soft_stats.num_refs_, soft_stats.num_cleared_, start_ns);
+    start_ns = NanoTime();
+    ClearedReferenceStats weak_stats =
+        weak_reference_queue_.ClearWhiteReferences(&cleared_references_, collector_);
+    RecordStats(
+        kWeakReference, weak_stats.num_refs_, weak_stats.num_cleared_, NanoTime() - start_ns);
+  }
   // Defer PhantomReference processing until we've finished marking through finalizers.
   {
     // TODO: Capture mark state of some system weaks here. If the referent was marked here,
@@ -251,6 +308,7 @@ void ReferenceProcessor::ProcessReferences(Thread* self, TimingLogger* timings)
     TimingLogger::ScopedTiming t2(
         concurrent_ ? "EnqueueFinalizerReferences" : "(Paused)EnqueueFinalizerReferences", timings);
     // Preserve all white objects with finalize methods and schedule them for finalization.
+    uint64_t start_ns = NanoTime();
     FinalizerStats finalizer_stats =
         finalizer_reference_queue_.EnqueueFinalizerReferences(&cleared_references_, collector_);
     if (ATraceEnabled()) {
@@ -264,6 +322,10 @@ void ReferenceProcessor::ProcessReferences(Thread* self, TimingLogger* timings)
     } else {
       collector_->ProcessMarkStack();
     }
+    RecordStats(kFinalizerReference,
+                finalizer_stats.num_refs_,
+                finalizer_stats.num_enqueued_,
+                NanoTime() - start_ns);
   }
 
   // Process all soft and weak references with white referents, where the references are reachable
@@ -285,13 +347,33 @@ void ReferenceProcessor::ProcessReferences(Thread* self, TimingLogger* timings)
   // finalized object containing pointers to native objects that have already been deallocated.
   // But it can be argued that this is just an instance of the broader rule that it is not safe
   // for finalizers to access otherwise inaccessible finalizable objects.
-  soft_reference_queue_.ClearWhiteReferences(&cleared_references_, collector_,
-                                             /*report_cleared=*/ true);
-  weak_reference_queue_.ClearWhiteReferences(&cleared_references_, collector_,
-                                             /*report_cleared=*/ true);
+  {
+    uint64_t start_ns = NanoTime();
+    ClearedReferenceStats soft_stats = soft_reference_queue_.ClearWhiteReferences(
+        &cleared_references_, collector_, /*report_cleared=*/ true);
+    AddPendingSoftStats(soft_stats.num_refs_, soft_stats.num_cleared_, start_ns);
+    start_ns = NanoTime();
+    ClearedReferenceStats weak_stats = weak_reference_queue_.ClearWhiteReferences(
+        &cleared_references_, collector_, /*report_cleared=*/ true);
+    RecordStats(
+        kWeakReference, weak_stats.num_refs_, weak_stats.num_cleared_, NanoTime() - start_ns);
+  }
 
-  // Clear all phantom references with white referents. It's fine to do this just once here.
-  phantom_reference_queue_.ClearWhiteReferences(&cleared_references_, collector_);
+  {
+    // Clear all phantom references with white referents. It's fine to do this just once here.
+    uint64_t start_ns = NanoTime();
+    ClearedReferenceStats phantom_stats =
+        phantom_reference_queue_.ClearWhiteReferences(&cleared_references_, collector_);
+    RecordStats(kPhantomReference,
+                phantom_stats.num_refs_,
+                phantom_stats.num_cleared_,
+                NanoTime() - start_ns);
+  }
+  RecordStats(kSoftReference,
+              pending_soft_stats_.num_refs,
+              pending_soft_stats_.num_cleared,
+              pending_soft_stats_.time_ns);
+  pending_soft_stats_ = PendingSoftReferenceStats();
 
   // At this point all reference queues other than the cleared references should be empty.
   DCHECK(soft_reference_queue_.IsEmpty());
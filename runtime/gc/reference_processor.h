@@ -91,8 +91,39 @@ class ReferenceProcessor {
       REQUIRES(!Locks::reference_processor_lock_);
   uint32_t ForwardSoftReferences(TimingLogger* timings)
       REQUIRES_SHARED(Locks::mutator_lock_);
+  // Dump cumulative reference processing statistics, per kind of reference.
+  void DumpStats(std::ostream& os) const;
 
  private:
+  enum ReferenceKind : uint8_t {
+    kSoftReference,
+    kWeakReference,
+    kFinalizerReference,
+    kPhantomReference,
+    kReferenceKindCount,
+  };
+  // Cumulative statistics for one kind of reference. Updated by the GC thread and read by
+  // DumpStats(), hence the relaxed atomics.
+  struct ReferenceKindStats {
+    // References processed. All of them are counted, except for forwarded SoftReferences
+    // where ReferenceQueue::ForwardSoftReferences() only reports those with a non-null referent.
+    // SoftReferences are recorded once per GC, from `pending_soft_stats_`.
+    Atomic<uint64_t> num_refs{0};
+    Atomic<uint64_t> num_cleared{0};  // Of those, the ones cleared (or enqueued for finalization).
+    Atomic<uint64_t> time_ns{0};      // Time spent processing them.
+  };
+
+  // SoftReferences are forwarded and cleared in several steps of a GC. Their numbers are
+  // summed here and recorded into `stats_` once, at the end of ProcessReferences().
+  struct PendingSoftReferenceStats {
+    uint32_t num_refs = 0u;
+    uint32_t num_cleared = 0u;
+    uint64_t time_ns = 0u;
+  };
+
+  void RecordStats(ReferenceKind kind, uint32_t num_refs, uint32_t num_cleared, uint64_t time_ns);
+  void AddPendingSoftStats(uint32_t num_refs, uint32_t num_cleared, uint64_t start_ns);
+
   bool SlowPathEnabled() REQUIRES_SHARED(Locks::mutator_lock_);
   // Called by ProcessReferences.
   void DisableSlowPath(Thread* self) REQUIRES(Locks::reference_processor_lock_)
@@ -124,6 +155,12 @@ class ReferenceProcessor {
   ReferenceQueue phantom_reference_queue_;
   ReferenceQueue cleared_references_;
 
+  ReferenceKindStats stats_[kReferenceKindCount];
+  PendingSoftReferenceStats pending_soft_stats_;  // Only used by GC thread.
+  // Number of times and total time mutators blocked in GetReferent().
+  Atomic<uint64_t> get_referent_blocked_count_;
+  Atomic<uint64_t> get_referent_blocked_ns_;
+
   DISALLOW_COPY_AND_ASSIGN(ReferenceProcessor);
 };
 
@@ -131,11 +131,13 @@ size_t ReferenceQueue::GetLength() const {
   return count;
 }
 
-void ReferenceQueue::ClearWhiteReferences(ReferenceQueue* cleared_references,
-                                          collector::GarbageCollector* collector,
-                                          bool report_cleared) {
+ClearedReferenceStats ReferenceQueue::ClearWhiteReferences(ReferenceQueue* cleared_references,
+                                                           collector::GarbageCollector* collector,
+                                                           bool report_cleared) {
+  uint32_t num_refs(0), num_cleared(0);
   while (!IsEmpty()) {
     ObjPtr<mirror::Reference> ref = DequeuePendingReference();
+    ++num_refs;
     mirror::HeapReference<mirror::Object>* referent_addr = ref->GetReferentReferenceAddr();
     // do_atomic_update is false because this happens during the reference processing phase where
     // Reference.clear() would block.
@@ -147,6 +149,7 @@ void ReferenceQueue::ClearWhiteReferences(ReferenceQueue* cleared_references,
         ref->ClearReferent<false>();
       }
       cleared_references->EnqueueReference(ref);
+      ++num_cleared;
       if (report_cleared) {
         static bool already_reported = false;
         if (!already_reported) {
@@ -161,6 +164,7 @@ void ReferenceQueue::ClearWhiteReferences(ReferenceQueue* cleared_references,
     // transaction mode will trigger the read barrier.
     DisableReadBarrierForReference(ref, std::memory_order_relaxed);
   }
+  return ClearedReferenceStats(num_refs, num_cleared);
 }
 
 FinalizerStats ReferenceQueue::EnqueueFinalizerReferences(ReferenceQueue* cleared_references,
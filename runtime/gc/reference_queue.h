@@ -57,6 +57,13 @@ struct FinalizerStats {
   const uint32_t num_enqueued_;
 };
 
+struct ClearedReferenceStats {
+  ClearedReferenceStats(size_t num_refs, size_t num_cleared)
+      : num_refs_(num_refs), num_cleared_(num_cleared) {}
+  const uint32_t num_refs_;
+  const uint32_t num_cleared_;
+};
+
 // Used to temporarily store java.lang.ref.Reference(s) during GC and prior to queueing on the
 // appropriate java.lang.ref.ReferenceQueue. The linked list is maintained as an unordered,
 // circular, and singly-linked list using the pendingNext fields of the java.lang.ref.Reference
@@ -104,9 +111,10 @@ class ReferenceQueue {
 
   // Unlink the reference list clearing references objects with white referents. Cleared references
   // registered to a reference queue are scheduled for appending by the heap worker thread.
-  void ClearWhiteReferences(ReferenceQueue* cleared_references,
-                            collector::GarbageCollector* collector,
-                            bool report_cleared = false)
+  // Returns the number of references unlinked and how many of them were cleared.
+  ClearedReferenceStats ClearWhiteReferences(ReferenceQueue* cleared_references,
+                                             collector::GarbageCollector* collector,
+                                             bool report_cleared = false)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
   void Dump(std::ostream& os) const REQUIRES_SHARED(Locks::mutator_lock_);
@@ -16,8 +16,10 @@
 
 #include "bump_pointer_space.h"
 #include "bump_pointer_space-inl.h"
+#include "gc/heap.h"
 #include "mirror/class-inl.h"
 #include "mirror/object-inl.h"
+#include "runtime.h"
 #include "thread_list.h"
 
 namespace art HIDDEN {
@@ -121,7 +123,7 @@ void BumpPointerSpace::Dump(std::ostream& os) const {
 
 size_t BumpPointerSpace::RevokeThreadLocalBuffers(Thread* thread) {
   MutexLock mu(Thread::Current(), lock_);
-  RevokeThreadLocalBuffersLocked(thread);
+  RevokeThreadLocalBuffersLocked(thread, /*by_gc=*/ true);
   return 0U;
 }
 
@@ -215,7 +217,11 @@ uint64_t BumpPointerSpace::GetObjectsAllocated() {
   return total;
 }
 
-void BumpPointerSpace::RevokeThreadLocalBuffersLocked(Thread* thread) {
+void BumpPointerSpace::RevokeThreadLocalBuffersLocked(Thread* thread, bool by_gc) {
+  if (thread->HasTlab()) {
+    // The unused tail of a revoked TLAB stays a hole until the next compaction.
+    Runtime::Current()->GetHeap()->RecordTlabWaste(thread, thread->TlabSize(), by_gc);
+  }
   objects_allocated_.fetch_add(thread->GetThreadLocalObjectsAllocated(), std::memory_order_relaxed);
   bytes_allocated_.fetch_add(thread->GetThreadLocalBytesAllocated(), std::memory_order_relaxed);
   thread->ResetTlab();
@@ -224,7 +230,7 @@ void BumpPointerSpace::RevokeThreadLocalBuffersLocked(Thread* thread) {
 bool BumpPointerSpace::AllocNewTlab(Thread* self, size_t bytes, size_t* bytes_tl_bulk_allocated) {
   bytes = RoundUp(bytes, kAlignment);
   MutexLock mu(Thread::Current(), lock_);
-  RevokeThreadLocalBuffersLocked(self);
+  RevokeThreadLocalBuffersLocked(self, /*by_gc=*/ false);
   uint8_t* start = AllocBlock(bytes);
   if (start == nullptr) {
     return false;
@@ -173,7 +173,8 @@ class EXPORT BumpPointerSpace final : public ContinuousMemMapAllocSpace {
 
   // Allocate a raw block of bytes.
   uint8_t* AllocBlock(size_t bytes) REQUIRES(lock_);
-  void RevokeThreadLocalBuffersLocked(Thread* thread) REQUIRES(lock_);
+  // `by_gc` is false if the TLAB is revoked by the thread itself to get a new one.
+  void RevokeThreadLocalBuffersLocked(Thread* thread, bool by_gc) REQUIRES(lock_);
 
   // The main block is an unbounded block where objects go when there are no other blocks. This
   // enables us to maintain tightly packed objects when you are not using thread local buffers for
@@ -644,7 +644,7 @@ void LargeObjectSpace::SweepCallback(size_t num_ptrs, mirror::Object** ptrs, voi
   SweepCallbackContext* context = static_cast<SweepCallbackContext*>(arg);
   space::LargeObjectSpace* space = context->space->AsLargeObjectSpace();
   Thread* self = context->self;
-  Locks::heap_bitmap_lock_->AssertExclusiveHeld(self);
+  Locks::heap_bitmap_lock_->AssertExclusiveHeld(context->gc_thread);
   // If the bitmaps aren't swapped we need to clear the bits since the GC isn't going to re-swap
   // the bitmaps as an optimization.
   if (!context->swap_bitmaps) {
@@ -661,16 +661,29 @@ collector::ObjectBytePair LargeObjectSpace::Sweep(bool swap_bitmaps) {
   if (Begin() >= End()) {
     return collector::ObjectBytePair(0, 0);
   }
+  std::pair<uint8_t*, uint8_t*> range = GetBeginEndAtomic();
+  return SweepRange(swap_bitmaps,
+                    reinterpret_cast<uintptr_t>(range.first),
+                    reinterpret_cast<uintptr_t>(range.second),
+                    Thread::Current());
+}
+
+collector::ObjectBytePair LargeObjectSpace::SweepRange(bool swap_bitmaps,
+                                                       uintptr_t sweep_begin,
+                                                       uintptr_t sweep_end,
+                                                       Thread* gc_thread) {
+  if (sweep_begin >= sweep_end) {
+    return collector::ObjectBytePair(0, 0);
+  }
   accounting::LargeObjectBitmap* live_bitmap = GetLiveBitmap();
   accounting::LargeObjectBitmap* mark_bitmap = GetMarkBitmap();
   if (swap_bitmaps) {
     std::swap(live_bitmap, mark_bitmap);
   }
-  AllocSpace::SweepCallbackContext scc(swap_bitmaps, this);
-  std::pair<uint8_t*, uint8_t*> range = GetBeginEndAtomic();
+  AllocSpace::SweepCallbackContext scc(swap_bitmaps, this, gc_thread);
   accounting::LargeObjectBitmap::SweepWalk(*live_bitmap, *mark_bitmap,
-                                           reinterpret_cast<uintptr_t>(range.first),
-                                           reinterpret_cast<uintptr_t>(range.second),
+                                           sweep_begin,
+                                           sweep_end,
                                            SweepCallback,
                                            &scc);
   return scc.freed;
@@ -81,6 +81,12 @@ class LargeObjectSpace : public DiscontinuousSpace, public AllocSpace {
     return this;
   }
   collector::ObjectBytePair Sweep(bool swap_bitmaps);
+  // Sweep only the objects in [sweep_begin, sweep_end), see
+  // ContinuousMemMapAllocSpace::SweepRange().
+  collector::ObjectBytePair SweepRange(bool swap_bitmaps,
+                                       uintptr_t sweep_begin,
+                                       uintptr_t sweep_end,
+                                       Thread* gc_thread);
   bool CanMoveObjects() const override {
     return false;
   }
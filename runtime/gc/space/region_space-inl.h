@@ -194,6 +194,15 @@ inline uint64_t RegionSpace::GetObjectsAllocatedInternal() {
 template <typename Visitor>
 inline void RegionSpace::ScanUnevacFromSpace(accounting::ContinuousSpaceBitmap* bitmap,
                                              Visitor&& visitor) {
+  VisitUnevacFromSpaceBlocks([bitmap, &visitor](uint8_t* block_begin, uint8_t* block_end) {
+    bitmap->VisitMarkedRange(reinterpret_cast<uintptr_t>(block_begin),
+                             reinterpret_cast<uintptr_t>(block_end),
+                             visitor);
+  });
+}
+
+template <typename Visitor>
+inline void RegionSpace::VisitUnevacFromSpaceBlocks(Visitor&& visitor) {
   const size_t iter_limit = kUseTableLookupReadBarrier
       ? num_regions_ : std::min(num_regions_, non_free_region_index_limit_);
   // Instead of region-wise scan, find contiguous blocks of un-evac regions and then
@@ -211,17 +220,13 @@ inline void RegionSpace::ScanUnevacFromSpace(accounting::ContinuousSpaceBitmap*
       visit_block_end = r->End();
     } else if (visit_block_begin != nullptr) {
       // Visit the block range as r is not adjacent to current visit block.
-      bitmap->VisitMarkedRange(reinterpret_cast<uintptr_t>(visit_block_begin),
-                               reinterpret_cast<uintptr_t>(visit_block_end),
-                               visitor);
+      visitor(visit_block_begin, visit_block_end);
       visit_block_begin = nullptr;
     }
   }
   // Visit last block, if not processed yet.
   if (visit_block_begin != nullptr) {
-    bitmap->VisitMarkedRange(reinterpret_cast<uintptr_t>(visit_block_begin),
-                             reinterpret_cast<uintptr_t>(visit_block_end),
-                             visitor);
+    visitor(visit_block_begin, visit_block_end);
   }
 }
 
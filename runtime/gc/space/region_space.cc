@@ -13,10 +13,18 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <sys/syscall.h>
+#include <unistd.h>
+
 #include <deque>
 
+#include "android-base/file.h"
+#include "android-base/stringprintf.h"
+#include "android-base/strings.h"
+
 #include "bump_pointer_space-inl.h"
 #include "bump_pointer_space.h"
+#include "base/casts.h"
 #include "base/dumpable.h"
 #include "base/logging.h"
 #include "gc/accounting/read_barrier_table.h"
@@ -28,10 +36,23 @@ namespace art HIDDEN {
 namespace gc {
 namespace space {
 
+using android::base::StringPrintf;
+
 // If a region has live objects whose size is less than this percent
 // value of the region size, evaculate the region.
 static constexpr uint kEvacuateLivePercentThreshold = 75U;
 
+// With survival tracking, regions that are not old yet are evacuated below this live percent
+// instead: their objects are still dying at a high rate, so compacting them now frees more
+// memory than waiting for them to be tenured.
+static constexpr uint kEvacuateYoungSurvivorLivePercentThreshold = 90U;
+
+// Survival percentage from which the objects of an age bucket are considered tenured.
+static constexpr float kTenuredSurvivalPercent = 90.0f;
+
+// Weight of the latest collection in the moving average of the per-bucket survival rates.
+static constexpr float kSurvivalPercentWeight = 0.25f;
+
 // Whether we protect the unused and cleared regions.
 static constexpr bool kProtectClearedRegions = kIsDebugBuild;
 
@@ -49,16 +70,21 @@ static constexpr bool kCheckLiveBytesAgainstRegionBitmap = kIsDebugBuild;
 
 MemMap RegionSpace::CreateMemMap(const std::string& name,
                                  size_t capacity,
-                                 uint8_t* requested_begin) {
+                                 uint8_t* requested_begin,
+                                 bool use_huge_pages) {
   CHECK_ALIGNED(capacity, kRegionSize);
   std::string error_msg;
   // Ask for the capacity of an additional kRegionSize so that we can align the map by kRegionSize
   // even if we get unaligned base address. This is necessary for the ReadBarrierTable to work.
+  // With huge pages, align the start to the huge page size instead so that region boundaries
+  // coincide with huge page boundaries as much as possible.
+  const size_t alignment =
+      use_huge_pages ? std::max(kRegionSize, GetHugePageSize()) : kRegionSize;
   MemMap mem_map;
   while (true) {
     mem_map = MemMap::MapAnonymous(name.c_str(),
                                    requested_begin,
-                                   capacity + kRegionSize,
+                                   capacity + alignment,
                                    PROT_READ | PROT_WRITE,
                                    /*low_4gb=*/ true,
                                    /*reuse=*/ false,
@@ -77,29 +103,57 @@ MemMap RegionSpace::CreateMemMap(const std::string& name,
     MemMap::DumpMaps(LOG_STREAM(ERROR));
     return MemMap::Invalid();
   }
-  CHECK_EQ(mem_map.Size(), capacity + kRegionSize);
+  CHECK_EQ(mem_map.Size(), capacity + alignment);
   CHECK_EQ(mem_map.Begin(), mem_map.BaseBegin());
   CHECK_EQ(mem_map.Size(), mem_map.BaseSize());
-  if (IsAlignedParam(mem_map.Begin(), kRegionSize)) {
-    // Got an aligned map. Since we requested a map that's kRegionSize larger. Shrink by
-    // kRegionSize at the end.
+  if (IsAlignedParam(mem_map.Begin(), alignment)) {
+    // Got an aligned map. Since we requested a map that's `alignment` larger. Shrink by
+    // `alignment` at the end.
     mem_map.SetSize(capacity);
-  } else {
+  } else if (alignment == kRegionSize) {
     // Got an unaligned map. Align the both ends.
     mem_map.AlignBy(kRegionSize);
+  } else {
+    // The capacity need not be a multiple of the huge page size, so align the start and trim the
+    // end back to the capacity.
+    mem_map.AlignBy(alignment, /*align_both_ends=*/ false);
+    mem_map.SetSize(capacity);
   }
   CHECK_ALIGNED(mem_map.Begin(), kRegionSize);
   CHECK_ALIGNED(mem_map.End(), kRegionSize);
   CHECK_EQ(mem_map.Size(), capacity);
+  if (use_huge_pages && mem_map.MadviseHugePages() == -1) {
+    PLOG(WARNING) << "Failed to enable transparent huge pages for " << name;
+  }
   return mem_map;
 }
 
-RegionSpace* RegionSpace::Create(
-    const std::string& name, MemMap&& mem_map, bool use_generational_cc) {
-  return new RegionSpace(name, std::move(mem_map), use_generational_cc);
+// Returns true if more than one NUMA node is online. The sysfs file lists the
+// online nodes as ranges, e.g. "0" or "0-1".
+static bool HasMultipleNumaNodes() {
+  static constexpr const char* kOnlineNodesPath = "/sys/devices/system/node/online";
+  std::string online_nodes;
+  if (!android::base::ReadFileToString(kOnlineNodesPath, &online_nodes)) {
+    return false;
+  }
+  online_nodes = android::base::Trim(online_nodes);
+  return online_nodes.find_first_of(",-") != std::string::npos;
+}
+
+RegionSpace* RegionSpace::Create(const std::string& name,
+                                 MemMap&& mem_map,
+                                 bool use_generational_cc,
+                                 bool use_huge_pages,
+                                 bool numa_aware) {
+  return new RegionSpace(
+      name, std::move(mem_map), use_generational_cc, use_huge_pages, numa_aware);
 }
 
-RegionSpace::RegionSpace(const std::string& name, MemMap&& mem_map, bool use_generational_cc)
+RegionSpace::RegionSpace(const std::string& name,
+                         MemMap&& mem_map,
+                         bool use_generational_cc,
+                         bool use_huge_pages,
+                         bool numa_aware)
     : ContinuousMemMapAllocSpace(name,
                                  std::move(mem_map),
                                  mem_map.Begin(),
@@ -108,6 +162,9 @@ RegionSpace::RegionSpace(const std::string& name, MemMap&& mem_map, bool use_gen
                                  kGcRetentionPolicyAlwaysCollect),
       region_lock_("Region lock", kRegionSpaceRegionLock),
       use_generational_cc_(use_generational_cc),
+      numa_aware_(numa_aware && HasMultipleNumaNodes()),
+      use_huge_pages_(use_huge_pages),
+      num_free_regions_on_node_{},
       time_(1U),
       num_regions_(mem_map_.Size() / kRegionSize),
       madvise_time_(0U),
@@ -117,11 +174,21 @@ RegionSpace::RegionSpace(const std::string& name, MemMap&& mem_map, bool use_gen
       non_free_region_index_limit_(0U),
       current_region_(&full_region_),
       evac_region_(nullptr),
-      cyclic_alloc_region_index_(0U) {
+      cyclic_alloc_region_index_(0U),
+      track_survival_(false),
+      survival_live_bytes_valid_(false),
+      last_young_survival_percent_(-1),
+      tenuring_age_(1U) {
   CHECK_ALIGNED(mem_map_.Size(), kRegionSize);
   CHECK_ALIGNED(mem_map_.Begin(), kRegionSize);
   DCHECK_GT(num_regions_, 0U);
   regions_.reset(new Region[num_regions_]);
+  for (size_t i = 0; i < kNumAgeBuckets; ++i) {
+    evacuated_survivor_bytes_[i].store(0u, std::memory_order_relaxed);
+    survival_allocated_bytes_[i] = 0u;
+    survival_live_bytes_[i] = 0u;
+    recent_survival_percent_[i] = -1.0f;
+  }
   uint8_t* region_addr = mem_map_.Begin();
   for (size_t i = 0; i < num_regions_; ++i, region_addr += kRegionSize) {
     regions_[i].Init(i, region_addr, region_addr + kRegionSize);
@@ -218,14 +285,15 @@ bool RegionSpace::Region::GetUseGenerationalCC() {
   return art::Runtime::Current()->GetHeap()->GetUseGenerationalCC();
 }
 
-inline bool RegionSpace::Region::ShouldBeEvacuated(EvacMode evac_mode) {
+inline bool RegionSpace::Region::ShouldBeEvacuated(EvacMode evac_mode,
+                                                   uint live_percent_threshold) {
   // Evacuation mode `kEvacModeNewlyAllocated` is only used during sticky-bit CC collections.
   DCHECK(GetUseGenerationalCC() || (evac_mode != kEvacModeNewlyAllocated));
   DCHECK((IsAllocated() || IsLarge()) && IsInToSpace());
   // The region should be evacuated if:
   // - the evacuation is forced (!large && `evac_mode == kEvacModeForceAll`); or
   // - the region was allocated after the start of the previous GC (newly allocated region); or
-  // - !large and the live ratio is below threshold (`kEvacuateLivePercentThreshold`).
+  // - !large and the live ratio is below threshold (`live_percent_threshold`).
   if (IsLarge()) {
     // It makes no sense to evacuate in the large case, since the region only contains zero or
     // one object. If the regions is completely empty, we'll reclaim it anyhow. If its one object
@@ -244,9 +312,8 @@ inline bool RegionSpace::Region::ShouldBeEvacuated(EvacMode evac_mode) {
     // the generational hypothesis, even before the Sticky-Bit CC
     // approach).
     //
-    // TODO: Verify that assertion by collecting statistics on the
-    // number/proportion of live objects in newly allocated regions
-    // in RegionSpace::ClearFromSpace.
+    // The survival rate of newly allocated regions can be checked
+    // with survival tracking (see RegionSpace::EnableSurvivalTracking).
     //
     // Note that a side effect of evacuating a newly-allocated
     // non-large region is that the "newly allocated" status will
@@ -265,7 +332,7 @@ inline bool RegionSpace::Region::ShouldBeEvacuated(EvacMode evac_mode) {
       // Side node: live_percent == 0 does not necessarily mean
       // there's no live objects due to rounding (there may be a
       // few).
-      return live_bytes_ * 100U < kEvacuateLivePercentThreshold * bytes_allocated;
+      return live_bytes_ * 100U < live_percent_threshold * bytes_allocated;
     }
   }
   return false;
@@ -322,6 +389,12 @@ void RegionSpace::SetFromSpace(accounting::ReadBarrierTable* rb_table,
   // We cannot use the partially utilized TLABs across a GC. Therefore, revoke
   // them during the thread-flip.
   partial_tlabs_.clear();
+  if (track_survival_) {
+    survival_live_bytes_valid_ = (evac_mode != kEvacModeNewlyAllocated);
+    for (size_t i = 0; i < kNumAgeBuckets; ++i) {
+      evacuated_survivor_bytes_[i].store(0u, std::memory_order_relaxed);
+    }
+  }
 
   // Counter for the number of expected large tail regions following a large region.
   size_t num_expected_large_tails = 0U;
@@ -342,7 +415,10 @@ void RegionSpace::SetFromSpace(accounting::ReadBarrierTable* rb_table,
         DCHECK((state == RegionState::kRegionStateAllocated ||
                 state == RegionState::kRegionStateLarge) &&
                type == RegionType::kRegionTypeToSpace);
-        bool should_evacuate = r->ShouldBeEvacuated(evac_mode);
+        if (track_survival_) {
+          r->age_ = dchecked_integral_cast<uint8_t>(ComputeAgeBucket(r));
+        }
+        bool should_evacuate = r->ShouldBeEvacuated(evac_mode, EvacuateLivePercentThreshold(r));
         bool is_newly_allocated = r->IsNewlyAllocated();
         if (should_evacuate) {
           r->SetAsFromSpace();
@@ -369,6 +445,9 @@ void RegionSpace::SetFromSpace(accounting::ReadBarrierTable* rb_table,
       } else {
         DCHECK(state == RegionState::kRegionStateLargeTail &&
                type == RegionType::kRegionTypeToSpace);
+        if (track_survival_) {
+          r->age_ = dchecked_integral_cast<uint8_t>(ComputeAgeBucket(r));
+        }
         if (prev_large_evacuated) {
           r->SetAsFromSpace();
           DCHECK(r->IsInFromSpace());
@@ -400,15 +479,69 @@ static void ZeroAndProtectRegion(uint8_t* begin, uint8_t* end, bool release_eage
   }
 }
 
-void RegionSpace::ReleaseFreeRegions() {
-  MutexLock mu(Thread::Current(), region_lock_);
-  for (size_t i = 0u; i < num_regions_; ++i) {
-    if (regions_[i].IsFree()) {
-      uint8_t* begin = regions_[i].Begin();
-      DCHECK_ALIGNED_PARAM(begin, gPageSize);
-      DCHECK_ALIGNED_PARAM(regions_[i].End(), gPageSize);
-      bool res = madvise(begin, regions_[i].End() - begin, MADV_DONTNEED);
-      CHECK_NE(res, -1) << "madvise failed";
+void RegionSpace::ZeroAndReleaseRange(uint8_t* begin, uint8_t* end, bool release_eagerly) {
+  if (!use_huge_pages_) {
+    ZeroMemory(begin, end - begin, release_eagerly);
+    return;
+  }
+  // Releasing part of a huge page makes the kernel split it. Only release whole huge pages and
+  // clear the rest by hand; it is most likely resident anyway.
+  const size_t huge_page_size = GetHugePageSize();
+  uint8_t* huge_begin = AlignUp(begin, huge_page_size);
+  uint8_t* huge_end = AlignDown(end, huge_page_size);
+  if (huge_begin >= huge_end) {
+    std::fill(begin, end, 0);
+    return;
+  }
+  std::fill(begin, huge_begin, 0);
+  ZeroMemory(huge_begin, huge_end - huge_begin, release_eagerly);
+  std::fill(huge_end, end, 0);
+}
+
+void RegionSpace::ReleaseFreeRegions(size_t max_batch_bytes) {
+  // Release runs of adjacent free regions at once. This needs fewer madvise calls and, with huge
+  // pages, lets us release huge pages spanning several regions.
+  auto release = [this](uint8_t* begin, uint8_t* end) REQUIRES(region_lock_) {
+    DCHECK_ALIGNED_PARAM(begin, gPageSize);
+    DCHECK_ALIGNED_PARAM(end, gPageSize);
+    if (use_huge_pages_) {
+      // Free regions are already zeroed, so there is nothing to do for partial huge pages.
+      const size_t huge_page_size = GetHugePageSize();
+      begin = AlignUp(begin, huge_page_size);
+      end = AlignDown(end, huge_page_size);
+      if (begin >= end) {
+        return;
+      }
+    }
+    bool res = madvise(begin, end - begin, MADV_DONTNEED);
+    CHECK_NE(res, -1) << "madvise failed";
+    // The released pages will be backed by the node of whoever touches them next.
+    for (uint8_t* addr = AlignUp(begin, kRegionSize); addr + kRegionSize <= end;
+         addr += kRegionSize) {
+      Region* r = RefToRegionLocked(reinterpret_cast<mirror::Object*>(addr));
+      RemoveFreeRegionFromNodeCount(r);
+      r->numa_node_ = kUnknownNumaNode;
+    }
+  };
+  Thread* const self = Thread::Current();
+  size_t i = 0u;
+  while (i < num_regions_) {
+    MutexLock mu(self, region_lock_);
+    uint8_t* free_begin = nullptr;
+    size_t batch_bytes = 0u;
+    for (; i < num_regions_ && batch_bytes < max_batch_bytes; ++i) {
+      if (regions_[i].IsFree()) {
+        if (free_begin == nullptr) {
+          free_begin = regions_[i].Begin();
+        }
+        batch_bytes += kRegionSize;
+      } else if (free_begin != nullptr) {
+        release(free_begin, regions_[i].Begin());
+        free_begin = nullptr;
+      }
+    }
+    if (free_begin != nullptr) {
+      release(free_begin, regions_[i - 1].End());
     }
   }
 }
@@ -497,7 +630,10 @@ void RegionSpace::ClearFromSpace(/* out */ uint64_t* cleared_bytes,
   // Madvise the memory ranges.
   uint64_t start_time = NanoTime();
   for (const auto &iter : madvise_list) {
-    ZeroAndProtectRegion(iter.first, iter.second, release_eagerly);
+    ZeroAndReleaseRange(iter.first, iter.second, release_eagerly);
+    if (kProtectClearedRegions) {
+      CheckedCall(mprotect, __FUNCTION__, iter.first, iter.second - iter.first, PROT_NONE);
+    }
   }
   madvise_time_ += NanoTime() - start_time;
 
@@ -519,24 +655,39 @@ void RegionSpace::ClearFromSpace(/* out */ uint64_t* cleared_bytes,
   max_peak_num_non_free_regions_ = std::max(max_peak_num_non_free_regions_,
                                             num_non_free_regions_);
 
+  // Per age bucket bytes of the collected regions, for the survival histogram.
+  uint64_t survival_allocated_bytes[kNumAgeBuckets] = {};
+  uint64_t survival_live_bytes[kNumAgeBuckets] = {};
   for (size_t i = 0; i < std::min(num_regions_, non_free_region_index_limit_); ++i) {
     Region* r = &regions_[i];
+    if (track_survival_ && !r->IsLargeTail()) {
+      // Regions that survived sticky-bit CC collections without being marked have stale live
+      // bytes, only count the ones this collection computed.
+      if (r->IsInFromSpace()) {
+        survival_allocated_bytes[r->age_] += r->BytesAllocated();
+      } else if (r->IsInUnevacFromSpace() &&
+                 (survival_live_bytes_valid_ || r->age_ == 0u) &&
+                 r->LiveBytes() != static_cast<size_t>(-1)) {
+        survival_allocated_bytes[r->age_] += r->BytesAllocated();
+        survival_live_bytes[r->age_] += r->LiveBytes();
+      }
+    }
     if (r->IsInFromSpace()) {
       DCHECK(!r->IsTlab());
       *cleared_bytes += r->BytesAllocated();
       *cleared_objects += r->ObjectsAllocated();
       --num_non_free_regions_;
-      r->Clear(/*zero_and_release_pages=*/false);
+      ClearZeroedRegion(r, /*pages_released=*/ release_eagerly);
     } else if (r->IsInUnevacFromSpace()) {
       if (r->LiveBytes() == 0) {
         DCHECK(!r->IsLargeTail());
         *cleared_bytes += r->BytesAllocated();
         *cleared_objects += r->ObjectsAllocated();
-        r->Clear(/*zero_and_release_pages=*/false);
+        ClearZeroedRegion(r, /*pages_released=*/ release_eagerly);
         size_t free_regions = 1;
         // Also release RAM for large tails.
         while (i + free_regions < num_regions_ && regions_[i + free_regions].IsLargeTail()) {
-          regions_[i + free_regions].Clear(/*zero_and_release_pages=*/false);
+          ClearZeroedRegion(&regions_[i + free_regions], /*pages_released=*/ release_eagerly);
           ++free_regions;
         }
         num_non_free_regions_ -= free_regions;
@@ -629,6 +780,81 @@ void RegionSpace::ClearFromSpace(/* out */ uint64_t* cleared_bytes,
   evac_region_ = nullptr;
   num_non_free_regions_ += num_evac_regions_;
   num_evac_regions_ = 0;
+  if (track_survival_) {
+    for (size_t i = 0; i < kNumAgeBuckets; ++i) {
+      survival_live_bytes[i] += evacuated_survivor_bytes_[i].load(std::memory_order_relaxed);
+    }
+    UpdateSurvivalHistogram(survival_allocated_bytes, survival_live_bytes);
+  }
+}
+
+size_t RegionSpace::ComputeAgeBucket(Region* r) {
+  DCHECK(!r->IsFree());
+  if (r->IsNewlyAllocated()) {
+    return 0u;
+  }
+  // `time_` was advanced by the starting collection, and evacuation regions are stamped with the
+  // time of the collection that filled them, so a region that survived one collection is 1.
+  DCHECK_GT(time_, r->alloc_time_);
+  return std::min<size_t>(time_ - r->alloc_time_, kNumAgeBuckets - 1u);
+}
+
+uint RegionSpace::EvacuateLivePercentThreshold(Region* r) {
+  if (track_survival_ && !r->IsNewlyAllocated() && r->age_ < tenuring_age_) {
+    return kEvacuateYoungSurvivorLivePercentThreshold;
+  }
+  return kEvacuateLivePercentThreshold;
+}
+
+void RegionSpace::UpdateSurvivalHistogram(const uint64_t (&allocated_bytes)[kNumAgeBuckets],
+                                          const uint64_t (&live_bytes)[kNumAgeBuckets]) {
+  last_young_survival_percent_ = -1;
+  for (size_t i = 0; i < kNumAgeBuckets; ++i) {
+    if (allocated_bytes[i] == 0u) {
+      continue;
+    }
+    // Objects copied to the non-moving space may grow slightly.
+    uint64_t live = std::min(live_bytes[i], allocated_bytes[i]);
+    survival_allocated_bytes_[i] += allocated_bytes[i];
+    survival_live_bytes_[i] += live;
+    float percent = 100.0f * live / allocated_bytes[i];
+    recent_survival_percent_[i] = (recent_survival_percent_[i] < 0.0f)
+        ? percent
+        : kSurvivalPercentWeight * percent +
+              (1.0f - kSurvivalPercentWeight) * recent_survival_percent_[i];
+    if (i == 0u) {
+      last_young_survival_percent_ = static_cast<int32_t>(percent);
+    }
+  }
+  // Regions become old at the youngest age from which most of their objects keep surviving.
+  tenuring_age_ = kNumAgeBuckets - 1u;
+  for (size_t i = 1; i < kNumAgeBuckets - 1u; ++i) {
+    float percent = recent_survival_percent_[i];
+    if (percent < 0.0f || percent >= kTenuredSurvivalPercent) {
+      tenuring_age_ = i;
+      break;
+    }
+  }
+}
+
+int32_t RegionSpace::GetLastYoungSurvivalPercent() {
+  MutexLock mu(Thread::Current(), region_lock_);
+  return last_young_survival_percent_;
+}
+
+void RegionSpace::DumpSurvivalHistogram(std::ostream& os) {
+  MutexLock mu(Thread::Current(), region_lock_);
+  os << "Region survival histogram (tenuring age " << tenuring_age_ << "):\n";
+  for (size_t i = 0; i < kNumAgeBuckets; ++i) {
+    if (survival_allocated_bytes_[i] == 0u) {
+      continue;
+    }
+    os << "  age " << i << ((i == kNumAgeBuckets - 1u) ? "+" : "") << ": "
+       << PrettySize(survival_live_bytes_[i]) << " of " << PrettySize(survival_allocated_bytes_[i])
+       << StringPrintf(" survived (%.1f%%), recent %.1f%%\n",
+                       100.0 * survival_live_bytes_[i] / survival_allocated_bytes_[i],
+                       recent_survival_percent_[i]);
+  }
 }
 
 void RegionSpace::CheckLiveBytesAgainstRegionBitmap(Region* r) {
@@ -783,6 +1009,7 @@ void RegionSpace::Clear() {
     }
     r->Clear(/*zero_and_release_pages=*/true);
   }
+  std::fill_n(num_free_regions_on_node_, kMaxNumaNodes, 0u);
   SetNonFreeRegionLimit(0);
   DCHECK_EQ(num_non_free_regions_, 0u);
   current_region_ = &full_region_;
@@ -859,7 +1086,7 @@ bool RegionSpace::AllocNewTlab(Thread* self,
                                const size_t tlab_size,
                                size_t* bytes_tl_bulk_allocated) {
   MutexLock mu(self, region_lock_);
-  RevokeThreadLocalBuffersLocked(self, /*reuse=*/ gc::Heap::kUsePartialTlabs);
+  RevokeThreadLocalBuffersLocked(self, /*reuse=*/ gc::Heap::kUsePartialTlabs, /*by_gc=*/ false);
   Region* r = nullptr;
   uint8_t* pos = nullptr;
   *bytes_tl_bulk_allocated = tlab_size;
@@ -896,20 +1123,23 @@ bool RegionSpace::AllocNewTlab(Thread* self,
 
 size_t RegionSpace::RevokeThreadLocalBuffers(Thread* thread) {
   MutexLock mu(Thread::Current(), region_lock_);
-  RevokeThreadLocalBuffersLocked(thread, /*reuse=*/ gc::Heap::kUsePartialTlabs);
+  RevokeThreadLocalBuffersLocked(thread, /*reuse=*/ gc::Heap::kUsePartialTlabs, /*by_gc=*/ true);
   return 0U;
 }
 
 size_t RegionSpace::RevokeThreadLocalBuffers(Thread* thread, const bool reuse) {
   MutexLock mu(Thread::Current(), region_lock_);
-  RevokeThreadLocalBuffersLocked(thread, reuse);
+  RevokeThreadLocalBuffersLocked(thread, reuse, /*by_gc=*/ true);
   return 0U;
 }
 
-void RegionSpace::RevokeThreadLocalBuffersLocked(Thread* thread, bool reuse) {
+void RegionSpace::RevokeThreadLocalBuffersLocked(Thread* thread, bool reuse, bool by_gc) {
   uint8_t* tlab_start = thread->GetTlabStart();
   DCHECK_EQ(thread->HasTlab(), tlab_start != nullptr);
   if (tlab_start != nullptr) {
+    // Count the unused part of the TLAB even if it is kept as a partial TLAB, as it is still
+    // a sign that the TLAB was too large for the thread.
+    Runtime::Current()->GetHeap()->RecordTlabWaste(thread, thread->TlabSize(), by_gc);
     Region* r = RefToRegionLocked(reinterpret_cast<mirror::Object*>(tlab_start));
     r->is_a_tlab_ = false;
     r->thread_ = nullptr;
@@ -965,6 +1195,7 @@ void RegionSpace::Region::Dump(std::ostream& os) const {
      << " type=" << type_
      << " objects_allocated=" << objects_allocated_
      << " alloc_time=" << alloc_time_
+     << " numa_node=" << numa_node_
      << " live_bytes=" << live_bytes_;
 
   if (live_bytes_ != static_cast<size_t>(-1)) {
@@ -1027,6 +1258,8 @@ void RegionSpace::Region::Clear(bool zero_and_release_pages) {
   live_bytes_ = static_cast<size_t>(-1);
   if (zero_and_release_pages) {
     ZeroAndProtectRegion(begin_, end_, /* release_eagerly= */ true);
+    // The pages will be backed by the node of whoever touches them next.
+    numa_node_ = kUnknownNumaNode;
   }
   is_newly_allocated_ = false;
   is_a_tlab_ = false;
@@ -1038,10 +1271,51 @@ void RegionSpace::TraceHeapSize() {
   heap->TraceHeapSize(heap->GetBytesAllocated() + EvacBytes());
 }
 
+int32_t RegionSpace::GetCurrentNumaNode() {
+#if defined(__linux__)
+  unsigned int cpu;
+  unsigned int node;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0 && node < kMaxNumaNodes) {
+    return static_cast<int32_t>(node);
+  }
+#endif
+  return kUnknownNumaNode;
+}
+
+void RegionSpace::AddFreeRegionToNodeCount(Region* r) {
+  DCHECK(r->IsFree());
+  if (r->numa_node_ != kUnknownNumaNode) {
+    ++num_free_regions_on_node_[r->numa_node_];
+  }
+}
+
+void RegionSpace::RemoveFreeRegionFromNodeCount(Region* r) {
+  DCHECK(r->IsFree());
+  if (r->numa_node_ != kUnknownNumaNode) {
+    DCHECK_NE(num_free_regions_on_node_[r->numa_node_], 0u);
+    --num_free_regions_on_node_[r->numa_node_];
+  }
+}
+
+void RegionSpace::ClearZeroedRegion(Region* r, bool pages_released) {
+  r->Clear(/*zero_and_release_pages=*/false);
+  if (pages_released) {
+    r->numa_node_ = kUnknownNumaNode;
+  } else {
+    AddFreeRegionToNodeCount(r);
+  }
+}
+
 RegionSpace::Region* RegionSpace::AllocateRegion(bool for_evac) {
   if (!for_evac && (num_non_free_regions_ + 1) * 2 > num_regions_) {
     return nullptr;
   }
+  // In NUMA-aware mode, prefer a free region last used on the caller's node.
+  // Failing that, take the first free region, like the non-NUMA-aware mode.
+  // For evacuation, this keeps survivors on the node of the thread copying them.
+  const int32_t numa_node = numa_aware_ ? GetCurrentNumaNode() : kUnknownNumaNode;
+  const bool local_only =
+      numa_node != kUnknownNumaNode && num_free_regions_on_node_[numa_node] != 0u;
   for (size_t i = 0; i < num_regions_; ++i) {
     // When using the cyclic region allocation strategy, try to
     // allocate a region starting from the last cyclic allocated
@@ -1051,33 +1325,46 @@ RegionSpace::Region* RegionSpace::AllocateRegion(bool for_evac) {
         ? ((cyclic_alloc_region_index_ + i) % num_regions_)
         : i;
     Region* r = &regions_[region_index];
-    if (r->IsFree()) {
-      r->Unfree(this, time_);
-      if (use_generational_cc_) {
-        // TODO: Add an explanation for this assertion.
-        DCHECK_IMPLIES(for_evac, !r->is_newly_allocated_);
-      }
-      if (for_evac) {
-        ++num_evac_regions_;
-        TraceHeapSize();
-        // Evac doesn't count as newly allocated.
-      } else {
-        r->SetNewlyAllocated();
-        ++num_non_free_regions_;
-      }
-      if (kCyclicRegionAllocation) {
-        // Move the cyclic allocation region marker to the region
-        // following the one that was just allocated.
-        cyclic_alloc_region_index_ = (region_index + 1) % num_regions_;
-      }
-      return r;
+    if (r->IsFree() && (!local_only || r->numa_node_ == numa_node)) {
+      return AllocateFreeRegion(r, region_index, for_evac, numa_node);
     }
   }
+  DCHECK(!local_only) << "Free region count of node " << numa_node << " is out of date";
   return nullptr;
 }
 
+RegionSpace::Region* RegionSpace::AllocateFreeRegion(Region* r,
+                                                     size_t region_index,
+                                                     bool for_evac,
+                                                     int32_t numa_node) {
+  DCHECK(r->IsFree());
+  r->Unfree(this, time_);
+  if (numa_node != kUnknownNumaNode) {
+    r->numa_node_ = numa_node;
+  }
+  if (use_generational_cc_) {
+    // TODO: Add an explanation for this assertion.
+    DCHECK_IMPLIES(for_evac, !r->is_newly_allocated_);
+  }
+  if (for_evac) {
+    ++num_evac_regions_;
+    TraceHeapSize();
+    // Evac doesn't count as newly allocated.
+  } else {
+    r->SetNewlyAllocated();
+    ++num_non_free_regions_;
+  }
+  if (kCyclicRegionAllocation) {
+    // Move the cyclic allocation region marker to the region
+    // following the one that was just allocated.
+    cyclic_alloc_region_index_ = (region_index + 1) % num_regions_;
+  }
+  return r;
+}
+
 void RegionSpace::Region::MarkAsAllocated(RegionSpace* region_space, uint32_t alloc_time) {
   DCHECK(IsFree());
+  region_space->RemoveFreeRegionFromNodeCount(this);
   alloc_time_ = alloc_time;
   region_space->AdjustNonFreeRegionLimit(idx_);
   type_ = RegionType::kRegionTypeToSpace;
@@ -23,6 +23,7 @@
 #include "thread.h"
 
 #include <functional>
+#include <limits>
 #include <map>
 
 namespace art HIDDEN {
@@ -48,6 +49,10 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
  public:
   using WalkCallback = void (*)(void *start, void *end, size_t num_bytes, void* callback_arg);
 
+  static constexpr int32_t kUnknownNumaNode = -1;
+  // Regions on nodes at or above this limit are not tracked and treated as on an unknown node.
+  static constexpr size_t kMaxNumaNodes = 8;
+
   enum EvacMode {
     kEvacModeNewlyAllocated,
     kEvacModeLivePercentNewlyAllocated,
@@ -61,8 +66,21 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   // Create a region space mem map with the requested sizes. The requested base address is not
   // guaranteed to be granted, if it is required, the caller should call Begin on the returned
   // space to confirm the request was granted.
-  static MemMap CreateMemMap(const std::string& name, size_t capacity, uint8_t* requested_begin);
-  static RegionSpace* Create(const std::string& name, MemMap&& mem_map, bool use_generational_cc);
+  // With `use_huge_pages`, the map is aligned to the transparent huge page size and advised to be
+  // backed by huge pages.
+  static MemMap CreateMemMap(const std::string& name,
+                             size_t capacity,
+                             uint8_t* requested_begin,
+                             bool use_huge_pages = false);
+  // If `numa_aware` is set and the system has more than one memory node, a free region whose
+  // pages were last backed by the allocating thread's node is preferred over other free regions.
+  // Free regions keep their (zeroed) pages unless released eagerly, so without this a thread could
+  // easily be handed a TLAB backed by remote memory.
+  static RegionSpace* Create(const std::string& name,
+                             MemMap&& mem_map,
+                             bool use_generational_cc,
+                             bool use_huge_pages = false,
+                             bool numa_aware = false);
 
   // Allocate `num_bytes`, returns null if the space is full.
   mirror::Object* Alloc(Thread* self,
@@ -224,6 +242,11 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   ALWAYS_INLINE void ScanUnevacFromSpace(accounting::ContinuousSpaceBitmap* bitmap,
                                          Visitor&& visitor) NO_THREAD_SAFETY_ANALYSIS;
 
+  // Calls visitor(begin, end) for every maximal block of contiguous unevac-space regions, in
+  // address order. Same restrictions as ScanUnevacFromSpace().
+  template <typename Visitor>
+  ALWAYS_INLINE void VisitUnevacFromSpaceBlocks(Visitor&& visitor) NO_THREAD_SAFETY_ANALYSIS;
+
   accounting::ContinuousSpaceBitmap::SweepCallback* GetSweepCallback() override {
     return nullptr;
   }
@@ -322,6 +345,36 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
     reg->AddLiveBytes(alloc_size);
   }
 
+  // Number of age buckets of the survival histogram. Bucket 0 holds the regions allocated since
+  // the previous collection, bucket `i` the regions whose objects have survived `i` collections
+  // and the last bucket all older regions.
+  static constexpr size_t kNumAgeBuckets = 8;
+
+  // Track region ages and gather the survival histogram in ClearFromSpace. Must be called before
+  // the first collection.
+  void EnableSurvivalTracking() {
+    track_survival_ = true;
+  }
+
+  bool IsSurvivalTrackingEnabled() const {
+    return track_survival_;
+  }
+
+  // Record that `alloc_size` bytes of the from-space object `ref` survived by being evacuated.
+  void RecordEvacuatedSurvivor(mirror::Object* ref, size_t alloc_size) {
+    DCHECK(track_survival_);
+    Region* reg = RefToRegionUnlocked(ref);
+    DCHECK(reg->IsInFromSpace());
+    evacuated_survivor_bytes_[reg->age_].fetch_add(alloc_size, std::memory_order_relaxed);
+  }
+
+  // Percentage of the bytes allocated since the previous collection that survived the last
+  // collection, or -1 if unknown.
+  int32_t GetLastYoungSurvivalPercent() REQUIRES(!region_lock_);
+
+  // Print the cumulative and recent survival rate of each age bucket.
+  void DumpSurvivalHistogram(std::ostream& os) REQUIRES(!region_lock_);
+
   void AssertAllRegionLiveBytesZeroOrCleared() REQUIRES(!region_lock_) {
     if (kIsDebugBuild) {
       MutexLock mu(Thread::Current(), region_lock_);
@@ -385,10 +438,22 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
     return madvise_time_;
   }
 
-  void ReleaseFreeRegions();
+  // Release the pages of the free regions to the kernel. Runs of free regions are released
+  // under region_lock_ in batches of up to `max_batch_bytes`, the lock is dropped between batches
+  // so that allocating threads are not blocked by a long series of madvise calls.
+  void ReleaseFreeRegions(size_t max_batch_bytes = std::numeric_limits<size_t>::max())
+      REQUIRES(!region_lock_);
 
  private:
-  RegionSpace(const std::string& name, MemMap&& mem_map, bool use_generational_cc);
+  RegionSpace(const std::string& name,
+              MemMap&& mem_map,
+              bool use_generational_cc,
+              bool use_huge_pages,
+              bool numa_aware);
+
+  // Zero [begin, end) and release its memory to the kernel. With huge pages, only whole huge
+  // pages are released; the remainder is just zeroed so as not to split huge pages.
+  void ZeroAndReleaseRange(uint8_t* begin, uint8_t* end, bool release_eagerly);
 
   class Region {
    public:
@@ -401,8 +466,10 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
           end_(nullptr),
           objects_allocated_(0),
           alloc_time_(0),
+          numa_node_(kUnknownNumaNode),
           is_newly_allocated_(false),
           is_a_tlab_(false),
+          age_(0),
           state_(RegionState::kRegionStateAllocated),
           type_(RegionType::kRegionTypeToSpace) {}
 
@@ -415,9 +482,11 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
       type_ = RegionType::kRegionTypeNone;
       objects_allocated_.store(0, std::memory_order_relaxed);
       alloc_time_ = 0;
+      numa_node_ = kUnknownNumaNode;
       live_bytes_ = static_cast<size_t>(-1);
       is_newly_allocated_ = false;
       is_a_tlab_ = false;
+      age_ = 0;
       thread_ = nullptr;
       DCHECK_LT(begin, end);
       DCHECK_EQ(static_cast<size_t>(end - begin), kRegionSize);
@@ -557,7 +626,9 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
     }
 
     // Return whether this region should be evacuated. Used by RegionSpace::SetFromSpace.
-    ALWAYS_INLINE bool ShouldBeEvacuated(EvacMode evac_mode);
+    // Regions that are not newly allocated are evacuated by live percent when their live ratio
+    // is below `live_percent_threshold`.
+    ALWAYS_INLINE bool ShouldBeEvacuated(EvacMode evac_mode, uint live_percent_threshold);
 
     void AddLiveBytes(size_t live_bytes) {
       DCHECK(GetUseGenerationalCC() || IsInUnevacFromSpace());
@@ -635,10 +706,16 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
     // are concurrent updates.
     Atomic<size_t> objects_allocated_;  // The number of objects allocated.
     uint32_t alloc_time_;               // The allocation time of the region.
+    // The NUMA node of the thread which first allocated the region since its
+    // pages were last released, or kUnknownNumaNode.
+    int32_t numa_node_;
     // Note that newly allocated and evacuated regions use -1 as
     // special value for `live_bytes_`.
     bool is_newly_allocated_;           // True if it's allocated after the last collection.
     bool is_a_tlab_;                    // True if it's a tlab.
+    // Age bucket of the survival histogram, set by RegionSpace::SetFromSpace when survival
+    // tracking is enabled.
+    uint8_t age_;
     RegionState state_;                 // The region state (see RegionState).
     RegionType type_;                   // The region type (see RegionType).
 
@@ -716,7 +793,22 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   }
 
   EXPORT Region* AllocateRegion(bool for_evac) REQUIRES(region_lock_);
-  void RevokeThreadLocalBuffersLocked(Thread* thread, bool reuse) REQUIRES(region_lock_);
+  // Called by AllocateRegion() to turn the free region `r` at `region_index`
+  // into an allocated one, recording `numa_node` as the node backing it.
+  Region* AllocateFreeRegion(Region* r, size_t region_index, bool for_evac, int32_t numa_node)
+      REQUIRES(region_lock_);
+  // Returns the NUMA node of the CPU the calling thread is running on, or
+  // kUnknownNumaNode if it cannot be determined or is not tracked.
+  static int32_t GetCurrentNumaNode();
+  // Keep `num_free_regions_on_node_` up to date when the free region `r` is added or removed.
+  void AddFreeRegionToNodeCount(Region* r) REQUIRES(region_lock_);
+  void RemoveFreeRegionFromNodeCount(Region* r) REQUIRES(region_lock_);
+  // Make the from-space region `r`, whose pages were zeroed, free. If `pages_released`, the
+  // pages no longer belong to any node.
+  void ClearZeroedRegion(Region* r, bool pages_released) REQUIRES(region_lock_);
+  // `by_gc` is false if the TLAB is revoked by the thread itself to get a new one.
+  void RevokeThreadLocalBuffersLocked(Thread* thread, bool reuse, bool by_gc)
+      REQUIRES(region_lock_);
 
   // Scan region range [`begin`, `end`) in increasing order to try to
   // allocate a large region having a size of `num_regs_in_large_region`
@@ -740,6 +832,18 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   // in the region space bitmap range corresponding to region `r`.
   void CheckLiveBytesAgainstRegionBitmap(Region* r);
 
+  // Age bucket of the survival histogram for non-free region `r`, to be called once `time_` has
+  // been advanced for the starting collection.
+  size_t ComputeAgeBucket(Region* r) REQUIRES(region_lock_);
+
+  // Live percent below which the non-newly allocated region `r` is evacuated.
+  uint EvacuateLivePercentThreshold(Region* r) REQUIRES(region_lock_);
+
+  // Fold the per-bucket bytes of the collection ending in ClearFromSpace into the histogram.
+  void UpdateSurvivalHistogram(const uint64_t (&allocated_bytes)[kNumAgeBuckets],
+                               const uint64_t (&live_bytes)[kNumAgeBuckets])
+      REQUIRES(region_lock_);
+
   // Poison memory areas used by dead objects within unevacuated
   // region `r`. This is meant to detect dangling references to dead
   // objects earlier in debug mode.
@@ -749,6 +853,15 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
 
   // Cached version of Heap::use_generational_cc_.
   const bool use_generational_cc_;
+  // True if NUMA-aware allocation was requested with -XX:UseNumaAwareRegionAllocation and the
+  // system has more than one memory node.
+  const bool numa_aware_;
+  // True if the space was created with -XX:UseTransparentHugePages. Memory is then released at
+  // huge page granularity.
+  const bool use_huge_pages_;
+  // The number of free regions whose pages are backed by each NUMA node. Used to skip the search
+  // for a node-local region when there is none.
+  size_t num_free_regions_on_node_[kMaxNumaNodes] GUARDED_BY(region_lock_);
   uint32_t time_;                  // The time as the number of collections since the startup.
   size_t num_regions_;             // The number of regions in this space.
   uint64_t madvise_time_;          // The amount of time spent in madvise for purging pages.
@@ -788,6 +901,24 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   // Mark bitmap used by the GC.
   accounting::ContinuousSpaceBitmap mark_bitmap_;
 
+  // Survival histogram, see EnableSurvivalTracking().
+  bool track_survival_;
+  // Whether the live bytes of the unevacuated regions are computed by the current collection.
+  // Sticky-bit CC collections only mark the objects of newly allocated regions.
+  bool survival_live_bytes_valid_;
+  // Bytes of the from-space objects of each age bucket that were evacuated by the current
+  // collection.
+  Atomic<uint64_t> evacuated_survivor_bytes_[kNumAgeBuckets];
+  // Cumulative bytes allocated in, and surviving from, the collected regions of each age bucket.
+  uint64_t survival_allocated_bytes_[kNumAgeBuckets] GUARDED_BY(region_lock_);
+  uint64_t survival_live_bytes_[kNumAgeBuckets] GUARDED_BY(region_lock_);
+  // Exponential moving average of the per-collection survival percentage of each age bucket,
+  // or -1 until a collection saw regions of that age.
+  float recent_survival_percent_[kNumAgeBuckets] GUARDED_BY(region_lock_);
+  int32_t last_young_survival_percent_ GUARDED_BY(region_lock_);
+  // Youngest age at which regions are considered old, derived from `recent_survival_percent_`.
+  size_t tenuring_age_ GUARDED_BY(region_lock_);
+
   DISALLOW_COPY_AND_ASSIGN(RegionSpace);
 };
 
@@ -88,20 +88,32 @@ DiscontinuousSpace::DiscontinuousSpace(const std::string& name,
 }
 
 collector::ObjectBytePair ContinuousMemMapAllocSpace::Sweep(bool swap_bitmaps) {
+  return SweepRange(swap_bitmaps,
+                    reinterpret_cast<uintptr_t>(Begin()),
+                    reinterpret_cast<uintptr_t>(End()),
+                    Thread::Current());
+}
+
+collector::ObjectBytePair ContinuousMemMapAllocSpace::SweepRange(bool swap_bitmaps,
+                                                                 uintptr_t sweep_begin,
+                                                                 uintptr_t sweep_end,
+                                                                 Thread* gc_thread) {
   accounting::ContinuousSpaceBitmap* live_bitmap = GetLiveBitmap();
   accounting::ContinuousSpaceBitmap* mark_bitmap = GetMarkBitmap();
   // If the bitmaps are bound then sweeping this space clearly won't do anything.
   if (live_bitmap == mark_bitmap) {
     return collector::ObjectBytePair(0, 0);
   }
-  SweepCallbackContext scc(swap_bitmaps, this);
+  DCHECK_GE(sweep_begin, reinterpret_cast<uintptr_t>(Begin()));
+  DCHECK_LE(sweep_end, reinterpret_cast<uintptr_t>(End()));
+  SweepCallbackContext scc(swap_bitmaps, this, gc_thread);
   if (swap_bitmaps) {
     std::swap(live_bitmap, mark_bitmap);
   }
   // Bitmaps are pre-swapped for optimization which enables sweeping with the heap unlocked.
   accounting::ContinuousSpaceBitmap::SweepWalk(
-      *live_bitmap, *mark_bitmap, reinterpret_cast<uintptr_t>(Begin()),
-      reinterpret_cast<uintptr_t>(End()), GetSweepCallback(), reinterpret_cast<void*>(&scc));
+      *live_bitmap, *mark_bitmap, sweep_begin, sweep_end, GetSweepCallback(),
+      reinterpret_cast<void*>(&scc));
   return scc.freed;
 }
 
@@ -133,8 +145,13 @@ void ContinuousMemMapAllocSpace::SwapBitmaps() {
   mark_bitmap_.SetName(temp_name);
 }
 
-AllocSpace::SweepCallbackContext::SweepCallbackContext(bool swap_bitmaps_in, space::Space* space_in)
-    : swap_bitmaps(swap_bitmaps_in), space(space_in), self(Thread::Current()) {
+AllocSpace::SweepCallbackContext::SweepCallbackContext(bool swap_bitmaps_in,
+                                                      space::Space* space_in,
+                                                      Thread* gc_thread_in)
+    : swap_bitmaps(swap_bitmaps_in),
+      space(space_in),
+      self(Thread::Current()),
+      gc_thread(gc_thread_in) {
 }
 
 }  // namespace space
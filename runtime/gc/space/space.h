@@ -250,10 +250,14 @@ class AllocSpace {
 
  protected:
   struct SweepCallbackContext {
-    SweepCallbackContext(bool swap_bitmaps, space::Space* space);
+    SweepCallbackContext(bool swap_bitmaps, space::Space* space, Thread* gc_thread);
     const bool swap_bitmaps;
     space::Space* const space;
+    // The thread doing the sweeping.
     Thread* const self;
+    // The thread which holds the heap bitmap lock on behalf of all the sweeping threads. Differs
+    // from `self` when sweeping in parallel.
+    Thread* const gc_thread;
     collector::ObjectBytePair freed;
   };
 
@@ -452,6 +456,13 @@ class ContinuousMemMapAllocSpace : public MemMapSpace, public AllocSpace {
   }
 
   collector::ObjectBytePair Sweep(bool swap_bitmaps);
+  // Sweep only the objects in [sweep_begin, sweep_end). Threads may sweep disjoint ranges in
+  // parallel as long as no bitmap word straddles two ranges. `gc_thread` is the thread holding
+  // the heap bitmap lock exclusively.
+  collector::ObjectBytePair SweepRange(bool swap_bitmaps,
+                                       uintptr_t sweep_begin,
+                                       uintptr_t sweep_end,
+                                       Thread* gc_thread);
   virtual accounting::ContinuousSpaceBitmap::SweepCallback* GetSweepCallback() = 0;
 
  protected:
@@ -17,6 +17,7 @@
 #include "hidden_api.h"
 
 #include <atomic>
+#include <optional>
 
 #include "art_field-inl.h"
 #include "art_method-inl.h"
@@ -573,20 +574,101 @@ bool HandleCorePlatformApiViolation(T* member,
   return policy == EnforcementPolicy::kEnabled;
 }
 
+// Caller-independent facts about a member that the slow path needs: its hiddenapi
+// dex flags and whether its signature matches the exemption lists. Computing them
+// requires a linear scan of the class data and building the member signature.
+struct MemberInfo {
+  ApiList api_list;
+  bool is_exempt;
+  bool is_warning_exempt;
+};
+
+// Small direct-mapped cache of MemberInfo for boot class path members, so that
+// repeated checks of the same hidden member (for example reflection or JNI in a
+// loop) skip the dex flags lookup and the signature matching. Only boot class
+// path members are cached as their ArtField/ArtMethod storage is never freed and
+// the pointer therefore identifies the member for the lifetime of the runtime.
+// Results are not stored in the member itself because writing access flags
+// dirties boot image pages. Each entry is guarded by a sequence counter; readers
+// never block and writers give up if the entry is being updated concurrently.
+class MemberInfoCache {
+ public:
+  bool Lookup(const void* member, uint32_t generation, /*out*/ MemberInfo* info) const {
+    const Entry& entry = entries_[GetIndex(member)];
+    uint32_t seq = entry.seq.load(std::memory_order_acquire);
+    if ((seq & 1u) != 0u) {
+      return false;
+    }
+    const void* cached_member = entry.member.load(std::memory_order_relaxed);
+    uint64_t value = entry.value.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (entry.seq.load(std::memory_order_relaxed) != seq ||
+        cached_member != member ||
+        static_cast<uint32_t>(value >> 32) != generation) {
+      return false;
+    }
+    info->api_list = ApiList(static_cast<uint32_t>(value) & kDexFlagsMask);
+    info->is_exempt = (value & kExemptBit) != 0u;
+    info->is_warning_exempt = (value & kWarningExemptBit) != 0u;
+    return true;
+  }
+
+  void Insert(const void* member, uint32_t generation, const MemberInfo& info) {
+    DCHECK_EQ(info.api_list.GetDexFlags() & ~kDexFlagsMask, 0u);
+    Entry& entry = entries_[GetIndex(member)];
+    uint32_t seq = entry.seq.load(std::memory_order_relaxed);
+    if ((seq & 1u) != 0u ||
+        !entry.seq.compare_exchange_strong(seq, seq + 1u, std::memory_order_relaxed)) {
+      return;  // Another thread is updating this entry.
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    uint64_t value = (static_cast<uint64_t>(generation) << 32) |
+                     info.api_list.GetDexFlags() |
+                     (info.is_exempt ? kExemptBit : 0u) |
+                     (info.is_warning_exempt ? kWarningExemptBit : 0u);
+    entry.member.store(member, std::memory_order_relaxed);
+    entry.value.store(value, std::memory_order_relaxed);
+    entry.seq.store(seq + 2u, std::memory_order_release);
+  }
+
+ private:
+  static constexpr size_t kSize = 512u;
+  static constexpr uint32_t kDexFlagsMask = 0xffffu;
+  static constexpr uint64_t kExemptBit = 1u << 16;
+  static constexpr uint64_t kWarningExemptBit = 1u << 17;
+
+  struct Entry {
+    std::atomic<uint32_t> seq = 0u;
+    std::atomic<const void*> member = nullptr;
+    std::atomic<uint64_t> value = 0u;
+  };
+
+  static size_t GetIndex(const void* member) {
+    uintptr_t address = reinterpret_cast<uintptr_t>(member);
+    return ((address >> 3) ^ (address >> 12)) & (kSize - 1u);
+  }
+
+  Entry entries_[kSize];
+};
+
+static MemberInfoCache gMemberInfoCache;
+
 template <typename T>
-bool ShouldDenyAccessToMemberImpl(T* member, ApiList api_list, AccessMethod access_method) {
-  DCHECK(member != nullptr);
+static bool ShouldDenyAccessToMemberImpl(T* member,
+                                         const MemberInfo& info,
+                                         std::optional<MemberSignature>& member_signature,
+                                         AccessMethod access_method)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
   Runtime* runtime = Runtime::Current();
   CompatFramework& compatFramework = runtime->GetCompatFramework();
+  const ApiList api_list = info.api_list;
 
   EnforcementPolicy hiddenApiPolicy = runtime->GetHiddenApiEnforcementPolicy();
   DCHECK(hiddenApiPolicy != EnforcementPolicy::kDisabled)
       << "Should never enter this function when access checks are completely disabled";
 
-  MemberSignature member_signature(member);
-
   // Check for an exemption first. Exempted APIs are treated as SDK.
-  if (member_signature.DoesPrefixMatchAny(runtime->GetHiddenApiExemptions())) {
+  if (info.is_exempt) {
     // Avoid re-examining the exemption list next time.
     // Note this results in no warning for the member, which seems like what one would expect.
     // Exemptions effectively adds new members to the public API list.
@@ -617,16 +699,20 @@ bool ShouldDenyAccessToMemberImpl(T* member, ApiList api_list, AccessMethod acce
   }
 
   if (access_method != AccessMethod::kNone) {
+    if (!member_signature.has_value()) {
+      member_signature.emplace(member);
+    }
+
     // Warn if blocked signature is being accessed or it is not exempted.
-    if (deny_access || !member_signature.DoesPrefixMatchAny(kWarningExemptions)) {
+    if (deny_access || !info.is_warning_exempt) {
       // Print a log message with information about this class member access.
       // We do this if we're about to deny access, or the app is debuggable.
       if (kLogAllAccesses || deny_access || runtime->IsJavaDebuggable()) {
-        member_signature.WarnAboutAccess(access_method, api_list, deny_access);
+        member_signature->WarnAboutAccess(access_method, api_list, deny_access);
       }
 
       // If there is a StrictMode listener, notify it about this violation.
-      member_signature.NotifyHiddenApiListener(access_method);
+      member_signature->NotifyHiddenApiListener(access_method);
     }
 
     // If event log sampling is enabled, report this violation.
@@ -637,7 +723,7 @@ bool ShouldDenyAccessToMemberImpl(T* member, ApiList api_list, AccessMethod acce
       if (eventLogSampleRate != 0) {
         const uint32_t sampled_value = static_cast<uint32_t>(std::rand()) & 0xffff;
         if (sampled_value <= eventLogSampleRate) {
-          member_signature.LogAccessToEventLog(sampled_value, access_method, deny_access);
+          member_signature->LogAccessToEventLog(sampled_value, access_method, deny_access);
         }
       }
     }
@@ -653,6 +739,46 @@ bool ShouldDenyAccessToMemberImpl(T* member, ApiList api_list, AccessMethod acce
   return deny_access;
 }
 
+template <typename T>
+bool ShouldDenyAccessToMemberImpl(T* member, ApiList api_list, AccessMethod access_method) {
+  DCHECK(member != nullptr);
+  Runtime* runtime = Runtime::Current();
+  std::optional<MemberSignature> member_signature(std::in_place, member);
+  MemberInfo info;
+  info.api_list = api_list;
+  info.is_exempt = member_signature->DoesPrefixMatchAny(runtime->GetHiddenApiExemptions());
+  info.is_warning_exempt = member_signature->DoesPrefixMatchAny(kWarningExemptions);
+  return ShouldDenyAccessToMemberImpl(member, info, member_signature, access_method);
+}
+
+template <typename T>
+bool ShouldDenyAccessToMemberImpl(T* member, AccessMethod access_method) {
+  DCHECK(member != nullptr);
+  Runtime* runtime = Runtime::Current();
+  const bool cacheable =
+      !runtime->IsAotCompiler() && member->GetDeclaringClass()->IsBootStrapClassLoaded();
+  const uint32_t generation = runtime->GetHiddenApiExemptionsGeneration();
+  MemberInfo info;
+  if (cacheable && gMemberInfoCache.Lookup(member, generation, &info)) {
+    std::optional<MemberSignature> member_signature;
+    return ShouldDenyAccessToMemberImpl(member, info, member_signature, access_method);
+  }
+
+  // Decode hidden API access flags from the dex file.
+  // This is an O(N) operation scaling with the number of fields/methods
+  // in the class. Only do this on slow path and only do it once.
+  info.api_list = ApiList(GetDexFlags(member));
+  DCHECK(info.api_list.IsValid());
+
+  std::optional<MemberSignature> member_signature(std::in_place, member);
+  info.is_exempt = member_signature->DoesPrefixMatchAny(runtime->GetHiddenApiExemptions());
+  info.is_warning_exempt = member_signature->DoesPrefixMatchAny(kWarningExemptions);
+  if (cacheable) {
+    gMemberInfoCache.Insert(member, generation, info);
+  }
+  return ShouldDenyAccessToMemberImpl(member, info, member_signature, access_method);
+}
+
 // Need to instantiate these.
 template uint32_t GetDexFlags<ArtField>(ArtField* member);
 template uint32_t GetDexFlags<ArtMethod>(ArtMethod* member);
@@ -670,6 +796,10 @@ template bool ShouldDenyAccessToMemberImpl<ArtField>(ArtField* member,
 template bool ShouldDenyAccessToMemberImpl<ArtMethod>(ArtMethod* member,
                                                       ApiList api_list,
                                                       AccessMethod access_method);
+template bool ShouldDenyAccessToMemberImpl<ArtField>(ArtField* member,
+                                                     AccessMethod access_method);
+template bool ShouldDenyAccessToMemberImpl<ArtMethod>(ArtMethod* member,
+                                                      AccessMethod access_method);
 }  // namespace detail
 
 template <typename T>
@@ -735,14 +865,8 @@ bool ShouldDenyAccessToMember(T* member,
       // If this is a proxy method, look at the interface method instead.
       member = detail::GetInterfaceMemberIfProxy(member);
 
-      // Decode hidden API access flags from the dex file.
-      // This is an O(N) operation scaling with the number of fields/methods
-      // in the class. Only do this on slow path and only do it once.
-      ApiList api_list(detail::GetDexFlags(member));
-      DCHECK(api_list.IsValid());
-
       // Member is hidden and caller is not exempted. Enter slow path.
-      return detail::ShouldDenyAccessToMemberImpl(member, api_list, access_method);
+      return detail::ShouldDenyAccessToMemberImpl(member, access_method);
     }
 
     case Domain::kPlatform: {
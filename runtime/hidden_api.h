@@ -233,6 +233,13 @@ template<typename T>
 bool ShouldDenyAccessToMemberImpl(T* member, ApiList api_list, AccessMethod access_method)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
+// As above, but looks up the hiddenapi flags of `member` and caches them, together
+// with the result of matching the member against the exemption lists, for members
+// of the boot class path. The cache is invalidated when the exemptions change.
+template<typename T>
+bool ShouldDenyAccessToMemberImpl(T* member, AccessMethod access_method)
+    REQUIRES_SHARED(Locks::mutator_lock_);
+
 inline ArtField* GetInterfaceMemberIfProxy(ArtField* field) { return field; }
 
 inline ArtMethod* GetInterfaceMemberIfProxy(ArtMethod* method)
@@ -298,6 +305,8 @@ ALWAYS_INLINE inline uint32_t GetRuntimeFlags(ArtMethod* method)
       case Intrinsics::kCRC32Update:
       case Intrinsics::kCRC32UpdateBytes:
       case Intrinsics::kCRC32UpdateByteBuffer:
+      case Intrinsics::kCRC32CUpdateBytes:
+      case Intrinsics::kCRC32CUpdateDirectByteBuffer:
       case Intrinsics::kStringNewStringFromBytes:
       case Intrinsics::kStringNewStringFromChars:
       case Intrinsics::kStringNewStringFromString:
@@ -327,6 +336,12 @@ ALWAYS_INLINE inline uint32_t GetRuntimeFlags(ArtMethod* method)
       case Intrinsics::kUnsafeLoadFence:
       case Intrinsics::kUnsafeStoreFence:
       case Intrinsics::kUnsafeFullFence:
+      case Intrinsics::kUnsafeGetByteAbsolute:
+      case Intrinsics::kUnsafeGetAbsolute:
+      case Intrinsics::kUnsafeGetLongAbsolute:
+      case Intrinsics::kUnsafePutByteAbsolute:
+      case Intrinsics::kUnsafePutAbsolute:
+      case Intrinsics::kUnsafePutLongAbsolute:
       case Intrinsics::kJdkUnsafeArrayBaseOffset:
       case Intrinsics::kJdkUnsafeCASInt:
       case Intrinsics::kJdkUnsafeCASLong:
@@ -365,6 +380,12 @@ ALWAYS_INLINE inline uint32_t GetRuntimeFlags(ArtMethod* method)
       case Intrinsics::kJdkUnsafePut:
       case Intrinsics::kJdkUnsafePutReference:
       case Intrinsics::kJdkUnsafePutByte:
+      case Intrinsics::kJdkUnsafeGetByteAbsolute:
+      case Intrinsics::kJdkUnsafeGetAbsolute:
+      case Intrinsics::kJdkUnsafeGetLongAbsolute:
+      case Intrinsics::kJdkUnsafePutByteAbsolute:
+      case Intrinsics::kJdkUnsafePutAbsolute:
+      case Intrinsics::kJdkUnsafePutLongAbsolute:
         return 0u;
       case Intrinsics::kFP16Ceil:
       case Intrinsics::kFP16Compare:
@@ -26,13 +26,16 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <signal.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/time.h>
 #include <sys/uio.h>
+#include <sys/wait.h>
 #include <time.h>
 #include <unistd.h>
 
+#include <optional>
 #include <set>
 
 #include <android-base/logging.h>
@@ -41,6 +44,7 @@
 #include "art_field-inl.h"
 #include "art_method-inl.h"
 #include "base/array_ref.h"
+#include "base/fast_exit.h"
 #include "base/file_utils.h"
 #include "base/logging.h"
 #include "base/macros.h"
@@ -80,6 +84,13 @@ static constexpr uint32_t kHprofNullThread = 0;
 static constexpr size_t kMaxObjectsPerSegment = 128;
 static constexpr size_t kMaxBytesPerSegment = 4096;
 
+// Records are batched into chunks of this size before a ChunkedFileEndianOutput writes them.
+static constexpr size_t kWriteChunkSize = 1 * MB;
+
+// A heap dump child that has not exited after this long is killed, by its own watchdog timer
+// and by the parent, as in perfetto_hprof.
+static constexpr time_t kChildDumpTimeoutSec = 120;
+
 // The static field-name for the synthetic object generated to account for class static overhead.
 static constexpr const char* kClassOverheadName = "$classOverhead";
 
@@ -408,6 +419,47 @@ class FileEndianOutput final : public EndianOutputBuffered {
   bool errors_;
 };
 
+// Like FileEndianOutput, but batches records into large chunks so that the file is written
+// with a few large writes rather than one write per record. Used by the forked child, which
+// writes synchronously: it cannot safely start threads.
+class ChunkedFileEndianOutput final : public EndianOutputBuffered {
+ public:
+  ChunkedFileEndianOutput(File* fp, size_t reserved_size)
+      : EndianOutputBuffered(reserved_size), fp_(fp), errors_(false) {
+    DCHECK(fp != nullptr);
+    chunk_.reserve(kWriteChunkSize);
+  }
+  ~ChunkedFileEndianOutput() {
+    WriteChunk();
+  }
+
+  // Write out the last chunk. Returns whether there were errors.
+  bool Errors() {
+    WriteChunk();
+    return errors_;
+  }
+
+ protected:
+  void HandleFlush(const uint8_t* buffer, size_t length) override {
+    chunk_.insert(chunk_.end(), buffer, buffer + length);
+    if (chunk_.size() >= kWriteChunkSize) {
+      WriteChunk();
+    }
+  }
+
+ private:
+  void WriteChunk() {
+    if (!errors_ && !chunk_.empty()) {
+      errors_ = !fp_->WriteFully(chunk_.data(), chunk_.size());
+    }
+    chunk_.clear();
+  }
+
+  File* fp_;
+  bool errors_;
+  std::vector<uint8_t> chunk_;
+};
+
 class VectorEndianOuputput final : public EndianOutputBuffered {
  public:
   VectorEndianOuputput(std::vector<uint8_t>& data, size_t reserved_size)
@@ -429,14 +481,16 @@ class VectorEndianOuputput final : public EndianOutputBuffered {
 
 class Hprof : public SingleRootVisitor {
  public:
-  Hprof(const char* output_filename, int fd, bool direct_to_ddms)
+  Hprof(const char* output_filename, int fd, bool direct_to_ddms, bool chunked_writes = false)
       : filename_(output_filename),
         fd_(fd),
-        direct_to_ddms_(direct_to_ddms) {
+        direct_to_ddms_(direct_to_ddms),
+        chunked_writes_(chunked_writes) {
     LOG(INFO) << "hprof: heap dump \"" << filename_ << "\" starting...";
   }
 
-  void Dump()
+  // Returns whether the dump was written successfully.
+  bool Dump()
     REQUIRES(Locks::mutator_lock_)
     REQUIRES(!Locks::heap_bitmap_lock_, !Locks::alloc_tracker_lock_) {
     {
@@ -477,6 +531,7 @@ class Hprof : public SingleRootVisitor {
                 << " objects " << total_objects_
                 << " objects with stack traces " << total_objects_with_stack_trace_;
     }
+    return okay;
   }
 
  private:
@@ -772,18 +827,12 @@ class Hprof : public SingleRootVisitor {
 
     std::unique_ptr<File> file(new File(out_fd, filename_, true));
     bool okay;
-    {
+    if (chunked_writes_) {
+      ChunkedFileEndianOutput file_output(file.get(), max_length);
+      okay = WriteToFileOutput(&file_output, overall_size);
+    } else {
       FileEndianOutput file_output(file.get(), max_length);
-      output_ = &file_output;
-      ProcessHeap(true);
-      okay = !file_output.Errors();
-
-      if (okay) {
-        // Check for expected size. Output is expected to be less-or-equal than first phase, see
-        // b/23521263.
-        DCHECK_LE(file_output.SumLength(), overall_size);
-      }
-      output_ = nullptr;
+      okay = WriteToFileOutput(&file_output, overall_size);
     }
 
     if (okay) {
@@ -802,6 +851,21 @@ class Hprof : public SingleRootVisitor {
     return okay;
   }
 
+  template <typename FileOutput>
+  bool WriteToFileOutput(FileOutput* file_output, size_t overall_size)
+      REQUIRES(Locks::mutator_lock_) {
+    output_ = file_output;
+    ProcessHeap(true);
+    bool okay = !file_output->Errors();
+    if (okay) {
+      // Check for expected size. Output is expected to be less-or-equal than first phase, see
+      // b/23521263.
+      DCHECK_LE(file_output->SumLength(), overall_size);
+    }
+    output_ = nullptr;
+    return okay;
+  }
+
   bool DumpToDdmsDirect(size_t overall_size, size_t max_length, uint32_t chunk_type)
       REQUIRES(Locks::mutator_lock_) {
     CHECK(direct_to_ddms_);
@@ -871,6 +935,8 @@ class Hprof : public SingleRootVisitor {
   std::string filename_;
   int fd_;
   bool direct_to_ddms_;
+  // Whether file output is batched into large writes (see ChunkedFileEndianOutput).
+  bool chunked_writes_;
 
   uint64_t start_ns_ = NanoTime();
 
@@ -1596,6 +1662,88 @@ void Hprof::VisitRoot(mirror::Object* obj, const RootInfo& info) {
   MarkRootObject(obj, nullptr, xlate[info.GetType()], info.GetThreadId());
 }
 
+// Kill this process if it is still running after kChildDumpTimeoutSec. Only called in the
+// child, so failing here does not affect the app.
+static void ArmChildWatchdogOrDie() {
+  timer_t timerid{};
+  struct sigevent sev {};
+  sev.sigev_notify = SIGEV_SIGNAL;
+  sev.sigev_signo = SIGKILL;
+  if (timer_create(CLOCK_MONOTONIC, &sev, &timerid) == -1) {
+    PLOG(FATAL) << "hprof: failed to create watchdog timer";
+  }
+  struct itimerspec its {};
+  its.it_value.tv_sec = kChildDumpTimeoutSec;
+  if (timer_settime(timerid, 0, &its, nullptr) == -1) {
+    PLOG(FATAL) << "hprof: failed to arm watchdog timer";
+  }
+}
+
+// Wait for the child for at most kChildDumpTimeoutSec, polling like perfetto_hprof's
+// BusyWaitpid, and kill it if it has not exited by then. Returns whether it exited cleanly.
+static bool WaitForDumpChild(pid_t pid) {
+  static constexpr uint32_t kPollIntervalMs = 10;
+  static constexpr uint32_t kMaxPolls = kChildDumpTimeoutSec * 1000 / kPollIntervalMs;
+  for (uint32_t i = 0;; ++i) {
+    if (i == kMaxPolls) {
+      // The child's own watchdog should have fired already. Kill it; the next waitpid reaps it.
+      LOG(ERROR) << "hprof: child " << pid << " timed out. Sending SIGKILL.";
+      kill(pid, SIGKILL);
+    }
+    int status;
+    pid_t wait_result = waitpid(pid, &status, WNOHANG);
+    if (wait_result == pid) {
+      return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+    if (wait_result == -1 && errno != EINTR) {
+      PLOG(ERROR) << "hprof: waitpid for child " << pid << " failed";
+      return false;
+    }
+    usleep(kPollIntervalMs * 1000);
+  }
+}
+
+// Dump the heap from a forked child so that the parent only stays suspended for the fork itself.
+// The child gets a copy-on-write snapshot of the suspended heap and is the only thread left, so
+// it can walk the heap and write the file at leisure while the parent resumes.
+static void DumpHeapInChild(const char* filename, int fd) {
+  Thread* self = Thread::Current();
+  pid_t pid;
+  {
+    // As in perfetto_hprof, enter the GC critical section and suspend before forking, so that the
+    // child does not inherit a GC in progress or threads holding runtime locks.
+    std::optional<gc::ScopedGCCriticalSection> gcs(std::in_place,
+                                                   self,
+                                                   gc::kGcCauseHprof,
+                                                   gc::kCollectorTypeHprof);
+    std::optional<ScopedSuspendAll> ssa(std::in_place, __FUNCTION__, /* long_suspend= */ true);
+    pid = fork();
+    if (pid == 0) {
+      // Child. Native threads that were not suspended may have held locks when we forked, so
+      // arm a watchdog in case we block on one, and write the file from this thread only.
+      ArmChildWatchdogOrDie();
+      Hprof hprof(filename, fd, /* direct_to_ddms= */ false, /* chunked_writes= */ true);
+      bool okay = hprof.Dump();
+      // Do not run the parent's atexit handlers.
+      FastExit(okay ? 0 : 1);
+    }
+  }
+  if (pid == -1) {
+    int fork_errno = errno;
+    ScopedObjectAccess soa(self);
+    ThrowRuntimeException("Couldn't dump heap; fork failed: %s", strerror(fork_errno));
+    return;
+  }
+  LOG(INFO) << "hprof: dumping from child " << pid;
+  // The parent has resumed; only this thread waits for the child.
+  if (!WaitForDumpChild(pid)) {
+    ScopedObjectAccess soa(self);
+    ThrowRuntimeException("Couldn't dump heap; writing \"%s\" from child %d failed",
+                          filename,
+                          static_cast<int>(pid));
+  }
+}
+
 // If "direct_to_ddms" is true, the other arguments are ignored, and data is
 // sent directly to DDMS.
 // If "fd" is >= 0, the output will be written to that file descriptor.
@@ -1603,6 +1751,11 @@ void Hprof::VisitRoot(mirror::Object* obj, const RootInfo& info) {
 void DumpHeap(const char* filename, int fd, bool direct_to_ddms) {
   CHECK(filename != nullptr);
   Thread* self = Thread::Current();
+  // DDMS chunks are published by the parent, so only file dumps can be written from a child.
+  if (!direct_to_ddms && Runtime::Current()->IsHprofDumpInChildEnabled()) {
+    DumpHeapInChild(filename, fd);
+    return;
+  }
   // Need to take a heap dump while GC isn't running. See the comment in Heap::VisitObjects().
   // Also we need the critical section to avoid visiting the same object twice. See b/34967844
   gc::ScopedGCCriticalSection gcs(self,
@@ -16,8 +16,11 @@
 
 #include "interpreter.h"
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
 #include <string_view>
+#include <vector>
 
 #include "common_dex_operations.h"
 #include "common_throws.h"
@@ -613,6 +616,40 @@ void CheckInterpreterAsmConstants() {
   CheckNterpAsmConstants();
 }
 
+static std::atomic<uint64_t>* GetOpcodePairCounts() {
+  DCHECK(kCountOpcodePairsEnabled);
+  // Allocated on first use, so that we do not reserve the space unless counting.
+  static std::atomic<uint64_t>* counts =
+      new std::atomic<uint64_t>[kNumPackedOpcodes * kNumPackedOpcodes]();
+  return counts;
+}
+
+void CountOpcodePair(Instruction::Code previous, Instruction::Code current) {
+  size_t index = static_cast<size_t>(previous) * kNumPackedOpcodes + static_cast<size_t>(current);
+  GetOpcodePairCounts()[index].fetch_add(1u, std::memory_order_relaxed);
+}
+
+void DumpOpcodePairCounts(std::ostream& os) {
+  static constexpr size_t kNumPairsToDump = 32u;
+  std::atomic<uint64_t>* counts = GetOpcodePairCounts();
+  std::vector<std::pair<uint64_t, size_t>> pairs;
+  for (size_t i = 0; i != kNumPackedOpcodes * kNumPackedOpcodes; ++i) {
+    uint64_t count = counts[i].load(std::memory_order_relaxed);
+    if (count != 0u) {
+      pairs.emplace_back(count, i);
+    }
+  }
+  size_t num_pairs = std::min(pairs.size(), kNumPairsToDump);
+  std::partial_sort(pairs.begin(), pairs.begin() + num_pairs, pairs.end(), std::greater<>());
+  os << "Most frequent opcode pairs in the interpreter:\n";
+  for (size_t i = 0; i != num_pairs; ++i) {
+    size_t index = pairs[i].second;
+    os << "  " << Instruction::Name(static_cast<Instruction::Code>(index / kNumPackedOpcodes))
+       << " " << Instruction::Name(static_cast<Instruction::Code>(index % kNumPackedOpcodes))
+       << ": " << pairs[i].first << "\n";
+  }
+}
+
 bool PrevFrameWillRetry(Thread* self, const ShadowFrame& frame) {
   ShadowFrame* prev_frame = frame.GetLink();
   if (prev_frame == nullptr) {
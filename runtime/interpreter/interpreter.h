@@ -17,9 +17,12 @@
 #ifndef ART_RUNTIME_INTERPRETER_INTERPRETER_H_
 #define ART_RUNTIME_INTERPRETER_INTERPRETER_H_
 
+#include <iosfwd>
+
 #include "base/locks.h"
 #include "base/macros.h"
 #include "dex/dex_file.h"
+#include "dex/dex_instruction.h"
 #include "obj_ptr.h"
 
 namespace art HIDDEN {
@@ -74,6 +77,14 @@ void CheckInterpreterAsmConstants();
 bool PrevFrameWillRetry(Thread* self, const ShadowFrame& frame)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
+// Set true to count the pairs of consecutive opcodes executed by the switch interpreter,
+// for example to find which pairs are worth fusing in nterp. The most frequent pairs
+// are printed on SIGQUIT.
+constexpr bool kCountOpcodePairsEnabled = false;
+
+void CountOpcodePair(Instruction::Code previous, Instruction::Code current);
+void DumpOpcodePairCounts(std::ostream& os);
+
 }  // namespace interpreter
 
 }  // namespace art
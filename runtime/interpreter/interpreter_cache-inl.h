@@ -27,9 +27,35 @@ inline bool InterpreterCache::Get(Thread* self, const void* key, /* out */ size_
   DCHECK(self->GetInterpreterCache() == this) << "Must be called from owning thread";
   Entry& entry = data_[IndexOf(key)];
   if (LIKELY(entry.first == key)) {
+    if (kCountLookups) {
+      ++first_way_hits_;
+    }
     *value = entry.second;
     return true;
   }
+  return GetFromOtherWays(self, key, value);
+}
+
+inline bool InterpreterCache::GetFromOtherWays(Thread* self,
+                                               const void* key,
+                                               /* out */ size_t* value) {
+  DCHECK(self->GetInterpreterCache() == this) << "Must be called from owning thread";
+  size_t index = IndexOf(key);
+  for (size_t way = 1u; way != kWays; ++way) {
+    Entry& entry = OtherWay(index, way);
+    if (entry.first == key) {
+      if (kCountLookups) {
+        ++other_way_hits_;
+      }
+      // Swap with the first way, so that nterp finds the entry inline next time.
+      std::swap(entry, data_[index]);
+      *value = data_[index].second;
+      return true;
+    }
+  }
+  if (kCountLookups) {
+    ++misses_;
+  }
   return false;
 }
 
@@ -37,7 +63,15 @@ inline void InterpreterCache::Set(Thread* self, const void* key, size_t value) {
   DCHECK(self->GetInterpreterCache() == this) << "Must be called from owning thread";
   // Simple store works here as the cache is always read/written by the owning
   // thread only (or in a stop-the-world pause).
-  data_[IndexOf(key)] = Entry{key, value};
+  size_t index = IndexOf(key);
+  Entry& first = data_[index];
+  if (kWays != 1u && first.first != nullptr && first.first != key) {
+    // Demote the entry of the first way, replacing the other ways in round-robin order.
+    uint8_t victim = next_victims_[index];
+    OtherWay(index, 1u + victim) = first;
+    next_victims_[index] = (victim + 1u == kWays - 1u) ? 0u : victim + 1u;
+  }
+  first = Entry{key, value};
 }
 
 }  // namespace art
@@ -29,6 +29,19 @@ void InterpreterCache::Clear(Thread* owning_thread) {
         reinterpret_cast<std::atomic<const void*>*>(&entry.first);
     atomic_key_addr->store(nullptr, std::memory_order_relaxed);
   }
+  for (Entry& entry : other_ways_) {
+    std::atomic<const void*>* atomic_key_addr =
+        reinterpret_cast<std::atomic<const void*>*>(&entry.first);
+    atomic_key_addr->store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+void InterpreterCache::DumpStats(std::ostream& os) const {
+  size_t lookups = first_way_hits_ + other_way_hits_ + misses_;
+  os << "Interpreter cache: " << lookups << " lookups, "
+     << first_way_hits_ << " first way hits, "
+     << other_way_hits_ << " other way hits, "
+     << misses_ << " misses\n";
 }
 
 }  // namespace art
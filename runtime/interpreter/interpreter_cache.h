@@ -19,6 +19,7 @@
 
 #include <array>
 #include <atomic>
+#include <ostream>
 
 #include "base/bit_utils.h"
 #include "base/macros.h"
@@ -39,6 +40,12 @@ class Thread;
 //   sget/sput: The ArtField* pointer. The field must be non-volitile.
 //   invoke: The ArtMethod* pointer (before vtable indirection, etc).
 //
+// The cache is set-associative. The first way of each set is the most recently
+// used entry, which is the only one nterp looks up inline. The other ways hold
+// entries evicted from the first way and are searched by the nterp slow paths
+// before resolving again, so that large methods whose instructions collide in
+// the first way do not keep going through resolution.
+//
 // We ensure consistency of the cache by clearing it
 // whenever any dex file is unloaded.
 //
@@ -51,12 +58,22 @@ class ALIGNED(16) InterpreterCache {
 
   // 2x size increase/decrease corresponds to ~0.5% interpreter performance change.
   // Value of 256 has around 75% cache hit rate.
+  // Note that the nterp assembly also depends on the size.
   static constexpr size_t kSize = 256;
 
+  // The number of entries in each set, including the first way probed by nterp.
+  static constexpr size_t kWays = 2;
+  static_assert(kWays >= 1u && kWays <= 256u, "Unsupported number of ways");
+
+  // Whether to count lookups, for measuring the hit rate of the cache.
+  static constexpr bool kCountLookups = false;
+
   InterpreterCache() {
     // We can not use the Clear() method since the constructor will not
     // be called from the owning thread.
     data_.fill(Entry{});
+    other_ways_.fill(Entry{});
+    next_victims_.fill(0u);
   }
 
   // Clear the whole cache. It requires the owning thread for DCHECKs.
@@ -64,12 +81,25 @@ class ALIGNED(16) InterpreterCache {
 
   ALWAYS_INLINE bool Get(Thread* self, const void* key, /* out */ size_t* value);
 
+  // Look up `key` only in the ways that nterp does not probe inline. On a hit,
+  // the entry is moved to the first way.
+  ALWAYS_INLINE bool GetFromOtherWays(Thread* self, const void* key, /* out */ size_t* value);
+
   ALWAYS_INLINE void Set(Thread* self, const void* key, size_t value);
 
-  std::array<Entry, kSize>& GetArray() {
-    return data_;
+  // Visit all entries, for example to sweep them.
+  template <typename Visitor>
+  void VisitEntries(Visitor&& visitor) {
+    for (Entry& entry : data_) {
+      visitor(entry);
+    }
+    for (Entry& entry : other_ways_) {
+      visitor(entry);
+    }
   }
 
+  void DumpStats(std::ostream& os) const;
+
  private:
   static ALWAYS_INLINE size_t IndexOf(const void* key) {
     static_assert(IsPowerOfTwo(kSize), "Size must be power of two");
@@ -78,7 +108,24 @@ class ALIGNED(16) InterpreterCache {
     return index;
   }
 
+  // Returns the entry of `way` in the set at `index`, for ways other than the first.
+  Entry& OtherWay(size_t index, size_t way) {
+    DCHECK_GE(way, 1u);
+    DCHECK_LT(way, kWays);
+    return other_ways_[index * (kWays - 1u) + (way - 1u)];
+  }
+
+  // The first way of each set. This must be the first field, nterp accesses it directly.
   std::array<Entry, kSize> data_;
+  std::array<Entry, kSize * (kWays - 1u)> other_ways_;
+  // For each set, the next way to evict an entry from, in round-robin order.
+  std::array<uint8_t, kSize> next_victims_;
+
+  // Lookup counters, only updated with `kCountLookups`. Hits in the first way
+  // done by nterp assembly are not counted.
+  size_t first_way_hits_ = 0u;
+  size_t other_way_hits_ = 0u;
+  size_t misses_ = 0u;
 };
 
 }  // namespace art
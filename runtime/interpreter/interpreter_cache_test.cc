@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "interpreter_cache-inl.h"
+
+#include "common_runtime_test.h"
+#include "thread-current-inl.h"
+
+namespace art HIDDEN {
+
+class InterpreterCacheTest : public CommonRuntimeTest {
+ protected:
+  // Keys 1KiB apart map to the same set.
+  static const void* Key(size_t i) {
+    return reinterpret_cast<const void*>(0x10000u + i * 1024u);
+  }
+};
+
+TEST_F(InterpreterCacheTest, CollidingEntries) {
+  static_assert(InterpreterCache::kWays == 2u, "Test assumes two ways");
+  Thread* self = Thread::Current();
+  InterpreterCache* cache = self->GetInterpreterCache();
+  cache->Clear(self);
+
+  size_t value = 0u;
+  EXPECT_FALSE(cache->Get(self, Key(0), &value));
+  cache->Set(self, Key(0), 10u);
+  cache->Set(self, Key(1), 11u);
+  // The first entry was demoted to the second way rather than evicted.
+  EXPECT_TRUE(cache->Get(self, Key(1), &value));
+  EXPECT_EQ(value, 11u);
+  EXPECT_TRUE(cache->GetFromOtherWays(self, Key(0), &value));
+  EXPECT_EQ(value, 10u);
+  // The hit swapped `Key(0)` back into the first way, so it is `Key(1)` that is evicted now.
+  cache->Set(self, Key(2), 12u);
+  EXPECT_TRUE(cache->Get(self, Key(2), &value));
+  EXPECT_EQ(value, 12u);
+  EXPECT_TRUE(cache->Get(self, Key(0), &value));
+  EXPECT_EQ(value, 10u);
+  EXPECT_FALSE(cache->Get(self, Key(1), &value));
+
+  // Updating the entry in the first way does not demote it.
+  cache->Set(self, Key(0), 20u);
+  EXPECT_TRUE(cache->GetFromOtherWays(self, Key(2), &value));
+  EXPECT_EQ(value, 12u);
+  EXPECT_TRUE(cache->GetFromOtherWays(self, Key(0), &value));
+  EXPECT_EQ(value, 20u);
+
+  cache->Clear(self);
+  EXPECT_FALSE(cache->Get(self, Key(0), &value));
+  EXPECT_FALSE(cache->Get(self, Key(2), &value));
+}
+
+}  // namespace art
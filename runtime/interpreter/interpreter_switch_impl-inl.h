@@ -429,7 +429,7 @@ class InstructionHandler {
       // Hotness update.
       jit::Jit* jit = Runtime::Current()->GetJit();
       if (jit != nullptr) {
-        jit->AddSamples(Self(), shadow_frame_.GetMethod());
+        jit->AddSamples(Self(), shadow_frame_.GetMethod(), /* from_loop= */ true);
       }
       // Record new dex pc early to have consistent suspend point at loop header.
       shadow_frame_.SetDexPC(next_->GetDexPc(Insns()));
@@ -2036,11 +2036,18 @@ void ExecuteSwitchImplCpp(SwitchImplContext* ctx) {
       << "Entered interpreter from invoke without retry instruction being handled!";
 
   bool const interpret_one_instruction = ctx->interpret_one_instruction;
+  const Instruction* previous = nullptr;
   while (true) {
     const Instruction* const inst = next;
     dex_pc = inst->GetDexPc(insns);
     shadow_frame.SetDexPC(dex_pc);
     TraceExecution(shadow_frame, inst, dex_pc);
+    if (kCountOpcodePairsEnabled) {
+      if (previous != nullptr) {
+        CountOpcodePair(previous->Opcode(), inst->Opcode());
+      }
+      previous = inst;
+    }
     uint16_t inst_data = inst->Fetch16(0);
     bool exit = false;
     bool success;  // Moved outside to keep frames small under asan.
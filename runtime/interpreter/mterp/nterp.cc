@@ -131,6 +131,12 @@ inline void UpdateCache(Thread* self, const uint16_t* dex_pc_ptr, T* value) {
   UpdateCache(self, dex_pc_ptr, reinterpret_cast<size_t>(value));
 }
 
+// Nterp only looks up the first way of the thread-local cache inline. Before resolving
+// again, look for the entry in the other ways, where it may have been evicted to.
+inline bool GetFromCache(Thread* self, const uint16_t* dex_pc_ptr, /* out */ size_t* value) {
+  return self->GetInterpreterCache()->GetFromOtherWays(self, dex_pc_ptr, value);
+}
+
 #ifdef __arm__
 
 extern "C" void NterpStoreArm32Fprs(const char* shorty,
@@ -316,6 +322,10 @@ LIBART_PROTECTED FLATTEN
 extern "C" size_t NterpGetMethod(Thread* self, ArtMethod* caller, const uint16_t* dex_pc_ptr)
     REQUIRES_SHARED(Locks::mutator_lock_) {
   UpdateHotness(caller);
+  size_t cached_value;
+  if (GetFromCache(self, dex_pc_ptr, &cached_value)) {
+    return cached_value;
+  }
   const Instruction* inst = Instruction::At(dex_pc_ptr);
   Instruction::Code opcode = inst->Opcode();
   DCHECK(IsUint<8>(static_cast<std::underlying_type_t<Instruction::Code>>(opcode)));
@@ -349,6 +359,13 @@ extern "C" size_t NterpGetMethod(Thread* self, ArtMethod* caller, const uint16_t
     }
   }
 
+  // Note that nterp does not keep a per call site cache keyed on the receiver class. The
+  // thread-local cache only holds what is independent of the receiver: the vtable index
+  // for virtual calls, and the interface method for interface calls, which then goes
+  // through the IMT. An IMT conflict is resolved by the conflict trampoline, whose
+  // per-class `ImtConflictTable` already acts as a polymorphic cache. A receiver class
+  // cache would save at most a couple of dependent loads, and its entries would need to
+  // be swept on class unloading like the other entries of `InterpreterCache`.
   if (invoke_type == kInterface) {
     size_t result = 0u;
     if (resolved_method->GetDeclaringClass()->IsObjectClass()) {
@@ -392,6 +409,10 @@ extern "C" size_t NterpGetStaticField(Thread* self,
                                       size_t resolve_field_type)  // Resolve if not zero
     REQUIRES_SHARED(Locks::mutator_lock_) {
   UpdateHotness(caller);
+  size_t cached_field;
+  if (GetFromCache(self, dex_pc_ptr, &cached_field)) {
+    return cached_field;
+  }
   const Instruction* inst = Instruction::At(dex_pc_ptr);
   uint16_t field_index = inst->VRegB_21c();
   ClassLinker* const class_linker = Runtime::Current()->GetClassLinker();
@@ -448,6 +469,10 @@ extern "C" uint32_t NterpGetInstanceFieldOffset(Thread* self,
                                                 size_t resolve_field_type)  // Resolve if not zero
     REQUIRES_SHARED(Locks::mutator_lock_) {
   UpdateHotness(caller);
+  size_t cached_offset;
+  if (GetFromCache(self, dex_pc_ptr, &cached_offset)) {
+    return dchecked_integral_cast<uint32_t>(cached_offset);
+  }
   const Instruction* inst = Instruction::At(dex_pc_ptr);
   uint16_t field_index = inst->VRegC_22c();
   ClassLinker* const class_linker = Runtime::Current()->GetClassLinker();
@@ -487,6 +512,10 @@ extern "C" uint32_t NterpGetInstanceFieldOffset(Thread* self,
 extern "C" mirror::Object* NterpGetClass(Thread* self, ArtMethod* caller, uint16_t* dex_pc_ptr)
     REQUIRES_SHARED(Locks::mutator_lock_) {
   UpdateHotness(caller);
+  size_t cached_class;
+  if (GetFromCache(self, dex_pc_ptr, &cached_class)) {
+    return reinterpret_cast<mirror::Class*>(cached_class);
+  }
   const Instruction* inst = Instruction::At(dex_pc_ptr);
   Instruction::Code opcode = inst->Opcode();
   DCHECK(opcode == Instruction::CHECK_CAST ||
@@ -521,6 +550,13 @@ extern "C" mirror::Object* NterpAllocateObject(Thread* self,
                                                uint16_t* dex_pc_ptr)
     REQUIRES_SHARED(Locks::mutator_lock_) {
   UpdateHotness(caller);
+  gc::AllocatorType allocator_type = Runtime::Current()->GetHeap()->GetCurrentAllocator();
+  size_t cached_class;
+  if (GetFromCache(self, dex_pc_ptr, &cached_class)) {
+    return AllocObjectFromCode(reinterpret_cast<mirror::Class*>(cached_class),
+                               self,
+                               allocator_type).Ptr();
+  }
   const Instruction* inst = Instruction::At(dex_pc_ptr);
   DCHECK_EQ(inst->Opcode(), Instruction::NEW_INSTANCE);
   dex::TypeIndex index = dex::TypeIndex(inst->VRegB_21c());
@@ -535,7 +571,6 @@ extern "C" mirror::Object* NterpAllocateObject(Thread* self,
     return nullptr;
   }
 
-  gc::AllocatorType allocator_type = Runtime::Current()->GetHeap()->GetCurrentAllocator();
   if (UNLIKELY(c->IsStringClass())) {
     // We don't cache the class for strings as we need to special case their
     // allocation.
@@ -557,6 +592,10 @@ extern "C" mirror::Object* NterpLoadObject(Thread* self, ArtMethod* caller, uint
     case Instruction::CONST_STRING:
     case Instruction::CONST_STRING_JUMBO: {
       UpdateHotness(caller);
+      size_t cached_string;
+      if (GetFromCache(self, dex_pc_ptr, &cached_string)) {
+        return reinterpret_cast<mirror::String*>(cached_string);
+      }
       dex::StringIndex string_index(
           (inst->Opcode() == Instruction::CONST_STRING)
               ? inst->VRegB_21c()
@@ -711,7 +750,7 @@ extern "C" jit::OsrData* NterpHotMethod(ArtMethod* method, uint16_t* dex_pc_ptr,
         return osr_data;
       }
     }
-    jit->MaybeEnqueueCompilation(method, Thread::Current());
+    jit->MaybeEnqueueCompilation(method, Thread::Current(), /* from_loop= */ dex_pc_ptr != nullptr);
   }
   return nullptr;
 }
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "allocation_site_table.h"
+
+#include <algorithm>
+#include <ostream>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "android-base/stringprintf.h"
+#include "art_method-inl.h"
+#include "base/bit_utils.h"
+#include "base/utils.h"
+#include "stack.h"
+#include "thread-current-inl.h"
+
+namespace art HIDDEN {
+
+using android::base::StringPrintf;
+
+static_assert(IsPowerOfTwo(AllocationSiteTable::kCapacity));
+
+AllocationSiteTable::AllocationSiteTable()
+    : slots_(new Atomic<Site*>[kCapacity]()),
+      num_sites_(0),
+      sampled_bytes_(0),
+      sampled_objects_(0),
+      dropped_samples_(0),
+      epoch_(0) {}
+
+AllocationSiteTable::~AllocationSiteTable() {
+  for (size_t i = 0; i < kCapacity; ++i) {
+    delete slots_[i].load(std::memory_order_relaxed);
+  }
+}
+
+void AllocationSiteTable::RecordSample(Thread* self, size_t byte_count) {
+  gc::AllocRecordStackTrace trace;
+  // The walk does not suspend, so the freshly allocated object cannot move under us. Leave the
+  // tid at zero so that identical sites on different threads are deduplicated.
+  StackVisitor::WalkStack(
+      [&](const art::StackVisitor* stack_visitor) REQUIRES_SHARED(Locks::mutator_lock_) {
+        if (trace.GetDepth() >= kStackDepth) {
+          return false;
+        }
+        ArtMethod* m = stack_visitor->GetMethod();
+        if (m != nullptr && !m->IsRuntimeMethod()) {
+          m = m->GetInterfaceMethodIfProxy(kRuntimePointerSize);
+          trace.AddStackElement(gc::AllocRecordStackTraceElement(m, stack_visitor->GetDexPc()));
+        }
+        return true;
+      },
+      self,
+      /* context= */ nullptr,
+      art::StackVisitor::StackWalkKind::kIncludeInlinedFrames);
+
+  // Read the epoch after the walk. A method on our stack that reuses the memory of an unloaded
+  // one was allocated after OnMethodsUnloaded(), so we see the new epoch and cannot match a
+  // site interned for the unloaded method.
+  uint32_t epoch = epoch_.load(std::memory_order_acquire);
+  sampled_bytes_.fetch_add(byte_count, std::memory_order_relaxed);
+  sampled_objects_.fetch_add(1u, std::memory_order_relaxed);
+  size_t hash = gc::HashAllocRecordTypes()(trace);
+  Site* site = FindOrInsert(std::move(trace), hash, epoch);
+  if (site == nullptr) {
+    dropped_samples_.fetch_add(1u, std::memory_order_relaxed);
+    return;
+  }
+  site->bytes.fetch_add(byte_count, std::memory_order_relaxed);
+  site->objects.fetch_add(1u, std::memory_order_relaxed);
+}
+
+AllocationSiteTable::Site* AllocationSiteTable::FindOrInsert(gc::AllocRecordStackTrace&& trace,
+                                                             size_t hash,
+                                                             uint32_t epoch) {
+  std::unique_ptr<Site> new_site;
+  for (size_t probe = 0; probe < kCapacity; ++probe) {
+    Atomic<Site*>& slot = slots_[(hash + probe) & (kCapacity - 1)];
+    Site* site = slot.load(std::memory_order_acquire);
+    while (site == nullptr) {
+      if (new_site == nullptr) {
+        // Only format the frames for sites we have not seen before.
+        std::string description;
+        for (size_t i = 0, depth = trace.GetDepth(); i < depth; ++i) {
+          const gc::AllocRecordStackTraceElement& element = trace.GetStackElement(i);
+          description += StringPrintf("    at %s (line %d)\n",
+                                      element.GetMethod()->PrettyMethod().c_str(),
+                                      element.ComputeLineNumber());
+        }
+        if (description.empty()) {
+          description = "    (no managed frames)\n";
+        }
+        new_site.reset(new Site(hash, epoch, std::move(trace), std::move(description)));
+      }
+      if (slot.CompareAndSetStrongRelease(nullptr, new_site.get())) {
+        num_sites_.fetch_add(1u, std::memory_order_relaxed);
+        return new_site.release();
+      }
+      // Lost the race, look at whoever won.
+      site = slot.load(std::memory_order_acquire);
+    }
+    const gc::AllocRecordStackTrace& key = (new_site != nullptr) ? new_site->trace : trace;
+    if (site->hash == hash && site->epoch == epoch && site->trace == key) {
+      return site;
+    }
+  }
+  return nullptr;
+}
+
+void AllocationSiteTable::Reset() {
+  for (size_t i = 0; i < kCapacity; ++i) {
+    Site* site = slots_[i].load(std::memory_order_acquire);
+    if (site != nullptr) {
+      site->bytes.store(0u, std::memory_order_relaxed);
+      site->objects.store(0u, std::memory_order_relaxed);
+    }
+  }
+  sampled_bytes_.store(0u, std::memory_order_relaxed);
+  sampled_objects_.store(0u, std::memory_order_relaxed);
+  dropped_samples_.store(0u, std::memory_order_relaxed);
+}
+
+void AllocationSiteTable::Dump(std::ostream& os) const {
+  // Bytes and samples per distinct description, merging the sites of different epochs.
+  struct DumpedSite {
+    uint64_t bytes;
+    uint64_t objects;
+    std::string_view description;
+  };
+  std::vector<DumpedSite> sites;
+  std::unordered_map<std::string_view, size_t> site_indexes;
+  sites.reserve(GetNumSites());
+  for (size_t i = 0; i < kCapacity; ++i) {
+    const Site* site = slots_[i].load(std::memory_order_acquire);
+    if (site != nullptr) {
+      uint64_t bytes = site->bytes.load(std::memory_order_relaxed);
+      if (bytes != 0u) {
+        uint64_t objects = site->objects.load(std::memory_order_relaxed);
+        auto [it, inserted] = site_indexes.emplace(site->description, sites.size());
+        if (inserted) {
+          sites.push_back({bytes, objects, site->description});
+        } else {
+          sites[it->second].bytes += bytes;
+          sites[it->second].objects += objects;
+        }
+      }
+    }
+  }
+  size_t num_dumped = std::min(sites.size(), kMaxDumpedSites);
+  std::partial_sort(sites.begin(),
+                    sites.begin() + num_dumped,
+                    sites.end(),
+                    [](const auto& a, const auto& b) { return a.bytes > b.bytes; });
+  uint64_t total_bytes = GetSampledBytes();
+  os << "Sampled allocation sites: " << GetNumSites() << " sites, "
+     << GetSampledObjects() << " samples, " << PrettySize(total_bytes) << " sampled";
+  uint64_t dropped = dropped_samples_.load(std::memory_order_relaxed);
+  if (dropped != 0u) {
+    os << ", " << dropped << " samples dropped (table full)";
+  }
+  os << "\n";
+  for (size_t i = 0; i < num_dumped; ++i) {
+    uint64_t bytes = sites[i].bytes;
+    os << "  " << PrettySize(bytes)
+       << StringPrintf(" (%.1f%%) in ", total_bytes != 0u ? 100.0 * bytes / total_bytes : 0.0)
+       << sites[i].objects << " samples\n"
+       << sites[i].description;
+  }
+}
+
+}  // namespace art
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_JAVAHEAPPROF_ALLOCATION_SITE_TABLE_H_
+#define ART_RUNTIME_JAVAHEAPPROF_ALLOCATION_SITE_TABLE_H_
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+#include "base/atomic.h"
+#include "base/locks.h"
+#include "base/macros.h"
+#include "gc/allocation_record.h"
+
+namespace art HIDDEN {
+
+class Thread;
+
+// Aggregates sampled allocations by allocation site. Each sample walks a bounded number of
+// managed frames and the resulting stack trace is interned in a fixed-size, open-addressed hash
+// table. Lookups and insertions are lock-free: slots are only ever published with a CAS and
+// entries are never freed while the table is alive, so concurrent readers (e.g. a SIGQUIT dump)
+// can walk the table without synchronizing with allocating threads.
+//
+// Sites are keyed by ArtMethod pointers, which may be reused for other methods once class
+// loaders are unloaded. OnMethodsUnloaded() therefore starts a new epoch: sites interned
+// earlier keep their counters and are still dumped, but no longer match new samples.
+class AllocationSiteTable {
+ public:
+  // Number of managed frames recorded per sample. Kept well below kDefaultAllocStackDepth to
+  // keep the per-sample stack walk cheap.
+  static constexpr size_t kStackDepth = 8;
+  // Number of distinct allocation sites that can be tracked. Must be a power of two.
+  static constexpr size_t kCapacity = 4096;
+  // Number of sites printed by Dump().
+  static constexpr size_t kMaxDumpedSites = 20;
+
+  AllocationSiteTable();
+  ~AllocationSiteTable();
+
+  // Attribute `byte_count` bytes to the allocation site of the caller's managed stack.
+  void RecordSample(Thread* self, size_t byte_count) REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Zero the counters of every site. Interned traces are kept.
+  void Reset();
+
+  // Called before the methods of unloaded class loaders are freed. Samples recorded after this
+  // are attributed to new sites, even if their stack trace matches an earlier site.
+  void OnMethodsUnloaded() {
+    epoch_.fetch_add(1u, std::memory_order_release);
+  }
+
+  // Print the heaviest allocation sites ordered by sampled bytes. Sites of different epochs
+  // with the same frames are printed once.
+  void Dump(std::ostream& os) const;
+
+  size_t GetNumSites() const {
+    return num_sites_.load(std::memory_order_relaxed);
+  }
+
+  uint64_t GetSampledBytes() const {
+    return sampled_bytes_.load(std::memory_order_relaxed);
+  }
+
+  uint64_t GetSampledObjects() const {
+    return sampled_objects_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Site {
+    Site(size_t h, uint32_t e, gc::AllocRecordStackTrace&& t, std::string&& d)
+        : hash(h), epoch(e), trace(std::move(t)), description(std::move(d)) {}
+
+    const size_t hash;
+    // The value of `epoch_` when the site was interned. Only sites of the current epoch match.
+    const uint32_t epoch;
+    const gc::AllocRecordStackTrace trace;
+    // Pretty printed frames, computed once when the site is interned so that dumping does not
+    // need the mutator lock and does not touch methods of classes that have since been unloaded.
+    const std::string description;
+    Atomic<uint64_t> bytes{0};
+    Atomic<uint64_t> objects{0};
+  };
+
+  // Return the interned site for `trace`, inserting it if needed. Returns null if the table is
+  // full.
+  Site* FindOrInsert(gc::AllocRecordStackTrace&& trace, size_t hash, uint32_t epoch)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  std::unique_ptr<Atomic<Site*>[]> slots_;
+  Atomic<size_t> num_sites_;
+  Atomic<uint64_t> sampled_bytes_;
+  Atomic<uint64_t> sampled_objects_;
+  // Samples that could not be attributed because the table was full.
+  Atomic<uint64_t> dropped_samples_;
+  // Incremented when classes are unloaded, see OnMethodsUnloaded().
+  Atomic<uint32_t> epoch_;
+
+  DISALLOW_COPY_AND_ASSIGN(AllocationSiteTable);
+};
+
+}  // namespace art
+
+#endif  // ART_RUNTIME_JAVAHEAPPROF_ALLOCATION_SITE_TABLE_H_
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "allocation_site_table.h"
+
+#include <sstream>
+
+#include "common_runtime_test.h"
+#include "scoped_thread_state_change-inl.h"
+
+namespace art HIDDEN {
+
+class AllocationSiteTableTest : public CommonRuntimeTest {
+ protected:
+  AllocationSiteTableTest() {
+    use_boot_image_ = true;  // Make the Runtime creation cheaper.
+  }
+};
+
+TEST_F(AllocationSiteTableTest, DeduplicatesSites) {
+  Thread* self = Thread::Current();
+  ScopedObjectAccess soa(self);
+  AllocationSiteTable table;
+  // Both samples come from the same (empty) managed stack and must share a site.
+  table.RecordSample(self, 16);
+  table.RecordSample(self, 48);
+  EXPECT_EQ(table.GetNumSites(), 1u);
+  EXPECT_EQ(table.GetSampledObjects(), 2u);
+  EXPECT_EQ(table.GetSampledBytes(), 64u);
+
+  std::ostringstream oss;
+  table.Dump(oss);
+  EXPECT_NE(oss.str().find("1 sites, 2 samples"), std::string::npos) << oss.str();
+
+  table.Reset();
+  EXPECT_EQ(table.GetNumSites(), 1u);
+  EXPECT_EQ(table.GetSampledObjects(), 0u);
+  EXPECT_EQ(table.GetSampledBytes(), 0u);
+}
+
+TEST_F(AllocationSiteTableTest, UnloadingStartsNewSites) {
+  Thread* self = Thread::Current();
+  ScopedObjectAccess soa(self);
+  AllocationSiteTable table;
+  table.RecordSample(self, 16);
+  // The interned site must not be matched again, its methods may have been freed.
+  table.OnMethodsUnloaded();
+  table.RecordSample(self, 48);
+  EXPECT_EQ(table.GetNumSites(), 2u);
+  table.RecordSample(self, 64);
+  EXPECT_EQ(table.GetNumSites(), 2u);
+
+  // Both sites have the same frames and are printed once.
+  std::ostringstream oss;
+  table.Dump(oss);
+  EXPECT_NE(oss.str().find("in 3 samples"), std::string::npos) << oss.str();
+}
+
+}  // namespace art
@@ -22,6 +22,7 @@
 #include "perfetto/heap_profile.h"
 #endif
 #include "runtime.h"
+#include "thread-current-inl.h"
 
 namespace art HIDDEN {
 
@@ -66,8 +67,69 @@ void HeapSampler::ReportSample(art::mirror::Object* obj, size_t allocation_size)
   uint64_t perf_alloc_id = reinterpret_cast<uint64_t>(obj);
   VLOG(heap) << "JHP:***Report Perfetto Allocation: obj: " << perf_alloc_id;
 #ifdef ART_TARGET_ANDROID
-  AHeapProfile_reportSample(perfetto_heap_id_, perf_alloc_id, allocation_size);
+  // The sampler may be enabled for allocation site profiling alone, without Perfetto.
+  if (perfetto_heap_id_ != 0 &&
+      profiler_enabled_.load(std::memory_order_acquire) &&
+      KeepSample(profiler_sampling_interval_.load(std::memory_order_acquire))) {
+    AHeapProfile_reportSample(perfetto_heap_id_, perf_alloc_id, allocation_size);
+  }
 #endif
+  // Native allocations registered through VMRuntime are reported with a null object and may come
+  // from threads that do not hold the mutator lock; only walk the stack for managed allocations.
+  AllocationSiteTable* site_table = site_table_.load(std::memory_order_acquire);
+  if (site_table != nullptr &&
+      obj != nullptr &&
+      KeepSample(site_sampling_interval_.load(std::memory_order_acquire))) {
+    art::Thread* self = art::Thread::Current();
+    art::Locks::mutator_lock_->AssertSharedHeld(self);
+    site_table->RecordSample(self, allocation_size);
+  }
+}
+
+bool HeapSampler::KeepSample(int wanted_interval) {
+  int interval = GetSamplingInterval();
+  if (wanted_interval <= interval) {
+    return true;
+  }
+  art::MutexLock mu(art::Thread::Current(), geo_dist_rng_lock_);
+  return std::uniform_int_distribution<int>(0, wanted_interval - 1)(rng_) < interval;
+}
+
+void HeapSampler::EnableHeapSampler() {
+  art::MutexLock mu(art::Thread::Current(), geo_dist_rng_lock_);
+  profiler_enabled_.store(true, std::memory_order_release);
+  UpdateSamplingIntervalLocked();
+}
+
+void HeapSampler::DisableHeapSampler() {
+  art::MutexLock mu(art::Thread::Current(), geo_dist_rng_lock_);
+  profiler_enabled_.store(false, std::memory_order_release);
+  UpdateSamplingIntervalLocked();
+}
+
+void HeapSampler::EnableAllocationSiteProfiling(int sampling_interval) {
+  DCHECK_GT(sampling_interval, 0);
+  art::MutexLock mu(art::Thread::Current(), geo_dist_rng_lock_);
+  if (owned_site_table_ == nullptr) {
+    owned_site_table_.reset(new AllocationSiteTable());
+    site_table_.store(owned_site_table_.get(), std::memory_order_release);
+  }
+  site_sampling_interval_.store(sampling_interval, std::memory_order_release);
+  UpdateSamplingIntervalLocked();
+}
+
+void HeapSampler::OnClassLoadersUnloaded() {
+  AllocationSiteTable* site_table = site_table_.load(std::memory_order_acquire);
+  if (site_table != nullptr) {
+    site_table->OnMethodsUnloaded();
+  }
+}
+
+void HeapSampler::DumpAllocationSites(std::ostream& os) const {
+  AllocationSiteTable* site_table = site_table_.load(std::memory_order_acquire);
+  if (site_table != nullptr) {
+    site_table->Dump(os);
+  }
 }
 
 // Check whether we should take a sample or not at this allocation and calculate the sample
@@ -138,8 +200,21 @@ int HeapSampler::GetSamplingInterval() {
 void HeapSampler::SetSamplingInterval(int sampling_interval) {
   // Make sure that rng_ and geo_dist are thread safe by acquiring a lock to access.
   art::MutexLock mu(art::Thread::Current(), geo_dist_rng_lock_);
-  p_sampling_interval_.store(sampling_interval, std::memory_order_release);
+  profiler_sampling_interval_.store(sampling_interval, std::memory_order_release);
+  UpdateSamplingIntervalLocked();
+}
+
+void HeapSampler::UpdateSamplingIntervalLocked() {
+  bool profiler_enabled = profiler_enabled_.load(std::memory_order_relaxed);
+  int profiler_interval = profiler_sampling_interval_.load(std::memory_order_relaxed);
+  int site_interval = site_sampling_interval_.load(std::memory_order_relaxed);
+  int interval = profiler_interval;
+  if (site_interval != 0 && (!profiler_enabled || site_interval < profiler_interval)) {
+    interval = site_interval;
+  }
+  p_sampling_interval_.store(interval, std::memory_order_release);
   geo_dist_.param(std::geometric_distribution<size_t>::param_type(1.0/p_sampling_interval_));
+  enabled_.store(profiler_enabled || site_interval != 0, std::memory_order_release);
 }
 
 }  // namespace art
@@ -17,9 +17,12 @@
 #ifndef ART_RUNTIME_JAVAHEAPPROF_JAVAHEAPSAMPLER_H_
 #define ART_RUNTIME_JAVAHEAPPROF_JAVAHEAPSAMPLER_H_
 
+#include <iosfwd>
+#include <memory>
 #include <random>
 #include "base/locks.h"
 #include "base/mutex.h"
+#include "javaheapprof/allocation_site_table.h"
 #include "mirror/object.h"
 
 namespace art HIDDEN {
@@ -45,14 +48,20 @@ class HeapSampler {
   void SetHeapID(uint32_t heap_id) {
     perfetto_heap_id_ = heap_id;
   }
-  void EnableHeapSampler() {
-    enabled_.store(true, std::memory_order_release);
-  }
-  void DisableHeapSampler() {
-    enabled_.store(false, std::memory_order_release);
-  }
-  // Report a sample to Perfetto.
-  void ReportSample(art::mirror::Object* obj, size_t allocation_size);
+  // Enable or disable sampling for the Java Heap Profiler. Sampling continues while allocation
+  // site profiling is enabled.
+  void EnableHeapSampler() REQUIRES(!geo_dist_rng_lock_);
+  void DisableHeapSampler() REQUIRES(!geo_dist_rng_lock_);
+  // Also aggregate samples by allocation site in an in-process table, with its own sampling
+  // interval. The table is created on first use and kept for the lifetime of the runtime.
+  void EnableAllocationSiteProfiling(int sampling_interval) REQUIRES(!geo_dist_rng_lock_);
+  // Print the heaviest sampled allocation sites, if allocation site profiling is enabled.
+  void DumpAllocationSites(std::ostream& os) const;
+  // Called before the methods of unloaded class loaders are freed.
+  void OnClassLoadersUnloaded();
+  // Report a sample to Perfetto and to the allocation site table, each at its own interval.
+  void ReportSample(art::mirror::Object* obj, size_t allocation_size)
+      REQUIRES(!geo_dist_rng_lock_);
   // Check whether we should take a sample or not at this allocation, and return the
   // number of bytes from current pos to the next sample to use in the expand Tlab
   // calculation.
@@ -69,9 +78,10 @@ class HeapSampler {
   void AdjustSampleOffset(size_t adjustment);
   // Is heap sampler enabled?
   bool IsEnabled() { return enabled_.load(std::memory_order_acquire); }
-  // Set the sampling interval.
+  // Set the sampling interval of the Java Heap Profiler.
   void SetSamplingInterval(int sampling_interval) REQUIRES(!geo_dist_rng_lock_);
-  // Return the sampling interval.
+  // Return the interval at which allocations are sampled: the smallest interval wanted by the
+  // Java Heap Profiler and allocation site profiling.
   int GetSamplingInterval();
 
  private:
@@ -79,12 +89,29 @@ class HeapSampler {
   // Choose, save, and return the number of bytes until the next sample,
   // possibly decreasing sample intervals by sample_adj_bytes.
   size_t PickAndAdjustNextSample(size_t sample_adj_bytes = 0) REQUIRES(!geo_dist_rng_lock_);
+  // Recompute `p_sampling_interval_` and `enabled_` after a change of the intervals wanted.
+  void UpdateSamplingIntervalLocked() REQUIRES(geo_dist_rng_lock_);
+  // Whether to pass a sample taken at `GetSamplingInterval()` on to a consumer that wants one
+  // every `wanted_interval` bytes. Thinning the samples this way keeps them geometrically
+  // distributed with the wanted mean.
+  bool KeepSample(int wanted_interval) REQUIRES(!geo_dist_rng_lock_);
 
+  // Set if the Java Heap Profiler or allocation site profiling is enabled.
   std::atomic<bool> enabled_{false};
+  std::atomic<bool> profiler_enabled_{false};
   // Default sampling interval is 4kb.
   // Writes guarded by geo_dist_rng_lock_.
   std::atomic<int> p_sampling_interval_{4 * 1024};
+  // The intervals wanted by the Java Heap Profiler and by allocation site profiling (0 while it
+  // is disabled). Writes guarded by geo_dist_rng_lock_.
+  std::atomic<int> profiler_sampling_interval_{4 * 1024};
+  std::atomic<int> site_sampling_interval_{0};
+  // Zero until the heap is registered with Perfetto, samples are not reported to it before.
   uint32_t perfetto_heap_id_ = 0;
+  // Per-site aggregation of samples, null unless allocation site profiling is enabled. Never
+  // freed before the sampler so that readers do not need to synchronize with allocators.
+  std::atomic<AllocationSiteTable*> site_table_{nullptr};
+  std::unique_ptr<AllocationSiteTable> owned_site_table_ GUARDED_BY(geo_dist_rng_lock_);
   // std random number generator.
   std::minstd_rand rng_ GUARDED_BY(geo_dist_rng_lock_);  // Holds the state
   // std geometric distribution
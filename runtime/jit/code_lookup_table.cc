@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "code_lookup_table.h"
+
+#include <sched.h>
+
+#include <cmath>
+#include <iterator>
+
+#include "base/logging.h"
+
+namespace art HIDDEN {
+namespace jit {
+
+CodeLookupTable::~CodeLookupTable() {
+  const Snapshot* snapshot = snapshot_.load(std::memory_order_relaxed);
+  if (snapshot != nullptr) {
+    delete snapshot->base;
+    delete snapshot;
+  }
+}
+
+void CodeLookupTable::Publish(std::vector<Entry>&& entries) {
+  DCHECK(std::is_sorted(entries.begin(), entries.end()));
+  Replace(new Snapshot{new std::vector<Entry>(std::move(entries)), {}});
+}
+
+void CodeLookupTable::Add(const Entry& entry) {
+  const Snapshot* old_snapshot = snapshot_.load(std::memory_order_relaxed);
+  if (old_snapshot == nullptr) {
+    Publish({entry});
+    return;
+  }
+  const std::vector<Entry>& base = *old_snapshot->base;
+  const std::vector<Entry>& old_delta = old_snapshot->delta;
+  if (kIsDebugBuild) {
+    for (const std::vector<Entry>* entries : {&base, &old_delta}) {
+      const Entry* last = FindLastNotAbove(*entries, entry.first);
+      DCHECK(last == nullptr || last->first != entry.first);
+    }
+  }
+  size_t max_delta_size =
+      std::max(kMinMaxDeltaSize, static_cast<size_t>(std::sqrt(static_cast<double>(base.size()))));
+  if (old_delta.size() + 1u < max_delta_size) {
+    std::vector<Entry> delta;
+    delta.reserve(old_delta.size() + 1u);
+    auto pos = std::upper_bound(old_delta.begin(), old_delta.end(), entry);
+    delta.insert(delta.end(), old_delta.begin(), pos);
+    delta.push_back(entry);
+    delta.insert(delta.end(), pos, old_delta.end());
+    Replace(new Snapshot{old_snapshot->base, std::move(delta)});
+    return;
+  }
+  // Merge the delta and the new entry into a new base.
+  std::vector<Entry> delta = old_delta;
+  delta.insert(std::upper_bound(delta.begin(), delta.end(), entry), entry);
+  std::vector<Entry>* merged = new std::vector<Entry>();
+  merged->reserve(base.size() + delta.size());
+  std::merge(base.begin(), base.end(), delta.begin(), delta.end(), std::back_inserter(*merged));
+  Replace(new Snapshot{merged, {}});
+}
+
+void CodeLookupTable::Replace(Snapshot* snapshot) {
+  const Snapshot* old_snapshot = snapshot_.exchange(snapshot, std::memory_order_seq_cst);
+  if (old_snapshot == nullptr) {
+    return;
+  }
+  // Readers entering from now on see the new epoch and thus the new snapshot. Wait for the ones
+  // counted under the old epoch, they are only doing a binary search.
+  uint32_t old_epoch = epoch_.fetch_add(1u, std::memory_order_seq_cst);
+  const Stripe* old_stripes = stripes_[old_epoch & 1u];
+  for (size_t i = 0; i < kNumStripes; ++i) {
+    while (old_stripes[i].readers.load(std::memory_order_acquire) != 0u) {
+      sched_yield();
+    }
+  }
+  if (old_snapshot->base != snapshot->base) {
+    delete old_snapshot->base;
+  }
+  delete old_snapshot;
+}
+
+}  // namespace jit
+}  // namespace art
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_JIT_CODE_LOOKUP_TABLE_H_
+#define ART_RUNTIME_JIT_CODE_LOOKUP_TABLE_H_
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "base/atomic.h"
+#include "base/macros.h"
+
+namespace art HIDDEN {
+
+class ArtMethod;
+
+namespace jit {
+
+// A sorted array of JIT code start addresses and their methods, which can be searched without
+// taking a lock. Writers publish a complete new snapshot and then wait for the readers that may
+// still look at the previous one before deleting it. Readers announce themselves in one of two
+// sets of striped counters, selected by the parity of `epoch_`, so that they do not all write to
+// the same cache line.
+//
+// A snapshot is a large sorted base array, shared between snapshots, and a small sorted delta of
+// the entries added since. Add() only copies the delta, and merges it into a new base once it
+// holds about sqrt(n) entries, so that adding n entries one at a time costs O(n * sqrt(n))
+// rather than O(n^2). Removing entries republishes the whole table with Publish(). Lookups
+// search both arrays.
+//
+// Publishing must be serialized by the caller.
+class CodeLookupTable {
+ public:
+  using Entry = std::pair<const void*, ArtMethod*>;
+
+  CodeLookupTable() {}
+  ~CodeLookupTable();
+
+  // Replace the table with `entries`, which must be sorted by code address. Returns once no
+  // reader can be looking at the previous table.
+  void Publish(std::vector<Entry>&& entries);
+
+  // Add `entry`, whose code address must not be in the table yet. Returns once no reader can
+  // be looking at the previous table.
+  void Add(const Entry& entry);
+
+  // Find the entry with the greatest code address not above `pc`. The caller must check that
+  // `pc` is actually within that code. `hint` spreads readers over the counters, e.g. the
+  // address of the current Thread.
+  bool Lookup(const void* pc, uintptr_t hint, /*out*/ Entry* entry) const {
+    Atomic<uint32_t>& readers = EnterReader(hint);
+    const Snapshot* snapshot = snapshot_.load(std::memory_order_seq_cst);
+    bool found = false;
+    if (snapshot != nullptr) {
+      const Entry* base_entry = FindLastNotAbove(*snapshot->base, pc);
+      const Entry* delta_entry = FindLastNotAbove(snapshot->delta, pc);
+      if (base_entry != nullptr || delta_entry != nullptr) {
+        *entry = (delta_entry == nullptr ||
+                  (base_entry != nullptr && base_entry->first > delta_entry->first))
+            ? *base_entry
+            : *delta_entry;
+        found = true;
+      }
+    }
+    readers.fetch_sub(1u, std::memory_order_release);
+    return found;
+  }
+
+ private:
+  static constexpr size_t kNumStripes = 16;
+  static constexpr size_t kStripeAlignment = 64;
+  // The delta is merged into the base once it has this many entries or sqrt(base size).
+  static constexpr size_t kMinMaxDeltaSize = 32;
+
+  struct alignas(kStripeAlignment) Stripe {
+    mutable Atomic<uint32_t> readers{0u};
+  };
+
+  struct Snapshot {
+    // Owned by the table and shared by all snapshots published since the last merge.
+    const std::vector<Entry>* base;
+    std::vector<Entry> delta;
+  };
+
+  static const Entry* FindLastNotAbove(const std::vector<Entry>& entries, const void* pc) {
+    auto it = std::upper_bound(
+        entries.begin(),
+        entries.end(),
+        pc,
+        [](const void* value, const Entry& e) { return value < e.first; });
+    return (it != entries.begin()) ? &*(it - 1) : nullptr;
+  }
+
+  Atomic<uint32_t>& EnterReader(uintptr_t hint) const {
+    const Stripe* stripes = nullptr;
+    size_t index = (hint / kStripeAlignment) % kNumStripes;
+    while (true) {
+      uint32_t epoch = epoch_.load(std::memory_order_seq_cst);
+      stripes = stripes_[epoch & 1u];
+      stripes[index].readers.fetch_add(1u, std::memory_order_seq_cst);
+      // If a writer flipped the epoch in between, it may have missed our increment.
+      if (epoch_.load(std::memory_order_seq_cst) == epoch) {
+        return stripes[index].readers;
+      }
+      stripes[index].readers.fetch_sub(1u, std::memory_order_release);
+    }
+  }
+
+  // Make `snapshot` visible to readers, wait for the readers of the previous one and delete it,
+  // together with its base if `snapshot` does not share it.
+  void Replace(Snapshot* snapshot);
+
+  Atomic<const Snapshot*> snapshot_{nullptr};
+  Atomic<uint32_t> epoch_{0u};
+  Stripe stripes_[2][kNumStripes];
+
+  DISALLOW_COPY_AND_ASSIGN(CodeLookupTable);
+};
+
+}  // namespace jit
+}  // namespace art
+
+#endif  // ART_RUNTIME_JIT_CODE_LOOKUP_TABLE_H_
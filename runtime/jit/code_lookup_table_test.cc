@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "code_lookup_table.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+namespace art HIDDEN {
+namespace jit {
+
+static const void* Code(uintptr_t address) {
+  return reinterpret_cast<const void*>(address);
+}
+
+static ArtMethod* Method(uintptr_t id) {
+  return reinterpret_cast<ArtMethod*>(id);
+}
+
+TEST(CodeLookupTableTest, Lookup) {
+  CodeLookupTable table;
+  CodeLookupTable::Entry entry;
+  EXPECT_FALSE(table.Lookup(Code(0x1000), 0u, &entry));
+
+  table.Publish({{Code(0x1000), Method(1)}, {Code(0x2000), Method(2)}});
+  EXPECT_FALSE(table.Lookup(Code(0xfff), 0u, &entry));
+  ASSERT_TRUE(table.Lookup(Code(0x1000), 0u, &entry));
+  EXPECT_EQ(entry.second, Method(1));
+  ASSERT_TRUE(table.Lookup(Code(0x1fff), 0u, &entry));
+  EXPECT_EQ(entry.second, Method(1));
+  ASSERT_TRUE(table.Lookup(Code(0x2000), 0u, &entry));
+  EXPECT_EQ(entry.second, Method(2));
+  ASSERT_TRUE(table.Lookup(Code(0x9000), 0u, &entry));
+  EXPECT_EQ(entry.first, Code(0x2000));
+
+  table.Publish({{Code(0x2000), Method(3)}});
+  EXPECT_FALSE(table.Lookup(Code(0x1000), 0u, &entry));
+  ASSERT_TRUE(table.Lookup(Code(0x2010), 0u, &entry));
+  EXPECT_EQ(entry.second, Method(3));
+}
+
+TEST(CodeLookupTableTest, Add) {
+  static constexpr size_t kNumEntries = 1000;
+  CodeLookupTable table;
+  CodeLookupTable::Entry entry;
+  // Add entries in an order that interleaves with the ones already merged into the base.
+  for (size_t i = 0; i < kNumEntries; ++i) {
+    size_t index = (i * 7u) % kNumEntries;
+    table.Add({Code(0x1000 + index * 0x100), Method(index + 1)});
+    ASSERT_TRUE(table.Lookup(Code(0x1000 + index * 0x100 + 0x10), 0u, &entry));
+    EXPECT_EQ(entry.second, Method(index + 1));
+  }
+  for (size_t index = 0; index < kNumEntries; ++index) {
+    ASSERT_TRUE(table.Lookup(Code(0x1000 + index * 0x100 + 0xff), 0u, &entry));
+    EXPECT_EQ(entry.first, Code(0x1000 + index * 0x100));
+    EXPECT_EQ(entry.second, Method(index + 1));
+  }
+  EXPECT_FALSE(table.Lookup(Code(0xfff), 0u, &entry));
+
+  // Publishing drops the entries added before.
+  table.Publish({{Code(0x2000), Method(3)}});
+  table.Add({Code(0x3000), Method(4)});
+  EXPECT_FALSE(table.Lookup(Code(0x1000), 0u, &entry));
+  ASSERT_TRUE(table.Lookup(Code(0x2fff), 0u, &entry));
+  EXPECT_EQ(entry.second, Method(3));
+  ASSERT_TRUE(table.Lookup(Code(0x3000), 0u, &entry));
+  EXPECT_EQ(entry.second, Method(4));
+}
+
+TEST(CodeLookupTableTest, ConcurrentPublish) {
+  static constexpr size_t kNumReaders = 4;
+  static constexpr size_t kNumPublishes = 1000;
+  CodeLookupTable table;
+  // The entry at 0x1000 is always present, tables only differ in the entries after it.
+  table.Publish({{Code(0x1000), Method(1)}});
+  std::atomic<bool> done(false);
+  std::atomic<size_t> failures(0u);
+  std::vector<std::thread> readers;
+  for (size_t i = 0; i < kNumReaders; ++i) {
+    readers.emplace_back([&, i]() {
+      CodeLookupTable::Entry entry;
+      while (!done.load(std::memory_order_relaxed)) {
+        if (!table.Lookup(Code(0x1800), i * 64u, &entry) || entry.second != Method(1)) {
+          failures.fetch_add(1u, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+  for (size_t i = 0; i < kNumPublishes; ++i) {
+    std::vector<CodeLookupTable::Entry> entries = {{Code(0x1000), Method(1)}};
+    for (size_t j = 0; j < i % 16u; ++j) {
+      entries.emplace_back(Code(0x2000 + j * 0x100), Method(j + 2));
+    }
+    table.Publish(std::move(entries));
+  }
+  done.store(true, std::memory_order_relaxed);
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(failures.load(), 0u);
+}
+
+}  // namespace jit
+}  // namespace art
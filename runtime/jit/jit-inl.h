@@ -27,7 +27,7 @@
 namespace art HIDDEN {
 namespace jit {
 
-inline void Jit::AddSamples(Thread* self, ArtMethod* method) {
+inline void Jit::AddSamples(Thread* self, ArtMethod* method, bool from_loop) {
   if (method->CounterIsHot()) {
     if (method->IsMemorySharedMethod()) {
       if (self->DecrementSharedMethodHotness() == 0) {
@@ -38,7 +38,7 @@ inline void Jit::AddSamples(Thread* self, ArtMethod* method) {
     } else {
       method->ResetCounter(Runtime::Current()->GetJITOptions()->GetWarmupThreshold());
     }
-    MaybeEnqueueCompilation(method, self);
+    MaybeEnqueueCompilation(method, self, from_loop);
   } else {
     method->UpdateCounter(1);
   }
@@ -17,9 +17,11 @@
 #include "jit.h"
 
 #include <dlfcn.h>
+#include <stdlib.h>
 #include <sys/resource.h>
 
 #include "art_method-inl.h"
+#include "base/arena_allocator.h"
 #include "base/file_utils.h"
 #include "base/logging.h"  // For VLOG.
 #include "base/memfd.h"
@@ -27,10 +29,12 @@
 #include "base/pointer_size.h"
 #include "base/runtime_debug.h"
 #include "base/scoped_flock.h"
+#include "base/stl_util.h"
 #include "base/utils.h"
 #include "class_root-inl.h"
 #include "compilation_kind.h"
 #include "debugger.h"
+#include "dex/dex_file_loader.h"
 #include "dex/type_lookup_table.h"
 #include "entrypoints/entrypoint_utils-inl.h"
 #include "entrypoints/runtime_asm_entrypoints.h"
@@ -40,6 +44,7 @@
 #include "jit_code_cache.h"
 #include "jit_create.h"
 #include "jni/java_vm_ext.h"
+#include "mirror/iftable-inl.h"
 #include "mirror/method_handle_impl.h"
 #include "mirror/var_handle.h"
 #include "oat/image-inl.h"
@@ -50,6 +55,7 @@
 #include "profile/profile_boot_info.h"
 #include "profile/profile_compilation_info.h"
 #include "profile_saver.h"
+#include "profiling_info.h"
 #include "runtime.h"
 #include "runtime_options.h"
 #include "small_pattern_matcher.h"
@@ -70,8 +76,26 @@ JitCompilerInterface* Jit::jit_compiler_ = nullptr;
 void Jit::DumpInfo(std::ostream& os) {
   code_cache_->Dump(os);
   cumulative_timings_.Dump(os);
-  MutexLock mu(Thread::Current(), lock_);
-  memory_use_.PrintMemoryUse(os);
+  {
+    MutexLock mu(Thread::Current(), lock_);
+    memory_use_.PrintMemoryUse(os);
+    os << "JIT arena memory kept between compilations: "
+       << PrettySize(std::min(arena_high_water_mark_, kMaxRetainedArenaBytes)) << "\n"
+       << "Populated free memory of the JIT arena pool: "
+       << PrettySize(Runtime::Current()->GetJitArenaPool()->GetBytesAllocated()) << "\n";
+    if (!largest_arena_allocation_stats_.empty()) {
+      os << "Largest JIT arena allocation: " << largest_arena_allocation_stats_ << "\n";
+    }
+  }
+  os << "Number of OSR entries: " << number_of_osr_entries_.load(std::memory_order_relaxed) << "\n"
+     << "Number of OSR attempts without OSR code: "
+         << number_of_osr_misses_no_code_.load(std::memory_order_relaxed) << "\n"
+     << "Number of OSR attempts without OSR entry at the back edge: "
+         << number_of_osr_misses_no_stack_map_.load(std::memory_order_relaxed) << "\n"
+     << "Number of OSR attempts rejected: "
+         << number_of_osr_rejections_.load(std::memory_order_relaxed) << "\n";
+  MutexLock mu(Thread::Current(), pressure_lock_);
+  pressure_controller_.Dump(os);
 }
 
 void Jit::DumpForSigQuit(std::ostream& os) {
@@ -87,9 +111,11 @@ Jit::Jit(JitCodeCache* code_cache, JitOptions* options)
     : code_cache_(code_cache),
       options_(options),
       boot_completed_lock_("Jit::boot_completed_lock_"),
+      application_profile_lock_("Jit::application_profile_lock_"),
       cumulative_timings_("JIT timings"),
       memory_use_("Memory used for compilation", 16),
       lock_("JIT memory use lock"),
+      pressure_lock_("JIT pressure lock"),
       zygote_mapping_methods_(),
       fd_methods_(-1),
       fd_methods_size_(0) {}
@@ -225,8 +251,10 @@ bool Jit::CompileMethodInternal(ArtMethod* method,
   VLOG(jit) << "Compiling method "
             << ArtMethod::PrettyMethod(method_to_compile)
             << " kind=" << compilation_kind;
+  uint64_t start_ns = NanoTime();
   bool success = jit_compiler_->CompileMethod(self, region, method_to_compile, compilation_kind);
   code_cache_->DoneCompiling(method_to_compile, self);
+  RecordCompilationPressure(self, NanoTime() - start_ns);
   if (!success) {
     VLOG(jit) << "Failed to compile method "
               << ArtMethod::PrettyMethod(method_to_compile)
@@ -244,6 +272,38 @@ bool Jit::CompileMethodInternal(ArtMethod* method,
   return success;
 }
 
+void Jit::RecordCompilationPressure(Thread* self, uint64_t compile_ns) {
+  size_t used_memory;
+  size_t max_capacity;
+  size_t recompilations;
+  code_cache_->GetPressureInfo(self, &used_memory, &max_capacity, &recompilations);
+  MutexLock mu(self, pressure_lock_);
+  pressure_controller_.RecordCompilation(
+      NanoTime(), compile_ns, used_memory, max_capacity, recompilations);
+}
+
+void Jit::MaybeThrottleCompilation(Thread* self) {
+  const uint64_t now_ns = NanoTime();
+  uint64_t delay_ns;
+  {
+    MutexLock mu(self, pressure_lock_);
+    delay_ns = pressure_controller_.GetThrottleDelayNs(now_ns);
+  }
+  if (delay_ns == 0u) {
+    return;
+  }
+  // Hold back the optimized queue rather than this worker, so that OSR and baseline compilations,
+  // which are cheap and latency sensitive, keep going.
+  uint64_t paused_ns = thread_pool_->PauseOptimizedCompilations(self, now_ns + delay_ns);
+  if (paused_ns == 0u) {
+    return;
+  }
+  VLOG(jit) << "JIT throttling optimized compilation for " << PrettyDuration(delay_ns);
+  Runtime::Current()->GetMetrics()->JitThrottledTime()->Add(NsToUs(paused_ns));
+  MutexLock mu(self, pressure_lock_);
+  pressure_controller_.RecordThrottle(paused_ns);
+}
+
 void Jit::WaitForWorkersToBeCreated() {
   if (thread_pool_ != nullptr) {
     thread_pool_->WaitForWorkersToBeCreated();
@@ -252,6 +312,8 @@ void Jit::WaitForWorkersToBeCreated() {
 
 void Jit::DeleteThreadPool() {
   Thread* self = Thread::Current();
+  // Deleting the tasks needs the mutator lock, do it while this thread is still attached.
+  DeletePendingApplicationProfileTasks();
   if (thread_pool_ != nullptr) {
     std::unique_ptr<JitThreadPool> pool;
     {
@@ -282,6 +344,7 @@ void Jit::StartProfileSaver(const std::string& profile_filename,
                         code_cache_,
                         code_paths,
                         ref_profile_filename);
+    StartApplicationProfileTasks(profile_filename, code_paths);
   }
 }
 
@@ -353,9 +416,8 @@ OsrData* Jit::PrepareForOsr(ArtMethod* method, uint32_t dex_pc, uint32_t* vregs)
     return nullptr;
   }
 
-  // Cheap check if the method has been compiled already. That's an indicator that we should
-  // osr into it.
-  if (!GetCodeCache()->ContainsPc(method->GetEntryPointFromQuickCompiledCode())) {
+  // Cheap check if the method has OSR code, to avoid taking the JIT lock on every back edge.
+  if (!GetCodeCache()->MayHaveOsrCode(method)) {
     return nullptr;
   }
 
@@ -372,6 +434,7 @@ OsrData* Jit::PrepareForOsr(ArtMethod* method, uint32_t dex_pc, uint32_t* vregs)
     const OatQuickMethodHeader* osr_method = GetCodeCache()->LookupOsrMethodHeader(method);
     if (osr_method == nullptr) {
       // No osr method yet, just return to the interpreter.
+      number_of_osr_misses_no_code_.fetch_add(1u, std::memory_order_relaxed);
       return nullptr;
     }
 
@@ -382,6 +445,7 @@ OsrData* Jit::PrepareForOsr(ArtMethod* method, uint32_t dex_pc, uint32_t* vregs)
     if (!stack_map.IsValid()) {
       // There is no OSR stack map for this dex pc offset. Just return to the interpreter in the
       // hope that the next branch has one.
+      number_of_osr_misses_no_stack_map_.fetch_add(1u, std::memory_order_relaxed);
       return nullptr;
     }
 
@@ -439,6 +503,8 @@ OsrData* Jit::PrepareForOsr(ArtMethod* method, uint32_t dex_pc, uint32_t* vregs)
               << "@"
               << std::hex << reinterpret_cast<uintptr_t>(osr_data->native_pc);
   }
+  number_of_osr_entries_.fetch_add(1u, std::memory_order_relaxed);
+  Runtime::Current()->GetMetrics()->JitOsrEntryCount()->AddOne();
   return osr_data;
 }
 
@@ -457,6 +523,7 @@ bool Jit::MaybeDoOnStackReplacement(Thread* thread,
     // the interpreter frames are still on stack, OSR has the potential
     // to stack overflow even for a simple loop.
     // b/27094810.
+    jit->number_of_osr_rejections_.fetch_add(1u, std::memory_order_relaxed);
     return false;
   }
 
@@ -472,6 +539,7 @@ bool Jit::MaybeDoOnStackReplacement(Thread* thread,
   // complexity.
   if (Runtime::Current()->GetInstrumentation()->NeedsSlowInterpreterForMethod(thread, method) ||
       Runtime::Current()->GetRuntimeCallbacks()->HaveLocalsChanged()) {
+    jit->number_of_osr_rejections_.fetch_add(1u, std::memory_order_relaxed);
     return false;
   }
 
@@ -515,6 +583,28 @@ void Jit::AddMemoryUsage(ArtMethod* method, size_t bytes) {
   }
   MutexLock mu(Thread::Current(), lock_);
   memory_use_.AddValue(bytes);
+  arena_high_water_mark_ = std::max(arena_high_water_mark_, bytes);
+}
+
+void Jit::AddArenaAllocationStats(ArtMethod* method, size_t bytes, std::string&& stats) {
+  MutexLock mu(Thread::Current(), lock_);
+  if (bytes > largest_arena_allocation_) {
+    largest_arena_allocation_ = bytes;
+    largest_arena_allocation_stats_ =
+        ArtMethod::PrettyMethod(method) + " (" + PrettySize(bytes) + ")\n" + stats;
+  }
+}
+
+void Jit::TrimArenaPool(Thread* self) {
+  size_t retained_bytes;
+  {
+    MutexLock mu(self, lock_);
+    retained_bytes = std::min(arena_high_water_mark_, kMaxRetainedArenaBytes);
+    // Decay the high-water mark so that the memory of an unusually large compilation
+    // is eventually released if no other compilation needs as much.
+    arena_high_water_mark_ -= arena_high_water_mark_ / kArenaHighWaterMarkDecay;
+  }
+  Runtime::Current()->GetJitArenaPool()->TrimMapsAbove(retained_bytes);
 }
 
 void Jit::NotifyZygoteCompilationDone() {
@@ -658,10 +748,12 @@ class JitCompileTask final : public Task {
                  CompilationKind compilation_kind)
       : method_(method),
         kind_(task_kind),
-        compilation_kind_(compilation_kind) {
+        compilation_kind_(compilation_kind),
+        enqueue_time_ms_(MilliTime()) {
   }
 
   void Run(Thread* self) override {
+    RecordQueueTime();
     {
       ScopedObjectAccess soa(self);
       switch (kind_) {
@@ -677,6 +769,9 @@ class JitCompileTask final : public Task {
       }
     }
     ProfileSaver::NotifyJitActivity();
+    if (kind_ == TaskKind::kCompile) {
+      Runtime::Current()->GetJit()->MaybeThrottleCompilation(self);
+    }
   }
 
   void Finalize() override {
@@ -696,9 +791,27 @@ class JitCompileTask final : public Task {
   }
 
  private:
+  void RecordQueueTime() {
+    const uint64_t queue_time_ms = MilliTime() - enqueue_time_ms_;
+    metrics::ArtMetrics* metrics = Runtime::Current()->GetMetrics();
+    switch (compilation_kind_) {
+      case CompilationKind::kOsr:
+        metrics->JitOsrQueueTime()->Add(queue_time_ms);
+        break;
+      case CompilationKind::kBaseline:
+        metrics->JitBaselineQueueTime()->Add(queue_time_ms);
+        break;
+      case CompilationKind::kOptimized:
+        metrics->JitOptimizedQueueTime()->Add(queue_time_ms);
+        break;
+    }
+  }
+
   ArtMethod* const method_;
   const TaskKind kind_;
   const CompilationKind compilation_kind_;
+  // Used to report how long the task waited in the queue.
+  const uint64_t enqueue_time_ms_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(JitCompileTask);
 };
@@ -914,14 +1027,35 @@ class JitProfileTask final : public Task {
     std::string profile = GetProfileFile(dex_files_[0]->GetLocation());
     std::string boot_profile = GetBootProfileFile(profile);
 
+    if (!profile_.empty()) {
+      // Application profiles are not co-located with the dex files and do not have a boot
+      // profile.
+      profile = profile_;
+      boot_profile.clear();
+    }
+
     Jit* jit = Runtime::Current()->GetJit();
+    const JitOptions* options = Runtime::Current()->GetJITOptions();
 
-    jit->CompileMethodsFromBootProfile(
-        self,
-        dex_files_,
-        boot_profile,
-        loader,
-        /* add_to_queue= */ false);
+    // Do these first, the application is running its startup code right now.
+    if (options->InitializeClasses() && !profile_.empty()) {
+      jit->InitializeClassesFromProfile(self, dex_files_, profile, loader);
+    }
+    if (options->PrefillDexCaches() && !profile_.empty()) {
+      jit->PrefillDexCachesFromProfile(self, dex_files_, profile, loader);
+    }
+    if (!options->UseProfiledJitCompilation()) {
+      return;
+    }
+
+    if (!boot_profile.empty()) {
+      jit->CompileMethodsFromBootProfile(
+          self,
+          dex_files_,
+          boot_profile,
+          loader,
+          /* add_to_queue= */ false);
+    }
 
     jit->CompileMethodsFromProfile(
         self,
@@ -940,9 +1074,19 @@ class JitProfileTask final : public Task {
     soa.Vm()->DeleteGlobalRef(soa.Self(), class_loader_);
   }
 
+  const std::vector<const DexFile*>& GetDexFiles() const {
+    return dex_files_;
+  }
+
+  void SetProfile(const std::string& profile) {
+    profile_ = profile;
+  }
+
  private:
   std::vector<const DexFile*> dex_files_;
   jobject class_loader_;
+  // Profile to compile methods from. If empty, use the profile next to the dex files.
+  std::string profile_;
 
   DISALLOW_COPY_AND_ASSIGN(JitProfileTask);
 };
@@ -1086,9 +1230,11 @@ void Jit::CreateThreadPool() {
   // There is a DCHECK in the 'AddSamples' method to ensure the tread pool
   // is not null when we instrument.
 
-  thread_pool_.reset(JitThreadPool::Create("Jit thread pool", 1));
-
   Runtime* runtime = Runtime::Current();
+  // The zygote deletes and recreates its workers around each fork, keep a single one there.
+  thread_pool_.reset(JitThreadPool::Create(
+      "Jit thread pool", runtime->IsZygote() ? 1u : options_->GetThreadPoolSize()));
+
   thread_pool_->SetPthreadPriority(
       runtime->IsZygote()
           ? options_->GetZygoteThreadPoolPthreadPriority()
@@ -1210,6 +1356,76 @@ void Jit::RegisterDexFiles(const std::vector<std::unique_ptr<const DexFile>>& de
     // - System server dex files are registered *before* we set the runtime as
     //   system server (though we are in the system server process).
     thread_pool_->AddTask(Thread::Current(), new JitProfileTask(dex_files, class_loader));
+  } else if (UseJitCompilation() &&
+             (options_->UseProfiledJitCompilation() ||
+              options_->PrefillDexCaches() ||
+              options_->InitializeClasses()) &&
+             options_->GetSaveProfilingInfo() &&
+             !runtime->IsZygote() &&
+             !runtime->IsJavaDebuggable()) {
+    // The location of the application profile is only known once the profile saver is
+    // started. Keep the task until then, see StartApplicationProfileTasks.
+    // Dex files loaded after the application started are not in its profile.
+    Thread* self = Thread::Current();
+    {
+      MutexLock mu(self, application_profile_lock_);
+      if (application_profile_known_) {
+        return;
+      }
+    }
+    JitProfileTask* task = new JitProfileTask(dex_files, class_loader);
+    {
+      MutexLock mu(self, application_profile_lock_);
+      if (!application_profile_known_) {
+        pending_application_profile_tasks_.push_back(task);
+        return;
+      }
+    }
+    // The profile saver was started while creating the task.
+    task->Finalize();
+  }
+}
+
+void Jit::StartApplicationProfileTasks(const std::string& profile_filename,
+                                       const std::vector<std::string>& code_paths) {
+  Thread* self = Thread::Current();
+  std::vector<JitProfileTask*> tasks;
+  {
+    MutexLock mu(self, application_profile_lock_);
+    application_profile_known_ = true;
+    tasks.swap(pending_application_profile_tasks_);
+  }
+  for (JitProfileTask* task : tasks) {
+    bool in_code_paths = std::any_of(
+        task->GetDexFiles().begin(),
+        task->GetDexFiles().end(),
+        [&](const DexFile* dex_file) {
+          std::string location = DexFileLoader::GetBaseLocation(dex_file->GetLocation());
+          return ContainsElement(code_paths, location);
+        });
+    if (in_code_paths && thread_pool_ != nullptr) {
+      // The saved profile holds the methods that were hot in earlier runs of the application
+      // and have not been AOT compiled since. Compile them in the background instead of
+      // waiting for them to warm up again, and prefill the dex caches for startup code.
+      VLOG(jit) << "Compiling methods of " << task->GetDexFiles()[0]->GetLocation()
+                << " from " << profile_filename;
+      task->SetProfile(profile_filename);
+      thread_pool_->AddTask(self, task);
+    } else {
+      task->Finalize();
+    }
+  }
+}
+
+void Jit::DeletePendingApplicationProfileTasks() {
+  std::vector<JitProfileTask*> tasks;
+  {
+    MutexLock mu(Thread::Current(), application_profile_lock_);
+    tasks.swap(pending_application_profile_tasks_);
+  }
+  // Deleting the tasks needs the mutator lock, do it without holding the lock.
+  for (JitProfileTask* task : tasks) {
+    task->Finalize();
   }
 }
 
@@ -1373,6 +1589,211 @@ uint32_t Jit::CompileMethodsFromProfile(
   return added_to_queue;
 }
 
+void Jit::PrefillDexCacheForMethod(Thread* self,
+                                   ClassLinker* class_linker,
+                                   uint32_t method_idx,
+                                   Handle<mirror::DexCache> dex_cache,
+                                   Handle<mirror::ClassLoader> class_loader) {
+  // This fills the same dex cache entries as the application threads would on first use.
+  // Racing with them is fine, they all store the same resolved entry.
+  ArtMethod* method = class_linker->ResolveMethodWithoutInvokeType(
+      method_idx, dex_cache, class_loader);
+  if (method == nullptr) {
+    self->ClearException();
+    return;
+  }
+  if (method->GetDexFile() != dex_cache->GetDexFile()) {
+    return;
+  }
+  for (const DexInstructionPcPair& inst : method->DexInstructions()) {
+    switch (inst->Opcode()) {
+      case Instruction::CONST_STRING:
+      case Instruction::CONST_STRING_JUMBO: {
+        dex::StringIndex string_idx(inst->VRegB());
+        if (class_linker->ResolveString(string_idx, dex_cache) == nullptr) {
+          self->ClearException();
+        }
+        break;
+      }
+      case Instruction::CONST_CLASS:
+      case Instruction::CHECK_CAST:
+      case Instruction::NEW_INSTANCE:
+      case Instruction::INSTANCE_OF:
+      case Instruction::NEW_ARRAY:
+      case Instruction::FILLED_NEW_ARRAY:
+      case Instruction::FILLED_NEW_ARRAY_RANGE: {
+        dex::TypeIndex type_idx((inst->Opcode() == Instruction::INSTANCE_OF ||
+                                 inst->Opcode() == Instruction::NEW_ARRAY)
+            ? inst->VRegC_22c()
+            : inst->VRegB());
+        if (class_linker->ResolveType(type_idx, dex_cache, class_loader) == nullptr) {
+          self->ClearException();
+        }
+        break;
+      }
+      case Instruction::INVOKE_VIRTUAL:
+      case Instruction::INVOKE_SUPER:
+      case Instruction::INVOKE_DIRECT:
+      case Instruction::INVOKE_STATIC:
+      case Instruction::INVOKE_INTERFACE:
+      case Instruction::INVOKE_VIRTUAL_RANGE:
+      case Instruction::INVOKE_SUPER_RANGE:
+      case Instruction::INVOKE_DIRECT_RANGE:
+      case Instruction::INVOKE_STATIC_RANGE:
+      case Instruction::INVOKE_INTERFACE_RANGE: {
+        if (class_linker->ResolveMethodWithoutInvokeType(
+                inst->VRegB(), dex_cache, class_loader) == nullptr) {
+          self->ClearException();
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+}
+
+uint32_t Jit::PrefillDexCachesFromProfile(Thread* self,
+                                          const std::vector<const DexFile*>& dex_files,
+                                          const std::string& profile_file,
+                                          Handle<mirror::ClassLoader> class_loader) {
+  // The profile does not exist until the profile saver first writes it.
+  unix_file::FdFile profile(profile_file, O_RDONLY, true);
+  if (profile.Fd() == -1) {
+    return 0u;
+  }
+
+  ProfileCompilationInfo profile_info(/* for_boot_image= */ false);
+  if (!profile_info.Load(profile.Fd())) {
+    LOG(ERROR) << "Could not load profile file";
+    return 0u;
+  }
+  StackHandleScope<1> hs(self);
+  MutableHandle<mirror::DexCache> dex_cache = hs.NewHandle<mirror::DexCache>(nullptr);
+  ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
+  uint32_t number_of_methods = 0u;
+  for (const DexFile* dex_file : dex_files) {
+    std::set<dex::TypeIndex> class_types;
+    std::set<uint16_t> unused_methods;
+    std::set<uint16_t> startup_methods;
+    if (!profile_info.GetClassesAndMethods(*dex_file,
+                                           &class_types,
+                                           &unused_methods,
+                                           &startup_methods,
+                                           &unused_methods)) {
+      continue;
+    }
+    dex_cache.Assign(class_linker->FindDexCache(self, *dex_file));
+    CHECK(dex_cache != nullptr) << "Could not find dex cache for " << dex_file->GetLocation();
+
+    for (dex::TypeIndex type_idx : class_types) {
+      // The index is greater or equal to NumTypeIds if the type is an extra
+      // descriptor, not referenced by the dex file.
+      if (type_idx.index_ < dex_file->NumTypeIds() &&
+          class_linker->ResolveType(type_idx, dex_cache, class_loader) == nullptr) {
+        self->ClearException();
+      }
+    }
+    for (uint16_t method_idx : startup_methods) {
+      PrefillDexCacheForMethod(self, class_linker, method_idx, dex_cache, class_loader);
+      ++number_of_methods;
+    }
+  }
+  VLOG(jit) << "Prefilled dex caches of " << dex_files[0]->GetLocation() << " for "
+            << number_of_methods << " startup methods from " << profile_file;
+  return number_of_methods;
+}
+
+// Returns whether `klass` can be initialized ahead of its first use. This is the case if
+// the class, its uninitialized superclasses and the uninitialized interfaces with default
+// methods that it implements are verified and only have trivial class initializers, so
+// that neither the time nor the thread of the initialization can be observed.
+static bool CanInitializeAheadOfUse(ObjPtr<mirror::Class> klass, PointerSize pointer_size)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  for (ObjPtr<mirror::Class> k = klass; k != nullptr && !k->IsInitialized();
+       k = k->GetSuperClass()) {
+    if (!k->IsVerified() || !k->HasTrivialClassInitializer(pointer_size)) {
+      return false;
+    }
+  }
+  ObjPtr<mirror::IfTable> iftable = klass->GetIfTable();
+  for (int32_t i = 0, count = iftable->Count(); i != count; ++i) {
+    ObjPtr<mirror::Class> iface = iftable->GetInterface(i);
+    if (!iface->HasDefaultMethods() || iface->IsInitialized()) {
+      continue;  // Initializing `klass` does not run an initializer for this interface.
+    }
+    if (!iface->IsVerified() || !iface->HasTrivialClassInitializer(pointer_size)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint32_t Jit::InitializeClassesFromProfile(Thread* self,
+                                           const std::vector<const DexFile*>& dex_files,
+                                           const std::string& profile_file,
+                                           Handle<mirror::ClassLoader> class_loader) {
+  // The profile does not exist until the profile saver first writes it.
+  unix_file::FdFile profile(profile_file, O_RDONLY, true);
+  if (profile.Fd() == -1) {
+    return 0u;
+  }
+
+  ProfileCompilationInfo profile_info(/* for_boot_image= */ false);
+  if (!profile_info.Load(profile.Fd())) {
+    LOG(ERROR) << "Could not load profile file";
+    return 0u;
+  }
+  StackHandleScope<2> hs(self);
+  MutableHandle<mirror::DexCache> dex_cache = hs.NewHandle<mirror::DexCache>(nullptr);
+  MutableHandle<mirror::Class> klass = hs.NewHandle<mirror::Class>(nullptr);
+  ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
+  PointerSize pointer_size = class_linker->GetImagePointerSize();
+  uint32_t number_of_classes = 0u;
+  for (const DexFile* dex_file : dex_files) {
+    std::set<dex::TypeIndex> class_types;
+    std::set<uint16_t> unused_methods;
+    if (!profile_info.GetClassesAndMethods(*dex_file,
+                                           &class_types,
+                                           &unused_methods,
+                                           &unused_methods,
+                                           &unused_methods)) {
+      continue;
+    }
+    dex_cache.Assign(class_linker->FindDexCache(self, *dex_file));
+    CHECK(dex_cache != nullptr) << "Could not find dex cache for " << dex_file->GetLocation();
+
+    for (dex::TypeIndex type_idx : class_types) {
+      // The index is greater or equal to NumTypeIds if the type is an extra
+      // descriptor, not referenced by the dex file.
+      if (type_idx.index_ >= dex_file->NumTypeIds()) {
+        continue;
+      }
+      klass.Assign(class_linker->ResolveType(type_idx, dex_cache, class_loader));
+      if (klass == nullptr) {
+        self->ClearException();
+        continue;
+      }
+      if (klass->IsInitialized() || !CanInitializeAheadOfUse(klass.Get(), pointer_size)) {
+        continue;
+      }
+      // This follows the regular initialization protocol: if the application is already
+      // initializing the class, we wait for it.
+      if (!class_linker->EnsureInitialized(self,
+                                           klass,
+                                           /* can_init_fields= */ true,
+                                           /* can_init_parents= */ true)) {
+        self->ClearException();
+        continue;
+      }
+      ++number_of_classes;
+    }
+  }
+  VLOG(jit) << "Initialized " << number_of_classes << " classes of "
+            << dex_files[0]->GetLocation() << " from " << profile_file;
+  return number_of_classes;
+}
+
 bool Jit::IgnoreSamplesForMethod(ArtMethod* method) REQUIRES_SHARED(Locks::mutator_lock_) {
   if (method->IsClassInitializer() || !method->IsCompilable()) {
     // We do not want to compile such methods.
@@ -1414,6 +1835,15 @@ void Jit::EnqueueOptimizedCompilation(ArtMethod* method, Thread* self) {
   // hotness threshold. If we're not only using the baseline compiler, enqueue a compilation
   // task that will compile optimize the method.
   if (!options_->UseBaselineCompiler()) {
+    // Under pressure, keep lukewarm methods in baseline code: only optimize the ones whose
+    // baseline code keeps running out of hotness.
+    uint32_t needed = JitPressureController::GetOptimizationRequestsNeeded(GetPressure());
+    if (needed > 1u) {
+      ProfilingInfo* info = GetCodeCache()->GetProfilingInfo(method, self);
+      if (info != nullptr && !info->RecordOptimizationRequest(needed)) {
+        return;
+      }
+    }
     AddCompileTask(self, method, CompilationKind::kOptimized);
   }
 }
@@ -1619,7 +2049,7 @@ void Jit::PostZygoteFork() {
     NotifyZygoteCompilationDone();
     CHECK(code_cache_->GetZygoteMap()->IsCompilationNotified());
   }
-  thread_pool_->CreateThreads();
+  thread_pool_->CreateThreads(runtime->IsZygote() ? 1u : options_->GetThreadPoolSize());
   thread_pool_->SetPthreadPriority(
       runtime->IsZygote()
           ? options_->GetZygoteThreadPoolPthreadPriority()
@@ -1677,7 +2107,7 @@ bool Jit::CanAssumeInitialized(ObjPtr<mirror::Class> cls, bool is_for_shared_reg
   }
 }
 
-void Jit::MaybeEnqueueCompilation(ArtMethod* method, Thread* self) {
+void Jit::MaybeEnqueueCompilation(ArtMethod* method, Thread* self, bool from_loop) {
   if (thread_pool_ == nullptr) {
     return;
   }
@@ -1731,6 +2161,17 @@ void Jit::MaybeEnqueueCompilation(ArtMethod* method, Thread* self) {
     }
   }
 
+  if (from_loop &&
+      options_->UseEarlyOsrCompilation() &&
+      !method->IsNative() &&
+      GetPressure() == JitPressure::kNone &&
+      !GetCodeCache()->IsSharedRegion(*GetCodeCache()->GetCurrentRegion())) {
+    // The method got hot in a loop before being compiled at all. This may be a long running loop
+    // in a method invoked once, which only OSR can speed up, so don't wait for the baseline code
+    // to request it.
+    AddCompileTask(self, method, CompilationKind::kOsr);
+  }
+
   if (!method->IsNative() && GetCodeCache()->CanAllocateProfilingInfo()) {
     AddCompileTask(self, method, CompilationKind::kBaseline);
   } else {
@@ -1753,7 +2194,7 @@ size_t JitThreadPool::GetTaskCount(Thread* self) {
   MutexLock mu(self, task_queue_lock_);
   return generic_queue_.size() +
       baseline_queue_.size() +
-      optimized_queue_.size() +
+      optimized_requests_.size() +
       osr_queue_.size();
 }
 
@@ -1776,6 +2217,7 @@ void JitThreadPool::RemoveAllTasks(Thread* self) {
   MutexLock mu(self, task_queue_lock_);
   baseline_queue_.clear();
   optimized_queue_.clear();
+  optimized_requests_.clear();
   osr_queue_.clear();
 }
 
@@ -1793,6 +2235,7 @@ void JitThreadPool::AddTask(Thread* self, Task* task) {
     return;
   }
   generic_queue_.push_back(task);
+  UpdateActiveWorkersLocked();
   // If we have any waiters, signal one.
   if (waiting_count_ != 0) {
     task_queue_condition_.Signal(self);
@@ -1800,6 +2243,7 @@ void JitThreadPool::AddTask(Thread* self, Task* task) {
 }
 
 void JitThreadPool::AddTask(Thread* self, ArtMethod* method, CompilationKind kind) {
+  uint64_t now_ns = NanoTime();
   MutexLock mu(self, task_queue_lock_);
   // We don't want to enqueue any new tasks when thread pool has stopped. This simplifies
   // the implementation of redefinition feature in jvmti.
@@ -1821,20 +2265,64 @@ void JitThreadPool::AddTask(Thread* self, ArtMethod* method, CompilationKind kin
       baseline_enqueued_methods_.insert(method);
       baseline_queue_.push_back(method);
       break;
-    case CompilationKind::kOptimized:
+    case CompilationKind::kOptimized: {
       if (ContainsElement(optimized_enqueued_methods_, method)) {
+        auto it = optimized_requests_.find(method);
+        if (it != optimized_requests_.end()) {
+          // Still waiting: the method stayed hot. Move it ahead of the methods requested only
+          // once, the first time this happens; its old entry is skipped once fetched.
+          if (++it->second.requests == 2u) {
+            optimized_queue_.push_front(method);
+          }
+          it->second.last_request_ns = now_ns;
+        }
         return;
       }
       optimized_enqueued_methods_.insert(method);
+      optimized_requests_.emplace(method, OptimizedRequest{1u, now_ns});
       optimized_queue_.push_back(method);
       break;
+    }
   }
+  UpdateActiveWorkersLocked();
   // If we have any waiters, signal one.
   if (waiting_count_ != 0) {
     task_queue_condition_.Signal(self);
   }
 }
 
+void JitThreadPool::CreateThreads(size_t num_threads) {
+  DCHECK_NE(num_threads, 0u);
+  {
+    MutexLock mu(Thread::Current(), task_queue_lock_);
+    max_active_workers_ = num_threads;
+  }
+  CreateThreads();
+}
+
+void JitThreadPool::UpdateActiveWorkersLocked() {
+  size_t num_threads = GetThreadCount();
+  if (num_threads <= 1u) {
+    return;
+  }
+  uint64_t now_ns = NanoTime();
+  if (now_ns - last_load_sample_ns_ >= kLoadSamplePeriodNs) {
+    last_load_sample_ns_ = now_ns;
+    double load;
+    if (getloadavg(&load, 1) == 1) {
+      size_t busy_cpus = static_cast<size_t>(load + 0.5);
+      idle_cpus_ = (busy_cpus < num_cpus_) ? num_cpus_ - busy_cpus : 0u;
+    }
+  }
+  size_t pending = generic_queue_.size() +
+      baseline_queue_.size() +
+      optimized_requests_.size() +
+      osr_queue_.size();
+  size_t wanted = (pending + kPendingTasksPerWorker - 1u) / kPendingTasksPerWorker;
+  // Always keep one worker so that compilation makes progress on a loaded system.
+  max_active_workers_ = std::clamp<size_t>(std::min(wanted, idle_cpus_), 1u, num_threads);
+}
+
 Task* JitThreadPool::TryGetTaskLocked() {
   if (!started_) {
     return nullptr;
@@ -1851,24 +2339,70 @@ Task* JitThreadPool::TryGetTaskLocked() {
   Task* task = FetchFrom(osr_queue_, CompilationKind::kOsr);
   if (task == nullptr) {
     task = FetchFrom(baseline_queue_, CompilationKind::kBaseline);
-    if (task == nullptr) {
-      task = FetchFrom(optimized_queue_, CompilationKind::kOptimized);
+    if (task == nullptr &&
+        (optimized_paused_until_ns_ == 0u || NanoTime() >= optimized_paused_until_ns_)) {
+      optimized_paused_until_ns_ = 0u;
+      task = FetchOptimized();
     }
   }
   return task;
 }
 
+uint64_t JitThreadPool::PauseOptimizedCompilations(Thread* self, uint64_t until_ns) {
+  MutexLock mu(self, task_queue_lock_);
+  if (until_ns <= optimized_paused_until_ns_) {
+    return 0u;
+  }
+  uint64_t start_ns = std::max(optimized_paused_until_ns_, NanoTime());
+  optimized_paused_until_ns_ = until_ns;
+  return (until_ns > start_ns) ? until_ns - start_ns : 0u;
+}
+
+uint64_t JitThreadPool::GetDeferredTasksDelayNs() const {
+  if (optimized_paused_until_ns_ == 0u || optimized_requests_.empty()) {
+    return 0u;
+  }
+  // Once the pause is over, the next worker looking for a task fetches them.
+  uint64_t now_ns = NanoTime();
+  return (optimized_paused_until_ns_ > now_ns) ? optimized_paused_until_ns_ - now_ns : 0u;
+}
+
 Task* JitThreadPool::FetchFrom(std::deque<ArtMethod*>& methods, CompilationKind kind) {
   if (!methods.empty()) {
     ArtMethod* method = methods.front();
     methods.pop_front();
-    JitCompileTask* task = new JitCompileTask(method, JitCompileTask::TaskKind::kCompile, kind);
-    current_compilations_.insert(task);
-    return task;
+    return NewCompileTask(method, kind);
   }
   return nullptr;
 }
 
+Task* JitThreadPool::FetchOptimized() {
+  uint64_t now_ns = NanoTime();
+  while (!optimized_queue_.empty()) {
+    ArtMethod* method = optimized_queue_.front();
+    optimized_queue_.pop_front();
+    auto it = optimized_requests_.find(method);
+    if (it == optimized_requests_.end()) {
+      // Already fetched through its other entry.
+      continue;
+    }
+    bool is_stale = now_ns - it->second.last_request_ns > kOptimizedRequestStaleNs;
+    optimized_requests_.erase(it);
+    if (is_stale) {
+      optimized_enqueued_methods_.erase(method);
+      continue;
+    }
+    return NewCompileTask(method, CompilationKind::kOptimized);
+  }
+  return nullptr;
+}
+
+Task* JitThreadPool::NewCompileTask(ArtMethod* method, CompilationKind kind) {
+  JitCompileTask* task = new JitCompileTask(method, JitCompileTask::TaskKind::kCompile, kind);
+  current_compilations_.insert(task);
+  return task;
+}
+
 void JitThreadPool::Remove(JitCompileTask* task) {
   MutexLock mu(Thread::Current(), task_queue_lock_);
   current_compilations_.erase(task);
@@ -1911,7 +2445,9 @@ void JitThreadPool::VisitRoots(RootVisitor* visitor) {
     //   part of the boot classpath or system server classpath.
     methods.insert(methods.end(), osr_queue_.begin(), osr_queue_.end());
     methods.insert(methods.end(), baseline_queue_.begin(), baseline_queue_.end());
-    methods.insert(methods.end(), optimized_queue_.begin(), optimized_queue_.end());
+    for (const auto& entry : optimized_requests_) {
+      methods.push_back(entry.first);
+    }
     for (JitCompileTask* task : current_compilations_) {
       methods.push_back(task->GetArtMethod());
     }
@@ -17,6 +17,10 @@
 #ifndef ART_RUNTIME_JIT_JIT_H_
 #define ART_RUNTIME_JIT_JIT_H_
 
+#include <unistd.h>
+
+#include <algorithm>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <android-base/unique_fd.h>
@@ -24,6 +28,7 @@
 #include "base/histogram-inl.h"
 #include "base/macros.h"
 #include "base/mutex.h"
+#include "base/time_utils.h"
 #include "base/timing_logger.h"
 #include "compilation_kind.h"
 #include "handle.h"
@@ -31,6 +36,7 @@
 #include "interpreter/mterp/nterp.h"
 #include "jit/debugger_interface.h"
 #include "jit_options.h"
+#include "jit_pressure_controller.h"
 #include "obj_ptr.h"
 #include "thread_pool.h"
 
@@ -58,6 +64,7 @@ class JitCodeCache;
 class JitCompileTask;
 class JitMemoryRegion;
 class JitOptions;
+class JitProfileTask;
 
 static constexpr int16_t kJitCheckForOSR = -1;
 static constexpr int16_t kJitHotnessDisabled = -2;
@@ -137,6 +144,13 @@ class JitThreadPool : public AbstractThreadPool {
   // Visit the ArtMethods stored in the various queues.
   void VisitRoots(RootVisitor* visitor);
 
+  // Create `num_threads` worker threads, e.g. after they were deleted for a zygote fork.
+  void CreateThreads(size_t num_threads) REQUIRES(!task_queue_lock_);
+
+  // Do not start optimized compilations before `until_ns`. OSR and baseline compilations are not
+  // affected. Returns by how long this extended the current pause.
+  uint64_t PauseOptimizedCompilations(Thread* self, uint64_t until_ns) REQUIRES(!task_queue_lock_);
+
  protected:
   Task* TryGetTaskLocked() REQUIRES(task_queue_lock_) override;
 
@@ -144,25 +158,65 @@ class JitThreadPool : public AbstractThreadPool {
     return started_ &&
         (!generic_queue_.empty() ||
          !baseline_queue_.empty() ||
-         !optimized_queue_.empty() ||
+         !optimized_requests_.empty() ||
          !osr_queue_.empty());
   }
 
+  uint64_t GetDeferredTasksDelayNs() const REQUIRES(task_queue_lock_) override;
+
  private:
   JitThreadPool(const char* name,
                 size_t num_threads,
                 size_t worker_stack_size)
       // We need peers as we may report the JIT thread, e.g., in the debugger.
-      : AbstractThreadPool(name, num_threads, /* create_peers= */ true, worker_stack_size) {}
+      : AbstractThreadPool(name, num_threads, /* create_peers= */ true, worker_stack_size),
+        num_cpus_(std::max<long>(sysconf(_SC_NPROCESSORS_ONLN), 1)),
+        idle_cpus_(num_cpus_),
+        last_load_sample_ns_(0u) {}
+
+  using AbstractThreadPool::CreateThreads;
+
+  // Adjust the number of active workers to the number of pending compilations and to the
+  // number of idle CPUs.
+  void UpdateActiveWorkersLocked() REQUIRES(task_queue_lock_);
+
+  // A pending optimized compilation. Requests for a method already in the queue are merged,
+  // so that `requests` tells how often the baseline code of the method ran out of hotness
+  // while waiting. A method requested again is also moved ahead, see AddTask().
+  struct OptimizedRequest {
+    uint32_t requests;
+    uint64_t last_request_ns;
+  };
+
+  // Number of pending compilations that justify waking up another worker.
+  static constexpr size_t kPendingTasksPerWorker = 4;
+  // How often we read the system load average.
+  static constexpr uint64_t kLoadSamplePeriodNs = MsToNs(1000);
+
+  // Requests that have not been repeated for this long are dropped. The method will be requested
+  // again if it gets hot again.
+  static constexpr uint64_t kOptimizedRequestStaleNs = MsToNs(10000);
 
   // Try to fetch an entry from `methods`. Return null if `methods` is empty.
   Task* FetchFrom(std::deque<ArtMethod*>& methods, CompilationKind kind) REQUIRES(task_queue_lock_);
 
+  // Fetch the first entry of `optimized_queue_` that is still pending, dropping stale ones.
+  // Return null if there is none left. Each entry is popped once, so this is amortized O(1).
+  Task* FetchOptimized() REQUIRES(task_queue_lock_);
+
+  Task* NewCompileTask(ArtMethod* method, CompilationKind kind) REQUIRES(task_queue_lock_);
+
   std::deque<Task*> generic_queue_ GUARDED_BY(task_queue_lock_);
 
   std::deque<ArtMethod*> osr_queue_ GUARDED_BY(task_queue_lock_);
   std::deque<ArtMethod*> baseline_queue_ GUARDED_BY(task_queue_lock_);
+  // Pending optimized compilations in the order to compile them. A method may appear twice, see
+  // AddTask(); entries for methods no longer in `optimized_requests_` are skipped.
   std::deque<ArtMethod*> optimized_queue_ GUARDED_BY(task_queue_lock_);
+  std::unordered_map<ArtMethod*, OptimizedRequest> optimized_requests_
+      GUARDED_BY(task_queue_lock_);
+  // Optimized compilations are paused until then to stay within the JIT compilation budget.
+  uint64_t optimized_paused_until_ns_ GUARDED_BY(task_queue_lock_) = 0u;
 
   // We track the methods that are currently enqueued to avoid
   // adding them to the queue multiple times, which could bloat the
@@ -175,6 +229,11 @@ class JitThreadPool : public AbstractThreadPool {
   // will be removed when JitCompileTask->Finalize is called.
   std::unordered_set<JitCompileTask*> current_compilations_ GUARDED_BY(task_queue_lock_);
 
+  const size_t num_cpus_;
+  // Number of CPUs not used according to the last load average sample.
+  size_t idle_cpus_ GUARDED_BY(task_queue_lock_);
+  uint64_t last_load_sample_ns_ GUARDED_BY(task_queue_lock_);
+
   DISALLOW_COPY_AND_ASSIGN(JitThreadPool);
 };
 
@@ -183,6 +242,11 @@ class Jit {
   // How frequently should the interpreter check to see if OSR compilation is ready.
   static constexpr int16_t kJitRecheckOSRThreshold = 101;  // Prime number to avoid patterns.
 
+  // Upper bound of the arena memory kept populated between compilations.
+  static constexpr size_t kMaxRetainedArenaBytes = 16 * MB;
+  // Every time the JIT goes idle, the arena high-water mark loses this fraction of its value.
+  static constexpr size_t kArenaHighWaterMarkDecay = 4;
+
   virtual ~Jit();
 
   // Create JIT itself.
@@ -208,12 +272,12 @@ class Jit {
   }
 
   void CreateThreadPool();
-  void DeleteThreadPool();
+  void DeleteThreadPool() REQUIRES(!application_profile_lock_);
   void WaitForWorkersToBeCreated();
 
   // Dump interesting info: #methods compiled, code vs data size, compile / verify cumulative
   // loggers.
-  void DumpInfo(std::ostream& os) REQUIRES(!lock_);
+  void DumpInfo(std::ostream& os) REQUIRES(!lock_, !pressure_lock_);
   // Add a timing logger to cumulative_timings_.
   void AddTimingLogger(const TimingLogger& logger);
 
@@ -221,6 +285,17 @@ class Jit {
       REQUIRES(!lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Keep the breakdown by allocation kind of the compilation that used the most arena memory,
+  // for DumpInfo(). Only called when arena allocations are counted.
+  void AddArenaAllocationStats(ArtMethod* method, size_t bytes, std::string&& stats)
+      REQUIRES(!lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Called when there is no compilation left to do. Release the free memory of the JIT arena
+  // pool, except for what recent compilations needed so that the next ones do not fault it in
+  // again.
+  void TrimArenaPool(Thread* self) REQUIRES(!lock_);
+
   int GetThreadPoolPthreadPriority() const {
     return options_->GetThreadPoolPthreadPriority();
   }
@@ -258,7 +333,7 @@ class Jit {
   void MethodEntered(Thread* thread, ArtMethod* method)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
-  ALWAYS_INLINE void AddSamples(Thread* self, ArtMethod* method)
+  ALWAYS_INLINE void AddSamples(Thread* self, ArtMethod* method, bool from_loop = false)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
   void NotifyInterpreterToCompiledCodeTransition(Thread* self, ArtMethod* caller)
@@ -283,7 +358,7 @@ class Jit {
                          const std::string& ref_profile_filename);
   void StopProfileSaver();
 
-  void DumpForSigQuit(std::ostream& os) REQUIRES(!lock_);
+  void DumpForSigQuit(std::ostream& os) REQUIRES(!lock_, !pressure_lock_);
 
   static void NewTypeLoadedIfUsingJit(mirror::Class* type)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -362,6 +437,25 @@ class Jit {
                                          Handle<mirror::ClassLoader> class_loader,
                                          bool add_to_queue);
 
+  // Resolve the classes of the given profile, and the methods flagged as startup methods
+  // along with the strings, types and methods their code refers to, so that they are in the
+  // dex caches when the application first needs them.
+  // Return the number of startup methods processed.
+  uint32_t PrefillDexCachesFromProfile(Thread* self,
+                                       const std::vector<const DexFile*>& dex_files,
+                                       const std::string& profile_path,
+                                       Handle<mirror::ClassLoader> class_loader)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Initialize the verified classes of the given profile that only need trivial class
+  // initializers, so that the application does not run them on its startup path.
+  // Return the number of classes initialized.
+  uint32_t InitializeClassesFromProfile(Thread* self,
+                                        const std::vector<const DexFile*>& dex_files,
+                                        const std::string& profile_path,
+                                        Handle<mirror::ClassLoader> class_loader)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   // Register the dex files to the JIT. This is to perform any compilation/optimization
   // at the point of loading the dex files.
   void RegisterDexFiles(const std::vector<std::unique_ptr<const DexFile>>& dex_files,
@@ -387,12 +481,22 @@ class Jit {
 
   EXPORT void EnqueueOptimizedCompilation(ArtMethod* method, Thread* self);
 
-  EXPORT void MaybeEnqueueCompilation(ArtMethod* method, Thread* self)
+  // `from_loop` tells whether the method got hot on a loop back edge.
+  EXPORT void MaybeEnqueueCompilation(ArtMethod* method, Thread* self, bool from_loop = false)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
   EXPORT static bool TryPatternMatch(ArtMethod* method, CompilationKind compilation_kind)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Pause optimized compilations if compilation went over the time budget of the current JIT
+  // pressure level. Called by the JIT workers between compilations.
+  void MaybeThrottleCompilation(Thread* self) REQUIRES(!pressure_lock_);
+
+  // Lock-free, the pressure controller publishes its level atomically.
+  JitPressure GetPressure() const NO_THREAD_SAFETY_ANALYSIS {
+    return pressure_controller_.GetPressure();
+  }
+
  private:
   Jit(JitCodeCache* code_cache, JitOptions* options);
 
@@ -411,6 +515,14 @@ class Jit {
                                 bool compile_after_boot)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Resolve an individual startup method listed in a profile and what its code refers to.
+  void PrefillDexCacheForMethod(Thread* self,
+                                ClassLinker* linker,
+                                uint32_t method_idx,
+                                Handle<mirror::DexCache> dex_cache,
+                                Handle<mirror::ClassLoader> class_loader)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   static bool BindCompilerMethods(std::string* error_msg);
 
   void AddCompileTask(Thread* self,
@@ -421,7 +533,18 @@ class Jit {
                              Thread* self,
                              CompilationKind compilation_kind,
                              bool prejit)
-      REQUIRES_SHARED(Locks::mutator_lock_);
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!pressure_lock_);
+
+  // Feed the pressure controller with a compilation that took `compile_ns`.
+  void RecordCompilationPressure(Thread* self, uint64_t compile_ns) REQUIRES(!pressure_lock_);
+
+  // Schedule the compilation of the pending application profile tasks whose dex files are in
+  // `code_paths`, and drop the others.
+  void StartApplicationProfileTasks(const std::string& profile_filename,
+                                    const std::vector<std::string>& code_paths)
+      REQUIRES(!application_profile_lock_);
+  void DeletePendingApplicationProfileTasks() REQUIRES(!application_profile_lock_);
 
   // JIT compiler
   EXPORT static JitCompilerInterface* jit_compiler_;
@@ -437,11 +560,35 @@ class Jit {
   bool boot_completed_ GUARDED_BY(boot_completed_lock_) = false;
   std::deque<Task*> tasks_after_boot_ GUARDED_BY(boot_completed_lock_);
 
+  // With profiled JIT compilation, the dex files registered before the profile saver is started
+  // are compiled from the saved application profile once its location is known.
+  Mutex application_profile_lock_;
+  bool application_profile_known_ GUARDED_BY(application_profile_lock_) = false;
+  std::vector<JitProfileTask*> pending_application_profile_tasks_
+      GUARDED_BY(application_profile_lock_);
+
   // Performance monitoring.
   CumulativeLogger cumulative_timings_;
   Histogram<uint64_t> memory_use_ GUARDED_BY(lock_);
+  // Arena memory used by the largest recent compilation, decayed by `TrimArenaPool()`.
+  size_t arena_high_water_mark_ GUARDED_BY(lock_) = 0u;
+  size_t largest_arena_allocation_ GUARDED_BY(lock_) = 0u;
+  std::string largest_arena_allocation_stats_ GUARDED_BY(lock_);
   Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
 
+  // On stack replacement statistics, updated by the interpreters.
+  Atomic<uint64_t> number_of_osr_entries_{0u};
+  // The method had no OSR code yet.
+  Atomic<uint64_t> number_of_osr_misses_no_code_{0u};
+  // The OSR code had no entry at the dex pc of the back edge.
+  Atomic<uint64_t> number_of_osr_misses_no_stack_map_{0u};
+  // The frame could not be replaced, e.g. close to the stack limit or while debugging.
+  Atomic<uint64_t> number_of_osr_rejections_{0u};
+
+  // Adapts how eagerly we compile to the code cache pressure.
+  Mutex pressure_lock_;
+  JitPressureController pressure_controller_ GUARDED_BY(pressure_lock_);
+
   // In the JIT zygote configuration, after all compilation is done, the zygote
   // will copy its contents of the boot image to the zygote_mapping_methods_,
   // which will be picked up by processes that will map the memory
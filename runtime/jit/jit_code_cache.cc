@@ -269,6 +269,7 @@ JitCodeCache::JitCodeCache()
       number_of_optimized_compilations_(0),
       number_of_osr_compilations_(0),
       number_of_collections_(0),
+      number_of_recompilations_(0),
       histogram_stack_map_memory_use_("Memory used for stack maps", 16),
       histogram_code_memory_use_("Memory used for compiled code", 16),
       histogram_profiling_info_memory_use_("Memory used for profiling info", 16) {
@@ -587,12 +588,20 @@ void JitCodeCache::RemoveMethodsIn(Thread* self, const LinearAlloc& alloc) {
         ++it;
       }
     }
+    UpdateMethodCodeTableLocked();
+    for (auto it = collected_methods_.begin(); it != collected_methods_.end();) {
+      if (alloc.ContainsUnsafe(*it)) {
+        it = collected_methods_.erase(it);
+      } else {
+        ++it;
+      }
+    }
     for (auto it = osr_code_map_.begin(); it != osr_code_map_.end();) {
       DCHECK(!ContainsElement(zombie_code_, it->second));
       if (alloc.ContainsUnsafe(it->first)) {
         // Note that the code has already been pushed to method_headers in the loop
         // above and is going to be removed in FreeCode() below.
-        it = osr_code_map_.erase(it);
+        it = EraseOsrCodeLocked(it);
       } else {
         ++it;
       }
@@ -730,6 +739,10 @@ bool JitCodeCache::Commit(Thread* self,
         number_of_optimized_compilations_++;
         break;
     }
+    if (compilation_kind != CompilationKind::kOsr && collected_methods_.erase(method) != 0u) {
+      number_of_recompilations_++;
+      Runtime::Current()->GetMetrics()->JitRecompilationCount()->AddOne();
+    }
 
     // We need to update the debug info before the entry point gets set.
     // At the same time we want to do under JIT lock so that debug info and JIT maps are in sync.
@@ -789,6 +802,8 @@ bool JitCodeCache::Commit(Thread* self,
         ScopedDebugDisallowReadBarriers sddrb(self);
         WriterMutexLock mu2(self, *Locks::jit_mutator_lock_);
         method_code_map_.Put(code_ptr, method);
+        // Publish before the entry point is updated, so that any frame of the new code finds it.
+        method_code_table_.Add({code_ptr, method});
 
         // Searching for MethodType-s in roots. They need to be treated as strongly reachable while
         // the corresponding ArtMethod is not removed.
@@ -812,7 +827,7 @@ bool JitCodeCache::Commit(Thread* self,
       if (compilation_kind == CompilationKind::kOsr) {
         ScopedDebugDisallowReadBarriers sddrb(self);
         WriterMutexLock mu2(self, *Locks::jit_mutator_lock_);
-        osr_code_map_.Put(method, code_ptr);
+        PutOsrCodeLocked(method, code_ptr);
       } else if (method->StillNeedsClinitCheck()) {
         ScopedDebugDisallowReadBarriers sddrb(self);
         // This situation currently only occurs in the jit-zygote mode.
@@ -910,10 +925,13 @@ bool JitCodeCache::RemoveMethodLocked(ArtMethod* method, bool release_memory) {
       }
     }
     method_code_map_reversed_.erase(method);
+    if (in_cache) {
+      UpdateMethodCodeTableLocked();
+    }
 
     auto osr_it = osr_code_map_.find(method);
     if (osr_it != osr_code_map_.end()) {
-      osr_code_map_.erase(osr_it);
+      EraseOsrCodeLocked(osr_it);
     }
   }
 
@@ -955,11 +973,13 @@ void JitCodeCache::MoveObsoleteMethod(ArtMethod* old_method, ArtMethod* new_meth
       it.second = new_method;
     }
   }
+  UpdateMethodCodeTableLocked();
   // Update osr_code_map_ to point to the new method.
   auto code_map = osr_code_map_.find(old_method);
   if (code_map != osr_code_map_.end()) {
-    osr_code_map_.Put(new_method, code_map->second);
-    osr_code_map_.erase(old_method);
+    const void* code_ptr = code_map->second;
+    EraseOsrCodeLocked(code_map);
+    PutOsrCodeLocked(new_method, code_ptr);
   }
 
   auto node = method_code_map_reversed_.extract(old_method);
@@ -1019,6 +1039,7 @@ bool JitCodeCache::Reserve(Thread* self,
                            size_t stack_map_size,
                            size_t number_of_roots,
                            ArtMethod* method,
+                           CompilationKind compilation_kind,
                            /*out*/ArrayRef<const uint8_t>* reserved_code,
                            /*out*/ArrayRef<const uint8_t>* reserved_data) {
   code_size = OatQuickMethodHeader::InstructionAlignedSize() + code_size;
@@ -1032,7 +1053,9 @@ bool JitCodeCache::Reserve(Thread* self,
       ScopedThreadSuspension sts(self, ThreadState::kSuspended);
       MutexLock mu(self, *Locks::jit_lock_);
       ScopedCodeCacheWrite ccw(*region);
-      code = region->AllocateCode(code_size);
+      // Optimized code is what runs in steady state, keep it together.
+      code = region->AllocateCode(code_size,
+                                  /*is_hot=*/ compilation_kind == CompilationKind::kOptimized);
       data = region->AllocateData(data_size);
       at_max_capacity = IsAtMaxCapacity();
     }
@@ -1143,6 +1166,16 @@ bool JitCodeCache::IsAtMaxCapacity() const {
   return private_region_.GetCurrentCapacity() == private_region_.GetMaxCapacity();
 }
 
+void JitCodeCache::GetPressureInfo(Thread* self,
+                                   /*out*/ size_t* used_memory,
+                                   /*out*/ size_t* max_capacity,
+                                   /*out*/ size_t* recompilations) {
+  MutexLock mu(self, *Locks::jit_lock_);
+  *used_memory = private_region_.GetUsedMemoryForCode() + private_region_.GetUsedMemoryForData();
+  *max_capacity = private_region_.GetMaxCapacity();
+  *recompilations = number_of_recompilations_;
+}
+
 void JitCodeCache::IncreaseCodeCacheCapacity(Thread* self) {
   ScopedThreadSuspension sts(self, ThreadState::kSuspended);
   MutexLock mu(self, *Locks::jit_lock_);
@@ -1181,6 +1214,8 @@ void JitCodeCache::RemoveUnmarkedCode(Thread* self) {
 
             if (code_ptrs.empty()) {
               method_code_map_reversed_.erase(code_ptrs_it);
+              // Compiling the method again means the collection did not pay off.
+              collected_methods_.insert(method);
             }
           }
         }
@@ -1191,6 +1226,12 @@ void JitCodeCache::RemoveUnmarkedCode(Thread* self) {
       it = processed_zombie_code_.erase(it);
     }
   }
+  if (!method_headers.empty()) {
+    // Frames can only be in marked code, so lookups do not need the removed entries to be gone
+    // before the table is published again.
+    WriterMutexLock mu2(self, *Locks::jit_mutator_lock_);
+    UpdateMethodCodeTableLocked();
+  }
   for (auto it = processed_zombie_jni_code_.begin(); it != processed_zombie_jni_code_.end();) {
     WriterMutexLock mu2(self, *Locks::jit_mutator_lock_);
     ArtMethod* method = *it;
@@ -1314,6 +1355,23 @@ void JitCodeCache::MaybeUpdateInlineCache(ArtMethod* method,
   info->AddInvokeInfo(dex_pc, cls.Ptr());
 }
 
+void JitCodeCache::RecordDeoptimization(ArtMethod* method,
+                                        DeoptimizationKind kind,
+                                        Thread* self) {
+  Runtime::Current()->GetMetrics()->JitDeoptimizationCount()->AddOne();
+  ScopedDebugDisallowReadBarriers sddrb(self);
+  MutexLock mu(self, *Locks::jit_lock_);
+  auto it = profiling_infos_.find(method);
+  if (it == profiling_infos_.end()) {
+    return;
+  }
+  if (it->second->RecordDeoptimization(kind)) {
+    VLOG(jit) << "Disabling speculation for " << GetDeoptimizationKindName(kind)
+              << " in " << method->PrettyMethod() << " after repeated deoptimizations";
+    Runtime::Current()->GetMetrics()->JitSpeculationDisabledCount()->AddOne();
+  }
+}
+
 void JitCodeCache::DoCollection(Thread* self) {
   ScopedTrace trace(__FUNCTION__);
 
@@ -1327,6 +1385,8 @@ void JitCodeCache::DoCollection(Thread* self) {
     }
     collection_in_progress_ = true;
     number_of_collections_++;
+    // Only count methods compiled again since the last collection.
+    collected_methods_.clear();
     live_bitmap_.reset(CodeCacheBitmap::Create(
           "code-cache-bitmap",
           reinterpret_cast<uintptr_t>(private_region_.GetExecPages()->Begin()),
@@ -1343,7 +1403,7 @@ void JitCodeCache::DoCollection(Thread* self) {
       for (auto it = osr_code_map_.begin(); it != osr_code_map_.end(); ++it) {
         processed_zombie_code_.insert(it->second);
       }
-      osr_code_map_.clear();
+      ClearOsrCodeLocked();
     }
   }
   TimingLogger logger("JIT code cache timing logger", true, VLOG_IS_ON(jit));
@@ -1369,6 +1429,11 @@ void JitCodeCache::DoCollection(Thread* self) {
   Runtime::Current()->GetJit()->AddTimingLogger(logger);
 }
 
+void JitCodeCache::UpdateMethodCodeTableLocked() {
+  std::vector<CodeLookupTable::Entry> entries(method_code_map_.begin(), method_code_map_.end());
+  method_code_table_.Publish(std::move(entries));
+}
+
 OatQuickMethodHeader* JitCodeCache::LookupMethodHeader(uintptr_t pc, ArtMethod* method) {
   static_assert(kRuntimeISA != InstructionSet::kThumb2, "kThumb2 cannot be a runtime ISA");
   const void* pc_ptr = reinterpret_cast<const void*>(pc);
@@ -1411,17 +1476,13 @@ OatQuickMethodHeader* JitCodeCache::LookupMethodHeader(uintptr_t pc, ArtMethod*
       }
     }
     {
-      ReaderMutexLock mu(self, *Locks::jit_mutator_lock_);
-      auto it = method_code_map_.lower_bound(pc_ptr);
-      if ((it == method_code_map_.end() || it->first != pc_ptr) &&
-          it != method_code_map_.begin()) {
-        --it;
-      }
-      if (it != method_code_map_.end()) {
-        const void* code_ptr = it->first;
+      // Stack walks come here for every JIT frame, use the lock-free copy of `method_code_map_`.
+      CodeLookupTable::Entry entry;
+      if (method_code_table_.Lookup(pc_ptr, reinterpret_cast<uintptr_t>(self), &entry)) {
+        const void* code_ptr = entry.first;
         if (OatQuickMethodHeader::FromCodePointer(code_ptr)->Contains(pc)) {
           method_header = OatQuickMethodHeader::FromCodePointer(code_ptr);
-          found_method = it->second;
+          found_method = entry.second;
         }
       }
     }
@@ -1451,6 +1512,29 @@ OatQuickMethodHeader* JitCodeCache::LookupMethodHeader(uintptr_t pc, ArtMethod*
   return method_header;
 }
 
+void JitCodeCache::PutOsrCodeLocked(ArtMethod* method, const void* code_ptr) {
+  if (osr_code_map_.find(method) == osr_code_map_.end()) {
+    std::atomic<uint32_t>& count = osr_code_filter_[OsrCodeFilterIndex(method)];
+    count.store(count.load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+  }
+  osr_code_map_.Put(method, code_ptr);
+}
+
+SafeMap<ArtMethod*, const void*>::iterator JitCodeCache::EraseOsrCodeLocked(
+    SafeMap<ArtMethod*, const void*>::iterator it) {
+  std::atomic<uint32_t>& count = osr_code_filter_[OsrCodeFilterIndex(it->first)];
+  DCHECK_NE(count.load(std::memory_order_relaxed), 0u);
+  count.store(count.load(std::memory_order_relaxed) - 1u, std::memory_order_relaxed);
+  return osr_code_map_.erase(it);
+}
+
+void JitCodeCache::ClearOsrCodeLocked() {
+  osr_code_map_.clear();
+  for (std::atomic<uint32_t>& count : osr_code_filter_) {
+    count.store(0u, std::memory_order_relaxed);
+  }
+}
+
 OatQuickMethodHeader* JitCodeCache::LookupOsrMethodHeader(ArtMethod* method) {
   Thread* self = Thread::Current();
   ScopedDebugDisallowReadBarriers sddrb(self);
@@ -1783,7 +1867,7 @@ void JitCodeCache::InvalidateAllCompiledCode() {
         instr->InitializeMethodsCode(meth, /*aot_code=*/ nullptr);
       }
     }
-    osr_code_map_.clear();
+    ClearOsrCodeLocked();
     saved_compiled_methods_map_.clear();
   }
 
@@ -1815,7 +1899,7 @@ void JitCodeCache::InvalidateCompiledCodeFor(ArtMethod* method,
     auto it = osr_code_map_.find(method);
     if (it != osr_code_map_.end() && OatQuickMethodHeader::FromCodePointer(it->second) == header) {
       // Remove the OSR method, to avoid using it again.
-      osr_code_map_.erase(it);
+      EraseOsrCodeLocked(it);
     }
   }
 
@@ -1851,7 +1935,9 @@ void JitCodeCache::Dump(std::ostream& os) {
      << "Total number of JIT optimized compilations: " << number_of_optimized_compilations_ << "\n"
      << "Total number of JIT compilations for on stack replacement: "
         << number_of_osr_compilations_ << "\n"
-     << "Total number of JIT code cache collections: " << number_of_collections_ << std::endl;
+     << "Total number of JIT code cache collections: " << number_of_collections_ << "\n"
+     << "Total number of JIT compilations of collected methods: "
+        << number_of_recompilations_ << std::endl;
   histogram_stack_map_memory_use_.PrintMemoryUse(os);
   histogram_code_memory_use_.PrintMemoryUse(os);
   histogram_profiling_info_memory_use_.PrintMemoryUse(os);
@@ -1910,6 +1996,8 @@ void JitCodeCache::PostForkChildAction(bool is_system_server, bool is_zygote) {
   number_of_optimized_compilations_ = 0;
   number_of_osr_compilations_ = 0;
   number_of_collections_ = 0;
+  number_of_recompilations_ = 0;
+  collected_methods_.clear();
   histogram_stack_map_memory_use_.Reset();
   histogram_code_memory_use_.Reset();
   histogram_profiling_info_memory_use_.Reset();
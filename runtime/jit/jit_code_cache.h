@@ -17,6 +17,8 @@
 #ifndef ART_RUNTIME_JIT_JIT_CODE_CACHE_H_
 #define ART_RUNTIME_JIT_JIT_CODE_CACHE_H_
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <iosfwd>
 #include <memory>
@@ -34,6 +36,7 @@
 #include "base/mem_map.h"
 #include "base/mutex.h"
 #include "base/safe_map.h"
+#include "code_lookup_table.h"
 #include "compilation_kind.h"
 #include "jit_memory_region.h"
 #include "profiling_info.h"
@@ -254,6 +257,7 @@ class JitCodeCache {
                size_t stack_map_size,
                size_t number_of_roots,
                ArtMethod* method,
+               CompilationKind compilation_kind,
                /*out*/ArrayRef<const uint8_t>* reserved_code,
                /*out*/ArrayRef<const uint8_t>* reserved_data)
       REQUIRES_SHARED(Locks::mutator_lock_)
@@ -303,6 +307,12 @@ class JitCodeCache {
       REQUIRES(!Locks::jit_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Lock-free check done by the interpreters on back edges before `LookupOsrMethodHeader()`.
+  // Returns false if `method` has no OSR code. May return true for a method without OSR code.
+  bool MayHaveOsrCode(ArtMethod* method) const {
+    return osr_code_filter_[OsrCodeFilterIndex(method)].load(std::memory_order_relaxed) != 0u;
+  }
+
   // Removes method from the cache for testing purposes. The caller
   // must ensure that all threads are suspended and the method should
   // not be in any thread's stack.
@@ -351,6 +361,14 @@ class JitCodeCache {
       REQUIRES_SHARED(Locks::mutator_lock_);
 
   void Dump(std::ostream& os) REQUIRES(!Locks::jit_lock_);
+
+  // Return what the JIT pressure controller needs to know about the code cache: how much of the
+  // private region is used, its maximum capacity and how many collected methods got compiled
+  // again.
+  void GetPressureInfo(Thread* self,
+                       /*out*/ size_t* used_memory,
+                       /*out*/ size_t* max_capacity,
+                       /*out*/ size_t* recompilations) REQUIRES(!Locks::jit_lock_);
   void DumpAllCompiledMethods(std::ostream& os)
       REQUIRES(!Locks::jit_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -426,6 +444,11 @@ class JitCodeCache {
                               Thread* self)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Record that the compiled code of `method` deoptimized for `kind`, so that we stop
+  // speculating for `kind` in `method` when it deoptimizes too often.
+  void RecordDeoptimization(ArtMethod* method, DeoptimizationKind kind, Thread* self)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   // NO_THREAD_SAFETY_ANALYSIS because we may be called with the JIT lock held
   // or not. The implementation of this method handles the two cases.
   void AddZombieCode(ArtMethod* method, const void* code_ptr) NO_THREAD_SAFETY_ANALYSIS;
@@ -486,6 +509,21 @@ class JitCodeCache {
   // Return whether the code cache's capacity is at its maximum.
   bool IsAtMaxCapacity() const REQUIRES(Locks::jit_lock_);
 
+  // Publish the current content of `method_code_map_` to `method_code_table_`.
+  void UpdateMethodCodeTableLocked() REQUIRES(Locks::jit_mutator_lock_);
+
+  // Update `osr_code_map_` and `osr_code_filter_` together.
+  void PutOsrCodeLocked(ArtMethod* method, const void* code_ptr)
+      REQUIRES(Locks::jit_mutator_lock_);
+  SafeMap<ArtMethod*, const void*>::iterator EraseOsrCodeLocked(
+      SafeMap<ArtMethod*, const void*>::iterator it) REQUIRES(Locks::jit_mutator_lock_);
+  void ClearOsrCodeLocked() REQUIRES(Locks::jit_mutator_lock_);
+
+  static size_t OsrCodeFilterIndex(ArtMethod* method) {
+    // ArtMethods are at least 16 bytes apart, ignore the low bits.
+    return (reinterpret_cast<uintptr_t>(method) >> 4) % kOsrCodeFilterSize;
+  }
+
   void RemoveUnmarkedCode(Thread* self)
       REQUIRES(!Locks::jit_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -553,6 +591,10 @@ class JitCodeCache {
 
   // Holds compiled code associated to the ArtMethod.
   SafeMap<const void*, ArtMethod*> method_code_map_ GUARDED_BY(Locks::jit_mutator_lock_);
+  // Copy of `method_code_map_` for looking up methods by pc without taking a lock. New code is
+  // added to it on commit, other changes of `method_code_map_` republish it with
+  // `UpdateMethodCodeTableLocked()`.
+  CodeLookupTable method_code_table_;
   // Subset of `method_code_map_`, but keyed by `ArtMethod*`. Used to treat certain
   // objects (like `MethodType`-s) as strongly reachable from the corresponding ArtMethod.
   SafeMap<ArtMethod*, std::vector<const void*>> method_code_map_reversed_
@@ -565,6 +607,11 @@ class JitCodeCache {
   // Holds osr compiled code associated to the ArtMethod.
   SafeMap<ArtMethod*, const void*> osr_code_map_ GUARDED_BY(Locks::jit_mutator_lock_);
 
+  // Number of `osr_code_map_` entries per hash of the method, written with
+  // `jit_mutator_lock_` held and read without it by `MayHaveOsrCode()`.
+  static constexpr size_t kOsrCodeFilterSize = 256u;
+  std::array<std::atomic<uint32_t>, kOsrCodeFilterSize> osr_code_filter_ = {};
+
   // Zombie code and JNI methods to consider for collection.
   std::set<const void*> zombie_code_ GUARDED_BY(Locks::jit_mutator_lock_);
   std::set<ArtMethod*> zombie_jni_code_ GUARDED_BY(Locks::jit_mutator_lock_);
@@ -612,6 +659,13 @@ class JitCodeCache {
   // Number of code cache collections done throughout the lifetime of the JIT.
   size_t number_of_collections_ GUARDED_BY(Locks::jit_lock_);
 
+  // Number of compilations of methods whose code was removed by the last collection.
+  size_t number_of_recompilations_ GUARDED_BY(Locks::jit_lock_);
+
+  // Methods which lost all their compiled code in the last collection. Only used for
+  // lookups, the methods are never accessed.
+  std::unordered_set<ArtMethod*> collected_methods_ GUARDED_BY(Locks::jit_lock_);
+
   // Histograms for keeping track of stack map size statistics.
   Histogram<uint64_t> histogram_stack_map_memory_use_ GUARDED_BY(Locks::jit_lock_);
 
@@ -302,10 +302,20 @@ bool JitMemoryRegion::Initialize(size_t initial_capacity,
   return true;
 }
 
+size_t JitMemoryRegion::ComputeHotCodeChunkSize(size_t code_capacity) {
+  if (code_capacity < kMinHotCodeChunkSize * kHotCodeChunkCapacityDivider) {
+    return 0u;
+  }
+  return std::min(TruncToPowerOfTwo(code_capacity / kHotCodeChunkCapacityDivider),
+                  kMaxHotCodeChunkSize);
+}
+
 void JitMemoryRegion::SetFootprintLimit(size_t new_footprint) {
   size_t data_space_footprint = new_footprint / kCodeAndDataCapacityDivider;
   DCHECK(IsAlignedParam(data_space_footprint, gPageSize));
   DCHECK_EQ(data_space_footprint * kCodeAndDataCapacityDivider, new_footprint);
+  hot_code_chunk_size_ = ComputeHotCodeChunkSize(new_footprint - data_space_footprint);
+  hot_code_chunk_allocation_failed_ = false;
   if (HasCodeMapping()) {
     ScopedCodeCacheWrite scc(*this);
     mspace_set_footprint_limit(exec_mspace_, new_footprint - data_space_footprint);
@@ -463,7 +473,14 @@ bool JitMemoryRegion::CommitData(ArrayRef<const uint8_t> reserved_data,
   return true;
 }
 
-const uint8_t* JitMemoryRegion::AllocateCode(size_t size) {
+const uint8_t* JitMemoryRegion::AllocateCode(size_t size, bool is_hot) {
+  if (is_hot && size <= hot_code_chunk_size_ / kHotCodeChunkSizeToMaxCodeSize) {
+    const uint8_t* result = AllocateHotCode(size);
+    if (result != nullptr) {
+      return result;
+    }
+    // Fall back to the mspace, it may still have room for a smaller block.
+  }
   size_t alignment = GetInstructionSetCodeAlignment(kRuntimeISA);
   void* result = mspace_memalign(exec_mspace_, alignment, size);
   if (UNLIKELY(result == nullptr)) {
@@ -473,10 +490,70 @@ const uint8_t* JitMemoryRegion::AllocateCode(size_t size) {
   return reinterpret_cast<uint8_t*>(GetExecutableAddress(result));
 }
 
+const uint8_t* JitMemoryRegion::AllocateHotCode(size_t size) {
+  size_t alignment = GetInstructionSetCodeAlignment(kRuntimeISA);
+  HotCodeChunk* chunk = nullptr;
+  if (current_hot_code_chunk_ != nullptr) {
+    chunk = &hot_code_chunks_.find(current_hot_code_chunk_)->second;
+    if (RoundUp(chunk->used, alignment) + size > chunk->size) {
+      chunk = nullptr;
+    }
+  }
+  if (chunk == nullptr) {
+    if (hot_code_chunk_allocation_failed_) {
+      // Do not look for a chunk again for every hot method until code is freed or the
+      // capacity increases.
+      return nullptr;
+    }
+    void* memory = mspace_memalign(exec_mspace_, alignment, hot_code_chunk_size_);
+    if (memory == nullptr) {
+      hot_code_chunk_allocation_failed_ = true;
+      return nullptr;
+    }
+    used_memory_for_code_ += mspace_usable_size(memory);
+    current_hot_code_chunk_ = reinterpret_cast<const uint8_t*>(memory);
+    chunk = &hot_code_chunks_.emplace(
+        current_hot_code_chunk_, HotCodeChunk{hot_code_chunk_size_, 0u, 0u}).first->second;
+  }
+  size_t offset = RoundUp(chunk->used, alignment);
+  chunk->used = offset + size;
+  ++chunk->live_allocations;
+  return GetExecutableAddress(current_hot_code_chunk_ + offset);
+}
+
+bool JitMemoryRegion::FreeHotCode(const uint8_t* code) {
+  auto it = hot_code_chunks_.upper_bound(code);
+  if (it == hot_code_chunks_.begin()) {
+    return false;
+  }
+  --it;
+  if (code >= it->first + it->second.size) {
+    return false;
+  }
+  HotCodeChunk& chunk = it->second;
+  DCHECK_NE(chunk.live_allocations, 0u);
+  if (--chunk.live_allocations == 0u) {
+    if (it->first == current_hot_code_chunk_) {
+      // Keep the chunk for the next hot code.
+      chunk.used = 0u;
+    } else {
+      used_memory_for_code_ -= mspace_usable_size(it->first);
+      mspace_free(exec_mspace_, const_cast<uint8_t*>(it->first));
+      hot_code_chunks_.erase(it);
+      hot_code_chunk_allocation_failed_ = false;
+    }
+  }
+  return true;
+}
+
 void JitMemoryRegion::FreeCode(const uint8_t* code) {
   code = GetNonExecutableAddress(code);
+  if (FreeHotCode(code)) {
+    return;
+  }
   used_memory_for_code_ -= mspace_usable_size(code);
   mspace_free(exec_mspace_, const_cast<uint8_t*>(code));
+  hot_code_chunk_allocation_failed_ = false;
 }
 
 const uint8_t* JitMemoryRegion::AllocateData(size_t data_size) {
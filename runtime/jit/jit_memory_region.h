@@ -17,6 +17,7 @@
 #ifndef ART_RUNTIME_JIT_JIT_MEMORY_REGION_H_
 #define ART_RUNTIME_JIT_JIT_MEMORY_REGION_H_
 
+#include <map>
 #include <string>
 
 #include "arch/instruction_set.h"
@@ -79,7 +80,17 @@ class JitMemoryRegion {
   // Set the footprint limit of the code cache.
   void SetFootprintLimit(size_t new_footprint) REQUIRES(Locks::jit_lock_);
 
-  const uint8_t* AllocateCode(size_t code_size) REQUIRES(Locks::jit_lock_);
+  // Size of the chunks hot code is packed into for a code capacity of `code_capacity`, zero if
+  // hot code is not packed at that capacity.
+  static size_t ComputeHotCodeChunkSize(size_t code_capacity);
+
+  size_t GetHotCodeChunkSize() const REQUIRES(Locks::jit_lock_) {
+    return hot_code_chunk_size_;
+  }
+
+  // Allocate code. Code of hot methods is packed into dedicated chunks, so that it shares pages
+  // with other hot code rather than with short-lived code, and needs fewer iTLB entries.
+  const uint8_t* AllocateCode(size_t code_size, bool is_hot = false) REQUIRES(Locks::jit_lock_);
   void FreeCode(const uint8_t* code) REQUIRES(Locks::jit_lock_);
   const uint8_t* AllocateData(size_t data_size) REQUIRES(Locks::jit_lock_);
   void FreeData(const uint8_t* data) REQUIRES(Locks::jit_lock_);
@@ -277,6 +288,35 @@ class JitMemoryRegion {
   // The opaque mspace for allocating code.
   void* exec_mspace_ GUARDED_BY(Locks::jit_lock_);
 
+  // A chunk of `exec_mspace_` in which hot code is allocated sequentially. The chunk is returned
+  // to the mspace once all the code in it is freed.
+  struct HotCodeChunk {
+    size_t size;
+    size_t used;
+    size_t live_allocations;
+  };
+
+  // A whole chunk is accounted as used code memory, so chunks are a small share of the code
+  // capacity, and small code caches do not pack hot code at all.
+  static constexpr size_t kHotCodeChunkCapacityDivider = 32;
+  static constexpr size_t kMinHotCodeChunkSize = 16 * KB;
+  static constexpr size_t kMaxHotCodeChunkSize = 64 * KB;
+  // Only code up to this fraction of a chunk is packed into chunks.
+  static constexpr size_t kHotCodeChunkSizeToMaxCodeSize = 4;
+
+  const uint8_t* AllocateHotCode(size_t code_size) REQUIRES(Locks::jit_lock_);
+  // Free `code` if it is in a hot code chunk. Returns whether it was.
+  bool FreeHotCode(const uint8_t* code) REQUIRES(Locks::jit_lock_);
+
+  // Hot code chunks, keyed by their start in the updatable code mapping.
+  std::map<const uint8_t*, HotCodeChunk> hot_code_chunks_ GUARDED_BY(Locks::jit_lock_);
+  // The chunk new hot code is allocated in, null if none.
+  const uint8_t* current_hot_code_chunk_ GUARDED_BY(Locks::jit_lock_) = nullptr;
+  // Size of new hot code chunks for the current capacity, zero if hot code is not packed.
+  size_t hot_code_chunk_size_ GUARDED_BY(Locks::jit_lock_) = 0u;
+  // Whether the last attempt to allocate a chunk failed and no code was freed since.
+  bool hot_code_chunk_allocation_failed_ GUARDED_BY(Locks::jit_lock_) = false;
+
   friend class ScopedCodeCacheWrite;  // For GetUpdatableCodeMapping
   friend class TestZygoteMemory;
 };
@@ -28,6 +28,8 @@
 #include "base/memfd.h"
 #include "base/utils.h"
 #include "common_runtime_test.h"
+#include "jit/jit_scoped_code_cache_write.h"
+#include "thread-current-inl.h"
 
 namespace art HIDDEN {
 namespace jit {
@@ -576,5 +578,65 @@ TEST_F(TestZygoteMemory, TestVmMayWriteAfter) {
 
 #endif  // defined (__BIONIC__)
 
+class JitMemoryRegionTest : public CommonRuntimeTest {};
+
+TEST_F(JitMemoryRegionTest, HotCodeChunkSize) {
+  // Small code caches do not pack hot code.
+  EXPECT_EQ(JitMemoryRegion::ComputeHotCodeChunkSize(32 * KB), 0u);
+  EXPECT_EQ(JitMemoryRegion::ComputeHotCodeChunkSize(256 * KB), 0u);
+  // Chunks grow with the capacity, up to a limit.
+  EXPECT_EQ(JitMemoryRegion::ComputeHotCodeChunkSize(512 * KB), 16 * KB);
+  EXPECT_EQ(JitMemoryRegion::ComputeHotCodeChunkSize(1 * MB), 32 * KB);
+  EXPECT_EQ(JitMemoryRegion::ComputeHotCodeChunkSize(1 * MB + 512 * KB), 32 * KB);
+  EXPECT_EQ(JitMemoryRegion::ComputeHotCodeChunkSize(2 * MB), 64 * KB);
+  EXPECT_EQ(JitMemoryRegion::ComputeHotCodeChunkSize(64 * MB), 64 * KB);
+}
+
+TEST_F(JitMemoryRegionTest, HotCode) {
+  MutexLock mu(Thread::Current(), *Locks::jit_lock_);
+  JitMemoryRegion region;
+  std::string error_msg;
+  ASSERT_TRUE(region.Initialize(/*initial_capacity=*/ 64 * KB,
+                                /*max_capacity=*/ 16 * MB,
+                                /*rwx_memory_allowed=*/ true,
+                                /*is_zygote=*/ false,
+                                &error_msg)) << error_msg;
+  constexpr size_t kCodeSize = 1 * KB;
+
+  // With the initial capacity, hot code is allocated like any other code.
+  ASSERT_EQ(region.GetHotCodeChunkSize(), 0u);
+  {
+    ScopedCodeCacheWrite ccw(region);
+    const uint8_t* code = region.AllocateCode(kCodeSize, /*is_hot=*/ true);
+    ASSERT_TRUE(code != nullptr);
+    EXPECT_LT(region.GetUsedMemoryForCode(), 2 * kCodeSize);
+    region.FreeCode(code);
+    EXPECT_EQ(region.GetUsedMemoryForCode(), 0u);
+  }
+
+  while (region.GetHotCodeChunkSize() == 0u) {
+    ASSERT_TRUE(region.IncreaseCodeCacheCapacity());
+  }
+  const size_t chunk_size = region.GetHotCodeChunkSize();
+
+  ScopedCodeCacheWrite ccw(region);
+  // Hot code is packed into a chunk, which is accounted as used as a whole.
+  const uint8_t* hot1 = region.AllocateCode(kCodeSize, /*is_hot=*/ true);
+  const uint8_t* hot2 = region.AllocateCode(kCodeSize, /*is_hot=*/ true);
+  ASSERT_TRUE(hot1 != nullptr);
+  ASSERT_TRUE(hot2 != nullptr);
+  EXPECT_EQ(hot2, hot1 + RoundUp(kCodeSize, GetInstructionSetCodeAlignment(kRuntimeISA)));
+  EXPECT_GE(region.GetUsedMemoryForCode(), chunk_size);
+
+  // Code too large for the chunks is allocated outside of them.
+  const uint8_t* large = region.AllocateCode(chunk_size / 2, /*is_hot=*/ true);
+  ASSERT_TRUE(large != nullptr);
+  EXPECT_TRUE(large + chunk_size / 2 <= hot1 || large >= hot1 + chunk_size);
+
+  region.FreeCode(large);
+  region.FreeCode(hot1);
+  region.FreeCode(hot2);
+}
+
 }  // namespace jit
 }  // namespace art
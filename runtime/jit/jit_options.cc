@@ -16,6 +16,8 @@
 
 #include "jit_options.h"
 
+#include <algorithm>
+
 #include "runtime_options.h"
 
 namespace art HIDDEN {
@@ -48,6 +50,12 @@ JitOptions* JitOptions::CreateFromRuntimeArguments(const RuntimeArgumentMap& opt
   jit_options->use_jit_compilation_ = options.GetOrDefault(RuntimeArgumentMap::UseJitCompilation);
   jit_options->use_profiled_jit_compilation_ =
       options.GetOrDefault(RuntimeArgumentMap::UseProfiledJitCompilation);
+  jit_options->prefill_dex_caches_ =
+      options.GetOrDefault(RuntimeArgumentMap::PrefillDexCachesFromProfile);
+  jit_options->initialize_classes_ =
+      options.GetOrDefault(RuntimeArgumentMap::InitializeClassesFromProfile);
+  jit_options->use_early_osr_compilation_ =
+      options.GetOrDefault(RuntimeArgumentMap::UseEarlyOsrCompilation);
 
   jit_options->code_cache_initial_capacity_ =
       options.GetOrDefault(RuntimeArgumentMap::JITCodeCacheInitialCapacity);
@@ -61,6 +69,8 @@ JitOptions* JitOptions::CreateFromRuntimeArguments(const RuntimeArgumentMap& opt
       options.GetOrDefault(RuntimeArgumentMap::JITPoolThreadPthreadPriority);
   jit_options->zygote_thread_pool_pthread_priority_ =
       options.GetOrDefault(RuntimeArgumentMap::JITZygotePoolThreadPthreadPriority);
+  jit_options->thread_pool_size_ =
+      std::max(options.GetOrDefault(RuntimeArgumentMap::JITPoolThreads), 1u);
 
   // Set default optimize threshold to aid with checking defaults.
   jit_options->optimize_threshold_ = kIsDebugBuild
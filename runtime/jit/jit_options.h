@@ -34,6 +34,8 @@ static constexpr int kJitPoolThreadPthreadDefaultPriority = 9;
 // 19 is the lowest background priority on device.
 // See android/os/Process.java.
 static constexpr int kJitZygotePoolThreadPthreadDefaultPriority = 19;
+// Default number of JIT worker threads.
+static constexpr unsigned int kJitPoolDefaultThreads = 1;
 
 class JitOptions {
  public:
@@ -85,6 +87,10 @@ class JitOptions {
     return zygote_thread_pool_pthread_priority_;
   }
 
+  size_t GetThreadPoolSize() const {
+    return thread_pool_size_;
+  }
+
   bool UseJitCompilation() const {
     return use_jit_compilation_;
   }
@@ -93,6 +99,18 @@ class JitOptions {
     return use_profiled_jit_compilation_;
   }
 
+  bool PrefillDexCaches() const {
+    return prefill_dex_caches_;
+  }
+
+  bool InitializeClasses() const {
+    return initialize_classes_;
+  }
+
+  bool UseEarlyOsrCompilation() const {
+    return use_early_osr_compilation_;
+  }
+
   void SetUseJitCompilation(bool b) {
     use_jit_compilation_ = b;
   }
@@ -125,6 +143,15 @@ class JitOptions {
 
   bool use_jit_compilation_;
   bool use_profiled_jit_compilation_;
+  // Whether to resolve the strings, types and methods used by the startup methods of the
+  // application profile in the background, so that startup code finds them in the dex caches.
+  bool prefill_dex_caches_;
+  // Whether to initialize, in the background, the profile classes whose initialization
+  // cannot be observed, so that startup code does not run their initializers.
+  bool initialize_classes_;
+  // Whether to request an OSR compilation when a method gets hot in a loop before it has any
+  // JIT code, instead of waiting for its baseline code.
+  bool use_early_osr_compilation_;
   bool use_baseline_compiler_;
   size_t code_cache_initial_capacity_;
   size_t code_cache_max_capacity_;
@@ -135,11 +162,17 @@ class JitOptions {
   bool dump_info_on_shutdown_;
   int thread_pool_pthread_priority_;
   int zygote_thread_pool_pthread_priority_;
+  // Maximum number of JIT worker threads. Fewer are active when there is little to compile or
+  // the CPUs are busy.
+  size_t thread_pool_size_;
   ProfileSaverOptions profile_saver_options_;
 
   JitOptions()
       : use_jit_compilation_(false),
         use_profiled_jit_compilation_(false),
+        prefill_dex_caches_(false),
+        initialize_classes_(false),
+        use_early_osr_compilation_(false),
         use_baseline_compiler_(false),
         code_cache_initial_capacity_(0),
         code_cache_max_capacity_(0),
@@ -149,7 +182,8 @@ class JitOptions {
         invoke_transition_weight_(0),
         dump_info_on_shutdown_(false),
         thread_pool_pthread_priority_(kJitPoolThreadPthreadDefaultPriority),
-        zygote_thread_pool_pthread_priority_(kJitZygotePoolThreadPthreadDefaultPriority) {}
+        zygote_thread_pool_pthread_priority_(kJitZygotePoolThreadPthreadDefaultPriority),
+        thread_pool_size_(kJitPoolDefaultThreads) {}
 
   DISALLOW_COPY_AND_ASSIGN(JitOptions);
 };
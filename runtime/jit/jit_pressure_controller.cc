@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jit_pressure_controller.h"
+
+#include <algorithm>
+#include <ostream>
+
+#include "base/logging.h"
+
+namespace art HIDDEN {
+namespace jit {
+
+uint32_t JitPressureController::GetOptimizationRequestsNeeded(JitPressure pressure) {
+  switch (pressure) {
+    case JitPressure::kNone:
+      return 1u;
+    case JitPressure::kElevated:
+      return 2u;
+    case JitPressure::kHigh:
+      return 4u;
+  }
+}
+
+double JitPressureController::GetCompileBudget(JitPressure pressure) {
+  switch (pressure) {
+    case JitPressure::kNone:
+      return 1.0;
+    case JitPressure::kElevated:
+      return 0.5;
+    case JitPressure::kHigh:
+      return 0.25;
+  }
+}
+
+void JitPressureController::RecordCompilation(uint64_t now_ns,
+                                              uint64_t compile_ns,
+                                              size_t used_memory,
+                                              size_t max_capacity,
+                                              size_t recompilations) {
+  double occupancy =
+      (max_capacity == 0u) ? 0.0 : static_cast<double>(used_memory) / max_capacity;
+  if (!started_) {
+    started_ = true;
+    window_start_ns_ = now_ns - std::min(now_ns, compile_ns);
+    window_start_occupancy_ = occupancy;
+    window_start_recompilations_ = recompilations;
+  } else if (now_ns - window_start_ns_ >= kWindowNs) {
+    EndWindow(now_ns, occupancy, recompilations);
+  }
+  window_compile_ns_ += compile_ns;
+}
+
+void JitPressureController::EndWindow(uint64_t now_ns, double occupancy, size_t recompilations) {
+  DCHECK_GE(recompilations, window_start_recompilations_);
+  uint64_t window_ns = now_ns - window_start_ns_;
+  last_compile_fraction_ = static_cast<double>(window_compile_ns_) / window_ns;
+  last_occupancy_ = occupancy;
+  last_occupancy_trend_ = occupancy - window_start_occupancy_;
+  last_churn_ = recompilations - window_start_recompilations_;
+
+  JitPressure pressure = JitPressure::kNone;
+  if (last_churn_ >= kSevereChurn ||
+      (occupancy >= kHighOccupancy &&
+       (last_churn_ >= kHighChurn || last_compile_fraction_ >= kHighCompileFraction))) {
+    pressure = JitPressure::kHigh;
+  } else if (last_churn_ != 0u ||
+             occupancy >= kHighOccupancy ||
+             (occupancy >= kElevatedOccupancy && last_occupancy_trend_ > 0.0)) {
+    pressure = JitPressure::kElevated;
+  }
+  if (pressure != GetPressure()) {
+    VLOG(jit) << "JIT pressure changed to " << pressure
+              << ", code cache occupancy: " << occupancy
+              << ", recompilations: " << last_churn_
+              << ", share of time compiling: " << last_compile_fraction_;
+  }
+  pressure_.store(pressure, std::memory_order_relaxed);
+  if (pressure != JitPressure::kNone) {
+    ++windows_under_pressure_;
+  }
+
+  window_start_ns_ = now_ns;
+  window_compile_ns_ = 0u;
+  window_start_occupancy_ = occupancy;
+  window_start_recompilations_ = recompilations;
+}
+
+uint64_t JitPressureController::GetThrottleDelayNs(uint64_t now_ns) const {
+  JitPressure pressure = GetPressure();
+  if (!started_ || pressure == JitPressure::kNone) {
+    return 0u;
+  }
+  uint64_t window_end_ns = window_start_ns_ + kWindowNs;
+  if (now_ns >= window_end_ns) {
+    return 0u;
+  }
+  uint64_t budget_ns = static_cast<uint64_t>(GetCompileBudget(pressure) * kWindowNs);
+  return (window_compile_ns_ >= budget_ns) ? window_end_ns - now_ns : 0u;
+}
+
+void JitPressureController::Dump(std::ostream& os) const {
+  os << "JIT pressure: " << GetPressure() << "\n"
+     << "JIT code cache occupancy: " << static_cast<int>(last_occupancy_ * 100) << "%"
+     << " (trend " << static_cast<int>(last_occupancy_trend_ * 100) << "% per window)\n"
+     << "JIT recompilations in the last window: " << last_churn_ << "\n"
+     << "JIT share of time compiling in the last window: "
+         << static_cast<int>(last_compile_fraction_ * 100) << "%\n"
+     << "Number of JIT windows under pressure: " << windows_under_pressure_ << "\n"
+     << "Total time JIT compilation was throttled: " << PrettyDuration(total_throttled_ns_)
+     << "\n";
+}
+
+}  // namespace jit
+}  // namespace art
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_JIT_JIT_PRESSURE_CONTROLLER_H_
+#define ART_RUNTIME_JIT_JIT_PRESSURE_CONTROLLER_H_
+
+#include <iosfwd>
+
+#include "base/atomic.h"
+#include "base/macros.h"
+#include "base/time_utils.h"
+
+namespace art HIDDEN {
+namespace jit {
+
+enum class JitPressure : uint8_t {
+  kNone,      // Compile as usual.
+  kElevated,  // The code cache fills up, or code got collected and compiled again.
+  kHigh,      // The code cache is nearly full and we keep compiling.
+};
+std::ostream& operator<<(std::ostream& os, JitPressure rhs);
+
+// Tracks how much time the JIT spends compiling, how full the code cache is getting and how
+// many methods get compiled again after their code was collected, and derives a pressure level
+// from it. Under pressure, lukewarm methods stay in baseline code and optimized compilations
+// back off so that compilation stays within a time budget, instead of collecting and
+// recompiling in a loop.
+//
+// The signals are measured over windows of `kWindowNs`: the pressure level is recomputed at the
+// first compilation that ends after the current window.
+//
+// Not thread-safe, except for `GetPressure`. Callers serialize the other methods.
+class JitPressureController {
+ public:
+  static constexpr uint64_t kWindowNs = MsToNs(1000);
+
+  JitPressureController() {}
+
+  // Record a compilation finishing at `now_ns` after `compile_ns`. The remaining arguments
+  // describe the code cache at that point; `recompilations` is the running count of methods
+  // compiled again after their code was collected.
+  void RecordCompilation(uint64_t now_ns,
+                         uint64_t compile_ns,
+                         size_t used_memory,
+                         size_t max_capacity,
+                         size_t recompilations);
+
+  // Record that optimized compilations were held back for `throttled_ns` to stay within the
+  // compilation budget.
+  void RecordThrottle(uint64_t throttled_ns) {
+    total_throttled_ns_ += throttled_ns;
+  }
+
+  JitPressure GetPressure() const {
+    return pressure_.load(std::memory_order_relaxed);
+  }
+
+  // How many times the baseline code of a method must run out of hotness before we compile it
+  // optimized. This multiplies the optimize threshold without changing the code we already
+  // generated.
+  static uint32_t GetOptimizationRequestsNeeded(JitPressure pressure);
+
+  // How long optimized compilations should be held back, so that the time spent compiling in
+  // the current window stays within the budget of the current pressure level.
+  uint64_t GetThrottleDelayNs(uint64_t now_ns) const;
+
+  uint64_t GetTotalThrottledNs() const {
+    return total_throttled_ns_;
+  }
+
+  void Dump(std::ostream& os) const;
+
+ private:
+  // Code cache occupancy above which we consider being under (high) pressure.
+  static constexpr double kElevatedOccupancy = 0.75;
+  static constexpr double kHighOccupancy = 0.9;
+  // Recompilations per window which mean we are thrashing with a nearly full cache, or
+  // whatever the occupancy.
+  static constexpr size_t kHighChurn = 4;
+  static constexpr size_t kSevereChurn = 16;
+  // Share of the window spent compiling which, with a nearly full cache, means high pressure.
+  static constexpr double kHighCompileFraction = 0.5;
+
+  // Share of a window we allow spending in compilation, per pressure level.
+  static double GetCompileBudget(JitPressure pressure);
+
+  void EndWindow(uint64_t now_ns, double occupancy, size_t recompilations);
+
+  Atomic<JitPressure> pressure_{JitPressure::kNone};
+
+  bool started_ = false;
+  uint64_t window_start_ns_ = 0u;
+  uint64_t window_compile_ns_ = 0u;
+  double window_start_occupancy_ = 0.0;
+  size_t window_start_recompilations_ = 0u;
+
+  // Values measured over the last complete window.
+  double last_compile_fraction_ = 0.0;
+  double last_occupancy_ = 0.0;
+  double last_occupancy_trend_ = 0.0;
+  size_t last_churn_ = 0u;
+
+  uint64_t total_throttled_ns_ = 0u;
+  size_t windows_under_pressure_ = 0u;
+
+  DISALLOW_COPY_AND_ASSIGN(JitPressureController);
+};
+
+}  // namespace jit
+}  // namespace art
+
+#endif  // ART_RUNTIME_JIT_JIT_PRESSURE_CONTROLLER_H_
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jit_pressure_controller.h"
+
+#include <gtest/gtest.h>
+
+namespace art HIDDEN {
+namespace jit {
+
+static constexpr uint64_t kWindowNs = JitPressureController::kWindowNs;
+static constexpr size_t kCapacity = 100u;
+
+TEST(JitPressureControllerTest, NoPressure) {
+  JitPressureController controller;
+  uint64_t now_ns = kWindowNs;
+  for (size_t i = 0; i < 10u; ++i) {
+    controller.RecordCompilation(now_ns, MsToNs(900), /*used_memory=*/ 10u + i, kCapacity, 0u);
+    now_ns += kWindowNs;
+  }
+  EXPECT_EQ(controller.GetPressure(), JitPressure::kNone);
+  EXPECT_EQ(controller.GetThrottleDelayNs(now_ns), 0u);
+  EXPECT_EQ(JitPressureController::GetOptimizationRequestsNeeded(controller.GetPressure()), 1u);
+}
+
+TEST(JitPressureControllerTest, FillingUp) {
+  JitPressureController controller;
+  controller.RecordCompilation(kWindowNs, MsToNs(1), /*used_memory=*/ 70u, kCapacity, 0u);
+  // Growing past the elevated occupancy.
+  controller.RecordCompilation(2 * kWindowNs, MsToNs(1), /*used_memory=*/ 80u, kCapacity, 0u);
+  EXPECT_EQ(controller.GetPressure(), JitPressure::kElevated);
+  // Staying under the high occupancy without growing.
+  controller.RecordCompilation(3 * kWindowNs, MsToNs(1), /*used_memory=*/ 80u, kCapacity, 0u);
+  EXPECT_EQ(controller.GetPressure(), JitPressure::kNone);
+  // Nearly full and busy compiling.
+  controller.RecordCompilation(4 * kWindowNs, MsToNs(600), /*used_memory=*/ 95u, kCapacity, 0u);
+  controller.RecordCompilation(5 * kWindowNs, MsToNs(1), /*used_memory=*/ 95u, kCapacity, 0u);
+  EXPECT_EQ(controller.GetPressure(), JitPressure::kHigh);
+  EXPECT_EQ(JitPressureController::GetOptimizationRequestsNeeded(controller.GetPressure()), 4u);
+}
+
+TEST(JitPressureControllerTest, Churn) {
+  JitPressureController controller;
+  controller.RecordCompilation(kWindowNs, MsToNs(1), /*used_memory=*/ 10u, kCapacity, 0u);
+  controller.RecordCompilation(2 * kWindowNs, MsToNs(1), /*used_memory=*/ 10u, kCapacity, 1u);
+  EXPECT_EQ(controller.GetPressure(), JitPressure::kElevated);
+  controller.RecordCompilation(3 * kWindowNs, MsToNs(1), /*used_memory=*/ 10u, kCapacity, 20u);
+  EXPECT_EQ(controller.GetPressure(), JitPressure::kHigh);
+  // No more recompilations, the pressure goes away.
+  controller.RecordCompilation(4 * kWindowNs, MsToNs(1), /*used_memory=*/ 10u, kCapacity, 20u);
+  EXPECT_EQ(controller.GetPressure(), JitPressure::kNone);
+}
+
+TEST(JitPressureControllerTest, Throttle) {
+  JitPressureController controller;
+  controller.RecordCompilation(kWindowNs, MsToNs(1), /*used_memory=*/ 10u, kCapacity, 0u);
+  controller.RecordCompilation(2 * kWindowNs, MsToNs(1), /*used_memory=*/ 10u, kCapacity, 20u);
+  ASSERT_EQ(controller.GetPressure(), JitPressure::kHigh);
+  // Within budget.
+  EXPECT_EQ(controller.GetThrottleDelayNs(2 * kWindowNs + MsToNs(10)), 0u);
+  // Over a quarter of the window spent compiling.
+  uint64_t now_ns = 2 * kWindowNs + MsToNs(400);
+  controller.RecordCompilation(now_ns, MsToNs(300), /*used_memory=*/ 10u, kCapacity, 20u);
+  EXPECT_EQ(controller.GetThrottleDelayNs(now_ns), MsToNs(600));
+  // The next window starts with a new budget.
+  EXPECT_EQ(controller.GetThrottleDelayNs(3 * kWindowNs), 0u);
+}
+
+}  // namespace jit
+}  // namespace art
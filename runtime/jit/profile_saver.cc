@@ -42,6 +42,8 @@
 #include "oat/oat_file_manager.h"
 #include "profile/profile_compilation_info.h"
 #include "scoped_thread_state_change-inl.h"
+#include "stack.h"
+#include "thread_list.h"
 
 namespace art HIDDEN {
 
@@ -49,6 +51,7 @@ using Hotness = ProfileCompilationInfo::MethodHotness;
 
 ProfileSaver* ProfileSaver::instance_ = nullptr;
 pthread_t ProfileSaver::profiler_pthread_ = 0U;
+pthread_t ProfileSaver::sampler_pthread_ = 0U;
 
 static_assert(ProfileCompilationInfo::kIndividualInlineCacheSize ==
               InlineCache::kIndividualCacheSize,
@@ -88,6 +91,7 @@ ProfileSaver::ProfileSaver(const ProfileSaverOptions& options, jit::JitCodeCache
       jit_activity_notifications_(0),
       wait_lock_("ProfileSaver wait lock"),
       period_condition_("ProfileSaver period condition", wait_lock_),
+      sampling_condition_("ProfileSaver sampling condition", wait_lock_),
       total_bytes_written_(0),
       total_number_of_writes_(0),
       total_number_of_code_cache_queries_(0),
@@ -97,6 +101,7 @@ ProfileSaver::ProfileSaver(const ProfileSaverOptions& options, jit::JitCodeCache
       total_ns_of_work_(0),
       total_number_of_hot_spikes_(0),
       total_number_of_wake_ups_(0),
+      total_number_of_samples_(0),
       options_(options) {
   DCHECK(options_.IsEnabled());
 }
@@ -764,6 +769,44 @@ void ProfileSaver::FetchAndCacheResolvedClassesAndMethods(bool startup) {
                  << " sampled methods in " << PrettyDuration(NanoTime() - start_time);
 }
 
+// Computes a fingerprint of the profiled methods and the cached classes and methods that
+// a save would add to the profile file.
+static size_t ComputeSaveFingerprint(const std::vector<ProfileMethodInfo>& profile_methods,
+                                     const ProfileCompilationInfo* cached_info) {
+  size_t fingerprint = profile_methods.size();
+  auto combine = [&fingerprint](size_t value) { fingerprint = fingerprint * 31u + value; };
+  for (const ProfileMethodInfo& method : profile_methods) {
+    combine(reinterpret_cast<uintptr_t>(method.ref.dex_file));
+    combine(method.ref.index);
+    for (const ProfileMethodInfo::ProfileInlineCache& cache : method.inline_caches) {
+      combine(cache.dex_pc);
+      combine(cache.is_missing_types ? 1u : 0u);
+      for (const TypeReference& type : cache.classes) {
+        combine(reinterpret_cast<uintptr_t>(type.dex_file));
+        combine(type.TypeIndex().index_);
+      }
+    }
+  }
+  if (cached_info != nullptr) {
+    combine(cached_info->GetNumberOfMethods());
+    combine(cached_info->GetNumberOfResolvedClasses());
+  }
+  return fingerprint;
+}
+
+// Computes a fingerprint of the size and modification time of the profile file, so that a
+// change of the file by someone else, e.g. a profile merge or a clear, leads to a new save.
+static size_t ComputeFileFingerprint(const std::string& filename) {
+  struct stat st;
+  if (stat(filename.c_str(), &st) != 0) {
+    return 0u;
+  }
+  size_t fingerprint = static_cast<size_t>(st.st_size);
+  fingerprint = fingerprint * 31u + static_cast<size_t>(st.st_mtim.tv_sec);
+  fingerprint = fingerprint * 31u + static_cast<size_t>(st.st_mtim.tv_nsec);
+  return fingerprint;
+}
+
 bool ProfileSaver::ProcessProfilingInfo(bool force_save, /*out*/uint16_t* number_of_new_methods) {
   ScopedTrace trace(__PRETTY_FUNCTION__);
 
@@ -804,6 +847,23 @@ bool ProfileSaver::ProcessProfilingInfo(bool force_save, /*out*/uint16_t* number
           locations, profile_methods, options_.GetInlineCacheThreshold());
       total_number_of_code_cache_queries_++;
     }
+    size_t data_fingerprint;
+    size_t file_fingerprint = ComputeFileFingerprint(filename);
+    {
+      MutexLock mu(Thread::Current(), *Locks::profiler_lock_);
+      auto profile_cache_it = profile_cache_.find(filename);
+      data_fingerprint = ComputeSaveFingerprint(
+          profile_methods,
+          profile_cache_it != profile_cache_.end() ? profile_cache_it->second : nullptr);
+      auto fingerprint_it = last_save_fingerprints_.find(filename);
+      if (!force_save &&
+          fingerprint_it != last_save_fingerprints_.end() &&
+          fingerprint_it->second == data_fingerprint * 31u + file_fingerprint) {
+        VLOG(profiler) << "No new information to save to: " << filename;
+        total_number_of_skipped_writes_++;
+        continue;
+      }
+    }
     {
       ProfileCompilationInfo info(Runtime::Current()->GetArenaPool(),
                                   /*for_boot_image=*/options_.GetProfileBootClassPath());
@@ -864,6 +924,7 @@ bool ProfileSaver::ProcessProfilingInfo(bool force_save, /*out*/uint16_t* number
                         << " Number of methods: " << delta_number_of_methods
                         << " Number of classes: " << delta_number_of_classes;
           total_number_of_skipped_writes_++;
+          last_save_fingerprints_.Overwrite(filename, data_fingerprint * 31u + file_fingerprint);
           continue;
         }
 
@@ -876,6 +937,9 @@ bool ProfileSaver::ProcessProfilingInfo(bool force_save, /*out*/uint16_t* number
         // Force the save. In case the profile data is corrupted or the profile
         // has the wrong version this will "fix" the file to the correct format.
         if (info.Save(filename, &bytes_written)) {
+          // Record the file as we left it, so that only later changes by others count.
+          last_save_fingerprints_.Overwrite(
+              filename, data_fingerprint * 31u + ComputeFileFingerprint(filename));
           // We managed to save the profile. Clear the cache stored during startup.
           if (profile_cache_it != profile_cache_.end()) {
             ProfileCompilationInfo *cached_info = profile_cache_it->second;
@@ -908,6 +972,79 @@ bool ProfileSaver::ProcessProfilingInfo(bool force_save, /*out*/uint16_t* number
   return profile_file_saved;
 }
 
+class SampleMethodClosure final : public Closure {
+ public:
+  void Run(Thread* thread) override REQUIRES_SHARED(Locks::mutator_lock_) {
+    // Threads that are suspended or blocked are not using CPU time. For these, the checkpoint
+    // is run by the sampler thread and the thread is skipped.
+    if (thread->GetState() != ThreadState::kRunnable) {
+      return;
+    }
+    ArtMethod* sampled_method = nullptr;
+    StackVisitor::WalkStack(
+        [&](const art::StackVisitor* stack_visitor) REQUIRES_SHARED(Locks::mutator_lock_) {
+          ArtMethod* method = stack_visitor->GetMethod();
+          if (method == nullptr || method->IsRuntimeMethod()) {
+            return true;
+          }
+          sampled_method = method;
+          return false;
+        },
+        thread,
+        /* context= */ nullptr,
+        art::StackVisitor::StackWalkKind::kIncludeInlinedFrames);
+    // Like NterpHotMethod(), do not dirty shared memory by updating boot image methods.
+    if (sampled_method != nullptr &&
+        !sampled_method->IsNative() &&
+        !sampled_method->IsMemorySharedMethod() &&
+        !sampled_method->PreviouslyWarm()) {
+      // Warm for the runtime means hot for the profile.
+      sampled_method->SetPreviouslyWarm();
+    }
+  }
+};
+
+void ProfileSaver::SampleThreads() {
+  SampleMethodClosure closure;
+  Runtime::Current()->GetThreadList()->RunCheckpoint(&closure);
+  total_number_of_samples_++;
+}
+
+void ProfileSaver::RunSampler() {
+  Thread* self = Thread::Current();
+  const uint32_t sampling_interval_ms = options_.GetSamplingIntervalMs();
+  DCHECK_NE(sampling_interval_ms, ProfileSaverOptions::kSamplingIntervalMsDisabled);
+  while (!ShuttingDown(self)) {
+    {
+      MutexLock mu(self, wait_lock_);
+      sampling_condition_.TimedWait(self, sampling_interval_ms, 0);
+    }
+    if (ShuttingDown(self)) {
+      break;
+    }
+    SampleThreads();
+  }
+}
+
+void* ProfileSaver::RunSamplerThread(void* arg) {
+  Runtime* runtime = Runtime::Current();
+
+  bool attached = runtime->AttachCurrentThread("Profile Sampler",
+                                               /*as_daemon=*/true,
+                                               runtime->GetSystemThreadGroup(),
+                                               /*create_peer=*/true);
+  if (!attached) {
+    CHECK(runtime->IsShuttingDown(Thread::Current()));
+    return nullptr;
+  }
+
+  reinterpret_cast<ProfileSaver*>(arg)->RunSampler();
+
+  runtime->DetachCurrentThread();
+  VLOG(profiler) << "Profile sampler shutdown";
+  return nullptr;
+}
+
 void* ProfileSaver::RunProfileSaverThread(void* arg) {
   Runtime* runtime = Runtime::Current();
 
@@ -1032,17 +1169,29 @@ void  ProfileSaver::Start(const ProfileSaverOptions& options,
       "Profile saver thread");
 
   SetProfileSaverThreadPriority(profiler_pthread_, kProfileSaverPthreadPriority);
+
+  if (options.GetSamplingIntervalMs() != ProfileSaverOptions::kSamplingIntervalMsDisabled) {
+    // Create a thread which samples the running methods.
+    CHECK_PTHREAD_CALL(
+        pthread_create,
+        (&sampler_pthread_, nullptr, &RunSamplerThread, reinterpret_cast<void*>(instance_)),
+        "Profile sampler thread");
+
+    SetProfileSaverThreadPriority(sampler_pthread_, kProfileSaverPthreadPriority);
+  }
 }
 
 void ProfileSaver::Stop(bool dump_info) {
   ProfileSaver* profile_saver = nullptr;
   pthread_t profiler_pthread = 0U;
+  pthread_t sampler_pthread = 0U;
 
   {
     MutexLock profiler_mutex(Thread::Current(), *Locks::profiler_lock_);
     VLOG(profiler) << "Stopping profile saver thread";
     profile_saver = instance_;
     profiler_pthread = profiler_pthread_;
+    sampler_pthread = sampler_pthread_;
     if (instance_ == nullptr) {
       DCHECK(false) << "Tried to stop a profile saver which was not started";
       return;
@@ -1055,9 +1204,14 @@ void ProfileSaver::Stop(bool dump_info) {
   }
 
   {
-    // Wake up the saver thread if it is sleeping to allow for a clean exit.
+    // Wake up the saver and sampler threads if they are sleeping to allow for a clean exit.
     MutexLock wait_mutex(Thread::Current(), profile_saver->wait_lock_);
     profile_saver->period_condition_.Signal(Thread::Current());
+    profile_saver->sampling_condition_.Signal(Thread::Current());
+  }
+
+  if (sampler_pthread != 0U) {
+    CHECK_PTHREAD_CALL(pthread_join, (sampler_pthread, nullptr), "profile sampler thread shutdown");
   }
 
   // Force save everything before destroying the thread since we want profiler_pthread_ to remain
@@ -1074,6 +1228,7 @@ void ProfileSaver::Stop(bool dump_info) {
     }
     instance_ = nullptr;
     profiler_pthread_ = 0U;
+    sampler_pthread_ = 0U;
   }
   delete profile_saver;
 }
@@ -1167,7 +1322,8 @@ void ProfileSaver::DumpInfo(std::ostream& os) {
      << "ProfileSaver total_ms_of_sleep=" << total_ms_of_sleep_ << '\n'
      << "ProfileSaver total_ms_of_work=" << NsToMs(total_ns_of_work_) << '\n'
      << "ProfileSaver total_number_of_hot_spikes=" << total_number_of_hot_spikes_ << '\n'
-     << "ProfileSaver total_number_of_wake_ups=" << total_number_of_wake_ups_ << '\n';
+     << "ProfileSaver total_number_of_wake_ups=" << total_number_of_wake_ups_ << '\n'
+     << "ProfileSaver total_number_of_samples=" << total_number_of_samples_ << '\n';
 }
 
 
@@ -74,6 +74,15 @@ class ProfileSaver {
       REQUIRES(Locks::profiler_lock_, !wait_lock_)
       RELEASE(Locks::profiler_lock_);
 
+  static void* RunSamplerThread(void* arg)
+      REQUIRES(!Locks::profiler_lock_, !instance_->wait_lock_);
+
+  // The run loop for the sampler, see ProfileSaverOptions::GetSamplingIntervalMs().
+  void RunSampler() REQUIRES(!Locks::profiler_lock_, !wait_lock_);
+
+  // Marks the method running on each runnable thread as hot for the profile.
+  void SampleThreads() REQUIRES(!Locks::mutator_lock_);
+
   // Processes the existing profiling info from the jit code cache and returns
   // true if it needed to be saved to disk.
   // If number_of_new_methods is not null, after the call it will contain the number of new methods
@@ -119,6 +128,8 @@ class ProfileSaver {
   static ProfileSaver* instance_ GUARDED_BY(Locks::profiler_lock_);
   // Profile saver thread.
   static pthread_t profiler_pthread_ GUARDED_BY(Locks::profiler_lock_);
+  // Method sampler thread, only started if a sampling interval is set.
+  static pthread_t sampler_pthread_ GUARDED_BY(Locks::profiler_lock_);
 
   jit::JitCodeCache* jit_code_cache_;
 
@@ -151,6 +162,12 @@ class ProfileSaver {
   // to just a few hundreds entries in the ProfileCompilationInfo objects.
   SafeMap<std::string, ProfileCompilationInfo*> profile_cache_ GUARDED_BY(Locks::profiler_lock_);
 
+  // For each tracked file, a fingerprint of the data considered by the last save that either
+  // wrote the file or found too little new data, and of the size and modification time of the
+  // file after that save. A save with the same fingerprint would reach the same decision, so it
+  // is skipped without loading the profile file.
+  SafeMap<std::string, size_t> last_save_fingerprints_ GUARDED_BY(Locks::profiler_lock_);
+
   // Whether or not this is the first ever profile save.
   // Note this is an approximation and is not 100% precise. It relies on checking
   // whether or not the profiles are empty which is not a precise indication
@@ -160,6 +177,7 @@ class ProfileSaver {
   // Save period condition support.
   Mutex wait_lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
   ConditionVariable period_condition_ GUARDED_BY(wait_lock_);
+  ConditionVariable sampling_condition_ GUARDED_BY(wait_lock_);
 
   uint64_t total_bytes_written_;
   uint64_t total_number_of_writes_;
@@ -171,6 +189,7 @@ class ProfileSaver {
   // TODO(calin): replace with an actual size.
   uint64_t total_number_of_hot_spikes_;
   uint64_t total_number_of_wake_ups_;
+  uint64_t total_number_of_samples_;
 
   const ProfileSaverOptions options_;
 
@@ -30,6 +30,8 @@ struct ProfileSaverOptions {
   static constexpr uint32_t kMinNotificationBeforeWake = 10;
   static constexpr uint32_t kMaxNotificationBeforeWake = 50;
   static constexpr uint16_t kInlineCacheThreshold = 4000;
+  // Default value for the sampling interval, indicating that sampling is disabled.
+  static constexpr uint32_t kSamplingIntervalMsDisabled = 0;
 
   ProfileSaverOptions()
       : enabled_(false),
@@ -43,7 +45,8 @@ struct ProfileSaverOptions {
         profile_path_(""),
         profile_boot_class_path_(false),
         profile_aot_code_(false),
-        wait_for_jit_notifications_to_save_(true) {}
+        wait_for_jit_notifications_to_save_(true),
+        sampling_interval_ms_(kSamplingIntervalMsDisabled) {}
 
   ProfileSaverOptions(bool enabled,
                       uint32_t min_save_period_ms,
@@ -56,7 +59,8 @@ struct ProfileSaverOptions {
                       const std::string& profile_path,
                       bool profile_boot_class_path,
                       bool profile_aot_code = false,
-                      bool wait_for_jit_notifications_to_save = true)
+                      bool wait_for_jit_notifications_to_save = true,
+                      uint32_t sampling_interval_ms = kSamplingIntervalMsDisabled)
       : enabled_(enabled),
         min_save_period_ms_(min_save_period_ms),
         min_first_save_ms_(min_first_save_ms),
@@ -68,7 +72,8 @@ struct ProfileSaverOptions {
         profile_path_(profile_path),
         profile_boot_class_path_(profile_boot_class_path),
         profile_aot_code_(profile_aot_code),
-        wait_for_jit_notifications_to_save_(wait_for_jit_notifications_to_save) {}
+        wait_for_jit_notifications_to_save_(wait_for_jit_notifications_to_save),
+        sampling_interval_ms_(sampling_interval_ms) {}
 
   bool IsEnabled() const {
     return enabled_;
@@ -113,6 +118,9 @@ struct ProfileSaverOptions {
   void SetWaitForJitNotificationsToSave(bool value) {
     wait_for_jit_notifications_to_save_ = value;
   }
+  uint32_t GetSamplingIntervalMs() const {
+    return sampling_interval_ms_;
+  }
 
   friend std::ostream & operator<<(std::ostream &os, const ProfileSaverOptions& pso) {
     os << "enabled_" << pso.enabled_
@@ -125,7 +133,8 @@ struct ProfileSaverOptions {
         << ", inline_cache_threshold_" << pso.inline_cache_threshold_
         << ", profile_boot_class_path_" << pso.profile_boot_class_path_
         << ", profile_aot_code_" << pso.profile_aot_code_
-        << ", wait_for_jit_notifications_to_save_" << pso.wait_for_jit_notifications_to_save_;
+        << ", wait_for_jit_notifications_to_save_" << pso.wait_for_jit_notifications_to_save_
+        << ", sampling_interval_ms_" << pso.sampling_interval_ms_;
     return os;
   }
 
@@ -141,6 +150,9 @@ struct ProfileSaverOptions {
   bool profile_boot_class_path_;
   bool profile_aot_code_;
   bool wait_for_jit_notifications_to_save_;
+  // If not zero, the methods running on each thread are sampled with this period and the
+  // sampled methods are recorded as hot, whether they run in the interpreter, JIT or AOT code.
+  uint32_t sampling_interval_ms_;
 };
 
 }  // namespace art
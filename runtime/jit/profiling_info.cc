@@ -32,7 +32,9 @@ ProfilingInfo::ProfilingInfo(ArtMethod* method,
         method_(method),
         number_of_inline_caches_(inline_cache_entries.size()),
         number_of_branch_caches_(branch_cache_entries.size()),
-        current_inline_uses_(0) {
+        current_inline_uses_(0),
+        optimization_requests_(0) {
+  memset(deoptimization_counts_, 0, sizeof(deoptimization_counts_));
   InlineCache* inline_caches = GetInlineCaches();
   memset(inline_caches, 0, number_of_inline_caches_ * sizeof(InlineCache));
   for (size_t i = 0; i < number_of_inline_caches_; ++i) {
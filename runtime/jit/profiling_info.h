@@ -21,6 +21,7 @@
 
 #include "base/macros.h"
 #include "base/value_object.h"
+#include "deoptimization_kind.h"
 #include "gc_root.h"
 #include "interpreter/mterp/nterp.h"
 #include "offsets.h"
@@ -177,6 +178,32 @@ class ProfilingInfo {
 
   static uint16_t GetOptimizeThreshold();
 
+  // Record the baseline code running out of hotness. Returns whether that happened at least
+  // `needed` times, in which case the count starts over.
+  bool RecordOptimizationRequest(uint32_t needed) {
+    if (++optimization_requests_ < needed) {
+      return false;
+    }
+    optimization_requests_ = 0;
+    return true;
+  }
+
+  // Record a single-frame deoptimization of the compiled code of the method. Returns whether
+  // this deoptimization made the compiler stop speculating for `kind` in the method.
+  bool RecordDeoptimization(DeoptimizationKind kind) {
+    uint8_t& count = deoptimization_counts_[static_cast<size_t>(kind)];
+    if (count == kMaxDeoptimizationsPerKind) {
+      return false;
+    }
+    return ++count == kMaxDeoptimizationsPerKind;
+  }
+
+  // Whether the compiler may still emit code that deoptimizes for `kind` when compiling the
+  // method, or methods inlined into it.
+  bool ShouldSpeculate(DeoptimizationKind kind) const {
+    return deoptimization_counts_[static_cast<size_t>(kind)] < kMaxDeoptimizationsPerKind;
+  }
+
  private:
   ProfilingInfo(ArtMethod* method,
                 const std::vector<uint32_t>& inline_cache_entries,
@@ -202,6 +229,16 @@ class ProfilingInfo {
   // it updates this counter so that the GC does not try to clear the inline caches.
   uint16_t current_inline_uses_;
 
+  // How many times the baseline code ran out of hotness since the method was last enqueued for
+  // optimized compilation. Updated without synchronization, it is only a heuristic.
+  uint16_t optimization_requests_;
+
+  // How many times the compiled code of the method deoptimized, per kind. Once a kind reaches
+  // `kMaxDeoptimizationsPerKind`, the code we compile next does not speculate for it, so that
+  // we do not go back and forth between compiled code and the interpreter.
+  static constexpr uint8_t kMaxDeoptimizationsPerKind = 3;
+  uint8_t deoptimization_counts_[static_cast<size_t>(DeoptimizationKind::kLast) + 1];
+
   // Memory following the object:
   // - Dynamically allocated array of `InlineCache` of size `number_of_inline_caches_`.
   // - Dynamically allocated array of `BranchCache of size `number_of_branch_caches_`.
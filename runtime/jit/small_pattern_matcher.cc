@@ -18,6 +18,7 @@
 
 #include "art_method-inl.h"
 #include "dex/dex_instruction-inl.h"
+#include "dex/dex_instruction_utils.h"
 #include "entrypoints/entrypoint_utils-inl.h"
 
 namespace art HIDDEN {
@@ -27,12 +28,26 @@ namespace jit {
 // code.
 
 static void EmptyMethod() {}
-static int32_t ReturnZero() { return 0; }
-static int32_t ReturnOne() { return 1; }
 static int32_t ReturnFirstArgMethod([[maybe_unused]] ArtMethod* method, int32_t first_arg) {
   return first_arg;
 }
 
+template <typename T, T value>
+static T ReturnConstant() { return value; }
+
+// On arm64, each non floating-point argument takes one core register whatever its width, so
+// the same stub returns any of the first arguments. Registers past the actual arguments hold
+// garbage, which is fine as we never return them.
+template <size_t index>
+static int64_t ReturnCoreArgAt([[maybe_unused]] ArtMethod* method,
+                               int64_t arg0,
+                               int64_t arg1,
+                               int64_t arg2,
+                               int64_t arg3) {
+  const int64_t args[] = { arg0, arg1, arg2, arg3 };
+  return args[index];
+}
+
 template <int offset, typename T>
 static std::conditional_t<(sizeof(T) < sizeof(int32_t)), int32_t, T> ReturnFieldAt(
     [[maybe_unused]] ArtMethod* method, mirror::Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
@@ -129,6 +144,12 @@ static void ConstructorSetFieldObjectAt([[maybe_unused]] ArtMethod* method,
   switch (K) {                                      \
     case Primitive::kPrimBoolean:                   \
       DO_SWITCH_OFFSET(offset, P, uint8_t);         \
+    case Primitive::kPrimByte:                      \
+      DO_SWITCH_OFFSET(offset, P, int8_t);          \
+    case Primitive::kPrimChar:                      \
+      DO_SWITCH_OFFSET(offset, P, uint16_t);        \
+    case Primitive::kPrimShort:                     \
+      DO_SWITCH_OFFSET(offset, P, int16_t);         \
     case Primitive::kPrimInt:                       \
       DO_SWITCH_OFFSET(offset, P, int32_t);         \
     case Primitive::kPrimLong:                      \
@@ -151,6 +172,132 @@ static void ConstructorSetFieldObjectAt([[maybe_unused]] ArtMethod* method,
       return nullptr;                               \
   }
 
+static bool IsFloatingPointType(Primitive::Type type) {
+  return type == Primitive::kPrimFloat || type == Primitive::kPrimDouble;
+}
+
+#define CONSTANT_CASE(value, type) \
+  case (value):                    \
+    return reinterpret_cast<void*>(&ReturnConstant<type, (value)>);
+
+// We share stubs for the small constants that are commonly returned: flags, counts and
+// enumeration-like values.
+template <typename T>
+static const void* GetReturnConstantStub(int64_t constant) {
+  switch (constant) {
+    CONSTANT_CASE(-1, T)
+    CONSTANT_CASE(0, T)
+    CONSTANT_CASE(1, T)
+    CONSTANT_CASE(2, T)
+    CONSTANT_CASE(3, T)
+    CONSTANT_CASE(4, T)
+    CONSTANT_CASE(5, T)
+    CONSTANT_CASE(6, T)
+    CONSTANT_CASE(7, T)
+    default: return nullptr;
+  }
+}
+
+// Recognize:
+//   const{/4,/16} vX, constant
+//   return{-object} vX
+// Or:
+//   const-wide/16 vX, constant
+//   return-wide vX
+static const void* TryMatchReturnConstant(const CodeItemDataAccessor& accessor, ArtMethod* method)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  Primitive::Type return_type = method->GetReturnTypePrimitive();
+  if (IsFloatingPointType(return_type)) {
+    // Returned in a floating point register, and too rare to bother.
+    return nullptr;
+  }
+  int32_t register_index = -1;
+  int64_t constant = 0;
+  bool is_wide = false;
+  for (DexInstructionPcPair pair : accessor) {
+    const Instruction& instruction = pair.Inst();
+    switch (pair->Opcode()) {
+      case Instruction::CONST_4:
+        register_index = instruction.VRegA_11n();
+        constant = instruction.VRegB_11n();
+        break;
+      case Instruction::CONST_16:
+        register_index = instruction.VRegA_21s();
+        constant = instruction.VRegB_21s();
+        break;
+      case Instruction::CONST_WIDE_16:
+        register_index = instruction.VRegA_21s();
+        constant = instruction.VRegB_21s();
+        is_wide = true;
+        break;
+      case Instruction::RETURN:
+      case Instruction::RETURN_OBJECT:
+        if (is_wide || register_index != instruction.VRegA_11x()) {
+          return nullptr;
+        }
+        if (pair->Opcode() == Instruction::RETURN_OBJECT && constant != 0) {
+          return nullptr;
+        }
+        return GetReturnConstantStub<int32_t>(constant);
+      case Instruction::RETURN_WIDE:
+        if (!is_wide || register_index != instruction.VRegA_11x()) {
+          return nullptr;
+        }
+        return GetReturnConstantStub<int64_t>(constant);
+      default:
+        return nullptr;
+    }
+  }
+  return nullptr;
+}
+
+// Recognize:
+//   return{-object,-wide} vX
+// where vX is an argument.
+static const void* TryMatchReturnArgument(const CodeItemDataAccessor& accessor,
+                                          ArtMethod* method,
+                                          const Instruction& instruction)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  if (IsFloatingPointType(method->GetReturnTypePrimitive())) {
+    return nullptr;
+  }
+  uint32_t returned_reg = instruction.VRegA_11x();
+  uint32_t vreg = accessor.RegistersSize() - accessor.InsSize();
+  size_t index = 0u;
+  if (!method->IsStatic()) {
+    if (vreg == returned_reg) {
+      return reinterpret_cast<void*>(&ReturnFirstArgMethod);
+    }
+    ++vreg;
+    ++index;
+  }
+  std::string_view shorty = method->GetShortyView();
+  for (size_t i = 1; i < shorty.size(); ++i, ++index) {
+    Primitive::Type type = Primitive::GetType(shorty[i]);
+    if (IsFloatingPointType(type)) {
+      // Floating point arguments are passed in different registers.
+      return nullptr;
+    }
+    if (vreg == returned_reg) {
+      if (index == 0u && !Primitive::Is64BitType(type)) {
+        return reinterpret_cast<void*>(&ReturnFirstArgMethod);
+      }
+      if (kRuntimeISA != InstructionSet::kArm64) {
+        return nullptr;
+      }
+      switch (index) {
+        case 0u: return reinterpret_cast<void*>(&ReturnCoreArgAt<0u>);
+        case 1u: return reinterpret_cast<void*>(&ReturnCoreArgAt<1u>);
+        case 2u: return reinterpret_cast<void*>(&ReturnCoreArgAt<2u>);
+        case 3u: return reinterpret_cast<void*>(&ReturnCoreArgAt<3u>);
+        default: return nullptr;
+      }
+    }
+    vreg += Primitive::Is64BitType(type) ? 2u : 1u;
+  }
+  return nullptr;
+}
+
 const void* SmallPatternMatcher::TryMatch(ArtMethod* method) REQUIRES_SHARED(Locks::mutator_lock_) {
   CodeItemDataAccessor accessor(*method->GetDexFile(), method->GetCodeItem());
 
@@ -212,87 +359,44 @@ const void* SmallPatternMatcher::TryMatch(ArtMethod* method) REQUIRES_SHARED(Loc
   // Recognize:
   //   return-void
   // Or:
-  //   return-object v0
+  //   return{-object,-wide} vX, where vX is an argument.
   if (insns_size == 1u) {
     const Instruction& instruction = accessor.begin().Inst();
-    if (instruction.Opcode() == Instruction::RETURN_VOID) {
-      return reinterpret_cast<void*>(&EmptyMethod);
-    }
-
-    if (instruction.Opcode() == Instruction::RETURN_OBJECT) {
-      uint16_t number_of_vregs = accessor.RegistersSize();
-      uint16_t number_of_parameters = accessor.InsSize();
-      uint16_t obj_reg = number_of_vregs - number_of_parameters;
-      if (obj_reg == instruction.VRegA_11x()) {
-        return reinterpret_cast<void*>(&ReturnFirstArgMethod);
-      }
+    switch (instruction.Opcode()) {
+      case Instruction::RETURN_VOID:
+        return reinterpret_cast<void*>(&EmptyMethod);
+      case Instruction::RETURN:
+      case Instruction::RETURN_OBJECT:
+      case Instruction::RETURN_WIDE:
+        return TryMatchReturnArgument(accessor, method, instruction);
+      default:
+        return nullptr;
     }
-    return nullptr;
   }
 
-  // Recognize:
-  //   const vX, 0/1
-  //   return{-object} vX
-  if (insns_size == 2u) {
-    if (method->GetReturnTypePrimitive() == Primitive::kPrimFloat) {
-      // Too rare to bother.
-      return nullptr;
+  if (insns_size == 2u || insns_size == 3u) {
+    const void* stub = TryMatchReturnConstant(accessor, method);
+    if (stub != nullptr || insns_size == 2u) {
+      return stub;
     }
-    int32_t register_index = -1;
-    int32_t constant = -1;
-    for (DexInstructionPcPair pair : accessor) {
-      const Instruction& instruction = pair.Inst();
-      switch (pair->Opcode()) {
-        case Instruction::CONST_4: {
-          register_index = instruction.VRegA_11n();
-          constant = instruction.VRegB_11n();
-          if (constant != 0 && constant != 1) {
-            return nullptr;
-          }
-          break;
-        }
-        case Instruction::CONST_16: {
-          register_index = instruction.VRegA_21s();
-          constant = instruction.VRegB_21s();
-          if (constant != 0 && constant != 1) {
-            return nullptr;
-          }
-          break;
-        }
-        case Instruction::RETURN:
-        case Instruction::RETURN_OBJECT: {
-          if (register_index == instruction.VRegA_11x()) {
-            if (constant == 0) {
-              return reinterpret_cast<void*>(&ReturnZero);
-            } else if (constant == 1) {
-              return reinterpret_cast<void*>(&ReturnOne);
-            }
-          }
-          return nullptr;
-        }
-        default:
-          return nullptr;
-      }
-    }
-    return nullptr;
   }
 
   // Recognize:
-  //   iget-{object,wide,boolean} vX, v0, field
-  //   return-{object} vX
+  //   iget{-object,-wide,-boolean,-byte,-char,-short} vX, v0, field
+  //   return{-object,-wide} vX
   // Or:
-  //   iput-{object,wide,boolean} v1, v0, field
+  //   iput{-object,-wide,-boolean,-byte,-char,-short} v1, v0, field
   //   return-void
   // Or:
-  //   sget-object vX, field
-  //   return-object vX
+  //   sget{-object,-wide,-boolean,-byte,-char,-short} vX, field
+  //   return{-object,-wide} vX
   // Or:
-  //   iput-{object,wide,boolean} v1, v0, field
+  //   iput{-object,-wide,-boolean,-byte,-char,-short} v1, v0, field
   //   invoke-direct v0, j.l.Object.<init>
   //   return-void
   // Or:
   //   invoke-direct v0, j.l.Object.<init>
-  //   iput-{object,wide,boolean} v1, v0, field
+  //   iput{-object,-wide,-boolean,-byte,-char,-short} v1, v0, field
   //   return-void
   if (insns_size == 3u || insns_size == 6u) {
     DCHECK_IMPLIES(insns_size == 6u, is_recognizable_constructor);
@@ -315,23 +419,32 @@ const void* SmallPatternMatcher::TryMatch(ArtMethod* method) REQUIRES_SHARED(Loc
             return nullptr;
           }
           break;
+        case Instruction::SGET:
+        case Instruction::SGET_WIDE:
         case Instruction::SGET_OBJECT:
-          is_static = true;
-          FALLTHROUGH_INTENDED;
-        case Instruction::IPUT_OBJECT:
-        case Instruction::IGET_OBJECT:
-          is_object = true;
-          FALLTHROUGH_INTENDED;
-        case Instruction::IPUT:
+        case Instruction::SGET_BOOLEAN:
+        case Instruction::SGET_BYTE:
+        case Instruction::SGET_CHAR:
+        case Instruction::SGET_SHORT:
         case Instruction::IGET:
+        case Instruction::IGET_WIDE:
+        case Instruction::IGET_OBJECT:
         case Instruction::IGET_BOOLEAN:
+        case Instruction::IGET_BYTE:
+        case Instruction::IGET_CHAR:
+        case Instruction::IGET_SHORT:
+        case Instruction::IPUT:
+        case Instruction::IPUT_WIDE:
+        case Instruction::IPUT_OBJECT:
         case Instruction::IPUT_BOOLEAN:
-        case Instruction::IGET_WIDE:
-        case Instruction::IPUT_WIDE: {
-          is_put = (pair->Opcode() == Instruction::IPUT ||
-                    pair->Opcode() == Instruction::IPUT_OBJECT ||
-                    pair->Opcode() == Instruction::IPUT_BOOLEAN ||
-                    pair->Opcode() == Instruction::IPUT_WIDE);
+        case Instruction::IPUT_BYTE:
+        case Instruction::IPUT_CHAR:
+        case Instruction::IPUT_SHORT: {
+          is_static = IsInstructionSGet(pair->Opcode());
+          is_put = IsInstructionIPut(pair->Opcode());
+          is_object = (pair->Opcode() == Instruction::SGET_OBJECT ||
+                       pair->Opcode() == Instruction::IGET_OBJECT ||
+                       pair->Opcode() == Instruction::IPUT_OBJECT);
           if (!is_static && obj_reg != instruction.VRegB_22c()) {
             // The field access is not on the first parameter.
             return nullptr;
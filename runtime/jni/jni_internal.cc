@@ -145,6 +145,25 @@ size_t VisitUtf8Chars(const char* utf8, size_t byte_count, GoodFunc good, BadFun
   return len;
 }
 
+// Returns whether all the `length` bytes at `utf8` are 7-bit ASCII, checking a word at a time.
+static bool IsAsciiUtf8(const char* utf8, size_t length) {
+  static constexpr uint64_t kHighBits = UINT64_C(0x8080808080808080);
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, utf8 + i, sizeof(uint64_t));
+    if ((word & kHighBits) != 0u) {
+      return false;
+    }
+  }
+  for (; i != length; ++i) {
+    if ((static_cast<uint8_t>(utf8[i]) & 0x80u) != 0u) {
+      return false;
+    }
+  }
+  return true;
+}
+
 ALWAYS_INLINE
 static inline uint16_t DecodeModifiedUtf8Character(const char* ptr, size_t length) {
   switch (length) {
@@ -173,6 +192,11 @@ class NewStringUTFVisitor {
     DCHECK_IMPLIES(string->IsCompressed(), mirror::kUseStringCompression);
     if (string->IsCompressed()) {
       uint8_t* value_compressed = string->GetValueCompressed();
+      if (!has_bad_char_ && static_cast<size_t>(string->GetLength()) == utf8_length_) {
+        // Only one-byte encodings, i.e. plain ASCII. Copy the bytes directly.
+        memcpy(value_compressed, utf_, utf8_length_);
+        return;
+      }
       auto good = [&](const char* ptr, size_t length) {
         uint16_t c = DecodeModifiedUtf8Character(ptr, length);
         DCHECK(mirror::String::IsASCII(c));
@@ -2000,33 +2024,40 @@ class JNI {
     size_t utf8_length = strlen(utf);
     bool compressible = mirror::kUseStringCompression;
     bool has_bad_char = false;
-    size_t utf16_length = VisitUtf8Chars(
-        utf,
-        utf8_length,
-        /*good=*/ [&compressible](const char* ptr, size_t length) {
-          if (mirror::kUseStringCompression) {
-            switch (length) {
-              case 1:
-                DCHECK(mirror::String::IsASCII(*ptr));
-                break;
-              case 2:
-              case 3:
-                if (!mirror::String::IsASCII(DecodeModifiedUtf8Character(ptr, length))) {
+    // Most strings from native code are plain ASCII, for which the UTF-16 length is the byte count
+    // and nothing needs to be decoded.
+    size_t utf16_length;
+    if (IsAsciiUtf8(utf, utf8_length)) {
+      utf16_length = utf8_length;
+    } else {
+      utf16_length = VisitUtf8Chars(
+          utf,
+          utf8_length,
+          /*good=*/ [&compressible](const char* ptr, size_t length) {
+            if (mirror::kUseStringCompression) {
+              switch (length) {
+                case 1:
+                  DCHECK(mirror::String::IsASCII(*ptr));
+                  break;
+                case 2:
+                case 3:
+                  if (!mirror::String::IsASCII(DecodeModifiedUtf8Character(ptr, length))) {
+                    compressible = false;
+                  }
+                  break;
+                default:
+                  // 4-byte sequences lead to uncompressible surroate pairs.
+                  DCHECK_EQ(length, 4u);
                   compressible = false;
-                }
-                break;
-              default:
-                // 4-byte sequences lead to uncompressible surroate pairs.
-                DCHECK_EQ(length, 4u);
-                compressible = false;
-                break;
+                  break;
+              }
             }
-          }
-        },
-        /*bad=*/ [&has_bad_char]() {
-          static_assert(mirror::String::IsASCII(kBadUtf8ReplacementChar));  // Compressible.
-          has_bad_char = true;
-        });
+          },
+          /*bad=*/ [&has_bad_char]() {
+            static_assert(mirror::String::IsASCII(kBadUtf8ReplacementChar));  // Compressible.
+            has_bad_char = true;
+          });
+    }
     if (UNLIKELY(utf16_length > static_cast<uint32_t>(std::numeric_limits<int32_t>::max()))) {
       // Converting the utf16_length to int32_t would overflow. Explicitly throw an OOME.
       std::string error =
@@ -195,6 +195,25 @@ constexpr std::optional<int32_t> EncodeDatumId(DatumId datum_id) {
     case DatumId::kTimeElapsedDelta:
       return std::make_optional(
           statsd::ART_DATUM_DELTA_REPORTED__KIND__ART_DATUM_DELTA_TIME_ELAPSED_MS);
+    case DatumId::kJitRecompilationCount:
+    case DatumId::kJitThrottledTime:
+    case DatumId::kJitOsrEntryCount:
+    case DatumId::kJitDeoptimizationCount:
+    case DatumId::kJitSpeculationDisabledCount:
+    case DatumId::kYoungObjectSurvivalRate:
+    case DatumId::kDeoptimizationCount:
+    case DatumId::kDeoptimizationTotalTime:
+    case DatumId::kChaInvalidatedCodeCount:
+    case DatumId::kChaCheckpointCount:
+    case DatumId::kThreadSuspendAllTime:
+    case DatumId::kJitOsrQueueTime:
+    case DatumId::kJitBaselineQueueTime:
+    case DatumId::kJitOptimizedQueueTime:
+    case DatumId::kHeapTrimCount:
+    case DatumId::kHeapTrimReclaimedBytes:
+    case DatumId::kHeapTrimTotalTime:
+      // No atom yet, only reported through the other metrics backends.
+      return std::nullopt;
   }
 }
 
@@ -34,9 +34,11 @@
 #include "class_linker-inl.h"
 #include "class_loader.h"
 #include "class_root-inl.h"
+#include "dex/code_item_accessors-inl.h"
 #include "dex/descriptors_names.h"
 #include "dex/dex_file-inl.h"
 #include "dex/dex_file_annotations.h"
+#include "dex/dex_instruction-inl.h"
 #include "dex/signature-inl.h"
 #include "dex_cache-inl.h"
 #include "field.h"
@@ -1045,6 +1047,99 @@ ArtMethod* Class::FindClassInitializer(PointerSize pointer_size) {
   return nullptr;
 }
 
+bool Class::HasTrivialClassInitializer(PointerSize pointer_size) {
+  // Check if the class has encoded fields that trigger bytecode execution.
+  // (Encoded fields are just a different representation of <clinit>.)
+  if (NumStaticFields() != 0u) {
+    DCHECK(GetClassDef() != nullptr);
+    EncodedStaticFieldValueIterator it(GetDexFile(), *GetClassDef());
+    for (; it.HasNext(); it.Next()) {
+      switch (it.GetValueType()) {
+        case EncodedArrayValueIterator::ValueType::kBoolean:
+        case EncodedArrayValueIterator::ValueType::kByte:
+        case EncodedArrayValueIterator::ValueType::kShort:
+        case EncodedArrayValueIterator::ValueType::kChar:
+        case EncodedArrayValueIterator::ValueType::kInt:
+        case EncodedArrayValueIterator::ValueType::kLong:
+        case EncodedArrayValueIterator::ValueType::kFloat:
+        case EncodedArrayValueIterator::ValueType::kDouble:
+        case EncodedArrayValueIterator::ValueType::kNull:
+        case EncodedArrayValueIterator::ValueType::kString:
+          // Primitive, null or j.l.String initialization is permitted.
+          break;
+        case EncodedArrayValueIterator::ValueType::kType:
+          // Type initialization can load classes and execute bytecode through a class loader
+          // which can execute arbitrary bytecode. We do not optimize for known class loaders;
+          // kType is rarely used (if ever).
+          return false;
+        default:
+          // Other types in the encoded static field list are rejected by the DexFileVerifier.
+          LOG(FATAL) << "Unexpected type " << it.GetValueType();
+          UNREACHABLE();
+      }
+    }
+  }
+  // Check if the class has <clinit> that executes arbitrary code.
+  // Initialization of static fields of the class itself with constants is allowed.
+  ArtMethod* clinit = FindClassInitializer(pointer_size);
+  if (clinit != nullptr) {
+    const DexFile& dex_file = *clinit->GetDexFile();
+    CodeItemInstructionAccessor accessor(dex_file, clinit->GetCodeItem());
+    for (DexInstructionPcPair it : accessor) {
+      switch (it->Opcode()) {
+        case Instruction::CONST_4:
+        case Instruction::CONST_16:
+        case Instruction::CONST:
+        case Instruction::CONST_HIGH16:
+        case Instruction::CONST_WIDE_16:
+        case Instruction::CONST_WIDE_32:
+        case Instruction::CONST_WIDE:
+        case Instruction::CONST_WIDE_HIGH16:
+        case Instruction::CONST_STRING:
+        case Instruction::CONST_STRING_JUMBO:
+          // Primitive, null or j.l.String initialization is permitted.
+          break;
+        case Instruction::RETURN_VOID:
+          break;
+        case Instruction::SPUT:
+        case Instruction::SPUT_WIDE:
+        case Instruction::SPUT_OBJECT:
+        case Instruction::SPUT_BOOLEAN:
+        case Instruction::SPUT_BYTE:
+        case Instruction::SPUT_CHAR:
+        case Instruction::SPUT_SHORT:
+          // Only initialization of a static field of the same class is permitted.
+          if (dex_file.GetFieldId(it->VRegB_21c()).class_idx_ != GetDexTypeIndex()) {
+            return false;
+          }
+          break;
+        case Instruction::NEW_ARRAY:
+          // Only primitive arrays are permitted.
+          if (Primitive::GetType(dex_file.GetTypeDescriptor(dex_file.GetTypeId(
+                  dex::TypeIndex(it->VRegC_22c())))[1]) == Primitive::kPrimNot) {
+            return false;
+          }
+          break;
+        case Instruction::APUT:
+        case Instruction::APUT_WIDE:
+        case Instruction::APUT_BOOLEAN:
+        case Instruction::APUT_BYTE:
+        case Instruction::APUT_CHAR:
+        case Instruction::APUT_SHORT:
+        case Instruction::FILL_ARRAY_DATA:
+        case Instruction::NOP:
+          // Allow initialization of primitive arrays (only constants can be stored).
+          // Note: We expect NOPs used for fill-array-data-payload but accept all NOPs
+          // (even unreferenced switch payloads if they make it through the verifier).
+          break;
+        default:
+          return false;
+      }
+    }
+  }
+  return true;
+}
+
 static std::tuple<bool, ArtField*> FindFieldByNameAndType(const DexFile& dex_file,
                                                           LengthPrefixedArray<ArtField>* fields,
                                                           std::string_view name,
@@ -1014,6 +1014,11 @@ class EXPORT MANAGED Class final : public Object {
 
   ArtMethod* FindClassInitializer(PointerSize pointer_size) REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Returns whether initializing this class only stores constants, primitive arrays or
+  // strings to its own static fields, so that the time of initialization is unobservable.
+  // Superclasses and interfaces are not checked.
+  bool HasTrivialClassInitializer(PointerSize pointer_size) REQUIRES_SHARED(Locks::mutator_lock_);
+
   bool HasDefaultMethods() REQUIRES_SHARED(Locks::mutator_lock_) {
     return (GetAccessFlags() & kAccHasDefaultMethod) != 0;
   }
@@ -46,15 +46,17 @@ class MANAGED ClassLoader : public Object {
 
   ObjPtr<ClassLoader> GetParent() REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // The class table is read without Locks::classlinker_classes_lock_ when defining and looking
+  // up classes, so it is published with a volatile store and read with a volatile load.
   template<VerifyObjectFlags kVerifyFlags = kDefaultVerifyFlags>
   ClassTable* GetClassTable() REQUIRES_SHARED(Locks::mutator_lock_) {
     return reinterpret_cast<ClassTable*>(
-        GetField64<kVerifyFlags>(OFFSET_OF_OBJECT_MEMBER(ClassLoader, class_table_)));
+        GetField64Volatile<kVerifyFlags>(OFFSET_OF_OBJECT_MEMBER(ClassLoader, class_table_)));
   }
 
   void SetClassTable(ClassTable* class_table) REQUIRES_SHARED(Locks::mutator_lock_) {
-    SetField64<false>(OFFSET_OF_OBJECT_MEMBER(ClassLoader, class_table_),
-                      reinterpret_cast<uint64_t>(class_table));
+    SetField64Volatile<false>(OFFSET_OF_OBJECT_MEMBER(ClassLoader, class_table_),
+                              reinterpret_cast<uint64_t>(class_table));
   }
 
   LinearAlloc* GetAllocator() REQUIRES_SHARED(Locks::mutator_lock_) {
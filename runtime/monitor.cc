@@ -16,10 +16,14 @@
 
 #include <android-base/properties.h>
 
+#include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "android-base/stringprintf.h"
 #include "art_method-inl.h"
+#include "base/histogram-inl.h"
 #include "base/logging.h"  // For VLOG.
 #include "base/mutex.h"
 #include "base/quasi_atomic.h"
@@ -53,6 +57,9 @@ using android::base::StringPrintf;
 static constexpr uint64_t kDebugThresholdFudgeFactor = kIsDebugBuild ? 10 : 1;
 static constexpr uint64_t kLongWaitMs = 100 * kDebugThresholdFudgeFactor;
 
+// Upper bound for the adaptive spin limit of a monitor, see Monitor::spin_limit_.
+static constexpr uint8_t kMaxMonitorSpins = 4 * Mutex::kDefaultMaxTryLockSpins;
+
 /*
  * Every Object has a monitor associated with it, but not every Object is actually locked.  Even
  * the ones that are locked do not need a full-fledged monitor until a) there is actual contention
@@ -84,6 +91,16 @@ static constexpr uint64_t kLongWaitMs = 100 * kDebugThresholdFudgeFactor;
 uint32_t Monitor::lock_profiling_threshold_ = 0;
 uint32_t Monitor::stack_dump_lock_profiling_threshold_ = 0;
 
+// Sampled contention events aggregated by "owner method -> contending method (class of the locked
+// object)". Methods and classes are recorded by name so that the profile stays valid after class
+// unloading. The number of distinct sites is bounded; events at new sites beyond the limit are only
+// counted.
+static constexpr size_t kMaxContentionProfileSites = 256;
+static Mutex g_contention_profile_lock("Monitor contention profile lock", kGenericBottomLock);
+static std::map<std::string, std::unique_ptr<Histogram<uint64_t>>> g_contention_profile
+    GUARDED_BY(g_contention_profile_lock);
+static uint64_t g_contention_profile_dropped_events GUARDED_BY(g_contention_profile_lock) = 0;
+
 void Monitor::Init(uint32_t lock_profiling_threshold,
                    uint32_t stack_dump_lock_profiling_threshold) {
   // It isn't great to always include the debug build fudge factor for command-
@@ -94,9 +111,50 @@ void Monitor::Init(uint32_t lock_profiling_threshold,
       stack_dump_lock_profiling_threshold * kDebugThresholdFudgeFactor;
 }
 
+void Monitor::DumpContentionProfile(std::ostream& os) {
+  MutexLock mu(Thread::Current(), g_contention_profile_lock);
+  if (g_contention_profile.empty()) {
+    return;
+  }
+  os << "Monitor contention profile (sampled, wait time in ms):\n";
+  for (const auto& [site, histogram] : g_contention_profile) {
+    Histogram<uint64_t>::CumulativeData data;
+    histogram->CreateHistogram(&data);
+    os << "  " << site << ": count=" << histogram->SampleSize() << " sum=" << histogram->Sum()
+       << " max=" << histogram->Max() << " ";
+    histogram->PrintConfidenceIntervals(os, 0.99, data);
+  }
+  if (g_contention_profile_dropped_events != 0) {
+    os << "  " << g_contention_profile_dropped_events << " events at other sites\n";
+  }
+}
+
+void Monitor::RecordContentionProfile(uint64_t wait_ms,
+                                      ArtMethod* owner_method,
+                                      ArtMethod* waiter_method) {
+  ObjPtr<mirror::Object> obj = GetObject();
+  std::string site = (owner_method != nullptr ? owner_method->PrettyMethod() : "<unknown>") +
+                     " -> " + ArtMethod::PrettyMethod(waiter_method) + " (" +
+                     (obj != nullptr ? obj->GetClass()->PrettyDescriptor() : "<cleared>") + ")";
+  MutexLock mu(Thread::Current(), g_contention_profile_lock);
+  auto it = g_contention_profile.find(site);
+  if (it == g_contention_profile.end()) {
+    if (g_contention_profile.size() >= kMaxContentionProfileSites) {
+      ++g_contention_profile_dropped_events;
+      return;
+    }
+    auto histogram = std::make_unique<Histogram<uint64_t>>("monitor contention",
+                                                           /*initial_bucket_width=*/ 1,
+                                                           /*max_buckets=*/ 32);
+    it = g_contention_profile.emplace(std::move(site), std::move(histogram)).first;
+  }
+  it->second->AddValue(wait_ms);
+}
+
 Monitor::Monitor(Thread* self, Thread* owner, ObjPtr<mirror::Object> obj, int32_t hash_code)
     : monitor_lock_("a monitor lock", kMonitorLock),
       num_waiters_(0),
+      spin_limit_(Mutex::kDefaultMaxTryLockSpins),
       owner_(owner),
       lock_count_(0),
       obj_(GcRoot<mirror::Object>(obj)),
@@ -131,6 +189,7 @@ Monitor::Monitor(Thread* self,
                  MonitorId id)
     : monitor_lock_("a monitor lock", kMonitorLock),
       num_waiters_(0),
+      spin_limit_(Mutex::kDefaultMaxTryLockSpins),
       owner_(owner),
       lock_count_(0),
       obj_(GcRoot<mirror::Object>(obj)),
@@ -426,8 +485,18 @@ bool Monitor::TryLock(Thread* self, bool spin) {
     lock_count_++;
     CHECK_NE(lock_count_, 0u);  // Abort on overflow.
   } else {
-    bool success = spin ? monitor_lock_.ExclusiveTryLockWithSpinning(self)
-        : monitor_lock_.ExclusiveTryLock(self);
+    bool success;
+    if (spin) {
+      uint8_t spin_limit = spin_limit_.load(std::memory_order_relaxed);
+      success = monitor_lock_.ExclusiveTryLockWithSpinning(self, spin_limit);
+      uint8_t new_spin_limit = success ? std::min<uint8_t>(spin_limit + 1u, kMaxMonitorSpins)
+                                       : std::max<uint8_t>(spin_limit / 2u, 1u);
+      if (new_spin_limit != spin_limit) {
+        spin_limit_.store(new_spin_limit, std::memory_order_relaxed);
+      }
+    } else {
+      success = monitor_lock_.ExclusiveTryLock(self);
+    }
     if (!success) {
       return false;
     }
@@ -616,6 +685,8 @@ void Monitor::Lock(Thread* self) {
                             sample_percent,
                             owners_method,
                             owners_dex_pc);
+          uint32_t pc;
+          RecordContentionProfile(wait_ms, owners_method, self->GetCurrentMethod(&pc));
         } else {
           Locks::thread_list_lock_->ExclusiveUnlock(self);
         }
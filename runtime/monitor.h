@@ -72,6 +72,10 @@ class Monitor {
 
   static void Init(uint32_t lock_profiling_threshold, uint32_t stack_dump_lock_profiling_threshold);
 
+  // Dumps the wait-time histograms of the contention events sampled because of the lock profiling
+  // threshold, aggregated by owner method, contending method and class of the locked object.
+  static void DumpContentionProfile(std::ostream& os);
+
   // Return the thread id of the lock owner or 0 when there is no owner.
   EXPORT static uint32_t GetLockOwnerThreadId(ObjPtr<mirror::Object> obj)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -225,6 +229,10 @@ class Monitor {
                           uint32_t owner_dex_pc)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Adds a sampled contention event to the contention profile dumped on SIGQUIT.
+  void RecordContentionProfile(uint64_t wait_ms, ArtMethod* owner_method, ArtMethod* waiter_method)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   static void FailedUnlock(ObjPtr<mirror::Object> obj,
                            uint32_t expected_owner_thread_id,
                            uint32_t found_owner_thread_id,
@@ -332,6 +340,12 @@ class Monitor {
   // monitor acquisition. Prevents deflation.
   std::atomic<size_t> num_waiters_;
 
+  // Number of times a contended acquisition retries before blocking on monitor_lock_. It grows
+  // while spinning acquires the lock and shrinks when it doesn't, so monitors guarding short
+  // critical sections avoid the futex round-trip and long-held monitors don't burn CPU.
+  // Updated racily; it's only a heuristic.
+  std::atomic<uint8_t> spin_limit_;
+
   // Which thread currently owns the lock? monitor_lock_ only keeps the tid.
   // Only set while holding monitor_lock_. Non-locking readers only use it to
   // compare to self or for debugging.
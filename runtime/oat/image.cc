@@ -34,8 +34,8 @@
 namespace art HIDDEN {
 
 const uint8_t ImageHeader::kImageMagic[] = { 'a', 'r', 't', '\n' };
-// Last change: Add intrinsics for Unsafe/JdkUnsafe.arrayBaseOffset.
-const uint8_t ImageHeader::kImageVersion[] = { '1', '1', '4', '\0' };
+// Last change: Add the Unsafe.get*(long) and Unsafe.put*(long, ...) intrinsics.
+const uint8_t ImageHeader::kImageVersion[] = { '1', '1', '8', '\0' };
 
 ImageHeader::ImageHeader(uint32_t image_reservation_size,
                          uint32_t component_count,
@@ -76,7 +76,9 @@ OatHeader::OatHeader(InstructionSet instruction_set,
       quick_imt_conflict_trampoline_offset_(0),
       quick_resolution_trampoline_offset_(0),
       quick_to_interpreter_bridge_offset_(0),
-      nterp_trampoline_offset_(0) {
+      nterp_trampoline_offset_(0),
+      startup_code_offset_(0),
+      startup_code_size_(0) {
   // Don't want asserts in header as they would be checked in each file that includes it. But the
   // fields are private, so we check inside a method.
   static_assert(decltype(magic_)().size() == kOatMagic.size(),
@@ -339,6 +341,24 @@ void OatHeader::SetNterpTrampolineOffset(uint32_t offset) {
   nterp_trampoline_offset_ = offset;
 }
 
+uint32_t OatHeader::GetStartupCodeOffset() const {
+  DCHECK(IsValid());
+  return startup_code_offset_;
+}
+
+uint32_t OatHeader::GetStartupCodeSize() const {
+  DCHECK(IsValid());
+  return startup_code_size_;
+}
+
+void OatHeader::SetStartupCodeRange(uint32_t offset, uint32_t size) {
+  CHECK(size == 0 || offset >= executable_offset_);
+  DCHECK(IsValid());
+
+  startup_code_offset_ = offset;
+  startup_code_size_ = size;
+}
+
 uint32_t OatHeader::GetKeyValueStoreSize() const {
   CHECK(IsValid());
   return key_value_store_size_;
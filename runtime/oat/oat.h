@@ -44,8 +44,8 @@ std::ostream& operator<<(std::ostream& stream, StubType stub_type);
 class EXPORT PACKED(4) OatHeader {
  public:
   static constexpr std::array<uint8_t, 4> kOatMagic { { 'o', 'a', 't', '\n' } };
-  // Last oat version changed reason: Adding new entrypoints for InvokeExact intrisic.
-  static constexpr std::array<uint8_t, 4> kOatVersion{{'2', '4', '7', '\0'}};
+  // Last oat version changed reason: Add the startup code range.
+  static constexpr std::array<uint8_t, 4> kOatVersion{{'2', '4', '8', '\0'}};
 
   static constexpr const char* kDex2OatCmdLineKey = "dex2oat-cmdline";
   static constexpr const char* kDebuggableKey = "debuggable";
@@ -108,6 +108,12 @@ class EXPORT PACKED(4) OatHeader {
   uint32_t GetNterpTrampolineOffset() const;
   void SetNterpTrampolineOffset(uint32_t offset);
 
+  // Range of the code of methods that the profile marks as startup methods. The
+  // compiler lays them out together so that they can be read ahead on load.
+  uint32_t GetStartupCodeOffset() const;
+  uint32_t GetStartupCodeSize() const;
+  void SetStartupCodeRange(uint32_t offset, uint32_t size);
+
   InstructionSet GetInstructionSet() const;
   uint32_t GetInstructionSetFeaturesBitmap() const;
 
@@ -155,6 +161,8 @@ class EXPORT PACKED(4) OatHeader {
   uint32_t quick_resolution_trampoline_offset_;
   uint32_t quick_to_interpreter_bridge_offset_;
   uint32_t nterp_trampoline_offset_;
+  uint32_t startup_code_offset_;
+  uint32_t startup_code_size_;
 
   uint32_t key_value_store_size_;
   uint8_t key_value_store_[0];  // note variable width data at end
@@ -19,18 +19,24 @@
 #include <stdlib.h>
 #include <sys/stat.h>
 
+#include <atomic>
 #include <memory>
 #include <queue>
+#include <set>
 #include <vector>
 
 #include "android-base/file.h"
 #include "android-base/stringprintf.h"
 #include "android-base/strings.h"
 #include "art_field-inl.h"
+#include "base/array_ref.h"
+#include "base/bit_utils.h"
 #include "base/bit_vector-inl.h"
+#include "base/casts.h"
 #include "base/file_utils.h"
 #include "base/logging.h"  // For VLOG.
 #include "base/mutex-inl.h"
+#include "base/os.h"
 #include "base/sdk_version.h"
 #include "base/stl_util.h"
 #include "base/systrace.h"
@@ -51,6 +57,7 @@
 #include "oat_file.h"
 #include "oat_file_assistant.h"
 #include "obj_ptr-inl.h"
+#include "profile/profile_compilation_info.h"
 #include "runtime_image.h"
 #include "scoped_thread_state_change-inl.h"
 #include "thread-current-inl.h"
@@ -74,6 +81,22 @@ static const bool kEnableRuntimeAppImage = true;
 static const char* kDisableAppImageKeyword = "_disable_art_image_";
 #endif
 
+// Madvise [begin, end), which does not need to be page aligned, but no more than
+// `size_limit` bytes of it. Used for the parts of the oat and vdex files that are read
+// during startup but may lie beyond the range madvised for the whole file. A limit of 0
+// disables the madvise, like it does for the whole file.
+static void MadviseStartupRange(const uint8_t* begin,
+                                const uint8_t* end,
+                                const std::string& file_name,
+                                size_t size_limit) {
+  if (begin == end || size_limit == 0u) {
+    return;
+  }
+  DCHECK_LT(begin, end);
+  const size_t size = dchecked_integral_cast<size_t>(end - AlignDown(begin, gPageSize));
+  Runtime::MadviseFileForRange(size_limit, size, begin, end, file_name);
+}
+
 const OatFile* OatFileManager::RegisterOatFile(std::unique_ptr<const OatFile> oat_file,
                                                bool in_memory) {
   // Use class_linker vlog to match the log for dex file registration.
@@ -277,6 +300,45 @@ std::vector<std::unique_ptr<const DexFile>> OatFileManager::OpenDexFilesFromOat(
                                      oat_file->Begin(),
                                      oat_file->End(),
                                      oat_file->GetLocation());
+        // The code of startup methods is about to run, read it ahead even when it lies
+        // beyond the range above. The odex limit still bounds how much of it we read.
+        const OatHeader& oat_header = oat_file->GetOatHeader();
+        const uint32_t startup_code_offset = oat_header.GetStartupCodeOffset();
+        const uint32_t startup_code_size = oat_header.GetStartupCodeSize();
+        if (compilation_enabled &&
+            madvise_size_limit != 0u &&
+            startup_code_size != 0u &&
+            startup_code_offset + startup_code_size > madvise_size_limit) {
+          const uint8_t* startup_code = oat_file->Begin() + startup_code_offset;
+          VLOG(oat) << "Madvising startup code of oat file: " << oat_file->GetLocation();
+          MadviseStartupRange(startup_code,
+                              startup_code + startup_code_size,
+                              oat_file->GetLocation(),
+                              madvise_size_limit);
+        }
+        // Class lookups and verification read the type lookup tables and the verifier
+        // deps of the vdex file at random offsets, read these sections ahead as well.
+        // Like the dex files madvised below, they are bounded by the vdex limit.
+        const VdexFile* vdex_file = oat_file->GetVdexFile();
+        size_t vdex_size_limit = runtime->GetMadviseWillNeedTotalDexSize();
+        if (vdex_file != nullptr && vdex_file->IsValid() && vdex_size_limit != 0u) {
+          VLOG(oat) << "Madvising vdex sections of: " << vdex_file->GetName();
+          ArrayRef<const uint8_t> verifier_deps = vdex_file->GetVerifierDepsData();
+          MadviseStartupRange(verifier_deps.begin(),
+                              verifier_deps.end(),
+                              vdex_file->GetName(),
+                              vdex_size_limit);
+          vdex_size_limit -= std::min(vdex_size_limit, verifier_deps.size());
+          if (vdex_file->HasTypeLookupTableSection()) {
+            const VdexFile::VdexSectionHeader& section =
+                vdex_file->GetSectionHeader(VdexSection::kTypeLookupTableSection);
+            const uint8_t* tables = vdex_file->Begin() + section.section_offset;
+            MadviseStartupRange(tables,
+                                tables + section.section_size,
+                                vdex_file->GetName(),
+                                vdex_size_limit);
+          }
+        }
       }
 
       ScopedTrace app_image_timing("AppImage:Loading");
@@ -568,10 +630,13 @@ std::vector<std::unique_ptr<const DexFile>> OatFileManager::OpenDexFilesFromOat_
   }
 
   // Load dex files. Skip structural dex file verification if vdex was found
-  // and dex checksums matched.
+  // and dex checksums matched. The checksum itself is not checked here: it
+  // protects against corrupt storage, which does not apply to memory handed over
+  // by the app, and computing it reads the whole file on the loading thread.
+  // Background verification checks it before writing a vdex keyed by it.
   std::vector<std::unique_ptr<const DexFile>> dex_files;
   for (size_t i = 0; i < dex_mem_maps.size(); ++i) {
-    static constexpr bool kVerifyChecksum = true;
+    static constexpr bool kVerifyChecksum = false;
     ArtDexFileLoader dex_file_loader(std::move(dex_mem_maps[i]),
                                      DexFileLoader::GetMultiDexLocation(i, dex_location.c_str()));
     std::unique_ptr<const DexFile> dex_file(dex_file_loader.Open(
@@ -689,13 +754,22 @@ static bool UnlinkLeastRecentlyUsedVdexIfNeeded(const std::string& vdex_path_to_
   return true;
 }
 
-class BackgroundVerificationTask final : public Task {
+// State shared by the tasks verifying one batch of dex files. The first task
+// computes the order in which classes are verified and spawns the other tasks;
+// all tasks then pull classes from that order, so that the classes the app is
+// most likely to need first get verified first. The last task to finish merges
+// the verifier deps of all tasks and writes the vdex file.
+class BackgroundVerificationJob {
  public:
-  BackgroundVerificationTask(const std::vector<const DexFile*>& dex_files,
-                             jobject class_loader,
-                             const std::string& vdex_path)
+  BackgroundVerificationJob(const std::vector<const DexFile*>& dex_files,
+                            jobject class_loader,
+                            const std::string& vdex_path,
+                            size_t num_tasks)
       : dex_files_(dex_files),
-        vdex_path_(vdex_path) {
+        vdex_path_(vdex_path),
+        task_deps_(num_tasks),
+        pending_tasks_(num_tasks),
+        next_class_(0u) {
     Thread* const self = Thread::Current();
     ScopedObjectAccess soa(self);
     // Create a global ref for `class_loader` because it will be accessed from a different thread.
@@ -703,62 +777,145 @@ class BackgroundVerificationTask final : public Task {
     CHECK(class_loader_ != nullptr);
   }
 
-  ~BackgroundVerificationTask() {
+  ~BackgroundVerificationJob() {
     Thread* const self = Thread::Current();
     ScopedObjectAccess soa(self);
     soa.Vm()->DeleteGlobalRef(self, class_loader_);
   }
 
-  void Run(Thread* self) override {
-    std::string error_msg;
-    ClassLinker* const class_linker = Runtime::Current()->GetClassLinker();
-    verifier::VerifierDeps verifier_deps(dex_files_);
+  size_t GetNumberOfTasks() const {
+    return task_deps_.size();
+  }
 
-    // Iterate over all classes and verify them.
+  // Order classes so that the ones listed in the app's profile come first. Without
+  // a profile, or for dex files the profile does not know, keep the class def order.
+  void ComputeClassOrder() {
+    ProfileCompilationInfo profile_info(/* for_boot_image= */ false);
+    bool has_profile = LoadProfile(&profile_info);
+    std::vector<std::pair<const DexFile*, uint16_t>> remaining_classes;
     for (const DexFile* dex_file : dex_files_) {
+      std::set<dex::TypeIndex> profile_classes;
+      std::set<uint16_t> unused_methods;
+      if (has_profile) {
+        profile_info.GetClassesAndMethods(*dex_file,
+                                          &profile_classes,
+                                          &unused_methods,
+                                          &unused_methods,
+                                          &unused_methods);
+      }
       for (uint32_t cdef_idx = 0; cdef_idx < dex_file->NumClassDefs(); cdef_idx++) {
         const dex::ClassDef& class_def = dex_file->GetClassDef(cdef_idx);
-
-        // Take handles inside the loop. The background verification is low priority
-        // and we want to minimize the risk of blocking anyone else.
-        ScopedObjectAccess soa(self);
-        StackHandleScope<2> hs(self);
-        Handle<mirror::ClassLoader> h_loader(hs.NewHandle(
-            soa.Decode<mirror::ClassLoader>(class_loader_)));
-        Handle<mirror::Class> h_class(hs.NewHandle<mirror::Class>(class_linker->FindClass(
-            self,
-            dex_file->GetClassDescriptor(class_def),
-            h_loader)));
-
-        if (h_class == nullptr) {
-          DCHECK(self->IsExceptionPending());
-          self->ClearException();
-          continue;
+        if (ContainsElement(profile_classes, class_def.class_idx_)) {
+          class_order_.emplace_back(dex_file, cdef_idx);
+        } else {
+          remaining_classes.emplace_back(dex_file, cdef_idx);
         }
+      }
+    }
+    VLOG(verifier) << "Background verification of " << dex_files_[0]->GetLocation()
+                   << " starts with " << class_order_.size() << " profiled classes";
+    class_order_.insert(class_order_.end(), remaining_classes.begin(), remaining_classes.end());
+  }
 
-        if (&h_class->GetDexFile() != dex_file) {
-          // There is a different class in the class path or a parent class loader
-          // with the same descriptor. This `h_class` is not resolvable, skip it.
-          continue;
-        }
+  // Verify classes until all of them have been taken by one of the tasks.
+  void VerifyClasses(Thread* self, size_t task_index) {
+    ClassLinker* const class_linker = Runtime::Current()->GetClassLinker();
+    // Verifier deps are not thread-safe, each task records into its own and they
+    // get merged once all tasks are done.
+    std::unique_ptr<verifier::VerifierDeps> verifier_deps(
+        new verifier::VerifierDeps(dex_files_));
+
+    for (size_t i = next_class_.fetch_add(1u, std::memory_order_relaxed);
+         i < class_order_.size();
+         i = next_class_.fetch_add(1u, std::memory_order_relaxed)) {
+      const DexFile* dex_file = class_order_[i].first;
+      const dex::ClassDef& class_def = dex_file->GetClassDef(class_order_[i].second);
+
+      // Take handles inside the loop. The background verification is low priority
+      // and we want to minimize the risk of blocking anyone else.
+      ScopedObjectAccess soa(self);
+      StackHandleScope<2> hs(self);
+      Handle<mirror::ClassLoader> h_loader(hs.NewHandle(
+          soa.Decode<mirror::ClassLoader>(class_loader_)));
+      Handle<mirror::Class> h_class(hs.NewHandle<mirror::Class>(class_linker->FindClass(
+          self,
+          dex_file->GetClassDescriptor(class_def),
+          h_loader)));
+
+      if (h_class == nullptr) {
+        DCHECK(self->IsExceptionPending());
+        self->ClearException();
+        continue;
+      }
 
-        DCHECK(h_class->IsResolved()) << h_class->PrettyDescriptor();
-        class_linker->VerifyClass(self, &verifier_deps, h_class);
-        if (self->IsExceptionPending()) {
-          // ClassLinker::VerifyClass can throw, but the exception isn't useful here.
-          self->ClearException();
-        }
+      if (&h_class->GetDexFile() != dex_file) {
+        // There is a different class in the class path or a parent class loader
+        // with the same descriptor. This `h_class` is not resolvable, skip it.
+        continue;
+      }
 
-        DCHECK(h_class->IsVerified() || h_class->IsErroneous())
-            << h_class->PrettyDescriptor() << ": state=" << h_class->GetStatus();
+      // If another thread, be it the app or another task, is verifying the class,
+      // this waits on the class lock and then finds the class verified.
+      DCHECK(h_class->IsResolved()) << h_class->PrettyDescriptor();
+      class_linker->VerifyClass(self, verifier_deps.get(), h_class);
+      if (self->IsExceptionPending()) {
+        // ClassLinker::VerifyClass can throw, but the exception isn't useful here.
+        self->ClearException();
+      }
 
-        if (h_class->IsVerified()) {
-          verifier_deps.RecordClassVerified(*dex_file, class_def);
-        }
+      DCHECK(h_class->IsVerified() || h_class->IsErroneous())
+          << h_class->PrettyDescriptor() << ": state=" << h_class->GetStatus();
+
+      if (h_class->IsVerified()) {
+        verifier_deps->RecordClassVerified(*dex_file, class_def);
+      }
+    }
+
+    DCHECK(task_deps_[task_index] == nullptr);
+    task_deps_[task_index] = std::move(verifier_deps);
+    if (pending_tasks_.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+      WriteVdex();
+    }
+  }
+
+ private:
+  bool LoadProfile(ProfileCompilationInfo* profile_info) {
+    Runtime* const runtime = Runtime::Current();
+    std::string profile_path;
+    if (runtime->GetJITOptions() != nullptr) {
+      profile_path = runtime->GetJITOptions()->GetProfileSaverOptions().GetProfilePath();
+    }
+    if (profile_path.empty()) {
+      profile_path = runtime->GetAppInfo()->GetPrimaryApkReferenceProfile();
+    }
+    if (profile_path.empty() || !OS::FileExists(profile_path.c_str())) {
+      return false;
+    }
+    return profile_info->Load(profile_path, /* clear_if_invalid= */ false);
+  }
+
+  void WriteVdex() {
+    std::unique_ptr<verifier::VerifierDeps> verifier_deps = std::move(task_deps_[0]);
+    for (size_t i = 1; i < task_deps_.size(); ++i) {
+      verifier_deps->MergeWith(std::move(task_deps_[i]), dex_files_);
+    }
+
+    // Dex files loaded from memory are opened without checking their checksum.
+    // The vdex is matched against dex files by checksum, so only write it if the
+    // checksums are right.
+    for (const DexFile* dex_file : dex_files_) {
+      uint32_t checksum = dex_file->CalculateChecksum();
+      uint32_t expected_checksum = dex_file->GetHeader().checksum_;
+      if (checksum != expected_checksum) {
+        LOG(WARNING) << "Not writing vdex " << vdex_path_ << ": bad checksum for "
+                     << dex_file->GetLocation()
+                     << StringPrintf(" (%08x, expected %08x)", checksum, expected_checksum);
+        return;
       }
     }
 
     // Delete old vdex files if there are too many in the folder.
+    std::string error_msg;
     if (!UnlinkLeastRecentlyUsedVdexIfNeeded(vdex_path_, &error_msg)) {
       LOG(ERROR) << "Could not unlink old vdex files " << vdex_path_ << ": " << error_msg;
       return;
@@ -767,21 +924,53 @@ class BackgroundVerificationTask final : public Task {
     // Construct a vdex file and write `verifier_deps` into it.
     if (!VdexFile::WriteToDisk(vdex_path_,
                                dex_files_,
-                               verifier_deps,
+                               *verifier_deps,
                                &error_msg)) {
       LOG(ERROR) << "Could not write anonymous vdex " << vdex_path_ << ": " << error_msg;
       return;
     }
   }
 
+  const std::vector<const DexFile*> dex_files_;
+  jobject class_loader_;
+  const std::string vdex_path_;
+  std::vector<std::pair<const DexFile*, uint16_t>> class_order_;
+  std::vector<std::unique_ptr<verifier::VerifierDeps>> task_deps_;
+  std::atomic<size_t> pending_tasks_;
+  std::atomic<size_t> next_class_;
+
+  DISALLOW_COPY_AND_ASSIGN(BackgroundVerificationJob);
+};
+
+class BackgroundVerificationTask final : public Task {
+ public:
+  BackgroundVerificationTask(std::shared_ptr<BackgroundVerificationJob> job,
+                             ThreadPool* thread_pool,
+                             size_t task_index)
+      : job_(std::move(job)),
+        thread_pool_(thread_pool),
+        task_index_(task_index) {}
+
+  void Run(Thread* self) override {
+    if (task_index_ == 0u) {
+      // Compute the order here rather than on the thread loading the dex files,
+      // as it may need to read the profile from disk.
+      job_->ComputeClassOrder();
+      for (size_t i = 1; i < job_->GetNumberOfTasks(); ++i) {
+        thread_pool_->AddTask(self, new BackgroundVerificationTask(job_, thread_pool_, i));
+      }
+    }
+    job_->VerifyClasses(self, task_index_);
+  }
+
   void Finalize() override {
     delete this;
   }
 
  private:
-  const std::vector<const DexFile*> dex_files_;
-  jobject class_loader_;
-  const std::string vdex_path_;
+  const std::shared_ptr<BackgroundVerificationJob> job_;
+  ThreadPool* const thread_pool_;
+  const size_t task_index_;
 
   DISALLOW_COPY_AND_ASSIGN(BackgroundVerificationTask);
 };
@@ -854,15 +1043,20 @@ void OatFileManager::RunBackgroundVerification(const std::vector<const DexFile*>
   {
     WriterMutexLock mu(self, *Locks::oat_file_manager_lock_);
     if (verification_thread_pool_ == nullptr) {
-      verification_thread_pool_.reset(
-          ThreadPool::Create("Verification thread pool", /* num_threads= */ 1));
+      verification_thread_pool_.reset(ThreadPool::Create(
+          "Verification thread pool", runtime->GetBackgroundVerificationThreads()));
       verification_thread_pool_->StartWorkers(self);
     }
   }
-  verification_thread_pool_->AddTask(self, new BackgroundVerificationTask(
+  auto job = std::make_shared<BackgroundVerificationJob>(
       dex_files,
       class_loader,
-      GetVdexFilename(odex_filename)));
+      GetVdexFilename(odex_filename),
+      verification_thread_pool_->GetThreadCount());
+  verification_thread_pool_->AddTask(self, new BackgroundVerificationTask(
+      job,
+      verification_thread_pool_.get(),
+      /* task_index= */ 0u));
 }
 
 void OatFileManager::WaitForWorkersToBeCreated() {
@@ -124,7 +124,9 @@ class OatFileManager {
   void SetOnlyUseTrustedOatFiles();
   void ClearOnlyUseTrustedOatFiles();
 
-  // Spawn a background thread which verifies all classes in the given dex files.
+  // Verify all classes in the given dex files on background threads. Classes listed
+  // in the app's profile are verified first; see `-Xbackground-verification-threads`
+  // for the number of threads.
   void RunBackgroundVerification(const std::vector<const DexFile*>& dex_files,
                                  jobject class_loader);
 
@@ -167,7 +169,7 @@ class OatFileManager {
   // is not on /system, don't load it "executable".
   bool only_use_system_oat_files_;
 
-  // Single-thread pool used to run the verifier in the background.
+  // Thread pool used to run the verifier in the background.
   std::unique_ptr<ThreadPool> verification_thread_pool_;
 
   DISALLOW_COPY_AND_ASSIGN(OatFileManager);
@@ -224,12 +224,19 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
       .Define("-XX:LongGCLogThreshold=_")  // in ms
           .WithType<MillisecondsToNanoseconds>()  // store as ns
           .IntoKey(M::LongGCLogThreshold)
+      .Define("-XX:GcPauseTargetMs=_")  // in ms
+          .WithType<MillisecondsToNanoseconds>()  // store as ns
+          .IntoKey(M::GcPauseTarget)
       .Define("-XX:DumpGCPerformanceOnShutdown")
           .IntoKey(M::DumpGCPerformanceOnShutdown)
       .Define("-XX:DumpRegionInfoBeforeGC")
           .IntoKey(M::DumpRegionInfoBeforeGC)
       .Define("-XX:DumpRegionInfoAfterGC")
           .IntoKey(M::DumpRegionInfoAfterGC)
+      .Define("-XX:UseTransparentHugePages")
+          .IntoKey(M::UseTransparentHugePages)
+      .Define("-XX:UseNumaAwareRegionAllocation")
+          .IntoKey(M::UseNumaAwareRegionAllocation)
       .Define("-XX:DumpJITInfoOnShutdown")
           .IntoKey(M::DumpJITInfoOnShutdown)
       .Define("-XX:IgnoreMaxFootprint")
@@ -249,6 +256,10 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
           .WithType<bool>()
           .WithValueMap({{"false", false}, {"true", true}})
           .IntoKey(M::DumpNativeStackOnSigQuit)
+      .Define("-XX:CacheElfFilesForStackDumps:_")
+          .WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .IntoKey(M::CacheElfFilesForStackDumps)
       .Define("-XX:MadviseRandomAccess:_")
           .WithHelp("Deprecated option")
           .WithType<bool>()
@@ -271,6 +282,18 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
           .WithType<bool>()
           .WithValueMap({{"false", false}, {"true", true}})
           .IntoKey(M::UseProfiledJitCompilation)
+      .Define("-Xjitprefilldexcaches:_")
+          .WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .IntoKey(M::PrefillDexCachesFromProfile)
+      .Define("-Xjitinitclasses:_")
+          .WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .IntoKey(M::InitializeClassesFromProfile)
+      .Define("-Xjitearlyosr:_")
+          .WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .IntoKey(M::UseEarlyOsrCompilation)
       .Define("-Xjitinitialsize:_")
           .WithType<MemoryKiB>()
           .IntoKey(M::JITCodeCacheInitialCapacity)
@@ -292,6 +315,9 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
       .Define("-Xjitzygotepthreadpriority:_")
           .WithType<int>()
           .IntoKey(M::JITZygotePoolThreadPthreadPriority)
+      .Define("-Xjitthreads:_")
+          .WithType<unsigned int>()
+          .IntoKey(M::JITPoolThreads)
       .Define("-Xjitsaveprofilinginfo")
           .WithType<ProfileSaverOptions>()
           .AppendValues()
@@ -314,6 +340,7 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
                "-Xps-min-notification-before-wake:_",
                "-Xps-max-notification-before-wake:_",
                "-Xps-inline-cache-threshold:_",
+               "-Xps-sampling-interval-ms:_",
                "-Xps-profile-path:_"})
           .WithHelp("profile-saver options -Xps-<key>:<value>")
           .WithType<ProfileSaverOptions>()
@@ -445,10 +472,17 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
       .Define("-Xverifier-logging-threshold=_")
           .WithType<unsigned int>()
           .IntoKey(M::VerifierLoggingThreshold)
+      .Define("-Xbackground-verification-threads=_")
+          .WithType<unsigned int>()
+          .IntoKey(M::BackgroundVerificationThreads)
       .Define("-XX:FastClassNotFoundException=_")
           .WithType<bool>()
           .WithValueMap({{"false", false}, {"true", true}})
           .IntoKey(M::FastClassNotFoundException)
+      .Define("-XX:UseClassPathIndex=_")
+          .WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .IntoKey(M::UseClassPathIndex)
       .Define("-Xopaque-jni-ids:_")
           .WithHelp("Control the representation of jmethodID and jfieldID values")
           .WithType<JniIdType>()
@@ -478,7 +512,18 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
       .Define("-XX:PerfettoJavaHeapStackProf=_")
           .WithType<bool>()
           .WithValueMap({{"false", false}, {"true", true}})
-          .IntoKey(M::PerfettoJavaHeapStackProf);
+          .IntoKey(M::PerfettoJavaHeapStackProf)
+      .Define("-XX:HprofDumpInChild=_")
+          .WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .IntoKey(M::HprofDumpInChild)
+      .Define("-XX:AllocationSiteSamplingInterval=_")
+          .WithType<unsigned int>()
+          .IntoKey(M::AllocationSiteSamplingInterval)
+      .Define("-XX:GcSurvivalTracking=_")
+          .WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .IntoKey(M::GcSurvivalTracking);
   // clang-format on
 
   FlagBase::AddFlagsToCmdlineParser(parser_builder.get());
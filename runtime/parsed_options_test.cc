@@ -65,6 +65,7 @@ TEST_F(ParsedOptionsTest, ParsedOptions) {
   options.push_back(std::make_pair("-Xss1m", nullptr));
   options.push_back(std::make_pair("-XX:HeapTargetUtilization=0.75", nullptr));
   options.push_back(std::make_pair("-XX:StopForNativeAllocs=200m", nullptr));
+  options.push_back(std::make_pair("-XX:GcPauseTargetMs=8", nullptr));
   options.push_back(std::make_pair("-Dfoo=bar", nullptr));
   options.push_back(std::make_pair("-Dbaz=qux", nullptr));
   options.push_back(std::make_pair("-verbose:gc,class,jni", nullptr));
@@ -95,6 +96,7 @@ TEST_F(ParsedOptionsTest, ParsedOptions) {
   EXPECT_PARSED_EQ(1 * MB, Opt::StackSize);
   EXPECT_PARSED_EQ(200 * MB, Opt::StopForNativeAllocs);
   EXPECT_DOUBLE_EQ(0.75, map.GetOrDefault(Opt::HeapTargetUtilization));
+  EXPECT_EQ(MsToNs(8), map.GetOrDefault(Opt::GcPauseTarget).GetNanoseconds());
   EXPECT_TRUE(reinterpret_cast<void*>(test_vfprintf) == map.GetOrDefault(Opt::HookVfprintf));
   EXPECT_TRUE(reinterpret_cast<void*>(test_exit) == map.GetOrDefault(Opt::HookExit));
   EXPECT_TRUE(reinterpret_cast<void*>(test_abort) == map.GetOrDefault(Opt::HookAbort));
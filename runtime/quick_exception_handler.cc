@@ -25,6 +25,7 @@
 #include "base/array_ref.h"
 #include "base/globals.h"
 #include "base/logging.h"  // For VLOG_IS_ON.
+#include "base/metrics/metrics.h"
 #include "base/pointer_size.h"
 #include "base/systrace.h"
 #include "dex/dex_file_types.h"
@@ -43,6 +44,7 @@
 #include "nterp_helpers.h"
 #include "oat/oat_quick_method_header.h"
 #include "oat/stack_map.h"
+#include "runtime.h"
 #include "stack.h"
 
 namespace art HIDDEN {
@@ -709,6 +711,10 @@ void QuickExceptionHandler::DeoptimizeStack(bool skip_method_exit_callbacks) {
     self_->DumpStack(LOG_STREAM(INFO) << "Deoptimizing: ");
   }
 
+  metrics::ArtMetrics* metrics = Runtime::Current()->GetMetrics();
+  metrics::AutoTimer timer{metrics->DeoptimizationTotalTime()};
+  metrics->DeoptimizationCount()->AddOne();
+
   DeoptimizeStackVisitor visitor(self_, context_.get(), this, false, skip_method_exit_callbacks);
   visitor.WalkStack(true);
   PrepareForLongJumpToInvokeStubOrInterpreterBridge();
@@ -716,6 +722,9 @@ void QuickExceptionHandler::DeoptimizeStack(bool skip_method_exit_callbacks) {
 
 void QuickExceptionHandler::DeoptimizeSingleFrame(DeoptimizationKind kind) {
   DCHECK(is_deoptimization_);
+  metrics::ArtMetrics* metrics = Runtime::Current()->GetMetrics();
+  metrics::AutoTimer timer{metrics->DeoptimizationTotalTime()};
+  metrics->DeoptimizationCount()->AddOne();
 
   // This deopt is requested while still executing the method. We haven't run method exit callbacks
   // yet, so don't skip them.
@@ -742,8 +751,10 @@ void QuickExceptionHandler::DeoptimizeSingleFrame(DeoptimizationKind kind) {
   // needed fot this method.
   Runtime* runtime = Runtime::Current();
   if (runtime->UseJitCompilation() && (kind != DeoptimizationKind::kDebugging)) {
-    runtime->GetJit()->GetCodeCache()->InvalidateCompiledCodeFor(
+    jit::JitCodeCache* code_cache = runtime->GetJit()->GetCodeCache();
+    code_cache->InvalidateCompiledCodeFor(
         deopt_method, visitor.GetSingleFrameDeoptQuickMethodHeader());
+    code_cache->RecordDeoptimization(deopt_method, kind, self_);
   } else {
     runtime->GetInstrumentation()->InitializeMethodsCode(
         deopt_method, /*aot_code=*/ nullptr);
@@ -177,6 +177,7 @@
 #include "thread_list.h"
 #include "ti/agent.h"
 #include "trace.h"
+#include "unwindstack/Elf.h"
 #include "vdex_file.h"
 #include "verifier/class_verifier.h"
 #include "well_known_classes-inl.h"
@@ -319,9 +320,13 @@ Runtime::Runtime()
       process_state_(kProcessStateJankPerceptible),
       zygote_no_threads_(false),
       verifier_logging_threshold_ms_(100),
+      background_verification_threads_(1u),
       verifier_missing_kthrow_fatal_(false),
       perfetto_hprof_enabled_(false),
       perfetto_javaheapprof_enabled_(false),
+      hprof_dump_in_child_(false),
+      allocation_site_sampling_interval_(0u),
+      gc_survival_tracking_(false),
       out_of_memory_error_hook_(nullptr) {
   static_assert(Runtime::kCalleeSaveSize ==
                     static_cast<uint32_t>(CalleeSaveType::kLastCalleeSaveType), "Unexpected size");
@@ -1551,6 +1556,10 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
   force_java_zygote_fork_loop_ = runtime_options.GetOrDefault(Opt::ForceJavaZygoteForkLoop);
   perfetto_hprof_enabled_ = runtime_options.GetOrDefault(Opt::PerfettoHprof);
   perfetto_javaheapprof_enabled_ = runtime_options.GetOrDefault(Opt::PerfettoJavaHeapStackProf);
+  hprof_dump_in_child_ = runtime_options.GetOrDefault(Opt::HprofDumpInChild);
+  allocation_site_sampling_interval_ =
+      runtime_options.GetOrDefault(Opt::AllocationSiteSamplingInterval);
+  gc_survival_tracking_ = runtime_options.GetOrDefault(Opt::GcSurvivalTracking);
 
   // Try to reserve a dedicated fault page. This is allocated for clobbered registers and sentinels.
   // If we cannot reserve it, log a warning.
@@ -1634,6 +1643,15 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
       runtime_options.Exists(Opt::DisableEagerlyReleaseExplicitGC);
   image_dex2oat_enabled_ = runtime_options.GetOrDefault(Opt::ImageDex2Oat);
   dump_native_stack_on_sig_quit_ = runtime_options.GetOrDefault(Opt::DumpNativeStackOnSigQuit);
+  if (dump_native_stack_on_sig_quit_ &&
+      runtime_options.GetOrDefault(Opt::CacheElfFilesForStackDumps)) {
+    // Keep the parsed ELF files, including their unwind info and symbol tables, across thread
+    // dumps, so that repeated SIGQUIT dumps do not re-read them. This is a process-wide setting
+    // which is not thread-safe, so set it before any thread may unwind. It keeps the parsed
+    // files alive for the life of the process, so it is off by default and meant for processes
+    // that are dumped repeatedly, such as system_server under the watchdog.
+    unwindstack::Elf::SetCachingEnabled(true);
+  }
   allow_in_memory_compilation_ = runtime_options.Exists(Opt::AllowInMemoryCompilation);
 
   if (is_zygote_ || runtime_options.Exists(Opt::OnlyUseTrustedOatFiles)) {
@@ -1779,6 +1797,7 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
                        runtime_options.Exists(Opt::LowMemoryMode),
                        runtime_options.GetOrDefault(Opt::LongPauseLogThreshold),
                        runtime_options.GetOrDefault(Opt::LongGCLogThreshold),
+                       runtime_options.GetOrDefault(Opt::GcPauseTarget),
                        runtime_options.Exists(Opt::IgnoreMaxFootprint),
                        runtime_options.GetOrDefault(Opt::AlwaysLogExplicitGcs),
                        runtime_options.GetOrDefault(Opt::UseTLAB),
@@ -1794,7 +1813,9 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
                        use_generational_cc,
                        runtime_options.GetOrDefault(Opt::HSpaceCompactForOOMMinIntervalsMs),
                        runtime_options.Exists(Opt::DumpRegionInfoBeforeGC),
-                       runtime_options.Exists(Opt::DumpRegionInfoAfterGC));
+                       runtime_options.Exists(Opt::DumpRegionInfoAfterGC),
+                       runtime_options.Exists(Opt::UseTransparentHugePages),
+                       runtime_options.Exists(Opt::UseNumaAwareRegionAllocation));
 
   dump_gc_performance_on_shutdown_ = runtime_options.Exists(Opt::DumpGCPerformanceOnShutdown);
 
@@ -1921,6 +1942,8 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
   }
 
   verifier_logging_threshold_ms_ = runtime_options.GetOrDefault(Opt::VerifierLoggingThreshold);
+  background_verification_threads_ =
+      std::max(1u, runtime_options.GetOrDefault(Opt::BackgroundVerificationThreads));
 
   std::string error_msg;
   java_vm_ = JavaVMExt::Create(this, runtime_options, &error_msg);
@@ -1957,7 +1980,8 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
   } else {
     class_linker_ = new ClassLinker(
         intern_table_,
-        runtime_options.GetOrDefault(Opt::FastClassNotFoundException));
+        runtime_options.GetOrDefault(Opt::FastClassNotFoundException),
+        runtime_options.GetOrDefault(Opt::UseClassPathIndex));
   }
   if (GetHeap()->HasBootImageSpace()) {
     bool result = class_linker_->InitFromBootImage(&error_msg);
@@ -2468,6 +2492,10 @@ void Runtime::DumpForSigQuit(std::ostream& os) {
     os << "Running non JIT\n";
   }
   DumpDeoptimizations(os);
+  Monitor::DumpContentionProfile(os);
+  if (interpreter::kCountOpcodePairsEnabled) {
+    interpreter::DumpOpcodePairCounts(os);
+  }
   TrackedAllocators::Dump(os);
   GetMetrics()->DumpForSigQuit(os);
   os << "\n";
@@ -683,6 +683,13 @@ class Runtime {
 
   void SetHiddenApiExemptions(const std::vector<std::string>& exemptions) {
     hidden_api_exemptions_ = exemptions;
+    hidden_api_exemptions_generation_.fetch_add(1u, std::memory_order_release);
+  }
+
+  // Incremented whenever the exemptions change so that cached exemption matches
+  // can be discarded.
+  uint32_t GetHiddenApiExemptionsGeneration() const {
+    return hidden_api_exemptions_generation_.load(std::memory_order_acquire);
   }
 
   const std::vector<std::string>& GetHiddenApiExemptions() {
@@ -997,6 +1004,11 @@ class Runtime {
     return verifier_logging_threshold_ms_;
   }
 
+  // Number of threads used to verify dex files handed to `DexFile.verifyInBackground()`.
+  uint32_t GetBackgroundVerificationThreads() const {
+    return background_verification_threads_;
+  }
+
   // Atomically delete the thread pool if the reference count is 0.
   bool DeleteThreadPool() REQUIRES(!Locks::runtime_thread_pool_lock_);
 
@@ -1062,6 +1074,19 @@ class Runtime {
     return perfetto_javaheapprof_enabled_;
   }
 
+  bool IsHprofDumpInChildEnabled() const {
+    return hprof_dump_in_child_;
+  }
+
+  // Mean sampling interval of the built-in allocation site profiler, zero if disabled.
+  uint32_t GetAllocationSiteSamplingInterval() const {
+    return allocation_site_sampling_interval_;
+  }
+
+  bool IsGcSurvivalTrackingEnabled() const {
+    return gc_survival_tracking_;
+  }
+
   bool IsMonitorTimeoutEnabled() const {
     return monitor_timeout_enable_;
   }
@@ -1458,6 +1483,7 @@ class Runtime {
   // List of signature prefixes of methods that have been removed from the blocklist, and treated
   // as if SDK.
   std::vector<std::string> hidden_api_exemptions_;
+  std::atomic<uint32_t> hidden_api_exemptions_generation_ = 0u;
 
   // Do not warn about the same hidden API access violation twice.
   // This is only used for testing.
@@ -1528,6 +1554,8 @@ class Runtime {
 
   uint32_t verifier_logging_threshold_ms_;
 
+  uint32_t background_verification_threads_;
+
   bool load_app_image_startup_cache_ = false;
 
   // If startup has completed, must happen at most once.
@@ -1537,6 +1565,9 @@ class Runtime {
   bool force_java_zygote_fork_loop_;
   bool perfetto_hprof_enabled_;
   bool perfetto_javaheapprof_enabled_;
+  bool hprof_dump_in_child_;
+  uint32_t allocation_site_sampling_interval_;
+  bool gc_survival_tracking_;
 
   // Called on out of memory error
   void (*out_of_memory_error_hook_)();
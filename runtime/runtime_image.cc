@@ -1002,13 +1002,25 @@ class RuntimeImageHelper {
   }
 
 
-  static void LoadClassesFromReferenceProfile(
+  // Preload the classes listed in the reference profile, which dex2oat got from
+  // earlier runs, and in the current profile, which the profile saver keeps
+  // updating with the classes used by the runs since. The image then covers the
+  // startup classes of all recorded runs, not only the ones this run happened to
+  // load before startup completed.
+  static void LoadClassesFromProfiles(
       Thread* self,
       const dchecked_vector<Handle<mirror::DexCache>>& dex_caches)
           REQUIRES_SHARED(Locks::mutator_lock_) {
     AppInfo* app_info = Runtime::Current()->GetAppInfo();
-    std::string profile_file = app_info->GetPrimaryApkReferenceProfile();
+    LoadClassesFromProfile(self, dex_caches, app_info->GetPrimaryApkReferenceProfile());
+    LoadClassesFromProfile(self, dex_caches, app_info->GetPrimaryApkCurrentProfile());
+  }
 
+  static void LoadClassesFromProfile(
+      Thread* self,
+      const dchecked_vector<Handle<mirror::DexCache>>& dex_caches,
+      const std::string& profile_file)
+          REQUIRES_SHARED(Locks::mutator_lock_) {
     if (profile_file.empty()) {
       return;
     }
@@ -1111,10 +1123,10 @@ class RuntimeImageHelper {
       }
     }
 
-    // If classes referenced in the reference profile are not loaded, preload
-    // them. This makes sure we generate a good runtime app image, even if this
-    // current app run did not load all startup classes.
-    LoadClassesFromReferenceProfile(soa.Self(), dex_caches);
+    // If classes referenced in the profiles are not loaded, preload them. This
+    // makes sure we generate a good runtime app image, even if this current app
+    // run did not load all startup classes.
+    LoadClassesFromProfiles(soa.Self(), dex_caches);
 
     // We store the checksums of the dex files used at runtime. These can be
     // different compared to the vdex checksums due to compact dex.
@@ -16,6 +16,8 @@
 
 #include "string_builder_append.h"
 
+#include <vector>
+
 #include "base/casts.h"
 #include "base/logging.h"
 #include "common_throws.h"
@@ -77,6 +79,12 @@ class StringBuilderAppend::Builder {
                                 CharType* data,
                                 ObjPtr<mirror::String> str) REQUIRES_SHARED(Locks::mutator_lock_);
 
+  template <typename CharType>
+  CharType* AppendCharArray(ObjPtr<mirror::String> new_string,
+                            CharType* data,
+                            size_t char_array_index,
+                            size_t* char_array_offset) const REQUIRES_SHARED(Locks::mutator_lock_);
+
   template <typename CharType>
   static CharType* AppendInt64(ObjPtr<mirror::String> new_string,
                                CharType* data,
@@ -111,6 +119,13 @@ class StringBuilderAppend::Builder {
   uint8_t converted_fp_args_[kMaxArgs][kBinaryToASCIIBufferSize];
   int32_t converted_fp_arg_lengths_[kMaxArgs];
 
+  // The contents of `char[]` arguments are copied out during CalculateLengthWithFlag().
+  // Unlike `String`s, arrays are mutable and another thread could change the contents
+  // between the length calculation and the copy to the new string, invalidating the
+  // compression flag we have already committed to.
+  std::vector<uint16_t> char_array_data_;
+  uint32_t char_array_lengths_[kMaxArgs];
+
   // The length and flag to store when the AppendBuilder is used as a pre-fence visitor.
   int32_t length_with_flag_ = 0u;
 };
@@ -210,6 +225,23 @@ inline CharType* StringBuilderAppend::Builder::AppendString(ObjPtr<mirror::Strin
   return data + length;
 }
 
+template <typename CharType>
+inline CharType* StringBuilderAppend::Builder::AppendCharArray(ObjPtr<mirror::String> new_string,
+                                                               CharType* data,
+                                                               size_t char_array_index,
+                                                               size_t* char_array_offset) const {
+  DCHECK_LT(char_array_index, std::size(char_array_lengths_));
+  size_t length = char_array_lengths_[char_array_index];
+  DCHECK_LE(*char_array_offset + length, char_array_data_.size());
+  DCHECK_LE(length, RemainingSpace(new_string, data));
+  const uint16_t* value = char_array_data_.data() + *char_array_offset;
+  for (size_t i = 0; i != length; ++i) {
+    data[i] = dchecked_integral_cast<CharType>(value[i]);
+  }
+  *char_array_offset += length;
+  return data + length;
+}
+
 template <typename CharType>
 inline CharType* StringBuilderAppend::Builder::AppendInt64(ObjPtr<mirror::String> new_string,
                                                            CharType* data,
@@ -244,6 +276,7 @@ int32_t StringBuilderAppend::Builder::ConvertFpArgs() {
     ObjPtr<mirror::Object> converter;
     switch (static_cast<Argument>(f & kArgMask)) {
       case Argument::kString:
+      case Argument::kCharArray:
       case Argument::kBoolean:
       case Argument::kChar:
       case Argument::kInt:
@@ -271,7 +304,6 @@ int32_t StringBuilderAppend::Builder::ConvertFpArgs() {
         break;
       }
       case Argument::kStringBuilder:
-      case Argument::kCharArray:
       case Argument::kObject:
         LOG(FATAL) << "Unimplemented arg format: 0x" << std::hex
             << (f & kArgMask) << " full format: 0x" << std::hex << format_;
@@ -339,6 +371,7 @@ inline int32_t StringBuilderAppend::Builder::CalculateLengthWithFlag() {
   bool compressible = mirror::kUseStringCompression;
   uint64_t length = 0u;
   bool has_fp_args = false;
+  size_t char_array_index = 0u;
   const uint32_t* current_arg = args_;
   for (uint32_t f = format_; f != 0u; f >>= kBitsPerArg) {
     DCHECK_LE(f & kArgMask, static_cast<uint32_t>(Argument::kLast));
@@ -354,6 +387,23 @@ inline int32_t StringBuilderAppend::Builder::CalculateLengthWithFlag() {
         }
         break;
       }
+      case Argument::kCharArray: {
+        // The compiler fuses `append(char[])` only for arguments known to be non-null.
+        ObjPtr<mirror::CharArray> array = reinterpret_cast32<mirror::CharArray*>(*current_arg);
+        DCHECK(array != nullptr);
+        int32_t array_length = array->GetLength();
+        size_t offset = char_array_data_.size();
+        char_array_data_.insert(
+            char_array_data_.end(), array->GetData(), array->GetData() + array_length);
+        DCHECK_LT(char_array_index, std::size(char_array_lengths_));
+        char_array_lengths_[char_array_index] = static_cast<uint32_t>(array_length);
+        ++char_array_index;
+        length += array_length;
+        // Check the copied data, the array itself can change under our feet.
+        compressible = compressible &&
+            mirror::String::AllASCII(char_array_data_.data() + offset, array_length);
+        break;
+      }
       case Argument::kBoolean: {
         length += (*current_arg != 0u) ? kTrueLength : kFalseLength;
         break;
@@ -385,7 +435,6 @@ inline int32_t StringBuilderAppend::Builder::CalculateLengthWithFlag() {
         break;
 
       case Argument::kStringBuilder:
-      case Argument::kCharArray:
       case Argument::kObject:
         LOG(FATAL) << "Unimplemented arg format: 0x" << std::hex
             << (f & kArgMask) << " full format: 0x" << std::hex << format_;
@@ -424,6 +473,8 @@ inline void StringBuilderAppend::Builder::StoreData(ObjPtr<mirror::String> new_s
                                                     CharType* data) const {
   size_t handle_index = 0u;
   size_t fp_arg_index = 0u;
+  size_t char_array_index = 0u;
+  size_t char_array_offset = 0u;
   const uint32_t* current_arg = args_;
   for (uint32_t f = format_; f != 0u; f >>= kBitsPerArg) {
     DCHECK_LE(f & kArgMask, static_cast<uint32_t>(Argument::kLast));
@@ -440,6 +491,11 @@ inline void StringBuilderAppend::Builder::StoreData(ObjPtr<mirror::String> new_s
         }
         break;
       }
+      case Argument::kCharArray: {
+        data = AppendCharArray(new_string, data, char_array_index, &char_array_offset);
+        ++char_array_index;
+        break;
+      }
       case Argument::kBoolean: {
         if (*current_arg != 0u) {
           data = AppendLiteral(new_string, data, kTrue);
@@ -475,7 +531,6 @@ inline void StringBuilderAppend::Builder::StoreData(ObjPtr<mirror::String> new_s
       }
 
       case Argument::kStringBuilder:
-      case Argument::kCharArray:
         LOG(FATAL) << "Unimplemented arg format: 0x" << std::hex
             << (f & kArgMask) << " full format: 0x" << std::hex << format_;
         UNREACHABLE();
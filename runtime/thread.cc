@@ -1498,6 +1498,7 @@ bool Thread::PassActiveSuspendBarriers() {
   // TODO: Consider doing this without the temporary vector. That code will be a bit
   // tricky, since the WrappedSuspend1Barrier may disappear once the barrier is decremented.
   std::vector<AtomicInteger*> pass_barriers{};
+  AtomicInteger* suspendall_barrier = nullptr;
   {
     MutexLock mu(this, *Locks::thread_suspend_count_lock_);
     if (!ReadFlag(ThreadFlag::kActiveSuspendBarrier)) {
@@ -1510,7 +1511,8 @@ bool Thread::PassActiveSuspendBarriers() {
     }
     if (tlsPtr_.active_suspendall_barrier != nullptr) {
       // We have at most one active active_suspendall_barrier. See thread.h comment.
-      pass_barriers.push_back(tlsPtr_.active_suspendall_barrier);
+      suspendall_barrier = tlsPtr_.active_suspendall_barrier;
+      pass_barriers.push_back(suspendall_barrier);
       tlsPtr_.active_suspendall_barrier = nullptr;
     }
     for (WrappedSuspend1Barrier* w = tlsPtr_.active_suspend1_barriers; w != nullptr; w = w->next_) {
@@ -1528,6 +1530,9 @@ bool Thread::PassActiveSuspendBarriers() {
     for (AtomicInteger*& barrier : pass_barriers) {
       int32_t old_val = barrier->fetch_sub(1, std::memory_order_release);
       CHECK_GT(old_val, 0) << "Unexpected value for PassActiveSuspendBarriers(): " << old_val;
+      if (old_val == 1 && barrier == suspendall_barrier) {
+        Runtime::Current()->GetThreadList()->RecordSuspendAllHoldout(GetTid());
+      }
       if (old_val != 1) {
         // We're done with it.
         barrier = nullptr;
@@ -2137,6 +2142,10 @@ void Thread::DumpState(std::ostream& os, const Thread* thread, pid_t tid) {
       }
     }
     os << "\n";
+    if (InterpreterCache::kCountLookups) {
+      os << "  | ";
+      thread->interpreter_cache_.DumpStats(os);
+    }
   }
 }
 
@@ -3340,9 +3349,12 @@ jint Thread::InternalStackTraceToStackFrameInfoArray(
       hs.NewHandle(ObjPtr<mirror::PointerArray>::DownCast(decoded_traces->Get(0)));
 
   ClassLinker* const class_linker = Runtime::Current()->GetClassLinker();
-  Handle<mirror::Class> sfi_class =
-      hs.NewHandle(class_linker->FindSystemClass(soa.Self(), "Ljava/lang/StackFrameInfo;"));
-  DCHECK(sfi_class != nullptr);
+  // Callers asking only for class references (e.g. `StackWalker.getCallerClass()`) do not
+  // need the StackFrameInfo class, so avoid the lookup by descriptor for them.
+  Handle<mirror::Class> sfi_class = hs.NewHandle<mirror::Class>(
+      isClassArray ? nullptr
+                   : class_linker->FindSystemClass(soa.Self(), "Ljava/lang/StackFrameInfo;"));
+  DCHECK(isClassArray || sfi_class != nullptr);
 
   MutableHandle<mirror::StackFrameInfo> frame = hs.NewHandle<mirror::StackFrameInfo>(nullptr);
   MutableHandle<mirror::Class> clazz = hs.NewHandle<mirror::Class>(nullptr);
@@ -4272,9 +4284,15 @@ class ReferenceMapVisitor : public StackVisitor {
       StackReference<mirror::Object>* vreg_base =
           reinterpret_cast<StackReference<mirror::Object>*>(cur_quick_frame);
       uintptr_t native_pc_offset = method_header->NativeQuickPcOffset(GetCurrentQuickFramePc());
-      CodeInfo code_info = kPrecise
-          ? CodeInfo(method_header)  // We will need dex register maps.
-          : CodeInfo::DecodeGcMasksOnly(method_header);
+      // Deep stacks often have many consecutive frames of the same method (recursion),
+      // so keep the last decoded CodeInfo around.
+      if (method_header != last_code_info_header_) {
+        last_code_info_ = kPrecise
+            ? CodeInfo(method_header)  // We will need dex register maps.
+            : CodeInfo::DecodeGcMasksOnly(method_header);
+        last_code_info_header_ = method_header;
+      }
+      const CodeInfo& code_info = last_code_info_;
       StackMap map = code_info.GetStackMapForNativePcOffset(native_pc_offset);
       DCHECK(map.IsValid());
 
@@ -4432,6 +4450,10 @@ class ReferenceMapVisitor : public StackVisitor {
   // Visitor for when we visit a root.
   RootVisitor& visitor_;
   bool visit_declaring_class_;
+
+  // The last decoded CodeInfo and the method header it was decoded from.
+  const OatQuickMethodHeader* last_code_info_header_ = nullptr;
+  CodeInfo last_code_info_;
 };
 
 class RootCallbackVisitor {
@@ -4586,9 +4608,10 @@ static void SweepCacheEntry(IsMarkedVisitor* visitor, const Instruction* inst, s
 }
 
 void Thread::SweepInterpreterCache(IsMarkedVisitor* visitor) {
-  for (InterpreterCache::Entry& entry : GetInterpreterCache()->GetArray()) {
+  GetInterpreterCache()->VisitEntries([visitor](InterpreterCache::Entry& entry)
+      REQUIRES_SHARED(Locks::mutator_lock_) {
     SweepCacheEntry(visitor, reinterpret_cast<const Instruction*>(entry.first), &entry.second);
-  }
+  });
 }
 
 // FIXME: clang-r433403 reports the below function exceeds frame size limit.
@@ -1457,6 +1457,19 @@ class EXPORT Thread {
   uint8_t* GetTlabEnd() {
     return tlsPtr_.thread_local_end;
   }
+
+  // Per-thread state for adaptive TLAB sizing, see Heap::AdaptiveTlabSize().
+  struct AdaptiveTlabState {
+    // Log2 of the factor by which the default TLAB size is scaled for this thread.
+    int32_t size_shift = 0;
+    // Number of TLAB refills since the GC numbered `gc_num` completed.
+    uint32_t refills = 0;
+    uint32_t gc_num = 0;
+  };
+
+  AdaptiveTlabState* GetAdaptiveTlabState() {
+    return &adaptive_tlab_state_;
+  }
   // Remove the suspend trigger for this thread by making the suspend_trigger_ TLS value
   // equal to a valid pointer.
   void RemoveSuspendTrigger() {
@@ -2397,6 +2410,8 @@ class EXPORT Thread {
   // the caller is allowed to access all fields and methods in the Core Platform API.
   uint32_t core_platform_api_cookie_ = 0;
 
+  AdaptiveTlabState adaptive_tlab_state_;
+
   friend class gc::collector::SemiSpace;  // For getting stack traces.
   friend class Runtime;  // For CreatePeer.
   friend class QuickExceptionHandler;  // For dumping the stack.
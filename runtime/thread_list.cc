@@ -74,6 +74,7 @@ ThreadList::ThreadList(uint64_t thread_suspend_timeout_ns)
       unregistering_count_(0),
       suspend_all_histogram_("suspend all histogram", 16, 64),
       long_suspend_(false),
+      suspend_all_holdout_tid_(0),
       shut_down_(false),
       thread_suspend_timeout_ns_(thread_suspend_timeout_ns),
       empty_checkpoint_barrier_(new Barrier(0)) {
@@ -194,8 +195,7 @@ class DumpCheckpoint final : public Closure {
         // This avoids a SIGABRT that would otherwise happen in the destructor.
         barrier_(0, /*verify_count_on_shutdown=*/false),
         unwinder_(std::vector<std::string>{}, std::vector<std::string> {"oat", "odex"}),
-        dump_native_stack_(dump_native_stack) {
-  }
+        dump_native_stack_(dump_native_stack) {}
 
   void Run(Thread* thread) override {
     // Note thread and self may not be equal if thread was already suspended at the point of the
@@ -623,7 +623,9 @@ void ThreadList::FlipThreadRoots(Closure* thread_flip_visitor,
 
     // Run the flip callback for the collector.
     Locks::mutator_lock_->ExclusiveLock(self);
-    suspend_all_histogram_.AdjustAndAddValue(NanoTime() - suspend_start_time);
+    const uint64_t suspend_time = NanoTime() - suspend_start_time;
+    suspend_all_histogram_.AdjustAndAddValue(suspend_time);
+    Runtime::Current()->GetMetrics()->ThreadSuspendAllTime()->Add(NsToUs(suspend_time));
     flip_callback->Run(self);
 
     {
@@ -866,8 +868,10 @@ void ThreadList::SuspendAll(const char* cause, bool long_suspend) {
     const uint64_t end_time = NanoTime();
     const uint64_t suspend_time = end_time - start_time;
     suspend_all_histogram_.AdjustAndAddValue(suspend_time);
+    Runtime::Current()->GetMetrics()->ThreadSuspendAllTime()->Add(NsToUs(suspend_time));
     if (suspend_time > kLongThreadSuspendThreshold) {
-      LOG(WARNING) << "Suspending all threads took: " << PrettyDuration(suspend_time);
+      LOG(WARNING) << "Suspending all threads took: " << PrettyDuration(suspend_time)
+                   << DescribeSuspendAllHoldout(self);
     }
 
     if (kDebugLocking) {
@@ -889,6 +893,22 @@ void ThreadList::SuspendAll(const char* cause, bool long_suspend) {
   }
 }
 
+std::string ThreadList::DescribeSuspendAllHoldout(Thread* self) {
+  pid_t tid = suspend_all_holdout_tid_.load(std::memory_order_relaxed);
+  if (tid == 0) {
+    return "";
+  }
+  MutexLock mu(self, *Locks::thread_list_lock_);
+  for (Thread* thread : list_) {
+    if (thread->GetTid() == tid) {
+      std::string name;
+      thread->GetThreadName(name);
+      return StringPrintf(", last to suspend: \"%s\" tid=%d", name.c_str(), tid);
+    }
+  }
+  return StringPrintf(", last to suspend: tid=%d", tid);
+}
+
 // Ensures all threads running Java suspend and that those not running Java don't start.
 void ThreadList::SuspendAllInternal(Thread* self, SuspendReason reason) {
   // self can be nullptr if this is an unregistered thread.
@@ -921,6 +941,7 @@ void ThreadList::SuspendAllInternal(Thread* self, SuspendReason reason) {
         bool found_myself = false;
         // Update global suspend all state for attaching threads.
         ++suspend_all_count_;
+        suspend_all_holdout_tid_.store(0, std::memory_order_relaxed);
         pending_threads.store(list_.size() - (self == nullptr ? 0 : 1), std::memory_order_relaxed);
         // Increment everybody else's suspend count.
         for (const auto& thread : list_) {
@@ -85,6 +85,12 @@ class ThreadList {
                !Locks::thread_suspend_count_lock_,
                !Locks::mutator_lock_);
 
+  // Called by the thread that passes the suspend-all barrier last, i.e. the thread that took the
+  // longest to reach a suspend point. Reported by SuspendAll when the suspension was slow.
+  void RecordSuspendAllHoldout(pid_t tid) {
+    suspend_all_holdout_tid_.store(tid, std::memory_order_relaxed);
+  }
+
   // Suspend a thread using a peer, typically used by the debugger. Returns the thread on success,
   // else null. The peer is used to identify the thread to avoid races with the thread terminating.
   EXPORT Thread* SuspendThreadByPeer(jobject peer, SuspendReason reason)
@@ -278,6 +284,9 @@ class ThreadList {
                !Locks::thread_suspend_count_lock_,
                !Locks::mutator_lock_);
 
+  // Returns a description of the thread recorded by RecordSuspendAllHoldout, for logging.
+  std::string DescribeSuspendAllHoldout(Thread* self) REQUIRES(!Locks::thread_list_lock_);
+
   void AssertOtherThreadsAreSuspended(Thread* self)
       REQUIRES(!Locks::thread_list_lock_, !Locks::thread_suspend_count_lock_);
 
@@ -302,6 +311,9 @@ class ThreadList {
   // Whether or not the current thread suspension is long.
   bool long_suspend_;
 
+  // Tid of the last thread to pass the barrier of the current or most recent SuspendAll.
+  std::atomic<pid_t> suspend_all_holdout_tid_;
+
   // Whether the shutdown function has been called. This is checked in the destructor. It is an
   // error to destroy a ThreadList instance without first calling ShutDown().
   bool shut_down_;
@@ -252,9 +252,15 @@ void AbstractThreadPool::DeleteThreads() {
 }
 
 void AbstractThreadPool::SetMaxActiveWorkers(size_t max_workers) {
-  MutexLock mu(Thread::Current(), task_queue_lock_);
+  Thread* self = Thread::Current();
+  MutexLock mu(self, task_queue_lock_);
   CHECK_LE(max_workers, GetThreadCount());
+  const bool raised = max_workers > max_active_workers_;
   max_active_workers_ = max_workers;
+  if (raised && HasOutstandingTasks()) {
+    // Wake up workers that were held back by the previous limit.
+    task_queue_condition_.Broadcast(self);
+  }
 }
 
 void AbstractThreadPool::StartWorkers(Thread* self) {
@@ -295,7 +301,14 @@ Task* AbstractThreadPool::GetTask(Thread* self) {
       completion_condition_.Broadcast(self);
     }
     const uint64_t wait_start = kMeasureWaitTime ? NanoTime() : 0;
-    task_queue_condition_.Wait(self);
+    const uint64_t deferred_delay_ns = GetDeferredTasksDelayNs();
+    if (deferred_delay_ns != 0u) {
+      task_queue_condition_.TimedWait(self,
+                                      static_cast<int64_t>(deferred_delay_ns / MsToNs(1)),
+                                      static_cast<int32_t>(deferred_delay_ns % MsToNs(1)));
+    } else {
+      task_queue_condition_.Wait(self);
+    }
     if (kMeasureWaitTime) {
       const uint64_t wait_end = NanoTime();
       total_wait_time_ += wait_end - std::max(wait_start, start_time_);
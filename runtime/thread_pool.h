@@ -153,7 +153,8 @@ class AbstractThreadPool {
   }
 
   // Provides a way to bound the maximum number of worker threads, threads must be less the the
-  // thread count of the thread pool.
+  // thread count of the thread pool. The limit can be changed while the pool is running, for
+  // example to throttle background work; raising it wakes up the idle workers.
   void SetMaxActiveWorkers(size_t threads) REQUIRES(!task_queue_lock_);
 
   // Set the "nice" priority for threads in the pool.
@@ -183,6 +184,12 @@ class AbstractThreadPool {
 
   virtual bool HasOutstandingTasks() const REQUIRES(task_queue_lock_) = 0;
 
+  // If some outstanding tasks cannot be started yet, how long until they can. Idle workers wake
+  // up after that time instead of waiting for a new task. Zero if there are no such tasks.
+  virtual uint64_t GetDeferredTasksDelayNs() const REQUIRES(task_queue_lock_) {
+    return 0u;
+  }
+
   EXPORT AbstractThreadPool(const char* name,
                             size_t num_threads,
                             bool create_peers,
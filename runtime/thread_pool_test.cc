@@ -125,6 +125,29 @@ TEST_F(ThreadPoolTest, StopWait) {
   thread_pool->Wait(self, /* do_work= */ true, false);
 }
 
+// Check that the active worker limit can be lowered and raised while the pool is running.
+TEST_F(ThreadPoolTest, MaxActiveWorkers) {
+  Thread* self = Thread::Current();
+  std::unique_ptr<ThreadPool> thread_pool(
+      ThreadPool::Create("Thread pool test thread pool", num_threads));
+  thread_pool->SetMaxActiveWorkers(0);
+
+  AtomicInteger count(0);
+  static const int32_t num_tasks = num_threads * 4;
+  for (int32_t i = 0; i < num_tasks; ++i) {
+    thread_pool->AddTask(self, new CountTask(&count));
+  }
+  thread_pool->StartWorkers(self);
+  usleep(200);
+  // No worker is allowed to run.
+  EXPECT_EQ(0, count.load(std::memory_order_seq_cst));
+
+  // Raising the limit must wake up the idle workers without adding new tasks.
+  thread_pool->SetMaxActiveWorkers(num_threads);
+  thread_pool->Wait(self, /* do_work= */ false, false);
+  EXPECT_EQ(num_tasks, count.load(std::memory_order_seq_cst));
+}
+
 class TreeTask : public Task {
  public:
   TreeTask(ThreadPool* const thread_pool, AtomicInteger* count, int depth)
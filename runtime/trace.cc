@@ -1782,6 +1782,14 @@ void TraceWriter::FlushBuffer(uintptr_t* method_trace_entries,
                               size_t current_offset,
                               size_t tid,
                               const std::unordered_map<ArtMethod*, std::string>& method_infos) {
+  if (trace_output_mode_ == TraceOutputMode::kStreaming &&
+      trace_format_version_ == Trace::kFormatV2) {
+    // The V2 format encodes method pointers directly and doesn't need any shared state to encode a
+    // block, so encode it outside the lock and only serialize the write to the file.
+    FlushBufferStreamingV2(method_trace_entries, current_offset, tid);
+    return;
+  }
+
   // Take a trace_writer_lock_ to serialize writes across threads. We also need to allocate a unique
   // method id for each method. We do that by maintaining a map from id to method for each newly
   // seen method. trace_writer_lock_ is required to serialize these.
@@ -1831,6 +1839,29 @@ void TraceWriter::FlushBuffer(uintptr_t* method_trace_entries,
   return;
 }
 
+void TraceWriter::FlushBufferStreamingV2(uintptr_t* method_trace_entries,
+                                         size_t current_offset,
+                                         size_t tid) {
+  size_t num_entries = GetNumEntries(clock_source_);
+  size_t num_records = (kPerThreadBufSize - current_offset) / num_entries;
+  DCHECK_EQ((kPerThreadBufSize - current_offset) % num_entries, 0u);
+  // GetRecordSize only gives the expected size of a V2 record, so size the block for the worst
+  // case of a 64-bit LEB128 for the method diff and for each timestamp diff.
+  const size_t num_fields =
+      1 + (UseWallClock(clock_source_) ? 1 : 0) + (UseThreadCpuClock(clock_source_) ? 1 : 0);
+  const size_t max_record_size = 10 * num_fields;
+
+  std::unique_ptr<uint8_t[]> block(new uint8_t[kEntryHeaderSizeV2 + max_record_size * num_records]);
+  size_t block_size = 0;
+  FlushEntriesFormatV2(method_trace_entries, tid, num_records, &block_size, block.get());
+
+  MutexLock mu(Thread::Current(), trace_writer_lock_);
+  num_records_ += num_records;
+  if (!trace_file_->WriteFully(block.get(), block_size)) {
+    PLOG(WARNING) << "Failed streaming a tracing event.";
+  }
+}
+
 void Trace::LogMethodTraceEvent(Thread* thread,
                                 ArtMethod* method,
                                 TraceAction action,
@@ -299,6 +299,10 @@ class TraceWriter {
   // Writes buffer contents to the file.
   void WriteToFile(uint8_t* buffer, size_t offset);
 
+  // Get the tab separated class, name, signature and source file of the method, ended by a
+  // newline. Proxy methods are described by the interface method they implement.
+  static std::string GetMethodInfoLine(ArtMethod* method) REQUIRES_SHARED(Locks::mutator_lock_);
+
  private:
   void ReadValuesFromRecord(uintptr_t* method_trace_entries,
                             size_t record_index,
@@ -310,7 +314,13 @@ class TraceWriter {
                             size_t tid,
                             size_t num_records,
                             size_t* current_index,
-                            uint8_t* init_buffer_ptr) REQUIRES(trace_writer_lock_);
+                            uint8_t* init_buffer_ptr);
+
+  // Encodes the entries of a per-thread buffer into a private block without holding
+  // trace_writer_lock_ and only takes the lock to append the block to the trace file. Only used in
+  // streaming mode with the V2 format, which doesn't need method or thread ids.
+  void FlushBufferStreamingV2(uintptr_t* method_trace_entries, size_t current_offset, size_t tid)
+      REQUIRES(!trace_writer_lock_);
 
   void FlushEntriesFormatV1(uintptr_t* method_trace_entries,
                             size_t tid,
@@ -330,7 +340,6 @@ class TraceWriter {
 
   // Get the information about the method.
   std::string GetMethodLine(const std::string& method_line, uint32_t method_id);
-  std::string GetMethodInfoLine(ArtMethod* method) REQUIRES_SHARED(Locks::mutator_lock_);
 
   // Helper function to record method information when processing the events. These are used by
   // streaming output mode. Non-streaming modes dump the methods and threads list at the end of
@@ -348,8 +357,7 @@ class TraceWriter {
 
   // Encodes the header for the events block. This assumes that there is enough space reserved to
   // encode the entry.
-  void EncodeEventBlockHeader(uint8_t* ptr, uint32_t thread_id, uint32_t num_records)
-      REQUIRES(trace_writer_lock_);
+  void EncodeEventBlockHeader(uint8_t* ptr, uint32_t thread_id, uint32_t num_records);
 
   // Ensures there is sufficient space in the buffer to record the requested_size. If there is not
   // enough sufficient space the current contents of the buffer are written to the file and
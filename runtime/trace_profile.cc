@@ -16,6 +16,9 @@
 
 #include "trace_profile.h"
 
+#include <limits>
+
+#include "art_method-inl.h"
 #include "base/leb128.h"
 #include "base/mutex.h"
 #include "base/unix_file/fd_file.h"
@@ -103,6 +106,35 @@ void TraceProfiler::Stop() {
   profile_in_progress_ = false;
 }
 
+void TraceProfiler::DumpMethodInfos(const std::unordered_set<ArtMethod*>& methods,
+                                    File* trace_file) {
+  // Records use the same layout as the method info records of the V2 method trace format:
+  // 1 byte of header identifier, 8 bytes of method id, 2 bytes of info length and the info line.
+  static constexpr size_t kMethodInfoHeaderSize = 11;
+  static constexpr size_t kMaxMethodInfoLength = std::numeric_limits<uint16_t>::max();
+  std::string method_infos;
+  for (ArtMethod* method : methods) {
+    std::string method_line = TraceWriter::GetMethodInfoLine(method);
+    if (UNLIKELY(method_line.length() > kMaxMethodInfoLength)) {
+      // The length has to fit in 2 bytes. Keep the line well formed, the class and method
+      // names come first.
+      LOG(WARNING) << "Truncating method info of " << method->PrettyMethod();
+      method_line.resize(kMaxMethodInfoLength - 1u);
+      method_line += '\n';
+    }
+    uint8_t header[kMethodInfoHeaderSize];
+    header[0] = kMethodInfoHeaderV2;
+    Append8LE(header + 1, reinterpret_cast<uint64_t>(method));
+    Append2LE(header + 9, method_line.length());
+    method_infos.append(reinterpret_cast<const char*>(header), kMethodInfoHeaderSize);
+    method_infos.append(method_line);
+  }
+
+  if (!trace_file->WriteFully(method_infos.c_str(), method_infos.length())) {
+    PLOG(WARNING) << "Failed writing method infos.";
+  }
+}
+
 uint8_t* TraceProfiler::DumpBuffer(uint32_t thread_id,
                                    uintptr_t* method_trace_entries,
                                    uint8_t* buffer,
@@ -169,12 +201,16 @@ void TraceProfiler::Dump(std::unique_ptr<File>&& trace_file) {
   MutexLock mu(self, *Locks::trace_lock_);
   if (!profile_in_progress_) {
     LOG(ERROR) << "No Profile in progress. Nothing to dump.";
+    if (trace_file->Close() != 0) {
+      PLOG(WARNING) << "Failed to close the trace file.";
+    }
     return;
   }
 
   ScopedSuspendAll ssa(__FUNCTION__);
   MutexLock tl(self, *Locks::thread_list_lock_);
-  uint8_t* buffer_ptr = new uint8_t[kBufSizeForEncodedData];
+  std::unique_ptr<uint8_t[]> buffer(new uint8_t[kBufSizeForEncodedData]);
+  uint8_t* buffer_ptr = buffer.get();
   uint8_t* curr_buffer_ptr = buffer_ptr;
   for (Thread* thread : Runtime::Current()->GetThreadList()->GetList()) {
     auto method_trace_entries = thread->GetMethodTraceBuffer();
@@ -198,6 +234,20 @@ void TraceProfiler::Dump(std::unique_ptr<File>&& trace_file) {
     // Reset the current pointer.
     thread->SetMethodTraceBufferCurrentEntry(kAlwaysOnTraceBufSize);
   }
+
+  // Write out the events that are still pending in the buffer.
+  size_t offset = curr_buffer_ptr - buffer_ptr;
+  if (offset > 0 && !trace_file->WriteFully(buffer_ptr, offset)) {
+    PLOG(WARNING) << "Failed streaming a tracing event.";
+  }
+
+  // The events only record method pointers, so also dump the information about the methods seen
+  // in the events to make the trace usable after the process has gone away.
+  DumpMethodInfos(traced_methods, trace_file.get());
+
+  if (trace_file->FlushClose() != 0) {
+    PLOG(WARNING) << "Failed to flush and close the trace file.";
+  }
 }
 
 bool TraceProfiler::IsTraceProfileInProgress() {
@@ -65,6 +65,11 @@ class TraceProfiler {
                              uint8_t* buffer /* out */,
                              std::unordered_set<ArtMethod*>& methods /* out */);
 
+  // Writes the information (class, name, signature and source file) about the methods seen in the
+  // dumped events, so the method ids in the events can be resolved offline.
+  static void DumpMethodInfos(const std::unordered_set<ArtMethod*>& methods, File* trace_file)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   static bool profile_in_progress_ GUARDED_BY(Locks::trace_lock_);
   DISALLOW_COPY_AND_ASSIGN(TraceProfiler);
 };
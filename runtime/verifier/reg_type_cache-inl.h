@@ -181,6 +181,7 @@ template <class RegTypeType>
 inline RegTypeType& RegTypeCache::AddEntry(RegTypeType* new_entry) {
   DCHECK(new_entry != nullptr);
   entries_.push_back(new_entry);
+  AddDescriptorEntry(new_entry);
   if (new_entry->HasClass()) {
     Handle<mirror::Class> klass = new_entry->GetClassHandle();
     DCHECK(!klass->IsPrimitive());
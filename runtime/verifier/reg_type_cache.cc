@@ -140,18 +140,21 @@ const RegType& RegTypeCache::RegTypeFromPrimitiveType(Primitive::Type prim_type)
   }
 }
 
-bool RegTypeCache::MatchDescriptor(size_t idx, const std::string_view& descriptor, bool precise) {
-  const RegType* entry = entries_[idx];
-  if (descriptor != entry->descriptor_) {
-    return false;
+void RegTypeCache::AddDescriptorEntry(const RegType* entry) {
+  if (entry->descriptor_.empty()) {
+    return;
   }
   if (entry->HasClass()) {
-    return MatchingPrecisionForClass(entry, precise);
+    if (!MatchingPrecisionForClass(entry, /* precise= */ false)) {
+      return;
+    }
+  } else if (!entry->IsUnresolvedReference()) {
+    // There is no notion of precise unresolved references, the precise information is just
+    // dropped on the floor. Other unresolved types are never looked up by descriptor.
+    return;
   }
-  // There is no notion of precise unresolved references, the precise information is just dropped
-  // on the floor.
-  DCHECK(entry->IsUnresolvedReference());
-  return true;
+  // Keep the first entry, which is the one a lookup in id order would find.
+  descriptor_entries_.insert({entry->descriptor_, entry->GetId()});
 }
 
 ObjPtr<mirror::Class> RegTypeCache::ResolveClass(const char* descriptor,
@@ -180,12 +183,10 @@ std::string_view RegTypeCache::AddString(const std::string_view& str) {
 
 const RegType& RegTypeCache::From(Handle<mirror::ClassLoader> loader, const char* descriptor) {
   std::string_view sv_descriptor(descriptor);
-  // Try looking up the class in the cache first. We use a std::string_view to avoid
-  // repeated strlen operations on the descriptor.
-  for (size_t i = kNumPrimitivesAndSmallConstants; i < entries_.size(); i++) {
-    if (MatchDescriptor(i, sv_descriptor, /* precise= */ false)) {
-      return *(entries_[i]);
-    }
+  // Try looking up the class in the cache first.
+  auto it = descriptor_entries_.find(sv_descriptor);
+  if (it != descriptor_entries_.end()) {
+    return *(entries_[it->second]);
   }
   // Class not found in the cache, will create a new type for that.
   // Try resolving class.
@@ -288,6 +289,8 @@ RegTypeCache::RegTypeCache(Thread* self,
                            bool can_suspend)
     : entries_(allocator.Adapter(kArenaAllocVerifier)),
       klass_entries_(allocator.Adapter(kArenaAllocVerifier)),
+      descriptor_entries_(allocator.Adapter(kArenaAllocVerifier)),
+      constant_entries_(allocator.Adapter(kArenaAllocVerifier)),
       allocator_(allocator),
       handles_(self),
       class_linker_(class_linker),
@@ -526,56 +529,35 @@ const UninitializedType& RegTypeCache::UninitializedThisArgument(const RegType&
   return AddEntry(entry);
 }
 
-const ConstantType& RegTypeCache::FromCat1NonSmallConstant(int32_t value, bool precise) {
-  for (size_t i = kNumPrimitivesAndSmallConstants; i < entries_.size(); i++) {
-    const RegType* cur_entry = entries_[i];
-    if (!cur_entry->HasClass() && cur_entry->IsConstant() &&
-        cur_entry->IsPreciseConstant() == precise &&
-        (down_cast<const ConstantType*>(cur_entry))->ConstantValue() == value) {
-      return *down_cast<const ConstantType*>(cur_entry);
-    }
+template <class PreciseRegTypeType, class ImpreciseRegTypeType>
+const ConstantType& RegTypeCache::FromConstant(ConstantKind kind, int32_t value, bool precise) {
+  uint64_t key = ConstantKey(kind, value, precise);
+  auto it = constant_entries_.find(key);
+  if (it != constant_entries_.end()) {
+    return *down_cast<const ConstantType*>(entries_[it->second]);
   }
   ConstantType* entry;
   if (precise) {
-    entry = new (&allocator_) PreciseConstType(null_handle_, value, entries_.size());
+    entry = new (&allocator_) PreciseRegTypeType(null_handle_, value, entries_.size());
   } else {
-    entry = new (&allocator_) ImpreciseConstType(null_handle_, value, entries_.size());
+    entry = new (&allocator_) ImpreciseRegTypeType(null_handle_, value, entries_.size());
   }
+  constant_entries_.insert({key, entry->GetId()});
   return AddEntry(entry);
 }
 
+const ConstantType& RegTypeCache::FromCat1NonSmallConstant(int32_t value, bool precise) {
+  return FromConstant<PreciseConstType, ImpreciseConstType>(ConstantKind::kCat1, value, precise);
+}
+
 const ConstantType& RegTypeCache::FromCat2ConstLo(int32_t value, bool precise) {
-  for (size_t i = kNumPrimitivesAndSmallConstants; i < entries_.size(); i++) {
-    const RegType* cur_entry = entries_[i];
-    if (cur_entry->IsConstantLo() && (cur_entry->IsPrecise() == precise) &&
-        (down_cast<const ConstantType*>(cur_entry))->ConstantValueLo() == value) {
-      return *down_cast<const ConstantType*>(cur_entry);
-    }
-  }
-  ConstantType* entry;
-  if (precise) {
-    entry = new (&allocator_) PreciseConstLoType(null_handle_, value, entries_.size());
-  } else {
-    entry = new (&allocator_) ImpreciseConstLoType(null_handle_, value, entries_.size());
-  }
-  return AddEntry(entry);
+  return FromConstant<PreciseConstLoType, ImpreciseConstLoType>(
+      ConstantKind::kCat2Lo, value, precise);
 }
 
 const ConstantType& RegTypeCache::FromCat2ConstHi(int32_t value, bool precise) {
-  for (size_t i = kNumPrimitivesAndSmallConstants; i < entries_.size(); i++) {
-    const RegType* cur_entry = entries_[i];
-    if (cur_entry->IsConstantHi() && (cur_entry->IsPrecise() == precise) &&
-        (down_cast<const ConstantType*>(cur_entry))->ConstantValueHi() == value) {
-      return *down_cast<const ConstantType*>(cur_entry);
-    }
-  }
-  ConstantType* entry;
-  if (precise) {
-    entry = new (&allocator_) PreciseConstHiType(null_handle_, value, entries_.size());
-  } else {
-    entry = new (&allocator_) ImpreciseConstHiType(null_handle_, value, entries_.size());
-  }
-  return AddEntry(entry);
+  return FromConstant<PreciseConstHiType, ImpreciseConstHiType>(
+      ConstantKind::kCat2Hi, value, precise);
 }
 
 const RegType& RegTypeCache::GetComponentType(const RegType& array,
@@ -179,11 +179,31 @@ class RegTypeCache {
   void FillPrimitiveAndSmallConstantTypes() REQUIRES_SHARED(Locks::mutator_lock_);
   ObjPtr<mirror::Class> ResolveClass(const char* descriptor, Handle<mirror::ClassLoader> loader)
       REQUIRES_SHARED(Locks::mutator_lock_);
-  bool MatchDescriptor(size_t idx, const std::string_view& descriptor, bool precise)
-      REQUIRES_SHARED(Locks::mutator_lock_);
   const ConstantType& FromCat1NonSmallConstant(int32_t value, bool precise)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Kinds of constants in `constant_entries_`. Non-zero so that no key is empty.
+  enum class ConstantKind : uint64_t {
+    kCat1 = 1,
+    kCat2Lo = 2,
+    kCat2Hi = 3,
+  };
+
+  static uint64_t ConstantKey(ConstantKind kind, int32_t value, bool precise) {
+    return (static_cast<uint64_t>(kind) << 33) |
+           (static_cast<uint64_t>(precise ? 1u : 0u) << 32) |
+           static_cast<uint32_t>(value);
+  }
+
+  // Find a constant in `constant_entries_`, or create it with `PreciseRegTypeType` or
+  // `ImpreciseRegTypeType` depending on `precise` and record it there.
+  template <class PreciseRegTypeType, class ImpreciseRegTypeType>
+  const ConstantType& FromConstant(ConstantKind kind, int32_t value, bool precise)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Record `entry` in `descriptor_entries_` if `From()` can return it for its descriptor.
+  void AddDescriptorEntry(const RegType* entry) REQUIRES_SHARED(Locks::mutator_lock_);
+
   const RegType& From(Handle<mirror::ClassLoader> loader, const char* descriptor)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -201,6 +221,13 @@ class RegTypeCache {
   // Fast lookup for quickly finding entries that have a matching class.
   ScopedArenaVector<std::pair<Handle<mirror::Class>, const RegType*>> klass_entries_;
 
+  // Ids of the entries `From()` returns for a descriptor, so that it does not need to
+  // compare the descriptor with every entry. Only the first such entry is recorded.
+  ScopedArenaHashMap<std::string_view, uint16_t> descriptor_entries_;
+
+  // Ids of the constants that are not preallocated, keyed by `ConstantKey()`.
+  ScopedArenaHashMap<uint64_t, uint16_t> constant_entries_;
+
   // Arena allocator.
   ScopedArenaAllocator& allocator_;
 
@@ -17,6 +17,7 @@
 #include "reg_type.h"
 
 #include <set>
+#include <string>
 
 #include "base/bit_vector.h"
 #include "base/casts.h"
@@ -1094,6 +1095,43 @@ TEST_F(RegTypeTest, ConstPrecision) {
   EXPECT_FALSE(imprecise_const.Equals(precise_const));
 }
 
+TEST_F(RegTypeTest, LookupManyEntries) {
+  // Tests that lookups find the existing entries in a cache with many of them.
+  ArenaStack stack(Runtime::Current()->GetArenaPool());
+  ScopedArenaAllocator allocator(&stack);
+  ScopedObjectAccess soa(Thread::Current());
+  ScopedNullHandle<mirror::ClassLoader> loader;
+  RegTypeCache cache(
+      soa.Self(), Runtime::Current()->GetClassLinker(), /* can_load_classes= */ true, allocator);
+  static constexpr int32_t kNumValues = 1000;
+  auto descriptor = [](int32_t i) { return "LDoesNotExist" + std::to_string(i) + ";"; };
+  for (int32_t i = 0; i < kNumValues; ++i) {
+    cache.FromCat1Const(kNumValues + i, /* precise= */ true);
+    cache.FromCat1Const(kNumValues + i, /* precise= */ false);
+    cache.FromCat2ConstLo(i, /* precise= */ true);
+    cache.FromCat2ConstHi(i, /* precise= */ true);
+    cache.FromDescriptor(loader, descriptor(i).c_str());
+  }
+  size_t cache_size = cache.GetCacheSize();
+  for (int32_t i = 0; i < kNumValues; ++i) {
+    const RegType& precise_const = cache.FromCat1Const(kNumValues + i, /* precise= */ true);
+    EXPECT_TRUE(precise_const.IsPreciseConstant());
+    EXPECT_EQ(kNumValues + i, down_cast<const ConstantType&>(precise_const).ConstantValue());
+    const RegType& imprecise_const = cache.FromCat1Const(kNumValues + i, /* precise= */ false);
+    EXPECT_TRUE(imprecise_const.IsImpreciseConstant());
+    EXPECT_FALSE(precise_const.Equals(imprecise_const));
+    const RegType& lo = cache.FromCat2ConstLo(i, /* precise= */ true);
+    const RegType& hi = cache.FromCat2ConstHi(i, /* precise= */ true);
+    EXPECT_TRUE(lo.IsConstantLo());
+    EXPECT_TRUE(hi.IsConstantHi());
+    EXPECT_TRUE(lo.CheckWidePair(hi));
+    const RegType& unresolved = cache.FromDescriptor(loader, descriptor(i).c_str());
+    EXPECT_TRUE(unresolved.IsUnresolvedReference());
+    EXPECT_EQ(descriptor(i), unresolved.GetDescriptor());
+  }
+  EXPECT_EQ(cache_size, cache.GetCacheSize());
+}
+
 class RegTypeOOMTest : public RegTypeTest {
  protected:
   void SetUpRuntimeOptions(RuntimeOptions *options) override {
@@ -27,6 +27,7 @@
 #include "compiler_callbacks.h"
 #include "dex/class_accessor-inl.h"
 #include "dex/dex_file-inl.h"
+#include "handle_scope-inl.h"
 #include "mirror/class-inl.h"
 #include "mirror/class_loader.h"
 #include "oat/oat_file.h"
@@ -63,14 +64,31 @@ void VerifierDeps::MergeWith(std::unique_ptr<VerifierDeps> other,
   for (const DexFile* dex_file : dex_files) {
     DexFileDeps* my_deps = GetDexFileDeps(*dex_file);
     DexFileDeps& other_deps = *other->GetDexFileDeps(*dex_file);
-    // We currently collect extra strings only on the main `VerifierDeps`,
-    // which should be the one passed as `this` in this method.
-    DCHECK(other_deps.strings_.empty());
     // Size is the number of class definitions in the dex file, and must be the
     // same between the two `VerifierDeps`.
     DCHECK_EQ(my_deps->assignable_types_.size(), other_deps.assignable_types_.size());
-    for (uint32_t i = 0; i < my_deps->assignable_types_.size(); ++i) {
-      my_deps->assignable_types_[i].merge(other_deps.assignable_types_[i]);
+    if (other_deps.strings_.empty()) {
+      // The compiler collects extra strings only on the main `VerifierDeps`, which
+      // should be the one passed as `this` in this method. IDs can be kept as is.
+      for (uint32_t i = 0; i < my_deps->assignable_types_.size(); ++i) {
+        my_deps->assignable_types_[i].merge(other_deps.assignable_types_[i]);
+      }
+    } else {
+      // Without compiler callbacks, each `VerifierDeps` numbers its extra strings
+      // on its own. Give them IDs in `this`.
+      DCHECK(Runtime::Current()->GetCompilerCallbacks() == nullptr);
+      uint32_t num_ids_in_dex = dex_file->NumStringIds();
+      auto remap = [&](dex::StringIndex string_id) {
+        return (string_id.index_ < num_ids_in_dex)
+            ? string_id
+            : GetIdFromString(*dex_file, other->GetStringFromId(*dex_file, string_id));
+      };
+      for (uint32_t i = 0; i < my_deps->assignable_types_.size(); ++i) {
+        for (const TypeAssignability& entry : other_deps.assignable_types_[i]) {
+          my_deps->assignable_types_[i].emplace(remap(entry.GetDestination()),
+                                                remap(entry.GetSource()));
+        }
+      }
     }
     BitVectorOr(my_deps->verified_classes_, other_deps.verified_classes_);
   }
@@ -707,11 +725,25 @@ bool VerifierDeps::VerifyDexFileAndUpdateStatus(
     const DexFile& dex_file,
     DexFileDeps& deps,
     Thread* self) {
-  StackHandleScope<2> hs(self);
   const std::vector<std::set<TypeAssignability>>& assignables = deps.assignable_types_;
   ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
-  MutableHandle<mirror::Class> source(hs.NewHandle<mirror::Class>(nullptr));
-  MutableHandle<mirror::Class> destination(hs.NewHandle<mirror::Class>(nullptr));
+
+  // Many classes record the same descriptors and the same assignability pairs, for example
+  // an app's activities are all checked against the framework's Activity. Resolve each
+  // descriptor once and check each successful pair once.
+  VariableSizedHandleScope hs(self);
+  std::map<dex::StringIndex, Handle<mirror::Class>> resolved_classes;
+  auto resolve = [&](dex::StringIndex string_idx) REQUIRES_SHARED(Locks::mutator_lock_) {
+    auto it = resolved_classes.find(string_idx);
+    if (it == resolved_classes.end()) {
+      const std::string& descriptor = GetStringFromId(dex_file, string_idx);
+      Handle<mirror::Class> klass =
+          hs.NewHandle(FindClassAndClearException(class_linker, self, descriptor, class_loader));
+      it = resolved_classes.emplace(string_idx, klass).first;
+    }
+    return it->second;
+  };
+  std::set<TypeAssignability> validated;
 
   uint32_t class_def_index = 0u;
   bool all_validated = true;
@@ -719,11 +751,11 @@ bool VerifierDeps::VerifyDexFileAndUpdateStatus(
   static constexpr uint32_t kMaxWarnings = 5;
   for (const auto& vec : assignables) {
     for (const auto& entry : vec) {
-      const std::string& destination_desc = GetStringFromId(dex_file, entry.GetDestination());
-      destination.Assign(
-          FindClassAndClearException(class_linker, self, destination_desc, class_loader));
-      const std::string& source_desc = GetStringFromId(dex_file, entry.GetSource());
-      source.Assign(FindClassAndClearException(class_linker, self, source_desc, class_loader));
+      if (validated.find(entry) != validated.end()) {
+        continue;
+      }
+      Handle<mirror::Class> destination = resolve(entry.GetDestination());
+      Handle<mirror::Class> source = resolve(entry.GetSource());
 
       if (destination == nullptr || source == nullptr) {
         // We currently don't use assignability information for unresolved
@@ -740,10 +772,13 @@ bool VerifierDeps::VerifyDexFileAndUpdateStatus(
           LOG(WARNING) << "Class "
                        << dex_file.PrettyType(dex_file.GetClassDef(class_def_index).class_idx_)
                        << " could not be fast verified because one of its methods wrongly expected "
-                       << destination_desc << " to be assignable from " << source_desc;
+                       << GetStringFromId(dex_file, entry.GetDestination())
+                       << " to be assignable from "
+                       << GetStringFromId(dex_file, entry.GetSource());
         }
         break;
       }
+      validated.insert(entry);
     }
     class_def_index++;
   }
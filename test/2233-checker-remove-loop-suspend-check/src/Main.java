@@ -26,6 +26,18 @@ public class Main {
   /// CHECK-NEXT:   dex_pc:{{.*}}
   /// CHECK:        Goto                 loop:<<LoopId>>
   /// CHECK-NEXT:   b
+  //
+  /// CHECK-START-X86_64: void Main.$noinline$testRemoveSuspendCheck(int[]) disassembly (after)
+  /// CHECK:        SuspendCheck         loop:<<LoopId:B\d+>>
+  /// CHECK-NEXT:   dex_pc:{{.*}}
+  /// CHECK:        Goto                 loop:<<LoopId>>
+  /// CHECK-NEXT:   jmp
+  //
+  /// CHECK-START-RISCV64: void Main.$noinline$testRemoveSuspendCheck(int[]) disassembly (after)
+  /// CHECK:        SuspendCheck         loop:<<LoopId:B\d+>>
+  /// CHECK-NEXT:   dex_pc:{{.*}}
+  /// CHECK:        Goto                 loop:<<LoopId>>
+  /// CHECK-NEXT:   {{(c\.)?j}}
 
   public static void $noinline$testRemoveSuspendCheck(int[] a) {
     for (int i = 0; i < ITERATIONS; i++) {
@@ -40,6 +52,16 @@ public class Main {
   /// CHECK:        SuspendCheck         loop:<<LoopId:B\d+>>
   /// CHECK:        Goto                 loop:<<LoopId>>
   /// CHECK-NEXT:   ldr
+  //
+  /// CHECK-START-X86_64: void Main.testRemoveSuspendCheckWithCall(int[]) disassembly (after)
+  /// CHECK:        SuspendCheck         loop:<<LoopId:B\d+>>
+  /// CHECK:        Goto                 loop:<<LoopId>>
+  /// CHECK-NEXT:   test
+  //
+  /// CHECK-START-RISCV64: void Main.testRemoveSuspendCheckWithCall(int[]) disassembly (after)
+  /// CHECK:        SuspendCheck         loop:<<LoopId:B\d+>>
+  /// CHECK:        Goto                 loop:<<LoopId>>
+  /// CHECK-NEXT:   {{(c\.)?lw}}
 
   public static void testRemoveSuspendCheckWithCall(int[] a) {
     for (int i = 0; i < ITERATIONS; i++) {
@@ -55,6 +77,16 @@ public class Main {
   /// CHECK:        SuspendCheck         loop:<<LoopId:B\d+>>
   /// CHECK:        Goto                 loop:<<LoopId>>
   /// CHECK-NEXT:   ldr
+  //
+  /// CHECK-START-X86_64: void Main.testRemoveSuspendCheckAboveHeuristic(int[]) disassembly (after)
+  /// CHECK:        SuspendCheck         loop:<<LoopId:B\d+>>
+  /// CHECK:        Goto                 loop:<<LoopId>>
+  /// CHECK-NEXT:   test
+  //
+  /// CHECK-START-RISCV64: void Main.testRemoveSuspendCheckAboveHeuristic(int[]) disassembly (after)
+  /// CHECK:        SuspendCheck         loop:<<LoopId:B\d+>>
+  /// CHECK:        Goto                 loop:<<LoopId>>
+  /// CHECK-NEXT:   {{(c\.)?lw}}
 
   public static void testRemoveSuspendCheckAboveHeuristic(int[] a) {
     for (int i = 0; i < ITERATIONS * 6; i++) {
@@ -69,6 +101,16 @@ public class Main {
   /// CHECK:        SuspendCheck         loop:<<LoopId:B\d+>>
   /// CHECK:        Goto                 loop:<<LoopId>>
   /// CHECK-NEXT:   ldr
+  //
+  /// CHECK-START-X86_64: void Main.testRemoveSuspendCheckUnknownCount(int[], int) disassembly (after)
+  /// CHECK:        SuspendCheck         loop:<<LoopId:B\d+>>
+  /// CHECK:        Goto                 loop:<<LoopId>>
+  /// CHECK-NEXT:   test
+  //
+  /// CHECK-START-RISCV64: void Main.testRemoveSuspendCheckUnknownCount(int[], int) disassembly (after)
+  /// CHECK:        SuspendCheck         loop:<<LoopId:B\d+>>
+  /// CHECK:        Goto                 loop:<<LoopId>>
+  /// CHECK-NEXT:   {{(c\.)?lw}}
 
   public static void testRemoveSuspendCheckUnknownCount(int[] a, int n) {
     for (int i = 0; i < n; i++) {
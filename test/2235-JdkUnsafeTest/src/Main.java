@@ -76,6 +76,7 @@ public class Main {
     testGetAndPutVolatile(unsafe);
     testGetAcquireAndPutRelease(unsafe);
     testCopyMemory(unsafe);
+    testGetAndPutAbsolute(unsafe);
   }
 
   private static void testArrayBaseOffset(Unsafe unsafe) {
@@ -410,6 +411,22 @@ public class Main {
           "Unsafe.getObjectAcquire(Object, long)");
   }
 
+  private static void testGetAndPutAbsolute(Unsafe unsafe) {
+    final int size = 32;
+    try (TestMemoryPtr memory = new TestMemoryPtr(size)) {
+      // Write past the start so that the int and long accesses are unaligned.
+      long address = memory.get() + 1;
+      unsafe.putByte(address, (byte) -2);
+      check(unsafe.getByte(address), (byte) -2, "Unsafe.getByte(long)");
+      unsafe.putInt(address, 0x12345678);
+      check(unsafe.getInt(address), 0x12345678, "Unsafe.getInt(long)");
+      check(unsafe.getByte(address), (byte) 0x78, "Unsafe.getByte(long) - low byte of int");
+      unsafe.putLong(address + 8, 0x0123456789abcdefL);
+      check(unsafe.getLong(address + 8), 0x0123456789abcdefL, "Unsafe.getLong(long)");
+      check(unsafe.getInt(address), 0x12345678, "Unsafe.getInt(long) - after putLong");
+    }
+  }
+
   private static void testCopyMemory(Unsafe unsafe) {
     final int size = 4 * 1024;
 
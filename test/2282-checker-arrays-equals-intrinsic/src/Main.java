@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.util.Arrays;
+
+public class Main {
+    public static void main(String[] args) {
+        byte[] a = new byte[] { 1, 2, 3 };
+        assertEquals(true, $noinline$equals(null, null));
+        assertEquals(false, $noinline$equals(a, null));
+        assertEquals(false, $noinline$equals(null, a));
+        assertEquals(true, $noinline$equals(a, a));
+        assertEquals(true, $noinline$equals(new byte[0], new byte[0]));
+        assertEquals(false, $noinline$equals(new byte[1], new byte[2]));
+
+        // Cover the byte loop, the 8-byte loop and the overlapping compare of the last 8 bytes.
+        for (int length = 1; length <= 100; ++length) {
+            byte[] x = new byte[length];
+            for (int i = 0; i < length; ++i) {
+                x[i] = (byte) (i * 7 + 1);
+            }
+            byte[] y = x.clone();
+            assertEquals(true, $noinline$equals(x, y));
+            for (int i = 0; i < length; ++i) {
+                y[i] ^= (byte) 0x80;
+                assertEquals(false, $noinline$equals(x, y));
+                assertEquals(false, $noinline$equals(y, x));
+                y[i] ^= (byte) 0x80;
+            }
+            assertEquals(true, $noinline$equals(y, x));
+        }
+    }
+
+    /// CHECK-START: boolean Main.$noinline$equals(byte[], byte[]) builder (after)
+    /// CHECK: InvokeStaticOrDirect intrinsic:ArraysEqualsByte
+    private static boolean $noinline$equals(byte[] a, byte[] b) {
+        return Arrays.equals(a, b);
+    }
+
+    private static void assertEquals(boolean expected, boolean actual) {
+        if (expected != actual) {
+            throw new AssertionError("Wrong result: " + expected + " != " + actual);
+        }
+    }
+}
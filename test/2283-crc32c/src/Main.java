@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.nio.ByteBuffer;
+import java.util.zip.CRC32C;
+
+/**
+ * The ART compiler can use intrinsics for the java.util.zip.CRC32C methods:
+ *   private static int updateBytes(int crc, byte[] b, int off, int end)
+ *   private static int updateDirectByteBuffer(int crc, long address, int off, int end)
+ *
+ * As the methods are private it is not possible to check the use of intrinsics
+ * for them directly.
+ * The tests check that correct checksums are produced.
+ */
+public class Main {
+  // Bitwise reference implementation of CRC32C with the reflected polynomial.
+  private static long referenceCRC32C(byte[] bytes, int off, int len) {
+    int crc = 0xFFFFFFFF;
+    for (int i = off; i < off + len; ++i) {
+      crc ^= bytes[i] & 0xFF;
+      for (int bit = 0; bit < 8; ++bit) {
+        crc = (crc >>> 1) ^ (0x82F63B78 & -(crc & 1));
+      }
+    }
+    return (~crc) & 0xFFFFFFFFL;
+  }
+
+  private static long CRC32CBytes(byte[] bytes, int off, int len) {
+    CRC32C crc32c = new CRC32C();
+    crc32c.update(bytes, off, len);
+    return crc32c.getValue();
+  }
+
+  private static long CRC32CDirectByteBuffer(byte[] bytes, int off, int len) {
+    ByteBuffer buffer = ByteBuffer.allocateDirect(bytes.length);
+    buffer.put(bytes);
+    buffer.position(off);
+    buffer.limit(off + len);
+    CRC32C crc32c = new CRC32C();
+    crc32c.update(buffer);
+    return crc32c.getValue();
+  }
+
+  public static void assertEqual(long expected, long actual) {
+    if (expected != actual) {
+      throw new Error("Expected: " + expected + ", found: " + actual);
+    }
+  }
+
+  private static void TestCheckValue() {
+    byte[] bytes = "123456789".getBytes();
+    assertEqual(0xE3069283L, CRC32CBytes(bytes, 0, bytes.length));
+    assertEqual(0xE3069283L, CRC32CDirectByteBuffer(bytes, 0, bytes.length));
+  }
+
+  private static void TestUpdateBytes() {
+    // Lengths and offsets cover the unaligned head, the 8-byte loop and all tails.
+    byte[] bytes = new byte[128];
+    for (int i = 0; i < bytes.length; ++i) {
+      bytes[i] = (byte) (i * 31 + 7);
+    }
+    for (int off = 0; off < 8; ++off) {
+      for (int len = 0; off + len <= bytes.length; ++len) {
+        long expected = referenceCRC32C(bytes, off, len);
+        assertEqual(expected, CRC32CBytes(bytes, off, len));
+        assertEqual(expected, CRC32CDirectByteBuffer(bytes, off, len));
+      }
+    }
+  }
+
+  private static void TestUpdateBytesInParts() {
+    byte[] bytes = new byte[1000];
+    for (int i = 0; i < bytes.length; ++i) {
+      bytes[i] = (byte) (i ^ (i >> 3));
+    }
+    CRC32C crc32c = new CRC32C();
+    crc32c.update(bytes, 0, 333);
+    crc32c.update(bytes, 333, 667);
+    assertEqual(referenceCRC32C(bytes, 0, bytes.length), crc32c.getValue());
+  }
+
+  private static void TestLargeArray() {
+    // Larger than the threshold of the intrinsic.
+    byte[] bytes = new byte[128 * 1024 + 3];
+    for (int i = 0; i < bytes.length; ++i) {
+      bytes[i] = (byte) (i * 13);
+    }
+    assertEqual(referenceCRC32C(bytes, 0, bytes.length), CRC32CBytes(bytes, 0, bytes.length));
+    assertEqual(referenceCRC32C(bytes, 5, bytes.length - 5),
+                CRC32CBytes(bytes, 5, bytes.length - 5));
+  }
+
+  public static void main(String args[]) {
+    TestCheckValue();
+    TestUpdateBytes();
+    TestUpdateBytesInParts();
+    TestLargeArray();
+  }
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.util.Observable;
+
+// Direct subclasses of Object sorted before the other classes. dex2oat can initialize them and
+// assign their bitstrings but they are never used at runtime, so the bitstrings that dex2oat and
+// the runtime assign to other direct subclasses of Object differ.
+class AFiller0 { }
+class AFiller1 { }
+class AFiller2 { }
+class AFiller3 { }
+class AFiller4 { }
+class AFiller5 { }
+class AFiller6 { }
+class AFiller7 { }
+class AFiller8 { }
+class AFiller9 { }
+class AFiller10 { }
+class AFiller11 { }
+class AFiller12 { }
+class AFiller13 { }
+class AFiller14 { }
+class AFiller15 { }
+
+// Subclasses of a boot image class that is not a type check target in the boot image, so its
+// bitstring is assigned only when initializing these classes.
+class ObservableSub extends Observable { }
+class ObservableOtherSub extends Observable { }
+
+public class Main {
+    public static void main(String[] args) {
+        assertEquals(true, $noinline$isObservable(new ObservableSub()));
+        assertEquals(true, $noinline$isObservable(new ObservableOtherSub()));
+        assertEquals(true, $noinline$isObservable(new Observable()));
+        assertEquals(false, $noinline$isObservable(new Object()));
+        assertEquals(false, $noinline$isObservable(null));
+
+        $noinline$castToObservable(new ObservableSub());
+        $noinline$castToObservable(new ObservableOtherSub());
+        try {
+            $noinline$castToObservable(new Object());
+            throw new AssertionError("Expected ClassCastException");
+        } catch (ClassCastException expected) {
+        }
+    }
+
+    /// CHECK-START: boolean Main.$noinline$isObservable(java.lang.Object) builder (after)
+    /// CHECK: InstanceOf check_kind:class_hierarchy_check
+    private static boolean $noinline$isObservable(Object o) {
+        return o instanceof Observable;
+    }
+
+    /// CHECK-START: java.util.Observable Main.$noinline$castToObservable(java.lang.Object) builder (after)
+    /// CHECK: CheckCast check_kind:class_hierarchy_check
+    private static Observable $noinline$castToObservable(Object o) {
+        return (Observable) o;
+    }
+
+    private static void assertEquals(boolean expected, boolean actual) {
+        if (expected != actual) {
+            throw new AssertionError("Wrong result: " + expected + " != " + actual);
+        }
+    }
+}
@@ -1621,6 +1621,45 @@ public class Main {
   }
 
 
+  /// CHECK-START: boolean Main.regionMatches(int[], int[], int, int) BCE (before)
+  /// CHECK:     BoundsCheck
+  /// CHECK:     ArrayGet
+  /// CHECK:     BoundsCheck
+  /// CHECK:     ArrayGet
+  /// CHECK-NOT: BoundsCheck
+
+  /// CHECK-START: boolean Main.regionMatches(int[], int[], int, int) BCE (after)
+  /// CHECK-NOT: Deoptimize
+
+  /// CHECK-START: boolean Main.regionMatches(int[], int[], int, int) BCE (after)
+  //  The loop is versioned: the original loop keeps its bounds checks and
+  //  its copy has none.
+  /// CHECK:     BoundsCheck
+  /// CHECK:     BoundsCheck
+  /// CHECK-NOT: BoundsCheck
+
+  /// CHECK-START: boolean Main.regionMatches(int[], int[], int, int) BCE (after)
+  /// CHECK:     ArrayGet
+  /// CHECK:     ArrayGet
+  /// CHECK:     ArrayGet
+  /// CHECK:     ArrayGet
+  /// CHECK-NOT: ArrayGet
+
+  static boolean regionMatches(int[] a, int[] b, int start, int end) {
+    if (a.length == 0 || b.length == 0) {
+      return false;
+    }
+    // The early exit rules out deoptimization, since the loop may stop
+    // before reaching an index out of bounds.
+    for (int i = start; i < end; i++) {
+      if (a[i] != b[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+
   static void testUnknownBounds() {
     boolean caught = false;
 
@@ -1729,6 +1768,23 @@ public class Main {
       System.out.println("partialLooping failed!");
     }
 
+    int[] region1 = {0, 1, 2, 3, 4, 5};
+    int[] region2 = {0, 1, 2, 3, 5};
+    if (!regionMatches(region1, region2, 1, 4) ||
+        regionMatches(region1, region2, 0, 5) ||
+        regionMatches(region1, region2, 4, 6)) {
+      System.out.println("regionMatches failed!");
+    }
+    caught = false;
+    try {
+      regionMatches(region1, region1, 0, 7);
+    } catch (ArrayIndexOutOfBoundsException e) {
+      caught = true;
+    }
+    if (!caught) {
+      System.out.println("regionMatches exception failed!");
+    }
+
     caught = false;
     main = new Main();
     try {
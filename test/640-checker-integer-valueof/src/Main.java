@@ -148,6 +148,47 @@ public class Main {
     return Integer.valueOf(value).intValue();
   }
 
+  /// CHECK-START: long Main.$noinline$boxUnboxLong(long) builder (after)
+  /// CHECK: <<Input:j\d+>>       ParameterValue
+  /// CHECK: <<Boxed:l\d+>>       InvokeStaticOrDirect [<<Input>>{{(,[ij]\d+)?}}] method_name:java.lang.Long.valueOf intrinsic:LongValueOf
+  /// CHECK-NOT:                  NullCheck [<<Boxed>>]
+  /// CHECK: <<Unboxed:j\d+>>     InvokeVirtual [<<Boxed>>] method_name:java.lang.Long.longValue
+  /// CHECK:                      Return [<<Unboxed>>]
+
+  /// CHECK-START: long Main.$noinline$boxUnboxLong(long) instruction_simplifier$after_inlining (after)
+  /// CHECK: <<Input:j\d+>>       ParameterValue
+  /// CHECK:                      Return [<<Input>>]
+
+  /// CHECK-START: long Main.$noinline$boxUnboxLong(long) dead_code_elimination$after_inlining (after)
+  /// CHECK-NOT:                  InvokeStaticOrDirect
+  /// CHECK-NOT:                  InstanceFieldGet
+
+  public static long $noinline$boxUnboxLong(long value) {
+    return Long.valueOf(value).longValue();
+  }
+
+  /// CHECK-START: java.lang.Long Main.$noinline$boxLong(long) disassembly (after)
+  /// CHECK: InvokeStaticOrDirect method_name:java.lang.Long.valueOf intrinsic:LongValueOf
+
+  public static Long $noinline$boxLong(long value) {
+    return Long.valueOf(value);
+  }
+
+  /// CHECK-START: java.lang.Long Main.$noinline$boxLongConstant() disassembly (after)
+  /// CHECK: InvokeStaticOrDirect method_name:java.lang.Long.valueOf intrinsic:LongValueOf
+
+  public static Long $noinline$boxLongConstant() {
+    return Long.valueOf(-42L);
+  }
+
+  /// CHECK-START: java.lang.Long Main.$noinline$boxLargeLongConstant() disassembly (after)
+  /// CHECK: InvokeStaticOrDirect method_name:java.lang.Long.valueOf intrinsic:LongValueOf
+
+  public static Long $noinline$boxLargeLongConstant() {
+    // Does not fit in a 32-bit immediate.
+    return Long.valueOf(0x123456789aL);
+  }
+
   /// CHECK-START: int Main.$noinline$boxUnboxByteAsUint8(byte) builder (after)
   /// CHECK-DAG: <<Input:b\d+>>   ParameterValue
   /// CHECK-DAG: <<Boxed:l\d+>>   InvokeStaticOrDirect [<<Input>>{{(,[ij]\d+)?}}] method_name:java.lang.Byte.valueOf intrinsic:ByteValueOf
@@ -249,6 +290,19 @@ public class Main {
 
     assertEqual(42, $noinline$boxUnboxByteAsUint8((byte) 42));
     assertEqual(-42 & 0xff, $noinline$boxUnboxByteAsUint8((byte) -42));
+
+    assertEqual(42L, $noinline$boxUnboxLong(42L));
+    assertEqual(0x123456789aL, $noinline$boxUnboxLong(0x123456789aL));
+    // Values in [-128, 127] come from the cache, others are new boxes.
+    assertEqual(true, $noinline$boxLong(-128L) == $noinline$boxLong(-128L));
+    assertEqual(true, $noinline$boxLong(127L) == $noinline$boxLong(127L));
+    assertEqual(false, $noinline$boxLong(128L) == $noinline$boxLong(128L));
+    assertEqual(false, $noinline$boxLong(-129L) == $noinline$boxLong(-129L));
+    // Must not be mistaken for a small value by a 32-bit range check.
+    assertEqual(false, $noinline$boxLong(0x100000000L) == $noinline$boxLong(0x100000000L));
+    assertEqual(0x100000000L, $noinline$boxLong(0x100000000L).longValue());
+    assertEqual(true, $noinline$boxLongConstant() == Long.valueOf(-42L));
+    assertEqual(0x123456789aL, $noinline$boxLargeLongConstant().longValue());
   }
 
   static void assertEqual(String a, Integer b) {
@@ -269,6 +323,18 @@ public class Main {
     }
   }
 
+  static void assertEqual(long a, long b) {
+    if (a != b) {
+      throw new Error("Expected " + a + ", got " + b);
+    }
+  }
+
+  static void assertEqual(boolean a, boolean b) {
+    if (a != b) {
+      throw new Error("Expected " + a + ", got " + b);
+    }
+  }
+
   static int intField = 42;
   static int intField2 = 42;
   static int intField3 = 55555;
@@ -551,6 +551,53 @@ public class Main {
     return sum;
   }
 
+  /// CHECK-START-ARM64: int Main.reductionMinInt(int[]) loop_optimization (after)
+  /// CHECK-DAG: <<Rep:d\d+>>    VecReplicateScalar [{{i\d+}}{{(,j\d+)?}}]  loop:none
+  /// CHECK-DAG: <<Phi:d\d+>>    Phi [<<Rep>>,{{d\d+}}]                    loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: <<Load:d\d+>>   VecLoad [{{l\d+}},{{i\d+}}                  loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:                 VecMin [<<Phi>>,<<Load>>                  loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: <<Red:d\d+>>    VecReduce [<<Phi>>                        loop:none
+  /// CHECK-DAG:                 VecExtractScalar [<<Red>>                 loop:none
+  private static int reductionMinInt(int[] x) {
+    int min = Integer.MAX_VALUE;
+    for (int i = 0; i < x.length; i++) {
+      min = Math.min(min, x[i]);
+    }
+    return min;
+  }
+
+  /// CHECK-START-ARM64: int Main.reductionMaxInt(int[]) loop_optimization (after)
+  /// CHECK-DAG: <<Rep:d\d+>>    VecReplicateScalar [{{i\d+}}{{(,j\d+)?}}]  loop:none
+  /// CHECK-DAG: <<Phi:d\d+>>    Phi [<<Rep>>,{{d\d+}}]                    loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: <<Load:d\d+>>   VecLoad [{{l\d+}},{{i\d+}}                  loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:                 VecMax [<<Phi>>,<<Load>>                  loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: <<Red:d\d+>>    VecReduce [<<Phi>>                        loop:none
+  /// CHECK-DAG:                 VecExtractScalar [<<Red>>                 loop:none
+  private static int reductionMaxInt(int[] x) {
+    int max = Integer.MIN_VALUE;
+    for (int i = 0; i < x.length; i++) {
+      // The reduction phi is the second operand.
+      max = Math.max(x[i], max);
+    }
+    return max;
+  }
+
+  private static long reductionMinLong(long[] x) {
+    long min = Long.MAX_VALUE;
+    for (int i = 0; i < x.length; i++) {
+      min = Math.min(min, x[i]);
+    }
+    return min;
+  }
+
+  private static long reductionMaxLong(long[] x) {
+    long max = Long.MIN_VALUE;
+    for (int i = 0; i < x.length; i++) {
+      max = Math.max(max, x[i]);
+    }
+    return max;
+  }
+
   //
   // A few special cases.
   //
@@ -627,6 +674,15 @@ public class Main {
     expectEquals(-27466, reductionShort(xs));
     expectEquals(38070, reductionChar(xc));
     expectEquals(365750, reductionInt(xi));
+    expectEquals(-17, reductionMinInt(xi));
+    expectEquals(1480, reductionMaxInt(xi));
+    expectEquals(3, reductionMinInt(xpi));
+    expectEquals(-4, reductionMaxInt(xni));
+    expectEquals(Integer.MAX_VALUE, reductionMinInt(new int[0]));
+    expectEquals(-17L, reductionMinLong(xl));
+    expectEquals(1480L, reductionMaxLong(xl));
+    expectEquals(-103L, reductionMinLong(xnl));
+    expectEquals(102L, reductionMaxLong(xpl));
     expectEquals(273, reductionIntChain());
     expectEquals(120, reductionIntToLoop(x0));
     expectEquals(121, reductionIntToLoop(x1));
@@ -22,6 +22,7 @@ public class Main {
         testAppendStringAndDouble();
         testAppendDoubleAndFloat();
         testAppendStringAndString();
+        testAppendStringAndCharArray();
         testMiscelaneous();
         testNoArgs();
         testInline();
@@ -357,6 +358,41 @@ public class Main {
         assertEquals("\u0131test\u0131", $noinline$appendStringAndString("\u0131", "test\u0131"));
     }
 
+    /// CHECK-START: java.lang.String Main.$noinline$appendStringAndCharArray(java.lang.String, char, char) instruction_simplifier (before)
+    /// CHECK-NOT:              StringBuilderAppend
+
+    /// CHECK-START: java.lang.String Main.$noinline$appendStringAndCharArray(java.lang.String, char, char) instruction_simplifier (after)
+    /// CHECK:                  StringBuilderAppend
+    public static String $noinline$appendStringAndCharArray(String s, char c1, char c2) {
+        char[] chars = new char[] { c1, c2 };
+        return new StringBuilder().append(s).append(chars).toString();
+    }
+
+    /// CHECK-START: java.lang.String Main.$noinline$appendNullableCharArray(char[]) instruction_simplifier (after)
+    /// CHECK-NOT:              StringBuilderAppend
+    public static String $noinline$appendNullableCharArray(char[] chars) {
+        return new StringBuilder().append("x").append(chars).toString();
+    }
+
+    /// CHECK-START: java.lang.String Main.$noinline$appendCharArrayModifiedLater(char, char) instruction_simplifier (after)
+    /// CHECK-NOT:              StringBuilderAppend
+    public static String $noinline$appendCharArrayModifiedLater(char c1, char c2) {
+        char[] chars = new char[] { c1 };
+        StringBuilder sb = new StringBuilder().append(chars);
+        chars[0] = c2;
+        return sb.append(chars).toString();
+    }
+
+    public static void testAppendStringAndCharArray() {
+        assertEquals("nullab", $noinline$appendStringAndCharArray(null, 'a', 'b'));
+        assertEquals("testab", $noinline$appendStringAndCharArray("test", 'a', 'b'));
+        // Test with non-ASCII characters.
+        assertEquals("test\u0131b", $noinline$appendStringAndCharArray("test", '\u0131', 'b'));
+        assertEquals("\u0131ab", $noinline$appendStringAndCharArray("\u0131", 'a', 'b'));
+        assertEquals("xyz", $noinline$appendNullableCharArray(new char[] { 'y', 'z' }));
+        assertEquals("ab", $noinline$appendCharArrayModifiedLater('a', 'b'));
+    }
+
     /// CHECK-START: java.lang.String Main.$noinline$appendSLILC(java.lang.String, long, int, long, char) instruction_simplifier (before)
     /// CHECK-NOT:              StringBuilderAppend
 
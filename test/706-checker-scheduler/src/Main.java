@@ -419,6 +419,7 @@ public class Main {
 
   /// CHECK-START-ARM: void Main.accessFieldsVolatile() scheduler (before)
   /// CHECK-START-ARM64: void Main.accessFieldsVolatile() scheduler (before)
+  /// CHECK-START-RISCV64: void Main.accessFieldsVolatile() scheduler (before)
   /// CHECK:            InstanceFieldGet
   /// CHECK:            Add
   /// CHECK:            InstanceFieldSet
@@ -434,6 +435,7 @@ public class Main {
 
   /// CHECK-START-ARM: void Main.accessFieldsVolatile() scheduler (after)
   /// CHECK-START-ARM64: void Main.accessFieldsVolatile() scheduler (after)
+  /// CHECK-START-RISCV64: void Main.accessFieldsVolatile() scheduler (after)
   /// CHECK:            InstanceFieldGet
   /// CHECK:            Add
   /// CHECK:            InstanceFieldSet